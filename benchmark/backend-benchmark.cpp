@@ -0,0 +1,601 @@
+/*
+ * (C) 2026 The University of Chicago
+ *
+ * See COPYRIGHT in top-level directory.
+ */
+
+/* This benchmark instantiates backends directly through the
+ * DatabaseFactory and drives them from a number of execution streams,
+ * without going through a provider (hence without RPC). It is meant to
+ * compare the backends with one another and to catch regressions in the
+ * backends' code without the noise introduced by the network.
+ */
+#include "config.h"
+#include <yokan/backend.hpp>
+#include <yokan/filters.hpp>
+#include <tclap/CmdLine.h>
+#include <nlohmann/json.hpp>
+#include <abt.h>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <regex>
+#include <chrono>
+#include <algorithm>
+#include <random>
+#include <map>
+#include "distributions.hpp"
+
+using namespace std::string_literals;
+using json = nlohmann::json;
+using yokan::Status;
+using yokan::UserMem;
+using yokan::BasicUserMem;
+using yokan::DatabaseInterface;
+
+struct range : public TCLAP::StringLikeTrait {
+
+    size_t min = 0;
+    size_t max = 0;
+
+    range() = default;
+    range(const std::string& str) {
+        std::regex rgx("^(0|([1-9][0-9]*))(,(0|([1-9][0-9]*)))?$");
+        std::smatch matches;
+        if(std::regex_search(str, matches, rgx)) {
+            min = atol(matches[1].str().c_str());
+            max = min;
+            if(!matches[4].str().empty())
+                max = atol(matches[4].str().c_str());
+            if(max < min)
+                throw TCLAP::ArgParseException("invalid range \""s + str + "\"");
+        } else {
+            throw TCLAP::ArgParseException("invalid range format \""s + str + "\"");
+        }
+    }
+};
+
+struct options {
+    std::vector<std::string> backends;
+    std::vector<std::string> operations;
+    std::string              configs;
+    std::string              path;
+    range                    key_sizes;
+    range                    val_sizes;
+    std::string              size_distribution;
+    size_t                   num_items;
+    unsigned                 num_threads;
+    unsigned                 batch_size;
+    unsigned                 repetitions;
+    unsigned                 seed;
+};
+
+static options parse_arguments(int argc, char** argv);
+
+/* Backends compiled by default (pmemkv requires a pool
+ * to be set up and is only run when explicitly requested) */
+static const std::vector<std::string> default_backends = {
+    "null", "map", "unordered_map", "set", "unordered_set",
+    "array", "log", "buffered",
+#ifdef YOKAN_HAS_LEVELDB
+    "leveldb",
+#endif
+#ifdef YOKAN_HAS_LMDB
+    "lmdb",
+#endif
+#ifdef YOKAN_HAS_BERKELEYDB
+    "berkeleydb",
+#endif
+#ifdef YOKAN_HAS_ROCKSDB
+    "rocksdb",
+#endif
+#ifdef YOKAN_HAS_GDBM
+    "gdbm",
+#endif
+#ifdef YOKAN_HAS_TKRZW
+    "tkrzw",
+#endif
+#ifdef YOKAN_HAS_UNQLITE
+    "unqlite",
+#endif
+};
+
+/* Operations, in the order in which they are executed. Operations that
+ * read data require the data to have been stored first, hence put and
+ * doc_store are executed (but not reported) when one of them is selected.
+ */
+static const std::vector<std::string> all_operations = {
+    "put", "exists", "length", "get", "list_keys", "list_keyvals", "iter", "erase",
+    "doc_store", "doc_load", "doc_update", "doc_list", "doc_iter"
+};
+
+static const char* collection_name = "bench";
+
+/**
+ * @brief Default configuration of a backend, storing its files (if any)
+ * in the provided directory.
+ */
+static json default_config(const std::string& type, const std::string& path) {
+    if(type == "log")
+        return json{{"path", path}};
+    if(type == "buffered")
+        return json{{"inner", {{"type", "map"}, {"config", json::object()}}},
+                    {"wal_path", path + "/buffered.wal"}};
+    if(type == "leveldb" || type == "rocksdb" || type == "lmdb" || type == "gdbm")
+        return json{{"path", path}, {"create_if_missing", true}};
+    if(type == "berkeleydb")
+        return json{{"path", path + "/db"}, {"create_if_missing", true}, {"type", "btree"}};
+    if(type == "tkrzw")
+        return json{{"path", path + "/db.tkt"}, {"type", "tree"}};
+    if(type == "unqlite")
+        return json{{"path", path + "/db"}, {"mode", "create"}};
+    return json::object();
+}
+
+/**
+ * @brief Data and buffers of a single thread. Each thread works on its
+ * own set of items, and on the documents it stored.
+ */
+struct thread_data {
+
+    std::string          keys;
+    std::vector<size_t>  ksizes;
+    std::vector<size_t>  koffsets;
+    std::string          vals;
+    std::vector<size_t>  vsizes;
+    std::vector<size_t>  voffsets;
+    std::vector<yk_id_t> ids;
+
+    // output buffers
+    std::vector<char>    kbuf;
+    std::vector<char>    vbuf;
+    std::vector<size_t>  ksizes_out;
+    std::vector<size_t>  vsizes_out;
+    std::vector<uint8_t> bits;
+    std::vector<yk_id_t> ids_out;
+    std::vector<size_t>  zeros;
+
+    // results of the last operation
+    Status   status = Status::OK;
+    size_t   num_items = 0;
+    size_t   num_calls = 0;
+    double   call_time = 0.0; // seconds
+
+    size_t count() const {
+        return ksizes.size();
+    }
+
+    UserMem keysAt(size_t i, size_t n) {
+        auto end = i + n == count() ? keys.size() : koffsets[i+n];
+        return UserMem{keys.data() + koffsets[i], end - koffsets[i]};
+    }
+
+    UserMem valsAt(size_t i, size_t n) {
+        auto end = i + n == count() ? vals.size() : voffsets[i+n];
+        return UserMem{vals.data() + voffsets[i], end - voffsets[i]};
+    }
+
+    UserMem keyAt(size_t i) {
+        return UserMem{keys.data() + koffsets[i], ksizes[i]};
+    }
+};
+
+static std::string make_key(uint64_t i, size_t size, std::mt19937_64& rng) {
+    static const char alphanum[]
+        = "0123456789"
+          "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+          "abcdefghijklmnopqrstuvwxyz";
+    // the key starts with the hash of its index so that keys are unique
+    // (for sizes of at least 8) and not inserted in sorted order
+    std::string key(size, ' ');
+    auto h = fnv_hash64(i);
+    for(size_t j = 0; j < size; j++) {
+        if(j < 8) {
+            key[j] = alphanum[h % (sizeof(alphanum) - 1)];
+            h /= (sizeof(alphanum) - 1);
+        } else {
+            key[j] = alphanum[rng() % (sizeof(alphanum) - 1)];
+        }
+    }
+    return key;
+}
+
+static void init_thread_data(thread_data& t, const options& opt,
+                             uint64_t first, uint64_t count, unsigned seed) {
+    std::mt19937_64 rng(seed);
+    json ksizes_config = {{"min", opt.key_sizes.min}, {"max", opt.key_sizes.max},
+                          {"distribution", opt.size_distribution}};
+    json vsizes_config = {{"min", opt.val_sizes.min}, {"max", opt.val_sizes.max},
+                          {"distribution", opt.size_distribution}};
+    SizeGenerator ksize_gen(ksizes_config);
+    SizeGenerator vsize_gen(vsizes_config);
+    for(uint64_t i = first; i < first + count; i++) {
+        auto ksize = ksize_gen.next(rng);
+        auto vsize = vsize_gen.next(rng);
+        t.koffsets.push_back(t.keys.size());
+        t.keys += make_key(i, ksize, rng);
+        t.ksizes.push_back(ksize);
+        t.voffsets.push_back(t.vals.size());
+        t.vals += make_key(i, vsize, rng);
+        t.vsizes.push_back(vsize);
+    }
+    t.ids.resize(count);
+    auto batch = std::max<size_t>(1, opt.batch_size);
+    t.kbuf.resize(batch*std::max<size_t>(1, opt.key_sizes.max));
+    t.vbuf.resize(batch*std::max<size_t>(1, opt.val_sizes.max));
+    t.ksizes_out.resize(batch);
+    t.vsizes_out.resize(batch);
+    t.bits.resize(batch/8 + 1);
+    t.ids_out.resize(batch);
+    t.zeros.resize(batch, 0);
+}
+
+struct thread_args {
+    DatabaseInterface*   db;
+    const std::string*   operation;
+    thread_data*         data;
+    unsigned             batch_size;
+    bool                 keys_only; // set backends store keys without values
+};
+
+/**
+ * @brief Execute an operation on all the items of a thread, in batches.
+ * Scanning operations (list_keys, list_keyvals, iter, doc_list, doc_iter)
+ * start from each item at the beginning of a batch and read up to a batch
+ * worth of items.
+ */
+static void run_operation(void* a) {
+    auto args  = static_cast<thread_args*>(a);
+    auto db    = args->db;
+    auto& op   = *args->operation;
+    auto& t    = *args->data;
+    auto batch = std::max<size_t>(1, args->batch_size);
+    const int32_t mode = YOKAN_MODE_DEFAULT;
+
+    t.status    = Status::OK;
+    t.num_items = 0;
+    t.num_calls = 0;
+    t.call_time = 0.0;
+
+    auto kv_filter = yokan::FilterFactory::makeKeyValueFilter(
+        MARGO_INSTANCE_NULL, mode, UserMem{nullptr, 0});
+    auto doc_filter = yokan::FilterFactory::makeDocFilter(
+        MARGO_INSTANCE_NULL, mode, UserMem{nullptr, 0});
+
+    for(size_t i = 0; i < t.count() && t.status == Status::OK; i += batch) {
+        auto n = std::min(batch, t.count() - i);
+        auto ksizes = BasicUserMem<size_t>{t.ksizes.data() + i, n};
+        auto vsizes = BasicUserMem<size_t>{t.vsizes.data() + i, n};
+        auto ids    = BasicUserMem<yk_id_t>{t.ids.data() + i, n};
+        auto kbuf   = UserMem{t.kbuf.data(), t.kbuf.size()};
+        auto vbuf   = UserMem{t.vbuf.data(), t.vbuf.size()};
+        auto ksizes_out = BasicUserMem<size_t>{t.ksizes_out.data(), n};
+        auto vsizes_out = BasicUserMem<size_t>{t.vsizes_out.data(), n};
+        auto ids_out    = BasicUserMem<yk_id_t>{t.ids_out.data(), n};
+        size_t items = n;
+
+        auto start = std::chrono::steady_clock::now();
+        if(op == "put" && args->keys_only) {
+            auto zeros = BasicUserMem<size_t>{t.zeros.data(), n};
+            t.status = db->put(mode, t.keysAt(i, n), ksizes, UserMem{nullptr, 0}, zeros);
+        } else if(op == "put") {
+            t.status = db->put(mode, t.keysAt(i, n), ksizes, t.valsAt(i, n), vsizes);
+        } else if(op == "exists") {
+            auto bits = yokan::BitField{t.bits.data(), n};
+            t.status = db->exists(mode, t.keysAt(i, n), ksizes, bits);
+        } else if(op == "length") {
+            t.status = db->length(mode, t.keysAt(i, n), ksizes, vsizes_out);
+        } else if(op == "get") {
+            t.status = db->get(mode, true, t.keysAt(i, n), ksizes, vbuf, vsizes_out);
+        } else if(op == "list_keys") {
+            t.status = db->listKeys(mode, true, t.keyAt(i), kv_filter, kbuf, ksizes_out);
+            items = ksizes_out.size;
+        } else if(op == "list_keyvals") {
+            t.status = db->listKeyValues(mode, true, t.keyAt(i), kv_filter,
+                                         kbuf, ksizes_out, vbuf, vsizes_out);
+            items = ksizes_out.size;
+        } else if(op == "iter") {
+            items = 0;
+            t.status = db->iter(mode, n, t.keyAt(i), kv_filter, false,
+                [&items](const UserMem&, const UserMem&) {
+                    items += 1;
+                    return Status::OK;
+                });
+        } else if(op == "erase") {
+            t.status = db->erase(mode, t.keysAt(i, n), ksizes);
+        } else if(op == "doc_store") {
+            t.status = db->docStore(collection_name, mode, t.valsAt(i, n), vsizes, ids);
+        } else if(op == "doc_load") {
+            t.status = db->docLoad(collection_name, mode, true, ids, vbuf, vsizes_out);
+        } else if(op == "doc_update") {
+            t.status = db->docUpdate(collection_name, mode, ids, t.valsAt(i, n), vsizes);
+        } else if(op == "doc_list") {
+            t.status = db->docList(collection_name, mode, true, t.ids[i], doc_filter,
+                                   ids_out, vbuf, vsizes_out);
+            items = ids_out.size;
+        } else if(op == "doc_iter") {
+            items = 0;
+            t.status = db->docIter(collection_name, mode, n, t.ids[i], doc_filter,
+                [&items](yk_id_t, const UserMem&) {
+                    items += 1;
+                    return Status::OK;
+                });
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        t.call_time += std::chrono::duration<double>(end - start).count();
+        t.num_calls += 1;
+        t.num_items += items;
+    }
+}
+
+/**
+ * @brief Result of an operation on a backend, across repetitions.
+ */
+struct result {
+    std::vector<double> throughputs; // items/second
+    std::vector<double> latencies;   // seconds per call
+    Status              status = Status::OK;
+};
+
+static std::string format_result(const result& r, bool latency) {
+    if(r.status == Status::NotSupported) return "n/a";
+    if(r.status != Status::OK) return "error";
+    auto& values = latency ? r.latencies : r.throughputs;
+    if(values.empty()) return "-";
+    double avg = 0.0;
+    for(auto& v : values) avg += v;
+    avg /= values.size();
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(latency ? 3 : 1)
+       << (latency ? avg*1e6 : avg/1e3);
+    return ss.str();
+}
+
+static void print_table(const std::string& title,
+                        const std::vector<std::string>& backends,
+                        const std::vector<std::string>& operations,
+                        std::map<std::string, std::map<std::string, result>>& results,
+                        bool latency) {
+    std::cout << "----- " << title << " -----" << std::endl;
+    std::cout << std::left << std::setw(14) << "OPERATION";
+    for(auto& b : backends)
+        std::cout << std::right << std::setw(std::max<int>(12, b.size()+2)) << b;
+    std::cout << std::endl;
+    for(auto& op : operations) {
+        std::cout << std::left << std::setw(14) << op;
+        for(auto& b : backends)
+            std::cout << std::right << std::setw(std::max<int>(12, b.size()+2))
+                      << format_result(results[b][op], latency);
+        std::cout << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+
+    auto opt = parse_arguments(argc, argv);
+
+    json configs = json::object();
+    if(!opt.configs.empty()) {
+        std::ifstream f(opt.configs);
+        if(!f.good()) {
+            std::cerr << "ERROR: file " << opt.configs << " does not exist" << std::endl;
+            exit(-1);
+        }
+        configs = json::parse(f);
+    }
+
+    // operations that need to be executed, including the ones
+    // that store the data needed by the selected operations
+    auto selected = [&opt](const std::string& op) {
+        return std::find(opt.operations.begin(), opt.operations.end(), op)
+            != opt.operations.end();
+    };
+    std::vector<std::string> operations;
+    bool need_put = false, need_doc_store = false;
+    for(auto& op : opt.operations) {
+        if(op.rfind("doc_", 0) == 0) need_doc_store = need_doc_store || op != "doc_store";
+        else need_put = need_put || op != "put";
+    }
+    for(auto& op : all_operations) {
+        if(selected(op) || (op == "put" && need_put) || (op == "doc_store" && need_doc_store))
+            operations.push_back(op);
+    }
+
+    // each thread works on its own subset of the items
+    std::vector<thread_data> threads(opt.num_threads);
+    for(unsigned i = 0; i < opt.num_threads; i++) {
+        auto first = (opt.num_items*i)/opt.num_threads;
+        auto last  = (opt.num_items*(i+1))/opt.num_threads;
+        init_thread_data(threads[i], opt, first, last - first, opt.seed + i);
+    }
+
+    ABT_init(0, nullptr);
+    ABT_pool pool = ABT_POOL_NULL;
+    ABT_pool_create_basic(ABT_POOL_FIFO, ABT_POOL_ACCESS_MPMC, ABT_TRUE, &pool);
+    std::vector<ABT_xstream> xstreams(opt.num_threads, ABT_XSTREAM_NULL);
+    for(auto& es : xstreams)
+        ABT_xstream_create_basic(ABT_SCHED_DEFAULT, 1, &pool, ABT_SCHED_CONFIG_NULL, &es);
+
+    std::vector<std::string> backends;
+    std::map<std::string, std::map<std::string, result>> results;
+
+    for(auto& type : opt.backends) {
+        if(!yokan::DatabaseFactory::hasBackendType(type)) {
+            std::cerr << "WARNING: backend " << type << " is not available" << std::endl;
+            continue;
+        }
+        backends.push_back(type);
+        auto path = opt.path + "/" + type;
+        auto config = configs.contains(type) ? configs[type] : default_config(type, path);
+        bool keys_only = type == "set" || type == "unordered_set";
+
+        for(unsigned rep = 0; rep < opt.repetitions; rep++) {
+            std::filesystem::remove_all(path);
+            std::filesystem::create_directories(path);
+
+            DatabaseInterface* db = nullptr;
+            auto status = yokan::DatabaseFactory::makeDatabase(type, config.dump(), &db);
+            if(status != Status::OK) {
+                std::cerr << "ERROR: could not create " << type << " database (status "
+                          << static_cast<int>(status) << ")" << std::endl;
+                for(auto& op : operations) results[type][op].status = status;
+                break;
+            }
+            if(need_doc_store || selected("doc_store"))
+                db->collCreate(YOKAN_MODE_DEFAULT, collection_name);
+
+            for(auto& op : operations) {
+                auto& r = results[type][op];
+                if(r.status != Status::OK) continue;
+
+                std::vector<thread_args> args(opt.num_threads);
+                std::vector<ABT_thread> ults(opt.num_threads, ABT_THREAD_NULL);
+                auto start = std::chrono::steady_clock::now();
+                for(unsigned i = 0; i < opt.num_threads; i++) {
+                    args[i] = thread_args{db, &op, &threads[i], opt.batch_size, keys_only};
+                    ABT_thread_create(pool, run_operation, &args[i],
+                                      ABT_THREAD_ATTR_NULL, &ults[i]);
+                }
+                ABT_thread_join_many(ults.size(), ults.data());
+                auto end = std::chrono::steady_clock::now();
+                ABT_thread_free_many(ults.size(), ults.data());
+
+                size_t num_items = 0, num_calls = 0;
+                double call_time = 0.0;
+                for(auto& t : threads) {
+                    if(t.status != Status::OK && r.status == Status::OK) {
+                        r.status = t.status;
+                        if(t.status != Status::NotSupported)
+                            std::cerr << "ERROR: " << op << " failed on " << type
+                                      << " (status " << static_cast<int>(t.status)
+                                      << ")" << std::endl;
+                    }
+                    num_items += t.num_items;
+                    num_calls += t.num_calls;
+                    call_time += t.call_time;
+                }
+                auto elapsed = std::chrono::duration<double>(end - start).count();
+                r.throughputs.push_back(elapsed > 0.0 ? num_items/elapsed : 0.0);
+                r.latencies.push_back(num_calls ? call_time/num_calls : 0.0);
+            }
+
+            db->destroy();
+            delete db;
+            std::filesystem::remove_all(path);
+        }
+    }
+
+    std::cout << "----- CONFIGURATION --------------" << std::endl;
+    std::cout << "ITEMS       : " << opt.num_items << std::endl;
+    std::cout << "KEY SIZES   : " << opt.key_sizes.min << "-" << opt.key_sizes.max
+              << " (" << opt.size_distribution << ")" << std::endl;
+    std::cout << "VALUE SIZES : " << opt.val_sizes.min << "-" << opt.val_sizes.max
+              << " (" << opt.size_distribution << ")" << std::endl;
+    std::cout << "THREADS     : " << opt.num_threads << std::endl;
+    std::cout << "BATCH SIZE  : " << opt.batch_size << std::endl;
+    std::cout << "REPETITIONS : " << opt.repetitions << std::endl;
+    print_table("THROUGHPUT (thousand items/second)",
+                backends, opt.operations, results, false);
+    print_table("LATENCY (microseconds/call)",
+                backends, opt.operations, results, true);
+
+    for(auto& es : xstreams) {
+        ABT_xstream_join(es);
+        ABT_xstream_free(&es);
+    }
+    ABT_finalize();
+    return 0;
+}
+
+static std::vector<std::string> split(const std::string& str) {
+    std::vector<std::string> result;
+    std::stringstream ss(str);
+    std::string item;
+    while(std::getline(ss, item, ','))
+        if(!item.empty()) result.push_back(item);
+    return result;
+}
+
+static options parse_arguments(int argc, char** argv) {
+    options opt;
+    try {
+        TCLAP::CmdLine cmd("Yokan Backend Benchmark", ' ', "0.1");
+        TCLAP::ValueArg<std::string> backendsArg(
+            "b", "backends", "Comma-separated list of backends (default: all compiled)", false, "", "string");
+        TCLAP::ValueArg<std::string> operationsArg(
+            "o", "operations", "Comma-separated list of operations (default: all)", false, "", "string");
+        TCLAP::ValueArg<std::string> configsArg(
+            "", "configs", "JSON file mapping backend types to their configuration", false, "", "filename");
+        TCLAP::ValueArg<std::string> pathArg(
+            "", "path", "Directory in which persistent backends store their files", false,
+            "/tmp/yk-backend-benchmark", "string");
+        TCLAP::ValueArg<range> keySizesArg(
+            "k", "key-sizes", "Range of key sizes (e.g. \"32,64\")", false, range("16,32"), "range");
+        TCLAP::ValueArg<range> valSizesArg(
+            "v", "value-sizes", "Range of value sizes (e.g. \"32,64\")", false, range("128,256"), "range");
+        TCLAP::ValueArg<std::string> sizeDistributionArg(
+            "d", "size-distribution", "Distribution of sizes (constant, uniform, zipfian)", false, "uniform", "string");
+        TCLAP::ValueArg<size_t> numItemsArg(
+            "n", "num-items", "Number of items", false, 100000, "integer");
+        TCLAP::ValueArg<unsigned> numThreadsArg(
+            "t", "threads", "Number of threads (execution streams)", false, 1, "integer");
+        TCLAP::ValueArg<unsigned> batchSizeArg(
+            "", "batch-size", "Number of items per call", false, 1, "integer");
+        TCLAP::ValueArg<unsigned> repetitionsArg(
+            "r", "repetitions", "Number of repetitions of the benchmark", false, 1, "integer");
+        TCLAP::ValueArg<unsigned> seedArg(
+            "s", "seed", "RNG seed", false, 1234, "integer");
+
+        cmd.add(backendsArg);
+        cmd.add(operationsArg);
+        cmd.add(configsArg);
+        cmd.add(pathArg);
+        cmd.add(keySizesArg);
+        cmd.add(valSizesArg);
+        cmd.add(sizeDistributionArg);
+        cmd.add(numItemsArg);
+        cmd.add(numThreadsArg);
+        cmd.add(batchSizeArg);
+        cmd.add(repetitionsArg);
+        cmd.add(seedArg);
+
+        cmd.parse(argc, argv);
+
+        opt.backends          = backendsArg.isSet() ? split(backendsArg.getValue())
+                                                    : default_backends;
+        opt.operations        = operationsArg.isSet() ? split(operationsArg.getValue())
+                                                      : all_operations;
+        opt.configs           = configsArg.getValue();
+        opt.path              = pathArg.getValue();
+        opt.key_sizes         = keySizesArg.getValue();
+        opt.val_sizes         = valSizesArg.getValue();
+        opt.size_distribution = sizeDistributionArg.getValue();
+        opt.num_items         = numItemsArg.getValue();
+        opt.num_threads       = numThreadsArg.getValue();
+        opt.batch_size        = batchSizeArg.getValue();
+        opt.repetitions       = repetitionsArg.getValue();
+        opt.seed              = seedArg.getValue();
+
+        for(auto& op : opt.operations) {
+            if(std::find(all_operations.begin(), all_operations.end(), op) == all_operations.end())
+                throw TCLAP::ArgException("Unknown operation " + op, "operations", "Invalid value");
+        }
+        if(opt.num_threads == 0)
+            throw TCLAP::ArgException("Value should be at least 1", "threads", "Invalid value");
+        if(opt.batch_size == 0)
+            throw TCLAP::ArgException("Value should be at least 1", "batch-size", "Invalid value");
+        if(opt.key_sizes.min < 8)
+            throw TCLAP::ArgException("Keys should be at least 8 bytes", "key-sizes", "Invalid value");
+        if(opt.size_distribution != "constant" && opt.size_distribution != "uniform"
+        && opt.size_distribution != "zipfian")
+            throw TCLAP::ArgException("Unknown distribution", "size-distribution", "Invalid value");
+
+    } catch(TCLAP::ArgException &e) {
+        std::cerr << e.what() << std::endl;
+        exit(-1);
+    }
+    return opt;
+}
@@ -1,14 +1,27 @@
 #include <yokan/cxx/client.hpp>
 #include <yokan/cxx/collection.hpp>
+#include <yokan/cxx/server.hpp>
 #include <tclap/CmdLine.h>
+#include <nlohmann/json.hpp>
 #include <functional>
 #include <unordered_map>
 #include <fstream>
+#include <cstring>
 #include <iostream>
 #include <regex>
 #include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+#include <array>
+#include "distributions.hpp"
+#ifdef YOKAN_BENCHMARK_HAS_MPI
+#include <mpi.h>
+#endif
 
 using namespace std::string_literals;
+using json = nlohmann::json;
 
 static std::string gen_random_string(size_t len)
 {
@@ -34,8 +47,11 @@ struct range : public TCLAP::StringLikeTrait {
         std::smatch matches;
         if(std::regex_search(str, matches, rgx)) {
             min = atol(matches[1].str().c_str());
+            max = min;
             if(!matches[4].str().empty())
-                max = atol(matches[1].str().c_str());
+                max = atol(matches[4].str().c_str());
+            if(max < min)
+                throw TCLAP::ArgParseException("invalid range \""s + str + "\"");
         } else {
             throw TCLAP::ArgParseException("invalid range format \""s + str + "\"");
         }
@@ -49,7 +65,6 @@ struct options {
     size_t      num_items;
     unsigned    seed;
     unsigned    repetitions;
-    std::string database_id;
     std::string margo_config;
     std::string server_address;
     uint16_t    provider_id;
@@ -58,6 +73,18 @@ struct options {
     bool        no_remove;
     bool        no_rdma;
     unsigned    batch_size;
+    unsigned    num_clients;
+    unsigned    num_xstreams;
+    double      rate;
+    std::string workload;
+    unsigned    pipeline_size;
+    std::vector<unsigned> sweep;
+    margo_instance_id mid = MARGO_INSTANCE_NULL;
+    std::string backend;
+    std::string backend_config;
+    std::string format;
+    std::string output;
+    std::string collection = "bench";
 };
 
 void fill_reference_map(const options& opt, std::unordered_map<std::string, std::string>& map) {
@@ -130,7 +157,12 @@ void put_keys_into_database(const std::shared_ptr<yokan::Database>& db,
 
 class Benchmark {
 
-    options m_opt;
+    using clock = std::chrono::steady_clock;
+
+    options                                    m_opt;
+    std::map<std::string, std::vector<double>> m_latencies; // in seconds
+    double                                     m_interval = 0.0;
+    clock::time_point                          m_next_op;
 
     public:
 
@@ -146,6 +178,83 @@ class Benchmark {
         return m_opt;
     }
 
+    /**
+     * @brief Names of the operations for which latencies are reported.
+     * Single-operation benchmarks report under the name of the benchmark.
+     */
+    virtual std::vector<std::string> operations() const {
+        return {m_opt.operation};
+    }
+
+    /**
+     * @brief Benchmark-specific parameters to report along with the results.
+     */
+    virtual json config() const {
+        return json::object();
+    }
+
+    /**
+     * @brief Benchmark-specific results derived from the latencies of all
+     * the clients and repetitions, to report along with the statistics.
+     */
+    virtual json summarize(const std::map<std::string, std::vector<double>>& latencies) const {
+        (void)latencies;
+        return json::object();
+    }
+
+    /**
+     * @brief Prepare for a call to run(). If rate is positive, operations
+     * issued via measure() are paced at that rate (in operations per second),
+     * otherwise they are issued back to back.
+     */
+    void start(double rate) {
+        m_latencies.clear();
+        for(auto& op : operations())
+            m_latencies[op].clear();
+        m_interval = rate > 0.0 ? 1.0/rate : 0.0;
+        m_next_op  = clock::now();
+    }
+
+    /**
+     * @brief Latencies (in seconds) of the operations issued via measure()
+     * since the last call to start(), by operation name.
+     */
+    const std::map<std::string, std::vector<double>>& getLatencies() const {
+        return m_latencies;
+    }
+
+    protected:
+
+    /**
+     * @brief Run an operation and record its latency. When the benchmark is
+     * paced, the operation waits for its scheduled time and its latency is
+     * measured from that time, so that time spent queuing behind slow
+     * operations is accounted for (avoiding coordinated omission).
+     */
+    template<typename Operation>
+    void measure(Operation&& op) {
+        measure(m_opt.operation, std::forward<Operation>(op));
+    }
+
+    template<typename Operation>
+    void measure(const std::string& name, Operation&& op) {
+        auto start = clock::now();
+        if(m_interval > 0.0) {
+            while(start < m_next_op) {
+                ABT_thread_yield();
+                start = clock::now();
+            }
+            start = m_next_op;
+            m_next_op += std::chrono::duration_cast<clock::duration>(
+                std::chrono::duration<double>(m_interval));
+        }
+        op();
+        m_latencies[name].push_back(
+            std::chrono::duration<double>(clock::now() - start).count());
+    }
+
+    public:
+
     using BenchmarkFactory = std::function<std::unique_ptr<Benchmark>(std::shared_ptr<yokan::Database>, const options&)>;
     static std::unordered_map<std::string, BenchmarkFactory> factories;
 };
@@ -183,11 +292,13 @@ class PutBenchmark : public Benchmark {
     void setUp() override {}
 
     void run() override {
-        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_DEFAULT : YOKAN_MODE_NO_RDMA;
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
         for(auto& pair : m_ref) {
-            m_db->put(pair.first.data(), pair.first.size(),
-                      pair.second.data(), pair.second.size(),
-                      mode);
+            measure([&]() {
+                m_db->put(pair.first.data(), pair.first.size(),
+                          pair.second.data(), pair.second.size(),
+                          mode);
+            });
         }
     }
 
@@ -223,7 +334,7 @@ class PutMultiBenchmark : public Benchmark {
         m_batches.resize((m_ref.size() + batch_size - 1) / batch_size);
         unsigned i = 0;
         for(auto& pair : m_ref) {
-            unsigned k = i % batch_size;
+            unsigned k = i/batch_size;
             auto& batch = m_batches[k];
             std::get<0>(batch).push_back(pair.first.data());
             std::get<1>(batch).push_back(pair.first.size());
@@ -234,14 +345,16 @@ class PutMultiBenchmark : public Benchmark {
     }
 
     void run() override {
-        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_DEFAULT : YOKAN_MODE_NO_RDMA;
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
         for(auto& batch : m_batches) {
             const auto& kptrs = std::get<0>(batch);
             const auto& ksize = std::get<1>(batch);
             const auto& vptrs = std::get<2>(batch);
             const auto& vsize = std::get<3>(batch);
-            m_db->putMulti(kptrs.size(), kptrs.data(), ksize.data(),
-                           vptrs.data(), vsize.data(), mode);
+            measure([&]() {
+                m_db->putMulti(kptrs.size(), kptrs.data(), ksize.data(),
+                               vptrs.data(), vsize.data(), mode);
+            });
         }
     }
 
@@ -288,14 +401,16 @@ class PutPackedBenchmark : public Benchmark {
     }
 
     void run() override {
-        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_DEFAULT : YOKAN_MODE_NO_RDMA;
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
         for(auto& batch : m_batches) {
             const auto& keys  = std::get<0>(batch);
             const auto& ksize = std::get<1>(batch);
             const auto& vals  = std::get<2>(batch);
             const auto& vsize = std::get<3>(batch);
-            m_db->putPacked(ksize.size(), keys.data(), ksize.data(),
-                            vals.data(), vsize.data(), mode);
+            measure([&]() {
+                m_db->putPacked(ksize.size(), keys.data(), ksize.data(),
+                                vals.data(), vsize.data(), mode);
+            });
         }
     }
 
@@ -328,12 +443,14 @@ class GetBenchmark : public Benchmark {
     }
 
     void run() override {
-        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_DEFAULT : YOKAN_MODE_NO_RDMA;
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
         size_t vsize;
         for(auto& pair : m_ref) {
             vsize = m_buffer.size();
-            m_db->get(pair.first.data(), pair.first.size(),
-                      m_buffer.data(), &vsize, mode);
+            measure([&]() {
+                m_db->get(pair.first.data(), pair.first.size(),
+                          m_buffer.data(), &vsize, mode);
+            });
         }
     }
 
@@ -373,7 +490,7 @@ class GetMultiBenchmark : public Benchmark {
         unsigned i = 0;
         auto& opt = getOptions();
         for(auto& pair : m_ref) {
-            unsigned k = i % batch_size;
+            unsigned k = i/batch_size;
             auto& batch = m_batches[k];
             auto& buffer = m_buffers[k];
             if(buffer.size() == 0)
@@ -388,14 +505,16 @@ class GetMultiBenchmark : public Benchmark {
     }
 
     void run() override {
-        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_DEFAULT : YOKAN_MODE_NO_RDMA;
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
         for(auto& batch : m_batches) {
             const auto& kptrs = std::get<0>(batch);
             const auto& ksize = std::get<1>(batch);
             auto& vptrs = std::get<2>(batch);
             auto& vsize = std::get<3>(batch);
-            m_db->getMulti(kptrs.size(), kptrs.data(), ksize.data(),
-                           vptrs.data(), vsize.data(), mode);
+            measure([&]() {
+                m_db->getMulti(kptrs.size(), kptrs.data(), ksize.data(),
+                               vptrs.data(), vsize.data(), mode);
+            });
         }
     }
 
@@ -445,13 +564,15 @@ class GetPackedBenchmark : public Benchmark {
     }
 
     void run() override {
-        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_DEFAULT : YOKAN_MODE_NO_RDMA;
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
         for(auto& batch : m_batches) {
             const auto& keys  = std::get<0>(batch);
             const auto& ksize = std::get<1>(batch);
-            m_db->getPacked(ksize.size(), keys.data(), ksize.data(),
-                            m_buffer.size(), m_buffer.data(), m_vsizes.data(),
-                            mode);
+            measure([&]() {
+                m_db->getPacked(ksize.size(), keys.data(), ksize.data(),
+                                m_buffer.size(), m_buffer.data(), m_vsizes.data(),
+                                mode);
+            });
         }
     }
 
@@ -481,9 +602,11 @@ class LengthBenchmark : public Benchmark {
     }
 
     void run() override {
-        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_DEFAULT : YOKAN_MODE_NO_RDMA;
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
         for(auto& pair : m_ref) {
-            m_db->length(pair.first.data(), pair.first.size(), mode);
+            measure([&]() {
+                m_db->length(pair.first.data(), pair.first.size(), mode);
+            });
         }
     }
 
@@ -530,12 +653,14 @@ class LengthMultiBenchmark : public Benchmark {
     }
 
     void run() override {
-        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_DEFAULT : YOKAN_MODE_NO_RDMA;
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
         for(auto& batch : m_batches) {
             const auto& kptrs = std::get<0>(batch);
             const auto& ksize = std::get<1>(batch);
-            m_db->lengthMulti(kptrs.size(), kptrs.data(), ksize.data(),
-                              m_vsizes.data(), mode);
+            measure([&]() {
+                m_db->lengthMulti(kptrs.size(), kptrs.data(), ksize.data(),
+                                  m_vsizes.data(), mode);
+            });
         }
     }
 
@@ -582,12 +707,14 @@ class LengthPackedBenchmark : public Benchmark {
     }
 
     void run() override {
-        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_DEFAULT : YOKAN_MODE_NO_RDMA;
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
         for(auto& batch : m_batches) {
             const auto& keys  = std::get<0>(batch);
             const auto& ksize = std::get<1>(batch);
-            m_db->lengthPacked(ksize.size(), keys.data(), ksize.data(),
-                               m_vsizes.data(), mode);
+            measure([&]() {
+                m_db->lengthPacked(ksize.size(), keys.data(), ksize.data(),
+                                   m_vsizes.data(), mode);
+            });
         }
     }
 
@@ -624,9 +751,11 @@ class ExistsBenchmark : public Benchmark {
     }
 
     void run() override {
-        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_DEFAULT : YOKAN_MODE_NO_RDMA;
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
         for(auto& pair : m_ref) {
-            m_db->exists(pair.first.data(), pair.first.size(), mode);
+            measure([&]() {
+                m_db->exists(pair.first.data(), pair.first.size(), mode);
+            });
         }
     }
 
@@ -674,11 +803,13 @@ class ExistsMultiBenchmark : public Benchmark {
     }
 
     void run() override {
-        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_DEFAULT : YOKAN_MODE_NO_RDMA;
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
         for(auto& batch : m_batches) {
             const auto& kptrs = std::get<0>(batch);
             const auto& ksize = std::get<1>(batch);
-            m_db->existsMulti(kptrs.size(), kptrs.data(), ksize.data(), mode);
+            measure([&]() {
+                m_db->existsMulti(kptrs.size(), kptrs.data(), ksize.data(), mode);
+            });
         }
     }
 
@@ -723,11 +854,13 @@ class ExistsPackedBenchmark : public Benchmark {
     }
 
     void run() override {
-        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_DEFAULT : YOKAN_MODE_NO_RDMA;
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
         for(auto& batch : m_batches) {
             const auto& keys  = std::get<0>(batch);
             const auto& ksize = std::get<1>(batch);
-            m_db->existsPacked(ksize.size(), keys.data(), ksize.data(), mode);
+            measure([&]() {
+                m_db->existsPacked(ksize.size(), keys.data(), ksize.data(), mode);
+            });
         }
     }
 
@@ -757,9 +890,11 @@ class EraseBenchmark : public Benchmark {
     }
 
     void run() override {
-        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_DEFAULT : YOKAN_MODE_NO_RDMA;
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
         for(auto& pair : m_ref) {
-            m_db->erase(pair.first.data(), pair.first.size(), mode);
+            measure([&]() {
+                m_db->erase(pair.first.data(), pair.first.size(), mode);
+            });
         }
     }
 
@@ -801,11 +936,13 @@ class EraseMultiBenchmark : public Benchmark {
     }
 
     void run() override {
-        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_DEFAULT : YOKAN_MODE_NO_RDMA;
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
         for(auto& batch : m_batches) {
             const auto& kptrs = std::get<0>(batch);
             const auto& ksize = std::get<1>(batch);
-            m_db->eraseMulti(kptrs.size(), kptrs.data(), ksize.data(), mode);
+            measure([&]() {
+                m_db->eraseMulti(kptrs.size(), kptrs.data(), ksize.data(), mode);
+            });
         }
     }
 
@@ -847,11 +984,13 @@ class ErasePackedBenchmark : public Benchmark {
     }
 
     void run() override {
-        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_DEFAULT : YOKAN_MODE_NO_RDMA;
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
         for(auto& batch : m_batches) {
             const auto& keys  = std::get<0>(batch);
             const auto& ksize = std::get<1>(batch);
-            m_db->erasePacked(ksize.size(), keys.data(), ksize.data(), mode);
+            measure([&]() {
+                m_db->erasePacked(ksize.size(), keys.data(), ksize.data(), mode);
+            });
         }
     }
 
@@ -899,21 +1038,23 @@ class ListKeysBenchmark : public Benchmark {
     }
 
     void run() override {
-        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_DEFAULT : YOKAN_MODE_NO_RDMA;
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
         std::string start_key;
         auto& prefix = getOptions().prefix;
         auto batch_size = getOptions().batch_size;
         for(auto& batch : m_batches) {
             auto& kptrs = std::get<0>(batch);
             auto& ksize = std::get<1>(batch);
-            m_db->listKeys(start_key.data(),
-                           start_key.size(),
-                           prefix.data(),
-                           prefix.size(),
-                           batch_size,
-                           kptrs.data(),
-                           ksize.data(),
-                           mode);
+            measure([&]() {
+                m_db->listKeys(start_key.data(),
+                               start_key.size(),
+                               prefix.data(),
+                               prefix.size(),
+                               batch_size,
+                               kptrs.data(),
+                               ksize.data(),
+                               mode);
+            });
             for(unsigned i = 0; i < batch_size; i++) {
                 if(ksize[i] == YOKAN_NO_MORE_KEYS)
                     return;
@@ -962,22 +1103,24 @@ class ListKeysPackedBenchmark : public Benchmark {
     }
 
     void run() override {
-        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_DEFAULT : YOKAN_MODE_NO_RDMA;
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
         std::string start_key;
         auto& prefix = getOptions().prefix;
         auto batch_size = getOptions().batch_size;
         for(auto& batch : m_batches) {
             auto& keys  = std::get<0>(batch);
             auto& ksize = std::get<1>(batch);
-            m_db->listKeysPacked(start_key.data(),
-                                 start_key.size(),
-                                 prefix.data(),
-                                 prefix.size(),
-                                 batch_size,
-                                 keys.data(),
-                                 keys.size(),
-                                 ksize.data(),
-                                 mode);
+            measure([&]() {
+                m_db->listKeysPacked(start_key.data(),
+                                     start_key.size(),
+                                     prefix.data(),
+                                     prefix.size(),
+                                     batch_size,
+                                     keys.data(),
+                                     keys.size(),
+                                     ksize.data(),
+                                     mode);
+            });
             size_t koffset = 0;
             for(unsigned i = 0; i < batch_size; i++) {
                 if(ksize[i] == YOKAN_NO_MORE_KEYS)
@@ -1041,7 +1184,7 @@ class ListKeyValsBenchmark : public Benchmark {
     }
 
     void run() override {
-        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_DEFAULT : YOKAN_MODE_NO_RDMA;
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
         std::string start_key;
         auto& prefix = getOptions().prefix;
         auto batch_size = getOptions().batch_size;
@@ -1050,16 +1193,18 @@ class ListKeyValsBenchmark : public Benchmark {
             auto& ksize = std::get<1>(batch);
             auto& vptrs = std::get<2>(batch);
             auto& vsize = std::get<3>(batch);
-            m_db->listKeyVals(start_key.data(),
-                              start_key.size(),
-                              prefix.data(),
-                              prefix.size(),
-                              batch_size,
-                              kptrs.data(),
-                              ksize.data(),
-                              vptrs.data(),
-                              vsize.data(),
-                              mode);
+            measure([&]() {
+                m_db->listKeyVals(start_key.data(),
+                                  start_key.size(),
+                                  prefix.data(),
+                                  prefix.size(),
+                                  batch_size,
+                                  kptrs.data(),
+                                  ksize.data(),
+                                  vptrs.data(),
+                                  vsize.data(),
+                                  mode);
+            });
             for(unsigned i = 0; i < batch_size; i++) {
                 if(ksize[i] == YOKAN_NO_MORE_KEYS)
                     return;
@@ -1112,7 +1257,7 @@ class ListKeyValsPackedBenchmark : public Benchmark {
     }
 
     void run() override {
-        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_DEFAULT : YOKAN_MODE_NO_RDMA;
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
         std::string start_key;
         auto& prefix = getOptions().prefix;
         auto batch_size = getOptions().batch_size;
@@ -1121,18 +1266,20 @@ class ListKeyValsPackedBenchmark : public Benchmark {
             auto& ksize = std::get<1>(batch);
             auto& vals  = std::get<2>(batch);
             auto& vsize = std::get<3>(batch);
-            m_db->listKeyValsPacked(start_key.data(),
-                                    start_key.size(),
-                                    prefix.data(),
-                                    prefix.size(),
-                                    batch_size,
-                                    keys.data(),
-                                    keys.size(),
-                                    ksize.data(),
-                                    vals.data(),
-                                    vals.size(),
-                                    vsize.data(),
-                                    mode);
+            measure([&]() {
+                m_db->listKeyValsPacked(start_key.data(),
+                                        start_key.size(),
+                                        prefix.data(),
+                                        prefix.size(),
+                                        batch_size,
+                                        keys.data(),
+                                        keys.size(),
+                                        ksize.data(),
+                                        vals.data(),
+                                        vals.size(),
+                                        vsize.data(),
+                                        mode);
+            });
             size_t koffset = 0;
             for(unsigned i = 0; i < batch_size; i++) {
                 if(ksize[i] == YOKAN_NO_MORE_KEYS)
@@ -1164,23 +1311,25 @@ class StoreBenchmark : public Benchmark {
 
     StoreBenchmark(std::shared_ptr<yokan::Database> db, const options& opt)
     : Benchmark(opt), m_db(std::move(db)),
-      m_coll(std::make_shared<yokan::Collection>("bench", *m_db)) {
+      m_coll(std::make_shared<yokan::Collection>(opt.collection.c_str(), *m_db)) {
         fill_reference_vector(opt, m_ref);
     }
 
     void setUp() override {
-        m_db->createCollection("bench");
+        m_db->createCollection(getOptions().collection.c_str());
     }
 
     void run() override {
-        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_DEFAULT : YOKAN_MODE_NO_RDMA;
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
         for(auto& doc : m_ref) {
-            m_coll->store(doc.data(), doc.size(), mode);
+            measure([&]() {
+                m_coll->store(doc.data(), doc.size(), mode);
+            });
         }
     }
 
     void tearDown() override {
-        m_db->dropCollection("bench");
+        m_db->dropCollection(getOptions().collection.c_str());
     }
 };
 REGISTER_BENCHMARK(StoreBenchmark, store);
@@ -1202,7 +1351,7 @@ class StoreMultiBenchmark : public Benchmark {
 
     StoreMultiBenchmark(std::shared_ptr<yokan::Database> db, const options& opt)
     : Benchmark(opt), m_db(std::move(db)),
-      m_coll(std::make_shared<yokan::Collection>("bench", *m_db)) {
+      m_coll(std::make_shared<yokan::Collection>(opt.collection.c_str(), *m_db)) {
         fill_reference_vector(opt, m_ref);
     }
 
@@ -1212,29 +1361,31 @@ class StoreMultiBenchmark : public Benchmark {
         m_batches.resize((m_ref.size() + batch_size - 1) / batch_size);
         unsigned i = 0;
         for(auto& doc : m_ref) {
-            unsigned k = i % batch_size;
+            unsigned k = i/batch_size;
             auto& batch = m_batches[k];
             std::get<0>(batch).push_back(-1);
             std::get<1>(batch).push_back(doc.data());
             std::get<2>(batch).push_back(doc.size());
             i += 1;
         }
-        m_db->createCollection("bench");
+        m_db->createCollection(getOptions().collection.c_str());
     }
 
     void run() override {
-        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_DEFAULT : YOKAN_MODE_NO_RDMA;
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
         for(auto& batch : m_batches) {
             auto& ids   = std::get<0>(batch);
             const auto& vptrs = std::get<1>(batch);
             const auto& vsize = std::get<2>(batch);
             auto count = vsize.size();
-            m_coll->storeMulti(count, vptrs.data(), vsize.data(), ids.data(), mode);
+            measure([&]() {
+                m_coll->storeMulti(count, vptrs.data(), vsize.data(), ids.data(), mode);
+            });
         }
     }
 
     void tearDown() override {
-        m_db->dropCollection("bench");
+        m_db->dropCollection(getOptions().collection.c_str());
     }
 };
 REGISTER_BENCHMARK(StoreMultiBenchmark, store_multi);
@@ -1256,7 +1407,7 @@ class StorePackedBenchmark : public Benchmark {
 
     StorePackedBenchmark(std::shared_ptr<yokan::Database> db, const options& opt)
     : Benchmark(opt), m_db(std::move(db)),
-      m_coll(std::make_shared<yokan::Collection>("bench", *m_db)) {
+      m_coll(std::make_shared<yokan::Collection>(opt.collection.c_str(), *m_db)) {
         fill_reference_vector(opt, m_ref);
     }
 
@@ -1273,209 +1424,2055 @@ class StorePackedBenchmark : public Benchmark {
             std::get<2>(batch).push_back(doc.size());
             i += 1;
         }
-        m_db->createCollection("bench");
+        m_db->createCollection(getOptions().collection.c_str());
     }
 
     void run() override {
-        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_DEFAULT : YOKAN_MODE_NO_RDMA;
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
         for(auto& batch : m_batches) {
             auto& ids   = std::get<0>(batch);
             const auto& vals  = std::get<1>(batch);
             const auto& vsize = std::get<2>(batch);
             auto count = ids.size();
-            m_coll->storePacked(count, vals.data(), vsize.data(),
-                                ids.data(), mode);
+            measure([&]() {
+                m_coll->storePacked(count, vals.data(), vsize.data(),
+                                    ids.data(), mode);
+            });
         }
     }
 
     void tearDown() override {
-        m_db->dropCollection("bench");
+        m_db->dropCollection(getOptions().collection.c_str());
     }
 };
 REGISTER_BENCHMARK(StorePackedBenchmark, store_packed);
 
-static options parse_arguments(int argc, char** argv);
+/**
+ * @brief Key/value pairs packed in batches of batch_size items
+ * (all the items in a single batch if batch_size is 0).
+ */
+struct packed_batch {
+    std::string         keys;
+    std::vector<size_t> ksizes;
+    std::string         vals;
+    std::vector<size_t> vsizes;
+};
 
-int main(int argc, char** argv) {
-    auto opt = parse_arguments(argc, argv);
-    srand(opt.seed);
+static std::vector<packed_batch> make_packed_batches(
+        const std::unordered_map<std::string, std::string>& ref,
+        unsigned batch_size) {
+    if(batch_size == 0) batch_size = ref.size();
+    std::vector<packed_batch> batches((ref.size() + batch_size - 1) / batch_size);
+    unsigned i = 0;
+    for(auto& pair : ref) {
+        auto& batch = batches[i/batch_size];
+        batch.keys += pair.first;
+        batch.ksizes.push_back(pair.first.size());
+        batch.vals += pair.second;
+        batch.vsizes.push_back(pair.second.size());
+        i += 1;
+    }
+    return batches;
+}
 
-    std::string protocol;
-    {
-        auto p = opt.server_address.find(":");
-        protocol = opt.server_address.substr(0, p);
+/**
+ * @brief Buffer exposed via a bulk handle, used by the *_bulk
+ * benchmarks. The buffer is built by appending the sections
+ * expected by the corresponding bulk operation.
+ */
+class BulkBuffer {
+
+    margo_instance_id m_mid;
+    std::vector<char> m_data;
+    hg_bulk_t         m_bulk = HG_BULK_NULL;
+
+    public:
+
+    BulkBuffer(margo_instance_id mid)
+    : m_mid(mid) {}
+
+    BulkBuffer(const BulkBuffer&) = delete;
+    BulkBuffer& operator=(const BulkBuffer&) = delete;
+
+    ~BulkBuffer() {
+        if(m_bulk != HG_BULK_NULL)
+            margo_bulk_free(m_bulk);
     }
 
-    std::string margo_config_str;
-    if(!opt.margo_config.empty()) {
-        std::ifstream t(opt.margo_config.c_str());
-        if(!t.good()) {
-            std::cerr << "ERROR: file " << opt.margo_config << " does not exist" << std::endl;
-            exit(-1);
+    template<typename T>
+    void append(const std::vector<T>& v) {
+        append(v.data(), v.size()*sizeof(T));
+    }
+
+    void append(const std::string& s) {
+        append(s.data(), s.size());
+    }
+
+    void append(const void* data, size_t size) {
+        auto ptr = static_cast<const char*>(data);
+        m_data.insert(m_data.end(), ptr, ptr + size);
+    }
+
+    void reserve(size_t size) {
+        m_data.resize(m_data.size() + size);
+    }
+
+    hg_bulk_t expose() {
+        void* ptr = m_data.data();
+        hg_size_t size = m_data.size();
+        hg_return_t hret = margo_bulk_create(
+            m_mid, 1, &ptr, &size, HG_BULK_READWRITE, &m_bulk);
+        if(hret != HG_SUCCESS)
+            throw std::runtime_error("margo_bulk_create failed");
+        return m_bulk;
+    }
+
+    hg_bulk_t handle() const {
+        return m_bulk;
+    }
+
+    size_t size() const {
+        return m_data.size();
+    }
+};
+
+/**
+ * @brief Store the documents of a reference vector in a
+ * collection, returning their ids.
+ */
+static std::vector<yk_id_t> store_docs_into_collection(
+        const yokan::Collection& coll,
+        const std::vector<std::string>& ref) {
+    std::string docs;
+    std::vector<size_t> docsizes;
+    docsizes.reserve(ref.size());
+    for(auto& doc : ref) {
+        docs += doc;
+        docsizes.push_back(doc.size());
+    }
+    std::vector<yk_id_t> ids(ref.size());
+    coll.storePacked(ref.size(), docs.data(), docsizes.data(), ids.data());
+    return ids;
+}
+
+/**
+ * @brief FETCH benchmark
+ */
+class FetchBenchmark : public Benchmark {
+
+    std::unordered_map<std::string, std::string> m_ref;
+    std::shared_ptr<yokan::Database> m_db;
+
+    public:
+
+    FetchBenchmark(std::shared_ptr<yokan::Database> db, const options& opt)
+    : Benchmark(opt), m_db(std::move(db)) {
+        fill_reference_map(opt, m_ref);
+    }
+
+    void setUp() override {
+        put_keys_into_database(m_db, m_ref);
+    }
+
+    void run() override {
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
+        yokan::Database::fetch_callback_type cb =
+            [](size_t, const void*, size_t, const void*, size_t) {
+                return YOKAN_SUCCESS;
+            };
+        for(auto& pair : m_ref) {
+            measure([&]() {
+                m_db->fetch(pair.first.data(), pair.first.size(), cb, mode);
+            });
         }
-        std::stringstream buffer;
-        buffer << t.rdbuf();
-        margo_config_str = buffer.str();
     }
 
-    margo_init_info margo_args;
-    memset(&margo_args, 0, sizeof(margo_args));
-    margo_args.json_config = margo_config_str.c_str();
-    margo_instance_id mid = margo_init_ext(protocol.c_str(),
-                                           MARGO_CLIENT_MODE,
-                                           &margo_args);
-    if(!mid) {
-        std::cerr << "ERROR: could not initialize margo instance" << std::endl;
-        exit(-1);
+    void tearDown() override {
+        remove_keys_from_database(m_db, m_ref);
     }
+};
+REGISTER_BENCHMARK(FetchBenchmark, fetch);
 
-    hg_addr_t svr_addr = HG_ADDR_NULL;
-    hg_return_t hret = margo_addr_lookup(mid, opt.server_address.c_str(), &svr_addr);
-    if(hret != HG_SUCCESS) {
-        std::cerr << "ERROR: could not lookup address " << opt.server_address << std::endl;
-        margo_finalize(mid);
-        exit(-1);
+/**
+ * @brief FETCH-PACKED benchmark. Values are sent back by the
+ * provider in batches of --pipeline-size items.
+ */
+class FetchPackedBenchmark : public Benchmark {
+
+    protected:
+
+    std::unordered_map<std::string, std::string> m_ref;
+    std::shared_ptr<yokan::Database> m_db;
+    std::vector<packed_batch> m_batches;
+
+    void runWith(const std::string& name, unsigned pipeline_size) {
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
+        yk_fetch_options_t options;
+        options.pool       = ABT_POOL_NULL;
+        options.batch_size = pipeline_size;
+        yokan::Database::fetch_callback_type cb =
+            [](size_t, const void*, size_t, const void*, size_t) {
+                return YOKAN_SUCCESS;
+            };
+        for(auto& batch : m_batches) {
+            measure(name, [&]() {
+                m_db->fetchPacked(batch.ksizes.size(), batch.keys.data(),
+                                  batch.ksizes.data(), cb, &options, mode);
+            });
+        }
     }
 
-    yk_database_id_t database_id;
-    yk_database_id_from_string(opt.database_id.c_str(), &database_id);
+    public:
 
-    std::shared_ptr<yokan::Client> client;
-    std::shared_ptr<yokan::Database> database;
+    FetchPackedBenchmark(std::shared_ptr<yokan::Database> db, const options& opt)
+    : Benchmark(opt), m_db(std::move(db)) {
+        fill_reference_map(opt, m_ref);
+    }
 
-    try {
-        client = std::make_shared<yokan::Client>(mid);
-        database = std::make_shared<yokan::Database>(
-            client->makeDatabaseHandle(
-                svr_addr, opt.provider_id, database_id));
-    } catch(const yokan::Exception& ex) {
-        std::cerr << "ERROR: " << ex.what() << std::endl;
-        margo_finalize(mid);
-        exit(-1);
+    void setUp() override {
+        m_batches = make_packed_batches(m_ref, getOptions().batch_size);
+        put_keys_into_database(m_db, m_ref);
     }
 
-    if(Benchmark::factories.count(opt.operation) == 0) {
-        std::cerr << "ERROR: invalid operation " << opt.operation << std::endl;
-        margo_finalize(mid);
-        exit(-1);
+    void run() override {
+        runWith(getOptions().operation, getOptions().pipeline_size);
     }
 
-    {
-        std::vector<double> timings;
-        auto& factory = Benchmark::factories[opt.operation];
-        for(unsigned i = 0; i < opt.repetitions; i++) {
-            auto benchmark = factory(database, opt);
-            benchmark->setUp();
-            std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
-            benchmark->run();
-            std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
-            benchmark->tearDown();
-            timings.push_back(
-                std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count());
-        }
-        double avg = 0.0;
-        double var = 0.0;
-        double min = -1;
-        double max = -1;
-        for(auto& t : timings) {
-            avg += t;
-            var += t*t;
-            if(min < 0 || min > t) min = t;
-            if(max < 0 || max < t) max = t;
-        }
-        avg /= timings.size();
-        var /= timings.size();
-        var -= avg*avg;
-        std::cout << "----- TIMING (milliseconds) ------" << std::endl;
-        std::cout << "AVERAGE  : " << avg << std::endl;
-        std::cout << "VARIANCE : " << var << std::endl;
-        std::cout << "MAXIMUM  : " << max << std::endl;
-        std::cout << "MINIMUM  : " << min << std::endl;
+    void tearDown() override {
+        remove_keys_from_database(m_db, m_ref);
     }
+};
+REGISTER_BENCHMARK(FetchPackedBenchmark, fetch_packed);
 
-    margo_finalize(mid);
-    return 0;
-}
+/**
+ * @brief FETCH-SWEEP benchmark: FETCH-PACKED executed for each of the
+ * pipeline sizes provided with --sweep, reported separately.
+ */
+class FetchSweepBenchmark : public FetchPackedBenchmark {
 
-static options parse_arguments(int argc, char** argv) {
-    options opt;
-    try {
-        TCLAP::CmdLine cmd("Yokan Benchmark", ' ', "0.1");
-        TCLAP::ValueArg<std::string> operationArg(
-            "o", "operation", "Operation to benchmark (e.g. \"store\")", true, "", "string");
-        TCLAP::ValueArg<range> keySizesArg(
-            "k", "key-sizes", "Range of key sizes (e.g. \"32,64\")", true, range(), "range");
-        TCLAP::ValueArg<range> valSizesArg(
-            "v", "value-sizes", "Range of value sizes (e.g. \"32,64\")", true, range(), "range");
-        TCLAP::ValueArg<unsigned> numItemsArg(
-            "n", "num-items", "Number of items", true, 0, "integer");
-        TCLAP::ValueArg<unsigned> seedArg(
-            "s", "seed", "RNG seed", false, 1234, "integer");
-        TCLAP::ValueArg<unsigned> repetitionsArg(
-            "r", "repetitions", "Number of repetitions of the benchmark", false, 1, "integer");
-        TCLAP::ValueArg<std::string> databaseIdArg(
-            "d", "database-id", "Database id", true, "", "uuid");
-        TCLAP::ValueArg<std::string> margoConfigArg(
-            "m", "margo-config", "Margo JSON configuration file", false, "", "filename");
-        TCLAP::ValueArg<std::string> serverAddressArg(
-            "a", "server-address", "Address of the server", true, "", "string");
-        TCLAP::ValueArg<uint16_t> providerIdArg(
-            "p", "provider-id", "Id of the Yokan provider", false, 0, "integer");
-        TCLAP::ValueArg<std::string> prefixArg(
-            "", "prefix", "Prefix to use for some of the keys", false, "", "string");
-        TCLAP::ValueArg<uint16_t> prefixFreqArg(
-            "", "prefix-freq", "Persentage of appearance of the prefix", false, 50, "integer");
-        TCLAP::ValueArg<unsigned> batchSizeArg(
-            "b", "batch-size", "Batch size for operations that acces multiple items", false, 0, "integer");
-        TCLAP::SwitchArg noRemoveArg(
-            "", "no-remove", "Do not remove stored key/value on teardown");
-        TCLAP::SwitchArg noRDMAArg(
-            "", "no-rdma", "Do not use RDMA when possible");
+    public:
 
-        cmd.add(operationArg);
-        cmd.add(keySizesArg);
-        cmd.add(valSizesArg);
-        cmd.add(numItemsArg);
-        cmd.add(seedArg);
-        cmd.add(repetitionsArg);
-        cmd.add(databaseIdArg);
-        cmd.add(margoConfigArg);
-        cmd.add(serverAddressArg);
-        cmd.add(providerIdArg);
-        cmd.add(prefixArg);
-        cmd.add(prefixFreqArg);
-        cmd.add(batchSizeArg);
-        cmd.add(noRemoveArg);
-        cmd.add(noRDMAArg);
+    using FetchPackedBenchmark::FetchPackedBenchmark;
 
-        cmd.parse(argc, argv);
+    std::vector<std::string> operations() const override {
+        std::vector<std::string> result;
+        for(auto s : getOptions().sweep)
+            result.push_back("pipeline_size=" + std::to_string(s));
+        return result;
+    }
 
-        opt.operation      = operationArg.getValue();
-        opt.key_sizes      = keySizesArg.getValue();
-        opt.val_sizes      = valSizesArg.getValue();
-        opt.num_items      = numItemsArg.getValue();
-        opt.seed           = seedArg.getValue();
-        opt.repetitions    = repetitionsArg.getValue();
-        opt.database_id    = databaseIdArg.getValue();
-        opt.margo_config   = margoConfigArg.getValue();
-        opt.server_address = serverAddressArg.getValue();
-        opt.provider_id    = providerIdArg.getValue();
-        opt.prefix         = prefixArg.getValue();
-        opt.prefix_freq    = prefixFreqArg.getValue();
-        opt.batch_size     = batchSizeArg.getValue();
-        opt.no_remove      = noRemoveArg.getValue();
-        opt.no_rdma        = noRDMAArg.getValue();
+    void run() override {
+        for(auto s : getOptions().sweep)
+            runWith("pipeline_size=" + std::to_string(s), s);
+    }
+};
+REGISTER_BENCHMARK(FetchSweepBenchmark, fetch_sweep);
 
-        if(opt.prefix_freq > 100) {
-            throw TCLAP::ArgException(
-                "Value should be between 0 and 100",
-                "prefix-freq", "Invalid value");
+/**
+ * @brief FETCH-BULK benchmark
+ */
+class FetchBulkBenchmark : public Benchmark {
+
+    std::unordered_map<std::string, std::string> m_ref;
+    std::shared_ptr<yokan::Database> m_db;
+    std::vector<std::unique_ptr<BulkBuffer>> m_bulks;
+
+    public:
+
+    FetchBulkBenchmark(std::shared_ptr<yokan::Database> db, const options& opt)
+    : Benchmark(opt), m_db(std::move(db)) {
+        fill_reference_map(opt, m_ref);
+    }
+
+    void setUp() override {
+        // bulk layout: key sizes, keys
+        for(auto& batch : make_packed_batches(m_ref, getOptions().batch_size)) {
+            auto bulk = std::make_unique<BulkBuffer>(getOptions().mid);
+            bulk->append(batch.ksizes);
+            bulk->append(batch.keys);
+            bulk->expose();
+            m_bulks.push_back(std::move(bulk));
+        }
+        put_keys_into_database(m_db, m_ref);
+    }
+
+    void run() override {
+        yk_fetch_options_t options;
+        options.pool       = ABT_POOL_NULL;
+        options.batch_size = getOptions().pipeline_size;
+        yokan::Database::fetch_callback_type cb =
+            [](size_t, const void*, size_t, const void*, size_t) {
+                return YOKAN_SUCCESS;
+            };
+        auto batch_size = getOptions().batch_size ? getOptions().batch_size : m_ref.size();
+        for(size_t i = 0; i < m_bulks.size(); i++) {
+            auto count = std::min<size_t>(batch_size, m_ref.size() - i*batch_size);
+            auto& bulk = m_bulks[i];
+            measure([&]() {
+                m_db->fetchBulk(count, nullptr, bulk->handle(), 0, bulk->size(),
+                                cb, &options);
+            });
+        }
+    }
+
+    void tearDown() override {
+        m_bulks.clear();
+        remove_keys_from_database(m_db, m_ref);
+    }
+};
+REGISTER_BENCHMARK(FetchBulkBenchmark, fetch_bulk);
+
+/**
+ * @brief PUT-BULK benchmark
+ */
+class PutBulkBenchmark : public Benchmark {
+
+    std::unordered_map<std::string, std::string> m_ref;
+    std::shared_ptr<yokan::Database> m_db;
+    std::vector<std::unique_ptr<BulkBuffer>> m_bulks;
+    std::vector<size_t> m_counts;
+
+    public:
+
+    PutBulkBenchmark(std::shared_ptr<yokan::Database> db, const options& opt)
+    : Benchmark(opt), m_db(std::move(db)) {
+        fill_reference_map(opt, m_ref);
+    }
+
+    void setUp() override {
+        // bulk layout: key sizes, value sizes, keys, values
+        for(auto& batch : make_packed_batches(m_ref, getOptions().batch_size)) {
+            auto bulk = std::make_unique<BulkBuffer>(getOptions().mid);
+            bulk->append(batch.ksizes);
+            bulk->append(batch.vsizes);
+            bulk->append(batch.keys);
+            bulk->append(batch.vals);
+            bulk->expose();
+            m_bulks.push_back(std::move(bulk));
+            m_counts.push_back(batch.ksizes.size());
+        }
+    }
+
+    void run() override {
+        for(size_t i = 0; i < m_bulks.size(); i++) {
+            auto& bulk = m_bulks[i];
+            measure([&]() {
+                m_db->putBulk(m_counts[i], nullptr, bulk->handle(), 0, bulk->size());
+            });
+        }
+    }
+
+    void tearDown() override {
+        m_bulks.clear();
+        m_counts.clear();
+        remove_keys_from_database(m_db, m_ref);
+    }
+};
+REGISTER_BENCHMARK(PutBulkBenchmark, put_bulk);
+
+/**
+ * @brief GET-BULK benchmark
+ */
+class GetBulkBenchmark : public Benchmark {
+
+    std::unordered_map<std::string, std::string> m_ref;
+    std::shared_ptr<yokan::Database> m_db;
+    std::vector<std::unique_ptr<BulkBuffer>> m_bulks;
+    std::vector<size_t> m_counts;
+
+    public:
+
+    GetBulkBenchmark(std::shared_ptr<yokan::Database> db, const options& opt)
+    : Benchmark(opt), m_db(std::move(db)) {
+        fill_reference_map(opt, m_ref);
+    }
+
+    void setUp() override {
+        // bulk layout: key sizes, value sizes, keys, packed values
+        auto& opt = getOptions();
+        for(auto& batch : make_packed_batches(m_ref, opt.batch_size)) {
+            auto bulk = std::make_unique<BulkBuffer>(opt.mid);
+            bulk->append(batch.ksizes);
+            bulk->reserve(batch.ksizes.size()*sizeof(size_t));
+            bulk->append(batch.keys);
+            bulk->reserve(batch.ksizes.size()*opt.val_sizes.max);
+            bulk->expose();
+            m_bulks.push_back(std::move(bulk));
+            m_counts.push_back(batch.ksizes.size());
+        }
+        put_keys_into_database(m_db, m_ref);
+    }
+
+    void run() override {
+        for(size_t i = 0; i < m_bulks.size(); i++) {
+            auto& bulk = m_bulks[i];
+            measure([&]() {
+                m_db->getBulk(m_counts[i], nullptr, bulk->handle(), 0, bulk->size(), true);
+            });
+        }
+    }
+
+    void tearDown() override {
+        m_bulks.clear();
+        m_counts.clear();
+        remove_keys_from_database(m_db, m_ref);
+    }
+};
+REGISTER_BENCHMARK(GetBulkBenchmark, get_bulk);
+
+/**
+ * @brief ERASE-BULK benchmark
+ */
+class EraseBulkBenchmark : public Benchmark {
+
+    std::unordered_map<std::string, std::string> m_ref;
+    std::shared_ptr<yokan::Database> m_db;
+    std::vector<std::unique_ptr<BulkBuffer>> m_bulks;
+    std::vector<size_t> m_counts;
+
+    public:
+
+    EraseBulkBenchmark(std::shared_ptr<yokan::Database> db, const options& opt)
+    : Benchmark(opt), m_db(std::move(db)) {
+        fill_reference_map(opt, m_ref);
+    }
+
+    void setUp() override {
+        // bulk layout: key sizes, keys
+        for(auto& batch : make_packed_batches(m_ref, getOptions().batch_size)) {
+            auto bulk = std::make_unique<BulkBuffer>(getOptions().mid);
+            bulk->append(batch.ksizes);
+            bulk->append(batch.keys);
+            bulk->expose();
+            m_bulks.push_back(std::move(bulk));
+            m_counts.push_back(batch.ksizes.size());
+        }
+        put_keys_into_database(m_db, m_ref);
+    }
+
+    void run() override {
+        for(size_t i = 0; i < m_bulks.size(); i++) {
+            auto& bulk = m_bulks[i];
+            measure([&]() {
+                m_db->eraseBulk(m_counts[i], nullptr, bulk->handle(), 0, bulk->size());
+            });
+        }
+    }
+
+    void tearDown() override {
+        m_bulks.clear();
+        m_counts.clear();
+    }
+};
+REGISTER_BENCHMARK(EraseBulkBenchmark, erase_bulk);
+
+/**
+ * @brief ERASE-RANGE benchmark. Keys are split into groups of batch_size
+ * keys sharing a distinct prefix, and each group is erased with a single
+ * call to eraseRange.
+ */
+class EraseRangeBenchmark : public Benchmark {
+
+    std::unordered_map<std::string, std::string> m_ref;
+    std::shared_ptr<yokan::Database> m_db;
+    std::vector<std::string> m_prefixes;
+
+    public:
+
+    EraseRangeBenchmark(std::shared_ptr<yokan::Database> db, const options& opt)
+    : Benchmark(opt), m_db(std::move(db)) {
+        std::unordered_map<std::string, std::string> ref;
+        fill_reference_map(opt, ref);
+        unsigned batch_size = opt.batch_size ? opt.batch_size : ref.size();
+        auto num_groups = (ref.size() + batch_size - 1) / batch_size;
+        auto width = std::to_string(num_groups).size();
+        for(size_t g = 0; g < num_groups; g++) {
+            auto id = std::to_string(g);
+            m_prefixes.push_back(opt.prefix + std::string(width - id.size(), '0') + id + "/");
+        }
+        unsigned i = 0;
+        for(auto& pair : ref) {
+            m_ref.emplace(m_prefixes[i/batch_size] + pair.first, pair.second);
+            i += 1;
+        }
+    }
+
+    void setUp() override {
+        put_keys_into_database(m_db, m_ref);
+    }
+
+    void run() override {
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
+        for(auto& prefix : m_prefixes) {
+            measure([&]() {
+                m_db->eraseRange(prefix.data(), prefix.size(), mode);
+            });
+        }
+    }
+
+    void tearDown() override {}
+};
+REGISTER_BENCHMARK(EraseRangeBenchmark, erase_range);
+
+/**
+ * @brief ITER benchmark. Iterates over the whole database, requesting
+ * batch_size items per call (all the items if batch_size is 0). Items
+ * are sent back by the provider in batches of --pipeline-size items.
+ */
+class IterBenchmark : public Benchmark {
+
+    protected:
+
+    std::unordered_map<std::string, std::string> m_ref;
+    std::shared_ptr<yokan::Database> m_db;
+
+    void runWith(const std::string& name, unsigned pipeline_size) {
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
+        auto& prefix = getOptions().prefix;
+        size_t count = getOptions().batch_size;
+        yk_iter_options_t options;
+        options.batch_size    = pipeline_size;
+        options.pool          = ABT_POOL_NULL;
+        options.ignore_values = false;
+        std::string start_key;
+        size_t num_items = 0;
+        yokan::Database::iter_callback_type cb =
+            [&](size_t index, const void* key, size_t ksize, const void*, size_t) {
+                num_items += 1;
+                if(index + 1 == count)
+                    start_key.assign(static_cast<const char*>(key), ksize);
+                return YOKAN_SUCCESS;
+            };
+        do {
+            num_items = 0;
+            measure(name, [&]() {
+                m_db->iter(start_key.data(), start_key.size(),
+                           prefix.data(), prefix.size(),
+                           count, cb, &options, mode);
+            });
+        } while(count != 0 && num_items == count);
+    }
+
+    public:
+
+    IterBenchmark(std::shared_ptr<yokan::Database> db, const options& opt)
+    : Benchmark(opt), m_db(std::move(db)) {
+        fill_reference_map(opt, m_ref);
+    }
+
+    void setUp() override {
+        put_keys_into_database(m_db, m_ref);
+    }
+
+    void run() override {
+        runWith(getOptions().operation, getOptions().pipeline_size);
+    }
+
+    void tearDown() override {
+        remove_keys_from_database(m_db, m_ref);
+    }
+};
+REGISTER_BENCHMARK(IterBenchmark, iter);
+
+/**
+ * @brief ITER-SWEEP benchmark: ITER executed for each of the
+ * pipeline sizes provided with --sweep, reported separately.
+ */
+class IterSweepBenchmark : public IterBenchmark {
+
+    public:
+
+    using IterBenchmark::IterBenchmark;
+
+    std::vector<std::string> operations() const override {
+        std::vector<std::string> result;
+        for(auto s : getOptions().sweep)
+            result.push_back("pipeline_size=" + std::to_string(s));
+        return result;
+    }
+
+    void run() override {
+        for(auto s : getOptions().sweep)
+            runWith("pipeline_size=" + std::to_string(s), s);
+    }
+};
+REGISTER_BENCHMARK(IterSweepBenchmark, iter_sweep);
+
+/**
+ * @brief Base class for the benchmarks that work on documents stored
+ * in the collection during setUp (LOAD, DOC-FETCH, DOC-LIST, UPDATE, etc.).
+ */
+class StoredDocsBenchmark : public Benchmark {
+
+    protected:
+
+    std::vector<std::string> m_ref;
+    std::shared_ptr<yokan::Database> m_db;
+    std::shared_ptr<yokan::Collection> m_coll;
+    std::vector<yk_id_t> m_ids;
+
+    public:
+
+    StoredDocsBenchmark(std::shared_ptr<yokan::Database> db, const options& opt)
+    : Benchmark(opt), m_db(std::move(db)),
+      m_coll(std::make_shared<yokan::Collection>(opt.collection.c_str(), *m_db)) {
+        fill_reference_vector(opt, m_ref);
+    }
+
+    void setUp() override {
+        m_db->createCollection(getOptions().collection.c_str());
+        m_ids = store_docs_into_collection(*m_coll, m_ref);
+    }
+
+    void tearDown() override {
+        m_db->dropCollection(getOptions().collection.c_str());
+    }
+
+    protected:
+
+    size_t batchSize() const {
+        return getOptions().batch_size ? getOptions().batch_size : m_ref.size();
+    }
+};
+
+/**
+ * @brief LOAD benchmark
+ */
+class LoadBenchmark : public StoredDocsBenchmark {
+
+    std::vector<char> m_buffer;
+
+    public:
+
+    using StoredDocsBenchmark::StoredDocsBenchmark;
+
+    void run() override {
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
+        m_buffer.resize(getOptions().val_sizes.max);
+        for(auto id : m_ids) {
+            size_t size = m_buffer.size();
+            measure([&]() {
+                m_coll->load(id, m_buffer.data(), &size, mode);
+            });
+        }
+    }
+};
+REGISTER_BENCHMARK(LoadBenchmark, load);
+
+/**
+ * @brief LOAD-PACKED benchmark
+ */
+class LoadPackedBenchmark : public StoredDocsBenchmark {
+
+    std::vector<char> m_buffer;
+    std::vector<size_t> m_sizes;
+
+    public:
+
+    using StoredDocsBenchmark::StoredDocsBenchmark;
+
+    void run() override {
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
+        auto batch_size = batchSize();
+        m_buffer.resize(batch_size*getOptions().val_sizes.max);
+        m_sizes.resize(batch_size);
+        for(size_t i = 0; i < m_ids.size(); i += batch_size) {
+            auto count = std::min(batch_size, m_ids.size() - i);
+            measure([&]() {
+                m_coll->loadPacked(count, m_ids.data() + i, m_buffer.size(),
+                                   m_buffer.data(), m_sizes.data(), mode);
+            });
+        }
+    }
+};
+REGISTER_BENCHMARK(LoadPackedBenchmark, load_packed);
+
+/**
+ * @brief LOAD-BULK benchmark
+ */
+class LoadBulkBenchmark : public StoredDocsBenchmark {
+
+    std::vector<std::unique_ptr<BulkBuffer>> m_bulks;
+
+    public:
+
+    using StoredDocsBenchmark::StoredDocsBenchmark;
+
+    void setUp() override {
+        StoredDocsBenchmark::setUp();
+        // bulk layout: document sizes, packed documents
+        auto batch_size = batchSize();
+        for(size_t i = 0; i < m_ids.size(); i += batch_size) {
+            auto count = std::min(batch_size, m_ids.size() - i);
+            auto bulk = std::make_unique<BulkBuffer>(getOptions().mid);
+            bulk->reserve(count*sizeof(size_t));
+            bulk->reserve(count*getOptions().val_sizes.max);
+            bulk->expose();
+            m_bulks.push_back(std::move(bulk));
+        }
+    }
+
+    void run() override {
+        auto batch_size = batchSize();
+        for(size_t i = 0; i < m_bulks.size(); i++) {
+            auto count = std::min(batch_size, m_ids.size() - i*batch_size);
+            auto& bulk = m_bulks[i];
+            measure([&]() {
+                m_coll->loadBulk(count, m_ids.data() + i*batch_size,
+                                 bulk->handle(), 0, bulk->size(), true);
+            });
+        }
+    }
+
+    void tearDown() override {
+        m_bulks.clear();
+        StoredDocsBenchmark::tearDown();
+    }
+};
+REGISTER_BENCHMARK(LoadBulkBenchmark, load_bulk);
+
+/**
+ * @brief DOC-FETCH benchmark
+ */
+class DocFetchBenchmark : public StoredDocsBenchmark {
+
+    public:
+
+    using StoredDocsBenchmark::StoredDocsBenchmark;
+
+    void run() override {
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
+        yokan::Collection::fetch_callback_type cb =
+            [](size_t, yk_id_t, const void*, size_t) {
+                return YOKAN_SUCCESS;
+            };
+        for(auto id : m_ids) {
+            measure([&]() {
+                m_coll->fetch(id, cb, mode);
+            });
+        }
+    }
+};
+REGISTER_BENCHMARK(DocFetchBenchmark, doc_fetch);
+
+/**
+ * @brief DOC-FETCH-MULTI benchmark. Documents are sent back by
+ * the provider in batches of --pipeline-size documents.
+ */
+class DocFetchMultiBenchmark : public StoredDocsBenchmark {
+
+    public:
+
+    using StoredDocsBenchmark::StoredDocsBenchmark;
+
+    void run() override {
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
+        yk_doc_fetch_options_t options;
+        options.pool       = ABT_POOL_NULL;
+        options.batch_size = getOptions().pipeline_size;
+        yokan::Collection::fetch_callback_type cb =
+            [](size_t, yk_id_t, const void*, size_t) {
+                return YOKAN_SUCCESS;
+            };
+        auto batch_size = batchSize();
+        for(size_t i = 0; i < m_ids.size(); i += batch_size) {
+            auto count = std::min(batch_size, m_ids.size() - i);
+            measure([&]() {
+                m_coll->fetchMulti(count, m_ids.data() + i, cb, &options, mode);
+            });
+        }
+    }
+};
+REGISTER_BENCHMARK(DocFetchMultiBenchmark, doc_fetch_multi);
+
+/**
+ * @brief DOC-LIST benchmark. Lists the whole collection,
+ * batch_size documents at a time.
+ */
+class DocListBenchmark : public StoredDocsBenchmark {
+
+    std::vector<yk_id_t> m_list_ids;
+    std::vector<char> m_buffer;
+    std::vector<size_t> m_sizes;
+
+    public:
+
+    using StoredDocsBenchmark::StoredDocsBenchmark;
+
+    void run() override {
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
+        auto batch_size = batchSize();
+        m_list_ids.resize(batch_size);
+        m_buffer.resize(batch_size*getOptions().val_sizes.max);
+        m_sizes.resize(batch_size);
+        yk_id_t start_id = 0;
+        while(true) {
+            measure([&]() {
+                m_coll->listPacked(start_id, nullptr, 0, batch_size,
+                                   m_list_ids.data(), m_buffer.size(),
+                                   m_buffer.data(), m_sizes.data(), mode);
+            });
+            if(m_sizes[batch_size-1] == YOKAN_NO_MORE_DOCS)
+                break;
+            start_id = m_list_ids[batch_size-1] + 1;
+        }
+    }
+};
+REGISTER_BENCHMARK(DocListBenchmark, doc_list);
+
+/**
+ * @brief DOC-ITER benchmark. Iterates over the whole collection,
+ * requesting batch_size documents per call (all the documents if
+ * batch_size is 0). Documents are sent back by the provider in
+ * batches of --pipeline-size documents.
+ */
+class DocIterBenchmark : public StoredDocsBenchmark {
+
+    public:
+
+    using StoredDocsBenchmark::StoredDocsBenchmark;
+
+    void run() override {
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
+        size_t count = getOptions().batch_size;
+        yk_doc_iter_options_t options;
+        options.batch_size = getOptions().pipeline_size;
+        options.pool       = ABT_POOL_NULL;
+        yk_id_t start_id = 0;
+        size_t num_docs = 0;
+        yokan::Collection::iter_callback_type cb =
+            [&](size_t, yk_id_t id, const void*, size_t) {
+                num_docs += 1;
+                start_id = id + 1;
+                return YOKAN_SUCCESS;
+            };
+        do {
+            num_docs = 0;
+            measure([&]() {
+                m_coll->iter(start_id, nullptr, 0, count, cb, &options, mode);
+            });
+        } while(count != 0 && num_docs == count);
+    }
+};
+REGISTER_BENCHMARK(DocIterBenchmark, doc_iter);
+
+/**
+ * @brief UPDATE benchmark
+ */
+class UpdateBenchmark : public StoredDocsBenchmark {
+
+    public:
+
+    using StoredDocsBenchmark::StoredDocsBenchmark;
+
+    void run() override {
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
+        for(size_t i = 0; i < m_ids.size(); i++) {
+            auto& doc = m_ref[m_ref.size() - 1 - i];
+            measure([&]() {
+                m_coll->update(m_ids[i], doc.data(), doc.size(), mode);
+            });
+        }
+    }
+};
+REGISTER_BENCHMARK(UpdateBenchmark, update);
+
+/**
+ * @brief UPDATE-PACKED benchmark
+ */
+class UpdatePackedBenchmark : public StoredDocsBenchmark {
+
+    std::vector<std::pair<std::string,           // documents
+                          std::vector<size_t>>>  // document sizes
+                              m_batches;
+
+    public:
+
+    using StoredDocsBenchmark::StoredDocsBenchmark;
+
+    void setUp() override {
+        StoredDocsBenchmark::setUp();
+        auto batch_size = batchSize();
+        m_batches.resize((m_ref.size() + batch_size - 1) / batch_size);
+        for(size_t i = 0; i < m_ref.size(); i++) {
+            auto& doc = m_ref[m_ref.size() - 1 - i];
+            m_batches[i/batch_size].first += doc;
+            m_batches[i/batch_size].second.push_back(doc.size());
+        }
+    }
+
+    void run() override {
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
+        auto batch_size = batchSize();
+        for(size_t i = 0; i < m_batches.size(); i++) {
+            auto& batch = m_batches[i];
+            measure([&]() {
+                m_coll->updatePacked(batch.second.size(), m_ids.data() + i*batch_size,
+                                     batch.first.data(), batch.second.data(), mode);
+            });
+        }
+    }
+
+    void tearDown() override {
+        m_batches.clear();
+        StoredDocsBenchmark::tearDown();
+    }
+};
+REGISTER_BENCHMARK(UpdatePackedBenchmark, update_packed);
+
+/**
+ * @brief Mixed workload benchmark, in the style of the YCSB core workloads.
+ * The workload is described by a JSON file (see benchmark/workloads for
+ * examples) of the following form, in which all the fields are optional:
+ * {
+ *   "api": "kv" | "doc",
+ *   "record_count": <number of records loaded before running>,
+ *   "operation_count": <number of operations executed by each client>,
+ *   "key_size": <size of the keys (KV API only)>,
+ *   "value_size": { "min": ..., "max": ..., "distribution": ... },
+ *   "proportions": { "read": ..., "update": ..., "insert": ...,
+ *                    "scan": ..., "read_modify_write": ... },
+ *   "request_distribution": { "distribution": ..., ... },
+ *   "scan_length": { "min": ..., "max": ..., "distribution": ... }
+ * }
+ * (see distributions.hpp for the available distributions).
+ * With the KV API, records are key/value pairs with hashed keys.
+ * With the document API, records are documents of a collection.
+ * Each client works on its own set of records.
+ */
+class WorkloadBenchmark : public Benchmark {
+
+    enum Operation { READ, UPDATE, INSERT, SCAN, READ_MODIFY_WRITE, NUM_OPERATIONS };
+
+    static constexpr const char* operation_names[NUM_OPERATIONS] = {
+        "read", "update", "insert", "scan", "read_modify_write"
+    };
+
+    std::shared_ptr<yokan::Database>   m_db;
+    std::shared_ptr<yokan::Collection> m_coll;
+    json                               m_spec;
+    bool                               m_doc_api;
+    std::string                        m_key_prefix;
+    size_t                             m_key_size;
+    uint64_t                           m_record_count;
+    uint64_t                           m_operation_count;
+    uint64_t                           m_num_records = 0;
+    std::discrete_distribution<int>    m_operation_dist;
+    std::unique_ptr<IntegerGenerator>  m_request_gen;
+    std::unique_ptr<SizeGenerator>     m_value_size_gen;
+    std::unique_ptr<SizeGenerator>     m_scan_length_gen;
+    std::mt19937_64                    m_rng;
+    std::string                        m_data;     // values are taken from here
+    std::vector<char>                  m_values;   // buffer for values read
+    std::vector<char>                  m_keys;     // buffer for keys read
+    std::vector<size_t>                m_ksizes;
+    std::vector<size_t>                m_vsizes;
+    std::vector<yk_id_t>               m_ids;
+
+    public:
+
+    WorkloadBenchmark(std::shared_ptr<yokan::Database> db, const options& opt)
+    : Benchmark(opt), m_db(std::move(db)), m_rng(opt.seed + rand()) {
+        std::ifstream f(opt.workload);
+        if(!f.good())
+            throw std::runtime_error("could not open workload file " + opt.workload);
+        m_spec = json::parse(f);
+
+        // fill the missing fields with their default values
+        auto set_default = [](json& j, const char* field, const json& value) {
+            if(!j.contains(field)) j[field] = value;
+        };
+        set_default(m_spec, "api", "kv");
+        set_default(m_spec, "record_count", opt.num_items);
+        set_default(m_spec, "operation_count", m_spec["record_count"]);
+        set_default(m_spec, "key_size", opt.key_sizes.max);
+        set_default(m_spec, "value_size", json::object());
+        set_default(m_spec["value_size"], "min", opt.val_sizes.min);
+        set_default(m_spec["value_size"], "max", opt.val_sizes.max);
+        set_default(m_spec["value_size"], "distribution", "uniform");
+        set_default(m_spec, "proportions", json{{"read", 1.0}});
+        for(auto name : operation_names)
+            set_default(m_spec["proportions"], name, 0.0);
+        set_default(m_spec, "request_distribution", json::object());
+        set_default(m_spec["request_distribution"], "distribution", "zipfian");
+        set_default(m_spec, "scan_length", json::object());
+        set_default(m_spec["scan_length"], "min", 1);
+        set_default(m_spec["scan_length"], "max", 100);
+        set_default(m_spec["scan_length"], "distribution", "uniform");
+
+        auto api = m_spec["api"].get<std::string>();
+        if(api != "kv" && api != "doc")
+            throw std::runtime_error("invalid api \"" + api + "\" in workload");
+        m_doc_api         = api == "doc";
+        m_key_prefix      = opt.collection + ":user";
+        m_key_size        = m_spec["key_size"].get<size_t>();
+        m_record_count    = m_spec["record_count"].get<uint64_t>();
+        m_operation_count = m_spec["operation_count"].get<uint64_t>();
+        std::vector<double> weights;
+        for(auto name : operation_names)
+            weights.push_back(m_spec["proportions"][name].get<double>());
+        m_operation_dist  = std::discrete_distribution<int>(weights.begin(), weights.end());
+        m_request_gen     = IntegerGenerator::make(m_spec["request_distribution"]);
+        m_value_size_gen  = std::make_unique<SizeGenerator>(m_spec["value_size"]);
+        m_scan_length_gen = std::make_unique<SizeGenerator>(m_spec["scan_length"]);
+        if(m_doc_api)
+            m_coll = std::make_shared<yokan::Collection>(opt.collection.c_str(), *m_db);
+
+        m_data = gen_random_string(m_value_size_gen->max());
+        auto max_scan = m_scan_length_gen->max();
+        m_values.resize(std::max<size_t>(1, max_scan)*m_value_size_gen->max());
+        m_keys.resize(std::max<size_t>(1, max_scan)*std::max(m_key_size, makeKey(0).size()));
+        m_ksizes.resize(std::max<size_t>(1, max_scan));
+        m_vsizes.resize(std::max<size_t>(1, max_scan));
+        m_ids.resize(std::max<size_t>(1, max_scan));
+    }
+
+    std::vector<std::string> operations() const override {
+        std::vector<std::string> result;
+        for(auto name : operation_names) {
+            if(m_spec["proportions"][name].get<double>() > 0.0)
+                result.push_back(name);
+        }
+        return result;
+    }
+
+    json config() const override {
+        return m_spec;
+    }
+
+    void setUp() override {
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
+        size_t batch_size = getOptions().batch_size ? getOptions().batch_size : 1024;
+        if(m_doc_api)
+            m_db->createCollection(getOptions().collection.c_str());
+        for(uint64_t first = 0; first < m_record_count; first += batch_size) {
+            auto count = std::min<uint64_t>(batch_size, m_record_count - first);
+            std::string keys, vals;
+            std::vector<size_t> ksizes, vsizes;
+            for(uint64_t r = first; r < first + count; r++) {
+                auto key = makeKey(r);
+                auto vsize = m_value_size_gen->next(m_rng);
+                keys += key;
+                ksizes.push_back(key.size());
+                vals.append(m_data.data(), vsize);
+                vsizes.push_back(vsize);
+            }
+            if(m_doc_api) {
+                std::vector<yk_id_t> ids(count);
+                m_coll->storePacked(count, vals.data(), vsizes.data(), ids.data(), mode);
+            } else {
+                m_db->putPacked(count, keys.data(), ksizes.data(),
+                                vals.data(), vsizes.data(), mode);
+            }
+        }
+        m_num_records = m_record_count;
+    }
+
+    void run() override {
+        int32_t mode = getOptions().no_rdma ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT;
+        for(uint64_t i = 0; i < m_operation_count; i++) {
+            auto op = static_cast<Operation>(m_operation_dist(m_rng));
+            uint64_t record = op == INSERT ? m_num_records
+                                           : m_request_gen->next(m_rng, m_num_records);
+            auto key = m_doc_api ? std::string{} : makeKey(record);
+            switch(op) {
+            case READ:
+                measure(operation_names[op], [&]() { read(key, record, mode); });
+                break;
+            case UPDATE: {
+                auto vsize = m_value_size_gen->next(m_rng);
+                measure(operation_names[op], [&]() { write(key, record, vsize, mode); });
+                } break;
+            case INSERT: {
+                auto vsize = m_value_size_gen->next(m_rng);
+                measure(operation_names[op], [&]() { write(key, record, vsize, mode); });
+                m_num_records += 1;
+                } break;
+            case SCAN: {
+                auto length = m_scan_length_gen->next(m_rng);
+                measure(operation_names[op], [&]() { scan(key, record, length, mode); });
+                } break;
+            case READ_MODIFY_WRITE: {
+                auto vsize = m_value_size_gen->next(m_rng);
+                measure(operation_names[op], [&]() {
+                    read(key, record, mode);
+                    write(key, record, vsize, mode);
+                });
+                } break;
+            default:
+                break;
+            }
+        }
+    }
+
+    void tearDown() override {
+        if(getOptions().no_remove) return;
+        if(m_doc_api) {
+            m_db->dropCollection(getOptions().collection.c_str());
+            return;
+        }
+        const uint64_t batch_size = 1024;
+        for(uint64_t first = 0; first < m_num_records; first += batch_size) {
+            auto count = std::min<uint64_t>(batch_size, m_num_records - first);
+            std::string keys;
+            std::vector<size_t> ksizes;
+            for(uint64_t r = first; r < first + count; r++) {
+                auto key = makeKey(r);
+                keys += key;
+                ksizes.push_back(key.size());
+            }
+            m_db->erasePacked(count, keys.data(), ksizes.data());
+        }
+    }
+
+    private:
+
+    std::string makeKey(uint64_t record) const {
+        auto num = std::to_string(fnv_hash64(record));
+        std::string key = m_key_prefix;
+        if(key.size() + num.size() < m_key_size)
+            key.append(m_key_size - key.size() - num.size(), '0');
+        return key + num;
+    }
+
+    void read(const std::string& key, uint64_t record, int32_t mode) {
+        size_t vsize = m_values.size();
+        if(m_doc_api)
+            m_coll->load(record, m_values.data(), &vsize, mode);
+        else
+            m_db->get(key.data(), key.size(), m_values.data(), &vsize, mode);
+    }
+
+    void write(const std::string& key, uint64_t record, size_t vsize, int32_t mode) {
+        if(m_doc_api) {
+            if(record < m_num_records)
+                m_coll->update(record, m_data.data(), vsize, mode);
+            else
+                m_coll->store(m_data.data(), vsize, mode);
+        } else {
+            m_db->put(key.data(), key.size(), m_data.data(), vsize, mode);
+        }
+    }
+
+    void scan(const std::string& key, uint64_t record, size_t length, int32_t mode) {
+        length = std::min(length, m_ids.size());
+        if(m_doc_api) {
+            m_coll->listPacked(record, nullptr, 0, length, m_ids.data(),
+                               m_values.size(), m_values.data(),
+                               m_vsizes.data(), mode);
+        } else {
+            m_db->listKeyValsPacked(key.data(), key.size(), nullptr, 0, length,
+                                    m_keys.data(), m_keys.size(), m_ksizes.data(),
+                                    m_values.data(), m_values.size(), m_vsizes.data(),
+                                    mode);
+        }
+    }
+};
+REGISTER_BENCHMARK(WorkloadBenchmark, workload);
+
+/**
+ * @brief RPC-OVERHEAD benchmark, meant to be run against the null backend
+ * to isolate the cost of serialization and transport. Each RPC variant is
+ * issued num_items times, in direct (YOKAN_MODE_NO_RDMA) and in bulk mode,
+ * for each number of keys per call (powers of 4 up to batch_size, 64 if 0)
+ * and each value size (powers of 4 within --value-sizes), with keys of
+ * the maximum key size. Latencies are reported per point, with labels of
+ * the form "<rpc>/<direct|bulk>/n=<keys>/v=<value size>", and summarize()
+ * fits latency = fixed + per_key*keys + per_byte*bytes for each variant.
+ */
+class RpcOverheadBenchmark : public Benchmark {
+
+    struct point {
+        std::string variant;
+        int32_t     mode;
+        size_t      count;
+        size_t      vsize;
+        std::string label;
+    };
+
+    std::shared_ptr<yokan::Database> m_db;
+    size_t                           m_ksize;
+    std::vector<point>               m_points;
+    std::map<std::string, std::string> m_unsupported; // variant -> error
+
+    static std::vector<size_t> powers_of_4(size_t min, size_t max) {
+        std::vector<size_t> result;
+        for(size_t x = std::max<size_t>(min, 1); x < max; x *= 4)
+            result.push_back(x);
+        result.push_back(max);
+        return result;
+    }
+
+    public:
+
+    RpcOverheadBenchmark(std::shared_ptr<yokan::Database> db, const options& opt)
+    : Benchmark(opt), m_db(std::move(db)), m_ksize(opt.key_sizes.max) {
+        auto counts = powers_of_4(1, opt.batch_size ? opt.batch_size : 64);
+        auto vsizes = powers_of_4(opt.val_sizes.min, opt.val_sizes.max);
+        const std::vector<std::string> single   = { "put", "get" };
+        const std::vector<std::string> multiple = {
+            "put_multi", "put_packed", "get_multi", "get_packed", "fetch_packed", "iter"
+        };
+        auto add_point = [&](const std::string& rpc, size_t count, size_t vsize) {
+            for(auto direct : {true, false}) {
+                auto variant = rpc + (direct ? "/direct" : "/bulk");
+                auto label   = variant + "/n=" + std::to_string(count)
+                                       + "/v=" + std::to_string(vsize);
+                m_points.push_back({variant,
+                                    direct ? YOKAN_MODE_NO_RDMA : YOKAN_MODE_DEFAULT,
+                                    count, vsize, label});
+            }
+        };
+        for(auto& rpc : single)
+            for(auto vsize : vsizes)
+                add_point(rpc, 1, vsize);
+        for(auto& rpc : multiple)
+            for(auto count : counts)
+                for(auto vsize : vsizes)
+                    add_point(rpc, count, vsize);
+    }
+
+    std::vector<std::string> operations() const override {
+        std::vector<std::string> result;
+        for(auto& p : m_points) result.push_back(p.label);
+        return result;
+    }
+
+    void setUp() override {
+        m_unsupported.clear();
+    }
+
+    void run() override {
+        for(auto& p : m_points) {
+            if(m_unsupported.count(p.variant)) continue;
+            try {
+                runPoint(p);
+            } catch(const yokan::Exception& ex) {
+                if(ex.code() != YOKAN_ERR_OP_UNSUPPORTED && ex.code() != YOKAN_ERR_MODE)
+                    throw;
+                m_unsupported[p.variant] = ex.what();
+            }
+        }
+    }
+
+    void tearDown() override {
+        if(getOptions().no_remove) return;
+        // remove the keys put by the largest points
+        size_t count = 0;
+        for(auto& p : m_points) count = std::max(count, p.count);
+        std::string keys;
+        std::vector<size_t> ksizes(count, m_ksize);
+        for(size_t i = 0; i < count; i++) keys += makeKey(i);
+        try {
+            m_db->erasePacked(count, keys.data(), ksizes.data());
+        } catch(const yokan::Exception&) {}
+    }
+
+    /**
+     * @brief Fit latency = fixed + per_key*keys + per_byte*bytes by least
+     * squares for each variant, where bytes = keys*(key size + value size).
+     * For each RPC, bulk_threshold_bytes is the payload of a single key
+     * above which the bulk variant is expected to be faster than the direct
+     * one (null if the direct variant is always faster).
+     */
+    json summarize(const std::map<std::string, std::vector<double>>& latencies) const override {
+        json result = json::object();
+        std::map<std::string, std::vector<std::array<double,3>>> samples; // variant -> (keys, bytes, us)
+        for(auto& p : m_points) {
+            auto it = latencies.find(p.label);
+            if(it == latencies.end() || it->second.empty()) continue;
+            double avg = 0.0;
+            for(auto x : it->second) avg += x;
+            avg /= it->second.size();
+            samples[p.variant].push_back({
+                static_cast<double>(p.count),
+                static_cast<double>(p.count*(m_ksize + p.vsize)),
+                avg*1e6});
+        }
+        for(auto& s : samples) {
+            auto coeffs = fit(s.second);
+            auto rpc = s.first.substr(0, s.first.find('/'));
+            auto path = s.first.substr(s.first.find('/')+1);
+            result[rpc][path] = {
+                {"fixed_us",    coeffs[0]},
+                {"per_key_us",  coeffs[1]},
+                {"per_byte_ns", coeffs[2]*1e3},
+                {"points",      s.second.size()}
+            };
+        }
+        for(auto& u : m_unsupported) {
+            auto rpc = u.first.substr(0, u.first.find('/'));
+            auto path = u.first.substr(u.first.find('/')+1);
+            result[rpc][path] = {{"unsupported", u.second}};
+        }
+        for(auto& r : result.items()) {
+            auto& direct = r.value()["direct"];
+            auto& bulk   = r.value()["bulk"];
+            if(!direct.contains("fixed_us") || !bulk.contains("fixed_us"))
+                continue;
+            double d0 = direct["fixed_us"].get<double>() + direct["per_key_us"].get<double>();
+            double b0 = bulk["fixed_us"].get<double>() + bulk["per_key_us"].get<double>();
+            double d1 = direct["per_byte_ns"].get<double>()/1e3;
+            double b1 = bulk["per_byte_ns"].get<double>()/1e3;
+            if(d1 > b1)
+                r.value()["bulk_threshold_bytes"] = std::max(0.0, (b0 - d0)/(d1 - b1));
+            else
+                r.value()["bulk_threshold_bytes"] = nullptr;
+        }
+        return result;
+    }
+
+    private:
+
+    std::string makeKey(size_t i) const {
+        auto id = std::to_string(i);
+        auto key = getOptions().prefix + id;
+        key.resize(std::max(m_ksize, key.size()), '.');
+        return key;
+    }
+
+    /**
+     * @brief Least squares fit of y = c0 + c1*keys + c2*bytes. The keys
+     * (resp. bytes) term is left out (zero) if it does not vary.
+     */
+    static std::array<double,3> fit(const std::vector<std::array<double,3>>& samples) {
+        std::vector<int> columns = {0};
+        for(int c : {1, 2}) {
+            for(auto& s : samples) {
+                if(s[c-1] != samples[0][c-1]) {
+                    columns.push_back(c);
+                    break;
+                }
+            }
+        }
+        auto x = [](const std::array<double,3>& s, int c) {
+            return c == 0 ? 1.0 : s[c-1];
+        };
+        // normal equations A*c = b, solved by Gaussian elimination
+        const size_t n = columns.size();
+        double A[3][4] = {};
+        for(auto& s : samples) {
+            for(size_t i = 0; i < n; i++) {
+                for(size_t j = 0; j < n; j++)
+                    A[i][j] += x(s, columns[i])*x(s, columns[j]);
+                A[i][n] += x(s, columns[i])*s[2];
+            }
+        }
+        for(size_t i = 0; i < n; i++) {
+            size_t pivot = i;
+            for(size_t k = i+1; k < n; k++)
+                if(std::abs(A[k][i]) > std::abs(A[pivot][i])) pivot = k;
+            std::swap(A[i], A[pivot]);
+            if(A[i][i] == 0.0) continue;
+            for(size_t k = 0; k < n; k++) {
+                if(k == i) continue;
+                double f = A[k][i]/A[i][i];
+                for(size_t j = i; j <= n; j++)
+                    A[k][j] -= f*A[i][j];
+            }
+        }
+        std::array<double,3> result = {0.0, 0.0, 0.0};
+        for(size_t i = 0; i < n; i++)
+            result[columns[i]] = A[i][i] != 0.0 ? A[i][n]/A[i][i] : 0.0;
+        return result;
+    }
+
+    void runPoint(const point& p) {
+        const auto& opt = getOptions();
+        std::string keys;
+        std::vector<size_t> ksizes(p.count, m_ksize);
+        std::vector<const void*> kptrs(p.count);
+        for(size_t i = 0; i < p.count; i++) keys += makeKey(i);
+        for(size_t i = 0; i < p.count; i++) kptrs[i] = keys.data() + i*m_ksize;
+        std::vector<char> vals(p.count*p.vsize, 'x');
+        std::vector<size_t> vsizes(p.count, p.vsize);
+        std::vector<void*> vptrs(p.count);
+        for(size_t i = 0; i < p.count; i++) vptrs[i] = vals.data() + i*p.vsize;
+        std::vector<const void*> cvptrs(vptrs.begin(), vptrs.end());
+        const auto rpc = p.variant.substr(0, p.variant.find('/'));
+
+        yokan::Database::fetch_callback_type fetch_cb =
+            [](size_t, const void*, size_t, const void*, size_t) {
+                return YOKAN_SUCCESS;
+            };
+        yk_fetch_options_t fetch_options;
+        fetch_options.pool       = ABT_POOL_NULL;
+        fetch_options.batch_size = opt.pipeline_size;
+        yokan::Database::iter_callback_type iter_cb =
+            [](size_t, const void*, size_t, const void*, size_t) {
+                return YOKAN_SUCCESS;
+            };
+        yk_iter_options_t iter_options;
+        iter_options.batch_size    = opt.pipeline_size;
+        iter_options.pool          = ABT_POOL_NULL;
+        iter_options.ignore_values = false;
+
+        for(size_t i = 0; i < opt.num_items; i++) {
+            // the get variants overwrite the sizes with those of the values found
+            std::fill(vsizes.begin(), vsizes.end(), p.vsize);
+            size_t vsize = p.vsize;
+            measure(p.label, [&]() {
+                if(rpc == "put")
+                    m_db->put(keys.data(), m_ksize, vals.data(), p.vsize, p.mode);
+                else if(rpc == "get")
+                    m_db->get(keys.data(), m_ksize, vals.data(), &vsize, p.mode);
+                else if(rpc == "put_multi")
+                    m_db->putMulti(p.count, kptrs.data(), ksizes.data(),
+                                   cvptrs.data(), vsizes.data(), p.mode);
+                else if(rpc == "put_packed")
+                    m_db->putPacked(p.count, keys.data(), ksizes.data(),
+                                    vals.data(), vsizes.data(), p.mode);
+                else if(rpc == "get_multi")
+                    m_db->getMulti(p.count, kptrs.data(), ksizes.data(),
+                                   vptrs.data(), vsizes.data(), p.mode);
+                else if(rpc == "get_packed")
+                    m_db->getPacked(p.count, keys.data(), ksizes.data(),
+                                    vals.size(), vals.data(), vsizes.data(), p.mode);
+                else if(rpc == "fetch_packed")
+                    m_db->fetchPacked(p.count, keys.data(), ksizes.data(),
+                                      fetch_cb, &fetch_options, p.mode);
+                else if(rpc == "iter")
+                    m_db->iter(nullptr, 0, nullptr, 0, p.count,
+                               iter_cb, &iter_options, p.mode);
+            });
+        }
+    }
+};
+REGISTER_BENCHMARK(RpcOverheadBenchmark, rpc_overhead);
+
+static options parse_arguments(int argc, char** argv);
+
+struct client_ult_args {
+    Benchmark* benchmark;
+    bool       failed;
+};
+
+static void client_ult(void* a) {
+    auto args = static_cast<client_ult_args*>(a);
+    try {
+        args->benchmark->run();
+    } catch(const yokan::Exception& ex) {
+        std::cerr << "ERROR: " << ex.what() << std::endl;
+        args->failed = true;
+    }
+}
+
+static double percentile(const std::vector<double>& sorted, double p) {
+    if(sorted.empty()) return 0.0;
+    size_t rank = static_cast<size_t>(std::ceil(p*sorted.size()));
+    if(rank > 0) rank -= 1;
+    return sorted[std::min(rank, sorted.size()-1)];
+}
+
+#ifndef YOKAN_VERSION
+#define YOKAN_VERSION "unknown"
+#endif
+#ifndef YOKAN_BUILD_TYPE
+#define YOKAN_BUILD_TYPE "unknown"
+#endif
+#ifndef YOKAN_CXX_FLAGS
+#define YOKAN_CXX_FLAGS ""
+#endif
+
+/**
+ * @brief Build the report of a benchmark run: the full configuration
+ * (including the backend, transport and build flags), the duration of
+ * each repetition, the throughput, and latency statistics per operation.
+ * This report is what --format json outputs, and is what
+ * yk-benchmark-compare expects.
+ */
+static json make_report(const options& opt, int num_ranks,
+                        const std::string& backend,
+                        const json& workload,
+                        const json& summary,
+                        const std::vector<double>& timings,
+                        std::map<std::string, std::vector<double>>& latencies,
+                        bool failed) {
+    json report;
+    auto& cfg = report["config"];
+    cfg["operation"]      = opt.operation;
+    cfg["backend"]        = backend;
+    cfg["backend_config"] = opt.backend.empty() ? json() : json::parse(opt.backend_config);
+    cfg["transport"]      = opt.server_address.substr(0, opt.server_address.find(":"));
+    cfg["local_provider"] = !opt.backend.empty();
+    cfg["key_sizes"]      = {{"min", opt.key_sizes.min}, {"max", opt.key_sizes.max}};
+    cfg["value_sizes"]    = {{"min", opt.val_sizes.min}, {"max", opt.val_sizes.max}};
+    cfg["num_items"]      = opt.num_items;
+    cfg["batch_size"]     = opt.batch_size;
+    cfg["pipeline_size"]  = opt.pipeline_size;
+    cfg["prefix"]         = opt.prefix;
+    cfg["prefix_freq"]    = opt.prefix_freq;
+    cfg["no_rdma"]        = opt.no_rdma;
+    cfg["seed"]           = opt.seed;
+    cfg["repetitions"]    = opt.repetitions;
+    cfg["processes"]      = num_ranks;
+    cfg["clients"]        = opt.num_clients;
+    cfg["xstreams"]       = opt.num_xstreams;
+    cfg["rate"]           = opt.rate;
+    if(!workload.empty())
+        cfg["workload"]   = workload;
+    cfg["build"] = {
+        {"yokan_version",  YOKAN_VERSION},
+        {"build_type",     YOKAN_BUILD_TYPE},
+        {"compiler",       __VERSION__},
+        {"cxx_flags",      YOKAN_CXX_FLAGS},
+#ifdef YOKAN_LOCK_PROFILING
+        {"lock_profiling", true},
+#else
+        {"lock_profiling", false},
+#endif
+#ifdef YOKAN_BENCHMARK_HAS_MPI
+        {"mpi",            true}
+#else
+        {"mpi",            false}
+#endif
+    };
+
+    double avg = 0.0;
+    double var = 0.0;
+    double min = -1;
+    double max = -1;
+    double total_time = 0.0;
+    for(auto& t : timings) {
+        avg += t;
+        var += t*t;
+        total_time += t;
+        if(min < 0 || min > t) min = t;
+        if(max < 0 || max < t) max = t;
+    }
+    avg /= timings.size();
+    var /= timings.size();
+    var -= avg*avg;
+    report["timing_ms"] = {
+        {"samples",  timings},
+        {"average",  avg},
+        {"variance", var},
+        {"maximum",  max},
+        {"minimum",  min}
+    };
+
+    size_t num_operations = 0;
+    for(auto& l : latencies) num_operations += l.second.size();
+    report["throughput"] = {
+        {"operations", num_operations},
+        {"ops_per_second", total_time > 0.0 ? num_operations/(total_time/1e3) : 0.0}
+    };
+
+    auto& lat_report = report["latency_us"];
+    lat_report = json::object();
+    for(auto& l : latencies) {
+        auto& lat = l.second;
+        std::sort(lat.begin(), lat.end());
+        double lat_avg = 0.0;
+        double lat_var = 0.0;
+        for(auto& x : lat) {
+            lat_avg += x;
+            lat_var += x*x;
+        }
+        if(!lat.empty()) {
+            lat_avg /= lat.size();
+            lat_var = std::max(0.0, lat_var/lat.size() - lat_avg*lat_avg);
+        }
+        lat_report[l.first] = {
+            {"operations", lat.size()},
+            {"average",    lat_avg*1e6},
+            {"stddev",     std::sqrt(lat_var)*1e6},
+            {"minimum",    lat.empty() ? 0.0 : lat.front()*1e6},
+            {"p50",        percentile(lat, 0.50)*1e6},
+            {"p90",        percentile(lat, 0.90)*1e6},
+            {"p99",        percentile(lat, 0.99)*1e6},
+            {"p99.9",      percentile(lat, 0.999)*1e6},
+            {"maximum",    lat.empty() ? 0.0 : lat.back()*1e6}
+        };
+    }
+    if(!summary.empty())
+        report["summary"] = summary;
+    report["failed"] = failed;
+    return report;
+}
+
+static void print_text_report(std::ostream& out, const json& report) {
+    auto& cfg = report["config"];
+    out << "----- CONFIGURATION --------------" << std::endl;
+    out << "PROCESSES: " << cfg["processes"].get<int>() << std::endl;
+    out << "CLIENTS  : " << cfg["clients"].get<unsigned>() << " per process" << std::endl;
+    out << "XSTREAMS : " << cfg["xstreams"].get<unsigned>() << " per process" << std::endl;
+    out << "RATE     : ";
+    if(cfg["rate"].get<double>() > 0) out << cfg["rate"].get<double>() << " operations/second" << std::endl;
+    else out << "closed loop" << std::endl;
+    if(cfg.contains("workload"))
+        out << "WORKLOAD : " << cfg["workload"].dump() << std::endl;
+    auto& timing = report["timing_ms"];
+    out << "----- TIMING (milliseconds) ------" << std::endl;
+    out << "AVERAGE  : " << timing["average"].get<double>() << std::endl;
+    out << "VARIANCE : " << timing["variance"].get<double>() << std::endl;
+    out << "MAXIMUM  : " << timing["maximum"].get<double>() << std::endl;
+    out << "MINIMUM  : " << timing["minimum"].get<double>() << std::endl;
+    out << "----- THROUGHPUT (operations/second) -----" << std::endl;
+    out << "OPERATIONS : " << report["throughput"]["operations"].get<size_t>() << std::endl;
+    out << "THROUGHPUT : " << report["throughput"]["ops_per_second"].get<double>() << std::endl;
+    auto& latencies = report["latency_us"];
+    for(auto& l : latencies.items()) {
+        // with several kinds of operations, each gets its own section
+        auto& lat = l.value();
+        if(latencies.size() == 1)
+            out << "----- LATENCY (microseconds) -----" << std::endl;
+        else
+            out << "----- LATENCY " << l.key() << " (microseconds) -----" << std::endl;
+        if(latencies.size() != 1)
+            out << "OPERATIONS : " << lat["operations"].get<size_t>() << std::endl;
+        out << "AVERAGE  : " << lat["average"].get<double>() << std::endl;
+        out << "MINIMUM  : " << lat["minimum"].get<double>() << std::endl;
+        out << "P50      : " << lat["p50"].get<double>() << std::endl;
+        out << "P90      : " << lat["p90"].get<double>() << std::endl;
+        out << "P99      : " << lat["p99"].get<double>() << std::endl;
+        out << "P99.9    : " << lat["p99.9"].get<double>() << std::endl;
+        out << "MAXIMUM  : " << lat["maximum"].get<double>() << std::endl;
+    }
+    if(report.contains("summary")) {
+        out << "----- SUMMARY --------------------" << std::endl;
+        out << report["summary"].dump(4) << std::endl;
+    }
+    if(report["failed"].get<bool>())
+        out << "WARNING: some operations failed" << std::endl;
+}
+
+/**
+ * @brief Print the report as CSV, with one row per operation
+ * (the configuration and throughput columns are repeated).
+ */
+static void print_csv_report(std::ostream& out, const json& report) {
+    auto& cfg = report["config"];
+    auto& timing = report["timing_ms"];
+    auto& build = cfg["build"];
+    out << "operation,label,backend,transport,key_size_min,key_size_max,"
+        << "value_size_min,value_size_max,num_items,batch_size,pipeline_size,"
+        << "no_rdma,processes,clients,xstreams,rate,repetitions,"
+        << "yokan_version,build_type,"
+        << "time_avg_ms,time_variance_ms2,throughput_ops,"
+        << "operations,lat_avg_us,lat_stddev_us,lat_min_us,"
+        << "lat_p50_us,lat_p90_us,lat_p99_us,lat_p999_us,lat_max_us,failed"
+        << std::endl;
+    for(auto& l : report["latency_us"].items()) {
+        auto& lat = l.value();
+        out << cfg["operation"].get<std::string>() << ","
+            << l.key() << ","
+            << cfg["backend"].get<std::string>() << ","
+            << cfg["transport"].get<std::string>() << ","
+            << cfg["key_sizes"]["min"] << "," << cfg["key_sizes"]["max"] << ","
+            << cfg["value_sizes"]["min"] << "," << cfg["value_sizes"]["max"] << ","
+            << cfg["num_items"] << ","
+            << cfg["batch_size"] << ","
+            << cfg["pipeline_size"] << ","
+            << cfg["no_rdma"] << ","
+            << cfg["processes"] << ","
+            << cfg["clients"] << ","
+            << cfg["xstreams"] << ","
+            << cfg["rate"] << ","
+            << cfg["repetitions"] << ","
+            << build["yokan_version"].get<std::string>() << ","
+            << build["build_type"].get<std::string>() << ","
+            << timing["average"] << ","
+            << timing["variance"] << ","
+            << report["throughput"]["ops_per_second"] << ","
+            << lat["operations"] << ","
+            << lat["average"] << ","
+            << lat["stddev"] << ","
+            << lat["minimum"] << ","
+            << lat["p50"] << ","
+            << lat["p90"] << ","
+            << lat["p99"] << ","
+            << lat["p99.9"] << ","
+            << lat["maximum"] << ","
+            << report["failed"]
+            << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    int rank = 0;
+    int num_ranks = 1;
+#ifdef YOKAN_BENCHMARK_HAS_MPI
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+#endif
+
+    auto opt = parse_arguments(argc, argv);
+    srand(opt.seed + rank);
+
+    std::string protocol;
+    {
+        auto p = opt.server_address.find(":");
+        protocol = opt.server_address.substr(0, p);
+    }
+
+    std::string margo_config_str;
+    if(!opt.margo_config.empty()) {
+        std::ifstream t(opt.margo_config.c_str());
+        if(!t.good()) {
+            std::cerr << "ERROR: file " << opt.margo_config << " does not exist" << std::endl;
+            exit(-1);
+        }
+        std::stringstream buffer;
+        buffer << t.rdbuf();
+        margo_config_str = buffer.str();
+    }
+
+    margo_init_info margo_args;
+    memset(&margo_args, 0, sizeof(margo_args));
+    margo_args.json_config = margo_config_str.c_str();
+    // with --backend, each process hosts its own provider and
+    // the server address only provides the protocol to use
+    const bool local_provider = !opt.backend.empty();
+    margo_instance_id mid = margo_init_ext(protocol.c_str(),
+                                           local_provider ? MARGO_SERVER_MODE : MARGO_CLIENT_MODE,
+                                           &margo_args);
+    if(!mid) {
+        std::cerr << "ERROR: could not initialize margo instance" << std::endl;
+        exit(-1);
+    }
+    opt.mid = mid;
+
+    std::unique_ptr<yokan::Provider> provider;
+    if(local_provider) {
+        json provider_config = {
+            {"database", {
+                {"type", opt.backend},
+                {"config", json::parse(opt.backend_config)}
+            }}
+        };
+        try {
+            provider = std::make_unique<yokan::Provider>(
+                mid, opt.provider_id, provider_config.dump().c_str());
+        } catch(const yokan::Exception& ex) {
+            std::cerr << "ERROR: could not create provider: " << ex.what() << std::endl;
+            margo_finalize(mid);
+            exit(-1);
+        }
+    }
+
+    hg_addr_t svr_addr = HG_ADDR_NULL;
+    hg_return_t hret = local_provider
+                     ? margo_addr_self(mid, &svr_addr)
+                     : margo_addr_lookup(mid, opt.server_address.c_str(), &svr_addr);
+    if(hret != HG_SUCCESS) {
+        std::cerr << "ERROR: could not lookup address " << opt.server_address << std::endl;
+        provider.reset();
+        margo_finalize(mid);
+        exit(-1);
+    }
+
+    std::shared_ptr<yokan::Client> client;
+    std::shared_ptr<yokan::Database> database;
+
+    try {
+        client = std::make_shared<yokan::Client>(mid);
+        // disable the automatic selection of direct transfers so that
+        // YOKAN_MODE_NO_RDMA (--no-rdma) selects between the two paths
+        client->setDirectThreshold(0);
+        database = std::make_shared<yokan::Database>(
+            client->makeDatabaseHandle(svr_addr, opt.provider_id));
+    } catch(const yokan::Exception& ex) {
+        std::cerr << "ERROR: " << ex.what() << std::endl;
+        margo_addr_free(mid, svr_addr);
+        margo_finalize(mid);
+        exit(-1);
+    }
+
+    // the type of a remote backend is taken from the
+    // statistics of the provider, when they are available
+    std::string backend = opt.backend;
+    if(backend.empty()) {
+        try {
+            auto stats = json::parse(database->getStats());
+            backend = stats["backend"].value("type", "unknown");
+        } catch(const std::exception&) {
+            backend = "unknown";
+        }
+    }
+
+    if(Benchmark::factories.count(opt.operation) == 0) {
+        std::cerr << "ERROR: invalid operation " << opt.operation << std::endl;
+        margo_addr_free(mid, svr_addr);
+        margo_finalize(mid);
+        exit(-1);
+    }
+
+    // client ULTs run in a dedicated pool served by num_xstreams
+    // execution streams, or in the pool of the calling ULT if 0
+    ABT_pool pool = ABT_POOL_NULL;
+    std::vector<ABT_xstream> xstreams(opt.num_xstreams, ABT_XSTREAM_NULL);
+    if(opt.num_xstreams) {
+        ABT_pool_create_basic(ABT_POOL_FIFO, ABT_POOL_ACCESS_MPMC, ABT_TRUE, &pool);
+        for(auto& es : xstreams)
+            ABT_xstream_create_basic(ABT_SCHED_DEFAULT, 1, &pool,
+                                     ABT_SCHED_CONFIG_NULL, &es);
+    } else {
+        ABT_self_get_last_pool(&pool);
+    }
+
+    const unsigned total_clients = opt.num_clients*num_ranks;
+    const double client_rate = opt.rate/total_clients;
+    int exit_code = 0;
+
+    {
+        std::vector<double> timings;   // duration of each repetition (ms)
+        std::map<std::string, std::vector<double>> latencies; // per operation (s)
+        json config; // configuration reported by the benchmark
+        std::unique_ptr<Benchmark> summarizer; // summarizes the latencies
+        bool failed = false;
+        auto& factory = Benchmark::factories[opt.operation];
+        for(unsigned i = 0; i < opt.repetitions; i++) {
+            std::vector<std::unique_ptr<Benchmark>> benchmarks;
+            for(unsigned j = 0; j < opt.num_clients; j++) {
+                auto client_opt = opt;
+                if(total_clients > 1)
+                    client_opt.collection += "_" + std::to_string(rank*opt.num_clients + j);
+                try {
+                    benchmarks.push_back(factory(database, client_opt));
+                } catch(const std::exception& ex) {
+                    std::cerr << "ERROR: " << ex.what() << std::endl;
+                    exit(-1);
+                }
+            }
+            for(auto& benchmark : benchmarks)
+                benchmark->setUp();
+#ifdef YOKAN_BENCHMARK_HAS_MPI
+            MPI_Barrier(MPI_COMM_WORLD);
+#endif
+            for(auto& benchmark : benchmarks)
+                benchmark->start(client_rate);
+            std::vector<client_ult_args> args(benchmarks.size());
+            std::vector<ABT_thread> ults(benchmarks.size(), ABT_THREAD_NULL);
+            std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+            for(unsigned j = 0; j < benchmarks.size(); j++) {
+                args[j] = client_ult_args{benchmarks[j].get(), false};
+                ABT_thread_create(pool, client_ult, &args[j],
+                                  ABT_THREAD_ATTR_NULL, &ults[j]);
+            }
+            ABT_thread_join_many(ults.size(), ults.data());
+            std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+            ABT_thread_free_many(ults.size(), ults.data());
+            double elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count();
+#ifdef YOKAN_BENCHMARK_HAS_MPI
+            MPI_Allreduce(MPI_IN_PLACE, &elapsed, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+#endif
+            timings.push_back(elapsed);
+            for(unsigned j = 0; j < benchmarks.size(); j++) {
+                failed = failed || args[j].failed;
+                for(auto& l : benchmarks[j]->getLatencies())
+                    latencies[l.first].insert(latencies[l.first].end(),
+                                              l.second.begin(), l.second.end());
+                if(config.empty()) config = benchmarks[j]->config();
+                benchmarks[j]->tearDown();
+            }
+            summarizer = std::move(benchmarks.front());
+        }
+
+#ifdef YOKAN_BENCHMARK_HAS_MPI
+        {
+            // gather the latencies of all the processes on rank 0
+            // (all the processes report the same operations)
+            for(auto& l : latencies) {
+                int count = l.second.size();
+                std::vector<int> counts(num_ranks), offsets(num_ranks);
+                MPI_Gather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, 0, MPI_COMM_WORLD);
+                size_t total = 0;
+                for(int r = 0; r < num_ranks; r++) {
+                    offsets[r] = total;
+                    total += counts[r];
+                }
+                std::vector<double> all_latencies(rank == 0 ? total : 0);
+                MPI_Gatherv(l.second.data(), count, MPI_DOUBLE,
+                            all_latencies.data(), counts.data(), offsets.data(),
+                            MPI_DOUBLE, 0, MPI_COMM_WORLD);
+                l.second = std::move(all_latencies);
+            }
+            int f = failed;
+            MPI_Allreduce(MPI_IN_PLACE, &f, 1, MPI_INT, MPI_LOR, MPI_COMM_WORLD);
+            failed = f;
+        }
+#endif
+        if(failed) exit_code = 1;
+
+        if(rank == 0) {
+            auto summary = summarizer ? summarizer->summarize(latencies) : json::object();
+            auto report = make_report(opt, num_ranks, backend, config, summary,
+                                      timings, latencies, failed);
+            std::ofstream output_file;
+            if(!opt.output.empty()) {
+                output_file.open(opt.output);
+                if(!output_file.good())
+                    std::cerr << "ERROR: could not open " << opt.output << std::endl;
+            }
+            std::ostream& out = output_file.is_open() ? output_file : std::cout;
+            if(opt.format == "json")
+                out << report.dump(4) << std::endl;
+            else if(opt.format == "csv")
+                print_csv_report(out, report);
+            else
+                print_text_report(out, report);
+        }
+    }
+
+    for(auto& es : xstreams) {
+        ABT_xstream_join(es);
+        ABT_xstream_free(&es);
+    }
+
+    database.reset();
+    client.reset();
+    margo_addr_free(mid, svr_addr);
+    provider.reset();
+    margo_finalize(mid);
+#ifdef YOKAN_BENCHMARK_HAS_MPI
+    MPI_Finalize();
+#endif
+    return exit_code;
+}
+
+static options parse_arguments(int argc, char** argv) {
+    options opt;
+    try {
+        TCLAP::CmdLine cmd("Yokan Benchmark", ' ', "0.1");
+        TCLAP::ValueArg<std::string> operationArg(
+            "o", "operation", "Operation to benchmark (e.g. \"store\")", true, "", "string");
+        TCLAP::ValueArg<range> keySizesArg(
+            "k", "key-sizes", "Range of key sizes (e.g. \"32,64\")", true, range(), "range");
+        TCLAP::ValueArg<range> valSizesArg(
+            "v", "value-sizes", "Range of value sizes (e.g. \"32,64\")", true, range(), "range");
+        TCLAP::ValueArg<unsigned> numItemsArg(
+            "n", "num-items", "Number of items", true, 0, "integer");
+        TCLAP::ValueArg<unsigned> seedArg(
+            "s", "seed", "RNG seed", false, 1234, "integer");
+        TCLAP::ValueArg<unsigned> repetitionsArg(
+            "r", "repetitions", "Number of repetitions of the benchmark", false, 1, "integer");
+        TCLAP::ValueArg<std::string> margoConfigArg(
+            "m", "margo-config", "Margo JSON configuration file", false, "", "filename");
+        TCLAP::ValueArg<std::string> serverAddressArg(
+            "a", "server-address", "Address of the server", true, "", "string");
+        TCLAP::ValueArg<uint16_t> providerIdArg(
+            "p", "provider-id", "Id of the Yokan provider", false, 0, "integer");
+        TCLAP::ValueArg<std::string> prefixArg(
+            "", "prefix", "Prefix to use for some of the keys", false, "", "string");
+        TCLAP::ValueArg<uint16_t> prefixFreqArg(
+            "", "prefix-freq", "Persentage of appearance of the prefix", false, 50, "integer");
+        TCLAP::ValueArg<unsigned> batchSizeArg(
+            "b", "batch-size", "Batch size for operations that acces multiple items", false, 0, "integer");
+        TCLAP::ValueArg<unsigned> numClientsArg(
+            "c", "clients", "Number of concurrent client ULTs per process", false, 1, "integer");
+        TCLAP::ValueArg<unsigned> numXstreamsArg(
+            "x", "xstreams", "Number of execution streams running the client ULTs", false, 0, "integer");
+        TCLAP::ValueArg<double> rateArg(
+            "", "rate", "Target rate of all the clients, in operations per second (0 for closed loop)", false, 0.0, "float");
+        TCLAP::ValueArg<std::string> workloadArg(
+            "w", "workload", "JSON file describing the workload (\"workload\" operation)", false, "", "filename");
+        TCLAP::ValueArg<unsigned> pipelineSizeArg(
+            "", "pipeline-size", "Number of items sent back at once by fetch and iter operations (0 for all)", false, 0, "integer");
+        TCLAP::ValueArg<std::string> sweepArg(
+            "", "sweep", "Pipeline sizes used by the *_sweep operations (e.g. \"1,8,64\")", false, "1,2,4,8,16,32,64", "list");
+        TCLAP::ValueArg<std::string> backendArg(
+            "", "backend", "Type of backend of a provider hosted by the benchmark itself (the server address then only provides the protocol)", false, "", "string");
+        TCLAP::ValueArg<std::string> backendConfigArg(
+            "", "backend-config", "JSON configuration of the backend hosted with --backend", false, "{}", "json");
+        TCLAP::ValueArg<std::string> formatArg(
+            "f", "format", "Format of the results (text, json, or csv)", false, "text", "string");
+        TCLAP::ValueArg<std::string> outputArg(
+            "", "output", "File in which to write the results (standard output by default)", false, "", "filename");
+        TCLAP::SwitchArg noRemoveArg(
+            "", "no-remove", "Do not remove stored key/value on teardown");
+        TCLAP::SwitchArg noRDMAArg(
+            "", "no-rdma", "Do not use RDMA when possible");
+
+        cmd.add(operationArg);
+        cmd.add(keySizesArg);
+        cmd.add(valSizesArg);
+        cmd.add(numItemsArg);
+        cmd.add(seedArg);
+        cmd.add(repetitionsArg);
+        cmd.add(margoConfigArg);
+        cmd.add(serverAddressArg);
+        cmd.add(providerIdArg);
+        cmd.add(prefixArg);
+        cmd.add(prefixFreqArg);
+        cmd.add(batchSizeArg);
+        cmd.add(numClientsArg);
+        cmd.add(numXstreamsArg);
+        cmd.add(rateArg);
+        cmd.add(workloadArg);
+        cmd.add(pipelineSizeArg);
+        cmd.add(sweepArg);
+        cmd.add(backendArg);
+        cmd.add(backendConfigArg);
+        cmd.add(formatArg);
+        cmd.add(outputArg);
+        cmd.add(noRemoveArg);
+        cmd.add(noRDMAArg);
+
+        cmd.parse(argc, argv);
+
+        opt.operation      = operationArg.getValue();
+        opt.key_sizes      = keySizesArg.getValue();
+        opt.val_sizes      = valSizesArg.getValue();
+        opt.num_items      = numItemsArg.getValue();
+        opt.seed           = seedArg.getValue();
+        opt.repetitions    = repetitionsArg.getValue();
+        opt.margo_config   = margoConfigArg.getValue();
+        opt.server_address = serverAddressArg.getValue();
+        opt.provider_id    = providerIdArg.getValue();
+        opt.prefix         = prefixArg.getValue();
+        opt.prefix_freq    = prefixFreqArg.getValue();
+        opt.batch_size     = batchSizeArg.getValue();
+        opt.num_clients    = numClientsArg.getValue();
+        opt.num_xstreams   = numXstreamsArg.getValue();
+        opt.rate           = rateArg.getValue();
+        opt.workload       = workloadArg.getValue();
+        opt.pipeline_size  = pipelineSizeArg.getValue();
+        opt.backend        = backendArg.getValue();
+        opt.backend_config = backendConfigArg.getValue();
+        opt.format         = formatArg.getValue();
+        opt.output         = outputArg.getValue();
+        opt.no_remove      = noRemoveArg.getValue();
+        opt.no_rdma        = noRDMAArg.getValue();
+
+        if(opt.prefix_freq > 100) {
+            throw TCLAP::ArgException(
+                "Value should be between 0 and 100",
+                "prefix-freq", "Invalid value");
+        }
+        if(opt.num_clients == 0) {
+            throw TCLAP::ArgException(
+                "Value should be at least 1",
+                "clients", "Invalid value");
+        }
+        {
+            std::stringstream ss(sweepArg.getValue());
+            std::string item;
+            while(std::getline(ss, item, ',')) {
+                try {
+                    opt.sweep.push_back(std::stoul(item));
+                } catch(const std::exception&) {
+                    throw TCLAP::ArgException(
+                        "Invalid pipeline size \"" + item + "\"",
+                        "sweep", "Invalid value");
+                }
+            }
+        }
+        if(opt.format != "text" && opt.format != "json" && opt.format != "csv") {
+            throw TCLAP::ArgException(
+                "Format should be text, json, or csv",
+                "format", "Invalid value");
+        }
+        if(!json::accept(opt.backend_config)) {
+            throw TCLAP::ArgException(
+                "Backend configuration is not valid JSON",
+                "backend-config", "Invalid value");
         }
-        if(opt.database_id.size() != 36) {
+        if(opt.operation == "workload" && opt.workload.empty()) {
             throw TCLAP::ArgException(
-                "Invalid UUID",
-                "database-id",
-                "Invalid value");
+                "A workload file is required by the workload operation",
+                "workload", "Missing value");
         }
 
     } catch(TCLAP::ArgException &e) {
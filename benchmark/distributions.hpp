@@ -0,0 +1,240 @@
+/*
+ * (C) 2026 The University of Chicago
+ *
+ * See COPYRIGHT in top-level directory.
+ */
+#ifndef __YOKAN_BENCHMARK_DISTRIBUTIONS_HPP
+#define __YOKAN_BENCHMARK_DISTRIBUTIONS_HPP
+
+#include <nlohmann/json.hpp>
+#include <random>
+#include <memory>
+#include <string>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+/**
+ * Generators of integers used by the workload benchmark to pick records
+ * (and sizes). They follow the definitions of the YCSB core workloads.
+ * All generators draw from [0, n), where n is provided at each call
+ * since the number of records grows as records are inserted.
+ */
+
+static inline uint64_t fnv_hash64(uint64_t val) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for(int i = 0; i < 8; i++) {
+        uint64_t octet = val & 0x00ff;
+        val = val >> 8;
+        hash = hash ^ octet;
+        hash = hash * 1099511628211ull;
+    }
+    return hash;
+}
+
+class IntegerGenerator {
+
+    public:
+
+    virtual ~IntegerGenerator() = default;
+
+    virtual uint64_t next(std::mt19937_64& rng, uint64_t n) = 0;
+
+    static std::unique_ptr<IntegerGenerator> make(const nlohmann::json& config);
+
+    protected:
+
+    static double uniform01(std::mt19937_64& rng) {
+        return std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+    }
+};
+
+/**
+ * @brief Uniform distribution over [0, n).
+ */
+class UniformGenerator : public IntegerGenerator {
+
+    public:
+
+    uint64_t next(std::mt19937_64& rng, uint64_t n) override {
+        return std::uniform_int_distribution<uint64_t>(0, n-1)(rng);
+    }
+};
+
+/**
+ * @brief Zipfian distribution over [0, n), where 0 is the most popular
+ * item, following "Quickly Generating Billion-Record Synthetic Databases"
+ * (Gray et al., SIGMOD 1994). The zeta constant is updated incrementally
+ * when n grows.
+ */
+class ZipfianGenerator : public IntegerGenerator {
+
+    public:
+
+    ZipfianGenerator(double theta = 0.99)
+    : m_theta(theta)
+    , m_alpha(1.0/(1.0 - theta))
+    , m_zeta2theta(zeta(0, 2, theta, 0.0)) {}
+
+    uint64_t next(std::mt19937_64& rng, uint64_t n) override {
+        if(n != m_count_for_zeta) {
+            if(n > m_count_for_zeta)
+                m_zetan = zeta(m_count_for_zeta, n, m_theta, m_zetan);
+            else
+                m_zetan = zeta(0, n, m_theta, 0.0);
+            m_count_for_zeta = n;
+            m_eta = (1.0 - std::pow(2.0/n, 1.0 - m_theta))
+                  / (1.0 - m_zeta2theta/m_zetan);
+        }
+        double u  = uniform01(rng);
+        double uz = u*m_zetan;
+        if(uz < 1.0) return 0;
+        if(uz < 1.0 + std::pow(0.5, m_theta)) return std::min<uint64_t>(1, n-1);
+        auto ret = static_cast<uint64_t>(n*std::pow(m_eta*u - m_eta + 1.0, m_alpha));
+        return std::min(ret, n-1);
+    }
+
+    private:
+
+    static double zeta(uint64_t start, uint64_t n, double theta, double initial) {
+        double sum = initial;
+        for(uint64_t i = start; i < n; i++)
+            sum += 1.0/std::pow(i + 1, theta);
+        return sum;
+    }
+
+    double   m_theta;
+    double   m_alpha;
+    double   m_zeta2theta;
+    double   m_zetan = 0.0;
+    double   m_eta = 0.0;
+    uint64_t m_count_for_zeta = 0;
+};
+
+/**
+ * @brief Zipfian distribution in which popular items are scattered
+ * across the key space instead of being the first ones.
+ */
+class ScrambledZipfianGenerator : public IntegerGenerator {
+
+    public:
+
+    ScrambledZipfianGenerator(double theta = 0.99)
+    : m_zipfian(theta) {}
+
+    uint64_t next(std::mt19937_64& rng, uint64_t n) override {
+        return fnv_hash64(m_zipfian.next(rng, n)) % n;
+    }
+
+    private:
+
+    ZipfianGenerator m_zipfian;
+};
+
+/**
+ * @brief Zipfian distribution favoring the most recently inserted items.
+ */
+class LatestGenerator : public IntegerGenerator {
+
+    public:
+
+    LatestGenerator(double theta = 0.99)
+    : m_zipfian(theta) {}
+
+    uint64_t next(std::mt19937_64& rng, uint64_t n) override {
+        return n - 1 - m_zipfian.next(rng, n);
+    }
+
+    private:
+
+    ZipfianGenerator m_zipfian;
+};
+
+/**
+ * @brief A fraction op_fraction of the draws fall uniformly in the first
+ * data_fraction of the items (the hot set), the others fall uniformly
+ * in the rest of the items.
+ */
+class HotspotGenerator : public IntegerGenerator {
+
+    public:
+
+    HotspotGenerator(double data_fraction, double op_fraction)
+    : m_data_fraction(data_fraction)
+    , m_op_fraction(op_fraction) {}
+
+    uint64_t next(std::mt19937_64& rng, uint64_t n) override {
+        uint64_t hot = std::max<uint64_t>(1, static_cast<uint64_t>(n*m_data_fraction));
+        hot = std::min(hot, n);
+        if(hot == n || uniform01(rng) < m_op_fraction)
+            return std::uniform_int_distribution<uint64_t>(0, hot-1)(rng);
+        return std::uniform_int_distribution<uint64_t>(hot, n-1)(rng);
+    }
+
+    private:
+
+    double m_data_fraction;
+    double m_op_fraction;
+};
+
+/**
+ * @brief Build a generator from a JSON object of the form
+ * { "distribution": "uniform" | "zipfian" | "scrambled_zipfian"
+ *                   | "latest" | "hotspot",
+ *   "zipfian_constant": 0.99,
+ *   "hotspot_data_fraction": 0.2,
+ *   "hotspot_op_fraction": 0.8 }
+ */
+inline std::unique_ptr<IntegerGenerator> IntegerGenerator::make(const nlohmann::json& config) {
+    auto distribution = config.value("distribution", "uniform");
+    auto theta = config.value("zipfian_constant", 0.99);
+    if(distribution == "uniform")
+        return std::make_unique<UniformGenerator>();
+    if(distribution == "zipfian")
+        return std::make_unique<ZipfianGenerator>(theta);
+    if(distribution == "scrambled_zipfian")
+        return std::make_unique<ScrambledZipfianGenerator>(theta);
+    if(distribution == "latest")
+        return std::make_unique<LatestGenerator>(theta);
+    if(distribution == "hotspot")
+        return std::make_unique<HotspotGenerator>(
+            config.value("hotspot_data_fraction", 0.2),
+            config.value("hotspot_op_fraction", 0.8));
+    throw std::invalid_argument("unknown distribution \"" + distribution + "\"");
+}
+
+/**
+ * @brief Generates sizes in [min, max] following a distribution built
+ * from a JSON object of the form { "min": ..., "max": ...,
+ * "distribution": "constant" | "uniform" | "zipfian" } (a "constant"
+ * distribution always returns max). Zipfian sizes favor small values.
+ */
+class SizeGenerator {
+
+    public:
+
+    SizeGenerator(const nlohmann::json& config)
+    : m_min(config.value("min", size_t{0}))
+    , m_max(std::max(m_min, config.value("max", m_min))) {
+        auto distribution = config.value("distribution", "uniform");
+        if(distribution != "constant")
+            m_gen = IntegerGenerator::make(config);
+    }
+
+    size_t next(std::mt19937_64& rng) {
+        if(!m_gen) return m_max;
+        return m_min + m_gen->next(rng, m_max - m_min + 1);
+    }
+
+    size_t max() const {
+        return m_max;
+    }
+
+    private:
+
+    size_t                            m_min;
+    size_t                            m_max;
+    std::unique_ptr<IntegerGenerator> m_gen;
+};
+
+#endif
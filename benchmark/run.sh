@@ -29,28 +29,35 @@ BEDROCK_PID=$!
 
 sleep 1
 
-echo "Extracting database id and server address..."
+echo "Extracting server address..."
 
-DATABASE_ID=`awk 'FNR == 1 {print $7}' bedrock.log`
 SVR_ADDRESS=`awk 'FNR == 3 {print $9}' bedrock.log`
 
-echo "Database id is ${DATABASE_ID}"
 echo "Server address is ${SVR_ADDRESS}"
 
+# number of concurrent clients, execution streams running them,
+# and target rate (in operations/second, 0 for closed loop)
+CLIENTS=${CLIENTS:-1}
+XSTREAMS=${XSTREAMS:-0}
+RATE=${RATE:-0}
+
 echo "Starting benchmark"
 
 function run_benchmark {
     echo "=================================="
     echo "Running \"$1\" benchmark"
-    benchmark/yokan-benchmark           \
+    benchmark/yk-benchmark              \
         --operation $1                  \
         --key-sizes 16,32               \
         --value-sizes 128,256           \
         --num-items 16384               \
         --repetitions 8                 \
-        --database-id ${DATABASE_ID}    \
         --server-address ${SVR_ADDRESS} \
-        --batch-size 32
+        --batch-size 32                 \
+        --clients ${CLIENTS}            \
+        --xstreams ${XSTREAMS}          \
+        --rate ${RATE}                  \
+        "${@:2}"
 }
 
 run_benchmark put
@@ -72,6 +79,50 @@ run_benchmark list_keys
 run_benchmark list_keys_packed
 run_benchmark list_keyvals
 run_benchmark list_keyvals_packed
+run_benchmark fetch
+run_benchmark fetch_packed
+run_benchmark fetch_bulk
+run_benchmark fetch_sweep
+run_benchmark iter
+run_benchmark iter_sweep
+run_benchmark erase_range
+run_benchmark put_bulk
+run_benchmark get_bulk
+run_benchmark erase_bulk
+run_benchmark put --no-rdma
+run_benchmark get --no-rdma
+run_benchmark store
+run_benchmark store_multi
+run_benchmark store_packed
+run_benchmark load
+run_benchmark load_packed
+run_benchmark load_bulk
+run_benchmark doc_fetch
+run_benchmark doc_fetch_multi
+run_benchmark doc_list
+run_benchmark doc_iter
+run_benchmark update
+run_benchmark update_packed
+
+# YCSB-style mixed workloads
+for WORKLOAD in $(dirname $0)/workloads/*.json; do
+    run_benchmark workload --workload ${WORKLOAD}
+done
+
+# per-RPC fixed overhead and per-byte cost of each RPC variant,
+# measured against a null backend hosted by the benchmark itself
+echo "=================================="
+echo "Running \"rpc_overhead\" benchmark"
+benchmark/yk-benchmark              \
+    --operation rpc_overhead        \
+    --backend null                  \
+    --server-address na+sm          \
+    --key-sizes 16,16               \
+    --value-sizes 8,65536           \
+    --num-items 256                 \
+    --batch-size 64                 \
+    --format json                   \
+    --output rpc-overhead.json
 
 echo "=================================="
 echo "Killing Bedrock"
@@ -0,0 +1,191 @@
+#!/usr/bin/env python3
+# (C) 2026 The University of Chicago
+# See COPYRIGHT in top-level directory.
+"""
+Compare two result files produced by yk-benchmark --format json and flag
+statistically significant regressions.
+
+The duration of the repetitions (which drives the throughput) and the
+average latency of each operation are compared using Welch's t-test. A
+difference is reported as a regression when it is significant at the
+requested level (--alpha) AND larger than the relative threshold
+(--threshold), so that negligible differences measured over many
+operations are not flagged. Percentiles are reported for information.
+
+Exit status: 0 if no regression was found, 1 if some were, 2 on error.
+"""
+import argparse
+import json
+import math
+import sys
+
+
+def _betacf(a, b, x):
+    """Continued fraction for the incomplete beta function."""
+    tiny = 1e-300
+    qab, qap, qam = a + b, a + 1.0, a - 1.0
+    c = 1.0
+    d = 1.0 - qab * x / qap
+    d = tiny if abs(d) < tiny else d
+    d = 1.0 / d
+    h = d
+    for m in range(1, 300):
+        m2 = 2 * m
+        aa = m * (b - m) * x / ((qam + m2) * (a + m2))
+        d = 1.0 + aa * d
+        d = tiny if abs(d) < tiny else d
+        c = 1.0 + aa / c
+        c = tiny if abs(c) < tiny else c
+        d = 1.0 / d
+        h *= d * c
+        aa = -(a + m) * (qab + m) * x / ((a + m2) * (qap + m2))
+        d = 1.0 + aa * d
+        d = tiny if abs(d) < tiny else d
+        c = 1.0 + aa / c
+        c = tiny if abs(c) < tiny else c
+        d = 1.0 / d
+        delta = d * c
+        h *= delta
+        if abs(delta - 1.0) < 1e-12:
+            break
+    return h
+
+
+def _betainc(a, b, x):
+    """Regularized incomplete beta function I_x(a, b)."""
+    if x <= 0.0:
+        return 0.0
+    if x >= 1.0:
+        return 1.0
+    lbeta = math.lgamma(a + b) - math.lgamma(a) - math.lgamma(b)
+    front = math.exp(lbeta + a * math.log(x) + b * math.log(1.0 - x))
+    if x < (a + 1.0) / (a + b + 2.0):
+        return front * _betacf(a, b, x) / a
+    return 1.0 - front * _betacf(b, a, 1.0 - x) / b
+
+
+def welch_test(n1, mean1, var1, n2, mean2, var2):
+    """Two-sided p-value of Welch's t-test from summary statistics
+    (var1 and var2 are sample variances)."""
+    if n1 < 2 or n2 < 2:
+        return None
+    se2 = var1 / n1 + var2 / n2
+    if se2 <= 0.0:
+        return 0.0 if mean1 != mean2 else 1.0
+    t = (mean2 - mean1) / math.sqrt(se2)
+    df = se2 * se2 / ((var1 / n1) ** 2 / (n1 - 1) + (var2 / n2) ** 2 / (n2 - 1))
+    return _betainc(df / 2.0, 0.5, df / (df + t * t))
+
+
+def sample_stats(samples):
+    n = len(samples)
+    mean = sum(samples) / n if n else 0.0
+    var = sum((x - mean) ** 2 for x in samples) / (n - 1) if n > 1 else 0.0
+    return n, mean, var
+
+
+class Comparison:
+
+    def __init__(self, args):
+        self.alpha = args.alpha
+        self.threshold = args.threshold
+        self.regressions = 0
+        self.rows = []
+
+    def add(self, name, base, curr, p_value=None, higher_is_worse=True):
+        """Record the comparison of a metric. Only metrics with a
+        p-value can be flagged as regressions."""
+        change = (curr - base) / base if base else 0.0
+        worse = change > self.threshold if higher_is_worse else change < -self.threshold
+        significant = p_value is not None and p_value < self.alpha
+        status = ""
+        if significant and worse:
+            status = "REGRESSION"
+            self.regressions += 1
+        elif significant and abs(change) > self.threshold:
+            status = "improvement"
+        self.rows.append((name, base, curr, change, p_value, status))
+
+    def print(self, out):
+        out.write("{:<32} {:>14} {:>14} {:>9} {:>9}  {}\n".format(
+            "metric", "baseline", "current", "change", "p-value", ""))
+        for name, base, curr, change, p_value, status in self.rows:
+            p_str = "{:.4f}".format(p_value) if p_value is not None else "-"
+            out.write("{:<32} {:>14.3f} {:>14.3f} {:>+8.1f}% {:>9}  {}\n".format(
+                name, base, curr, change * 100.0, p_str, status))
+
+
+def check_configs(baseline, current, out):
+    """Warn about configuration differences, other than build information."""
+    base_cfg = dict(baseline.get("config", {}))
+    curr_cfg = dict(current.get("config", {}))
+    base_cfg.pop("build", None)
+    curr_cfg.pop("build", None)
+    for key in sorted(set(base_cfg) | set(curr_cfg)):
+        if base_cfg.get(key) != curr_cfg.get(key):
+            out.write("WARNING: {} differs ({} vs {})\n".format(
+                key, json.dumps(base_cfg.get(key)), json.dumps(curr_cfg.get(key))))
+
+
+def compare(baseline, current, args):
+    comparison = Comparison(args)
+
+    base_n, base_mean, base_var = sample_stats(baseline["timing_ms"]["samples"])
+    curr_n, curr_mean, curr_var = sample_stats(current["timing_ms"]["samples"])
+    comparison.add("time (ms)", base_mean, curr_mean,
+                   welch_test(base_n, base_mean, base_var, curr_n, curr_mean, curr_var))
+    comparison.add("throughput (ops/s)",
+                   baseline["throughput"]["ops_per_second"],
+                   current["throughput"]["ops_per_second"],
+                   higher_is_worse=False)
+
+    base_lat = baseline["latency_us"]
+    curr_lat = current["latency_us"]
+    for op in sorted(set(base_lat) & set(curr_lat)):
+        b, c = base_lat[op], curr_lat[op]
+        b_n, c_n = b["operations"], c["operations"]
+        # the reports hold population standard deviations
+        b_var = b["stddev"] ** 2 * b_n / (b_n - 1) if b_n > 1 else 0.0
+        c_var = c["stddev"] ** 2 * c_n / (c_n - 1) if c_n > 1 else 0.0
+        comparison.add(op + " avg (us)", b["average"], c["average"],
+                       welch_test(b_n, b["average"], b_var, c_n, c["average"], c_var))
+        for p in ("p50", "p99"):
+            comparison.add(op + " " + p + " (us)", b[p], c[p])
+    for op in sorted(set(base_lat) ^ set(curr_lat)):
+        sys.stdout.write("WARNING: operation {} is only in one of the results\n".format(op))
+    return comparison
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Compare two yk-benchmark JSON results and flag regressions")
+    parser.add_argument("baseline", help="JSON results used as reference")
+    parser.add_argument("current", help="JSON results to compare to the reference")
+    parser.add_argument("--alpha", type=float, default=0.05,
+                        help="significance level of the tests (default: 0.05)")
+    parser.add_argument("--threshold", type=float, default=0.05,
+                        help="minimum relative change to flag (default: 0.05)")
+    args = parser.parse_args()
+
+    try:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        with open(args.current) as f:
+            current = json.load(f)
+        check_configs(baseline, current, sys.stdout)
+        comparison = compare(baseline, current, args)
+    except (OSError, ValueError, KeyError) as e:
+        sys.stderr.write("ERROR: {}\n".format(e))
+        return 2
+
+    comparison.print(sys.stdout)
+    if current.get("failed", False):
+        sys.stdout.write("WARNING: some operations failed in the current results\n")
+    if comparison.regressions:
+        sys.stdout.write("{} regression(s) found\n".format(comparison.regressions))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
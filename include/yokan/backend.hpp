@@ -122,6 +122,18 @@ class DatabaseInterface {
      */
     virtual std::string config() const = 0;
 
+    /**
+     * @brief Get backend-specific statistics (number of entries, memory
+     * used, internal counters of the underlying library, etc.) as a
+     * JSON-formatted string. The content of the returned object depends
+     * on the backend.
+     *
+     * @return Backend statistics.
+     */
+    virtual std::string stats() const {
+        return "{}";
+    }
+
     /**
      * @brief Destroy the resources (files, etc.) associated with the database.
      */
@@ -149,6 +161,20 @@ class DatabaseInterface {
      */
     virtual bool isSorted() const = 0;
 
+    /**
+     * @brief Check if the memory passed by fetch() and docFetch()
+     * to their callback remains valid until the fetch()/docFetch()
+     * call returns (e.g. because it points into a memory-mapped region
+     * that is pinned for the duration of the call). If this is the case,
+     * the provider may expose this memory for RDMA directly instead of
+     * copying values into an intermediate buffer.
+     *
+     * @return true/false.
+     */
+    virtual bool supportsZeroCopyFetch() const {
+        return false;
+    }
+
     /**
      * @brief Get the number of key/value pairs stored.
      *
@@ -337,6 +363,105 @@ class DatabaseInterface {
      */
     virtual Status eraseRange(int32_t mode, const UserMem& prefix);
 
+    /**
+     * @brief Read the bytes of the value associated with a key, starting
+     * at the given offset. data.size is used both as input (maximum number
+     * of bytes to read) and as output (number of bytes actually read, which
+     * is smaller if the value ends before offset + data.size, and 0 if the
+     * offset is past the end of the value).
+     *
+     * The default implementation relies on fetch. Backends that can access
+     * part of a value without copying all of it should override it.
+     *
+     * @param [in] mode Mode.
+     * @param [in] key Key.
+     * @param [in] offset Offset within the value.
+     * @param [in,out] data Memory to read the bytes into.
+     *
+     * @return Status (NotFound if the key does not exist).
+     */
+    virtual Status getRange(int32_t mode, const UserMem& key,
+                            size_t offset, UserMem& data);
+
+    /**
+     * @brief Overwrite the bytes of the value associated with a key,
+     * starting at the given offset. If the value ends before
+     * offset + data.size, it is extended, the bytes between its former end
+     * and the offset (if any) being set to 0. A key that does not exist is
+     * created, unless YOKAN_MODE_EXIST_ONLY is provided. With
+     * YOKAN_MODE_NEW_ONLY, the key must not exist.
+     *
+     * The default implementation is a read-modify-write of the whole value
+     * (fetch followed by put), which is not atomic with respect to other
+     * writers of the same key. Backends should override it when they can
+     * update the value in place or within a single transaction.
+     *
+     * @param [in] mode Mode.
+     * @param [in] key Key.
+     * @param [in] offset Offset within the value.
+     * @param [in] data Bytes to write.
+     *
+     * @return Status.
+     */
+    virtual Status putRange(int32_t mode, const UserMem& key,
+                            size_t offset, const UserMem& data);
+
+    /**
+     * @brief Replace the value associated with a key with a new value,
+     * only if the current value is equal to the expected one. The
+     * comparison and the replacement must happen atomically with respect
+     * to other writers, hence there is no default implementation.
+     *
+     * @param [in] mode Mode.
+     * @param [in] key Key.
+     * @param [in] expected Expected current value.
+     * @param [in] value New value.
+     * @param [out] swapped Whether the value was replaced.
+     *
+     * @return Status (NotFound if the key does not exist).
+     */
+    virtual Status compareAndSwap(int32_t mode, const UserMem& key,
+                                  const UserMem& expected,
+                                  const UserMem& value,
+                                  bool* swapped) {
+        (void)mode;
+        (void)key;
+        (void)expected;
+        (void)value;
+        (void)swapped;
+        return Status::NotSupported;
+    }
+
+    using MergeCallback = std::function<void(const UserMem& val)>;
+
+    /**
+     * @brief Atomically apply one of the YOKAN_MERGE_* operators to the
+     * value associated with a key. A key that does not exist is created
+     * (the operator being applied to an empty value), unless
+     * YOKAN_MODE_EXIST_ONLY is provided. If func is not empty, it is
+     * called with the new value once the operator has been applied.
+     *
+     * @param [in] mode Mode.
+     * @param [in] key Key.
+     * @param [in] op Operator.
+     * @param [in] operand Operand.
+     * @param [in] bound Maximum size of the value (YOKAN_MERGE_APPEND only, 0 for none).
+     * @param [in] func Function to call with the new value (may be empty).
+     *
+     * @return Status.
+     */
+    virtual Status merge(int32_t mode, const UserMem& key,
+                         int32_t op, const UserMem& operand,
+                         size_t bound, const MergeCallback& func) {
+        (void)mode;
+        (void)key;
+        (void)op;
+        (void)operand;
+        (void)bound;
+        (void)func;
+        return Status::NotSupported;
+    }
+
     /**
      * @brief This version of listKeys uses a single contiguous buffer
      * to hold all the keys. Their size is stored in the keySizes user-allocated
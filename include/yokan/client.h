@@ -7,6 +7,7 @@
 #define __YOKAN_CLIENT_H
 
 #include <margo.h>
+#include <stdbool.h>
 #include <yokan/common.h>
 
 #ifdef __cplusplus
@@ -35,6 +36,106 @@ yk_return_t yk_client_init(margo_instance_id mid, yk_client_t* client);
  */
 yk_return_t yk_client_finalize(yk_client_t client);
 
+/**
+ * @brief Sets the size (in bytes) under which operations send their data
+ * along with the RPC instead of exposing it via RDMA, when
+ * YOKAN_MODE_NO_RDMA is not specified. The size accounts for the keys,
+ * values, and size arrays sent or received by the operation. It defaults
+ * to the smallest of Mercury's input and output eager sizes. A threshold
+ * of 0 makes the client always use RDMA unless YOKAN_MODE_NO_RDMA is set.
+ * The threshold can be overridden for a single operation using
+ * YOKAN_EXTRA_DIRECT_THRESHOLD.
+ *
+ * @param[in] client YOKAN client
+ * @param[in] threshold Threshold in bytes
+ *
+ * @return YOKAN_SUCCESS or error code defined in common.h
+ */
+yk_return_t yk_client_set_direct_threshold(yk_client_t client, size_t threshold);
+
+/**
+ * @brief Gets the direct threshold of the client
+ * (see yk_client_set_direct_threshold).
+ *
+ * @param[in] client YOKAN client
+ * @param[out] threshold Threshold in bytes
+ *
+ * @return YOKAN_SUCCESS or error code defined in common.h
+ */
+yk_return_t yk_client_get_direct_threshold(yk_client_t client, size_t* threshold);
+
+/**
+ * @brief Gets statistics about the client, as a JSON string of the form
+ * {"direct_threshold": N, "transport": {"put": {"direct": D, "bulk": B}, ...},
+ *  "bulk_cache": {"capacity": C, "entries": E, "registered_buffers": R,
+ *                 "hits": H, "misses": M}},
+ * where "transport" counts, for each operation, how many times the data
+ * was sent along with the RPC and how many times it was transferred via
+ * RDMA. Operations that have not been called are omitted. "bulk_cache"
+ * describes the registration cache (see yk_client_register_buffer). The caller is
+ * responsible for freeing the string using free().
+ *
+ * @param[in] client YOKAN client
+ * @param[in] reset Whether to reset the counters
+ * @param[out] stats JSON string
+ *
+ * @return YOKAN_SUCCESS or error code defined in common.h
+ */
+yk_return_t yk_client_get_stats(yk_client_t client, bool reset, char** stats);
+
+/**
+ * @brief Registers a long-lived buffer with the client. The bulk handles
+ * that the client creates to expose memory located entirely within
+ * registered buffers are kept in a cache (up to the capacity set with
+ * yk_client_set_bulk_cache_capacity, 64 by default, least recently used
+ * handles being evicted first) and reused across operations instead of
+ * being created for every operation. The buffer must be unregistered with
+ * yk_client_unregister_buffer before being freed, and registered buffers
+ * cannot overlap.
+ *
+ * If bulk is not NULL, it is set to a handle exposing the whole buffer
+ * with the provided access flags (HG_BULK_READ_ONLY, HG_BULK_WRITE_ONLY,
+ * or HG_BULK_READWRITE), which can be used with the *_bulk functions
+ * (with a NULL origin). This handle belongs to the client and remains
+ * valid until the buffer is unregistered.
+ *
+ * @param[in] client YOKAN client
+ * @param[in] ptr Start of the buffer
+ * @param[in] size Size of the buffer
+ * @param[in] flags Access flags of the handle exposing the buffer
+ * @param[out] bulk Optional handle exposing the buffer
+ *
+ * @return YOKAN_SUCCESS or error code defined in common.h
+ */
+yk_return_t yk_client_register_buffer(yk_client_t client,
+                                      void* ptr,
+                                      size_t size,
+                                      hg_uint8_t flags,
+                                      hg_bulk_t* bulk);
+
+/**
+ * @brief Unregisters a buffer registered with yk_client_register_buffer,
+ * freeing the cached bulk handles that expose part of it.
+ *
+ * @param[in] client YOKAN client
+ * @param[in] ptr Start of the buffer
+ *
+ * @return YOKAN_SUCCESS or error code defined in common.h
+ */
+yk_return_t yk_client_unregister_buffer(yk_client_t client, void* ptr);
+
+/**
+ * @brief Sets the maximum number of bulk handles kept in the client's
+ * registration cache (see yk_client_register_buffer). A capacity of 0
+ * disables the cache.
+ *
+ * @param[in] client YOKAN client
+ * @param[in] capacity Maximum number of cached handles
+ *
+ * @return YOKAN_SUCCESS or error code defined in common.h
+ */
+yk_return_t yk_client_set_bulk_cache_capacity(yk_client_t client, size_t capacity);
+
 #ifdef __cplusplus
 }
 #endif
@@ -105,6 +105,8 @@ typedef enum yk_return_t {
  *   separated by a column character.
  * - YOKAN_MODE_NO_RDMA: use a version of the RPC that does not use RDMA for data
  *   transfers, when multiple underlying implementations of the RPC exists.
+ *   Without this flag, the client picks the version that does not use RDMA
+ *   for operations whose data fits in the client's direct threshold.
  * - YOKAN_MODE_UPDATE_NEW: allow yk_doc_update to create a document with the
  *   specified ID if it does not exist.
  * - YOKAN_MODE_EXTRA: indicates that the function call carries one additional
@@ -153,9 +155,41 @@ typedef enum yk_return_t {
  * - YOKAN_EXTRA_END:        sentinel, no value follows.
  * - YOKAN_EXTRA_TIMEOUT_MS: value is a double (milliseconds). A value of 0.0
  *                           means blocking forever (no timeout).
+ * - YOKAN_EXTRA_TRACE_ID:   value is a uint64_t identifying the request in
+ *                           the provider's trace (see "tracing" in the
+ *                           provider configuration). A value of 0 lets the
+ *                           provider assign an identifier. Only the put, get,
+ *                           fetch, erase, exists, and length operations are
+ *                           traced; other operations ignore it.
+ * - YOKAN_EXTRA_DIRECT_THRESHOLD: value is a size_t overriding, for this
+ *                           call, the direct threshold of the client (see
+ *                           yk_client_set_direct_threshold in yokan/client.h).
+ *                           A value of SIZE_MAX keeps the client's threshold.
  */
-#define YOKAN_EXTRA_END         0
-#define YOKAN_EXTRA_TIMEOUT_MS  1
+#define YOKAN_EXTRA_END              0
+#define YOKAN_EXTRA_TIMEOUT_MS       1
+#define YOKAN_EXTRA_TRACE_ID         2
+#define YOKAN_EXTRA_DIRECT_THRESHOLD 3
+
+/**
+ * @brief Operators that can be passed to yk_merge. The operator is
+ * applied atomically, on the provider, to the current value of the key.
+ * A key that does not exist is treated as having an empty value.
+ * - YOKAN_MERGE_ADD_INT64: the value and the operand are native int64_t
+ *   (an empty value being 0) and the operand is added to the value.
+ * - YOKAN_MERGE_MAX_INT64: the value and the operand are native int64_t
+ *   (an empty value being 0) and the value becomes the maximum of both.
+ * - YOKAN_MERGE_BIT_OR: the value becomes the bitwise "or" of the value
+ *   and the operand, the value being first extended with zeros if it is
+ *   shorter than the operand.
+ * - YOKAN_MERGE_APPEND: the operand is appended to the value. If a
+ *   bound is provided, the oldest bytes are then dropped so that the
+ *   value does not exceed the bound.
+ */
+#define YOKAN_MERGE_ADD_INT64 0
+#define YOKAN_MERGE_MAX_INT64 1
+#define YOKAN_MERGE_BIT_OR    2
+#define YOKAN_MERGE_APPEND    3
 
 /**
  * @brief Record when working with collections.
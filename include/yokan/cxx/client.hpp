@@ -11,6 +11,7 @@
 #include <yokan/cxx/exception.hpp>
 #include <yokan/cxx/database.hpp>
 #include <memory>
+#include <string>
 
 namespace yokan {
 
@@ -47,6 +48,45 @@ class Client {
         return Database(db, false, m_client);
     }
 
+    void setDirectThreshold(size_t threshold) const {
+        auto err = yk_client_set_direct_threshold(handle(), threshold);
+        YOKAN_CONVERT_AND_THROW(err);
+    }
+
+    size_t directThreshold() const {
+        size_t threshold;
+        auto err = yk_client_get_direct_threshold(handle(), &threshold);
+        YOKAN_CONVERT_AND_THROW(err);
+        return threshold;
+    }
+
+    hg_bulk_t registerBuffer(void* ptr, size_t size,
+                             hg_uint8_t flags = HG_BULK_READWRITE) const {
+        hg_bulk_t bulk = HG_BULK_NULL;
+        auto err = yk_client_register_buffer(handle(), ptr, size, flags, &bulk);
+        YOKAN_CONVERT_AND_THROW(err);
+        return bulk;
+    }
+
+    void unregisterBuffer(void* ptr) const {
+        auto err = yk_client_unregister_buffer(handle(), ptr);
+        YOKAN_CONVERT_AND_THROW(err);
+    }
+
+    void setBulkCacheCapacity(size_t capacity) const {
+        auto err = yk_client_set_bulk_cache_capacity(handle(), capacity);
+        YOKAN_CONVERT_AND_THROW(err);
+    }
+
+    std::string getStats(bool reset = false) const {
+        char* stats = nullptr;
+        auto err = yk_client_get_stats(handle(), reset, &stats);
+        YOKAN_CONVERT_AND_THROW(err);
+        auto result = std::string{stats ? stats : "{}"};
+        free(stats);
+        return result;
+    }
+
     yk_client_t handle() const {
         return m_client.get();
     }
@@ -29,7 +29,7 @@ class Collection {
 
     template <typename... Extras>
     size_t size(int32_t mode = YOKAN_MODE_DEFAULT, Extras&&... extras) const {
-        detail::check_known_extras<Extras...>();
+        detail::check_collection_extras<Extras...>();
         size_t s;
         yk_return_t err;
         if constexpr (sizeof...(Extras) == 0) {
@@ -37,9 +37,12 @@ class Collection {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_collection_size(m_db.handle(), m_name.c_str(),
                 mode | YOKAN_MODE_EXTRA, &s,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -48,7 +51,7 @@ class Collection {
 
     template <typename... Extras>
     yk_id_t last_id(int32_t mode = YOKAN_MODE_DEFAULT, Extras&&... extras) const {
-        detail::check_known_extras<Extras...>();
+        detail::check_collection_extras<Extras...>();
         yk_id_t last;
         yk_return_t err;
         if constexpr (sizeof...(Extras) == 0) {
@@ -57,9 +60,12 @@ class Collection {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_collection_last_id(m_db.handle(), m_name.c_str(),
                 mode | YOKAN_MODE_EXTRA, &last,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -70,7 +76,7 @@ class Collection {
     yk_id_t store(const void* doc, size_t docsize,
                   int32_t mode = YOKAN_MODE_DEFAULT,
                   Extras&&... extras) const {
-        detail::check_known_extras<Extras...>();
+        detail::check_collection_extras<Extras...>();
         yk_id_t id;
         yk_return_t err;
         if constexpr (sizeof...(Extras) == 0) {
@@ -79,9 +85,12 @@ class Collection {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_doc_store(m_db.handle(), m_name.c_str(),
                 mode | YOKAN_MODE_EXTRA, doc, docsize, &id,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -93,7 +102,7 @@ class Collection {
                     const size_t* docsizes, yk_id_t* ids,
                     int32_t mode = YOKAN_MODE_DEFAULT,
                     Extras&&... extras) const {
-        detail::check_known_extras<Extras...>();
+        detail::check_collection_extras<Extras...>();
         yk_return_t err;
         if constexpr (sizeof...(Extras) == 0) {
             err = yk_doc_store_multi(m_db.handle(), m_name.c_str(),
@@ -102,9 +111,12 @@ class Collection {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_doc_store_multi(m_db.handle(), m_name.c_str(),
                 mode | YOKAN_MODE_EXTRA, count, documents, docsizes, ids,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -115,7 +127,7 @@ class Collection {
                      const size_t* docsizes, yk_id_t* ids,
                      int32_t mode = YOKAN_MODE_DEFAULT,
                      Extras&&... extras) const {
-        detail::check_known_extras<Extras...>();
+        detail::check_collection_extras<Extras...>();
         yk_return_t err;
         if constexpr (sizeof...(Extras) == 0) {
             err = yk_doc_store_packed(m_db.handle(), m_name.c_str(),
@@ -124,9 +136,12 @@ class Collection {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_doc_store_packed(m_db.handle(), m_name.c_str(),
                 mode | YOKAN_MODE_EXTRA, count, documents, docsizes, ids,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -139,7 +154,7 @@ class Collection {
                    const char* origin = nullptr,
                    int32_t mode = YOKAN_MODE_DEFAULT,
                    Extras&&... extras) const {
-        detail::check_known_extras<Extras...>();
+        detail::check_collection_extras<Extras...>();
         yk_return_t err;
         if constexpr (sizeof...(Extras) == 0) {
             err = yk_doc_store_bulk(m_db.handle(), m_name.c_str(),
@@ -148,10 +163,13 @@ class Collection {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_doc_store_bulk(m_db.handle(), m_name.c_str(),
                 mode | YOKAN_MODE_EXTRA, count, origin, data,
                 offset, size, ids,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -161,7 +179,7 @@ class Collection {
     void load(yk_id_t id, void* data, size_t* size,
               int32_t mode = YOKAN_MODE_DEFAULT,
               Extras&&... extras) const {
-        detail::check_known_extras<Extras...>();
+        detail::check_collection_extras<Extras...>();
         yk_return_t err;
         if constexpr (sizeof...(Extras) == 0) {
             err = yk_doc_load(m_db.handle(), m_name.c_str(),
@@ -169,9 +187,12 @@ class Collection {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_doc_load(m_db.handle(), m_name.c_str(),
                 mode | YOKAN_MODE_EXTRA, id, data, size,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -184,7 +205,7 @@ class Collection {
                    size_t* docsizes,
                    int32_t mode = YOKAN_MODE_DEFAULT,
                    Extras&&... extras) const {
-        detail::check_known_extras<Extras...>();
+        detail::check_collection_extras<Extras...>();
         yk_return_t err;
         if constexpr (sizeof...(Extras) == 0) {
             err = yk_doc_load_multi(m_db.handle(), m_name.c_str(),
@@ -192,9 +213,12 @@ class Collection {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_doc_load_multi(m_db.handle(), m_name.c_str(),
                 mode | YOKAN_MODE_EXTRA, count, ids, documents, docsizes,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -208,7 +232,7 @@ class Collection {
                     size_t* docsizes,
                     int32_t mode = YOKAN_MODE_DEFAULT,
                     Extras&&... extras) const {
-        detail::check_known_extras<Extras...>();
+        detail::check_collection_extras<Extras...>();
         yk_return_t err;
         if constexpr (sizeof...(Extras) == 0) {
             err = yk_doc_load_packed(m_db.handle(), m_name.c_str(),
@@ -217,10 +241,13 @@ class Collection {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_doc_load_packed(m_db.handle(), m_name.c_str(),
                 mode | YOKAN_MODE_EXTRA, count, ids, bufsize,
                 documents, docsizes,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -236,7 +263,7 @@ class Collection {
                   const char* origin = nullptr,
                   int32_t mode = YOKAN_MODE_DEFAULT,
                   Extras&&... extras) const {
-        detail::check_known_extras<Extras...>();
+        detail::check_collection_extras<Extras...>();
         yk_return_t err;
         if constexpr (sizeof...(Extras) == 0) {
             err = yk_doc_load_bulk(m_db.handle(), m_name.c_str(),
@@ -245,10 +272,13 @@ class Collection {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_doc_load_bulk(m_db.handle(), m_name.c_str(),
                 mode | YOKAN_MODE_EXTRA, count, ids, origin,
                 data, offset, size, packed,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -260,16 +290,19 @@ class Collection {
                void* uargs,
                int32_t mode = YOKAN_MODE_DEFAULT,
                Extras&&... extras) const {
-        detail::check_known_extras<Extras...>();
+        detail::check_collection_extras<Extras...>();
         yk_return_t err;
         if constexpr (sizeof...(Extras) == 0) {
             err = yk_doc_fetch(m_db.handle(), m_name.c_str(), mode, id, cb, uargs);
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_doc_fetch(m_db.handle(), m_name.c_str(),
                 mode | YOKAN_MODE_EXTRA, id, cb, uargs,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -302,7 +335,7 @@ class Collection {
                     const yk_doc_fetch_options_t* options = nullptr,
                     int32_t mode = YOKAN_MODE_DEFAULT,
                     Extras&&... extras) const {
-        detail::check_known_extras<Extras...>();
+        detail::check_collection_extras<Extras...>();
         yk_return_t err;
         if constexpr (sizeof...(Extras) == 0) {
             err = yk_doc_fetch_multi(
@@ -311,10 +344,13 @@ class Collection {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_doc_fetch_multi(
                     m_db.handle(), m_name.c_str(),
                     mode | YOKAN_MODE_EXTRA, count, ids, cb, uargs, options,
                     YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                    YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                     YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -335,7 +371,7 @@ class Collection {
     size_t length(yk_id_t id,
                   int32_t mode = YOKAN_MODE_DEFAULT,
                   Extras&&... extras) const {
-        detail::check_known_extras<Extras...>();
+        detail::check_collection_extras<Extras...>();
         size_t size;
         yk_return_t err;
         if constexpr (sizeof...(Extras) == 0) {
@@ -344,9 +380,12 @@ class Collection {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_doc_length(m_db.handle(), m_name.c_str(),
                 mode | YOKAN_MODE_EXTRA, id, &size,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -357,7 +396,7 @@ class Collection {
     void lengthMulti(size_t count, const yk_id_t* ids,
                      size_t* sizes, int32_t mode = YOKAN_MODE_DEFAULT,
                      Extras&&... extras) const {
-        detail::check_known_extras<Extras...>();
+        detail::check_collection_extras<Extras...>();
         yk_return_t err;
         if constexpr (sizeof...(Extras) == 0) {
             err = yk_doc_length_multi(m_db.handle(), m_name.c_str(),
@@ -365,9 +404,12 @@ class Collection {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_doc_length_multi(m_db.handle(), m_name.c_str(),
                 mode | YOKAN_MODE_EXTRA, count, ids, sizes,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -377,7 +419,7 @@ class Collection {
     void update(yk_id_t id, const void* document, size_t docsize,
                 int32_t mode = YOKAN_MODE_DEFAULT,
                 Extras&&... extras) const {
-        detail::check_known_extras<Extras...>();
+        detail::check_collection_extras<Extras...>();
         yk_return_t err;
         if constexpr (sizeof...(Extras) == 0) {
             err = yk_doc_update(m_db.handle(), m_name.c_str(),
@@ -385,9 +427,12 @@ class Collection {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_doc_update(m_db.handle(), m_name.c_str(),
                 mode | YOKAN_MODE_EXTRA, id, document, docsize,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -400,7 +445,7 @@ class Collection {
                      const size_t* docsizes,
                      int32_t mode = YOKAN_MODE_DEFAULT,
                      Extras&&... extras) const {
-        detail::check_known_extras<Extras...>();
+        detail::check_collection_extras<Extras...>();
         yk_return_t err;
         if constexpr (sizeof...(Extras) == 0) {
             err = yk_doc_update_multi(m_db.handle(), m_name.c_str(),
@@ -409,10 +454,13 @@ class Collection {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_doc_update_multi(m_db.handle(), m_name.c_str(),
                 mode | YOKAN_MODE_EXTRA, count, ids,
                 documents, docsizes,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -425,7 +473,7 @@ class Collection {
                       const size_t* docsizes,
                       int32_t mode = YOKAN_MODE_DEFAULT,
                       Extras&&... extras) const {
-        detail::check_known_extras<Extras...>();
+        detail::check_collection_extras<Extras...>();
         yk_return_t err;
         if constexpr (sizeof...(Extras) == 0) {
             err = yk_doc_update_packed(m_db.handle(), m_name.c_str(),
@@ -434,10 +482,13 @@ class Collection {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_doc_update_packed(m_db.handle(), m_name.c_str(),
                 mode | YOKAN_MODE_EXTRA, count, ids,
                 documents, docsizes,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -452,7 +503,7 @@ class Collection {
                     const char* origin = nullptr,
                     int32_t mode = YOKAN_MODE_DEFAULT,
                     Extras&&... extras) const {
-        detail::check_known_extras<Extras...>();
+        detail::check_collection_extras<Extras...>();
         yk_return_t err;
         if constexpr (sizeof...(Extras) == 0) {
             err = yk_doc_update_bulk(m_db.handle(), m_name.c_str(),
@@ -461,10 +512,13 @@ class Collection {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_doc_update_bulk(m_db.handle(), m_name.c_str(),
                 mode | YOKAN_MODE_EXTRA, count, ids, origin,
                 data, offset, size,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -477,16 +531,19 @@ class Collection {
     template <typename... Extras>
     void erase(yk_id_t id, int32_t mode = YOKAN_MODE_DEFAULT,
                Extras&&... extras) const {
-        detail::check_known_extras<Extras...>();
+        detail::check_collection_extras<Extras...>();
         yk_return_t err;
         if constexpr (sizeof...(Extras) == 0) {
             err = yk_doc_erase(m_db.handle(), m_name.c_str(), mode, id);
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_doc_erase(m_db.handle(), m_name.c_str(),
                 mode | YOKAN_MODE_EXTRA, id,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -497,7 +554,7 @@ class Collection {
                     const yk_id_t* ids,
                     int32_t mode = YOKAN_MODE_DEFAULT,
                     Extras&&... extras) const {
-        detail::check_known_extras<Extras...>();
+        detail::check_collection_extras<Extras...>();
         yk_return_t err;
         if constexpr (sizeof...(Extras) == 0) {
             err = yk_doc_erase_multi(m_db.handle(), m_name.c_str(),
@@ -505,9 +562,12 @@ class Collection {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_doc_erase_multi(m_db.handle(), m_name.c_str(),
                 mode | YOKAN_MODE_EXTRA, count, ids,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -523,7 +583,7 @@ class Collection {
               size_t* doc_sizes,
               int32_t mode = YOKAN_MODE_DEFAULT,
               Extras&&... extras) const {
-        detail::check_known_extras<Extras...>();
+        detail::check_collection_extras<Extras...>();
         yk_return_t err;
         if constexpr (sizeof...(Extras) == 0) {
             err = yk_doc_list(m_db.handle(), m_name.c_str(),
@@ -532,10 +592,13 @@ class Collection {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_doc_list(m_db.handle(), m_name.c_str(),
                 mode | YOKAN_MODE_EXTRA, start_id, filter, filter_size,
                 max, ids, docs, doc_sizes,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -552,7 +615,7 @@ class Collection {
                     size_t* doc_sizes,
                     int32_t mode = YOKAN_MODE_DEFAULT,
                     Extras&&... extras) const {
-        detail::check_known_extras<Extras...>();
+        detail::check_collection_extras<Extras...>();
         yk_return_t err;
         if constexpr (sizeof...(Extras) == 0) {
             err = yk_doc_list_packed(m_db.handle(), m_name.c_str(),
@@ -561,10 +624,13 @@ class Collection {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_doc_list_packed(m_db.handle(), m_name.c_str(),
                 mode | YOKAN_MODE_EXTRA, start_id, filter, filter_size,
                 max, ids, bufsize, docs, doc_sizes,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -581,7 +647,7 @@ class Collection {
                   const char* origin = nullptr,
                   int32_t mode = YOKAN_MODE_DEFAULT,
                   Extras&&... extras) const {
-        detail::check_known_extras<Extras...>();
+        detail::check_collection_extras<Extras...>();
         yk_return_t err;
         if constexpr (sizeof...(Extras) == 0) {
             err = yk_doc_list_bulk(m_db.handle(), m_name.c_str(),
@@ -592,11 +658,14 @@ class Collection {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_doc_list_bulk(m_db.handle(), m_name.c_str(),
                 mode | YOKAN_MODE_EXTRA, from_id, filter_size,
                 origin, data, offset, docs_buf_size,
                 packed, count,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -612,7 +681,7 @@ class Collection {
               const yk_doc_iter_options_t* options = nullptr,
               int32_t mode = YOKAN_MODE_DEFAULT,
               Extras&&... extras) const {
-        detail::check_known_extras<Extras...>();
+        detail::check_collection_extras<Extras...>();
         yk_return_t err;
         if constexpr (sizeof...(Extras) == 0) {
             err = yk_doc_iter(m_db.handle(), m_name.c_str(),
@@ -621,10 +690,13 @@ class Collection {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_doc_iter(m_db.handle(), m_name.c_str(),
                 mode | YOKAN_MODE_EXTRA, from_id, filter, filter_size,
                 max, cb, uargs, options,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
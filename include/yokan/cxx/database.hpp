@@ -11,15 +11,26 @@
 #include <yokan/cxx/exception.hpp>
 #include <yokan/cxx/extras.hpp>
 #include <vector>
+#include <string>
 #include <functional>
 #include <memory>
 #include <utility>
+#include <cstdlib>
 
 namespace yokan {
 
 class Client;
 class Collection;
 
+/**
+ * @brief Buffer allocated by the client library to hold values
+ * (see Database::getAlloc), freed when the object is destroyed.
+ */
+struct AllocatedBuffer {
+    std::unique_ptr<char, decltype(&std::free)> data{nullptr, std::free};
+    size_t                                      size = 0;
+};
+
 class Database {
 
     friend class Client;
@@ -60,8 +71,14 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_count(handle(), mode | YOKAN_MODE_EXTRA, &c,
                            YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                           YOKAN_EXTRA_TRACE_ID, tr.id,
+                           YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                            YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -82,9 +99,15 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_put(handle(), mode | YOKAN_MODE_EXTRA,
                          key, ksize, value, vsize,
                          YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                         YOKAN_EXTRA_TRACE_ID, tr.id,
+                         YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                          YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -106,9 +129,15 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_put_multi(handle(), mode | YOKAN_MODE_EXTRA, count,
                 keys, ksizes, values, vsizes,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -130,9 +159,15 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_put_packed(handle(), mode | YOKAN_MODE_EXTRA, count,
                 keys, ksizes, values, vsizes,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -154,9 +189,15 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_put_bulk(handle(), mode | YOKAN_MODE_EXTRA, count,
                 origin, data, offset, size,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -175,8 +216,14 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_exists(handle(), mode | YOKAN_MODE_EXTRA, key, ksize, &e,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -198,9 +245,15 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_exists_multi(handle(), mode | YOKAN_MODE_EXTRA, count,
                 keys, ksizes, flags.data(),
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -226,9 +279,15 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_exists_packed(handle(), mode | YOKAN_MODE_EXTRA, count,
                 keys, ksizes, flags.data(),
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -256,9 +315,15 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_exists_bulk(handle(),
                 mode | YOKAN_MODE_EXTRA, count, origin, data, offset, size,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -277,8 +342,14 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_length(handle(), mode | YOKAN_MODE_EXTRA, key, ksize, &vsize,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -299,9 +370,15 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_length_multi(handle(), mode | YOKAN_MODE_EXTRA, count,
                 keys, ksizes, vsizes,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -321,9 +398,15 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_length_packed(handle(), mode | YOKAN_MODE_EXTRA, count,
                 keys, ksizes, vsizes,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -344,9 +427,15 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_length_bulk(handle(), mode | YOKAN_MODE_EXTRA, count,
                 origin, data, offset, size,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -366,8 +455,14 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_get(handle(), mode | YOKAN_MODE_EXTRA, key, ksize, value, vsize,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -389,9 +484,15 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_get_multi(handle(), mode | YOKAN_MODE_EXTRA, count,
                 keys, ksizes, values, vsizes,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -414,9 +515,15 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_get_packed(handle(), mode | YOKAN_MODE_EXTRA, count,
                 keys, ksizes, vbufsize, values, vsizes,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -439,12 +546,85 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_get_bulk(handle(), mode | YOKAN_MODE_EXTRA, count, origin,
                 data, offset, size, packed,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
+                YOKAN_EXTRA_END);
+        }
+        YOKAN_CONVERT_AND_THROW(err);
+    }
+
+    template <typename... Extras>
+    AllocatedBuffer getAlloc(const void* key,
+                             size_t ksize,
+                             int32_t mode = YOKAN_MODE_DEFAULT,
+                             Extras&&... extras) const {
+        detail::check_known_extras<Extras...>();
+        void* value = nullptr;
+        size_t vsize = 0;
+        yk_return_t err;
+        if constexpr (sizeof...(Extras) == 0) {
+            err = yk_get_alloc(handle(), mode, key, ksize, &value, &vsize);
+        } else {
+            const auto t = detail::extract_extra<Timeout>(
+                               std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
+            err = yk_get_alloc(handle(), mode | YOKAN_MODE_EXTRA,
+                key, ksize, &value, &vsize,
+                YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
+        AllocatedBuffer result;
+        result.data.reset(static_cast<char*>(value));
+        result.size = vsize;
+        return result;
+    }
+
+    template <typename... Extras>
+    AllocatedBuffer getAllocPacked(size_t count,
+                                   const void* keys,
+                                   const size_t* ksizes,
+                                   size_t* vsizes,
+                                   int32_t mode = YOKAN_MODE_DEFAULT,
+                                   Extras&&... extras) const {
+        detail::check_known_extras<Extras...>();
+        void* values = nullptr;
+        yk_return_t err;
+        if constexpr (sizeof...(Extras) == 0) {
+            err = yk_get_alloc_packed(handle(), mode, count, keys, ksizes,
+                &values, vsizes);
+        } else {
+            const auto t = detail::extract_extra<Timeout>(
+                               std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
+            err = yk_get_alloc_packed(handle(), mode | YOKAN_MODE_EXTRA,
+                count, keys, ksizes, &values, vsizes,
+                YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
+                YOKAN_EXTRA_END);
+        }
+        YOKAN_CONVERT_AND_THROW(err);
+        AllocatedBuffer result;
+        result.data.reset(static_cast<char*>(values));
+        for(size_t i = 0; i < count; ++i)
+            if(vsizes[i] != YOKAN_KEY_NOT_FOUND) result.size += vsizes[i];
+        return result;
     }
 
     template <typename... Extras>
@@ -461,8 +641,14 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_fetch(handle(), mode | YOKAN_MODE_EXTRA, key, ksize, cb, uargs,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -506,9 +692,15 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_fetch_packed(
                 handle(), mode | YOKAN_MODE_EXTRA, count, keys, ksizes, cb, uargs, options,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -543,9 +735,15 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_fetch_multi(
                 handle(), mode | YOKAN_MODE_EXTRA, count, keys, ksizes, cb, uargs, options,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -582,10 +780,16 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_fetch_bulk(
                 handle(), mode | YOKAN_MODE_EXTRA, count, origin, data, offset, size,
                 cb, uargs, options,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -618,8 +822,14 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_erase(handle(), mode | YOKAN_MODE_EXTRA, key, ksize,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -638,9 +848,15 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_erase_multi(handle(), mode | YOKAN_MODE_EXTRA, count,
                 keys, ksizes,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -659,9 +875,15 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_erase_packed(handle(), mode | YOKAN_MODE_EXTRA, count,
                 keys, ksizes,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -683,9 +905,15 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_erase_bulk(handle(), mode | YOKAN_MODE_EXTRA, count,
                 origin, data, offset, size,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -703,14 +931,146 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_erase_range(handle(), mode | YOKAN_MODE_EXTRA,
                 prefix, prefix_size,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
     }
 
+    template <typename... Extras>
+    size_t getRange(const void* key,
+                    size_t ksize,
+                    size_t offset,
+                    void* buffer,
+                    size_t size,
+                    int32_t mode = YOKAN_MODE_DEFAULT,
+                    Extras&&... extras) const {
+        detail::check_known_extras<Extras...>();
+        yk_return_t err;
+        if constexpr (sizeof...(Extras) == 0) {
+            err = yk_get_range(handle(), mode, key, ksize, offset, buffer, &size);
+        } else {
+            const auto t = detail::extract_extra<Timeout>(
+                               std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
+            err = yk_get_range(handle(), mode | YOKAN_MODE_EXTRA,
+                key, ksize, offset, buffer, &size,
+                YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
+                YOKAN_EXTRA_END);
+        }
+        YOKAN_CONVERT_AND_THROW(err);
+        return size;
+    }
+
+    template <typename... Extras>
+    void putRange(const void* key,
+                  size_t ksize,
+                  size_t offset,
+                  const void* data,
+                  size_t size,
+                  int32_t mode = YOKAN_MODE_DEFAULT,
+                  Extras&&... extras) const {
+        detail::check_known_extras<Extras...>();
+        yk_return_t err;
+        if constexpr (sizeof...(Extras) == 0) {
+            err = yk_put_range(handle(), mode, key, ksize, offset, data, size);
+        } else {
+            const auto t = detail::extract_extra<Timeout>(
+                               std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
+            err = yk_put_range(handle(), mode | YOKAN_MODE_EXTRA,
+                key, ksize, offset, data, size,
+                YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
+                YOKAN_EXTRA_END);
+        }
+        YOKAN_CONVERT_AND_THROW(err);
+    }
+
+    template <typename... Extras>
+    bool compareAndSwap(const void* key,
+                        size_t ksize,
+                        const void* expected,
+                        size_t esize,
+                        const void* value,
+                        size_t vsize,
+                        int32_t mode = YOKAN_MODE_DEFAULT,
+                        Extras&&... extras) const {
+        detail::check_known_extras<Extras...>();
+        bool swapped = false;
+        yk_return_t err;
+        if constexpr (sizeof...(Extras) == 0) {
+            err = yk_compare_and_swap(handle(), mode, key, ksize,
+                expected, esize, value, vsize, &swapped);
+        } else {
+            const auto t = detail::extract_extra<Timeout>(
+                               std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
+            err = yk_compare_and_swap(handle(), mode | YOKAN_MODE_EXTRA,
+                key, ksize, expected, esize, value, vsize, &swapped,
+                YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
+                YOKAN_EXTRA_END);
+        }
+        YOKAN_CONVERT_AND_THROW(err);
+        return swapped;
+    }
+
+    template <typename... Extras>
+    size_t merge(const void* key,
+                 size_t ksize,
+                 int32_t op,
+                 const void* operand,
+                 size_t osize,
+                 size_t bound = 0,
+                 void* result = nullptr,
+                 size_t rsize = 0,
+                 int32_t mode = YOKAN_MODE_DEFAULT,
+                 Extras&&... extras) const {
+        detail::check_known_extras<Extras...>();
+        yk_return_t err;
+        if constexpr (sizeof...(Extras) == 0) {
+            err = yk_merge(handle(), mode, key, ksize, op, operand, osize,
+                           bound, result, &rsize);
+        } else {
+            const auto t = detail::extract_extra<Timeout>(
+                               std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
+            err = yk_merge(handle(), mode | YOKAN_MODE_EXTRA,
+                key, ksize, op, operand, osize, bound, result, &rsize,
+                YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
+                YOKAN_EXTRA_END);
+        }
+        YOKAN_CONVERT_AND_THROW(err);
+        return rsize;
+    }
+
     template <typename... Extras>
     void listKeys(const void* from_key,
                   size_t from_ksize,
@@ -729,9 +1089,15 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_list_keys(handle(), mode | YOKAN_MODE_EXTRA, from_key,
                 from_ksize, filter, filter_size, count, keys, ksizes,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -758,10 +1124,16 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_list_keys_packed(handle(), mode | YOKAN_MODE_EXTRA, from_key,
                 from_ksize, filter, filter_size, count, keys,
                 keys_buf_size, ksizes,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -788,10 +1160,16 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_list_keys_bulk(handle(), mode | YOKAN_MODE_EXTRA, from_ksize,
                 filter_size, origin, data, offset, keys_buf_size,
                 packed, count,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -817,9 +1195,15 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_list_keyvals(handle(), mode | YOKAN_MODE_EXTRA, from_key,
                 from_ksize, filter, filter_size, count, keys, ksizes, values, vsizes,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -849,10 +1233,16 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_list_keyvals_packed(handle(), mode | YOKAN_MODE_EXTRA, from_key,
                 from_ksize, filter, filter_size, count, keys,
                 keys_buf_size, ksizes, vals, vals_buf_size, vsizes,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -880,10 +1270,16 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_list_keyvals_bulk(handle(), mode | YOKAN_MODE_EXTRA, from_ksize,
                 filter_size, origin, data, offset, keys_buf_size,
                 vals_buf_size, packed, count,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -908,9 +1304,15 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_iter(handle(), mode | YOKAN_MODE_EXTRA, from_key, from_ksize,
                           filter, filter_size, count, cb, uargs, options,
                           YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                          YOKAN_EXTRA_TRACE_ID, tr.id,
+                          YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                           YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -953,8 +1355,14 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_collection_create(handle(), name, mode | YOKAN_MODE_EXTRA,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -971,8 +1379,14 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_collection_drop(handle(), name, mode | YOKAN_MODE_EXTRA,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
@@ -990,14 +1404,74 @@ class Database {
         } else {
             const auto t = detail::extract_extra<Timeout>(
                                std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
             err = yk_collection_exists(handle(), name, mode | YOKAN_MODE_EXTRA, &flag,
                 YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
                 YOKAN_EXTRA_END);
         }
         YOKAN_CONVERT_AND_THROW(err);
         return static_cast<bool>(flag);
     }
 
+    void enableWriteCombining(const yk_write_combining_options_t* options = nullptr) const {
+        auto err = yk_database_handle_enable_write_combining(handle(), options);
+        YOKAN_CONVERT_AND_THROW(err);
+    }
+
+    void enableWriteCombining(const yk_write_combining_options_t& options) const {
+        enableWriteCombining(&options);
+    }
+
+    void disableWriteCombining() const {
+        auto err = yk_database_handle_disable_write_combining(handle());
+        YOKAN_CONVERT_AND_THROW(err);
+    }
+
+    void flush() const {
+        auto err = yk_database_handle_flush(handle());
+        YOKAN_CONVERT_AND_THROW(err);
+    }
+
+    void enableReadCache(const yk_read_cache_options_t* options = nullptr) const {
+        auto err = yk_database_handle_enable_read_cache(handle(), options);
+        YOKAN_CONVERT_AND_THROW(err);
+    }
+
+    void enableReadCache(const yk_read_cache_options_t& options) const {
+        enableReadCache(&options);
+    }
+
+    void disableReadCache() const {
+        auto err = yk_database_handle_disable_read_cache(handle());
+        YOKAN_CONVERT_AND_THROW(err);
+    }
+
+    void invalidateCache(const void* key = nullptr, size_t ksize = 0) const {
+        auto err = yk_database_handle_invalidate_cache(handle(), key, ksize);
+        YOKAN_CONVERT_AND_THROW(err);
+    }
+
+    std::pair<size_t, size_t> readCacheStats() const {
+        size_t hits = 0, misses = 0;
+        auto err = yk_database_handle_read_cache_stats(handle(), &hits, &misses);
+        YOKAN_CONVERT_AND_THROW(err);
+        return {hits, misses};
+    }
+
+    std::string getStats(bool reset = false) const {
+        char* stats = nullptr;
+        auto err = yk_get_stats(handle(), reset, &stats);
+        YOKAN_CONVERT_AND_THROW(err);
+        auto result = std::string{stats ? stats : "{}"};
+        free(stats);
+        return result;
+    }
+
     yk_database_handle_t handle() const {
         return m_db.get();
     }
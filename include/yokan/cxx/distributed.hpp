@@ -0,0 +1,380 @@
+/*
+ * (C) 2026 The University of Chicago
+ *
+ * See COPYRIGHT in top-level directory.
+ */
+#ifndef __YOKAN_DISTRIBUTED_HPP
+#define __YOKAN_DISTRIBUTED_HPP
+
+#include <yokan/distributed.h>
+#include <yokan/cxx/exception.hpp>
+#include <yokan/cxx/extras.hpp>
+#include <yokan/cxx/database.hpp>
+#include <vector>
+#include <string>
+#include <functional>
+#include <memory>
+
+namespace yokan {
+
+/**
+ * @brief C++ wrapper for yk_distributed_database_t (see yokan/distributed.h).
+ * Its methods have the same signature as their Database counterpart.
+ */
+class DistributedDatabase {
+
+    public:
+
+    DistributedDatabase() = default;
+
+    DistributedDatabase(const std::vector<Database>& databases,
+                        const yk_distributed_options_t* options = nullptr)
+    : m_databases(databases) {
+        std::vector<yk_database_handle_t> dbhs;
+        dbhs.reserve(databases.size());
+        for(auto& db : databases) dbhs.push_back(db.handle());
+        yk_distributed_database_t ddb;
+        auto err = yk_distributed_database_create(
+            dbhs.size(), dbhs.data(), options, &ddb);
+        YOKAN_CONVERT_AND_THROW(err);
+        m_ddb = std::shared_ptr<yk_distributed_database>{
+            ddb, yk_distributed_database_release};
+    }
+
+    DistributedDatabase(const std::vector<Database>& databases,
+                        const yk_distributed_options_t& options)
+    : DistributedDatabase(databases, &options) {}
+
+    DistributedDatabase(const DistributedDatabase&) = default;
+
+    DistributedDatabase(DistributedDatabase&&) = default;
+
+    DistributedDatabase& operator=(const DistributedDatabase&) = default;
+
+    DistributedDatabase& operator=(DistributedDatabase&&) = default;
+
+    ~DistributedDatabase() = default;
+
+    const std::vector<Database>& databases() const {
+        return m_databases;
+    }
+
+    size_t locate(const void* key, size_t ksize) const {
+        size_t index;
+        auto err = yk_distributed_locate(handle(), key, ksize, &index);
+        YOKAN_CONVERT_AND_THROW(err);
+        return index;
+    }
+
+    template <typename... Extras>
+    size_t count(int32_t mode = YOKAN_MODE_DEFAULT, Extras&&... extras) const {
+        detail::check_known_extras<Extras...>();
+        const auto t = detail::extract_extra<Timeout>(std::forward<Extras>(extras)...);
+        const auto tr = detail::extract_extra<TraceId>(std::forward<Extras>(extras)...);
+        const auto dt = detail::extract_extra<DirectThreshold>(std::forward<Extras>(extras)...);
+        size_t c;
+        auto err = yk_distributed_count(handle(), mode | YOKAN_MODE_EXTRA, &c,
+            YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+            YOKAN_EXTRA_TRACE_ID, tr.id,
+            YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
+            YOKAN_EXTRA_END);
+        YOKAN_CONVERT_AND_THROW(err);
+        return c;
+    }
+
+    template <typename... Extras>
+    void put(const void* key,
+             size_t ksize,
+             const void* value,
+             size_t vsize,
+             int32_t mode = YOKAN_MODE_DEFAULT,
+             Extras&&... extras) const {
+        detail::check_known_extras<Extras...>();
+        const auto t = detail::extract_extra<Timeout>(std::forward<Extras>(extras)...);
+        const auto tr = detail::extract_extra<TraceId>(std::forward<Extras>(extras)...);
+        const auto dt = detail::extract_extra<DirectThreshold>(std::forward<Extras>(extras)...);
+        auto err = yk_distributed_put(handle(), mode | YOKAN_MODE_EXTRA,
+            key, ksize, value, vsize,
+            YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+            YOKAN_EXTRA_TRACE_ID, tr.id,
+            YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
+            YOKAN_EXTRA_END);
+        YOKAN_CONVERT_AND_THROW(err);
+    }
+
+    template <typename... Extras>
+    void putMulti(size_t count,
+                  const void* const* keys,
+                  const size_t* ksizes,
+                  const void* const* values,
+                  const size_t* vsizes,
+                  int32_t mode = YOKAN_MODE_DEFAULT,
+                  Extras&&... extras) const {
+        detail::check_known_extras<Extras...>();
+        const auto t = detail::extract_extra<Timeout>(std::forward<Extras>(extras)...);
+        const auto tr = detail::extract_extra<TraceId>(std::forward<Extras>(extras)...);
+        const auto dt = detail::extract_extra<DirectThreshold>(std::forward<Extras>(extras)...);
+        auto err = yk_distributed_put_multi(handle(), mode | YOKAN_MODE_EXTRA,
+            count, keys, ksizes, values, vsizes,
+            YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+            YOKAN_EXTRA_TRACE_ID, tr.id,
+            YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
+            YOKAN_EXTRA_END);
+        YOKAN_CONVERT_AND_THROW(err);
+    }
+
+    template <typename... Extras>
+    void putPacked(size_t count,
+                   const void* keys,
+                   const size_t* ksizes,
+                   const void* values,
+                   const size_t* vsizes,
+                   int32_t mode = YOKAN_MODE_DEFAULT,
+                   Extras&&... extras) const {
+        detail::check_known_extras<Extras...>();
+        const auto t = detail::extract_extra<Timeout>(std::forward<Extras>(extras)...);
+        const auto tr = detail::extract_extra<TraceId>(std::forward<Extras>(extras)...);
+        const auto dt = detail::extract_extra<DirectThreshold>(std::forward<Extras>(extras)...);
+        auto err = yk_distributed_put_packed(handle(), mode | YOKAN_MODE_EXTRA,
+            count, keys, ksizes, values, vsizes,
+            YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+            YOKAN_EXTRA_TRACE_ID, tr.id,
+            YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
+            YOKAN_EXTRA_END);
+        YOKAN_CONVERT_AND_THROW(err);
+    }
+
+    template <typename... Extras>
+    bool exists(const void* key,
+                size_t ksize,
+                int32_t mode = YOKAN_MODE_DEFAULT,
+                Extras&&... extras) const {
+        detail::check_known_extras<Extras...>();
+        const auto t = detail::extract_extra<Timeout>(std::forward<Extras>(extras)...);
+        const auto tr = detail::extract_extra<TraceId>(std::forward<Extras>(extras)...);
+        const auto dt = detail::extract_extra<DirectThreshold>(std::forward<Extras>(extras)...);
+        uint8_t flag;
+        auto err = yk_distributed_exists(handle(), mode | YOKAN_MODE_EXTRA,
+            key, ksize, &flag,
+            YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+            YOKAN_EXTRA_TRACE_ID, tr.id,
+            YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
+            YOKAN_EXTRA_END);
+        YOKAN_CONVERT_AND_THROW(err);
+        return static_cast<bool>(flag);
+    }
+
+    template <typename... Extras>
+    size_t length(const void* key,
+                  size_t ksize,
+                  int32_t mode = YOKAN_MODE_DEFAULT,
+                  Extras&&... extras) const {
+        detail::check_known_extras<Extras...>();
+        const auto t = detail::extract_extra<Timeout>(std::forward<Extras>(extras)...);
+        const auto tr = detail::extract_extra<TraceId>(std::forward<Extras>(extras)...);
+        const auto dt = detail::extract_extra<DirectThreshold>(std::forward<Extras>(extras)...);
+        size_t vsize;
+        auto err = yk_distributed_length(handle(), mode | YOKAN_MODE_EXTRA,
+            key, ksize, &vsize,
+            YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+            YOKAN_EXTRA_TRACE_ID, tr.id,
+            YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
+            YOKAN_EXTRA_END);
+        YOKAN_CONVERT_AND_THROW(err);
+        return vsize;
+    }
+
+    template <typename... Extras>
+    void get(const void* key,
+             size_t ksize,
+             void* value,
+             size_t* vsize,
+             int32_t mode = YOKAN_MODE_DEFAULT,
+             Extras&&... extras) const {
+        detail::check_known_extras<Extras...>();
+        const auto t = detail::extract_extra<Timeout>(std::forward<Extras>(extras)...);
+        const auto tr = detail::extract_extra<TraceId>(std::forward<Extras>(extras)...);
+        const auto dt = detail::extract_extra<DirectThreshold>(std::forward<Extras>(extras)...);
+        auto err = yk_distributed_get(handle(), mode | YOKAN_MODE_EXTRA,
+            key, ksize, value, vsize,
+            YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+            YOKAN_EXTRA_TRACE_ID, tr.id,
+            YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
+            YOKAN_EXTRA_END);
+        YOKAN_CONVERT_AND_THROW(err);
+    }
+
+    template <typename... Extras>
+    void getMulti(size_t count,
+                  const void* const* keys,
+                  const size_t* ksizes,
+                  void* const* values,
+                  size_t* vsizes,
+                  int32_t mode = YOKAN_MODE_DEFAULT,
+                  Extras&&... extras) const {
+        detail::check_known_extras<Extras...>();
+        const auto t = detail::extract_extra<Timeout>(std::forward<Extras>(extras)...);
+        const auto tr = detail::extract_extra<TraceId>(std::forward<Extras>(extras)...);
+        const auto dt = detail::extract_extra<DirectThreshold>(std::forward<Extras>(extras)...);
+        auto err = yk_distributed_get_multi(handle(), mode | YOKAN_MODE_EXTRA,
+            count, keys, ksizes, values, vsizes,
+            YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+            YOKAN_EXTRA_TRACE_ID, tr.id,
+            YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
+            YOKAN_EXTRA_END);
+        YOKAN_CONVERT_AND_THROW(err);
+    }
+
+    template <typename... Extras>
+    void getPacked(size_t count,
+                   const void* keys,
+                   const size_t* ksizes,
+                   size_t vbufsize,
+                   void* values,
+                   size_t* vsizes,
+                   int32_t mode = YOKAN_MODE_DEFAULT,
+                   Extras&&... extras) const {
+        detail::check_known_extras<Extras...>();
+        const auto t = detail::extract_extra<Timeout>(std::forward<Extras>(extras)...);
+        const auto tr = detail::extract_extra<TraceId>(std::forward<Extras>(extras)...);
+        const auto dt = detail::extract_extra<DirectThreshold>(std::forward<Extras>(extras)...);
+        auto err = yk_distributed_get_packed(handle(), mode | YOKAN_MODE_EXTRA,
+            count, keys, ksizes, vbufsize, values, vsizes,
+            YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+            YOKAN_EXTRA_TRACE_ID, tr.id,
+            YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
+            YOKAN_EXTRA_END);
+        YOKAN_CONVERT_AND_THROW(err);
+    }
+
+    template <typename... Extras>
+    void erase(const void* key,
+               size_t ksize,
+               int32_t mode = YOKAN_MODE_DEFAULT,
+               Extras&&... extras) const {
+        detail::check_known_extras<Extras...>();
+        const auto t = detail::extract_extra<Timeout>(std::forward<Extras>(extras)...);
+        const auto tr = detail::extract_extra<TraceId>(std::forward<Extras>(extras)...);
+        const auto dt = detail::extract_extra<DirectThreshold>(std::forward<Extras>(extras)...);
+        auto err = yk_distributed_erase(handle(), mode | YOKAN_MODE_EXTRA,
+            key, ksize,
+            YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+            YOKAN_EXTRA_TRACE_ID, tr.id,
+            YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
+            YOKAN_EXTRA_END);
+        YOKAN_CONVERT_AND_THROW(err);
+    }
+
+    template <typename... Extras>
+    void eraseMulti(size_t count,
+                    const void* const* keys,
+                    const size_t* ksizes,
+                    int32_t mode = YOKAN_MODE_DEFAULT,
+                    Extras&&... extras) const {
+        detail::check_known_extras<Extras...>();
+        const auto t = detail::extract_extra<Timeout>(std::forward<Extras>(extras)...);
+        const auto tr = detail::extract_extra<TraceId>(std::forward<Extras>(extras)...);
+        const auto dt = detail::extract_extra<DirectThreshold>(std::forward<Extras>(extras)...);
+        auto err = yk_distributed_erase_multi(handle(), mode | YOKAN_MODE_EXTRA,
+            count, keys, ksizes,
+            YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+            YOKAN_EXTRA_TRACE_ID, tr.id,
+            YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
+            YOKAN_EXTRA_END);
+        YOKAN_CONVERT_AND_THROW(err);
+    }
+
+    template <typename... Extras>
+    void erasePacked(size_t count,
+                     const void* keys,
+                     const size_t* ksizes,
+                     int32_t mode = YOKAN_MODE_DEFAULT,
+                     Extras&&... extras) const {
+        detail::check_known_extras<Extras...>();
+        const auto t = detail::extract_extra<Timeout>(std::forward<Extras>(extras)...);
+        const auto tr = detail::extract_extra<TraceId>(std::forward<Extras>(extras)...);
+        const auto dt = detail::extract_extra<DirectThreshold>(std::forward<Extras>(extras)...);
+        auto err = yk_distributed_erase_packed(handle(), mode | YOKAN_MODE_EXTRA,
+            count, keys, ksizes,
+            YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+            YOKAN_EXTRA_TRACE_ID, tr.id,
+            YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
+            YOKAN_EXTRA_END);
+        YOKAN_CONVERT_AND_THROW(err);
+    }
+
+    template <typename... Extras>
+    void listKeys(const void* from_key,
+                  size_t from_ksize,
+                  const void* filter,
+                  size_t filter_size,
+                  size_t count,
+                  void* const* keys,
+                  size_t* ksizes,
+                  int32_t mode = YOKAN_MODE_DEFAULT,
+                  Extras&&... extras) const {
+        detail::check_known_extras<Extras...>();
+        const auto t = detail::extract_extra<Timeout>(std::forward<Extras>(extras)...);
+        const auto tr = detail::extract_extra<TraceId>(std::forward<Extras>(extras)...);
+        const auto dt = detail::extract_extra<DirectThreshold>(std::forward<Extras>(extras)...);
+        auto err = yk_distributed_list_keys(handle(), mode | YOKAN_MODE_EXTRA,
+            from_key, from_ksize, filter, filter_size, count, keys, ksizes,
+            YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+            YOKAN_EXTRA_TRACE_ID, tr.id,
+            YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
+            YOKAN_EXTRA_END);
+        YOKAN_CONVERT_AND_THROW(err);
+    }
+
+    template <typename... Extras>
+    void iter(const void* from_key,
+              size_t from_ksize,
+              const void* filter,
+              size_t filter_size,
+              size_t count,
+              yk_keyvalue_callback_t cb,
+              void* uargs,
+              const yk_iter_options_t* options = nullptr,
+              int32_t mode = YOKAN_MODE_DEFAULT,
+              Extras&&... extras) const {
+        detail::check_known_extras<Extras...>();
+        const auto t = detail::extract_extra<Timeout>(std::forward<Extras>(extras)...);
+        const auto tr = detail::extract_extra<TraceId>(std::forward<Extras>(extras)...);
+        const auto dt = detail::extract_extra<DirectThreshold>(std::forward<Extras>(extras)...);
+        auto err = yk_distributed_iter(handle(), mode | YOKAN_MODE_EXTRA,
+            from_key, from_ksize, filter, filter_size, count, cb, uargs, options,
+            YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+            YOKAN_EXTRA_TRACE_ID, tr.id,
+            YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
+            YOKAN_EXTRA_END);
+        YOKAN_CONVERT_AND_THROW(err);
+    }
+
+    template <typename... Extras>
+    void iter(const void* from_key,
+              size_t from_ksize,
+              const void* filter,
+              size_t filter_size,
+              size_t count,
+              const Database::iter_callback_type& cb,
+              const yk_iter_options_t* options = nullptr,
+              int32_t mode = YOKAN_MODE_DEFAULT,
+              Extras&&... extras) const {
+        iter(from_key, from_ksize, filter, filter_size, count,
+             Database::_iter_dispatch, (void*)&cb, options, mode,
+             std::forward<Extras>(extras)...);
+    }
+
+    yk_distributed_database_t handle() const {
+        return m_ddb.get();
+    }
+
+    private:
+
+    std::vector<Database>                    m_databases;
+    std::shared_ptr<yk_distributed_database> m_ddb;
+};
+
+}
+
+#endif
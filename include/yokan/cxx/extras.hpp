@@ -7,6 +7,8 @@
 #define __YOKAN_CXX_EXTRAS_HPP
 
 #include <yokan/common.h>
+#include <cstdint>
+#include <cstddef>
 #include <type_traits>
 #include <utility>
 
@@ -28,6 +30,40 @@ struct Timeout {
     constexpr explicit Timeout(double m) : ms(m) {}
 };
 
+/**
+ * @brief Trace identifier attached to the request.
+ *
+ * When the provider has tracing enabled, the spans recorded for this
+ * request carry this identifier, which allows client-side and server-side
+ * timelines to be stitched together. 0 (the default) lets the provider
+ * assign an identifier.
+ *
+ * Only the Database methods accept it, and only the put, get, fetch,
+ * erase, exists, and length operations are traced.
+ *
+ * Example:
+ *   db.get(k, ks, v, &vs, YOKAN_MODE_DEFAULT, yokan::TraceId{42});
+ */
+struct TraceId {
+    uint64_t id = 0;
+    constexpr TraceId() = default;
+    constexpr explicit TraceId(uint64_t i) : id(i) {}
+};
+
+/**
+ * @brief Per-call override of the client's direct threshold, in bytes:
+ * operations whose data fits in it use the version of the RPC that does
+ * not use RDMA. SIZE_MAX (the default) keeps the client's threshold.
+ *
+ * Example:
+ *   db.putPacked(n, k, ks, v, vs, YOKAN_MODE_DEFAULT, yokan::DirectThreshold{0});
+ */
+struct DirectThreshold {
+    size_t bytes = SIZE_MAX;
+    constexpr DirectThreshold() = default;
+    constexpr explicit DirectThreshold(size_t b) : bytes(b) {}
+};
+
 namespace detail {
 
 /**
@@ -52,9 +88,23 @@ constexpr T extract_extra(First&& first, Rest&&... rest) {
 template <typename... Extras>
 constexpr void check_known_extras() {
     static_assert(
-        (std::is_same_v<std::decay_t<Extras>, Timeout> && ...),
+        ((std::is_same_v<std::decay_t<Extras>, Timeout>
+          || std::is_same_v<std::decay_t<Extras>, TraceId>
+          || std::is_same_v<std::decay_t<Extras>, DirectThreshold>) && ...),
         "Unsupported extra passed to a Yokan wrapper method. "
-        "Allowed extras: yokan::Timeout.");
+        "Allowed extras: yokan::Timeout, yokan::TraceId, yokan::DirectThreshold.");
+}
+
+/**
+ * @brief Same as check_known_extras, for Collection methods: the
+ * document RPCs do not carry a trace identifier, so TraceId is rejected.
+ */
+template <typename... Extras>
+constexpr void check_collection_extras() {
+    check_known_extras<Extras...>();
+    static_assert(
+        (!std::is_same_v<std::decay_t<Extras>, TraceId> && ...),
+        "yokan::TraceId is not supported by Collection methods.");
 }
 
 } // namespace detail
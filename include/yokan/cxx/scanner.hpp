@@ -0,0 +1,111 @@
+/*
+ * (C) 2026 The University of Chicago
+ *
+ * See COPYRIGHT in top-level directory.
+ */
+#ifndef __YOKAN_SCANNER_HPP
+#define __YOKAN_SCANNER_HPP
+
+#include <yokan/database.h>
+#include <yokan/cxx/exception.hpp>
+#include <yokan/cxx/extras.hpp>
+#include <yokan/cxx/database.hpp>
+#include <memory>
+
+namespace yokan {
+
+/**
+ * @brief C++ wrapper for yk_scanner_t: lists the key/value pairs of a
+ * Database while the next pages are prefetched in the background.
+ *
+ * Example:
+ *   yokan::Scanner scanner{db, nullptr, 0, "prefix", 6};
+ *   const void* key; size_t ksize; const void* val; size_t vsize;
+ *   while(scanner.next(key, ksize, val, vsize)) { ... }
+ */
+class Scanner {
+
+    public:
+
+    Scanner() = default;
+
+    template <typename... Extras>
+    Scanner(const Database& db,
+            const void* from_key,
+            size_t from_ksize,
+            const void* filter,
+            size_t filter_size,
+            const yk_scan_options_t* options = nullptr,
+            int32_t mode = YOKAN_MODE_DEFAULT,
+            Extras&&... extras)
+    : m_db(db) {
+        detail::check_known_extras<Extras...>();
+        yk_scanner_t scanner;
+        yk_return_t err;
+        if constexpr (sizeof...(Extras) == 0) {
+            err = yk_scanner_create(db.handle(), mode, from_key, from_ksize,
+                filter, filter_size, options, &scanner);
+        } else {
+            const auto t = detail::extract_extra<Timeout>(
+                               std::forward<Extras>(extras)...);
+            const auto tr = detail::extract_extra<TraceId>(
+                               std::forward<Extras>(extras)...);
+            const auto dt = detail::extract_extra<DirectThreshold>(
+                               std::forward<Extras>(extras)...);
+            err = yk_scanner_create(db.handle(), mode | YOKAN_MODE_EXTRA,
+                from_key, from_ksize, filter, filter_size, options, &scanner,
+                YOKAN_EXTRA_TIMEOUT_MS, t.ms,
+                YOKAN_EXTRA_TRACE_ID, tr.id,
+                YOKAN_EXTRA_DIRECT_THRESHOLD, dt.bytes,
+                YOKAN_EXTRA_END);
+        }
+        YOKAN_CONVERT_AND_THROW(err);
+        m_scanner = std::unique_ptr<yk_scanner, decltype(&yk_scanner_destroy)>{
+            scanner, yk_scanner_destroy};
+    }
+
+    Scanner(Scanner&&) = default;
+
+    Scanner& operator=(Scanner&&) = default;
+
+    Scanner(const Scanner&) = delete;
+
+    Scanner& operator=(const Scanner&) = delete;
+
+    ~Scanner() = default;
+
+    /**
+     * @brief Gets the next key/value pair. Returns false at the end of
+     * the scan. The pointers remain valid until the next call.
+     */
+    bool next(const void*& key, size_t& ksize,
+              const void*& value, size_t& vsize) {
+        auto err = yk_scanner_next(handle(), &key, &ksize, &value, &vsize);
+        YOKAN_CONVERT_AND_THROW(err);
+        return ksize != YOKAN_NO_MORE_KEYS;
+    }
+
+    bool next(const void*& key, size_t& ksize) {
+        auto err = yk_scanner_next(handle(), &key, &ksize, nullptr, nullptr);
+        YOKAN_CONVERT_AND_THROW(err);
+        return ksize != YOKAN_NO_MORE_KEYS;
+    }
+
+    yk_scanner_t handle() const {
+        return m_scanner.get();
+    }
+
+    const Database& database() const {
+        return m_db;
+    }
+
+    private:
+
+    Database m_db;
+    std::unique_ptr<yk_scanner, decltype(&yk_scanner_destroy)> m_scanner{
+        nullptr, yk_scanner_destroy};
+};
+
+}
+
+#endif
@@ -68,6 +68,20 @@ class Provider {
         return result;
     }
 
+    std::string getStats(bool reset = false) const {
+        char* stats = yk_provider_get_stats(m_provider, reset);
+        auto result = std::string{stats ? stats : "{}"};
+        free(stats);
+        return result;
+    }
+
+    std::string getTrace(bool clear = false) const {
+        char* trace = yk_provider_get_trace(m_provider, clear);
+        auto result = std::string{trace ? trace : "{}"};
+        free(trace);
+        return result;
+    }
+
     /* Underlying C handle. Lifetime is tied to this Provider. */
     yk_provider_t handle() const { return m_provider; }
 
@@ -89,6 +89,142 @@ yk_return_t yk_database_handle_ref_incr(
  */
 yk_return_t yk_database_handle_release(yk_database_handle_t handle);
 
+typedef struct yk_write_combining_options {
+    size_t max_count;    /* flush when that many writes are pending (0 = no limit) */
+    size_t max_size;     /* flush when pending keys and values reach that many bytes (0 = no limit) */
+    double max_delay_ms; /* flush that long after a write was queued (0 = no timer) */
+} yk_write_combining_options_t;
+
+/**
+ * @brief Enables write combining on the database handle. The calls to
+ * yk_put and yk_erase made with YOKAN_MODE_DEFAULT (optionally with
+ * YOKAN_MODE_NO_RDMA) and without timeout are queued instead of being
+ * sent, and the queued writes are sent as a single yk_put_packed and a
+ * single yk_erase_packed when one of the thresholds of the options is
+ * reached, when yk_database_handle_flush is called, or before any other
+ * key/value operation is sent through the handle. Writes to the same key
+ * are applied in the order they were issued.
+ *
+ * An error that occurs when flushing is returned by the call that
+ * triggered the flush. An error that occurs when flushing because of the
+ * max_delay_ms threshold is returned by the next yk_put, yk_erase, or
+ * yk_database_handle_flush on the handle.
+ *
+ * If options is NULL, the writes are flushed when 1024 of them are
+ * pending, when they amount to 1 MiB, or 10 ms after being queued.
+ * Calling this function again updates the options. This function should
+ * not be called concurrently with other operations on the handle.
+ *
+ * @param[in] dbh Database handle
+ * @param[in] options Thresholds, or NULL to use the defaults
+ *
+ * @return YOKAN_SUCCESS or error code defined in common.h
+ */
+yk_return_t yk_database_handle_enable_write_combining(
+        yk_database_handle_t dbh,
+        const yk_write_combining_options_t* options);
+
+/**
+ * @brief Flushes the pending writes and disables write combining on the
+ * database handle. Write combining is also disabled (and the writes
+ * flushed) when the handle is freed.
+ *
+ * @param[in] dbh Database handle
+ *
+ * @return YOKAN_SUCCESS or error code defined in common.h
+ */
+yk_return_t yk_database_handle_disable_write_combining(
+        yk_database_handle_t dbh);
+
+/**
+ * @brief Sends the writes queued by write combining, if any.
+ *
+ * @param[in] dbh Database handle
+ *
+ * @return YOKAN_SUCCESS or error code defined in common.h
+ */
+yk_return_t yk_database_handle_flush(yk_database_handle_t dbh);
+
+/**
+ * @brief Options of the client-side read cache of a database handle.
+ */
+typedef struct yk_read_cache_options {
+    size_t capacity; /* maximum size of the cached keys and values, in bytes */
+    double ttl_ms;   /* lease after which an entry is re-read from the provider (0 = none) */
+} yk_read_cache_options_t;
+
+/**
+ * @brief Enables a client-side read cache on the database handle. The
+ * values successfully read by yk_get with YOKAN_MODE_DEFAULT (optionally
+ * with YOKAN_MODE_NO_RDMA) are kept in a cache bounded by the capacity
+ * of the options, evicting the least recently used entries, and the next
+ * calls to yk_get on the same keys are served from this cache.
+ *
+ * An entry is held under a lease of ttl_ms milliseconds, after which the
+ * value is read again from the provider. The writes sent through the
+ * handle (puts, erases, erase_range, and reads with YOKAN_MODE_CONSUME)
+ * invalidate the corresponding entries (or the whole cache, for the bulk
+ * versions of these functions). Writes from other handles or other
+ * clients are not seen until the lease expires, hence the cache should
+ * only be used for keys that rarely change, or with a short lease
+ * (yk_database_handle_invalidate_cache can be used to drop entries known
+ * to be stale). A ttl_ms of 0 keeps the entries until they are evicted
+ * or invalidated.
+ *
+ * If options is NULL, the cache holds up to 16 MiB with a lease of 1 s.
+ * Calling this function again updates the options. This function should
+ * not be called concurrently with other operations on the handle.
+ *
+ * @param[in] dbh Database handle
+ * @param[in] options Capacity and lease, or NULL to use the defaults
+ *
+ * @return YOKAN_SUCCESS or error code defined in common.h
+ */
+yk_return_t yk_database_handle_enable_read_cache(
+        yk_database_handle_t dbh,
+        const yk_read_cache_options_t* options);
+
+/**
+ * @brief Disables the read cache of the database handle and releases
+ * the cached values. The cache is also released when the handle is freed.
+ *
+ * @param[in] dbh Database handle
+ *
+ * @return YOKAN_SUCCESS or error code defined in common.h
+ */
+yk_return_t yk_database_handle_disable_read_cache(
+        yk_database_handle_t dbh);
+
+/**
+ * @brief Removes a key from the read cache of the database handle, or
+ * all the keys if key is NULL.
+ *
+ * @param[in] dbh Database handle
+ * @param[in] key Key to invalidate, or NULL
+ * @param[in] ksize Size of the key
+ *
+ * @return YOKAN_SUCCESS or error code defined in common.h
+ */
+yk_return_t yk_database_handle_invalidate_cache(
+        yk_database_handle_t dbh,
+        const void* key,
+        size_t ksize);
+
+/**
+ * @brief Get the number of yk_get calls served from (hits) and missed
+ * by (misses) the read cache of the database handle.
+ *
+ * @param[in] dbh Database handle
+ * @param[out] hits Number of hits
+ * @param[out] misses Number of misses
+ *
+ * @return YOKAN_SUCCESS or error code defined in common.h
+ */
+yk_return_t yk_database_handle_read_cache_stats(
+        yk_database_handle_t dbh,
+        size_t* hits,
+        size_t* misses);
+
 /**
  * @brief Get the number of key/val pairs stored in the database.
  *
@@ -102,6 +238,22 @@ yk_return_t yk_count(yk_database_handle_t dbh,
                      int32_t mode,
                      size_t* count, ...);
 
+/**
+ * @brief Get the RPC metrics collected by the provider managing
+ * the database and the statistics reported by its backend, as a
+ * JSON string (see yk_provider_get_stats in yokan/server.h for its
+ * format). The returned string must be free-ed by the caller.
+ *
+ * @param[in] dbh Database handle.
+ * @param[in] reset Whether to reset the RPC metrics after reading them.
+ * @param[out] stats JSON string.
+ *
+ * @return YOKAN_SUCCESS or corresponding error code.
+ */
+yk_return_t yk_get_stats(yk_database_handle_t dbh,
+                         bool reset,
+                         char** stats);
+
 /**
  * @brief Put a single key/value pair into the database.
  *
@@ -203,6 +355,109 @@ yk_return_t yk_put_bulk(yk_database_handle_t dbh,
                         size_t offset,
                         size_t size, ...);
 
+/**
+ * @brief Overwrite part of the value associated with a key, starting at
+ * the given offset, without sending the rest of the value. If the value
+ * ends before offset + size, it is extended, any gap between its former
+ * end and the offset being filled with zeros. A key that does not exist
+ * is created (with a value made of offset zeros followed by the data),
+ * unless YOKAN_MODE_EXIST_ONLY is specified, in which case the function
+ * returns YOKAN_ERR_KEY_NOT_FOUND. With YOKAN_MODE_NEW_ONLY, the function
+ * returns YOKAN_ERR_KEY_EXISTS if the key exists. The function returns
+ * YOKAN_ERR_INVALID_ARGS if offset + size exceeds the provider's
+ * "max_range_end" (1 GiB by default) or overflows.
+ *
+ * @param[in] dbh Database handle.
+ * @param[in] mode 0 or bitwise "or" of YOKAN_MODE_* flags.
+ * @param[in] key Key.
+ * @param[in] ksize Size of the key.
+ * @param[in] offset Offset within the value.
+ * @param[in] data Data to write.
+ * @param[in] size Size of the data.
+ *
+ * @return YOKAN_SUCCESS or corresponding error code.
+ */
+yk_return_t yk_put_range(yk_database_handle_t dbh,
+                         int32_t mode,
+                         const void* key,
+                         size_t ksize,
+                         size_t offset,
+                         const void* data,
+                         size_t size, ...);
+
+/**
+ * @brief Atomically replace the value associated with a key with a new
+ * value, only if the current value is equal (byte for byte) to the
+ * expected one. *swapped is set to true if the value was replaced, and
+ * to false otherwise. If the key does not exist, the function returns
+ * YOKAN_ERR_KEY_NOT_FOUND (use yk_put with YOKAN_MODE_NEW_ONLY to
+ * atomically create a key). Backends that cannot perform this
+ * operation atomically return YOKAN_ERR_OP_UNSUPPORTED.
+ *
+ * The key and values are sent along with the RPC regardless of the
+ * client's direct threshold.
+ *
+ * @param[in] dbh Database handle.
+ * @param[in] mode 0 or bitwise "or" of YOKAN_MODE_* flags.
+ * @param[in] key Key.
+ * @param[in] ksize Size of the key.
+ * @param[in] expected Expected current value.
+ * @param[in] esize Size of the expected value.
+ * @param[in] value New value.
+ * @param[in] vsize Size of the new value.
+ * @param[out] swapped Whether the value was replaced (may be NULL).
+ *
+ * @return YOKAN_SUCCESS or corresponding error code.
+ */
+yk_return_t yk_compare_and_swap(yk_database_handle_t dbh,
+                                int32_t mode,
+                                const void* key,
+                                size_t ksize,
+                                const void* expected,
+                                size_t esize,
+                                const void* value,
+                                size_t vsize,
+                                bool* swapped, ...);
+
+/**
+ * @brief Atomically apply a YOKAN_MERGE_* operator (see yokan/common.h)
+ * to the value associated with a key, on the provider, without reading
+ * the value first. A key that does not exist is created, the operator
+ * being applied to an empty value, unless YOKAN_MODE_EXIST_ONLY is
+ * specified, in which case the function returns YOKAN_ERR_KEY_NOT_FOUND.
+ * The function returns YOKAN_ERR_INVALID_ARGS if the operand (or the
+ * current value) does not fit the operator, and YOKAN_ERR_OP_UNSUPPORTED
+ * if the backend cannot perform the operation atomically.
+ *
+ * If rsize is not NULL and *rsize is not 0, the new value is copied into
+ * the result buffer (truncated to *rsize bytes) and *rsize is set to the
+ * size of the new value. The operand and the result are sent along with
+ * the RPC regardless of the client's direct threshold.
+ *
+ * @param[in] dbh Database handle.
+ * @param[in] mode 0 or bitwise "or" of YOKAN_MODE_* flags.
+ * @param[in] key Key.
+ * @param[in] ksize Size of the key.
+ * @param[in] op Operator (YOKAN_MERGE_*).
+ * @param[in] operand Operand.
+ * @param[in] osize Size of the operand.
+ * @param[in] bound Maximum size of the value for YOKAN_MERGE_APPEND (0 for none).
+ * @param[out] result Buffer in which to receive the new value (may be NULL).
+ * @param[inout] rsize Size of the result buffer / size of the new value (may be NULL).
+ *
+ * @return YOKAN_SUCCESS or corresponding error code.
+ */
+yk_return_t yk_merge(yk_database_handle_t dbh,
+                     int32_t mode,
+                     const void* key,
+                     size_t ksize,
+                     int32_t op,
+                     const void* operand,
+                     size_t osize,
+                     size_t bound,
+                     void* result,
+                     size_t* rsize, ...);
+
 /**
  * @brief Check if the key exists in the database.
  * exists is set to 1 if the key exists, 0 otherwise.
@@ -547,6 +802,84 @@ yk_return_t yk_get_bulk(yk_database_handle_t dbh,
                         size_t size,
                         bool packed, ...);
 
+/**
+ * @brief Get the value associated with a key without knowing its size
+ * in advance. The provider sends back the size of the value along with
+ * the value itself if it is small enough to fit in the response (see
+ * yk_client_set_direct_threshold), or a handle to a buffer from which
+ * the client pulls exactly the value, in a single round trip either way.
+ * The value is returned in a buffer allocated by the function, which
+ * the caller must free using free(). If the key is not found, the
+ * function returns YOKAN_ERR_KEY_NOT_FOUND and sets *value to NULL.
+ *
+ * @param[in] dbh Database handle.
+ * @param[in] mode 0 or bitwise "or" of YOKAN_MODE_* flags.
+ * @param[in] key Key.
+ * @param[in] ksize Size of the key.
+ * @param[out] value Allocated value buffer.
+ * @param[out] vsize Size of the value.
+ *
+ * @return YOKAN_SUCCESS or corresponding error code.
+ */
+yk_return_t yk_get_alloc(yk_database_handle_t dbh,
+                         int32_t mode,
+                         const void* key,
+                         size_t ksize,
+                         void** value,
+                         size_t* vsize, ...);
+
+/**
+ * @brief Same as yk_get_alloc for a set of packed keys. The values
+ * are packed in a single buffer allocated by the function, which the
+ * caller must free using free() (*values is set to NULL if no value
+ * was found). For any key that is not found, the corresponding value
+ * size will be set to YOKAN_KEY_NOT_FOUND.
+ *
+ * @param[in] dbh Database handle.
+ * @param[in] mode 0 or bitwise "or" of YOKAN_MODE_* flags.
+ * @param[in] count Number of key/value pairs.
+ * @param[in] keys Packed keys.
+ * @param[in] ksizes Array of key sizes.
+ * @param[out] values Allocated buffer holding the packed values.
+ * @param[out] vsizes Value sizes.
+ *
+ * @return YOKAN_SUCCESS or corresponding error code.
+ */
+yk_return_t yk_get_alloc_packed(yk_database_handle_t dbh,
+                                int32_t mode,
+                                size_t count,
+                                const void* keys,
+                                const size_t* ksizes,
+                                void** values,
+                                size_t* vsizes, ...);
+
+/**
+ * @brief Read part of the value associated with a key, starting at the
+ * given offset, without transferring the rest of the value. *size is
+ * used both as input (size of the buffer, i.e. maximum number of bytes
+ * to read) and as output (number of bytes read, which is smaller if the
+ * value ends before offset + *size, and 0 if the offset is past the end
+ * of the value). If the key is not found, the function returns
+ * YOKAN_ERR_KEY_NOT_FOUND.
+ *
+ * @param[in] dbh Database handle.
+ * @param[in] mode 0 or bitwise "or" of YOKAN_MODE_* flags.
+ * @param[in] key Key.
+ * @param[in] ksize Size of the key.
+ * @param[in] offset Offset within the value.
+ * @param[out] buffer Buffer in which to read the data.
+ * @param[inout] size Size of the buffer / number of bytes read.
+ *
+ * @return YOKAN_SUCCESS or corresponding error code.
+ */
+yk_return_t yk_get_range(yk_database_handle_t dbh,
+                         int32_t mode,
+                         const void* key,
+                         size_t ksize,
+                         size_t offset,
+                         void* buffer,
+                         size_t* size, ...);
+
 /**
  * @brief This function performs a GET but instead of providing a buffer
  * in which to receive the value, the caller provides a function to call
@@ -1032,6 +1365,86 @@ yk_return_t yk_iter(yk_database_handle_t dbh,
                     void* uargs,
                     const yk_iter_options_t* options, ...);
 
+/**
+ * A scanner lists the key/value pairs of a database page by page, like
+ * successive calls to yk_list_keyvals_packed, but a ULT keeps fetching
+ * the next pages while the application consumes the current one. Pages
+ * start at batch_size items and buffer_size bytes and are doubled as long
+ * as doing so increases the observed throughput, up to max_buffer_size.
+ */
+typedef struct yk_scanner* yk_scanner_t;
+#define YOKAN_SCANNER_NULL ((yk_scanner_t)NULL)
+
+typedef struct yk_scan_options {
+    size_t   batch_size;      /* initial number of items per page (0 = 64) */
+    size_t   buffer_size;     /* initial bytes per page (0 = 64 KiB) */
+    size_t   max_buffer_size; /* bound on the page growth (0 = 16 MiB) */
+    unsigned depth;           /* pages fetched ahead of the application (0 = 2) */
+    ABT_pool pool;            /* pool running the prefetching ULT
+                                 (ABT_POOL_NULL = handler pool of the client) */
+    bool     ignore_values;   /* list keys only */
+} yk_scan_options_t;
+
+#define YOKAN_SCAN_OPTIONS_INIT { 0, 0, 0, 0, ABT_POOL_NULL, false }
+
+/**
+ * @brief Creates a scanner starting at from_key (included if inclusive is
+ * set in the mode) and filtering keys if a filter is provided. Since each
+ * page starts after the last key of the previous one, the
+ * YOKAN_MODE_NO_PREFIX, YOKAN_MODE_IGNORE_KEYS, and YOKAN_MODE_KEEP_LAST
+ * modes are not supported.
+ *
+ * @param[in] dbh Database handle.
+ * @param[in] mode 0 or bitwise "or" of YOKAN_MODE_* flags.
+ * @param[in] from_key Starting key.
+ * @param[in] from_ksize Starting key size.
+ * @param[in] filter Key filter.
+ * @param[in] filter_size Filter size.
+ * @param[in] options Options (may be NULL).
+ * @param[out] scanner Resulting scanner.
+ *
+ * @return YOKAN_SUCCESS or corresponding error code.
+ */
+yk_return_t yk_scanner_create(yk_database_handle_t dbh,
+                              int32_t mode,
+                              const void* from_key,
+                              size_t from_ksize,
+                              const void* filter,
+                              size_t filter_size,
+                              const yk_scan_options_t* options,
+                              yk_scanner_t* scanner, ...);
+
+/**
+ * @brief Gets the next key/value pair of the scanner, blocking until
+ * its page is available. The pointers remain valid until the next call
+ * to yk_scanner_next or yk_scanner_destroy. At the end of the scan, the
+ * key is set to NULL and its size to YOKAN_NO_MORE_KEYS. If fetching a
+ * page failed, the error is returned once the previous pages have been
+ * consumed.
+ *
+ * @param[in] scanner Scanner.
+ * @param[out] key Key.
+ * @param[out] ksize Key size.
+ * @param[out] value Value (may be NULL, NULL if ignore_values is set).
+ * @param[out] vsize Value size (may be NULL).
+ *
+ * @return YOKAN_SUCCESS or corresponding error code.
+ */
+yk_return_t yk_scanner_next(yk_scanner_t scanner,
+                            const void** key,
+                            size_t* ksize,
+                            const void** value,
+                            size_t* vsize);
+
+/**
+ * @brief Stops the prefetching ULT and destroys the scanner.
+ *
+ * @param[in] scanner Scanner.
+ *
+ * @return YOKAN_SUCCESS or corresponding error code.
+ */
+yk_return_t yk_scanner_destroy(yk_scanner_t scanner);
+
 #ifdef __cplusplus
 }
 #endif
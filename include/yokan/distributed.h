@@ -0,0 +1,252 @@
+/*
+ * (C) 2026 The University of Chicago
+ *
+ * See COPYRIGHT in top-level directory.
+ */
+#ifndef __YOKAN_DISTRIBUTED_H
+#define __YOKAN_DISTRIBUTED_H
+
+#include <stdbool.h>
+#include <margo.h>
+#include <yokan/common.h>
+#include <yokan/database.h>
+#include <yokan/client.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A distributed database handle spreads the keys of a logical database
+ * over several databases (possibly managed by different providers). Each
+ * key is stored in exactly one of them, chosen either by consistent
+ * hashing or by range partitioning. Calls on a single key are forwarded
+ * to the database holding the key, calls on multiple keys are split into
+ * one call per database, executed in parallel, and the listing functions
+ * merge the results of all the databases in key order.
+ */
+typedef struct yk_distributed_database *yk_distributed_database_t;
+#define YOKAN_DISTRIBUTED_DATABASE_NULL ((yk_distributed_database_t)NULL)
+
+typedef enum yk_partitioning {
+    /* Keys are placed on a hash ring on which each database owns a number
+     * of virtual nodes. The placement of a database's virtual nodes only
+     * depends on its address and provider id, hence adding or removing a
+     * database only moves the keys it gains or loses, and clients created
+     * with the same databases in a different order agree on the placement. */
+    YOKAN_PARTITION_HASH = 0,
+    /* Database i holds the keys in [split_keys[i-1], split_keys[i]), which
+     * keeps ranges of keys together on sorted backends. */
+    YOKAN_PARTITION_RANGE = 1
+} yk_partitioning_t;
+
+typedef struct yk_distributed_options {
+    yk_partitioning_t  partitioning;
+    size_t             virtual_nodes; /* per database, for YOKAN_PARTITION_HASH (0 = 64) */
+    const void* const* split_keys;    /* count-1 sorted keys, for YOKAN_PARTITION_RANGE */
+    const size_t*      split_ksizes;  /* sizes of the split keys */
+    ABT_pool           pool;          /* pool running the per-database calls
+                                         (ABT_POOL_NULL = pool of the caller) */
+} yk_distributed_options_t;
+
+#define YOKAN_DISTRIBUTED_OPTIONS_INIT \
+    { YOKAN_PARTITION_HASH, 0, NULL, NULL, ABT_POOL_NULL }
+
+/**
+ * @brief Creates a distributed database handle over the provided
+ * database handles. The distributed handle holds a reference to each
+ * of them, so the caller may release them afterwards.
+ *
+ * @param[in] count Number of databases
+ * @param[in] dbhs Database handles
+ * @param[in] options Partitioning options (NULL = consistent hashing)
+ * @param[out] ddb Distributed database handle
+ *
+ * @return YOKAN_SUCCESS or error code defined in common.h
+ */
+yk_return_t yk_distributed_database_create(
+        size_t count,
+        const yk_database_handle_t* dbhs,
+        const yk_distributed_options_t* options,
+        yk_distributed_database_t* ddb);
+
+/**
+ * @brief Releases the distributed database handle and the references
+ * it holds to the underlying database handles.
+ *
+ * @param[in] ddb Distributed database handle
+ *
+ * @return YOKAN_SUCCESS or error code defined in common.h
+ */
+yk_return_t yk_distributed_database_release(
+        yk_distributed_database_t ddb);
+
+/**
+ * @brief Get the number of databases and, if dbh is not NULL, the
+ * database handle at the given index (which is NOT ref-incremented).
+ *
+ * @param[in] ddb Distributed database handle
+ * @param[in] index Index of the database
+ * @param[out] count Number of databases (may be NULL)
+ * @param[out] dbh Database handle at the index (may be NULL)
+ *
+ * @return YOKAN_SUCCESS or error code defined in common.h
+ */
+yk_return_t yk_distributed_database_get_info(
+        yk_distributed_database_t ddb,
+        size_t index,
+        size_t* count,
+        yk_database_handle_t* dbh);
+
+/**
+ * @brief Get the index of the database holding the given key.
+ *
+ * @param[in] ddb Distributed database handle
+ * @param[in] key Key
+ * @param[in] ksize Size of the key
+ * @param[out] index Index of the database
+ *
+ * @return YOKAN_SUCCESS or error code defined in common.h
+ */
+yk_return_t yk_distributed_locate(
+        yk_distributed_database_t ddb,
+        const void* key,
+        size_t ksize,
+        size_t* index);
+
+/**
+ * The following functions have the same semantics as their yk_*
+ * counterpart in yokan/database.h. The multi and packed versions send
+ * one request per database involved, in parallel, and return the first
+ * error encountered, if any.
+ */
+
+yk_return_t yk_distributed_count(yk_distributed_database_t ddb,
+                                 int32_t mode,
+                                 size_t* count, ...);
+
+yk_return_t yk_distributed_put(yk_distributed_database_t ddb,
+                               int32_t mode,
+                               const void* key,
+                               size_t ksize,
+                               const void* value,
+                               size_t vsize, ...);
+
+yk_return_t yk_distributed_put_multi(yk_distributed_database_t ddb,
+                                     int32_t mode,
+                                     size_t count,
+                                     const void* const* keys,
+                                     const size_t* ksizes,
+                                     const void* const* values,
+                                     const size_t* vsizes, ...);
+
+yk_return_t yk_distributed_put_packed(yk_distributed_database_t ddb,
+                                      int32_t mode,
+                                      size_t count,
+                                      const void* keys,
+                                      const size_t* ksizes,
+                                      const void* values,
+                                      const size_t* vsizes, ...);
+
+yk_return_t yk_distributed_exists(yk_distributed_database_t ddb,
+                                  int32_t mode,
+                                  const void* key,
+                                  size_t ksize,
+                                  uint8_t* exists, ...);
+
+yk_return_t yk_distributed_length(yk_distributed_database_t ddb,
+                                  int32_t mode,
+                                  const void* key,
+                                  size_t ksize,
+                                  size_t* vsize, ...);
+
+yk_return_t yk_distributed_get(yk_distributed_database_t ddb,
+                               int32_t mode,
+                               const void* key,
+                               size_t ksize,
+                               void* value,
+                               size_t* vsize, ...);
+
+yk_return_t yk_distributed_get_multi(yk_distributed_database_t ddb,
+                                     int32_t mode,
+                                     size_t count,
+                                     const void* const* keys,
+                                     const size_t* ksizes,
+                                     void* const* values,
+                                     size_t* vsizes, ...);
+
+/**
+ * Note: since the values of each database are received in a separate
+ * buffer before being packed in the values buffer, this function needs
+ * a temporary buffer of vbufsize bytes per database involved. Use
+ * yk_distributed_get_multi when this is an issue.
+ */
+yk_return_t yk_distributed_get_packed(yk_distributed_database_t ddb,
+                                      int32_t mode,
+                                      size_t count,
+                                      const void* keys,
+                                      const size_t* ksizes,
+                                      size_t vbufsize,
+                                      void* values,
+                                      size_t* vsizes, ...);
+
+yk_return_t yk_distributed_erase(yk_distributed_database_t ddb,
+                                 int32_t mode,
+                                 const void* key,
+                                 size_t ksize, ...);
+
+yk_return_t yk_distributed_erase_multi(yk_distributed_database_t ddb,
+                                       int32_t mode,
+                                       size_t count,
+                                       const void* const* keys,
+                                       const size_t* ksizes, ...);
+
+yk_return_t yk_distributed_erase_packed(yk_distributed_database_t ddb,
+                                        int32_t mode,
+                                        size_t count,
+                                        const void* keys,
+                                        const size_t* ksizes, ...);
+
+/**
+ * @brief Lists up to count keys of the distributed database in key order.
+ * The keys are obtained by iterating over all the databases and merging
+ * their keys. Since the keys are needed to merge the results, the
+ * YOKAN_MODE_NO_PREFIX, YOKAN_MODE_IGNORE_KEYS, and YOKAN_MODE_KEEP_LAST
+ * modes are not supported, and neither is YOKAN_MODE_CONSUME, since keys
+ * read from a database may not end up in the result. Key order is the
+ * lexicographical order of the key bytes.
+ *
+ * Entries of ksizes past the last key found are set to YOKAN_NO_MORE_KEYS.
+ */
+yk_return_t yk_distributed_list_keys(yk_distributed_database_t ddb,
+                                     int32_t mode,
+                                     const void* from_key,
+                                     size_t from_ksize,
+                                     const void* filter,
+                                     size_t filter_size,
+                                     size_t count,
+                                     void* const* keys,
+                                     size_t* ksizes, ...);
+
+/**
+ * @brief Iterates over up to count key/value pairs of the distributed
+ * database in key order (see yk_distributed_list_keys for the supported
+ * modes). Each database is read in batches of options->batch_size items
+ * (64 if 0) and the callback is invoked by the calling ULT.
+ */
+yk_return_t yk_distributed_iter(yk_distributed_database_t ddb,
+                                int32_t mode,
+                                const void* from_key,
+                                size_t from_ksize,
+                                const void* filter,
+                                size_t filter_size,
+                                size_t count,
+                                yk_keyvalue_callback_t cb,
+                                void* uargs,
+                                const yk_iter_options_t* options, ...);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -48,10 +48,11 @@ class DocumentStoreMixin : public DB {
 
     DocumentStoreMixin() {
         ABT_rwlock_create(&m_lock);
-
+        YOKAN_PROFILE_LOCK(m_lock, this, "doc_mixin");
     }
 
     virtual ~DocumentStoreMixin() {
+        YOKAN_UNPROFILE_LOCK(m_lock);
         ABT_rwlock_free(&m_lock);
     }
 
@@ -72,6 +73,7 @@ class DocumentStoreMixin : public DB {
     using DB::listKeyValues;
 
     void disableDocMixinLock() {
+        YOKAN_UNPROFILE_LOCK(m_lock);
         ABT_rwlock_free(&m_lock);
         m_lock = ABT_RWLOCK_NULL;
     }
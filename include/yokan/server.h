@@ -138,6 +138,61 @@ yk_return_t yk_provider_restore_database(
  */
 char* yk_provider_get_config(yk_provider_t provider);
 
+/**
+ * @brief Returns the statistics collected by the provider, as a
+ * JSON string of the form { "rpcs": { "<rpc name>": { ... } },
+ * "backend": { ... } }.
+ *
+ * For each RPC type that has been called at least once, the "rpcs"
+ * object contains the number of calls, the number of keys or documents,
+ * the bytes received and sent, the number of occurences of each
+ * error code, and latency statistics (min, max, avg, and
+ * percentiles, in microseconds). RPC metrics can be disabled by setting
+ * "enabled" to false in the "metrics" section of the provider's
+ * configuration, in which case the "rpcs" field is absent.
+ *
+ * The "backend" object contains the statistics reported by the
+ * database's backend (see DatabaseInterface::stats), along with
+ * the backend's "type". Its content depends on the backend
+ * (e.g. number of entries, memory used, RocksDB properties).
+ * This field is absent if the provider has no database.
+ *
+ * If Yokan was built with ENABLE_LOCK_PROFILING, a "locks" object
+ * maps the name of each lock of the backend ("<type>/<purpose>",
+ * e.g. "map/db") to its number of read and write acquisitions,
+ * the number of contended acquisitions, the number of waiters, and
+ * histograms of wait and hold times (in microseconds).
+ *
+ * The returned string must be free-ed by the caller.
+ *
+ * @param provider YOKAN provider.
+ * @param reset Whether to reset the RPC metrics and lock profiles
+ * after reading them.
+ */
+char* yk_provider_get_stats(yk_provider_t provider, bool reset);
+
+/**
+ * @brief Returns the spans recorded by the provider's RPC tracer, as a
+ * JSON string in the Chrome trace event format (which can be loaded in
+ * chrome://tracing or Perfetto). Each traced RPC produces one span for
+ * the whole RPC and one span per phase of its handler (deserialize,
+ * prepare, bulk_pull, backend, bulk_push, respond). Spans are grouped
+ * by trace id, which the client can set using YOKAN_EXTRA_TRACE_ID.
+ *
+ * Tracing is disabled by default. It is enabled by setting "enabled"
+ * to true in the "tracing" section of the provider's configuration,
+ * which also accepts a "capacity" (maximum number of spans kept, the
+ * oldest ones being overwritten) and an "output_file" to which the
+ * trace is written when the provider is finalized. If tracing is
+ * disabled, this function returns "{}".
+ *
+ * The returned string must be free-ed by the caller.
+ *
+ * @param provider YOKAN provider.
+ * @param clear Whether to clear the recorded spans after reading them.
+ */
+char* yk_provider_get_trace(yk_provider_t provider, bool clear);
+
 #ifdef __cplusplus
 }
 #endif
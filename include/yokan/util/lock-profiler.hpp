@@ -0,0 +1,176 @@
+/*
+ * (C) 2026 The University of Chicago
+ *
+ * See COPYRIGHT in top-level directory.
+ */
+#ifndef __YOKAN_LOCK_PROFILER_HPP
+#define __YOKAN_LOCK_PROFILER_HPP
+
+#include <abt.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <cstdint>
+
+namespace yokan {
+
+class DatabaseInterface;
+
+/**
+ * @brief Contention profile of a single lock instance. Wait and hold
+ * times are recorded in histograms with one bucket per power of two
+ * nanoseconds. The number of ULTs waiting on the lock is sampled every
+ * time a ULT starts waiting.
+ *
+ * This class is only used when Yokan is built with ENABLE_LOCK_PROFILING.
+ */
+struct LockProfile {
+
+    static constexpr unsigned NumBuckets = 64;
+
+    /**
+     * @brief Acquisitions that waited at least this long
+     * are counted as contended.
+     */
+    static constexpr uint64_t ContendedThresholdNs = 1000;
+
+    LockProfile(const DatabaseInterface* o, std::string n)
+    : owner(o)
+    , name(std::move(n)) {}
+
+    static uint64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static unsigned bucketIndex(uint64_t ns) {
+        return ns ? 64 - __builtin_clzll(ns) - 1 : 0;
+    }
+
+    void recordWait(uint64_t ns, bool exclusive) {
+        constexpr auto relaxed = std::memory_order_relaxed;
+        (exclusive ? write_acquisitions : read_acquisitions).fetch_add(1, relaxed);
+        if(ns >= ContendedThresholdNs) contended.fetch_add(1, relaxed);
+        wait_sum.fetch_add(ns, relaxed);
+        auto max = wait_max.load(relaxed);
+        while(ns > max && !wait_max.compare_exchange_weak(max, ns, relaxed));
+        wait_histogram[bucketIndex(ns)].fetch_add(1, relaxed);
+    }
+
+    void recordHold(uint64_t ns) {
+        constexpr auto relaxed = std::memory_order_relaxed;
+        hold_sum.fetch_add(ns, relaxed);
+        auto max = hold_max.load(relaxed);
+        while(ns > max && !hold_max.compare_exchange_weak(max, ns, relaxed));
+        hold_histogram[bucketIndex(ns)].fetch_add(1, relaxed);
+    }
+
+    void startWaiting() {
+        constexpr auto relaxed = std::memory_order_relaxed;
+        auto w = waiters.fetch_add(1, relaxed) + 1;
+        waiters_sum.fetch_add(w - 1, relaxed);
+        auto max = waiters_max.load(relaxed);
+        while(w > max && !waiters_max.compare_exchange_weak(max, w, relaxed));
+    }
+
+    void stopWaiting() {
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    const DatabaseInterface* owner;
+    std::string              name;
+
+    std::atomic<uint64_t> read_acquisitions{0};
+    std::atomic<uint64_t> write_acquisitions{0};
+    std::atomic<uint64_t> contended{0};
+    std::atomic<uint64_t> waiters{0};
+    std::atomic<uint64_t> waiters_sum{0}; // other waiters seen on arrival
+    std::atomic<uint64_t> waiters_max{0};
+    std::atomic<uint64_t> wait_sum{0};
+    std::atomic<uint64_t> wait_max{0};
+    std::atomic<uint64_t> hold_sum{0};
+    std::atomic<uint64_t> hold_max{0};
+    std::atomic<uint64_t> wait_histogram[NumBuckets] = {};
+    std::atomic<uint64_t> hold_histogram[NumBuckets] = {};
+};
+
+/**
+ * @brief Process-wide registry of the profiled locks. Locks are
+ * registered by their owner (typically right after ABT_rwlock_create)
+ * using the YOKAN_PROFILE_LOCK macro and unregistered before being
+ * freed using YOKAN_UNPROFILE_LOCK. Locks that are not registered
+ * are not profiled.
+ */
+class LockProfiler {
+
+    public:
+
+    /**
+     * @brief Register a lock. The name should describe the purpose
+     * of the lock within its owner (e.g. "db", "collection:<name>").
+     */
+    static void add(ABT_rwlock lock, const DatabaseInterface* owner, std::string name);
+
+    /**
+     * @brief Unregister a lock, discarding its profile.
+     */
+    static void remove(ABT_rwlock lock);
+
+    /**
+     * @brief Find the profile of a lock, or nullptr if it is not registered.
+     */
+    static LockProfile* find(ABT_rwlock lock);
+
+    /**
+     * @brief Return a JSON string describing the profiles of all the
+     * locks registered by the provided owner, as an object mapping
+     * the name of each lock to its statistics. If reset is true, the
+     * counters are reset after being read.
+     */
+    static std::string toJSON(const DatabaseInterface* owner, bool reset);
+};
+
+/**
+ * @brief State kept by ScopedReadLock and ScopedWriteLock
+ * to profile the lock they hold.
+ */
+struct LockProfilingState {
+
+    void rdlock(ABT_rwlock lock) {
+        acquire(lock, false);
+    }
+
+    void wrlock(ABT_rwlock lock) {
+        acquire(lock, true);
+    }
+
+    void unlock(ABT_rwlock lock) {
+        ABT_rwlock_unlock(lock);
+        if(m_profile) m_profile->recordHold(LockProfile::now() - m_acquired);
+    }
+
+    private:
+
+    void acquire(ABT_rwlock lock, bool exclusive) {
+        m_profile = LockProfiler::find(lock);
+        if(!m_profile) {
+            if(exclusive) ABT_rwlock_wrlock(lock);
+            else ABT_rwlock_rdlock(lock);
+            return;
+        }
+        auto start = LockProfile::now();
+        m_profile->startWaiting();
+        if(exclusive) ABT_rwlock_wrlock(lock);
+        else ABT_rwlock_rdlock(lock);
+        m_profile->stopWaiting();
+        m_acquired = LockProfile::now();
+        m_profile->recordWait(m_acquired - start, exclusive);
+    }
+
+    LockProfile* m_profile  = nullptr;
+    uint64_t     m_acquired = 0;
+};
+
+}
+
+#endif
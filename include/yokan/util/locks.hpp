@@ -8,6 +8,30 @@
 
 #include <abt.h>
 
+/**
+ * When Yokan is built with ENABLE_LOCK_PROFILING, ScopedReadLock and
+ * ScopedWriteLock record wait time, hold time, and waiter counts for
+ * the locks registered via YOKAN_PROFILE_LOCK. Otherwise these macros
+ * expand to nothing (their arguments are not evaluated) and the lock
+ * wrappers are plain calls to Argobots.
+ */
+#ifdef YOKAN_LOCK_PROFILING
+#include <yokan/util/lock-profiler.hpp>
+#define YOKAN_PROFILE_LOCK(__lock__, __owner__, __name__) \
+    ::yokan::LockProfiler::add((__lock__), (__owner__), (__name__))
+#define YOKAN_UNPROFILE_LOCK(__lock__) \
+    ::yokan::LockProfiler::remove(__lock__)
+#define YOKAN_RWLOCK_RDLOCK(__lock__) m_profiling.rdlock(__lock__)
+#define YOKAN_RWLOCK_WRLOCK(__lock__) m_profiling.wrlock(__lock__)
+#define YOKAN_RWLOCK_UNLOCK(__lock__) m_profiling.unlock(__lock__)
+#else
+#define YOKAN_PROFILE_LOCK(__lock__, __owner__, __name__) do {} while(0)
+#define YOKAN_UNPROFILE_LOCK(__lock__) do {} while(0)
+#define YOKAN_RWLOCK_RDLOCK(__lock__) ABT_rwlock_rdlock(__lock__)
+#define YOKAN_RWLOCK_WRLOCK(__lock__) ABT_rwlock_wrlock(__lock__)
+#define YOKAN_RWLOCK_UNLOCK(__lock__) ABT_rwlock_unlock(__lock__)
+#endif
+
 namespace yokan {
 
 struct ScopedWriteLock {
@@ -17,25 +41,28 @@ struct ScopedWriteLock {
     ScopedWriteLock(ABT_rwlock lock)
     : m_lock(lock) {
         if(m_lock != ABT_RWLOCK_NULL)
-            ABT_rwlock_wrlock(m_lock);
+            YOKAN_RWLOCK_WRLOCK(m_lock);
     }
 
     ~ScopedWriteLock() {
         if(m_lock != ABT_RWLOCK_NULL)
-            ABT_rwlock_unlock(m_lock);
+            YOKAN_RWLOCK_UNLOCK(m_lock);
     }
 
     void unlock() {
         if(m_lock != ABT_RWLOCK_NULL)
-            ABT_rwlock_unlock(m_lock);
+            YOKAN_RWLOCK_UNLOCK(m_lock);
     }
 
     void lock() {
         if(m_lock != ABT_RWLOCK_NULL)
-            ABT_rwlock_wrlock(m_lock);
+            YOKAN_RWLOCK_WRLOCK(m_lock);
     }
 
     ABT_rwlock m_lock = ABT_RWLOCK_NULL;
+#ifdef YOKAN_LOCK_PROFILING
+    LockProfilingState m_profiling;
+#endif
 };
 
 struct ScopedReadLock {
@@ -43,25 +70,28 @@ struct ScopedReadLock {
     ScopedReadLock(ABT_rwlock lock)
     : m_lock(lock) {
         if(m_lock != ABT_RWLOCK_NULL)
-            ABT_rwlock_rdlock(m_lock);
+            YOKAN_RWLOCK_RDLOCK(m_lock);
     }
 
     ~ScopedReadLock() {
         if(m_lock != ABT_RWLOCK_NULL)
-            ABT_rwlock_unlock(m_lock);
+            YOKAN_RWLOCK_UNLOCK(m_lock);
     }
 
     void unlock() {
         if(m_lock != ABT_RWLOCK_NULL)
-            ABT_rwlock_unlock(m_lock);
+            YOKAN_RWLOCK_UNLOCK(m_lock);
     }
 
     void lock() {
         if(m_lock != ABT_RWLOCK_NULL)
-            ABT_rwlock_rdlock(m_lock);
+            YOKAN_RWLOCK_RDLOCK(m_lock);
     }
 
     ABT_rwlock m_lock = ABT_RWLOCK_NULL;
+#ifdef YOKAN_LOCK_PROFILING
+    LockProfilingState m_profiling;
+#endif
 };
 
 struct ScopedMutex {
@@ -0,0 +1,51 @@
+"""
+Asyncio integration for Yokan database handles.
+
+The methods of Database release the GIL while waiting for the provider.
+AsyncDatabase exposes each of them as a coroutine that runs the call in
+an executor, so that an event loop can keep many Yokan operations in
+flight while doing other work.
+
+Since the calls are issued from executor threads, which are not managed
+by Argobots, the Margo engine should be created with a progress thread
+(e.g. config={"use_progress_thread": True}); otherwise network progress
+depends on the thread running the event loop.
+"""
+
+import asyncio
+import functools
+
+from pyyokan_client import Database
+
+
+class AsyncDatabase:
+    """
+    Wraps a Database so that `await adb.get(...)` behaves like
+    `db.get(...)` without blocking the event loop. Attributes that are
+    not methods are returned as-is.
+    """
+
+    def __init__(self, database: Database, executor=None):
+        self._database = database
+        self._executor = executor
+
+    @property
+    def database(self) -> Database:
+        return self._database
+
+    def __getattr__(self, name):
+        method = getattr(self._database, name)
+        if not callable(method):
+            return method
+
+        async def coroutine(*args, **kwargs):
+            loop = asyncio.get_running_loop()
+            return await loop.run_in_executor(
+                self._executor, functools.partial(method, *args, **kwargs))
+
+        coroutine.__name__ = name
+        coroutine.__doc__ = method.__doc__
+        return coroutine
+
+
+__all__ = ['AsyncDatabase']
@@ -3,5 +3,7 @@ Yokan client module providing high-level Python API for Yokan client operations.
 """
 
 from pyyokan_client import Client, Database, Collection
+from pyyokan_common import YOKAN_KEY_NOT_FOUND, YOKAN_SIZE_TOO_SMALL
 
-__all__ = ['Client', 'Database', 'Collection']
+__all__ = ['Client', 'Database', 'Collection',
+           'YOKAN_KEY_NOT_FOUND', 'YOKAN_SIZE_TOO_SMALL']
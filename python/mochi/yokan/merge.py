@@ -0,0 +1,17 @@
+"""
+Yokan operators for Database.merge.
+"""
+
+from pyyokan_common import (
+    YOKAN_MERGE_ADD_INT64,
+    YOKAN_MERGE_MAX_INT64,
+    YOKAN_MERGE_BIT_OR,
+    YOKAN_MERGE_APPEND,
+)
+
+__all__ = [
+    'YOKAN_MERGE_ADD_INT64',
+    'YOKAN_MERGE_MAX_INT64',
+    'YOKAN_MERGE_BIT_OR',
+    'YOKAN_MERGE_APPEND',
+]
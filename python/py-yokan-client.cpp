@@ -4,6 +4,7 @@
 #include <yokan/cxx/client.hpp>
 #include <yokan/cxx/database.hpp>
 #include <yokan/cxx/collection.hpp>
+#include <yokan/cxx/scanner.hpp>
 #include <iostream>
 #include <numeric>
 #include <optional>
@@ -40,6 +41,40 @@ static auto get_buffer_info(const std::string& str) {
         throw yokan::Exception(YOKAN_ERR_READONLY);     \
 } while(0)
 
+/**
+ * Sizes of packed keys and values may be passed as any buffer of integers
+ * (e.g. a NumPy array). A contiguous array of size_t (dtype uint64 in
+ * NumPy) is used in place, without creating a Python object per item.
+ * Other buffers are converted into the provided vector. The caller keeps
+ * the buffer_info, and with it the buffer export, alive for as long as it
+ * uses the returned pointer (including while the GIL is released).
+ */
+static bool is_size_array(const py::buffer_info& info) {
+    if(info.ndim != 1 || info.itemsize != sizeof(size_t)) return false;
+    if(info.size > 1 && info.strides[0] != (ssize_t)sizeof(size_t)) return false;
+    const auto& f = info.format;
+    return f == "Q" || f == "L" || f == "=Q" || f == "=L" || f == "@Q" || f == "@L";
+}
+
+static std::pair<const size_t*, size_t> get_size_array(
+        const py::buffer& buf, py::buffer_info& info, std::vector<size_t>& copy) {
+    info = buf.request();
+    if(is_size_array(info))
+        return { static_cast<const size_t*>(info.ptr), (size_t)info.size };
+    copy = buf.cast<std::vector<size_t>>();
+    return { copy.data(), copy.size() };
+}
+
+static size_t* get_output_size_array(
+        py::buffer& buf, py::buffer_info& info, size_t count) {
+    info = buf.request(true);
+    if(!is_size_array(info))
+        throw std::invalid_argument("output sizes should be a contiguous array of uint64");
+    if((size_t)info.size < count)
+        throw std::length_error("output sizes array is smaller than the number of keys");
+    return static_cast<size_t*>(info.ptr);
+}
+
 template <typename KeyType, typename ValueType>
 static void put_helper(const yokan::Database& db, const KeyType& key,
                        const ValueType& val, int32_t mode, double timeout_ms) {
@@ -62,6 +97,95 @@ static void put_helper(const yokan::Database& db, const KeyType& key,
                 mode);
 }
 
+template <typename KeyType, typename ValueType>
+static void put_range_helper(const yokan::Database& db, const KeyType& key,
+                             size_t offset, const ValueType& val,
+                             int32_t mode, double timeout_ms) {
+    auto key_info = get_buffer_info(key);
+    auto val_info = get_buffer_info(val);
+    CHECK_BUFFER_IS_CONTIGUOUS(key_info);
+    CHECK_BUFFER_IS_CONTIGUOUS(val_info);
+    py::gil_scoped_release release;
+    if (timeout_ms > 0.0)
+        db.putRange(key_info.ptr,
+                    key_info.itemsize*key_info.size,
+                    offset,
+                    val_info.ptr,
+                    val_info.itemsize*val_info.size,
+                    mode, yokan::Timeout{timeout_ms});
+    else
+        db.putRange(key_info.ptr,
+                    key_info.itemsize*key_info.size,
+                    offset,
+                    val_info.ptr,
+                    val_info.itemsize*val_info.size,
+                    mode);
+}
+
+template <typename KeyType, typename ValueType>
+static bool compare_and_swap_helper(const yokan::Database& db, const KeyType& key,
+                                    const ValueType& expected, const ValueType& val,
+                                    int32_t mode, double timeout_ms) {
+    auto key_info = get_buffer_info(key);
+    auto exp_info = get_buffer_info(expected);
+    auto val_info = get_buffer_info(val);
+    CHECK_BUFFER_IS_CONTIGUOUS(key_info);
+    CHECK_BUFFER_IS_CONTIGUOUS(exp_info);
+    CHECK_BUFFER_IS_CONTIGUOUS(val_info);
+    py::gil_scoped_release release;
+    if (timeout_ms > 0.0)
+        return db.compareAndSwap(key_info.ptr,
+                                 key_info.itemsize*key_info.size,
+                                 exp_info.ptr,
+                                 exp_info.itemsize*exp_info.size,
+                                 val_info.ptr,
+                                 val_info.itemsize*val_info.size,
+                                 mode, yokan::Timeout{timeout_ms});
+    else
+        return db.compareAndSwap(key_info.ptr,
+                                 key_info.itemsize*key_info.size,
+                                 exp_info.ptr,
+                                 exp_info.itemsize*exp_info.size,
+                                 val_info.ptr,
+                                 val_info.itemsize*val_info.size,
+                                 mode);
+}
+
+template <typename KeyType, typename OperandType>
+static size_t merge_helper(const yokan::Database& db, const KeyType& key,
+                           int32_t op, const OperandType& operand, size_t bound,
+                           std::optional<py::buffer> result,
+                           int32_t mode, double timeout_ms) {
+    auto key_info = get_buffer_info(key);
+    auto op_info  = get_buffer_info(operand);
+    CHECK_BUFFER_IS_CONTIGUOUS(key_info);
+    CHECK_BUFFER_IS_CONTIGUOUS(op_info);
+    void*  rptr  = nullptr;
+    size_t rsize = 0;
+    if(result) {
+        auto res_info = result->request();
+        CHECK_BUFFER_IS_CONTIGUOUS(res_info);
+        CHECK_BUFFER_IS_WRITABLE(res_info);
+        rptr  = res_info.ptr;
+        rsize = res_info.itemsize*res_info.size;
+    }
+    py::gil_scoped_release release;
+    if (timeout_ms > 0.0)
+        return db.merge(key_info.ptr,
+                        key_info.itemsize*key_info.size,
+                        op, op_info.ptr,
+                        op_info.itemsize*op_info.size,
+                        bound, rptr, rsize,
+                        mode, yokan::Timeout{timeout_ms});
+    else
+        return db.merge(key_info.ptr,
+                        key_info.itemsize*key_info.size,
+                        op, op_info.ptr,
+                        op_info.itemsize*op_info.size,
+                        bound, rptr, rsize,
+                        mode);
+}
+
 template <typename KeyType, typename ValueType>
 static void put_multi_helper(const yokan::Database& db,
                              const std::vector<std::pair<KeyType,ValueType>>& keyvals,
@@ -125,6 +249,45 @@ static auto get_helper(const yokan::Database& db, const KeyType& key,
     return vsize;
 }
 
+template<typename KeyType>
+static auto get_range_helper(const yokan::Database& db, const KeyType& key,
+                             size_t offset, py::buffer& val,
+                             int32_t mode, double timeout_ms) {
+    auto key_info = get_buffer_info(key);
+    auto val_info = val.request();
+    CHECK_BUFFER_IS_CONTIGUOUS(key_info);
+    CHECK_BUFFER_IS_CONTIGUOUS(val_info);
+    CHECK_BUFFER_IS_WRITABLE(val_info);
+    size_t vsize = val_info.itemsize*val_info.size;
+    py::gil_scoped_release release;
+    if (timeout_ms > 0.0)
+        return db.getRange(key_info.ptr,
+                           key_info.itemsize*key_info.size,
+                           offset, val_info.ptr, vsize,
+                           mode, yokan::Timeout{timeout_ms});
+    else
+        return db.getRange(key_info.ptr,
+                           key_info.itemsize*key_info.size,
+                           offset, val_info.ptr, vsize,
+                           mode);
+}
+
+template<typename KeyType>
+static auto get_alloc_helper(const yokan::Database& db, const KeyType& key,
+                             int32_t mode, double timeout_ms) {
+    auto key_info = get_buffer_info(key);
+    CHECK_BUFFER_IS_CONTIGUOUS(key_info);
+    py::gil_scoped_release release;
+    if (timeout_ms > 0.0)
+        return db.getAlloc(key_info.ptr,
+                           key_info.itemsize*key_info.size,
+                           mode, yokan::Timeout{timeout_ms});
+    else
+        return db.getAlloc(key_info.ptr,
+                           key_info.itemsize*key_info.size,
+                           mode);
+}
+
 template<typename KeyType>
 static auto get_multi_helper(const yokan::Database& db,
                              const std::vector<std::pair<KeyType, py::buffer>>& keyvals,
@@ -594,6 +757,49 @@ static auto iter_helper(
                 count, func, &options, mode);
 }
 
+struct py_scanner {
+    yokan::Scanner scanner;
+    bool           str_keys;
+    bool           ignore_values;
+};
+
+template<typename KeyType, typename FilterType>
+static auto scan_helper(
+                const yokan::Database& db,
+                const KeyType& from_key,
+                const FilterType& filter,
+                int32_t mode, size_t batch_size, size_t buffer_size,
+                size_t max_buffer_size, unsigned depth, bool ignore_values,
+                double timeout_ms) {
+    auto from_key_info = get_buffer_info(from_key);
+    CHECK_BUFFER_IS_CONTIGUOUS(from_key_info);
+    auto filter_info = get_buffer_info(filter);
+    CHECK_BUFFER_IS_CONTIGUOUS(filter_info);
+    yk_scan_options_t options = YOKAN_SCAN_OPTIONS_INIT;
+    options.batch_size      = batch_size;
+    options.buffer_size     = buffer_size;
+    options.max_buffer_size = max_buffer_size;
+    options.depth           = depth;
+    options.ignore_values   = ignore_values;
+    auto result = std::make_unique<py_scanner>();
+    result->str_keys      = std::is_same<KeyType, std::string>::value;
+    result->ignore_values = ignore_values;
+    py::gil_scoped_release release;
+    if (timeout_ms > 0.0)
+        result->scanner = yokan::Scanner{db, from_key_info.ptr,
+                from_key_info.itemsize*from_key_info.size,
+                filter_info.ptr,
+                filter_info.itemsize*filter_info.size,
+                &options, mode, yokan::Timeout{timeout_ms}};
+    else
+        result->scanner = yokan::Scanner{db, from_key_info.ptr,
+                from_key_info.itemsize*from_key_info.size,
+                filter_info.ptr,
+                filter_info.itemsize*filter_info.size,
+                &options, mode};
+    return result;
+}
+
 template <typename DocType>
 static auto doc_store_helper(const yokan::Collection& coll,
                              const DocType& doc, int32_t mode, double timeout_ms) {
@@ -901,10 +1107,114 @@ PYBIND11_MODULE(pyyokan_client, m) {
                 py::capsule addr_capsule = addr.cast<py::capsule>();
                 return client.makeDatabaseHandle(addr_capsule, provider_id, check);
              },
-             "address"_a, "provider_id"_a, "check"_a=true);
+             "address"_a, "provider_id"_a, "check"_a=true)
+        .def_property("direct_threshold",
+             [](const yokan::Client& client) {
+                return client.directThreshold();
+             },
+             [](const yokan::Client& client, size_t threshold) {
+                client.setDirectThreshold(threshold);
+             })
+        .def("get_stats",
+             [](const yokan::Client& client, bool reset) {
+                return client.getStats(reset);
+             }, "reset"_a=false);
+
+    py::class_<py_scanner>(m, "Scanner")
+        .def("__iter__", [](py_scanner& s) -> py_scanner& { return s; })
+        .def("__next__",
+             [](py_scanner& s) {
+                const void* key;
+                const void* val;
+                size_t ksize, vsize;
+                bool found;
+                {
+                    py::gil_scoped_release release;
+                    found = s.scanner.next(key, ksize, val, vsize);
+                }
+                if(!found) throw py::stop_iteration();
+                py::object k = s.str_keys
+                    ? py::object(py::str((const char*)key, ksize))
+                    : py::object(py::bytes((const char*)key, ksize));
+                py::object v = s.ignore_values
+                    ? py::object(py::none())
+                    : py::object(py::bytes((const char*)val, vsize));
+                return py::make_tuple(k, v);
+             });
+
+    py::class_<yokan::AllocatedBuffer>(m, "AllocatedBuffer", py::buffer_protocol())
+        .def_buffer([](yokan::AllocatedBuffer& b) -> py::buffer_info {
+                return py::buffer_info(
+                    b.data.get(), sizeof(uint8_t),
+                    py::format_descriptor<uint8_t>::format(),
+                    1, { b.size }, { sizeof(uint8_t) });
+             })
+        .def("__len__", [](const yokan::AllocatedBuffer& b) { return b.size; });
 
     py::class_<yokan::Database>(m, "Database")
         // --------------------------------------------------------------
+        // WRITE COMBINING
+        // --------------------------------------------------------------
+        .def("enable_write_combining",
+             [](const yokan::Database& db, size_t max_count,
+                size_t max_size, double max_delay_ms) {
+                yk_write_combining_options_t options;
+                options.max_count    = max_count;
+                options.max_size     = max_size;
+                options.max_delay_ms = max_delay_ms;
+                db.enableWriteCombining(options);
+             }, "max_count"_a=1024, "max_size"_a=1024*1024, "max_delay_ms"_a=10.0)
+        .def("disable_write_combining",
+             [](const yokan::Database& db) {
+                py::gil_scoped_release release;
+                db.disableWriteCombining();
+             })
+        .def("flush",
+             [](const yokan::Database& db) {
+                py::gil_scoped_release release;
+                db.flush();
+             })
+        // --------------------------------------------------------------
+        // READ CACHE
+        // --------------------------------------------------------------
+        .def("enable_read_cache",
+             [](const yokan::Database& db, size_t capacity, double ttl_ms) {
+                yk_read_cache_options_t options;
+                options.capacity = capacity;
+                options.ttl_ms   = ttl_ms;
+                db.enableReadCache(options);
+             }, "capacity"_a=16*1024*1024, "ttl_ms"_a=1000.0)
+        .def("disable_read_cache",
+             [](const yokan::Database& db) {
+                db.disableReadCache();
+             })
+        .def("invalidate_cache",
+             [](const yokan::Database& db, const std::string& key) {
+                db.invalidateCache(key.data(), key.size());
+             }, "key"_a)
+        .def("invalidate_cache",
+             [](const yokan::Database& db, const py::buffer& key) {
+                auto key_info = get_buffer_info(key);
+                CHECK_BUFFER_IS_CONTIGUOUS(key_info);
+                db.invalidateCache(key_info.ptr, key_info.itemsize*key_info.size);
+             }, "key"_a)
+        .def("invalidate_cache",
+             [](const yokan::Database& db) {
+                db.invalidateCache();
+             })
+        .def_property_readonly("read_cache_stats",
+             [](const yokan::Database& db) {
+                return db.readCacheStats();
+             })
+        // --------------------------------------------------------------
+        // GET_STATS
+        // --------------------------------------------------------------
+        .def("get_stats",
+             [](const yokan::Database& db, bool reset) {
+                py::gil_scoped_release release;
+                return db.getStats(reset);
+             }, "reset"_a=false)
+        // --------------------------------------------------------------
         // COUNT
         // --------------------------------------------------------------
         .def("count",
@@ -930,6 +1240,57 @@ PYBIND11_MODULE(pyyokan_client, m) {
                          const std::string&, int32_t, double)>(&put_helper),
              "key"_a, "value"_a, "mode"_a=YOKAN_MODE_DEFAULT, "timeout_ms"_a=0.0)
         // --------------------------------------------------------------
+        // PUT_RANGE
+        // --------------------------------------------------------------
+        .def("put_range",
+             static_cast<void(*)(const yokan::Database&, const py::buffer&,
+                         size_t, const py::buffer&, int32_t, double)>(&put_range_helper),
+             "key"_a, "offset"_a, "value"_a, "mode"_a=YOKAN_MODE_DEFAULT, "timeout_ms"_a=0.0)
+        .def("put_range",
+             static_cast<void(*)(const yokan::Database&, const std::string&,
+                         size_t, const py::buffer&, int32_t, double)>(&put_range_helper),
+             "key"_a, "offset"_a, "value"_a, "mode"_a=YOKAN_MODE_DEFAULT, "timeout_ms"_a=0.0)
+        .def("put_range",
+             static_cast<void(*)(const yokan::Database&, const std::string&,
+                         size_t, const std::string&, int32_t, double)>(&put_range_helper),
+             "key"_a, "offset"_a, "value"_a, "mode"_a=YOKAN_MODE_DEFAULT, "timeout_ms"_a=0.0)
+        // --------------------------------------------------------------
+        // COMPARE_AND_SWAP
+        // --------------------------------------------------------------
+        .def("compare_and_swap",
+             static_cast<bool(*)(const yokan::Database&, const py::buffer&,
+                         const py::buffer&, const py::buffer&, int32_t, double)>(&compare_and_swap_helper),
+             "key"_a, "expected"_a, "value"_a, "mode"_a=YOKAN_MODE_DEFAULT, "timeout_ms"_a=0.0)
+        .def("compare_and_swap",
+             static_cast<bool(*)(const yokan::Database&, const std::string&,
+                         const py::buffer&, const py::buffer&, int32_t, double)>(&compare_and_swap_helper),
+             "key"_a, "expected"_a, "value"_a, "mode"_a=YOKAN_MODE_DEFAULT, "timeout_ms"_a=0.0)
+        .def("compare_and_swap",
+             static_cast<bool(*)(const yokan::Database&, const std::string&,
+                         const std::string&, const std::string&, int32_t, double)>(&compare_and_swap_helper),
+             "key"_a, "expected"_a, "value"_a, "mode"_a=YOKAN_MODE_DEFAULT, "timeout_ms"_a=0.0)
+        // --------------------------------------------------------------
+        // MERGE
+        // --------------------------------------------------------------
+        .def("merge",
+             static_cast<size_t(*)(const yokan::Database&, const py::buffer&,
+                         int32_t, const py::buffer&, size_t, std::optional<py::buffer>,
+                         int32_t, double)>(&merge_helper),
+             "key"_a, "op"_a, "operand"_a, "bound"_a=0, "result"_a=py::none(),
+             "mode"_a=YOKAN_MODE_DEFAULT, "timeout_ms"_a=0.0)
+        .def("merge",
+             static_cast<size_t(*)(const yokan::Database&, const std::string&,
+                         int32_t, const py::buffer&, size_t, std::optional<py::buffer>,
+                         int32_t, double)>(&merge_helper),
+             "key"_a, "op"_a, "operand"_a, "bound"_a=0, "result"_a=py::none(),
+             "mode"_a=YOKAN_MODE_DEFAULT, "timeout_ms"_a=0.0)
+        .def("merge",
+             static_cast<size_t(*)(const yokan::Database&, const std::string&,
+                         int32_t, const std::string&, size_t, std::optional<py::buffer>,
+                         int32_t, double)>(&merge_helper),
+             "key"_a, "op"_a, "operand"_a, "bound"_a=0, "result"_a=py::none(),
+             "mode"_a=YOKAN_MODE_DEFAULT, "timeout_ms"_a=0.0)
+        // --------------------------------------------------------------
         // PUT_MULTI
         // --------------------------------------------------------------
         .def("put_multi",
@@ -950,6 +1311,42 @@ PYBIND11_MODULE(pyyokan_client, m) {
         // --------------------------------------------------------------
         // PUT_PACKED
         // --------------------------------------------------------------
+        .def("put_packed",
+             [](const yokan::Database& db, const py::buffer& keys,
+                const py::buffer& key_sizes,
+                const py::buffer& vals,
+                const py::buffer& val_sizes,
+                int32_t mode, double timeout_ms) {
+                py::buffer_info ksizes_info, vsizes_info;
+                std::vector<size_t> ksizes_copy, vsizes_copy;
+                auto ksizes = get_size_array(key_sizes, ksizes_info, ksizes_copy);
+                auto vsizes = get_size_array(val_sizes, vsizes_info, vsizes_copy);
+                size_t count = ksizes.second;
+                if(count != vsizes.second) {
+                    throw std::length_error("key_sizes and value_sizes should have the same length");
+                }
+                auto key_info = keys.request();
+                auto val_info = vals.request();
+                CHECK_BUFFER_IS_CONTIGUOUS(key_info);
+                CHECK_BUFFER_IS_CONTIGUOUS(val_info);
+                auto total_key_size = std::accumulate(ksizes.first, ksizes.first + count, (size_t)0);
+                auto total_val_size = std::accumulate(vsizes.first, vsizes.first + count, (size_t)0);
+                if((ssize_t)total_key_size > key_info.itemsize*key_info.size) {
+                    throw std::length_error("keys buffer is smaller than accumulated key_sizes");
+                }
+                if((ssize_t)total_val_size > val_info.itemsize*val_info.size) {
+                    throw std::length_error("values buffer is smaller than accumulated value_sizes");
+                }
+                py::gil_scoped_release release;
+                if (timeout_ms > 0.0)
+                    db.putPacked(count, key_info.ptr, ksizes.first,
+                                 val_info.ptr, vsizes.first,
+                                 mode, yokan::Timeout{timeout_ms});
+                else
+                    db.putPacked(count, key_info.ptr, ksizes.first,
+                                 val_info.ptr, vsizes.first, mode);
+             }, "keys"_a, "key_sizes"_a, "values"_a, "value_sizes"_a,
+                "mode"_a=YOKAN_MODE_DEFAULT, "timeout_ms"_a=0.0)
         .def("put_packed",
              [](const yokan::Database& db, const py::buffer& keys,
                 const std::vector<size_t> key_sizes,
@@ -1001,6 +1398,28 @@ PYBIND11_MODULE(pyyokan_client, m) {
                 py::buffer&, int32_t, double)>(&get_helper),
              "key"_a, "value"_a, "mode"_a=YOKAN_MODE_DEFAULT, "timeout_ms"_a=0.0)
         // --------------------------------------------------------------
+        // GET_RANGE
+        // --------------------------------------------------------------
+        .def("get_range",
+             static_cast<size_t(*)(const yokan::Database&, const py::buffer&,
+                size_t, py::buffer&, int32_t, double)>(&get_range_helper),
+             "key"_a, "offset"_a, "value"_a, "mode"_a=YOKAN_MODE_DEFAULT, "timeout_ms"_a=0.0)
+        .def("get_range",
+             static_cast<size_t(*)(const yokan::Database&, const std::string&,
+                size_t, py::buffer&, int32_t, double)>(&get_range_helper),
+             "key"_a, "offset"_a, "value"_a, "mode"_a=YOKAN_MODE_DEFAULT, "timeout_ms"_a=0.0)
+        // --------------------------------------------------------------
+        // GET_ALLOC
+        // --------------------------------------------------------------
+        .def("get_alloc",
+             static_cast<yokan::AllocatedBuffer(*)(const yokan::Database&,
+                const py::buffer&, int32_t, double)>(&get_alloc_helper),
+             "key"_a, "mode"_a=YOKAN_MODE_DEFAULT, "timeout_ms"_a=0.0)
+        .def("get_alloc",
+             static_cast<yokan::AllocatedBuffer(*)(const yokan::Database&,
+                const std::string&, int32_t, double)>(&get_alloc_helper),
+             "key"_a, "mode"_a=YOKAN_MODE_DEFAULT, "timeout_ms"_a=0.0)
+        // --------------------------------------------------------------
         // GET_MULTI
         // --------------------------------------------------------------
         .def("get_multi",
@@ -1016,6 +1435,37 @@ PYBIND11_MODULE(pyyokan_client, m) {
         // --------------------------------------------------------------
         // GET_PACKED
         // --------------------------------------------------------------
+        .def("get_packed",
+             [](const yokan::Database& db, const py::buffer& keys,
+                const py::buffer& key_sizes,
+                py::buffer& vals,
+                py::buffer& val_sizes,
+                int32_t mode, double timeout_ms) {
+                py::buffer_info ksizes_info, vsizes_info;
+                std::vector<size_t> ksizes_copy;
+                auto ksizes = get_size_array(key_sizes, ksizes_info, ksizes_copy);
+                size_t count = ksizes.second;
+                auto vsizes = get_output_size_array(val_sizes, vsizes_info, count);
+                auto key_info = keys.request();
+                auto val_info = vals.request();
+                CHECK_BUFFER_IS_CONTIGUOUS(key_info);
+                CHECK_BUFFER_IS_CONTIGUOUS(val_info);
+                CHECK_BUFFER_IS_WRITABLE(val_info);
+                auto total_key_size = std::accumulate(ksizes.first, ksizes.first + count, (size_t)0);
+                if((ssize_t)total_key_size > key_info.itemsize*key_info.size) {
+                    throw std::length_error("keys buffer size smaller than accumulated key_sizes");
+                }
+                size_t vbuf_size = (size_t)(val_info.itemsize*val_info.size);
+                py::gil_scoped_release release;
+                if (timeout_ms > 0.0)
+                    db.getPacked(count, key_info.ptr, ksizes.first,
+                                 vbuf_size, val_info.ptr, vsizes,
+                                 mode, yokan::Timeout{timeout_ms});
+                else
+                    db.getPacked(count, key_info.ptr, ksizes.first,
+                                 vbuf_size, val_info.ptr, vsizes, mode);
+             }, "keys"_a, "key_sizes"_a, "values"_a, "value_sizes"_a,
+                "mode"_a=YOKAN_MODE_DEFAULT, "timeout_ms"_a=0.0)
         .def("get_packed",
              [](const yokan::Database& db, const py::buffer& keys,
                 const std::vector<size_t>& key_sizes,
@@ -1354,6 +1804,31 @@ PYBIND11_MODULE(pyyokan_client, m) {
         // --------------------------------------------------------------
         // LENGTH_PACKED
         // --------------------------------------------------------------
+        .def("length_packed",
+             [](const yokan::Database& db, const py::buffer& keys,
+                const py::buffer& key_sizes,
+                py::buffer& val_sizes,
+                int32_t mode, double timeout_ms) {
+                py::buffer_info ksizes_info, vsizes_info;
+                std::vector<size_t> ksizes_copy;
+                auto ksizes = get_size_array(key_sizes, ksizes_info, ksizes_copy);
+                size_t count = ksizes.second;
+                auto vsizes = get_output_size_array(val_sizes, vsizes_info, count);
+                auto key_info = keys.request();
+                CHECK_BUFFER_IS_CONTIGUOUS(key_info);
+                auto total_key_size = std::accumulate(ksizes.first, ksizes.first + count, (size_t)0);
+                if((ssize_t)total_key_size > key_info.itemsize*key_info.size) {
+                    throw std::length_error("keys buffer size smaller than accumulated key_sizes");
+                }
+                py::gil_scoped_release release;
+                if (timeout_ms > 0.0)
+                    db.lengthPacked(count, key_info.ptr, ksizes.first,
+                                    vsizes, mode, yokan::Timeout{timeout_ms});
+                else
+                    db.lengthPacked(count, key_info.ptr, ksizes.first,
+                                    vsizes, mode);
+             }, "keys"_a, "key_sizes"_a, "value_sizes"_a,
+                "mode"_a=YOKAN_MODE_DEFAULT, "timeout_ms"_a=0.0)
         .def("length_packed",
              [](const yokan::Database& db, const py::buffer& keys,
                 const std::vector<size_t>& key_sizes,
@@ -1411,6 +1886,28 @@ PYBIND11_MODULE(pyyokan_client, m) {
         // --------------------------------------------------------------
         // ERASE_PACKED
         // --------------------------------------------------------------
+        .def("erase_packed",
+             [](const yokan::Database& db, const py::buffer& keys,
+                const py::buffer& key_sizes,
+                int32_t mode, double timeout_ms) {
+                py::buffer_info ksizes_info;
+                std::vector<size_t> ksizes_copy;
+                auto ksizes = get_size_array(key_sizes, ksizes_info, ksizes_copy);
+                size_t count = ksizes.second;
+                auto key_info = keys.request();
+                CHECK_BUFFER_IS_CONTIGUOUS(key_info);
+                auto total_key_size = std::accumulate(ksizes.first, ksizes.first + count, (size_t)0);
+                if((ssize_t)total_key_size > key_info.itemsize*key_info.size) {
+                    throw std::length_error("keys buffer size smaller than accumulated key_sizes");
+                }
+                py::gil_scoped_release release;
+                if (timeout_ms > 0.0)
+                    db.erasePacked(count, key_info.ptr, ksizes.first,
+                                   mode, yokan::Timeout{timeout_ms});
+                else
+                    db.erasePacked(count, key_info.ptr, ksizes.first, mode);
+             }, "keys"_a, "key_sizes"_a,
+                "mode"_a=YOKAN_MODE_DEFAULT, "timeout_ms"_a=0.0)
         .def("erase_packed",
              [](const yokan::Database& db, const py::buffer& keys,
                 const std::vector<size_t>& key_sizes,
@@ -1635,6 +2132,45 @@ PYBIND11_MODULE(pyyokan_client, m) {
              "mode"_a=YOKAN_MODE_DEFAULT, "batch_size"_a=0, "ignore_values"_a=false,
              "timeout_ms"_a=0.0)
         // --------------------------------------------------------------
+        // SCAN
+        // --------------------------------------------------------------
+        .def("scan",
+             static_cast<std::unique_ptr<py_scanner>(*)(
+                const yokan::Database&,
+                const py::buffer&, const py::buffer&,
+                int32_t, size_t, size_t, size_t, unsigned, bool, double)>(&scan_helper),
+             "from_key"_a=py::bytes{}, "filter"_a=py::bytes{},
+             "mode"_a=YOKAN_MODE_DEFAULT, "batch_size"_a=0, "buffer_size"_a=0,
+             "max_buffer_size"_a=0, "depth"_a=0, "ignore_values"_a=false,
+             "timeout_ms"_a=0.0)
+        .def("scan",
+             static_cast<std::unique_ptr<py_scanner>(*)(
+                const yokan::Database&,
+                const py::buffer&, const std::string&,
+                int32_t, size_t, size_t, size_t, unsigned, bool, double)>(&scan_helper),
+             "from_key"_a=py::bytes{}, "filter"_a=std::string{},
+             "mode"_a=YOKAN_MODE_DEFAULT, "batch_size"_a=0, "buffer_size"_a=0,
+             "max_buffer_size"_a=0, "depth"_a=0, "ignore_values"_a=false,
+             "timeout_ms"_a=0.0)
+        .def("scan",
+             static_cast<std::unique_ptr<py_scanner>(*)(
+                const yokan::Database&,
+                const std::string&, const py::buffer&,
+                int32_t, size_t, size_t, size_t, unsigned, bool, double)>(&scan_helper),
+             "from_key"_a=std::string{}, "filter"_a=py::bytes{},
+             "mode"_a=YOKAN_MODE_DEFAULT, "batch_size"_a=0, "buffer_size"_a=0,
+             "max_buffer_size"_a=0, "depth"_a=0, "ignore_values"_a=false,
+             "timeout_ms"_a=0.0)
+        .def("scan",
+             static_cast<std::unique_ptr<py_scanner>(*)(
+                const yokan::Database&,
+                const std::string&, const std::string&,
+                int32_t, size_t, size_t, size_t, unsigned, bool, double)>(&scan_helper),
+             "from_key"_a=std::string{}, "filter"_a=std::string{},
+             "mode"_a=YOKAN_MODE_DEFAULT, "batch_size"_a=0, "buffer_size"_a=0,
+             "max_buffer_size"_a=0, "depth"_a=0, "ignore_values"_a=false,
+             "timeout_ms"_a=0.0)
+        // --------------------------------------------------------------
         // COLLECTION MANAGEMENT
         // --------------------------------------------------------------
         .def("create_collection",
@@ -55,6 +55,14 @@ class Exception(RuntimeError):
     m.attr("YOKAN_MODE_LIB_FILTER")   = YOKAN_MODE_LIB_FILTER;
     m.attr("YOKAN_MODE_NO_RDMA")      = YOKAN_MODE_NO_RDMA;
 
+    m.attr("YOKAN_MERGE_ADD_INT64")   = YOKAN_MERGE_ADD_INT64;
+    m.attr("YOKAN_MERGE_MAX_INT64")   = YOKAN_MERGE_MAX_INT64;
+    m.attr("YOKAN_MERGE_BIT_OR")      = YOKAN_MERGE_BIT_OR;
+    m.attr("YOKAN_MERGE_APPEND")      = YOKAN_MERGE_APPEND;
+
+    m.attr("YOKAN_KEY_NOT_FOUND")     = static_cast<size_t>(YOKAN_KEY_NOT_FOUND);
+    m.attr("YOKAN_SIZE_TOO_SMALL")    = static_cast<size_t>(YOKAN_SIZE_TOO_SMALL);
+
     m.attr("YOKAN_SUCCESS")               = static_cast<int>(YOKAN_SUCCESS);
     m.attr("YOKAN_ERR_ALLOCATION")        = static_cast<int>(YOKAN_ERR_ALLOCATION);
     m.attr("YOKAN_ERR_INVALID_MID")       = static_cast<int>(YOKAN_ERR_INVALID_MID);
@@ -36,5 +36,8 @@ PYBIND11_MODULE(pyyokan_server, m) {
 
             // Create provider
             return new yokan::Provider(mid_capsule, provider_id, config);
-        }), "engine"_a, "provider_id"_a, "config"_a);
+        }), "engine"_a, "provider_id"_a, "config"_a)
+        .def("get_config", &yokan::Provider::getConfig)
+        .def("get_stats", &yokan::Provider::getStats, "reset"_a=false)
+        .def("get_trace", &yokan::Provider::getTrace, "clear"_a=false);
 }
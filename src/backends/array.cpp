@@ -42,8 +42,16 @@ class ArrayDatabase : public DatabaseInterface {
         }
 
         ~Collection() {
-            if(m_lock != ABT_RWLOCK_NULL)
+            if(m_lock != ABT_RWLOCK_NULL) {
+                YOKAN_UNPROFILE_LOCK(m_lock);
                 ABT_rwlock_free(&m_lock);
+            }
+        }
+
+        void profileLock(const DatabaseInterface* owner, const std::string& name) {
+            (void)owner;
+            (void)name;
+            YOKAN_PROFILE_LOCK(m_lock, owner, "collection:" + name);
         }
     };
 
@@ -105,6 +113,7 @@ class ArrayDatabase : public DatabaseInterface {
             // create collection
             auto p = db->m_collections.emplace(name, db->m_lock != ABT_RWLOCK_NULL);
             auto& coll = p.first->second;
+            coll.profileLock(db, name);
             size_t doc_offset = 0;
             // read the documents
             for(size_t j = 0; j < coll_size; ++j) {
@@ -137,6 +146,31 @@ class ArrayDatabase : public DatabaseInterface {
     }
     // LCOV_EXCL_STOP
 
+    virtual std::string stats() const override {
+        ScopedReadLock lock(m_lock);
+        json collections = json::object();
+        size_t entries = 0, memory = 0;
+        for(auto& p : m_collections) {
+            auto& coll = p.second;
+            ScopedReadLock coll_lock(coll.m_lock);
+            auto coll_memory = coll.m_data.capacity()
+                             + (coll.m_offsets.capacity() + coll.m_sizes.capacity())*sizeof(size_t);
+            collections[p.first] = {
+                {"entries", coll.m_count},
+                {"ids",     coll.m_sizes.size()},
+                {"bytes",   coll.m_data.size()},
+                {"memory",  coll_memory}
+            };
+            entries += coll.m_count;
+            memory  += coll_memory;
+        }
+        return json{
+            {"entries",     entries},
+            {"memory",      memory},
+            {"collections", collections}
+        }.dump();
+    }
+
     virtual bool supportsMode(int32_t mode) const override {
         return mode ==
             (mode & (
@@ -164,7 +198,8 @@ class ArrayDatabase : public DatabaseInterface {
         ScopedWriteLock lock(m_lock);
         if(m_collections.count(name))
             return Status::KeyExists;
-        m_collections.emplace(name, m_lock != ABT_RWLOCK_NULL);
+        auto p = m_collections.emplace(name, m_lock != ABT_RWLOCK_NULL);
+        p.first->second.profileLock(this, name);
         return Status::OK;
     }
 
@@ -610,8 +645,10 @@ class ArrayDatabase : public DatabaseInterface {
     }
 
     ~ArrayDatabase() {
-        if(m_lock != ABT_RWLOCK_NULL)
+        if(m_lock != ABT_RWLOCK_NULL) {
+            YOKAN_UNPROFILE_LOCK(m_lock);
             ABT_rwlock_free(&m_lock);
+        }
     }
 
     private:
@@ -619,8 +656,10 @@ class ArrayDatabase : public DatabaseInterface {
     ArrayDatabase(json cfg)
     : m_config(std::move(cfg))
     {
-        if(m_config["use_lock"].get<bool>())
+        if(m_config["use_lock"].get<bool>()) {
             ABT_rwlock_create(&m_lock);
+            YOKAN_PROFILE_LOCK(m_lock, this, "db");
+        }
     }
 
     std::unordered_map<std::string, Collection> m_collections;
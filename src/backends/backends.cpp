@@ -5,6 +5,7 @@
  */
 #include "yokan/backend.hpp"
 #include "yokan/filters.hpp"
+#include <algorithm>
 #include <cstring>
 #include <vector>
 #include <memory>
@@ -136,4 +137,55 @@ Status DatabaseInterface::eraseRange(int32_t mode, const UserMem& prefix)
     }
 }
 
+Status DatabaseInterface::getRange(int32_t mode, const UserMem& key,
+                                   size_t offset, UserMem& data)
+{
+    int32_t op_mode = mode & ~YOKAN_MODE_EXTRA;
+    size_t ksize = key.size;
+    BasicUserMem<size_t> ksizes{ &ksize, 1 };
+    size_t read = 0;
+    auto status = fetch(op_mode, key, ksizes,
+        [&](const UserMem&, const UserMem& val) {
+            if(val.size == KeyNotFound) return Status::NotFound;
+            if(offset < val.size) {
+                read = std::min(data.size, val.size - offset);
+                std::memcpy(data.data, val.data + offset, read);
+            }
+            return Status::OK;
+        });
+    if(status != Status::OK) return status;
+    data.size = read;
+    return Status::OK;
+}
+
+Status DatabaseInterface::putRange(int32_t mode, const UserMem& key,
+                                   size_t offset, const UserMem& data)
+{
+    int32_t op_mode = mode & ~YOKAN_MODE_EXTRA;
+    size_t ksize = key.size;
+    BasicUserMem<size_t> ksizes{ &ksize, 1 };
+    bool found = false;
+    std::vector<char> value;
+    auto status = fetch(0, key, ksizes,
+        [&](const UserMem&, const UserMem& val) {
+            if(val.size == KeyNotFound) return Status::OK;
+            found = true;
+            value.assign(val.data, val.data + val.size);
+            return Status::OK;
+        });
+    if(status != Status::OK) return status;
+    if(!found && (op_mode & YOKAN_MODE_EXIST_ONLY)) return Status::NotFound;
+    if(found && (op_mode & YOKAN_MODE_NEW_ONLY)) return Status::KeyExists;
+
+    if(value.size() < offset + data.size)
+        value.resize(offset + data.size, 0);
+    if(data.size) std::memcpy(value.data() + offset, data.data, data.size);
+
+    size_t vsize = value.size();
+    BasicUserMem<size_t> vsizes{ &vsize, 1 };
+    UserMem vals{ value.data(), value.size() };
+    op_mode &= ~(YOKAN_MODE_NEW_ONLY|YOKAN_MODE_EXIST_ONLY|YOKAN_MODE_APPEND);
+    return put(op_mode, key, ksizes, vals, vsizes);
+}
+
 }
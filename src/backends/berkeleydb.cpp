@@ -5,6 +5,7 @@
  */
 #include "yokan/backend.hpp"
 #include "yokan/doc-mixin.hpp"
+#include "yokan/util/locks.hpp"
 #include "../common/linker.hpp"
 #include "../common/allocator.hpp"
 #include "../common/modes.hpp"
@@ -16,6 +17,9 @@
 #include <string>
 #include <cstring>
 #include <iostream>
+#include <memory>
+#include <algorithm>
+#include <unordered_map>
 #ifdef YOKAN_USE_STD_FILESYSTEM
 #include <filesystem>
 #else
@@ -51,6 +55,92 @@ static inline Status convertStatus(int bdb_status) {
     return Status::Other;
 }
 
+/**
+ * @brief Wrapper around a cursor that retrieves key/value pairs in
+ * batches using DB_MULTIPLE_KEY and returns them one at a time.
+ * The first call to next() behaves like a DB_CURRENT get, subsequent
+ * calls like a DB_NEXT get. The key and value returned point into the
+ * bulk buffer and remain valid until the next call to next().
+ *
+ * BerkeleyDB does not allow partial DBTs in bulk gets, so a reader
+ * created with keys_only = true instead steps through the cursor one
+ * key at a time with a zero-length partial value, which does not read
+ * the values at all, and returns empty values.
+ */
+class BulkCursorReader {
+
+    public:
+
+    BulkCursorReader(Dbc* cursor, size_t buffer_size, bool keys_only = false)
+    : m_cursor(cursor)
+    , m_keys_only(keys_only) {
+        m_key.set_flags(DB_DBT_REALLOC);
+        m_empty_val.set_ulen(0);
+        m_empty_val.set_dlen(0);
+        m_empty_val.set_flags(DB_DBT_USERMEM|DB_DBT_PARTIAL);
+        if(!m_keys_only) resizeBulk(buffer_size);
+    }
+
+    ~BulkCursorReader() {
+        free(m_key.get_data());
+    }
+
+    int next(Dbt& key, Dbt& val) {
+        if(m_keys_only) {
+            int status = m_cursor->get(&m_key, &m_empty_val, m_flag);
+            m_flag = DB_NEXT;
+            if(status != 0) return status;
+            key.set_data(m_key.get_data());
+            key.set_size(m_key.get_size());
+            val.set_data(nullptr);
+            val.set_size(0);
+            return 0;
+        }
+        while(true) {
+            if(m_iterator && m_iterator->next(key, val))
+                return 0;
+            m_iterator.reset();
+            int status = m_cursor->get(&m_key, &m_bulk, m_flag | DB_MULTIPLE_KEY);
+            if(status == DB_BUFFER_SMALL) {
+                // the next pair does not fit in the buffer, grow it and retry
+                resizeBulk(m_bulk.get_size());
+                continue;
+            }
+            m_flag = DB_NEXT;
+            if(status != 0) return status;
+            m_iterator = std::make_unique<DbMultipleKeyDataIterator>(m_bulk);
+        }
+    }
+
+    /* BerkeleyDB requires bulk buffers to be a multiple of 1024 bytes
+     * and at least as large as the database's page size (at most 64KB). */
+    static size_t roundBufferSize(size_t size) {
+        size = std::max<size_t>(size, 64*1024);
+        return ((size + 1023)/1024)*1024;
+    }
+
+    private:
+
+    /* The buffer is left uninitialized, BerkeleyDB only reads
+     * what it has written into it. */
+    void resizeBulk(size_t size) {
+        size = roundBufferSize(size);
+        m_buffer.reset(new char[size]);
+        m_bulk.set_data(m_buffer.get());
+        m_bulk.set_ulen(size);
+        m_bulk.set_flags(DB_DBT_USERMEM);
+    }
+
+    Dbc*                                       m_cursor;
+    bool                                       m_keys_only;
+    std::unique_ptr<char[]>                    m_buffer;
+    Dbt                                        m_key;
+    Dbt                                        m_bulk;
+    Dbt                                        m_empty_val;
+    std::unique_ptr<DbMultipleKeyDataIterator> m_iterator;
+    uint32_t                                   m_flag = DB_CURRENT;
+};
+
 class BerkeleyDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
 
     public:
@@ -88,6 +178,12 @@ class BerkeleyDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
             CHECK_TYPE_AND_SET_DEFAULT(cfg, "home", string, "");
             CHECK_TYPE_AND_SET_DEFAULT(cfg, "path", string, "");
             CHECK_TYPE_AND_SET_DEFAULT(cfg, "name", string, "");
+            CHECK_TYPE_AND_SET_DEFAULT(cfg, "cache_size", number_unsigned, 0);
+            CHECK_TYPE_AND_SET_DEFAULT(cfg, "mmap_size", number_unsigned, 0);
+            CHECK_TYPE_AND_SET_DEFAULT(cfg, "shared_env", boolean, false);
+            CHECK_TYPE_AND_SET_DEFAULT(cfg, "bulk_buffer_size", number_unsigned, 1024*1024);
+            cfg["bulk_buffer_size"] = BulkCursorReader::roundBufferSize(
+                cfg["bulk_buffer_size"].get<size_t>());
 
         } catch(...) {
             return Status::InvalidConf;
@@ -96,16 +192,10 @@ class BerkeleyDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
         auto db_name = cfg["name"].get<std::string>();
         auto db_home = cfg["home"].get<std::string>();
         if(!db_home.empty()) db_home += "/yokan";
+        auto shared_env = cfg["shared_env"].get<bool>();
+        if(shared_env && db_home.empty())
+            return Status::InvalidConf;
 
-        uint32_t db_env_flags =
-                DB_CREATE     |
-                DB_PRIVATE    |
-                DB_RECOVER    |
-                DB_INIT_LOCK  |
-                DB_INIT_LOG   |
-                DB_INIT_TXN   |
-                DB_THREAD     |
-                DB_INIT_MPOOL;
         uint32_t db_flags = 0;
         if(cfg["create_if_missing"].get<bool>()) {
            db_flags |= DB_CREATE;
@@ -120,8 +210,8 @@ class BerkeleyDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
             fs::create_directories(path, ec);
         }
 
-        auto db_env = new DbEnv(DB_CXX_NO_EXCEPTIONS);
-        int status = db_env->open(db_home.empty() ? nullptr : db_home.c_str(), db_env_flags, 0);
+        DbEnv* db_env = nullptr;
+        int status = acquireEnv(db_home, cfg, &db_env);
         if(status != 0)
             return convertStatus(status);
         auto db = new Db(db_env, 0);
@@ -129,8 +219,9 @@ class BerkeleyDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
                           db_name.empty() ? nullptr : db_name.c_str(),
                           db_type, db_flags, 0);
         if(status != 0) {
-            db_env->close(0);
-            delete db_env;
+            db->close(0);
+            delete db;
+            releaseEnv(db_home, shared_env, db_env);
             return convertStatus(status);
         }
 
@@ -150,6 +241,41 @@ class BerkeleyDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
     }
     // LCOV_EXCL_STOP
 
+    virtual std::string stats() const override {
+        json result = json::object();
+        // note: like count(), the number of keys is an estimate
+        if(m_db_type == DB_BTREE) {
+            DB_BTREE_STAT* bt_stats = nullptr;
+            if(m_db->stat(nullptr, &bt_stats, DB_FAST_STAT) == 0 && bt_stats) {
+                result["entries"]    = bt_stats->bt_nkeys;
+                result["page_size"]  = bt_stats->bt_pagesize;
+                free(bt_stats);
+            }
+        } else if(m_db_type == DB_HASH) {
+            DB_HASH_STAT* hash_stats = nullptr;
+            if(m_db->stat(nullptr, &hash_stats, DB_FAST_STAT) == 0 && hash_stats) {
+                result["entries"]    = hash_stats->hash_nkeys;
+                result["page_size"]  = hash_stats->hash_pagesize;
+                free(hash_stats);
+            }
+        }
+        DB_MPOOL_STAT* mp_stats = nullptr;
+        if(m_db_env && m_db_env->memp_stat(&mp_stats, nullptr, 0) == 0 && mp_stats) {
+            auto hits   = (uint64_t)mp_stats->st_cache_hit;
+            auto misses = (uint64_t)mp_stats->st_cache_miss;
+            result["memory"] = (uint64_t)mp_stats->st_gbytes*(1ull << 30) + mp_stats->st_bytes;
+            result["cache"] = {
+                {"hits",     hits},
+                {"misses",   misses},
+                {"hit_rate", hits + misses ? (double)hits/(hits + misses) : 0.0},
+                {"pages",    (uint64_t)mp_stats->st_pages},
+                {"dirty",    (uint64_t)mp_stats->st_page_dirty}
+            };
+            free(mp_stats);
+        }
+        return result.dump();
+    }
+
     virtual bool supportsMode(int32_t mode) const override {
         return mode ==
             (mode & (
@@ -192,12 +318,19 @@ class BerkeleyDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
         delete m_db;
         m_db = nullptr;
 
-        m_db_env->close(0);
-        delete m_db_env;
+        if(m_shared_env) {
+            // other databases may still be using the environment,
+            // only remove this database's file from it
+            m_db_env->dbremove(nullptr, db_path.empty() ? nullptr : db_path.c_str(),
+                               db_name.empty() ? nullptr : db_name.c_str(), 0);
+        }
+        bool env_closed = releaseEnv(db_home, m_shared_env, m_db_env);
         m_db_env = nullptr;
 
         std::error_code ec;
-        if(!db_home.empty()) fs::remove_all(db_home, ec);
+        if(!db_home.empty()) {
+            if(env_closed) fs::remove_all(db_home, ec);
+        }
         else fs::remove_all(db_path, ec);
         // TODO log error if necessary
     }
@@ -479,7 +612,6 @@ complete:
         size_t i = 0;
         size_t key_offset = 0;
         bool key_buf_too_small = false;
-        uint32_t flag = DB_CURRENT;
 
         auto ret = Status::OK;
 
@@ -487,8 +619,9 @@ complete:
         fromKeySlice.set_flags(DB_DBT_USERMEM);
         fromKeySlice.set_ulen(fromKey.size);
 
-        auto key = Dbt{ nullptr, 0};
-        key.set_flags(DB_DBT_REALLOC);
+        // key and value returned by the bulk reader
+        auto key = Dbt{ nullptr, 0 };
+        auto val = Dbt{ nullptr, 0 };
 
         // dummy key used to move the cursor
         auto dummy_key = Dbt{ nullptr, 0 };
@@ -496,26 +629,17 @@ complete:
         dummy_key.set_dlen(0);
         dummy_key.set_flags(DB_DBT_USERMEM|DB_DBT_PARTIAL);
 
-        // dummy value to prevent berkeleydb from reading values,
-        // or actual reallocatable value if the filter needs the value.
+        // dummy value to prevent berkeleydb from reading values
+        // while positioning the cursor
         auto dummy_val = Dbt{ nullptr, 0 };
         dummy_val.set_ulen(0);
         dummy_val.set_dlen(0);
         dummy_val.set_flags(DB_DBT_USERMEM|DB_DBT_PARTIAL);
 
-        // if the filter requires a value, we need somewhere to store it.
-        auto val = Dbt{ nullptr, 0 };
-        if(filter->requiresValue()) {
-            val.set_flags(DB_DBT_REALLOC);
-        } else {
-            val.set_ulen(0);
-            val.set_dlen(0);
-            val.set_flags(DB_DBT_USERMEM|DB_DBT_PARTIAL);
-        }
-
-
         Dbc* cursor = nullptr;
         int status = m_db->cursor(nullptr, &cursor, 0);
+        // the values are only read if the filter needs them
+        BulkCursorReader reader{cursor, m_bulk_buffer_size, !filter->requiresValue()};
 
         if(fromKey.size == 0) {
             // move the cursor to the beginning of the database
@@ -551,8 +675,7 @@ complete:
 
             // find the next key that matches the filter
             while(true) {
-                status = cursor->get(&key, &val, flag);
-                flag = DB_NEXT;
+                status = reader.next(key, val);
                 if(status == DB_NOTFOUND) {
                     goto complete;
                 }
@@ -594,8 +717,6 @@ complete:
                 keySizes[i] = YOKAN_NO_MORE_KEYS;
             }
         }
-        free(key.get_data());
-        free(val.get_data());
         cursor->close();
 
         return ret;
@@ -620,7 +741,6 @@ complete:
         size_t val_offset = 0;
         bool key_buf_too_small = false;
         bool val_buf_too_small = false;
-        uint32_t flag = DB_CURRENT;
         auto ret = Status::OK;
 
         auto fromKeySlice = Dbt{ fromKey.data, (u_int32_t)fromKey.size };
@@ -637,16 +757,15 @@ complete:
         dummy_val.set_dlen(0);
         dummy_val.set_flags(DB_DBT_USERMEM|DB_DBT_PARTIAL);
 
-        // Dbt key used to retrieve actual keys
+        // key and value returned by the bulk reader
         auto key = Dbt{ nullptr, 0 };
-        key.set_flags(DB_DBT_REALLOC);
-
-        // Dbt val used to retrieve actual values
         auto val = Dbt{ nullptr, 0 };
-        val.set_flags(DB_DBT_REALLOC);
 
         Dbc* cursor = nullptr;
         int status = m_db->cursor(nullptr, &cursor, 0);
+        // no need for a buffer much larger than what the caller can receive
+        BulkCursorReader reader{cursor,
+            std::min(m_bulk_buffer_size, keys.size + vals.size + 4*sizeof(uint32_t)*max)};
 
         if(fromKey.size == 0) {
             // move the cursor to the beginning of the database
@@ -682,8 +801,7 @@ complete:
 
             // find the next key that matches the filter
             while(true) {
-                status = cursor->get(&key, &val, flag);
-                flag = DB_NEXT;
+                status = reader.next(key, val);
                 if(status == DB_NOTFOUND) {
                     goto complete;
                 }
@@ -757,8 +875,6 @@ complete:
                 valSizes[i] = YOKAN_NO_MORE_KEYS;
             }
         }
-        free(key.get_data());
-        free(val.get_data());
         cursor->close();
 
         return ret;
@@ -774,7 +890,6 @@ complete:
         auto inclusive = mode & YOKAN_MODE_INCLUSIVE;
 
         size_t i = 0;
-        uint32_t flag = DB_CURRENT;
         auto ret = Status::OK;
 
         auto fromKeySlice = Dbt{ fromKey.data, (u_int32_t)fromKey.size };
@@ -791,16 +906,14 @@ complete:
         dummy_val.set_dlen(0);
         dummy_val.set_flags(DB_DBT_USERMEM|DB_DBT_PARTIAL);
 
-        // Dbt key used to retrieve actual keys
+        // key and value returned by the bulk reader
         auto key = Dbt{ nullptr, 0 };
-        key.set_flags(DB_DBT_REALLOC);
-
-        // Dbt val used to retrieve actual values
         auto val = Dbt{ nullptr, 0 };
-        val.set_flags(DB_DBT_REALLOC);
 
         Dbc* cursor = nullptr;
         int status = m_db->cursor(nullptr, &cursor, 0);
+        BulkCursorReader reader{cursor, m_bulk_buffer_size,
+            ignore_values && !filter->requiresValue()};
 
         if(fromKey.size == 0) {
             // move the cursor to the beginning of the database
@@ -835,11 +948,7 @@ complete:
         for(i = 0; (max == 0 || i < max); i++) {
             // find the next key that matches the filter
             while(true) {
-                if(ignore_values && !filter->requiresValue())
-                    status = cursor->get(&key, &dummy_val, flag);
-                else
-                    status = cursor->get(&key, &val, flag);
-                flag = DB_NEXT;
+                status = reader.next(key, val);
                 if(status == DB_NOTFOUND) {
                     goto complete;
                 }
@@ -855,6 +964,7 @@ complete:
 
             auto key_umem = UserMem{(char*)key.get_data(), key.get_size()};
             auto val_umem = UserMem{(char*)val.get_data(), val.get_size()};
+            if(ignore_values) val_umem = UserMem{nullptr, 0};
 
             auto s = func(key_umem, val_umem);
             if(s != Status::OK) {
@@ -865,8 +975,6 @@ complete:
 
         complete:
 
-        free(key.get_data());
-        free(val.get_data());
         cursor->close();
 
         return ret;
@@ -878,8 +986,8 @@ complete:
             delete m_db;
         }
         if(m_db_env) {
-            m_db_env->close(0);
-            delete m_db_env;
+            auto db_home = m_config["home"].get<std::string>() + "/yokan";
+            releaseEnv(db_home, m_shared_env, m_db_env);
         }
     }
 
@@ -891,6 +999,8 @@ complete:
     Db*         m_db = nullptr;
     std::string m_name;
     bool        m_is_sorted;
+    bool        m_shared_env;
+    size_t      m_bulk_buffer_size;
 
     BerkeleyDBDatabase(json cfg, int db_type, DbEnv* env, Db* db)
     : m_config(std::move(cfg))
@@ -900,6 +1010,95 @@ complete:
         auto disable_doc_mixin_lock = m_config.value("disable_doc_mixin_lock", false);
         if(disable_doc_mixin_lock) disableDocMixinLock();
         m_is_sorted = m_config["type"] == "btree";
+        m_shared_env = m_config["shared_env"].get<bool>();
+        m_bulk_buffer_size = m_config["bulk_buffer_size"].get<size_t>();
+    }
+
+    static int openEnv(const std::string& db_home, const json& cfg, DbEnv** env) {
+        uint32_t db_env_flags =
+                DB_CREATE     |
+                DB_PRIVATE    |
+                DB_RECOVER    |
+                DB_INIT_LOCK  |
+                DB_INIT_LOG   |
+                DB_INIT_TXN   |
+                DB_THREAD     |
+                DB_INIT_MPOOL;
+        auto db_env = new DbEnv(DB_CXX_NO_EXCEPTIONS);
+        int status = 0;
+        auto cache_size = cfg["cache_size"].get<uint64_t>();
+        if(cache_size) {
+            constexpr uint64_t GiB = 1024*1024*1024;
+            status = db_env->set_cachesize(
+                (u_int32_t)(cache_size / GiB), (u_int32_t)(cache_size % GiB), 1);
+        }
+        auto mmap_size = cfg["mmap_size"].get<size_t>();
+        if(status == 0 && mmap_size)
+            status = db_env->set_mp_mmapsize(mmap_size);
+        if(status == 0)
+            status = db_env->open(db_home.empty() ? nullptr : db_home.c_str(), db_env_flags, 0);
+        if(status != 0) {
+            db_env->close(0);
+            delete db_env;
+            return status;
+        }
+        *env = db_env;
+        return 0;
+    }
+
+    /* Environments shared by the databases that have "shared_env" set
+     * to true, indexed by home directory, so that they share a single
+     * memory pool. The cache_size and mmap_size of the first database
+     * opened in a given home are the ones used. */
+    struct SharedEnv {
+        DbEnv* env      = nullptr;
+        size_t refcount = 0;
+    };
+
+    struct SharedEnvRegistry {
+        ABT_mutex_memory                           mtx_mem = ABT_MUTEX_INITIALIZER;
+        std::unordered_map<std::string, SharedEnv> envs;
+    };
+
+    static SharedEnvRegistry& sharedEnvRegistry() {
+        static SharedEnvRegistry s_registry;
+        return s_registry;
+    }
+
+    static int acquireEnv(const std::string& db_home, const json& cfg, DbEnv** env) {
+        if(!cfg["shared_env"].get<bool>())
+            return openEnv(db_home, cfg, env);
+        auto& registry = sharedEnvRegistry();
+        ScopedMutex lock{ABT_MUTEX_MEMORY_GET_HANDLE(&registry.mtx_mem)};
+        auto& shared = registry.envs[db_home];
+        if(!shared.env) {
+            int status = openEnv(db_home, cfg, &shared.env);
+            if(status != 0) {
+                registry.envs.erase(db_home);
+                return status;
+            }
+        }
+        shared.refcount += 1;
+        *env = shared.env;
+        return 0;
+    }
+
+    /* Returns true if the environment was actually closed. */
+    static bool releaseEnv(const std::string& db_home, bool shared_env, DbEnv* env) {
+        if(shared_env) {
+            auto& registry = sharedEnvRegistry();
+            ScopedMutex lock{ABT_MUTEX_MEMORY_GET_HANDLE(&registry.mtx_mem)};
+            auto it = registry.envs.find(db_home);
+            if(it == registry.envs.end() || it->second.env != env)
+                return false; // LCOV_EXCL_LINE
+            it->second.refcount -= 1;
+            if(it->second.refcount != 0)
+                return false;
+            registry.envs.erase(it);
+        }
+        env->close(0);
+        delete env;
+        return true;
     }
 };
 
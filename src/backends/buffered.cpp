@@ -0,0 +1,1153 @@
+/*
+ * (C) 2026 The University of Chicago
+ *
+ * See COPYRIGHT in top-level directory.
+ */
+#include "yokan/backend.hpp"
+#include "yokan/doc-mixin.hpp"
+#include "yokan/util/locks.hpp"
+#include "../common/modes.hpp"
+#include "../common/logging.h"
+#include "util/key-copy.hpp"
+#include <nlohmann/json.hpp>
+#include <abt.h>
+#include <atomic>
+#include <map>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include <numeric>
+#include <cstring>
+#include <cstdio>
+#include <ctime>
+#include <unistd.h>
+#ifdef YOKAN_USE_STD_FILESYSTEM
+#include <filesystem>
+#else
+#include <experimental/filesystem>
+#endif
+
+namespace yokan {
+
+#ifdef YOKAN_USE_STD_FILESYSTEM
+namespace fs = std::filesystem;
+#else
+namespace fs = std::experimental::filesystem;
+#endif
+
+using json = nlohmann::json;
+
+/**
+ * @brief The BufferedDatabase wraps another backend (the "inner" database)
+ * and absorbs puts and erases into an in-memory sorted memtable. Reads merge
+ * the memtable with the inner database. The memtable is flushed into the
+ * inner database in large batches by a background ULT, either when its size
+ * exceeds "memtable_size" bytes, or every "flush_interval_ms" milliseconds.
+ * If "wal_path" is set, updates are also appended to a write-ahead log that
+ * is replayed when the database is re-opened or recovered (migration, restore).
+ *
+ * Example of configuration:
+ * {
+ *     "inner": { "type": "gdbm", "config": { "path": "/tmp/my-gdbm" } },
+ *     "memtable_size": 4194304,
+ *     "flush_interval_ms": 1000,
+ *     "wal_path": "/tmp/my-gdbm.wal",
+ *     "sync_wal": false
+ * }
+ *
+ * Listing and iterating require the inner database to be sorted with
+ * the default (memcmp-based) ordering.
+ */
+class BufferedDatabase : public DocumentStoreMixin<DatabaseInterface> {
+
+    struct Entry {
+        bool        erased = false;
+        std::string value;
+    };
+
+    using Memtable = std::map<std::string, Entry, std::less<>>;
+
+    enum class Lookup { Found, Erased, Missing };
+
+    enum WALOperation : uint8_t {
+        WAL_PUT   = 1,
+        WAL_ERASE = 2
+    };
+
+    /* Walks the memtable and the memtable being flushed in key order,
+     * entries from the memtable hiding those of the flushing one. */
+    class Overlay {
+
+        public:
+
+        Overlay(const Memtable& newer, const Memtable& older,
+                const UserMem& fromKey, bool inclusive)
+        : m_newer(start(newer, fromKey, inclusive))
+        , m_newer_end(newer.end())
+        , m_older(start(older, fromKey, inclusive))
+        , m_older_end(older.end()) {}
+
+        bool valid() const {
+            return m_newer != m_newer_end || m_older != m_older_end;
+        }
+
+        const Memtable::value_type& current() const {
+            if(m_older == m_older_end) return *m_newer;
+            if(m_newer == m_newer_end) return *m_older;
+            return (m_older->first < m_newer->first) ? *m_older : *m_newer;
+        }
+
+        void next() {
+            if(m_older == m_older_end) { ++m_newer; return; }
+            if(m_newer == m_newer_end) { ++m_older; return; }
+            auto c = m_newer->first.compare(m_older->first);
+            if(c <= 0) ++m_newer;
+            if(c >= 0) ++m_older;
+        }
+
+        private:
+
+        static Memtable::const_iterator start(const Memtable& table,
+                                              const UserMem& fromKey,
+                                              bool inclusive) {
+            if(fromKey.size == 0) return table.begin();
+            std::string_view from{fromKey.data, fromKey.size};
+            return inclusive ? table.lower_bound(from) : table.upper_bound(from);
+        }
+
+        Memtable::const_iterator m_newer, m_newer_end;
+        Memtable::const_iterator m_older, m_older_end;
+    };
+
+    static Status processConfig(const std::string& config, json& cfg) {
+        try {
+            cfg = json::parse(config);
+        } catch(...) {
+            return Status::InvalidConf;
+        }
+        if(!cfg.is_object())
+            return Status::InvalidConf;
+
+#define CHECK_AND_ADD_MISSING(__json__, __field__, __type__, __default__, __required__) \
+        do {                                                                            \
+            if(!__json__.contains(__field__)) {                                         \
+                if(__required__) {                                                      \
+                    return Status::InvalidConf;                                         \
+                } else {                                                                \
+                    __json__[__field__] = __default__;                                  \
+                }                                                                       \
+            } else if(!__json__[__field__].is_##__type__()) {                           \
+                return Status::InvalidConf;                                             \
+            }                                                                           \
+        } while(0)
+
+        CHECK_AND_ADD_MISSING(cfg, "inner", object, json::object(), true);
+        CHECK_AND_ADD_MISSING(cfg["inner"], "type", string, "", true);
+        CHECK_AND_ADD_MISSING(cfg["inner"], "config", object, json::object(), false);
+        CHECK_AND_ADD_MISSING(cfg, "memtable_size", number_unsigned, 4*1024*1024, false);
+        CHECK_AND_ADD_MISSING(cfg, "flush_interval_ms", number_unsigned, 1000, false);
+        CHECK_AND_ADD_MISSING(cfg, "wal_path", string, "", false);
+        CHECK_AND_ADD_MISSING(cfg, "sync_wal", boolean, false, false);
+
+        if(cfg["inner"]["type"].get<std::string>() == "buffered")
+            return Status::InvalidConf;
+
+        return Status::OK;
+    }
+
+    public:
+
+    static Status create(const std::string& config, DatabaseInterface** kvs) {
+        json cfg;
+        auto status = processConfig(config, cfg);
+        if(status != Status::OK) return status;
+
+        DatabaseInterface* inner = nullptr;
+        status = DatabaseFactory::makeDatabase(
+            cfg["inner"]["type"].get<std::string>(),
+            cfg["inner"]["config"].dump(), &inner);
+        if(status != Status::OK) return status;
+
+        auto db = new BufferedDatabase(std::move(cfg), inner);
+        status = db->replayWAL();
+        if(status != Status::OK) {
+            delete db;
+            return status;
+        }
+        *kvs = db;
+        return Status::OK;
+    }
+
+    static Status recover(
+            const std::string& config,
+            const std::string& migrationConfig,
+            const std::string& root,
+            const std::list<std::string>& files,
+            DatabaseInterface** kvs) {
+        json cfg;
+        auto status = processConfig(config, cfg);
+        if(status != Status::OK) return status;
+
+        DatabaseInterface* inner = nullptr;
+        status = DatabaseFactory::recoverDatabase(
+            cfg["inner"]["type"].get<std::string>(),
+            cfg["inner"]["config"].dump(),
+            migrationConfig, root, files, &inner);
+        if(status != Status::OK) return status;
+
+        auto db = new BufferedDatabase(std::move(cfg), inner);
+        status = db->replayWAL();
+        if(status != Status::OK) {
+            delete db;
+            return status;
+        }
+        *kvs = db;
+        return Status::OK;
+    }
+
+    // LCOV_EXCL_START
+    virtual std::string type() const override {
+        return "buffered";
+    }
+    // LCOV_EXCL_STOP
+
+    // LCOV_EXCL_START
+    virtual std::string config() const override {
+        auto cfg = m_config;
+        cfg["inner"]["config"] = json::parse(m_inner->config());
+        return cfg.dump();
+    }
+    // LCOV_EXCL_STOP
+
+    virtual std::string stats() const override {
+        json result = json::object();
+        {
+            ScopedReadLock lock(m_lock);
+            result["memtable"] = {
+                {"entries", m_memtable.size()},
+                {"bytes",   m_memtable_bytes}
+            };
+            result["flushing"] = m_flushing.size();
+        }
+        result["flushes"]        = m_flushes.load(std::memory_order_relaxed);
+        result["failed_flushes"] = m_failed_flushes.load(std::memory_order_relaxed);
+        result["inner"]          = json::parse(m_inner->stats());
+        return result.dump();
+    }
+
+    virtual bool supportsMode(int32_t mode) const override {
+        // APPEND, NEW_ONLY, and EXIST_ONLY are handled by the memtable
+        const int32_t put_modes = YOKAN_MODE_APPEND
+                                | YOKAN_MODE_NEW_ONLY
+                                | YOKAN_MODE_EXIST_ONLY;
+        return mode ==
+            (mode & (
+                     YOKAN_MODE_INCLUSIVE
+                    |YOKAN_MODE_APPEND
+                    |YOKAN_MODE_CONSUME
+        //            |YOKAN_MODE_WAIT
+        //            |YOKAN_MODE_NOTIFY
+                    |YOKAN_MODE_NEW_ONLY
+                    |YOKAN_MODE_EXIST_ONLY
+                    |YOKAN_MODE_NO_PREFIX
+                    |YOKAN_MODE_IGNORE_KEYS
+                    |YOKAN_MODE_KEEP_LAST
+                    |YOKAN_MODE_SUFFIX
+#ifdef YOKAN_HAS_LUA
+                    |YOKAN_MODE_LUA_FILTER
+#endif
+                    |YOKAN_MODE_IGNORE_DOCS
+                    |YOKAN_MODE_FILTER_VALUE
+                    |YOKAN_MODE_LIB_FILTER
+                    |YOKAN_MODE_NO_RDMA
+                    |YOKAN_MODE_UPDATE_NEW
+                    )
+            )
+            && m_inner->supportsMode(mode & ~put_modes);
+    }
+
+    bool isSorted() const override {
+        return m_inner->isSorted();
+    }
+
+    virtual void destroy() override {
+        ScopedMutex flush_lock(m_flush_mtx);
+        ScopedWriteLock lock(m_lock);
+        m_memtable.clear();
+        m_flushing.clear();
+        m_memtable_bytes = 0;
+        if(m_wal) {
+            std::fclose(m_wal);
+            m_wal = nullptr;
+        }
+        for(auto& filename : m_flushing_wal_files)
+            std::remove(filename.c_str());
+        m_flushing_wal_files.clear();
+        if(!m_wal_path.empty())
+            std::remove(m_wal_path.c_str());
+        m_inner->destroy();
+    }
+
+    virtual Status count(int32_t mode, uint64_t* c) const override {
+        // the number of keys can only be known once the memtable is flushed
+        auto status = const_cast<BufferedDatabase*>(this)->flush();
+        if(status != Status::OK) return status;
+        return m_inner->count(mode, c);
+    }
+
+    virtual Status exists(int32_t mode, const UserMem& keys,
+                          const BasicUserMem<size_t>& ksizes,
+                          BitField& flags) const override {
+        if(ksizes.size > flags.size) return Status::InvalidArg;
+        ScopedReadLock lock(m_lock);
+        if(!anyInMemtables(keys, ksizes))
+            return m_inner->exists(mode, keys, ksizes, flags);
+        size_t offset = 0;
+        for(size_t i = 0; i < ksizes.size; i++) {
+            if(offset + ksizes[i] > keys.size) return Status::InvalidArg;
+            std::string_view key{keys.data + offset, ksizes[i]};
+            auto l = lookupMemtables(key);
+            if(l == Lookup::Missing) {
+                uint8_t bit = 0;
+                BitField flag{&bit, 1};
+                auto status = m_inner->exists(mode, UserMem{keys.data + offset, ksizes[i]},
+                                              BasicUserMem<size_t>{ksizes.data + i, 1}, flag);
+                if(status != Status::OK) return status;
+                flags[i] = (bool)flag[0];
+            } else {
+                flags[i] = (l == Lookup::Found);
+            }
+            offset += ksizes[i];
+        }
+        return Status::OK;
+    }
+
+    virtual Status length(int32_t mode, const UserMem& keys,
+                          const BasicUserMem<size_t>& ksizes,
+                          BasicUserMem<size_t>& vsizes) const override {
+        if(ksizes.size != vsizes.size) return Status::InvalidArg;
+        ScopedReadLock lock(m_lock);
+        if(!anyInMemtables(keys, ksizes))
+            return m_inner->length(mode, keys, ksizes, vsizes);
+        size_t offset = 0;
+        for(size_t i = 0; i < ksizes.size; i++) {
+            if(offset + ksizes[i] > keys.size) return Status::InvalidArg;
+            std::string_view key{keys.data + offset, ksizes[i]};
+            const std::string* value = nullptr;
+            auto l = lookupMemtables(key, &value);
+            if(l == Lookup::Found) {
+                vsizes[i] = value->size();
+            } else if(l == Lookup::Erased) {
+                vsizes[i] = KeyNotFound;
+            } else {
+                BasicUserMem<size_t> vsize{vsizes.data + i, 1};
+                auto status = m_inner->length(mode, UserMem{keys.data + offset, ksizes[i]},
+                                              BasicUserMem<size_t>{ksizes.data + i, 1}, vsize);
+                if(status != Status::OK) return status;
+            }
+            offset += ksizes[i];
+        }
+        return Status::OK;
+    }
+
+    virtual Status put(int32_t mode,
+                       const UserMem& keys,
+                       const BasicUserMem<size_t>& ksizes,
+                       const UserMem& vals,
+                       const BasicUserMem<size_t>& vsizes) override {
+        if(ksizes.size != vsizes.size) return Status::InvalidArg;
+
+        size_t total_ksizes = std::accumulate(ksizes.data,
+                                              ksizes.data + ksizes.size,
+                                              (size_t)0);
+        if(total_ksizes > keys.size) return Status::InvalidArg;
+
+        size_t total_vsizes = std::accumulate(vsizes.data,
+                                              vsizes.data + vsizes.size,
+                                              (size_t)0);
+        if(total_vsizes > vals.size) return Status::InvalidArg;
+
+        const auto mode_append     = mode & YOKAN_MODE_APPEND;
+        const auto mode_new_only   = mode & YOKAN_MODE_NEW_ONLY;
+        const auto mode_exist_only = mode & YOKAN_MODE_EXIST_ONLY;
+
+        size_t key_offset = 0;
+        size_t val_offset = 0;
+        size_t memtable_bytes = 0;
+        {
+            ScopedWriteLock lock(m_lock);
+            for(size_t i = 0; i < ksizes.size; i++) {
+                std::string_view key{keys.data + key_offset, ksizes[i]};
+                std::string_view val{vals.data + val_offset, vsizes[i]};
+                key_offset += ksizes[i];
+                val_offset += vsizes[i];
+                if(!(mode_append || mode_new_only || mode_exist_only)) {
+                    setEntry(key, false, std::string{val});
+                    continue;
+                }
+                std::string current;
+                auto status = readValue(key, current);
+                if(status != Status::OK && status != Status::NotFound)
+                    return status;
+                bool exists = (status == Status::OK);
+                if(mode_new_only && exists) {
+                    if(ksizes.size == 1) return Status::KeyExists;
+                    continue;
+                }
+                if(mode_exist_only && !exists)
+                    continue;
+                if(mode_append && exists) {
+                    current.append(val);
+                    setEntry(key, false, std::move(current));
+                } else {
+                    setEntry(key, false, std::string{val});
+                }
+            }
+            auto status = syncWAL();
+            if(status != Status::OK) return status;
+            memtable_bytes = m_memtable_bytes;
+        }
+        return checkMemtableSize(memtable_bytes);
+    }
+
+    virtual Status get(int32_t mode, bool packed, const UserMem& keys,
+                       const BasicUserMem<size_t>& ksizes,
+                       UserMem& vals,
+                       BasicUserMem<size_t>& vsizes) override {
+        if(ksizes.size != vsizes.size) return Status::InvalidArg;
+        const int32_t inner_mode = mode & ~YOKAN_MODE_CONSUME;
+        {
+            ScopedReadLock lock(m_lock);
+            Status status = Status::OK;
+            if(!anyInMemtables(keys, ksizes))
+                status = m_inner->get(inner_mode, packed, keys, ksizes, vals, vsizes);
+            else if(!packed)
+                status = getUnpacked(inner_mode, keys, ksizes, vals, vsizes);
+            else
+                status = getPacked(inner_mode, keys, ksizes, vals, vsizes);
+            if(status != Status::OK) return status;
+        }
+        if(mode & YOKAN_MODE_CONSUME) {
+            return erase(mode, keys, ksizes);
+        }
+        return Status::OK;
+    }
+
+    Status fetch(int32_t mode, const UserMem& keys,
+                 const BasicUserMem<size_t>& ksizes,
+                 const FetchCallback& func) override {
+        const int32_t inner_mode = mode & ~YOKAN_MODE_CONSUME;
+        {
+            ScopedReadLock lock(m_lock);
+            if(!anyInMemtables(keys, ksizes)) {
+                auto status = m_inner->fetch(inner_mode, keys, ksizes, func);
+                if(status != Status::OK) return status;
+            } else {
+                size_t offset = 0;
+                for(size_t i = 0; i < ksizes.size; i++) {
+                    auto key_umem = UserMem{keys.data + offset, ksizes[i]};
+                    const std::string* value = nullptr;
+                    auto l = lookupMemtables({key_umem.data, key_umem.size}, &value);
+                    Status status;
+                    if(l == Lookup::Found) {
+                        status = func(key_umem, UserMem{const_cast<char*>(value->data()), value->size()});
+                    } else if(l == Lookup::Erased) {
+                        status = func(key_umem, UserMem{nullptr, KeyNotFound});
+                    } else {
+                        status = m_inner->fetch(inner_mode, key_umem,
+                                                BasicUserMem<size_t>{ksizes.data + i, 1}, func);
+                    }
+                    if(status != Status::OK) return status;
+                    offset += ksizes[i];
+                }
+            }
+        }
+        if(mode & YOKAN_MODE_CONSUME) {
+            return erase(mode, keys, ksizes);
+        }
+        return Status::OK;
+    }
+
+    virtual Status erase(int32_t mode, const UserMem& keys,
+                         const BasicUserMem<size_t>& ksizes) override {
+        (void)mode;
+        size_t total_ksizes = std::accumulate(ksizes.data,
+                                              ksizes.data + ksizes.size,
+                                              (size_t)0);
+        if(total_ksizes > keys.size) return Status::InvalidArg;
+        size_t memtable_bytes = 0;
+        {
+            ScopedWriteLock lock(m_lock);
+            size_t offset = 0;
+            for(size_t i = 0; i < ksizes.size; i++) {
+                setEntry({keys.data + offset, ksizes[i]}, true, std::string{});
+                offset += ksizes[i];
+            }
+            auto status = syncWAL();
+            if(status != Status::OK) return status;
+            memtable_bytes = m_memtable_bytes;
+        }
+        return checkMemtableSize(memtable_bytes);
+    }
+
+    virtual Status eraseRange(int32_t mode, const UserMem& prefix) override {
+        // prevent flushes while erasing so that entries being flushed
+        // cannot reappear in the inner database after eraseRange
+        ScopedMutex flush_lock(m_flush_mtx);
+        ScopedWriteLock lock(m_lock);
+        std::string_view prefix_sv{prefix.data, prefix.size};
+        std::vector<std::string> to_erase;
+        for(auto it = m_memtable.lower_bound(prefix_sv); it != m_memtable.end(); ++it) {
+            if(it->first.compare(0, prefix.size, prefix_sv) != 0) break;
+            if(!it->second.erased) to_erase.push_back(it->first);
+        }
+        for(auto& key : to_erase)
+            setEntry(key, true, std::string{});
+        auto status = syncWAL();
+        if(status != Status::OK) return status;
+        return m_inner->eraseRange(mode, prefix);
+    }
+
+    virtual Status listKeys(int32_t mode, bool packed, const UserMem& fromKey,
+                            const std::shared_ptr<KeyValueFilter>& filter,
+                            UserMem& keys, BasicUserMem<size_t>& keySizes) const override {
+        auto max = keySizes.size;
+        std::vector<std::pair<std::string, std::string>> entries;
+        auto status = collect(mode, max, fromKey, filter, true, entries);
+        if(status != Status::OK) return status;
+
+        size_t i = 0;
+        size_t offset = 0;
+        bool buf_too_small = false;
+
+        for(; i < max && i < entries.size(); i++) {
+            auto& key = entries[i].first;
+
+            size_t usize = packed ? (keys.size - offset) : keySizes[i];
+            auto umem = static_cast<char*>(keys.data) + offset;
+
+            bool is_last = (i+1 == max) || (i+1 == entries.size());
+
+            if(!packed) {
+                keySizes[i] = keyCopy(mode, is_last, filter, umem, usize, key.data(), key.size());
+                offset += usize;
+            } else {
+                if(buf_too_small) {
+                    keySizes[i] = YOKAN_SIZE_TOO_SMALL;
+                } else {
+                    keySizes[i] = keyCopy(mode, is_last, filter, umem, usize, key.data(), key.size());
+                    if(keySizes[i] == YOKAN_SIZE_TOO_SMALL) {
+                        buf_too_small = true;
+                    } else {
+                        offset += keySizes[i];
+                    }
+                }
+            }
+        }
+
+        keys.size = offset;
+        for(; i < max; i++) {
+            keySizes[i] = YOKAN_NO_MORE_KEYS;
+        }
+
+        return Status::OK;
+    }
+
+    virtual Status listKeyValues(int32_t mode,
+                                 bool packed,
+                                 const UserMem& fromKey,
+                                 const std::shared_ptr<KeyValueFilter>& filter,
+                                 UserMem& keys,
+                                 BasicUserMem<size_t>& keySizes,
+                                 UserMem& vals,
+                                 BasicUserMem<size_t>& valSizes) const override {
+        auto max = keySizes.size;
+        std::vector<std::pair<std::string, std::string>> entries;
+        auto status = collect(mode, max, fromKey, filter, false, entries);
+        if(status != Status::OK) return status;
+
+        size_t i = 0;
+        size_t key_offset = 0;
+        size_t val_offset = 0;
+        bool key_buf_too_small = false;
+        bool val_buf_too_small = false;
+
+        for(; i < max && i < entries.size(); i++) {
+            auto& key = entries[i].first;
+            auto& val = entries[i].second;
+
+            auto key_umem = static_cast<char*>(keys.data) + key_offset;
+            auto val_umem = static_cast<char*>(vals.data) + val_offset;
+
+            bool is_last = (i+1 == max) || (i+1 == entries.size());
+
+            if(!packed) {
+
+                size_t key_usize = keySizes[i];
+                size_t val_usize = valSizes[i];
+                keySizes[i] = keyCopy(mode, is_last, filter, key_umem, key_usize,
+                                      key.data(), key.size());
+                valSizes[i] = filter->valCopy(val_umem, val_usize,
+                                              val.data(), val.size());
+                key_offset += key_usize;
+                val_offset += val_usize;
+
+            } else {
+
+                size_t key_usize = keys.size - key_offset;
+                size_t val_usize = vals.size - val_offset;
+
+                if(key_buf_too_small) {
+                    keySizes[i] = YOKAN_SIZE_TOO_SMALL;
+                } else {
+                    keySizes[i] = keyCopy(mode, is_last, filter, key_umem, key_usize,
+                                          key.data(), key.size());
+                    if(keySizes[i] != YOKAN_SIZE_TOO_SMALL)
+                        key_offset += keySizes[i];
+                    else
+                        key_buf_too_small = true;
+                }
+                if(val_buf_too_small) {
+                    valSizes[i] = YOKAN_SIZE_TOO_SMALL;
+                } else {
+                    valSizes[i] = filter->valCopy(val_umem, val_usize,
+                                                  val.data(), val.size());
+                    if(valSizes[i] != YOKAN_SIZE_TOO_SMALL)
+                        val_offset += valSizes[i];
+                    else
+                        val_buf_too_small = true;
+                }
+            }
+        }
+
+        keys.size = key_offset;
+        vals.size = val_offset;
+        for(; i < max; i++) {
+            keySizes[i] = YOKAN_NO_MORE_KEYS;
+            valSizes[i] = YOKAN_NO_MORE_KEYS;
+        }
+
+        return Status::OK;
+    }
+
+    Status iter(int32_t mode, uint64_t max, const UserMem& fromKey,
+                const std::shared_ptr<KeyValueFilter>& filter,
+                bool ignore_values,
+                const IterCallback& func) const override {
+        if(!m_inner->isSorted())
+            return Status::NotSupported;
+
+        ScopedReadLock lock(m_lock);
+
+        auto inclusive = mode & YOKAN_MODE_INCLUSIVE;
+        Overlay overlay{m_memtable, m_flushing, fromKey, (bool)inclusive};
+
+        uint64_t count = 0;
+        bool stop = false;
+        Status func_status = Status::OK;
+
+        // returns false if the iteration should stop
+        auto emit = [&](std::string_view key, std::string_view val) -> bool {
+            if(!filter->check(key.data(), key.size(), val.data(), val.size())) {
+                stop = filter->shouldStop(key.data(), key.size(), val.data(), val.size());
+                return !stop;
+            }
+            auto key_umem = UserMem{const_cast<char*>(key.data()), key.size()};
+            auto val_umem = (ignore_values && !filter->requiresValue()) ?
+                UserMem{nullptr, 0} : UserMem{const_cast<char*>(val.data()), val.size()};
+            func_status = func(key_umem, val_umem);
+            count += 1;
+            stop = (func_status != Status::OK) || (max != 0 && count == max);
+            return !stop;
+        };
+
+        // emits the memtable entries that are before the provided key
+        // (or all the remaining ones if key is null)
+        auto emit_overlay_until = [&](const std::string_view* key) -> bool {
+            while(overlay.valid()) {
+                auto& entry = overlay.current();
+                if(key && std::string_view{entry.first} >= *key) break;
+                if(!entry.second.erased && !emit(entry.first, entry.second.value))
+                    return false;
+                overlay.next();
+            }
+            return true;
+        };
+
+        auto inner_func = [&](const UserMem& key, const UserMem& val) -> Status {
+            std::string_view key_sv{key.data, key.size};
+            if(!emit_overlay_until(&key_sv))
+                return Status::StopIteration;
+            if(overlay.valid() && std::string_view{overlay.current().first} == key_sv) {
+                // the memtable hides the value from the inner database
+                auto& entry = overlay.current();
+                if(!entry.second.erased && !emit(entry.first, entry.second.value))
+                    return Status::StopIteration;
+                overlay.next();
+                return Status::OK;
+            }
+            if(!emit(key_sv, {val.data, val.size}))
+                return Status::StopIteration;
+            return Status::OK;
+        };
+
+        auto status = m_inner->iter(mode, 0, fromKey, filter, ignore_values, inner_func);
+        if(stop) return func_status;
+        if(status != Status::OK) return status;
+        emit_overlay_until(nullptr);
+        return func_status;
+    }
+
+    Status startMigration(std::unique_ptr<MigrationHandle>& mh) override {
+        auto status = flush();
+        if(status != Status::OK) return status;
+        return m_inner->startMigration(mh);
+    }
+
+    ~BufferedDatabase() {
+        if(m_flush_thread != ABT_THREAD_NULL) {
+            {
+                ScopedMutex lock(m_bg_mtx);
+                m_shutdown = true;
+                ABT_cond_signal(m_bg_cond);
+            }
+            ABT_thread_join(m_flush_thread);
+            ABT_thread_free(&m_flush_thread);
+        }
+        if(m_wal) std::fclose(m_wal);
+        delete m_inner;
+        ABT_cond_free(&m_bg_cond);
+        ABT_mutex_free(&m_bg_mtx);
+        ABT_mutex_free(&m_flush_mtx);
+        YOKAN_UNPROFILE_LOCK(m_lock);
+        ABT_rwlock_free(&m_lock);
+    }
+
+    private:
+
+    BufferedDatabase(json cfg, DatabaseInterface* inner)
+    : m_config(std::move(cfg))
+    , m_inner(inner) {
+        auto disable_doc_mixin_lock = m_config.value("disable_doc_mixin_lock", false);
+        if(disable_doc_mixin_lock) disableDocMixinLock();
+        m_memtable_size = m_config["memtable_size"].get<size_t>();
+        m_flush_interval = m_config["flush_interval_ms"].get<double>()/1000.0;
+        m_wal_path = m_config["wal_path"].get<std::string>();
+        m_sync_wal = m_config["sync_wal"].get<bool>();
+        ABT_rwlock_create(&m_lock);
+        YOKAN_PROFILE_LOCK(m_lock, this, "memtable");
+        ABT_mutex_create(&m_flush_mtx);
+        ABT_mutex_create(&m_bg_mtx);
+        ABT_cond_create(&m_bg_cond);
+        ABT_pool pool = ABT_POOL_NULL;
+        ABT_self_get_last_pool(&pool);
+        ABT_thread_create(pool, flushLoop, this, ABT_THREAD_ATTR_NULL, &m_flush_thread);
+    }
+
+    /* Must be called with m_lock held. */
+    Lookup lookupMemtables(std::string_view key, const std::string** value = nullptr) const {
+        for(auto table : {&m_memtable, &m_flushing}) {
+            auto it = table->find(key);
+            if(it == table->end()) continue;
+            if(it->second.erased) return Lookup::Erased;
+            if(value) *value = &it->second.value;
+            return Lookup::Found;
+        }
+        return Lookup::Missing;
+    }
+
+    /* Must be called with m_lock held. */
+    bool anyInMemtables(const UserMem& keys, const BasicUserMem<size_t>& ksizes) const {
+        if(m_memtable.empty() && m_flushing.empty()) return false;
+        size_t offset = 0;
+        for(size_t i = 0; i < ksizes.size; i++) {
+            if(offset + ksizes[i] > keys.size) return false;
+            if(lookupMemtables({keys.data + offset, ksizes[i]}) != Lookup::Missing)
+                return true;
+            offset += ksizes[i];
+        }
+        return false;
+    }
+
+    /* Must be called with m_lock held. */
+    Status readValue(std::string_view key, std::string& value) const {
+        const std::string* v = nullptr;
+        auto l = lookupMemtables(key, &v);
+        if(l == Lookup::Found) {
+            value = *v;
+            return Status::OK;
+        }
+        if(l == Lookup::Erased)
+            return Status::NotFound;
+        size_t ksize = key.size();
+        auto ret = Status::NotFound;
+        auto status = m_inner->fetch(YOKAN_MODE_DEFAULT,
+            UserMem{const_cast<char*>(key.data()), ksize},
+            BasicUserMem<size_t>{&ksize, 1},
+            [&value, &ret](const UserMem&, const UserMem& val) {
+                if(val.size != KeyNotFound) {
+                    value.assign(val.data, val.size);
+                    ret = Status::OK;
+                }
+                return Status::OK;
+            });
+        if(status != Status::OK) return status;
+        return ret;
+    }
+
+    /* Must be called with m_lock held in write mode. */
+    void setEntry(std::string_view key, bool erased, std::string&& value) {
+        appendToWAL(erased ? WAL_ERASE : WAL_PUT, key, value);
+        auto it = m_memtable.find(key);
+        if(it == m_memtable.end()) {
+            m_memtable_bytes += key.size() + value.size();
+            m_memtable.emplace(std::string{key}, Entry{erased, std::move(value)});
+        } else {
+            m_memtable_bytes -= it->second.value.size();
+            m_memtable_bytes += value.size();
+            it->second.erased = erased;
+            it->second.value  = std::move(value);
+        }
+    }
+
+    /* Must be called with m_lock held. */
+    Status getUnpacked(int32_t mode, const UserMem& keys,
+                       const BasicUserMem<size_t>& ksizes,
+                       UserMem& vals,
+                       BasicUserMem<size_t>& vsizes) const {
+        size_t key_offset = 0;
+        size_t val_offset = 0;
+        for(size_t i = 0; i < ksizes.size; i++) {
+            const auto available = vsizes[i];
+            std::string_view key{keys.data + key_offset, ksizes[i]};
+            const std::string* value = nullptr;
+            auto l = lookupMemtables(key, &value);
+            if(l == Lookup::Found) {
+                if(value->size() > available) {
+                    vsizes[i] = BufTooSmall;
+                } else {
+                    std::memcpy(vals.data + val_offset, value->data(), value->size());
+                    vsizes[i] = value->size();
+                }
+            } else if(l == Lookup::Erased) {
+                vsizes[i] = KeyNotFound;
+            } else {
+                auto val = UserMem{vals.data + val_offset, available};
+                auto vsize = BasicUserMem<size_t>{vsizes.data + i, 1};
+                auto status = m_inner->get(mode, false,
+                    UserMem{keys.data + key_offset, ksizes[i]},
+                    BasicUserMem<size_t>{ksizes.data + i, 1}, val, vsize);
+                if(status != Status::OK) return status;
+            }
+            key_offset += ksizes[i];
+            val_offset += available;
+        }
+        return Status::OK;
+    }
+
+    /* Must be called with m_lock held. */
+    Status getPacked(int32_t mode, const UserMem& keys,
+                     const BasicUserMem<size_t>& ksizes,
+                     UserMem& vals,
+                     BasicUserMem<size_t>& vsizes) const {
+        size_t key_offset = 0;
+        size_t val_offset = 0;
+        for(size_t i = 0; i < ksizes.size; i++) {
+            const auto available = vals.size - val_offset;
+            std::string_view key{keys.data + key_offset, ksizes[i]};
+            const std::string* value = nullptr;
+            auto l = lookupMemtables(key, &value);
+            if(l == Lookup::Found) {
+                if(value->size() > available) {
+                    vsizes[i] = BufTooSmall;
+                } else {
+                    std::memcpy(vals.data + val_offset, value->data(), value->size());
+                    vsizes[i] = value->size();
+                }
+            } else if(l == Lookup::Erased) {
+                vsizes[i] = KeyNotFound;
+            } else {
+                auto val = UserMem{vals.data + val_offset, available};
+                auto vsize = BasicUserMem<size_t>{vsizes.data + i, 1};
+                auto status = m_inner->get(mode, true,
+                    UserMem{keys.data + key_offset, ksizes[i]},
+                    BasicUserMem<size_t>{ksizes.data + i, 1}, val, vsize);
+                if(status != Status::OK) return status;
+            }
+            if(vsizes[i] == BufTooSmall) {
+                for(; i < ksizes.size; i++)
+                    vsizes[i] = BufTooSmall;
+                break;
+            }
+            if(vsizes[i] != KeyNotFound)
+                val_offset += vsizes[i];
+            key_offset += ksizes[i];
+        }
+        vals.size = val_offset;
+        return Status::OK;
+    }
+
+    /* Collects up to max+1 entries (the extra one tells whether the
+     * max-th entry is the last) by merging the memtable with the inner
+     * database through iter. */
+    Status collect(int32_t mode, size_t max, const UserMem& fromKey,
+                   const std::shared_ptr<KeyValueFilter>& filter,
+                   bool ignore_values,
+                   std::vector<std::pair<std::string, std::string>>& entries) const {
+        entries.reserve(max+1);
+        return iter(mode, max+1, fromKey, filter, ignore_values,
+            [&entries](const UserMem& key, const UserMem& val) {
+                entries.emplace_back(std::string{key.data, key.size},
+                                     std::string{val.data, val.size});
+                return Status::OK;
+            });
+    }
+
+    /* Signals the background ULT if the memtable is large enough to be
+     * flushed, and flushes from the caller if it grew twice as large
+     * (i.e. the background ULT is not keeping up). */
+    Status checkMemtableSize(size_t memtable_bytes) {
+        if(memtable_bytes < m_memtable_size) return Status::OK;
+        if(memtable_bytes >= 2*m_memtable_size)
+            return flush();
+        ScopedMutex lock(m_bg_mtx);
+        m_flush_requested = true;
+        ABT_cond_signal(m_bg_cond);
+        return Status::OK;
+    }
+
+    Status flush() {
+        ScopedMutex flush_lock(m_flush_mtx);
+        {
+            ScopedWriteLock lock(m_lock);
+            if(m_memtable.empty()) return Status::OK;
+            m_flushing = std::move(m_memtable);
+            m_memtable = Memtable{};
+            m_memtable_bytes = 0;
+            rotateWAL();
+        }
+
+        // m_flushing is only modified by the thread holding m_flush_mtx,
+        // so it can be read here without holding m_lock
+        std::vector<char>   keys, vals, erased_keys;
+        std::vector<size_t> ksizes, vsizes, erased_ksizes;
+        for(auto& p : m_flushing) {
+            if(p.second.erased) {
+                erased_keys.insert(erased_keys.end(), p.first.begin(), p.first.end());
+                erased_ksizes.push_back(p.first.size());
+            } else {
+                keys.insert(keys.end(), p.first.begin(), p.first.end());
+                ksizes.push_back(p.first.size());
+                vals.insert(vals.end(), p.second.value.begin(), p.second.value.end());
+                vsizes.push_back(p.second.value.size());
+            }
+        }
+
+        auto status = Status::OK;
+        if(!ksizes.empty())
+            status = m_inner->put(YOKAN_MODE_DEFAULT,
+                                  UserMem{keys.data(), keys.size()}, ksizes,
+                                  UserMem{vals.data(), vals.size()}, vsizes);
+        if(status == Status::OK && !erased_ksizes.empty())
+            status = m_inner->erase(YOKAN_MODE_DEFAULT,
+                                    UserMem{erased_keys.data(), erased_keys.size()},
+                                    erased_ksizes);
+
+        {
+            ScopedWriteLock lock(m_lock);
+            if(status != Status::OK) {
+                // put back the entries that have not been updated since,
+                // their WAL files are kept until a flush succeeds
+                for(auto& p : m_flushing) {
+                    if(m_memtable.count(p.first)) continue;
+                    m_memtable_bytes += p.first.size() + p.second.value.size();
+                    m_memtable.insert(p);
+                }
+            }
+            m_flushing.clear();
+        }
+
+        if(status != Status::OK) {
+            // LCOV_EXCL_START
+            m_failed_flushes.fetch_add(1, std::memory_order_relaxed);
+            YOKAN_LOG_ERROR(MARGO_INSTANCE_NULL,
+                "buffered backend failed to flush memtable (status %d)", (int)status);
+            return status;
+            // LCOV_EXCL_STOP
+        }
+        m_flushes.fetch_add(1, std::memory_order_relaxed);
+        for(auto& filename : m_flushing_wal_files)
+            std::remove(filename.c_str());
+        m_flushing_wal_files.clear();
+        return Status::OK;
+    }
+
+    static void flushLoop(void* arg) {
+        auto db = static_cast<BufferedDatabase*>(arg);
+        while(true) {
+            bool shutdown = false;
+            {
+                ScopedMutex lock(db->m_bg_mtx);
+                if(!db->m_shutdown && !db->m_flush_requested) {
+                    if(db->m_flush_interval > 0) {
+                        struct timespec deadline;
+                        clock_gettime(CLOCK_REALTIME, &deadline);
+                        auto ns = (long)(db->m_flush_interval*1e9) + deadline.tv_nsec;
+                        deadline.tv_sec  += ns / 1000000000L;
+                        deadline.tv_nsec  = ns % 1000000000L;
+                        ABT_cond_timedwait(db->m_bg_cond, lock.m_mutex, &deadline);
+                    } else {
+                        ABT_cond_wait(db->m_bg_cond, lock.m_mutex);
+                    }
+                }
+                shutdown = db->m_shutdown;
+                db->m_flush_requested = false;
+            }
+            db->flush();
+            if(shutdown) break;
+        }
+    }
+
+    /* Must be called with m_lock held in write mode. */
+    void appendToWAL(WALOperation op, std::string_view key, std::string_view value) {
+        if(m_wal_path.empty()) return;
+        if(!m_wal) {
+            m_wal = std::fopen(m_wal_path.c_str(), "ab");
+            if(!m_wal) {
+                // LCOV_EXCL_START
+                YOKAN_LOG_ERROR(MARGO_INSTANCE_NULL,
+                    "buffered backend could not open WAL file %s", m_wal_path.c_str());
+                return;
+                // LCOV_EXCL_STOP
+            }
+        }
+        uint64_t ksize = key.size();
+        uint64_t vsize = value.size();
+        std::fwrite(&op, sizeof(op), 1, m_wal);
+        std::fwrite(&ksize, sizeof(ksize), 1, m_wal);
+        std::fwrite(&vsize, sizeof(vsize), 1, m_wal);
+        std::fwrite(key.data(), 1, ksize, m_wal);
+        std::fwrite(value.data(), 1, vsize, m_wal);
+    }
+
+    /* Must be called with m_lock held in write mode. */
+    Status syncWAL() {
+        if(!m_wal) return Status::OK;
+        if(std::fflush(m_wal) != 0)
+            return Status::IOError; // LCOV_EXCL_LINE
+        if(m_sync_wal && fdatasync(fileno(m_wal)) != 0)
+            return Status::IOError; // LCOV_EXCL_LINE
+        return Status::OK;
+    }
+
+    /* Must be called with m_lock held in write mode. The current WAL file
+     * is renamed so that it can be removed once the flush completes. */
+    void rotateWAL() {
+        if(!m_wal) return;
+        std::fclose(m_wal);
+        m_wal = nullptr;
+        auto filename = m_wal_path + "." + std::to_string(m_wal_seq++);
+        std::rename(m_wal_path.c_str(), filename.c_str());
+        m_flushing_wal_files.push_back(std::move(filename));
+    }
+
+    /* Replays the WAL files left by a previous instance (rotated files
+     * first, in order, then the current one), then flushes them. */
+    Status replayWAL() {
+        if(m_wal_path.empty()) return Status::OK;
+        std::vector<std::pair<uint64_t, std::string>> files;
+        auto wal_path  = fs::path{m_wal_path};
+        auto directory = wal_path.has_parent_path() ? wal_path.parent_path() : fs::path{"."};
+        auto prefix    = wal_path.filename().string() + ".";
+        std::error_code ec;
+        for(auto& p : fs::directory_iterator(directory, ec)) {
+            auto name = p.path().filename().string();
+            if(name.compare(0, prefix.size(), prefix) != 0) continue;
+            auto suffix = name.substr(prefix.size());
+            if(suffix.empty() || suffix.find_first_not_of("0123456789") != std::string::npos)
+                continue;
+            files.emplace_back(std::stoull(suffix), p.path().string());
+        }
+        std::sort(files.begin(), files.end());
+        if(!files.empty()) m_wal_seq = files.back().first + 1;
+        if(fs::exists(m_wal_path, ec))
+            files.emplace_back(0, m_wal_path);
+        if(files.empty()) return Status::OK;
+
+        {
+            ScopedWriteLock lock(m_lock);
+            for(auto& f : files) {
+                auto file = std::fopen(f.second.c_str(), "rb");
+                if(!file) continue;
+                while(true) {
+                    uint8_t  op;
+                    uint64_t ksize, vsize;
+                    if(std::fread(&op, sizeof(op), 1, file) != 1) break;
+                    if(std::fread(&ksize, sizeof(ksize), 1, file) != 1) break;
+                    if(std::fread(&vsize, sizeof(vsize), 1, file) != 1) break;
+                    std::string key(ksize, '\0'), value(vsize, '\0');
+                    if(std::fread(key.data(), 1, ksize, file) != ksize) break;
+                    if(std::fread(value.data(), 1, vsize, file) != vsize) break;
+                    // entries are not re-logged, the replayed files are
+                    // kept until the flush below succeeds
+                    auto it = m_memtable.find(key);
+                    if(it != m_memtable.end()) {
+                        m_memtable_bytes -= it->second.value.size();
+                        m_memtable.erase(it);
+                    } else {
+                        m_memtable_bytes += key.size();
+                    }
+                    m_memtable_bytes += value.size();
+                    m_memtable.emplace(std::move(key), Entry{op == WAL_ERASE, std::move(value)});
+                }
+                std::fclose(file);
+                if(f.second != m_wal_path)
+                    m_flushing_wal_files.push_back(f.second);
+            }
+            rotateCurrentWALFile();
+        }
+        return flush();
+    }
+
+    /* Used after replaying: the current WAL file, if any, is renamed so
+     * that it is removed along with the others once flushed. */
+    void rotateCurrentWALFile() {
+        std::error_code ec;
+        if(!fs::exists(m_wal_path, ec)) return;
+        auto filename = m_wal_path + "." + std::to_string(m_wal_seq++);
+        std::rename(m_wal_path.c_str(), filename.c_str());
+        m_flushing_wal_files.push_back(std::move(filename));
+    }
+
+    json               m_config;
+    DatabaseInterface* m_inner = nullptr;
+
+    Memtable   m_memtable;            // memtable receiving updates
+    Memtable   m_flushing;            // memtable being flushed
+    size_t     m_memtable_bytes = 0;  // size of keys and values in m_memtable
+    ABT_rwlock m_lock = ABT_RWLOCK_NULL;
+    ABT_mutex  m_flush_mtx = ABT_MUTEX_NULL;
+
+    size_t m_memtable_size  = 0;
+    double m_flush_interval = 0.0;
+
+    std::atomic<uint64_t> m_flushes{0};        // successful flushes
+    std::atomic<uint64_t> m_failed_flushes{0}; // failed flushes (entries are kept)
+
+    std::string              m_wal_path;
+    bool                     m_sync_wal = false;
+    FILE*                    m_wal = nullptr;
+    uint64_t                 m_wal_seq = 0;
+    std::vector<std::string> m_flushing_wal_files;
+
+    ABT_thread m_flush_thread    = ABT_THREAD_NULL;
+    ABT_mutex  m_bg_mtx          = ABT_MUTEX_NULL;
+    ABT_cond   m_bg_cond         = ABT_COND_NULL;
+    bool       m_flush_requested = false;
+    bool       m_shutdown        = false;
+};
+
+}
+
+YOKAN_REGISTER_BACKEND(buffered, yokan::BufferedDatabase);
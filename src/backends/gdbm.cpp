@@ -420,8 +420,10 @@ class GDBMDatabase : public DocumentStoreMixin<DatabaseInterface> {
     }
 
     ~GDBMDatabase() {
-        if(m_lock != ABT_RWLOCK_NULL)
+        if(m_lock != ABT_RWLOCK_NULL) {
+            YOKAN_UNPROFILE_LOCK(m_lock);
             ABT_rwlock_free(&m_lock);
+        }
         if(m_db) gdbm_close(m_db);
     }
 
@@ -432,8 +434,10 @@ class GDBMDatabase : public DocumentStoreMixin<DatabaseInterface> {
     , m_db(db)
     , m_path(path)
     {
-        if(use_lock)
+        if(use_lock) {
             ABT_rwlock_create(&m_lock);
+            YOKAN_PROFILE_LOCK(m_lock, this, "db");
+        }
         auto disable_doc_mixin_lock = m_config.value("disable_doc_mixin_lock", false);
         if(disable_doc_mixin_lock) disableDocMixinLock();
     }
@@ -5,6 +5,7 @@
  */
 #include "yokan/backend.hpp"
 #include "yokan/doc-mixin.hpp"
+#include "yokan/util/locks.hpp"
 #include "../common/modes.hpp"
 #include "util/key-copy.hpp"
 #include <nlohmann/json.hpp>
@@ -12,10 +13,15 @@
 #include <leveldb/db.h>
 #include <leveldb/comparator.h>
 #include <leveldb/env.h>
+#include <leveldb/cache.h>
+#include <leveldb/filter_policy.h>
 #include <leveldb/write_batch.h>
 #include <string>
 #include <cstring>
 #include <iostream>
+#include <memory>
+#include <unordered_map>
+#include <map>
 #ifdef YOKAN_USE_STD_FILESYSTEM
 #include <filesystem>
 #else
@@ -34,10 +40,26 @@ using json = nlohmann::json;
 
 class LevelDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
 
+    /* Block caches shared by all the LevelDB databases of the process
+     * that have "shared_block_cache" set to true, indexed by capacity. */
+    static std::shared_ptr<leveldb::Cache> getSharedBlockCache(size_t capacity) {
+        static ABT_mutex_memory s_mtx_mem = ABT_MUTEX_INITIALIZER;
+        static std::unordered_map<size_t, std::weak_ptr<leveldb::Cache>> s_caches;
+        ScopedMutex lock{ABT_MUTEX_MEMORY_GET_HANDLE(&s_mtx_mem)};
+        auto cache = s_caches[capacity].lock();
+        if(!cache) {
+            cache.reset(leveldb::NewLRUCache(capacity));
+            s_caches[capacity] = cache;
+        }
+        return cache;
+    }
+
     static Status processConfig(
             const std::string& config,
             json& cfg,
-            leveldb::Options& options) {
+            leveldb::Options& options,
+            std::shared_ptr<const leveldb::FilterPolicy>& filter_policy,
+            std::shared_ptr<leveldb::Cache>& block_cache) {
         try {
             cfg = json::parse(config);
         } catch(...) {
@@ -79,10 +101,30 @@ class LevelDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
         CHECK_AND_ADD_MISSING(cfg, "read_options", object, json::object());
         CHECK_AND_ADD_MISSING(cfg["read_options"], "verify_checksums", boolean, false);
         CHECK_AND_ADD_MISSING(cfg["read_options"], "fill_cache", boolean, true);
+        CHECK_AND_ADD_MISSING(cfg["read_options"], "snapshot_iteration", boolean, false);
+        CHECK_AND_ADD_MISSING(cfg["read_options"], "snapshot_max_age_ms", number_unsigned, 1000);
         CHECK_AND_ADD_MISSING(cfg, "write_options", object, json::object());
         CHECK_AND_ADD_MISSING(cfg["write_options"], "sync", boolean, false);
         CHECK_AND_ADD_MISSING(cfg["write_options"], "use_write_batch", boolean, false);
-        // TODO set logger, env, block_cache, and filter_policy
+        CHECK_AND_ADD_MISSING(cfg, "bloom_filter_bits_per_key", number_unsigned, 0);
+        CHECK_AND_ADD_MISSING(cfg, "block_cache_size", number_unsigned, 0);
+        CHECK_AND_ADD_MISSING(cfg, "shared_block_cache", boolean, false);
+        // a bloom_filter_bits_per_key of 0 disables the bloom filter
+        auto bloom_bits = cfg["bloom_filter_bits_per_key"].get<int>();
+        if(bloom_bits > 0) {
+            filter_policy.reset(leveldb::NewBloomFilterPolicy(bloom_bits));
+            options.filter_policy = filter_policy.get();
+        }
+        // a block_cache_size of 0 keeps LevelDB's internal 8MB cache
+        auto cache_size = cfg["block_cache_size"].get<size_t>();
+        if(cache_size > 0) {
+            if(cfg["shared_block_cache"].get<bool>())
+                block_cache = getSharedBlockCache(cache_size);
+            else
+                block_cache.reset(leveldb::NewLRUCache(cache_size));
+            options.block_cache = block_cache.get();
+        }
+        // TODO set logger and env
         return Status::OK;
     }
 
@@ -102,8 +144,10 @@ class LevelDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
         leveldb::Options options;
         json cfg;
         leveldb::Status status;
+        std::shared_ptr<const leveldb::FilterPolicy> filter_policy;
+        std::shared_ptr<leveldb::Cache> block_cache;
 
-        if(processConfig(config, cfg, options) != Status::OK)
+        if(processConfig(config, cfg, options, filter_policy, block_cache) != Status::OK)
             return Status::InvalidConf;
 
         std::string path = cfg.value("path", "");
@@ -115,7 +159,8 @@ class LevelDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
         if(!status.ok())
             return convertStatus(status);
 
-        *kvs = new LevelDBDatabase(db, std::move(cfg));
+        *kvs = new LevelDBDatabase(db, std::move(cfg),
+                                   std::move(filter_policy), std::move(block_cache));
 
         return Status::OK;
     }
@@ -131,8 +176,10 @@ class LevelDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
         leveldb::Options options;
         json cfg;
         leveldb::Status status;
+        std::shared_ptr<const leveldb::FilterPolicy> filter_policy;
+        std::shared_ptr<leveldb::Cache> block_cache;
 
-        if(processConfig(config, cfg, options) != Status::OK)
+        if(processConfig(config, cfg, options, filter_policy, block_cache) != Status::OK)
             return Status::InvalidConf;
 
         if(files.empty()) return Status::IOError;
@@ -147,7 +194,8 @@ class LevelDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
         if(!status.ok())
             return convertStatus(status);
 
-        *kvs = new LevelDBDatabase(db, std::move(cfg));
+        *kvs = new LevelDBDatabase(db, std::move(cfg),
+                                   std::move(filter_policy), std::move(block_cache));
 
         return Status::OK;
     }
@@ -168,6 +216,32 @@ class LevelDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
     }
     // LCOV_EXCL_STOP
 
+    virtual std::string stats() const override {
+        ScopedReadLock mlock(m_migration_lock);
+        if(m_migrated) return "{}";
+        json result = json::object();
+        std::string value;
+        if(m_db->GetProperty("leveldb.approximate-memory-usage", &value))
+            result["memory"] = std::stoull(value);
+        json files_per_level = json::array();
+        // GetProperty fails once level exceeds the number of levels
+        for(int level = 0; m_db->GetProperty(
+                "leveldb.num-files-at-level" + std::to_string(level), &value); level++) {
+            files_per_level.push_back(std::stoull(value));
+        }
+        result["files_per_level"] = files_per_level;
+        if(m_db->GetProperty("leveldb.stats", &value))
+            result["leveldb.stats"] = value;
+        if(m_block_cache) {
+            result["block_cache"] = {
+                {"capacity", m_config["block_cache_size"]},
+                {"usage",    m_block_cache->TotalCharge()},
+                {"shared",   m_config["shared_block_cache"]}
+            };
+        }
+        return result.dump();
+    }
+
     virtual bool supportsMode(int32_t mode) const override {
         return mode ==
             (mode & (
@@ -478,7 +552,10 @@ class LevelDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
         auto fromKeySlice = leveldb::Slice{ fromKey.data, fromKey.size };
         auto max = keySizes.size;
 
-        auto iterator = m_db->NewIterator(m_read_options);
+        auto snapshot = getIterationSnapshot(fromKey);
+        auto read_options = m_read_options;
+        read_options.snapshot = snapshot.get();
+        auto iterator = m_db->NewIterator(read_options);
         if(fromKey.size == 0) {
             iterator->SeekToFirst();
         } else {
@@ -532,6 +609,7 @@ class LevelDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
                 offset += usize;
             }
             i += 1;
+            if(i == max) saveIterationSnapshot(snapshot, key);
             iterator->Next();
         }
         keys.size = offset;
@@ -558,7 +636,10 @@ class LevelDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
 
         auto max = keySizes.size;
 
-        auto iterator = m_db->NewIterator(m_read_options);
+        auto snapshot = getIterationSnapshot(fromKey);
+        auto read_options = m_read_options;
+        read_options.snapshot = snapshot.get();
+        auto iterator = m_db->NewIterator(read_options);
         if(fromKey.size == 0) {
             iterator->SeekToFirst();
         } else {
@@ -641,6 +722,7 @@ class LevelDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
                 val_offset += val_usize;
             }
             i += 1;
+            if(i == max) saveIterationSnapshot(snapshot, key);
             iterator->Next();
         }
         keys.size = key_offset;
@@ -663,7 +745,10 @@ class LevelDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
         auto inclusive = mode & YOKAN_MODE_INCLUSIVE;
         auto fromKeySlice = leveldb::Slice{ fromKey.data, fromKey.size };
 
-        auto iterator = m_db->NewIterator(m_read_options);
+        auto snapshot = getIterationSnapshot(fromKey);
+        auto read_options = m_read_options;
+        read_options.snapshot = snapshot.get();
+        auto iterator = m_db->NewIterator(read_options);
         if(fromKey.size == 0) {
             iterator->SeekToFirst();
         } else {
@@ -698,6 +783,7 @@ class LevelDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
                 return status;
 
             i += 1;
+            if(i == max) saveIterationSnapshot(snapshot, key);
             iterator->Next();
         }
         delete iterator;
@@ -747,22 +833,70 @@ class LevelDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
     }
 
     ~LevelDBDatabase() {
+        m_snapshots.clear();
         delete m_db;
+        YOKAN_UNPROFILE_LOCK(m_migration_lock);
         ABT_rwlock_free(&m_migration_lock);
+        ABT_mutex_free(&m_snapshot_mtx);
     }
 
     private:
 
-    LevelDBDatabase(leveldb::DB* db, json&& cfg)
+    LevelDBDatabase(leveldb::DB* db, json&& cfg,
+                    std::shared_ptr<const leveldb::FilterPolicy>&& filter_policy,
+                    std::shared_ptr<leveldb::Cache>&& block_cache)
     : m_db(db)
-    , m_config(std::move(cfg)) {
+    , m_config(std::move(cfg))
+    , m_filter_policy(std::move(filter_policy))
+    , m_block_cache(std::move(block_cache)) {
         m_read_options.verify_checksums = m_config["read_options"]["verify_checksums"].get<bool>();
         m_read_options.fill_cache = m_config["read_options"]["fill_cache"].get<bool>();
+        m_snapshot_iteration = m_config["read_options"]["snapshot_iteration"].get<bool>();
+        m_snapshot_max_age = m_config["read_options"]["snapshot_max_age_ms"].get<double>()/1000.0;
         m_write_options.sync = m_config["write_options"]["sync"].get<bool>();
         m_use_write_batch = m_config["write_options"]["use_write_batch"].get<bool>();
         auto disable_doc_mixin_lock = m_config.value("disable_doc_mixin_lock", false);
         if(disable_doc_mixin_lock) disableDocMixinLock();
         ABT_rwlock_create(&m_migration_lock);
+        YOKAN_PROFILE_LOCK(m_migration_lock, this, "migration");
+        ABT_mutex_create(&m_snapshot_mtx);
+    }
+
+    /* Returns the snapshot that listKeys, listKeyValues, and iter should
+     * use, or nullptr if snapshot iteration is disabled. A scan starting
+     * from the key on which a previous page of the scan ended (within
+     * snapshot_max_age_ms) continues with the snapshot of that page, so
+     * all the pages of a scan see the same view of the database. Any
+     * other call takes a new snapshot and sees all prior writes. */
+    std::shared_ptr<const leveldb::Snapshot> getIterationSnapshot(const UserMem& fromKey) const {
+        if(!m_snapshot_iteration) return nullptr;
+        ScopedMutex lock{m_snapshot_mtx};
+        if(fromKey.size != 0) {
+            auto it = m_snapshots.find(std::string{fromKey.data, fromKey.size});
+            if(it != m_snapshots.end()
+            && ABT_get_wtime() - it->second.second <= m_snapshot_max_age)
+                return it->second.first;
+        }
+        auto db = m_db;
+        return std::shared_ptr<const leveldb::Snapshot>(m_db->GetSnapshot(),
+            [db](const leveldb::Snapshot* s) { db->ReleaseSnapshot(s); });
+    }
+
+    /* Records that a page of a scan using the given snapshot ended on
+     * the given key, so that the next page can use the same snapshot,
+     * and releases the snapshots of scans that were not continued. */
+    void saveIterationSnapshot(const std::shared_ptr<const leveldb::Snapshot>& snapshot,
+                               const leveldb::Slice& lastKey) const {
+        if(!snapshot) return;
+        ScopedMutex lock{m_snapshot_mtx};
+        auto now = ABT_get_wtime();
+        for(auto it = m_snapshots.begin(); it != m_snapshots.end();) {
+            if(now - it->second.second > m_snapshot_max_age)
+                it = m_snapshots.erase(it);
+            else
+                ++it;
+        }
+        m_snapshots[lastKey.ToString()] = std::make_pair(snapshot, now);
     }
 
     leveldb::DB*          m_db;
@@ -771,6 +905,15 @@ class LevelDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
     leveldb::WriteOptions m_write_options;
     bool                  m_use_write_batch;
 
+    std::shared_ptr<const leveldb::FilterPolicy> m_filter_policy;
+    std::shared_ptr<leveldb::Cache>              m_block_cache;
+
+    bool                                             m_snapshot_iteration = false;
+    double                                           m_snapshot_max_age = 0.0;
+    mutable std::map<std::string,
+        std::pair<std::shared_ptr<const leveldb::Snapshot>, double>> m_snapshots;
+    ABT_mutex                                        m_snapshot_mtx = ABT_MUTEX_NULL;
+
     bool                  m_migrated = false;
     ABT_rwlock            m_migration_lock = ABT_RWLOCK_NULL;
 };
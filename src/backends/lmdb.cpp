@@ -7,12 +7,15 @@
 #include "yokan/doc-mixin.hpp"
 #include "../common/modes.hpp"
 #include "util/key-copy.hpp"
+#include "util/merge.hpp"
 #include <nlohmann/json.hpp>
 #include <abt.h>
 #include <lmdb.h>
 #include <string>
 #include <cstring>
 #include <iostream>
+#include <vector>
+#include <algorithm>
 #ifdef YOKAN_USE_STD_FILESYSTEM
 #include <filesystem>
 #else
@@ -109,7 +112,8 @@ class LMDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
 
         ret = mdb_env_create(&env);
         if(ret != MDB_SUCCESS) return convertStatus(ret);
-        int flags = MDB_WRITEMAP;
+        // MDB_NOTLS: read transactions may be held by a ULT across yields
+        int flags = MDB_WRITEMAP | MDB_NOTLS;
         if(cfg["no_lock"].get<bool>()) flags |= MDB_NOLOCK;
         ret = mdb_env_open(env, path.c_str(), flags, 0644);
         if(ret != MDB_SUCCESS) {
@@ -165,7 +169,8 @@ class LMDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
 
         ret = mdb_env_create(&env);
         if(ret != MDB_SUCCESS) return convertStatus(ret);
-        int flags = MDB_WRITEMAP;
+        // MDB_NOTLS: read transactions may be held by a ULT across yields
+        int flags = MDB_WRITEMAP | MDB_NOTLS;
         if(cfg["no_lock"].get<bool>()) flags |= MDB_NOLOCK;
         ret = mdb_env_open(env, path.c_str(), flags, 0644);
         if(ret != MDB_SUCCESS) {
@@ -206,6 +211,37 @@ class LMDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
     }
     // LCOV_EXCL_STOP
 
+    virtual std::string stats() const override {
+        ScopedReadLock mlock(m_migration_lock);
+        if(m_migrated || !m_env) return "{}";
+        json result = json::object();
+        MDB_envinfo info;
+        MDB_stat env_stats;
+        if(mdb_env_info(m_env, &info) == MDB_SUCCESS
+        && mdb_env_stat(m_env, &env_stats) == MDB_SUCCESS) {
+            result["map_size"]    = info.me_mapsize;
+            result["last_pgno"]   = info.me_last_pgno;
+            result["last_txnid"]  = info.me_last_txnid;
+            result["max_readers"] = info.me_maxreaders;
+            result["num_readers"] = info.me_numreaders;
+            result["page_size"]   = env_stats.ms_psize;
+            result["memory"]      = (info.me_last_pgno + 1)*env_stats.ms_psize;
+        }
+        MDB_txn* txn = nullptr;
+        if(mdb_txn_begin(m_env, nullptr, MDB_RDONLY, &txn) == MDB_SUCCESS) {
+            MDB_stat db_stats;
+            if(mdb_stat(txn, m_db, &db_stats) == MDB_SUCCESS) {
+                result["entries"]        = db_stats.ms_entries;
+                result["depth"]          = db_stats.ms_depth;
+                result["branch_pages"]   = db_stats.ms_branch_pages;
+                result["leaf_pages"]     = db_stats.ms_leaf_pages;
+                result["overflow_pages"] = db_stats.ms_overflow_pages;
+            }
+            mdb_txn_abort(txn);
+        }
+        return result.dump();
+    }
+
     virtual bool supportsMode(int32_t mode) const override {
         return mode ==
             (mode & (
@@ -236,6 +272,12 @@ class LMDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
         return true;
     }
 
+    bool supportsZeroCopyFetch() const override {
+        // values point into the memory map and remain valid
+        // for the duration of the read transaction
+        return true;
+    }
+
     virtual void destroy() override {
         if(m_env) {
             mdb_dbi_close(m_env, m_db);
@@ -565,6 +607,163 @@ class LMDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
         return convertStatus(ret);
     }
 
+    virtual Status getRange(int32_t mode, const UserMem& key,
+                            size_t offset, UserMem& data) override {
+        ScopedReadLock mlock(m_migration_lock);
+        if(m_migrated) return Status::Migrated;
+        (void)mode;
+
+        MDB_txn* txn = nullptr;
+        int ret = mdb_txn_begin(m_env, nullptr, MDB_RDONLY, &txn);
+        if(ret != MDB_SUCCESS) return convertStatus(ret);
+        MDB_val k{ key.size, key.data };
+        MDB_val v{ 0, nullptr };
+        ret = mdb_get(txn, m_db, &k, &v);
+        if(ret != MDB_SUCCESS) {
+            mdb_txn_abort(txn);
+            return convertStatus(ret);
+        }
+        // copy only the requested bytes out of the memory map
+        size_t read = 0;
+        if(offset < v.mv_size) {
+            read = std::min(data.size, v.mv_size - offset);
+            std::memcpy(data.data, (const char*)v.mv_data + offset, read);
+        }
+        mdb_txn_abort(txn);
+        data.size = read;
+        return Status::OK;
+    }
+
+    virtual Status putRange(int32_t mode, const UserMem& key,
+                            size_t offset, const UserMem& data) override {
+        ScopedReadLock mlock(m_migration_lock);
+        if(m_migrated) return Status::Migrated;
+
+        MDB_txn* txn = nullptr;
+        int ret = mdb_txn_begin(m_env, nullptr, 0, &txn);
+        if(ret != MDB_SUCCESS) return convertStatus(ret);
+        MDB_val k{ key.size, key.data };
+        MDB_val v{ 0, nullptr };
+        ret = mdb_get(txn, m_db, &k, &v);
+        if(ret == MDB_NOTFOUND && (mode & YOKAN_MODE_EXIST_ONLY)) {
+            mdb_txn_abort(txn);
+            return Status::NotFound;
+        }
+        if(ret == MDB_SUCCESS && (mode & YOKAN_MODE_NEW_ONLY)) {
+            mdb_txn_abort(txn);
+            return Status::KeyExists;
+        }
+        if(ret != MDB_SUCCESS && ret != MDB_NOTFOUND) {
+            mdb_txn_abort(txn);
+            return convertStatus(ret);
+        }
+        // the old value may be moved by mdb_put, so keep a copy of the
+        // bytes that are not overwritten, then write the new value in the
+        // space reserved by mdb_put, within the same transaction
+        size_t old_size = ret == MDB_SUCCESS ? v.mv_size : 0;
+        size_t new_size = std::max(old_size, offset + data.size);
+        std::vector<char> head(std::min(old_size, offset));
+        std::vector<char> tail;
+        if(old_size > offset + data.size)
+            tail.resize(old_size - offset - data.size);
+        if(!head.empty())
+            std::memcpy(head.data(), v.mv_data, head.size());
+        if(!tail.empty())
+            std::memcpy(tail.data(),
+                        (const char*)v.mv_data + offset + data.size, tail.size());
+
+        MDB_val nv{ new_size, nullptr };
+        ret = mdb_put(txn, m_db, &k, &nv, MDB_RESERVE);
+        if(ret != MDB_SUCCESS) {
+            mdb_txn_abort(txn);
+            return convertStatus(ret);
+        }
+        char* dst = (char*)nv.mv_data;
+        if(!head.empty()) std::memcpy(dst, head.data(), head.size());
+        std::memset(dst + head.size(), 0, offset - head.size());
+        if(data.size) std::memcpy(dst + offset, data.data, data.size);
+        if(!tail.empty()) std::memcpy(dst + offset + data.size, tail.data(), tail.size());
+        ret = mdb_txn_commit(txn);
+        return convertStatus(ret);
+    }
+
+    virtual Status compareAndSwap(int32_t mode, const UserMem& key,
+                                  const UserMem& expected,
+                                  const UserMem& value,
+                                  bool* swapped) override {
+        ScopedReadLock mlock(m_migration_lock);
+        if(m_migrated) return Status::Migrated;
+        (void)mode;
+        *swapped = false;
+
+        // LMDB serializes write transactions, so the comparison and the
+        // replacement are atomic with respect to other writers
+        MDB_txn* txn = nullptr;
+        int ret = mdb_txn_begin(m_env, nullptr, 0, &txn);
+        if(ret != MDB_SUCCESS) return convertStatus(ret);
+        MDB_val k{ key.size, key.data };
+        MDB_val v{ 0, nullptr };
+        ret = mdb_get(txn, m_db, &k, &v);
+        if(ret != MDB_SUCCESS) {
+            mdb_txn_abort(txn);
+            return convertStatus(ret);
+        }
+        if(v.mv_size != expected.size
+        || std::memcmp(v.mv_data, expected.data, expected.size) != 0) {
+            mdb_txn_abort(txn);
+            return Status::OK;
+        }
+        MDB_val nv{ value.size, value.data };
+        ret = mdb_put(txn, m_db, &k, &nv, 0);
+        if(ret != MDB_SUCCESS) {
+            mdb_txn_abort(txn);
+            return convertStatus(ret);
+        }
+        ret = mdb_txn_commit(txn);
+        if(ret == MDB_SUCCESS) *swapped = true;
+        return convertStatus(ret);
+    }
+
+    virtual Status merge(int32_t mode, const UserMem& key,
+                         int32_t op, const UserMem& operand,
+                         size_t bound, const MergeCallback& func) override {
+        ScopedReadLock mlock(m_migration_lock);
+        if(m_migrated) return Status::Migrated;
+
+        MDB_txn* txn = nullptr;
+        int ret = mdb_txn_begin(m_env, nullptr, 0, &txn);
+        if(ret != MDB_SUCCESS) return convertStatus(ret);
+        MDB_val k{ key.size, key.data };
+        MDB_val v{ 0, nullptr };
+        ret = mdb_get(txn, m_db, &k, &v);
+        if(ret == MDB_NOTFOUND && (mode & YOKAN_MODE_EXIST_ONLY)) {
+            mdb_txn_abort(txn);
+            return Status::NotFound;
+        }
+        if(ret != MDB_SUCCESS && ret != MDB_NOTFOUND) {
+            mdb_txn_abort(txn);
+            return convertStatus(ret);
+        }
+        std::vector<char> value;
+        if(ret == MDB_SUCCESS)
+            value.assign((const char*)v.mv_data, (const char*)v.mv_data + v.mv_size);
+        auto status = applyMerge(op, operand, bound, value);
+        if(status != Status::OK) {
+            mdb_txn_abort(txn);
+            return status;
+        }
+        MDB_val nv{ value.size(), value.data() };
+        ret = mdb_put(txn, m_db, &k, &nv, 0);
+        if(ret != MDB_SUCCESS) {
+            mdb_txn_abort(txn);
+            return convertStatus(ret);
+        }
+        ret = mdb_txn_commit(txn);
+        if(ret != MDB_SUCCESS) return convertStatus(ret);
+        if(func) func(UserMem{ value.data(), value.size() });
+        return Status::OK;
+    }
+
     virtual Status listKeys(int32_t mode, bool packed, const UserMem& fromKey,
                             const std::shared_ptr<KeyValueFilter>& filter,
                             UserMem& keys, BasicUserMem<size_t>& keySizes) const override {
@@ -1023,6 +1222,7 @@ class LMDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
             mdb_env_close(m_env);
         }
         m_env = nullptr;
+        YOKAN_UNPROFILE_LOCK(m_migration_lock);
         ABT_rwlock_free(&m_migration_lock);
     }
 
@@ -1035,6 +1235,7 @@ class LMDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
         auto disable_doc_mixin_lock = m_config.value("disable_doc_mixin_lock", false);
         if(disable_doc_mixin_lock) disableDocMixinLock();
         ABT_rwlock_create(&m_migration_lock);
+        YOKAN_PROFILE_LOCK(m_migration_lock, this, "migration");
     }
 
     json        m_config;
@@ -57,8 +57,16 @@ class LogDatabase : public DatabaseInterface {
         }
 
         ~LRUCache() {
-            if(m_lock != ABT_RWLOCK_NULL)
+            if(m_lock != ABT_RWLOCK_NULL) {
+                YOKAN_UNPROFILE_LOCK(m_lock);
                 ABT_rwlock_free(&m_lock);
+            }
+        }
+
+        void profileLock(const DatabaseInterface* owner, const std::string& name) {
+            (void)owner;
+            (void)name;
+            YOKAN_PROFILE_LOCK(m_lock, owner, name);
         }
 
         // Get an object by id. If the object doesn't exist, call the function
@@ -67,15 +75,27 @@ class LogDatabase : public DatabaseInterface {
         std::shared_ptr<T> get(uint64_t id, Factory&& make) {
             auto it = m_cache_map.find(id);
             if (it == m_cache_map.end()) {
+                m_misses.fetch_add(1, std::memory_order_relaxed);
                 auto obj = make(id);
                 put(obj, id);
                 return obj;
             } else {
+                m_hits.fetch_add(1, std::memory_order_relaxed);
                 m_access_list.splice(m_access_list.begin(), m_access_list, it->second);
                 return it->second->second;
             }
         }
 
+        json stats() const {
+            return json{
+                {"capacity",  m_max_size},
+                {"size",      m_cache_map.size()},
+                {"hits",      m_hits.load(std::memory_order_relaxed)},
+                {"misses",    m_misses.load(std::memory_order_relaxed)},
+                {"evictions", m_evictions.load(std::memory_order_relaxed)}
+            };
+        }
+
         private:
 
         // Put an object in the cache
@@ -92,6 +112,7 @@ class LogDatabase : public DatabaseInterface {
                     auto lru = m_access_list.back();
                     m_cache_map.erase(lru.first);
                     m_access_list.pop_back();
+                    m_evictions.fetch_add(1, std::memory_order_relaxed);
                 }
                 // Insert the new item at the front of the list
                 m_access_list.emplace_front(id, obj);
@@ -105,6 +126,9 @@ class LogDatabase : public DatabaseInterface {
         std::list<std::pair<uint64_t, std::shared_ptr<T>>> m_access_list;
         std::unordered_map<uint64_t, ListIterator>         m_cache_map;
         ABT_rwlock                                         m_lock = ABT_RWLOCK_NULL;
+        std::atomic<uint64_t>                              m_hits{0};
+        std::atomic<uint64_t>                              m_misses{0};
+        std::atomic<uint64_t>                              m_evictions{0};
     };
 
     class MemoryMappedFile {
@@ -374,10 +398,17 @@ class LogDatabase : public DatabaseInterface {
 
         ~Collection() {
             if(m_lock != ABT_RWLOCK_NULL) {
+                YOKAN_UNPROFILE_LOCK(m_lock);
                 ABT_rwlock_free(&m_lock);
             }
         }
 
+        void profileLocks(const DatabaseInterface* owner) {
+            (void)owner;
+            YOKAN_PROFILE_LOCK(m_lock, owner, "collection:" + m_name);
+            m_chunk_cache.profileLock(owner, "chunk_cache:" + m_name);
+        }
+
         [[nodiscard]] Status erase(yk_id_t id) {
             if(id >= m_header->next_id)
                 return Status::InvalidID;
@@ -593,19 +624,33 @@ class LogDatabase : public DatabaseInterface {
             return Status::OK;
         }
 
-        [[nodiscard]] Status fetch(size_t id, DocFetchCallback cb) {
+        [[nodiscard]] Status fetch(size_t id, const DocFetchCallback& cb) {
             ScopedReadLock lock{m_lock};
-            if(id >= m_header->next_id)
-                return cb(id, UserMem{nullptr, YOKAN_KEY_NOT_FOUND});
-            EntryMetadata entry;
-            auto status = readEntryMetadata(id, entry);
-            if(status == Status::NotFound || entry.size == YOKAN_KEY_NOT_FOUND)
-                return cb(id, UserMem{nullptr, YOKAN_KEY_NOT_FOUND});
-            auto chunk = getChunkFromID(entry.chunk);
-            auto func = [id, &cb](const UserMem& doc) {
-                return cb(id, doc);
+            return _fetch(id, cb);
+        }
+
+        /**
+         * @brief Fetch multiple documents while holding the collection
+         * lock for the whole operation. Chunks accessed are kept alive
+         * until the function returns, hence the memory passed to the
+         * callback remains valid until then (zero-copy fetch).
+         * Errors returned by the callback are propagated.
+         */
+        [[nodiscard]] Status fetchMany(const BasicUserMem<yk_id_t>& ids,
+                                       const DocFetchCallback& cb) {
+            ScopedReadLock lock{m_lock};
+            std::vector<std::shared_ptr<Chunk>> pinned;
+            bool cb_failed = false;
+            auto wrapped_cb = [&cb, &cb_failed](yk_id_t id, const UserMem& doc) {
+                auto status = cb(id, doc);
+                if(status != Status::OK) cb_failed = true;
+                return status;
             };
-            return chunk->fetch(entry.offset, entry.size, func);
+            for(size_t i = 0; i < ids.size; ++i) {
+                auto status = _fetch(ids[i], wrapped_cb, &pinned);
+                if(cb_failed) return status;
+            }
+            return Status::OK;
         }
 
         [[nodiscard]] Status entrySize(size_t id, size_t* size) {
@@ -629,8 +674,37 @@ class LogDatabase : public DatabaseInterface {
             return m_header->coll_size;
         }
 
+        json stats() const {
+            ScopedReadLock lock{m_lock};
+            return json{
+                {"entries",     m_header->coll_size},
+                {"next_id",     m_header->next_id},
+                {"chunks",      m_header->last_chunk_id + 1},
+                {"chunk_size",  m_header->chunk_size},
+                {"meta_size",   m_meta->size()},
+                {"chunk_cache", m_chunk_cache.stats()}
+            };
+        }
+
         private:
 
+        [[nodiscard]] Status _fetch(size_t id, const DocFetchCallback& cb,
+                                    std::vector<std::shared_ptr<Chunk>>* pinned = nullptr) {
+            if(id >= m_header->next_id)
+                return cb(id, UserMem{nullptr, YOKAN_KEY_NOT_FOUND});
+            EntryMetadata entry;
+            auto status = readEntryMetadata(id, entry);
+            if(status == Status::NotFound || entry.size == YOKAN_KEY_NOT_FOUND)
+                return cb(id, UserMem{nullptr, YOKAN_KEY_NOT_FOUND});
+            auto chunk = getChunkFromID(entry.chunk);
+            if(pinned && (pinned->empty() || pinned->back() != chunk))
+                pinned->push_back(chunk);
+            auto func = [id, &cb](const UserMem& doc) {
+                return cb(id, doc);
+            };
+            return chunk->fetch(entry.offset, entry.size, func);
+        }
+
         std::string               m_name;
         std::string               m_path_prefix;
         size_t                    m_chunk_size;
@@ -729,6 +803,23 @@ class LogDatabase : public DatabaseInterface {
     }
     // LCOV_EXCL_STOP
 
+    virtual std::string stats() const override {
+        ScopedReadLock lock(m_lock);
+        json collections = json::object();
+        uint64_t entries = 0, chunks = 0;
+        for(auto& p : m_collections) {
+            auto coll_stats = p.second->stats();
+            entries += coll_stats["entries"].get<uint64_t>();
+            chunks  += coll_stats["chunks"].get<uint64_t>();
+            collections[p.first] = std::move(coll_stats);
+        }
+        return json{
+            {"entries",     entries},
+            {"chunks",      chunks},
+            {"collections", collections}
+        }.dump();
+    }
+
     virtual bool supportsMode(int32_t mode) const override {
         return mode ==
             (mode & (
@@ -751,6 +842,12 @@ class LogDatabase : public DatabaseInterface {
         return true;
     }
 
+    bool supportsZeroCopyFetch() const override {
+        // documents point into memory-mapped chunks that are
+        // pinned for the duration of docFetch
+        return true;
+    }
+
     Status collCreate(int32_t mode, const char* name) override {
         (void)mode;
         ScopedWriteLock lock(m_lock);
@@ -758,6 +855,7 @@ class LogDatabase : public DatabaseInterface {
             return Status::KeyExists;
         auto coll = std::make_shared<Collection>(
             name, m_path, m_chunk_size , m_cache_size, m_lock != ABT_RWLOCK_NULL);
+        coll->profileLocks(this);
         m_collections.emplace(name, coll);
         return Status::OK;
     }
@@ -940,11 +1038,7 @@ class LogDatabase : public DatabaseInterface {
             return Status::NotFound;
         auto coll = p->second;
 
-        for(size_t i = 0; i < ids.size; ++i) {
-            const auto id = ids[i];
-            (void)coll->fetch(id, func);
-        }
-        return Status::OK;
+        return coll->fetchMany(ids, func);
     }
 
     Status docErase(const char* collection,
@@ -1103,8 +1197,10 @@ class LogDatabase : public DatabaseInterface {
     }
 
     ~LogDatabase() {
-        if(m_lock != ABT_RWLOCK_NULL)
+        if(m_lock != ABT_RWLOCK_NULL) {
+            YOKAN_UNPROFILE_LOCK(m_lock);
             ABT_rwlock_free(&m_lock);
+        }
     }
 
     private:
@@ -1112,8 +1208,10 @@ class LogDatabase : public DatabaseInterface {
     LogDatabase(json cfg)
     : m_config(std::move(cfg))
     {
-        if(m_config["use_lock"].get<bool>())
+        if(m_config["use_lock"].get<bool>()) {
             ABT_rwlock_create(&m_lock);
+            YOKAN_PROFILE_LOCK(m_lock, this, "db");
+        }
         m_path = m_config["path"].get<std::string>();
         m_chunk_size = m_config["chunk_size"].get<size_t>();
         m_cache_size = m_config["cache_size"].get<size_t>();
@@ -1132,6 +1230,7 @@ class LogDatabase : public DatabaseInterface {
             auto coll = std::make_shared<Collection>(
                 name, m_path, m_chunk_size, m_cache_size,
                 m_lock != ABT_RWLOCK_NULL);
+            coll->profileLocks(this);
             m_collections.emplace(name, coll);
         }
     }
@@ -11,6 +11,7 @@
 #include "../common/allocator.hpp"
 #include "../common/modes.hpp"
 #include "util/key-copy.hpp"
+#include "util/merge.hpp"
 #include <nlohmann/json.hpp>
 #include <unistd.h>
 #include <abt.h>
@@ -209,6 +210,24 @@ class MapDatabase : public DocumentStoreMixin<DatabaseInterface> {
     }
     // LCOV_EXCL_STOP
 
+    virtual std::string stats() const override {
+        ScopedReadLock lock(m_lock);
+        json allocators = json::object();
+        size_t memory = 0;
+        allocators["node"] = allocator_usage(m_node_allocator);
+        memory += allocators["node"]["bytes"].get<size_t>();
+        allocators["key"] = allocator_usage(m_key_allocator);
+        memory += allocators["key"]["bytes"].get<size_t>();
+        allocators["value"] = allocator_usage(m_val_allocator);
+        memory += allocators["value"]["bytes"].get<size_t>();
+        json result = {
+            {"entries",    m_db->size()},
+            {"memory",     memory},
+            {"allocators", allocators}
+        };
+        return result.dump();
+    }
+
     virtual bool supportsMode(int32_t mode) const override {
         return mode ==
             (mode & (
@@ -624,6 +643,92 @@ retry:
         return Status::OK;
     }
 
+    virtual Status getRange(int32_t mode, const UserMem& key,
+                            size_t offset, UserMem& data) override {
+        (void)mode;
+        ScopedReadLock lock(m_lock);
+        if(m_migrated) return Status::Migrated;
+        auto it = m_db->find(key);
+        if(it == m_db->end()) return Status::NotFound;
+        auto& v = it->second;
+        size_t read = 0;
+        if(offset < v.size()) {
+            read = std::min(data.size, v.size() - offset);
+            std::memcpy(data.data, v.data() + offset, read);
+        }
+        data.size = read;
+        return Status::OK;
+    }
+
+    virtual Status putRange(int32_t mode, const UserMem& key,
+                            size_t offset, const UserMem& data) override {
+        ScopedWriteLock lock(m_lock);
+        if(m_migrated) return Status::Migrated;
+        auto it = m_db->find(key);
+        if(it == m_db->end()) {
+            if(mode & YOKAN_MODE_EXIST_ONLY) return Status::NotFound;
+            it = m_db->emplace(std::piecewise_construct,
+                    std::forward_as_tuple(key.data, key.size, m_key_allocator),
+                    std::forward_as_tuple(m_val_allocator)).first;
+        } else if(mode & YOKAN_MODE_NEW_ONLY) {
+            return Status::KeyExists;
+        }
+        auto& v = it->second;
+        if(v.size() < offset + data.size)
+            v.resize(offset + data.size, '\0');
+        if(data.size) std::memcpy(&v[offset], data.data, data.size);
+        if(mode & YOKAN_MODE_NOTIFY)
+            m_watcher.notifyKey(key);
+        return Status::OK;
+    }
+
+    virtual Status compareAndSwap(int32_t mode, const UserMem& key,
+                                  const UserMem& expected,
+                                  const UserMem& value,
+                                  bool* swapped) override {
+        ScopedWriteLock lock(m_lock);
+        if(m_migrated) return Status::Migrated;
+        *swapped = false;
+        auto it = m_db->find(key);
+        if(it == m_db->end()) return Status::NotFound;
+        auto& v = it->second;
+        if(v.size() != expected.size
+        || std::memcmp(v.data(), expected.data, expected.size) != 0)
+            return Status::OK;
+        v.assign(value.data, value.size);
+        *swapped = true;
+        if(mode & YOKAN_MODE_NOTIFY)
+            m_watcher.notifyKey(key);
+        return Status::OK;
+    }
+
+    virtual Status merge(int32_t mode, const UserMem& key,
+                         int32_t op, const UserMem& operand,
+                         size_t bound, const MergeCallback& func) override {
+        ScopedWriteLock lock(m_lock);
+        if(m_migrated) return Status::Migrated;
+        auto it = m_db->find(key);
+        if(it == m_db->end()) {
+            if(mode & YOKAN_MODE_EXIST_ONLY) return Status::NotFound;
+            // apply the operator before inserting the key, so that
+            // an invalid operand does not leave an empty value behind
+            auto v = value_type(m_val_allocator);
+            auto status = applyMerge(op, operand, bound, v);
+            if(status != Status::OK) return status;
+            it = m_db->emplace(std::piecewise_construct,
+                    std::forward_as_tuple(key.data, key.size, m_key_allocator),
+                    std::forward_as_tuple(std::move(v))).first;
+        } else {
+            auto status = applyMerge(op, operand, bound, it->second);
+            if(status != Status::OK) return status;
+        }
+        auto& v = it->second;
+        if(func) func(UserMem{ v.data(), v.size() });
+        if(mode & YOKAN_MODE_NOTIFY)
+            m_watcher.notifyKey(key);
+        return Status::OK;
+    }
+
     virtual Status listKeys(int32_t mode, bool packed, const UserMem& fromKey,
                             const std::shared_ptr<KeyValueFilter>& filter,
                             UserMem& keys, BasicUserMem<size_t>& keySizes) const override {
@@ -894,8 +999,10 @@ retry:
     }
 
     ~MapDatabase() {
-        if(m_lock != ABT_RWLOCK_NULL)
+        if(m_lock != ABT_RWLOCK_NULL) {
+            YOKAN_UNPROFILE_LOCK(m_lock);
             ABT_rwlock_free(&m_lock);
+        }
         delete m_db;
         m_key_allocator.finalize(m_key_allocator.context);
         m_val_allocator.finalize(m_val_allocator.context);
@@ -923,8 +1030,13 @@ retry:
     , m_key_allocator(key_allocator)
     , m_val_allocator(val_allocator)
     {
-        if(m_config["use_lock"].get<bool>())
+        wrap_counting_allocator(&m_node_allocator);
+        wrap_counting_allocator(&m_key_allocator);
+        wrap_counting_allocator(&m_val_allocator);
+        if(m_config["use_lock"].get<bool>()) {
             ABT_rwlock_create(&m_lock);
+            YOKAN_PROFILE_LOCK(m_lock, this, "db");
+        }
         m_db = new map_type(cmp_fun, allocator(m_node_allocator));
         auto disable_doc_mixin_lock = m_config.value("disable_doc_mixin_lock", false);
         if(disable_doc_mixin_lock) disableDocMixinLock();
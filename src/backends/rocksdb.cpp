@@ -8,11 +8,14 @@
 #include "../common/logging.h"
 #include "../common/modes.hpp"
 #include "util/key-copy.hpp"
+#include "util/merge.hpp"
 #include <nlohmann/json.hpp>
 #include <abt.h>
 #include <rocksdb/db.h>
 #include <rocksdb/comparator.h>
 #include <rocksdb/env.h>
+#include <rocksdb/merge_operator.h>
+#include <rocksdb/statistics.h>
 #include <rocksdb/write_batch.h>
 #include <string>
 #include <cstring>
@@ -82,6 +85,58 @@ class Logger : public rocksdb::Logger {
 
 };
 
+/**
+ * Merge operator installed in every RocksDB database opened by Yokan,
+ * applying the YOKAN_MERGE_* operators. An operand is encoded as the
+ * operator (int32_t), followed by the bound (uint64_t), followed by the
+ * operand provided by the user.
+ */
+class RocksDBMergeOperator : public rocksdb::MergeOperator {
+
+    public:
+
+    static std::string encode(int32_t op, size_t bound, const UserMem& operand) {
+        std::string encoded(sizeof(op) + sizeof(uint64_t) + operand.size, '\0');
+        uint64_t b = bound;
+        std::memcpy(&encoded[0], &op, sizeof(op));
+        std::memcpy(&encoded[sizeof(op)], &b, sizeof(b));
+        if(operand.size)
+            std::memcpy(&encoded[sizeof(op) + sizeof(b)], operand.data, operand.size);
+        return encoded;
+    }
+
+    bool FullMergeV2(const MergeOperationInput& merge_in,
+                     MergeOperationOutput* merge_out) const override {
+        auto& value = merge_out->new_value;
+        if(merge_in.existing_value)
+            value.assign(merge_in.existing_value->data(),
+                         merge_in.existing_value->size());
+        else
+            value.clear();
+        for(const auto& encoded : merge_in.operand_list) {
+            int32_t op;
+            uint64_t bound;
+            if(encoded.size() < sizeof(op) + sizeof(bound)) continue;
+            std::memcpy(&op, encoded.data(), sizeof(op));
+            std::memcpy(&bound, encoded.data() + sizeof(op), sizeof(bound));
+            auto operand = UserMem{
+                const_cast<char*>(encoded.data()) + sizeof(op) + sizeof(bound),
+                encoded.size() - sizeof(op) - sizeof(bound) };
+            // operands are validated before being written, and the
+            // operators that depend on the existing value are not applied
+            // through Merge, so this should not fail; if it does, report
+            // the corruption rather than dropping the operand
+            if(applyMerge(op, operand, bound, value) != Status::OK)
+                return false;
+        }
+        return true;
+    }
+
+    const char* Name() const override {
+        return "YokanMergeOperator";
+    }
+};
+
 class RocksDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
 
     public:
@@ -220,6 +275,11 @@ class RocksDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
 
         CHECK_AND_ADD_MISSING(cfg["write_options"], "use_write_batch", boolean, false);
 
+        // collect tickers (block cache hits/misses, etc.) reported by stats()
+        CHECK_AND_ADD_MISSING(cfg, "enable_statistics", boolean, false);
+        if(cfg["enable_statistics"].get<bool>())
+            options.statistics = rocksdb::CreateDBStatistics();
+
         if(cfg.contains("logger_redirects_to_margo")) {
             auto& logger_redirects_to_margo = cfg["logger_redirects_to_margo"];
             if(!logger_redirects_to_margo.is_boolean()) {
@@ -284,6 +344,7 @@ class RocksDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
                         p["target_size"].get<uint64_t>());
             }
         }
+        options.merge_operator = std::make_shared<RocksDBMergeOperator>();
         if(!cfg.contains("path")) {
             YOKAN_LOG_ERROR(MARGO_INSTANCE_NULL,
                 "path field not found in database configuration");
@@ -365,6 +426,56 @@ class RocksDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
         return m_config.dump();
     }
     // LCOV_EXCL_STOP
+
+    virtual std::string stats() const override {
+        ScopedReadLock mlock(m_migration_lock);
+        if(m_migrated) return "{}";
+        static const char* int_properties[] = {
+            "rocksdb.estimate-num-keys",
+            "rocksdb.cur-size-all-mem-tables",
+            "rocksdb.estimate-table-readers-mem",
+            "rocksdb.block-cache-capacity",
+            "rocksdb.block-cache-usage",
+            "rocksdb.block-cache-pinned-usage",
+            "rocksdb.total-sst-files-size",
+            "rocksdb.live-sst-files-size",
+            "rocksdb.estimate-pending-compaction-bytes",
+            "rocksdb.num-running-compactions",
+            "rocksdb.num-running-flushes",
+            "rocksdb.is-write-stopped",
+            "rocksdb.actual-delayed-write-rate"
+        };
+        json properties = json::object();
+        for(auto property : int_properties) {
+            uint64_t value;
+            if(m_db->GetIntProperty(property, &value))
+                properties[property] = value;
+        }
+        std::string db_stats;
+        if(m_db->GetProperty("rocksdb.stats", &db_stats))
+            properties["rocksdb.stats"] = db_stats;
+        json result = {
+            {"entries",    properties.value("rocksdb.estimate-num-keys", (uint64_t)0)},
+            {"memory",     properties.value("rocksdb.cur-size-all-mem-tables", (uint64_t)0)
+                         + properties.value("rocksdb.estimate-table-readers-mem", (uint64_t)0)
+                         + properties.value("rocksdb.block-cache-usage", (uint64_t)0)},
+            {"properties", properties}
+        };
+        auto statistics = m_db->GetDBOptions().statistics;
+        if(statistics) {
+            auto hits   = statistics->getTickerCount(rocksdb::BLOCK_CACHE_HIT);
+            auto misses = statistics->getTickerCount(rocksdb::BLOCK_CACHE_MISS);
+            result["block_cache"] = {
+                {"hits",     hits},
+                {"misses",   misses},
+                {"hit_rate", hits + misses ? (double)hits/(hits + misses) : 0.0}
+            };
+            result["bytes_read"]    = statistics->getTickerCount(rocksdb::BYTES_READ);
+            result["bytes_written"] = statistics->getTickerCount(rocksdb::BYTES_WRITTEN);
+            result["stall_micros"]  = statistics->getTickerCount(rocksdb::STALL_MICROS);
+        }
+        return result.dump();
+    }
     virtual bool supportsMode(int32_t mode) const override {
         return mode ==
             (mode & (
@@ -697,6 +808,67 @@ class RocksDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
         return convertStatus(status);
     }
 
+    virtual Status compareAndSwap(int32_t mode, const UserMem& key,
+                                  const UserMem& expected,
+                                  const UserMem& value,
+                                  bool* swapped) override {
+        // RocksDB has no per-key lock, so the comparison and the replacement
+        // exclude all the other writers by taking the migration lock in
+        // write mode (writers take it in read mode)
+        ScopedWriteLock mlock(m_migration_lock);
+        if(m_migrated) return Status::Migrated;
+        (void)mode;
+        *swapped = false;
+        rocksdb::Slice k{ key.data, key.size };
+        std::string current;
+        auto status = m_db->Get(m_read_options, k, &current);
+        if(!status.ok()) return convertStatus(status);
+        if(current.size() != expected.size
+        || std::memcmp(current.data(), expected.data, expected.size) != 0)
+            return Status::OK;
+        status = m_db->Put(m_write_options, k, rocksdb::Slice{ value.data, value.size });
+        if(status.ok()) *swapped = true;
+        return convertStatus(status);
+    }
+
+    virtual Status merge(int32_t mode, const UserMem& key,
+                         int32_t op, const UserMem& operand,
+                         size_t bound, const MergeCallback& func) override {
+        (void)mode;
+        rocksdb::Slice k{ key.data, key.size };
+        // check the operator and the operand up front, since the merge
+        // operator cannot report errors back to the caller
+        {
+            std::string probe;
+            auto status = applyMerge(op, operand, bound, probe);
+            if(status != Status::OK) return status;
+        }
+        // the integer operators fail on existing values that are not
+        // 8 bytes long, which only the Get+Put path below can report
+        bool native = !func
+                   && op != YOKAN_MERGE_ADD_INT64
+                   && op != YOKAN_MERGE_MAX_INT64;
+        if(native) {
+            // the new value is not needed, let RocksDB apply the operator
+            ScopedReadLock mlock(m_migration_lock);
+            if(m_migrated) return Status::Migrated;
+            auto status = m_db->Merge(m_write_options, k,
+                RocksDBMergeOperator::encode(op, bound, operand));
+            return convertStatus(status);
+        }
+        ScopedWriteLock mlock(m_migration_lock);
+        if(m_migrated) return Status::Migrated;
+        std::string value;
+        auto status = m_db->Get(m_read_options, k, &value);
+        if(!status.ok() && !status.IsNotFound()) return convertStatus(status);
+        auto s = applyMerge(op, operand, bound, value);
+        if(s != Status::OK) return s;
+        status = m_db->Put(m_write_options, k, value);
+        if(!status.ok()) return convertStatus(status);
+        if(func) func(UserMem{ value.data(), value.size() });
+        return Status::OK;
+    }
+
     virtual Status listKeys(int32_t mode, bool packed, const UserMem& fromKey,
                             const std::shared_ptr<KeyValueFilter>& filter,
                             UserMem& keys, BasicUserMem<size_t>& keySizes) const override {
@@ -978,6 +1150,7 @@ class RocksDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
     ~RocksDBDatabase() {
         if(m_db)
             delete m_db;
+        YOKAN_UNPROFILE_LOCK(m_migration_lock);
         ABT_rwlock_free(&m_migration_lock);
     }
 
@@ -1016,6 +1189,7 @@ class RocksDBDatabase : public DocumentStoreMixin<DatabaseInterface> {
         if(disable_doc_mixin_lock) disableDocMixinLock();
 
         ABT_rwlock_create(&m_migration_lock);
+        YOKAN_PROFILE_LOCK(m_migration_lock, this, "migration");
     }
 
     rocksdb::DB*          m_db;
@@ -189,6 +189,22 @@ class SetDatabase : public DatabaseInterface {
     }
     // LCOV_EXCL_STOP
 
+    virtual std::string stats() const override {
+        ScopedReadLock lock(m_lock);
+        json allocators = json::object();
+        size_t memory = 0;
+        allocators["node"] = allocator_usage(m_node_allocator);
+        memory += allocators["node"]["bytes"].get<size_t>();
+        allocators["key"] = allocator_usage(m_key_allocator);
+        memory += allocators["key"]["bytes"].get<size_t>();
+        json result = {
+            {"entries",    m_db->size()},
+            {"memory",     memory},
+            {"allocators", allocators}
+        };
+        return result.dump();
+    }
+
     virtual bool supportsMode(int32_t mode) const override {
         // note: technically YOKAN_MODE_APPEND, NEW_ONLY, and EXIST_ONLY
         // are supported but they are useless for a backend that doesn't
@@ -764,8 +780,10 @@ class SetDatabase : public DatabaseInterface {
     }
 
     ~SetDatabase() {
-        if(m_lock != ABT_RWLOCK_NULL)
+        if(m_lock != ABT_RWLOCK_NULL) {
+            YOKAN_UNPROFILE_LOCK(m_lock);
             ABT_rwlock_free(&m_lock);
+        }
         delete m_db;
         m_key_allocator.finalize(m_key_allocator.context);
         m_node_allocator.finalize(m_node_allocator.context);
@@ -788,8 +806,12 @@ class SetDatabase : public DatabaseInterface {
     , m_node_allocator(node_allocator)
     , m_key_allocator(key_allocator)
     {
-        if(m_config["use_lock"].get<bool>())
+        wrap_counting_allocator(&m_node_allocator);
+        wrap_counting_allocator(&m_key_allocator);
+        if(m_config["use_lock"].get<bool>()) {
             ABT_rwlock_create(&m_lock);
+            YOKAN_PROFILE_LOCK(m_lock, this, "db");
+        }
         m_db = new set_type(cmp_fun, allocator(m_node_allocator));
     }
 
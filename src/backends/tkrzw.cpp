@@ -14,12 +14,18 @@
 #include <tkrzw_dbm_skip.h>
 #include <tkrzw_dbm_tiny.h>
 #include <tkrzw_dbm_baby.h>
+#include <tkrzw_dbm_shard.h>
+#include <tkrzw_dbm_async.h>
 #include <nlohmann/json.hpp>
 #include <abt.h>
 #include <string>
 #include <cstring>
 #include <iostream>
 #include <filesystem>
+#include <future>
+#include <chrono>
+#include <map>
+#include <unordered_set>
 
 namespace yokan {
 
@@ -124,6 +130,8 @@ class TkrzwDatabase : public DocumentStoreMixin<DatabaseInterface> {
             }
             CHECK_TYPE_AND_COMPLETE(cfg, "writable", boolean, true, false);
             CHECK_TYPE_AND_COMPLETE(cfg, "path", string, "", true);
+            CHECK_TYPE_AND_COMPLETE(cfg, "num_shards", number_unsigned, 0, false);
+            CHECK_TYPE_AND_COMPLETE(cfg, "async_threads", number_unsigned, 0, false);
         } catch(const std::exception& ex) {
             return Status::InvalidConf;
         }
@@ -232,12 +240,31 @@ class TkrzwDatabase : public DocumentStoreMixin<DatabaseInterface> {
             return params;
     }
 
-    static Status create(const std::string& config, DatabaseInterface** kvs) {
-        json cfg;
-
-        if(processConfig(config, cfg) != Status::OK)
-            return Status::InvalidConf;
+    static std::map<std::string, std::string> createShardDBMParams(const json& cfg) {
+        static const std::map<std::string, std::string> dbm_classes = {
+            {"hash", "HashDBM"}, {"tree", "TreeDBM"},
+            {"tiny", "TinyDBM"}, {"baby", "BabyDBM"}
+        };
+        std::map<std::string, std::string> params;
+        params["dbm"] = dbm_classes.at(cfg["type"].get<std::string>());
+        params["num_shards"] = std::to_string(cfg["num_shards"].get<int32_t>());
+        for(auto field : {"offset_width", "align_pow", "num_buckets", "fbp_capacity",
+                          "min_read_size", "max_page_size", "max_branches",
+                          "max_cached_pages"}) {
+            if(cfg.contains(field) && cfg[field].get<int64_t>() > 0)
+                params[field] = std::to_string(cfg[field].get<int64_t>());
+        }
+        auto update_mode = cfg.value("update_mode", "default");
+        if(update_mode == "in_place")
+            params["update_mode"] = "UPDATE_IN_PLACE";
+        else if(update_mode == "appending")
+            params["update_mode"] = "UPDATE_APPENDING";
+        if(cfg.value("cache_buckets", false))
+            params["cache_buckets"] = "true";
+        return params;
+    }
 
+    static Status openDBM(const json& cfg, tkrzw::DBM** dbm) {
         auto path = cfg["path"].get<std::string>();
         auto writable = cfg["writable"].get<bool>();
 
@@ -246,7 +273,14 @@ class TkrzwDatabase : public DocumentStoreMixin<DatabaseInterface> {
         auto& type = cfg["type"].get_ref<const std::string&>();
 
         tkrzw::Status status;
-        if(type == "hash") {
+        if(cfg["num_shards"].get<int32_t>() > 0) {
+            // the ShardDBM dispatches keys to num_shards files of the
+            // requested type, named path-XXXXX-of-YYYYY
+            auto params = createShardDBMParams(cfg);
+            auto tmp = new tkrzw::ShardDBM{};
+            status = tmp->OpenAdvanced(path, writable, tkrzw::File::OPEN_DEFAULT, params);
+            db = tmp;
+        } else if(type == "hash") {
             auto params = createHashDBMTunningParameter(cfg);
             auto tmp = new tkrzw::HashDBM{};
             status = tmp->OpenAdvanced(path, writable, tkrzw::File::OPEN_DEFAULT, params);
@@ -273,6 +307,20 @@ class TkrzwDatabase : public DocumentStoreMixin<DatabaseInterface> {
             delete db;
             return convertStatus(status);
         }
+        *dbm = db;
+        return Status::OK;
+    }
+
+    static Status create(const std::string& config, DatabaseInterface** kvs) {
+        json cfg;
+
+        if(processConfig(config, cfg) != Status::OK)
+            return Status::InvalidConf;
+
+        tkrzw::DBM* db = nullptr;
+        auto status = openDBM(cfg, &db);
+        if(status != Status::OK)
+            return status;
         *kvs = new TkrzwDatabase(std::move(cfg), db);
         return Status::OK;
     }
@@ -293,40 +341,10 @@ class TkrzwDatabase : public DocumentStoreMixin<DatabaseInterface> {
         std::string path = root + "/" + files.front();
         cfg["path"] = path;
 
-        auto writable = cfg["writable"].get<bool>();
-
         tkrzw::DBM* db = nullptr;
-
-        auto& type = cfg["type"].get_ref<const std::string&>();
-
-        tkrzw::Status status;
-        if(type == "hash") {
-            auto params = createHashDBMTunningParameter(cfg);
-            auto tmp = new tkrzw::HashDBM{};
-            status = tmp->OpenAdvanced(path, writable, tkrzw::File::OPEN_DEFAULT, params);
-            db = tmp;
-        } else if(type == "tree") {
-            auto params = createTreeDBMTuningParameters(cfg);
-            auto tmp = new tkrzw::TreeDBM{};
-            status = tmp->OpenAdvanced(path, writable, tkrzw::File::OPEN_DEFAULT, params);
-            db = tmp;
-        } else if(type == "tiny") {
-            auto num_buckets = cfg["num_buckets"].get<int64_t>();
-            auto tmp = new tkrzw::TinyDBM{num_buckets};
-            status = tmp->Open(path, writable);
-            db = tmp;
-        } else if(type == "baby") {
-            auto key_comparator_name = cfg["key_comparator"].get<std::string>();
-            // TODO add support for key_comparator
-            auto tmp = new tkrzw::BabyDBM{};
-            status = tmp->Open(path, writable);
-            db = tmp;
-        }
-
-        if(!status.IsOK()) {
-            delete db;
-            return convertStatus(status);
-        }
+        auto status = openDBM(cfg, &db);
+        if(status != Status::OK)
+            return status;
         *kvs = new TkrzwDatabase(std::move(cfg), db);
         return Status::OK;
     }
@@ -343,6 +361,19 @@ class TkrzwDatabase : public DocumentStoreMixin<DatabaseInterface> {
     }
     // LCOV_EXCL_STOP
 
+    virtual std::string stats() const override {
+        ScopedReadLock mlock(m_migration_lock);
+        if(m_migrated || !m_db) return "{}";
+        json properties = json::object();
+        for(auto& p : m_db->Inspect())
+            properties[p.first] = p.second;
+        return json{
+            {"entries",    m_db->CountSimple()},
+            {"file_size",  m_db->GetFileSizeSimple()},
+            {"properties", properties}
+        }.dump();
+    }
+
     virtual bool supportsMode(int32_t mode) const override {
         return mode ==
             (mode & (
@@ -377,10 +408,20 @@ class TkrzwDatabase : public DocumentStoreMixin<DatabaseInterface> {
         if(!m_db) return;
         auto path = m_config["path"].get<std::string>();
         auto type = m_config["type"].get<std::string>();
+        auto num_shards = m_config["num_shards"].get<int32_t>();
+        m_async.reset();
         m_db->Close();
         delete m_db;
         m_db = nullptr;
-        std::filesystem::remove(path);
+        if(num_shards == 0) {
+            std::filesystem::remove(path);
+        } else {
+            for(int32_t i = 0; i < num_shards; ++i) {
+                char suffix[64];
+                std::snprintf(suffix, sizeof(suffix), "-%05d-of-%05d", i, num_shards);
+                std::filesystem::remove(path + suffix);
+            }
+        }
     }
 
     virtual Status count(int32_t mode, uint64_t* c) const override {
@@ -483,6 +524,25 @@ class TkrzwDatabase : public DocumentStoreMixin<DatabaseInterface> {
 
         bool overwrite = !mode_new_only;
 
+        // the AsyncDBM workers may reorder the updates, so batches that update
+        // the same key more than once are applied sequentially
+        if(m_async && ksizes.size > 1 && !hasDuplicateKeys(keys, ksizes)) {
+            // submit all the updates to the AsyncDBM and wait for them together
+            std::vector<std::future<tkrzw::Status>> futures;
+            futures.reserve(ksizes.size);
+            for(size_t i = 0; i < ksizes.size; i++) {
+                std::string_view key{ keys.data + key_offset, ksizes[i] };
+                std::string_view val{ vals.data + val_offset, vsizes[i] };
+                if(!mode_append)
+                    futures.push_back(m_async->Set(key, val, overwrite));
+                else
+                    futures.push_back(m_async->Append(key, val));
+                key_offset += ksizes[i];
+                val_offset += vsizes[i];
+            }
+            return waitForAll(futures);
+        }
+
         for(size_t i = 0; i < ksizes.size; i++) {
             tkrzw::Status status;
             if(!mode_append) {
@@ -565,9 +625,15 @@ class TkrzwDatabase : public DocumentStoreMixin<DatabaseInterface> {
         size_t i = 0;
         auto get_value = GetValue(i, vsizes, vals, packed);
 
+        std::vector<GetFuture> futures;
+        if(m_async && ksizes.size > 1)
+            futures = submitGets(keys, ksizes);
+
         for(; i < ksizes.size; i++) {
-            auto status = m_db->Process({ keys.data + key_offset, ksizes[i] },
-                                        &get_value, false);
+            std::string_view key{ keys.data + key_offset, ksizes[i] };
+            auto status = futures.empty() ?
+                m_db->Process(key, &get_value, false)
+              : processGetResult(key, futures[i], &get_value);
             if(!status.IsOK()) {
                 return convertStatus(status);
             }
@@ -622,9 +688,15 @@ class TkrzwDatabase : public DocumentStoreMixin<DatabaseInterface> {
 
         auto fetch_value = FetchValue{func, func_status};
 
+        std::vector<GetFuture> futures;
+        if(m_async && ksizes.size > 1)
+            futures = submitGets(keys, ksizes);
+
         for(; i < ksizes.size; i++) {
-            auto status = m_db->Process({ keys.data + key_offset, ksizes[i] },
-                                        &fetch_value, false);
+            std::string_view key{ keys.data + key_offset, ksizes[i] };
+            auto status = futures.empty() ?
+                m_db->Process(key, &fetch_value, false)
+              : processGetResult(key, futures[i], &fetch_value);
             if(!status.IsOK()) {
                 return convertStatus(status);
             }
@@ -645,6 +717,19 @@ class TkrzwDatabase : public DocumentStoreMixin<DatabaseInterface> {
         ScopedReadLock mlock(m_migration_lock);
         if(m_migrated) return Status::Migrated;
         size_t offset = 0;
+        if(m_async && ksizes.size > 1) {
+            size_t total_ksizes = std::accumulate(ksizes.data,
+                                                  ksizes.data + ksizes.size,
+                                                  (size_t)0);
+            if(total_ksizes > keys.size) return Status::InvalidArg;
+            std::vector<std::future<tkrzw::Status>> futures;
+            futures.reserve(ksizes.size);
+            for(size_t i = 0; i < ksizes.size; i++) {
+                futures.push_back(m_async->Remove({ keys.data + offset, ksizes[i] }));
+                offset += ksizes[i];
+            }
+            return waitForAll(futures);
+        }
         for(size_t i = 0; i < ksizes.size; i++) {
             if(offset + ksizes[i] > keys.size) return Status::InvalidArg;
             auto status = m_db->Remove({ keys.data + offset, ksizes[i] });
@@ -1095,6 +1180,8 @@ class TkrzwDatabase : public DocumentStoreMixin<DatabaseInterface> {
         if(m_migrated) return Status::Migrated;
         if(m_config["type"] == "tiny" || m_config["type"] == "baby")
             return Status::NotSupported;
+        if(m_config["num_shards"].get<int32_t>() > 0)
+            return Status::NotSupported;
         try {
             mh.reset(new TkrzwDBMigrationHandle(*this));
         } catch(...) {
@@ -1104,10 +1191,12 @@ class TkrzwDatabase : public DocumentStoreMixin<DatabaseInterface> {
     }
 
     ~TkrzwDatabase() {
+        m_async.reset();
         if(m_db) {
             m_db->Close();
             delete m_db;
         }
+        YOKAN_UNPROFILE_LOCK(m_migration_lock);
         ABT_rwlock_free(&m_migration_lock);
     }
 
@@ -1116,6 +1205,11 @@ class TkrzwDatabase : public DocumentStoreMixin<DatabaseInterface> {
     json        m_config;
     tkrzw::DBM* m_db = nullptr;
 
+    /* When async_threads > 0, multi-key put, get, fetch, and erase
+     * operations are submitted as a batch to this AsyncDBM's task
+     * queue, then awaited together (see waitFor). */
+    std::unique_ptr<tkrzw::AsyncDBM> m_async;
+
     bool       m_migrated = false;
     ABT_rwlock m_migration_lock = ABT_RWLOCK_NULL;
 
@@ -1125,7 +1219,77 @@ class TkrzwDatabase : public DocumentStoreMixin<DatabaseInterface> {
     {
         auto disable_doc_mixin_lock = m_config.value("disable_doc_mixin_lock", false);
         if(disable_doc_mixin_lock) disableDocMixinLock();
+        auto async_threads = m_config["async_threads"].get<int32_t>();
+        if(async_threads > 0)
+            m_async = std::make_unique<tkrzw::AsyncDBM>(m_db, async_threads);
         ABT_rwlock_create(&m_migration_lock);
+        YOKAN_PROFILE_LOCK(m_migration_lock, this, "migration");
+    }
+
+    using GetFuture = std::future<std::pair<tkrzw::Status, std::string>>;
+
+    std::vector<GetFuture> submitGets(const UserMem& keys,
+                                      const BasicUserMem<size_t>& ksizes) const {
+        std::vector<GetFuture> futures;
+        futures.reserve(ksizes.size);
+        size_t offset = 0;
+        for(size_t i = 0; i < ksizes.size; i++) {
+            futures.push_back(m_async->Get({ keys.data + offset, ksizes[i] }));
+            offset += ksizes[i];
+        }
+        return futures;
+    }
+
+    static bool hasDuplicateKeys(const UserMem& keys,
+                                 const BasicUserMem<size_t>& ksizes) {
+        std::unordered_set<std::string_view> seen;
+        seen.reserve(ksizes.size);
+        size_t offset = 0;
+        for(size_t i = 0; i < ksizes.size; i++) {
+            if(!seen.emplace(keys.data + offset, ksizes[i]).second)
+                return true;
+            offset += ksizes[i];
+        }
+        return false;
+    }
+
+    /* Waits for a future without blocking the execution stream:
+     * the calling ULT yields until the AsyncDBM worker is done,
+     * so other ULTs can run in the meantime. */
+    template<typename T>
+    static T waitFor(std::future<T>& future) {
+        while(future.wait_for(std::chrono::seconds::zero()) != std::future_status::ready)
+            ABT_thread_yield();
+        return future.get();
+    }
+
+    /* Waits for the result of an asynchronous Get and feeds it
+     * to the processor, as DBM::Process would have done. */
+    static tkrzw::Status processGetResult(std::string_view key, GetFuture& future,
+                                          tkrzw::DBM::RecordProcessor* proc) {
+        auto result = waitFor(future);
+        if(result.first.IsOK())
+            proc->ProcessFull(key, result.second);
+        else if(result.first == tkrzw::Status::NOT_FOUND_ERROR)
+            proc->ProcessEmpty(key);
+        else
+            return result.first;
+        return tkrzw::Status(tkrzw::Status::SUCCESS);
+    }
+
+    /* Waits for all the futures and returns the first error, ignoring
+     * DUPLICATION_ERROR (NEW_ONLY put) and NOT_FOUND_ERROR (erase). */
+    static Status waitForAll(std::vector<std::future<tkrzw::Status>>& futures) {
+        Status ret = Status::OK;
+        for(auto& f : futures) {
+            auto status = waitFor(f);
+            if(status.IsOK()
+            || status == tkrzw::Status::DUPLICATION_ERROR
+            || status == tkrzw::Status::NOT_FOUND_ERROR)
+                continue;
+            if(ret == Status::OK) ret = convertStatus(status);
+        }
+        return ret;
     }
 };
 
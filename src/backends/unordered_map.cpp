@@ -243,6 +243,26 @@ class UnorderedMapDatabase : public DocumentStoreMixin<DatabaseInterface> {
     }
     // LCOV_EXCL_STOP
 
+    virtual std::string stats() const override {
+        ScopedReadLock lock(m_lock);
+        json allocators = json::object();
+        size_t memory = 0;
+        allocators["node"] = allocator_usage(m_node_allocator);
+        memory += allocators["node"]["bytes"].get<size_t>();
+        allocators["key"] = allocator_usage(m_key_allocator);
+        memory += allocators["key"]["bytes"].get<size_t>();
+        allocators["value"] = allocator_usage(m_val_allocator);
+        memory += allocators["value"]["bytes"].get<size_t>();
+        json result = {
+            {"entries",    m_db->size()},
+            {"memory",     memory},
+            {"allocators", allocators}
+        };
+        result["bucket_count"] = m_db->bucket_count();
+        result["load_factor"]  = m_db->load_factor();
+        return result.dump();
+    }
+
     virtual bool supportsMode(int32_t mode) const override {
         // note we mark YOKAN_MODE_IGNORE_KEYS, KEEP_LAST, and SUFFIX
         // as supported, but the listKeys and listKeyvals are not
@@ -716,8 +736,10 @@ class UnorderedMapDatabase : public DocumentStoreMixin<DatabaseInterface> {
     }
 
     ~UnorderedMapDatabase() {
-        if(m_lock != ABT_RWLOCK_NULL)
+        if(m_lock != ABT_RWLOCK_NULL) {
+            YOKAN_UNPROFILE_LOCK(m_lock);
             ABT_rwlock_free(&m_lock);
+        }
         delete m_db;
         m_key_allocator.finalize(m_key_allocator.context);
         m_val_allocator.finalize(m_val_allocator.context);
@@ -744,8 +766,13 @@ class UnorderedMapDatabase : public DocumentStoreMixin<DatabaseInterface> {
     , m_key_allocator(key_allocator)
     , m_val_allocator(val_allocator)
     {
-        if(m_config["use_lock"].get<bool>())
+        wrap_counting_allocator(&m_node_allocator);
+        wrap_counting_allocator(&m_key_allocator);
+        wrap_counting_allocator(&m_val_allocator);
+        if(m_config["use_lock"].get<bool>()) {
             ABT_rwlock_create(&m_lock);
+            YOKAN_PROFILE_LOCK(m_lock, this, "db");
+        }
         m_db = new unordered_map_type(
                 m_config["initial_bucket_count"].get<size_t>(),
                 hash_type(),
@@ -217,6 +217,24 @@ class UnorderedSetDatabase : public DatabaseInterface {
     }
     // LCOV_EXCL_STOP
 
+    virtual std::string stats() const override {
+        ScopedReadLock lock(m_lock);
+        json allocators = json::object();
+        size_t memory = 0;
+        allocators["node"] = allocator_usage(m_node_allocator);
+        memory += allocators["node"]["bytes"].get<size_t>();
+        allocators["key"] = allocator_usage(m_key_allocator);
+        memory += allocators["key"]["bytes"].get<size_t>();
+        json result = {
+            {"entries",    m_db->size()},
+            {"memory",     memory},
+            {"allocators", allocators}
+        };
+        result["bucket_count"] = m_db->bucket_count();
+        result["load_factor"]  = m_db->load_factor();
+        return result.dump();
+    }
+
     virtual bool supportsMode(int32_t mode) const override {
         // note: YOKAN_MODE_APPEND, NEW_ONLY, and EXIST_ONLY
         // are marked as supported but they don't really do
@@ -502,8 +520,10 @@ class UnorderedSetDatabase : public DatabaseInterface {
     }
 
     ~UnorderedSetDatabase() {
-        if(m_lock != ABT_RWLOCK_NULL)
+        if(m_lock != ABT_RWLOCK_NULL) {
+            YOKAN_UNPROFILE_LOCK(m_lock);
             ABT_rwlock_free(&m_lock);
+        }
         delete m_db;
         m_key_allocator.finalize(m_key_allocator.context);
         m_node_allocator.finalize(m_node_allocator.context);
@@ -525,8 +545,12 @@ class UnorderedSetDatabase : public DatabaseInterface {
     , m_node_allocator(node_allocator)
     , m_key_allocator(key_allocator)
     {
-        if(m_config["use_lock"].get<bool>())
+        wrap_counting_allocator(&m_node_allocator);
+        wrap_counting_allocator(&m_key_allocator);
+        if(m_config["use_lock"].get<bool>()) {
             ABT_rwlock_create(&m_lock);
+            YOKAN_PROFILE_LOCK(m_lock, this, "db");
+        }
         m_db = new unordered_set_type(
                 m_config["initial_bucket_count"].get<size_t>(),
                 hash_type(),
@@ -926,8 +926,10 @@ class UnQLiteDatabase : public DocumentStoreMixin<DatabaseInterface> {
     }
 
     ~UnQLiteDatabase() {
-        if(m_lock != ABT_RWLOCK_NULL)
+        if(m_lock != ABT_RWLOCK_NULL) {
+            YOKAN_UNPROFILE_LOCK(m_lock);
             ABT_rwlock_free(&m_lock);
+        }
         if(m_db)
             unqlite_close(m_db);
     }
@@ -938,8 +940,10 @@ class UnQLiteDatabase : public DocumentStoreMixin<DatabaseInterface> {
     : m_db(db)
     , m_config(std::move(cfg))
     {
-        if(use_lock)
+        if(use_lock) {
             ABT_rwlock_create(&m_lock);
+            YOKAN_PROFILE_LOCK(m_lock, this, "db");
+        }
         auto disable_doc_mixin_lock = m_config.value("disable_doc_mixin_lock", false);
         if(disable_doc_mixin_lock) disableDocMixinLock();
     }
@@ -0,0 +1,61 @@
+/*
+ * (C) 2026 The University of Chicago
+ *
+ * See COPYRIGHT in top-level directory.
+ */
+#ifndef __YOKAN_BACKEND_UTIL_MERGE_HPP
+#define __YOKAN_BACKEND_UTIL_MERGE_HPP
+
+#include "yokan/backend.hpp"
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+
+namespace yokan {
+
+/**
+ * This function applies one of the YOKAN_MERGE_* operators to a value,
+ * in place. The Value type must behave like an std::string or an
+ * std::vector<char>. Backends call it while holding whatever lock or
+ * transaction makes the read-modify-write atomic.
+ */
+template<typename Value>
+static inline Status applyMerge(int32_t op, const UserMem& operand,
+                                size_t bound, Value& value) {
+    switch(op) {
+    case YOKAN_MERGE_ADD_INT64:
+    case YOKAN_MERGE_MAX_INT64:
+        {
+            if(operand.size != sizeof(int64_t)) return Status::InvalidArg;
+            if(value.size() != 0 && value.size() != sizeof(int64_t))
+                return Status::InvalidArg;
+            int64_t x = 0, y = 0;
+            if(value.size()) std::memcpy(&x, value.data(), sizeof(x));
+            std::memcpy(&y, operand.data, sizeof(y));
+            if(op == YOKAN_MERGE_ADD_INT64)
+                x = (int64_t)((uint64_t)x + (uint64_t)y);
+            else
+                x = std::max(x, y);
+            value.resize(sizeof(x));
+            std::memcpy(&value[0], &x, sizeof(x));
+        }
+        return Status::OK;
+    case YOKAN_MERGE_BIT_OR:
+        if(value.size() < operand.size)
+            value.resize(operand.size, '\0');
+        for(size_t i = 0; i < operand.size; i++)
+            value[i] |= operand.data[i];
+        return Status::OK;
+    case YOKAN_MERGE_APPEND:
+        value.insert(value.end(), operand.data, operand.data + operand.size);
+        if(bound && value.size() > bound)
+            value.erase(value.begin(), value.begin() + (value.size() - bound));
+        return Status::OK;
+    default:
+        return Status::InvalidArg;
+    }
+}
+
+}
+
+#endif
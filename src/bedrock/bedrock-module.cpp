@@ -30,7 +30,12 @@ class YokanComponent : public bedrock::AbstractComponent {
     }
 
     std::string getConfig() override {
-        return m_provider->getConfig();
+        // the provider's statistics (RPC metrics and backend statistics)
+        // are appended to its configuration
+        // (yk_provider_register ignores the "stats" field)
+        auto config = nlohmann::json::parse(m_provider->getConfig());
+        config["stats"] = nlohmann::json::parse(m_provider->getStats());
+        return config.dump();
     }
 
     void snapshot(const std::string& dest_path,
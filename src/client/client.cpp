@@ -6,16 +6,31 @@
 #include "../common/types.h"
 #include "client.hpp"
 #include "yokan/client.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <iterator>
+#include <new>
+#include <cstring>
 #include <stdio.h>
 
 extern "C" yk_return_t yk_client_init(margo_instance_id mid, yk_client_t* client)
 {
-    yk_client_t c = (yk_client_t)calloc(1, sizeof(*c));
+    yk_client_t c = new (std::nothrow) yk_client{};
     if(!c) return YOKAN_ERR_ALLOCATION;
 
     c->mid = mid;
     margo_instance_ref_incr(mid);
 
+    // by default, data that fits in Mercury's eager buffers in both
+    // directions is sent along with the RPC instead of using RDMA
+    hg_class_t* hg_class = margo_get_class(mid);
+    c->direct_threshold = std::min<size_t>(
+        HG_Class_get_input_eager_size(hg_class),
+        HG_Class_get_output_eager_size(hg_class));
+
+    ABT_mutex_create(&c->bulk_cache_mtx);
+    c->bulk_cache_capacity = 64;
+
     hg_bool_t flag;
     hg_id_t id;
     margo_registered_name(mid, "yk_exists", &id, &flag);
@@ -31,11 +46,17 @@ extern "C" yk_return_t yk_client_init(margo_instance_id mid, yk_client_t* client
         margo_registered_name(mid, "yk_put_direct",          &c->put_direct_id,          &flag);
         margo_registered_name(mid, "yk_get",                 &c->get_id,                 &flag);
         margo_registered_name(mid, "yk_get_direct",          &c->get_direct_id,          &flag);
+        margo_registered_name(mid, "yk_get_alloc",           &c->get_alloc_id,           &flag);
+        margo_registered_name(mid, "yk_get_alloc_release",   &c->get_alloc_release_id,   &flag);
         margo_registered_name(mid, "yk_fetch",               &c->fetch_id,               &flag);
         margo_registered_name(mid, "yk_fetch_direct",        &c->fetch_direct_id,        &flag);
         margo_registered_name(mid, "yk_erase",               &c->erase_id,               &flag);
         margo_registered_name(mid, "yk_erase_direct",        &c->erase_direct_id,        &flag);
         margo_registered_name(mid, "yk_erase_range",         &c->erase_range_id,         &flag);
+        margo_registered_name(mid, "yk_get_range",           &c->get_range_id,           &flag);
+        margo_registered_name(mid, "yk_put_range",           &c->put_range_id,           &flag);
+        margo_registered_name(mid, "yk_compare_and_swap",    &c->compare_and_swap_id,    &flag);
+        margo_registered_name(mid, "yk_merge",               &c->merge_id,               &flag);
         margo_registered_name(mid, "yk_list_keys",           &c->list_keys_id,           &flag);
         margo_registered_name(mid, "yk_list_keys_direct",    &c->list_keys_direct_id,    &flag);
         margo_registered_name(mid, "yk_list_keyvals",        &c->list_keyvals_id,        &flag);
@@ -62,6 +83,8 @@ extern "C" yk_return_t yk_client_init(margo_instance_id mid, yk_client_t* client
         margo_registered_name(mid, "yk_doc_iter",         &c->doc_iter_id,         &flag);
         margo_registered_name(mid, "yk_doc_iter_direct",  &c->doc_iter_direct_id,  &flag);
 
+        margo_registered_name(mid, "yk_get_stats",        &c->get_stats_id,        &flag);
+
     } else {
 
         c->count_id =
@@ -91,6 +114,13 @@ extern "C" yk_return_t yk_client_init(margo_instance_id mid, yk_client_t* client
         c->get_direct_id =
             MARGO_REGISTER(mid, "yk_get_direct",
                            get_direct_in_t, get_direct_out_t, NULL);
+        c->get_alloc_id =
+            MARGO_REGISTER(mid, "yk_get_alloc",
+                           get_alloc_in_t, get_alloc_out_t, NULL);
+        c->get_alloc_release_id =
+            MARGO_REGISTER(mid, "yk_get_alloc_release",
+                           get_alloc_release_in_t, void, NULL);
+        margo_registered_disable_response(mid, c->get_alloc_release_id, HG_TRUE);
         c->fetch_id =
             MARGO_REGISTER(mid, "yk_fetch",
                            fetch_in_t, fetch_out_t, NULL);
@@ -106,6 +136,18 @@ extern "C" yk_return_t yk_client_init(margo_instance_id mid, yk_client_t* client
         c->erase_range_id =
             MARGO_REGISTER(mid, "yk_erase_range",
                            erase_range_in_t, erase_range_out_t, NULL);
+        c->get_range_id =
+            MARGO_REGISTER(mid, "yk_get_range",
+                           get_range_in_t, get_range_out_t, NULL);
+        c->put_range_id =
+            MARGO_REGISTER(mid, "yk_put_range",
+                           put_range_in_t, put_range_out_t, NULL);
+        c->compare_and_swap_id =
+            MARGO_REGISTER(mid, "yk_compare_and_swap",
+                           compare_and_swap_in_t, compare_and_swap_out_t, NULL);
+        c->merge_id =
+            MARGO_REGISTER(mid, "yk_merge",
+                           merge_in_t, merge_out_t, NULL);
         c->list_keys_id =
             MARGO_REGISTER(mid, "yk_list_keys",
                            list_keys_in_t, list_keys_out_t, NULL);
@@ -179,6 +221,10 @@ extern "C" yk_return_t yk_client_init(margo_instance_id mid, yk_client_t* client
         c->doc_iter_direct_id =
             MARGO_REGISTER(mid, "yk_doc_iter_direct",
                            doc_iter_in_t, doc_iter_out_t, NULL);
+
+        c->get_stats_id =
+            MARGO_REGISTER(mid, "yk_get_stats",
+                           get_stats_in_t, get_stats_out_t, NULL);
     }
 
     // The RPCs bellow might have been already registered by a provider,
@@ -222,8 +268,248 @@ extern "C" yk_return_t yk_client_finalize(yk_client_t client)
             client->num_database_handles);
         // LCOV_EXCL_STOP
     }
+    for(auto& entry : client->bulk_cache)
+        margo_bulk_free(entry.second);
+    for(auto& entry : client->registered_buffers)
+        margo_bulk_free(entry.second.bulk);
+    ABT_mutex_free(&client->bulk_cache_mtx);
     margo_instance_release(client->mid);
-    free(client);
+    delete client;
+    return YOKAN_SUCCESS;
+}
+
+extern "C" yk_return_t yk_client_set_direct_threshold(
+        yk_client_t client,
+        size_t threshold)
+{
+    if(client == YOKAN_CLIENT_NULL)
+        return YOKAN_ERR_INVALID_ARGS;
+    client->direct_threshold = threshold;
+    return YOKAN_SUCCESS;
+}
+
+extern "C" yk_return_t yk_client_get_direct_threshold(
+        yk_client_t client,
+        size_t* threshold)
+{
+    if(client == YOKAN_CLIENT_NULL || !threshold)
+        return YOKAN_ERR_INVALID_ARGS;
+    *threshold = client->direct_threshold;
+    return YOKAN_SUCCESS;
+}
+
+/* Must be called with bulk_cache_mtx locked. */
+static void yk_client_evict_bulks(yk_client_t client, size_t capacity)
+{
+    while(client->bulk_cache.size() > capacity) {
+        auto& back = client->bulk_cache.back();
+        margo_bulk_free(back.second);
+        client->bulk_cache_index.erase(back.first);
+        client->bulk_cache.pop_back();
+    }
+}
+
+/* Must be called with bulk_cache_mtx locked. */
+static bool yk_client_is_registered(yk_client_t client, uintptr_t ptr, hg_size_t size)
+{
+    auto it = client->registered_buffers.upper_bound(ptr);
+    if(it == client->registered_buffers.begin()) return false;
+    --it;
+    return ptr + size <= it->first + it->second.size;
+}
+
+hg_return_t yk_client_bulk_create(yk_client_t client,
+                                  hg_uint32_t count,
+                                  void** ptrs,
+                                  const hg_size_t* sizes,
+                                  hg_uint8_t flags,
+                                  hg_bulk_t* bulk)
+{
+    yk_bulk_key key;
+    key.flags = flags;
+
+    ABT_mutex_lock(client->bulk_cache_mtx);
+    bool cacheable = client->bulk_cache_capacity != 0
+                  && !client->registered_buffers.empty();
+    if(cacheable) {
+        key.segments.reserve(count);
+        for(hg_uint32_t i = 0; i < count && cacheable; ++i) {
+            auto ptr = reinterpret_cast<uintptr_t>(ptrs[i]);
+            cacheable = yk_client_is_registered(client, ptr, sizes[i]);
+            key.segments.emplace_back(ptr, sizes[i]);
+        }
+    }
+    if(!cacheable) {
+        ABT_mutex_unlock(client->bulk_cache_mtx);
+        return margo_bulk_create(client->mid, count, ptrs, sizes, flags, bulk);
+    }
+    auto it = client->bulk_cache_index.find(key);
+    if(it != client->bulk_cache_index.end()) {
+        client->bulk_cache.splice(client->bulk_cache.begin(),
+                                  client->bulk_cache, it->second);
+        client->bulk_cache_hits += 1;
+        *bulk = it->second->second;
+        margo_bulk_ref_incr(*bulk);
+        ABT_mutex_unlock(client->bulk_cache_mtx);
+        return HG_SUCCESS;
+    }
+    client->bulk_cache_misses += 1;
+    ABT_mutex_unlock(client->bulk_cache_mtx);
+
+    hg_bulk_t handle = HG_BULK_NULL;
+    hg_return_t hret = margo_bulk_create(client->mid, count, ptrs, sizes, flags, &handle);
+    if(hret != HG_SUCCESS) return hret;
+
+    ABT_mutex_lock(client->bulk_cache_mtx);
+    // the buffers may have been unregistered in the meantime, or another
+    // ULT may have cached the same segments, in which case the new handle
+    // is simply not cached
+    bool still_registered = true;
+    for(auto& segment : key.segments)
+        still_registered = still_registered
+            && yk_client_is_registered(client, segment.first, segment.second);
+    if(still_registered && client->bulk_cache_capacity != 0
+    && client->bulk_cache_index.count(key) == 0) {
+        margo_bulk_ref_incr(handle);
+        client->bulk_cache.emplace_front(key, handle);
+        client->bulk_cache_index[std::move(key)] = client->bulk_cache.begin();
+        yk_client_evict_bulks(client, client->bulk_cache_capacity);
+    }
+    ABT_mutex_unlock(client->bulk_cache_mtx);
+
+    *bulk = handle;
+    return HG_SUCCESS;
+}
+
+extern "C" yk_return_t yk_client_register_buffer(
+        yk_client_t client,
+        void* ptr,
+        size_t size,
+        hg_uint8_t flags,
+        hg_bulk_t* bulk)
+{
+    if(client == YOKAN_CLIENT_NULL || !ptr || size == 0)
+        return YOKAN_ERR_INVALID_ARGS;
+
+    auto start = reinterpret_cast<uintptr_t>(ptr);
+    hg_size_t hsize = size;
+    hg_bulk_t handle = HG_BULK_NULL;
+    hg_return_t hret = margo_bulk_create(client->mid, 1, &ptr, &hsize, flags, &handle);
+    if(hret != HG_SUCCESS) return YOKAN_ERR_FROM_MERCURY;
+
+    ABT_mutex_lock(client->bulk_cache_mtx);
+    // registered buffers cannot overlap
+    auto next = client->registered_buffers.lower_bound(start);
+    bool overlaps = next != client->registered_buffers.end()
+                 && next->first < start + size;
+    if(next != client->registered_buffers.begin()) {
+        auto prev = std::prev(next);
+        overlaps = overlaps || prev->first + prev->second.size > start;
+    }
+    if(overlaps) {
+        ABT_mutex_unlock(client->bulk_cache_mtx);
+        margo_bulk_free(handle);
+        return YOKAN_ERR_INVALID_ARGS;
+    }
+    client->registered_buffers[start] = yk_registered_buffer{size, handle};
+    ABT_mutex_unlock(client->bulk_cache_mtx);
+
+    if(bulk) *bulk = handle;
+    return YOKAN_SUCCESS;
+}
+
+extern "C" yk_return_t yk_client_unregister_buffer(
+        yk_client_t client,
+        void* ptr)
+{
+    if(client == YOKAN_CLIENT_NULL)
+        return YOKAN_ERR_INVALID_ARGS;
+
+    auto start = reinterpret_cast<uintptr_t>(ptr);
+
+    ABT_mutex_lock(client->bulk_cache_mtx);
+    auto it = client->registered_buffers.find(start);
+    if(it == client->registered_buffers.end()) {
+        ABT_mutex_unlock(client->bulk_cache_mtx);
+        return YOKAN_ERR_INVALID_ARGS;
+    }
+    auto end = start + it->second.size;
+    hg_bulk_t handle = it->second.bulk;
+    client->registered_buffers.erase(it);
+
+    // invalidate the cached handles that expose part of the buffer
+    for(auto entry = client->bulk_cache.begin(); entry != client->bulk_cache.end();) {
+        bool overlaps = false;
+        for(auto& segment : entry->first.segments)
+            overlaps = overlaps || (segment.first < end && segment.first + segment.second > start);
+        if(!overlaps) {
+            ++entry;
+            continue;
+        }
+        margo_bulk_free(entry->second);
+        client->bulk_cache_index.erase(entry->first);
+        entry = client->bulk_cache.erase(entry);
+    }
+    ABT_mutex_unlock(client->bulk_cache_mtx);
+
+    margo_bulk_free(handle);
+    return YOKAN_SUCCESS;
+}
+
+extern "C" yk_return_t yk_client_set_bulk_cache_capacity(
+        yk_client_t client,
+        size_t capacity)
+{
+    if(client == YOKAN_CLIENT_NULL)
+        return YOKAN_ERR_INVALID_ARGS;
+    ABT_mutex_lock(client->bulk_cache_mtx);
+    client->bulk_cache_capacity = capacity;
+    yk_client_evict_bulks(client, capacity);
+    ABT_mutex_unlock(client->bulk_cache_mtx);
+    return YOKAN_SUCCESS;
+}
+
+extern "C" yk_return_t yk_client_get_stats(
+        yk_client_t client,
+        bool reset,
+        char** stats)
+{
+    static const char* op_names[YK_CLIENT_NUM_OPS] = {
+        "put", "get", "exists", "length", "erase", "list_keys",
+        "list_keyvals", "doc_store", "doc_update", "doc_load", "doc_list"
+    };
+    if(client == YOKAN_CLIENT_NULL || !stats)
+        return YOKAN_ERR_INVALID_ARGS;
+
+    auto result = nlohmann::json::object();
+    result["direct_threshold"] = client->direct_threshold.load();
+    auto& transport = result["transport"] = nlohmann::json::object();
+    for(int op = 0; op < YK_CLIENT_NUM_OPS; ++op) {
+        auto& counters = client->transport[op];
+        uint64_t direct = reset ? counters.direct.exchange(0) : counters.direct.load();
+        uint64_t bulk   = reset ? counters.bulk.exchange(0)   : counters.bulk.load();
+        if(direct == 0 && bulk == 0) continue;
+        transport[op_names[op]] = {{"direct", direct}, {"bulk", bulk}};
+    }
+
+    ABT_mutex_lock(client->bulk_cache_mtx);
+    result["bulk_cache"] = {
+        {"capacity", client->bulk_cache_capacity},
+        {"entries", client->bulk_cache.size()},
+        {"registered_buffers", client->registered_buffers.size()},
+        {"hits", client->bulk_cache_hits},
+        {"misses", client->bulk_cache_misses}
+    };
+    if(reset) {
+        client->bulk_cache_hits   = 0;
+        client->bulk_cache_misses = 0;
+    }
+    ABT_mutex_unlock(client->bulk_cache_mtx);
+
+    auto str = result.dump();
+    *stats = (char*)malloc(str.size()+1);
+    if(!*stats) return YOKAN_ERR_ALLOCATION;
+    std::memcpy(*stats, str.c_str(), str.size()+1);
     return YOKAN_SUCCESS;
 }
 
@@ -302,6 +588,15 @@ extern "C" yk_return_t yk_database_handle_release(yk_database_handle_t handle)
         return YOKAN_ERR_INVALID_ARGS;
     handle->refcount -= 1;
     if(handle->refcount == 0) {
+        yk_return_t ret = yk_database_handle_disable_write_combining(handle);
+        if(ret != YOKAN_SUCCESS) {
+            // LCOV_EXCL_START
+            margo_error(handle->client->mid,
+                "Error: flushing combined writes failed with error %d"
+                " when releasing the database handle", ret);
+            // LCOV_EXCL_STOP
+        }
+        yk_database_handle_disable_read_cache(handle);
         margo_addr_free(handle->client->mid, handle->addr);
         handle->client->num_database_handles -= 1;
         free(handle);
@@ -9,6 +9,58 @@
 #include "yokan/client.h"
 #include "yokan/database.h"
 #include "yokan/collection.h"
+#include "../common/extras.h"
+#include <atomic>
+#include <list>
+#include <map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Operations that can either send their data along with the RPC
+ * or expose it via RDMA, for which the client records the path taken.
+ */
+enum yk_client_op {
+    YK_CLIENT_OP_PUT,
+    YK_CLIENT_OP_GET,
+    YK_CLIENT_OP_EXISTS,
+    YK_CLIENT_OP_LENGTH,
+    YK_CLIENT_OP_ERASE,
+    YK_CLIENT_OP_LIST_KEYS,
+    YK_CLIENT_OP_LIST_KEYVALS,
+    YK_CLIENT_OP_DOC_STORE,
+    YK_CLIENT_OP_DOC_UPDATE,
+    YK_CLIENT_OP_DOC_LOAD,
+    YK_CLIENT_OP_DOC_LIST,
+    YK_CLIENT_NUM_OPS
+};
+
+struct yk_transport_counters {
+    std::atomic<uint64_t> direct{0};
+    std::atomic<uint64_t> bulk{0};
+};
+
+/**
+ * @brief Key of the bulk registration cache: the segments exposed by a
+ * bulk handle, along with its access mode.
+ */
+struct yk_bulk_key {
+    std::vector<std::pair<uintptr_t, hg_size_t>> segments;
+    hg_uint8_t                                   flags;
+
+    bool operator<(const yk_bulk_key& other) const {
+        if(flags != other.flags) return flags < other.flags;
+        return segments < other.segments;
+    }
+};
+
+/**
+ * @brief Buffer registered with yk_client_register_buffer.
+ */
+struct yk_registered_buffer {
+    size_t    size;
+    hg_bulk_t bulk;
+};
 
 typedef struct yk_client {
     margo_instance_id mid;
@@ -22,6 +74,8 @@ typedef struct yk_client {
     hg_id_t           put_direct_id;
     hg_id_t           get_id;
     hg_id_t           get_direct_id;
+    hg_id_t           get_alloc_id;
+    hg_id_t           get_alloc_release_id;
     hg_id_t           fetch_id;
     hg_id_t           fetch_direct_id;
     hg_id_t           fetch_back_id;
@@ -29,6 +83,10 @@ typedef struct yk_client {
     hg_id_t           erase_id;
     hg_id_t           erase_direct_id;
     hg_id_t           erase_range_id;
+    hg_id_t           get_range_id;
+    hg_id_t           put_range_id;
+    hg_id_t           compare_and_swap_id;
+    hg_id_t           merge_id;
     hg_id_t           list_keys_id;
     hg_id_t           list_keys_direct_id;
     hg_id_t           list_keyvals_id;
@@ -61,16 +119,189 @@ typedef struct yk_client {
     hg_id_t           doc_iter_back_id;
     hg_id_t           doc_iter_direct_back_id;
 
+    hg_id_t           get_stats_id;
+
     uint64_t          num_database_handles;
+
+    std::atomic<size_t>          direct_threshold{0};
+    yk_transport_counters        transport[YK_CLIENT_NUM_OPS];
+
+    ABT_mutex                                                          bulk_cache_mtx;
+    size_t                                                             bulk_cache_capacity;
+    std::list<std::pair<yk_bulk_key, hg_bulk_t>>                       bulk_cache;
+    std::map<yk_bulk_key,
+             std::list<std::pair<yk_bulk_key, hg_bulk_t>>::iterator>   bulk_cache_index;
+    std::map<uintptr_t, yk_registered_buffer>                          registered_buffers;
+    uint64_t                                                           bulk_cache_hits;
+    uint64_t                                                           bulk_cache_misses;
 } yk_client;
 
+struct yk_write_combiner;
+struct yk_read_cache;
+
 typedef struct yk_database_handle {
-    yk_client_t      client;
-    hg_addr_t        addr;
-    uint16_t         provider_id;
-    uint64_t         refcount;
+    yk_client_t               client;
+    hg_addr_t                 addr;
+    uint16_t                  provider_id;
+    uint64_t                  refcount;
+    struct yk_write_combiner* combiner;
+    struct yk_read_cache*     read_cache;
 } yk_database_handle;
 
+/**
+ * @brief Look up a key in the read cache of the database handle, if the
+ * read cache is enabled and the mode allows it. Returns true if the key
+ * was found, in which case the value (or YOKAN_SIZE_TOO_SMALL) was copied
+ * and *ret is set to the value yk_get should return. Otherwise,
+ * *generation is set to the value to pass to yk_read_cache_insert once
+ * the value has been read from the provider.
+ */
+bool yk_read_cache_lookup(yk_database_handle_t dbh,
+                          int32_t mode,
+                          const void* key,
+                          size_t ksize,
+                          void* value,
+                          size_t* vsize,
+                          yk_return_t* ret,
+                          uint64_t* generation);
+
+/**
+ * @brief Insert a value read from the provider in the read cache. The
+ * value is dropped if an invalidation happened since the corresponding
+ * yk_read_cache_lookup, since it may be older than the invalidating write.
+ */
+void yk_read_cache_insert(yk_database_handle_t dbh,
+                          uint64_t generation,
+                          const void* key,
+                          size_t ksize,
+                          const void* value,
+                          size_t vsize);
+
+/**
+ * @brief Invalidate keys (provided either packed or as an array of
+ * pointers), keys starting with a prefix, or the whole read cache.
+ * Functions that modify the database call these before sending their
+ * RPC and again once it completed (via YK_INVALIDATE_CACHED_*), so that
+ * a read racing with the modification does not cache an old value.
+ */
+void yk_read_cache_invalidate_packed(yk_database_handle_t dbh,
+                                     size_t count,
+                                     const void* keys,
+                                     const size_t* ksizes);
+
+void yk_read_cache_invalidate_multi(yk_database_handle_t dbh,
+                                    size_t count,
+                                    const void* const* keys,
+                                    const size_t* ksizes);
+
+void yk_read_cache_invalidate_prefix(yk_database_handle_t dbh,
+                                     const void* prefix,
+                                     size_t prefix_size);
+
+void yk_read_cache_clear(yk_database_handle_t dbh);
+
+#define YK_INVALIDATE_CACHED_PACKED(__dbh__, __count__, __keys__, __ksizes__) \
+    yk_read_cache_invalidate_packed(__dbh__, __count__, __keys__, __ksizes__); \
+    DEFER(yk_read_cache_invalidate_packed(__dbh__, __count__, __keys__, __ksizes__))
+
+#define YK_INVALIDATE_CACHED_MULTI(__dbh__, __count__, __keys__, __ksizes__) \
+    yk_read_cache_invalidate_multi(__dbh__, __count__, __keys__, __ksizes__); \
+    DEFER(yk_read_cache_invalidate_multi(__dbh__, __count__, __keys__, __ksizes__))
+
+#define YK_INVALIDATE_CACHED_PREFIX(__dbh__, __prefix__, __prefix_size__) \
+    yk_read_cache_invalidate_prefix(__dbh__, __prefix__, __prefix_size__); \
+    DEFER(yk_read_cache_invalidate_prefix(__dbh__, __prefix__, __prefix_size__))
+
+#define YK_INVALIDATE_CACHE(__dbh__) \
+    yk_read_cache_clear(__dbh__); \
+    DEFER(yk_read_cache_clear(__dbh__))
+
+#define YK_INVALIDATE_CACHE_IF_CONSUMING(__dbh__, __mode__) \
+    if((__mode__) & YOKAN_MODE_CONSUME) yk_read_cache_clear(__dbh__); \
+    DEFER(if((__mode__) & YOKAN_MODE_CONSUME) yk_read_cache_clear(__dbh__))
+
+/**
+ * @brief Queue a put (resp. erase) in the write combiner of the database
+ * handle, if write combining is enabled and the operation can be delayed.
+ * Returns true if the operation was queued, in which case *ret is set to
+ * the value the operation should return.
+ */
+bool yk_write_combiner_put(yk_database_handle_t dbh,
+                           int32_t mode,
+                           const yk_extra_opts_t& extras,
+                           const void* key,
+                           size_t ksize,
+                           const void* value,
+                           size_t vsize,
+                           yk_return_t* ret);
+
+bool yk_write_combiner_erase(yk_database_handle_t dbh,
+                             int32_t mode,
+                             const yk_extra_opts_t& extras,
+                             const void* key,
+                             size_t ksize,
+                             yk_return_t* ret);
+
+/**
+ * @brief Send the writes pending in the write combiner of the database
+ * handle, if any. Every function sending a key/value RPC through the
+ * handle calls this first (via YK_FLUSH_COMBINED_WRITES), so that the
+ * operation is ordered after the writes issued before it.
+ */
+yk_return_t yk_write_combiner_flush(yk_database_handle_t dbh);
+
+#define YK_FLUSH_COMBINED_WRITES(__dbh__) \
+    do { \
+        if((__dbh__)->combiner) { \
+            yk_return_t __flush_ret = yk_write_combiner_flush(__dbh__); \
+            if(__flush_ret != YOKAN_SUCCESS) return __flush_ret; \
+        } \
+    } while(0)
+
+/**
+ * @brief Size of the RPC header and of the fixed-size fields of the
+ * input structures, which also need to fit in the eager buffer.
+ */
+#define YK_DIRECT_HEADER_SIZE 64
+
+/**
+ * @brief Decides whether an operation should send its payload along with
+ * the RPC (direct) rather than exposing it via RDMA (bulk), and records
+ * the decision. The direct path is used when YOKAN_MODE_NO_RDMA is set,
+ * or when the payload fits within the direct threshold, which is either
+ * provided by YOKAN_EXTRA_DIRECT_THRESHOLD or that of the client.
+ */
+static inline bool yk_client_use_direct(yk_client_t client,
+                                        yk_client_op op,
+                                        int32_t mode,
+                                        const yk_extra_opts_t& extras,
+                                        size_t payload)
+{
+    bool direct = mode & YOKAN_MODE_NO_RDMA;
+    if(!direct) {
+        size_t threshold = extras.direct_threshold != SIZE_MAX
+                         ? extras.direct_threshold
+                         : client->direct_threshold.load(std::memory_order_relaxed);
+        direct = payload + YK_DIRECT_HEADER_SIZE <= threshold;
+    }
+    auto& counters = client->transport[op];
+    (direct ? counters.direct : counters.bulk).fetch_add(1, std::memory_order_relaxed);
+    return direct;
+}
+
+/**
+ * @brief Same as margo_bulk_create, but if all the segments lie within
+ * buffers registered with yk_client_register_buffer, the handle is taken
+ * from (or added to) the client's registration cache. In all cases, the
+ * caller should release the handle with margo_bulk_free.
+ */
+hg_return_t yk_client_bulk_create(yk_client_t client,
+                                  hg_uint32_t count,
+                                  void** ptrs,
+                                  const hg_size_t* sizes,
+                                  hg_uint8_t flags,
+                                  hg_bulk_t* bulk);
+
 DECLARE_MARGO_RPC_HANDLER(yk_fetch_back_ult)
 void yk_fetch_back_ult(hg_handle_t h);
 DECLARE_MARGO_RPC_HANDLER(yk_fetch_direct_back_ult)
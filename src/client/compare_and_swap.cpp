@@ -0,0 +1,66 @@
+/*
+ * (C) 2026 The University of Chicago
+ *
+ * See COPYRIGHT in top-level directory.
+ */
+#include "client.hpp"
+#include "../common/defer.hpp"
+#include "../common/types.h"
+#include "../common/logging.h"
+#include "../common/checks.h"
+#include "../common/extras.h"
+
+extern "C" yk_return_t yk_compare_and_swap(yk_database_handle_t dbh,
+                                           int32_t mode,
+                                           const void* key,
+                                           size_t ksize,
+                                           const void* expected,
+                                           size_t esize,
+                                           const void* value,
+                                           size_t vsize,
+                                           bool* swapped, ...)
+{
+    YK_EXTRACT_EXTRAS(extras, mode, swapped);
+
+    if(!key || ksize == 0 || (!expected && esize) || (!value && vsize))
+        return YOKAN_ERR_INVALID_ARGS;
+
+    CHECK_MODE_VALID(mode);
+
+    margo_instance_id mid = dbh->client->mid;
+    yk_return_t ret = YOKAN_SUCCESS;
+    hg_return_t hret = HG_SUCCESS;
+    compare_and_swap_in_t in;
+    compare_and_swap_out_t out;
+    hg_handle_t handle = HG_HANDLE_NULL;
+
+    in.mode          = mode;
+    in.timeout_ms    = extras.timeout_ms;
+    in.trace_id      = extras.trace_id;
+    in.key.data      = (char*)key;
+    in.key.size      = ksize;
+    in.expected.data = (char*)expected;
+    in.expected.size = esize;
+    in.value.data    = (char*)value;
+    in.value.size    = vsize;
+
+    YK_INVALIDATE_CACHED_PACKED(dbh, 1, key, &ksize);
+    YK_FLUSH_COMBINED_WRITES(dbh);
+
+    hret = margo_create(mid, dbh->addr, dbh->client->compare_and_swap_id, &handle);
+    CHECK_HRET(hret, margo_create);
+    DEFER(margo_destroy(handle));
+
+    hret = margo_provider_forward_timed(dbh->provider_id, handle, &in, extras.timeout_ms);
+    CHECK_HRET(hret, margo_provider_forward_timed);
+
+    hret = margo_get_output(handle, &out);
+    CHECK_HRET(hret, margo_get_output);
+
+    ret = static_cast<yk_return_t>(out.ret);
+    if(swapped) *swapped = ret == YOKAN_SUCCESS && out.swapped;
+    hret = margo_free_output(handle, &out);
+    CHECK_HRET(hret, margo_free_output);
+
+    return ret;
+}
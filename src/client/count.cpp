@@ -30,6 +30,8 @@ extern "C" yk_return_t yk_count(yk_database_handle_t dbh,
     in.mode  = mode;
     in.timeout_ms = extras.timeout_ms;
 
+    YK_FLUSH_COMBINED_WRITES(dbh);
+
     hret = margo_create(mid, dbh->addr, dbh->client->count_id, &handle);
     CHECK_HRET(hret, margo_create);
     DEFER(margo_destroy(handle));
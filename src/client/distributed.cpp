@@ -0,0 +1,744 @@
+/*
+ * (C) 2026 The University of Chicago
+ *
+ * See COPYRIGHT in top-level directory.
+ */
+#include "yokan/distributed.h"
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "client.hpp"
+#include "../common/logging.h"
+#include "../common/extras.h"
+
+struct yk_distributed_database {
+    std::vector<yk_database_handle_t>        dbhs;
+    yk_partitioning_t                        partitioning = YOKAN_PARTITION_HASH;
+    std::vector<std::pair<uint64_t, size_t>> ring;       /* (hash, database index), sorted */
+    std::vector<std::string>                 split_keys; /* sorted */
+    ABT_pool                                 pool = ABT_POOL_NULL;
+
+    size_t locate(const void* key, size_t ksize) const;
+};
+
+/* FNV-1a, followed by the finalizer of splitmix64 to spread the
+ * hashes of similar keys (e.g. keys differing only in their last
+ * character) over the whole ring. */
+static uint64_t yk_distributed_hash(const void* data, size_t size)
+{
+    auto bytes = static_cast<const unsigned char*>(data);
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for(size_t i = 0; i < size; ++i) {
+        h ^= bytes[i];
+        h *= 0x100000001b3ULL;
+    }
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebULL;
+    h ^= h >> 31;
+    return h;
+}
+
+size_t yk_distributed_database::locate(const void* key, size_t ksize) const
+{
+    if(dbhs.size() == 1) return 0;
+    if(partitioning == YOKAN_PARTITION_RANGE) {
+        std::string k{static_cast<const char*>(key), ksize};
+        return std::upper_bound(split_keys.begin(), split_keys.end(), k)
+             - split_keys.begin();
+    }
+    auto h  = yk_distributed_hash(key, ksize);
+    auto it = std::lower_bound(ring.begin(), ring.end(),
+                               std::make_pair(h, (size_t)0));
+    if(it == ring.end()) it = ring.begin();
+    return it->second;
+}
+
+/* Groups the indices of count keys by the database holding them. */
+template<typename KeyAt>
+static yk_return_t yk_distributed_group(yk_distributed_database_t ddb,
+                                        size_t count,
+                                        KeyAt&& key_at,
+                                        std::vector<std::vector<size_t>>& groups)
+{
+    groups.resize(ddb->dbhs.size());
+    for(size_t i = 0; i < count; ++i) {
+        auto k = key_at(i);
+        if(k.second == 0 || k.first == nullptr)
+            return YOKAN_ERR_INVALID_ARGS;
+        groups[ddb->locate(k.first, k.second)].push_back(i);
+    }
+    return YOKAN_SUCCESS;
+}
+
+/* Calls fn(i) for each database i in targets, in parallel ULTs when
+ * more than one database is involved, and returns the first error. */
+static yk_return_t yk_distributed_run(yk_distributed_database_t ddb,
+                                      const std::vector<size_t>& targets,
+                                      const std::function<yk_return_t(size_t)>& fn)
+{
+    if(targets.empty()) return YOKAN_SUCCESS;
+    if(targets.size() == 1) return fn(targets[0]);
+
+    struct ult_args {
+        const std::function<yk_return_t(size_t)>* fn;
+        size_t                                    index;
+        yk_return_t                               ret;
+    };
+    auto ult = [](void* a) -> void {
+        auto arg = static_cast<ult_args*>(a);
+        arg->ret = (*arg->fn)(arg->index);
+    };
+
+    ABT_pool pool = ddb->pool;
+    if(pool == ABT_POOL_NULL && ABT_self_get_last_pool(&pool) != ABT_SUCCESS)
+        pool = ABT_POOL_NULL;
+
+    std::vector<ult_args>   args(targets.size());
+    std::vector<ABT_thread> ults(targets.size(), ABT_THREAD_NULL);
+    for(size_t i = 0; i < targets.size(); ++i) {
+        args[i] = ult_args{&fn, targets[i], YOKAN_SUCCESS};
+        if(pool == ABT_POOL_NULL
+        || ABT_thread_create(pool, ult, &args[i], ABT_THREAD_ATTR_NULL, &ults[i]) != ABT_SUCCESS) {
+            ults[i] = ABT_THREAD_NULL;
+            ult(&args[i]);
+        }
+    }
+    yk_return_t ret = YOKAN_SUCCESS;
+    for(size_t i = 0; i < targets.size(); ++i) {
+        if(ults[i] != ABT_THREAD_NULL) {
+            ABT_thread_join(ults[i]);
+            ABT_thread_free(&ults[i]);
+        }
+        if(ret == YOKAN_SUCCESS) ret = args[i].ret;
+    }
+    return ret;
+}
+
+static std::vector<size_t> yk_distributed_targets(const std::vector<std::vector<size_t>>& groups)
+{
+    std::vector<size_t> targets;
+    for(size_t i = 0; i < groups.size(); ++i)
+        if(!groups[i].empty()) targets.push_back(i);
+    return targets;
+}
+
+extern "C" yk_return_t yk_distributed_database_create(
+        size_t count,
+        const yk_database_handle_t* dbhs,
+        const yk_distributed_options_t* options,
+        yk_distributed_database_t* ddb)
+{
+    if(count == 0 || !dbhs || !ddb)
+        return YOKAN_ERR_INVALID_ARGS;
+    for(size_t i = 0; i < count; ++i)
+        if(dbhs[i] == YOKAN_DATABASE_HANDLE_NULL)
+            return YOKAN_ERR_INVALID_ARGS;
+
+    yk_distributed_options_t opts = YOKAN_DISTRIBUTED_OPTIONS_INIT;
+    if(options) opts = *options;
+
+    auto result = new yk_distributed_database;
+    result->partitioning = opts.partitioning;
+    result->pool         = opts.pool;
+
+    if(opts.partitioning == YOKAN_PARTITION_RANGE) {
+        if(count > 1 && (!opts.split_keys || !opts.split_ksizes)) {
+            delete result;
+            return YOKAN_ERR_INVALID_ARGS;
+        }
+        for(size_t i = 0; i + 1 < count; ++i) {
+            result->split_keys.emplace_back(
+                static_cast<const char*>(opts.split_keys[i]), opts.split_ksizes[i]);
+            if(i > 0 && !(result->split_keys[i-1] < result->split_keys[i])) {
+                delete result;
+                return YOKAN_ERR_INVALID_ARGS;
+            }
+        }
+    } else if(opts.partitioning == YOKAN_PARTITION_HASH) {
+        size_t vnodes = opts.virtual_nodes ? opts.virtual_nodes : 64;
+        result->ring.reserve(count*vnodes);
+        for(size_t i = 0; i < count; ++i) {
+            // the virtual nodes are placed according to the address and
+            // provider id, not the index, so that all clients agree
+            auto mid = dbhs[i]->client->mid;
+            char addr_str[256];
+            hg_size_t addr_str_size = sizeof(addr_str);
+            hg_return_t hret = margo_addr_to_string(mid, addr_str, &addr_str_size, dbhs[i]->addr);
+            if(hret != HG_SUCCESS) {
+                YOKAN_LOG_ERROR(mid, "margo_addr_to_string returned %d", hret);
+                delete result;
+                return YOKAN_ERR_FROM_MERCURY;
+            }
+            std::string name = std::string{addr_str} + ":" + std::to_string(dbhs[i]->provider_id);
+            for(size_t v = 0; v < vnodes; ++v) {
+                auto vnode = name + "#" + std::to_string(v);
+                result->ring.emplace_back(
+                    yk_distributed_hash(vnode.data(), vnode.size()), i);
+            }
+        }
+        std::sort(result->ring.begin(), result->ring.end());
+    } else {
+        delete result;
+        return YOKAN_ERR_INVALID_ARGS;
+    }
+
+    for(size_t i = 0; i < count; ++i) {
+        yk_database_handle_ref_incr(dbhs[i]);
+        result->dbhs.push_back(dbhs[i]);
+    }
+    *ddb = result;
+    return YOKAN_SUCCESS;
+}
+
+extern "C" yk_return_t yk_distributed_database_release(
+        yk_distributed_database_t ddb)
+{
+    if(ddb == YOKAN_DISTRIBUTED_DATABASE_NULL)
+        return YOKAN_ERR_INVALID_ARGS;
+    for(auto dbh : ddb->dbhs)
+        yk_database_handle_release(dbh);
+    delete ddb;
+    return YOKAN_SUCCESS;
+}
+
+extern "C" yk_return_t yk_distributed_database_get_info(
+        yk_distributed_database_t ddb,
+        size_t index,
+        size_t* count,
+        yk_database_handle_t* dbh)
+{
+    if(ddb == YOKAN_DISTRIBUTED_DATABASE_NULL)
+        return YOKAN_ERR_INVALID_ARGS;
+    if(count) *count = ddb->dbhs.size();
+    if(dbh) {
+        if(index >= ddb->dbhs.size())
+            return YOKAN_ERR_INVALID_ARGS;
+        *dbh = ddb->dbhs[index];
+    }
+    return YOKAN_SUCCESS;
+}
+
+extern "C" yk_return_t yk_distributed_locate(
+        yk_distributed_database_t ddb,
+        const void* key,
+        size_t ksize,
+        size_t* index)
+{
+    if(ddb == YOKAN_DISTRIBUTED_DATABASE_NULL || !index || (!key && ksize))
+        return YOKAN_ERR_INVALID_ARGS;
+    *index = ddb->locate(key, ksize);
+    return YOKAN_SUCCESS;
+}
+
+extern "C" yk_return_t yk_distributed_count(yk_distributed_database_t ddb,
+                                            int32_t mode,
+                                            size_t* count, ...)
+{
+    YK_EXTRACT_EXTRAS(extras, mode, count);
+    if(ddb == YOKAN_DISTRIBUTED_DATABASE_NULL || !count)
+        return YOKAN_ERR_INVALID_ARGS;
+
+    std::vector<size_t> targets(ddb->dbhs.size());
+    std::iota(targets.begin(), targets.end(), 0);
+    std::vector<size_t> counts(ddb->dbhs.size(), 0);
+    auto ret = yk_distributed_run(ddb, targets, [&](size_t db) {
+        return yk_count(ddb->dbhs[db], YK_MODE_WITH_EXTRA(mode), &counts[db],
+                        YK_REEMIT_EXTRAS(extras));
+    });
+    if(ret == YOKAN_SUCCESS)
+        *count = std::accumulate(counts.begin(), counts.end(), (size_t)0);
+    return ret;
+}
+
+extern "C" yk_return_t yk_distributed_put(yk_distributed_database_t ddb,
+                                          int32_t mode,
+                                          const void* key,
+                                          size_t ksize,
+                                          const void* value,
+                                          size_t vsize, ...)
+{
+    YK_EXTRACT_EXTRAS(extras, mode, vsize);
+    if(ddb == YOKAN_DISTRIBUTED_DATABASE_NULL || !key || ksize == 0)
+        return YOKAN_ERR_INVALID_ARGS;
+    auto dbh = ddb->dbhs[ddb->locate(key, ksize)];
+    return yk_put(dbh, YK_MODE_WITH_EXTRA(mode), key, ksize, value, vsize,
+                  YK_REEMIT_EXTRAS(extras));
+}
+
+extern "C" yk_return_t yk_distributed_put_multi(yk_distributed_database_t ddb,
+                                                int32_t mode,
+                                                size_t count,
+                                                const void* const* keys,
+                                                const size_t* ksizes,
+                                                const void* const* values,
+                                                const size_t* vsizes, ...)
+{
+    YK_EXTRACT_EXTRAS(extras, mode, vsizes);
+    if(ddb == YOKAN_DISTRIBUTED_DATABASE_NULL)
+        return YOKAN_ERR_INVALID_ARGS;
+    if(count == 0)
+        return YOKAN_SUCCESS;
+    else if(!keys || !ksizes || !values || !vsizes)
+        return YOKAN_ERR_INVALID_ARGS;
+
+    std::vector<std::vector<size_t>> groups;
+    auto ret = yk_distributed_group(ddb, count,
+        [&](size_t i) { return std::make_pair(keys[i], ksizes[i]); }, groups);
+    if(ret != YOKAN_SUCCESS) return ret;
+
+    return yk_distributed_run(ddb, yk_distributed_targets(groups), [&](size_t db) {
+        auto& group = groups[db];
+        std::vector<const void*> sub_keys, sub_vals;
+        std::vector<size_t>      sub_ksizes, sub_vsizes;
+        sub_keys.reserve(group.size());
+        sub_vals.reserve(group.size());
+        sub_ksizes.reserve(group.size());
+        sub_vsizes.reserve(group.size());
+        for(auto i : group) {
+            sub_keys.push_back(keys[i]);
+            sub_ksizes.push_back(ksizes[i]);
+            sub_vals.push_back(values[i]);
+            sub_vsizes.push_back(vsizes[i]);
+        }
+        return yk_put_multi(ddb->dbhs[db], YK_MODE_WITH_EXTRA(mode), group.size(),
+                            sub_keys.data(), sub_ksizes.data(),
+                            sub_vals.data(), sub_vsizes.data(),
+                            YK_REEMIT_EXTRAS(extras));
+    });
+}
+
+/* Computes the pointers to the items of a packed buffer. */
+static std::vector<const void*> yk_distributed_unpack(size_t count,
+                                                      const void* data,
+                                                      const size_t* sizes)
+{
+    std::vector<const void*> ptrs(count);
+    auto ptr = static_cast<const char*>(data);
+    for(size_t i = 0; i < count; ++i) {
+        ptrs[i] = ptr;
+        if(ptr) ptr += sizes[i];
+    }
+    return ptrs;
+}
+
+extern "C" yk_return_t yk_distributed_put_packed(yk_distributed_database_t ddb,
+                                                 int32_t mode,
+                                                 size_t count,
+                                                 const void* keys,
+                                                 const size_t* ksizes,
+                                                 const void* values,
+                                                 const size_t* vsizes, ...)
+{
+    YK_EXTRACT_EXTRAS(extras, mode, vsizes);
+    if(ddb == YOKAN_DISTRIBUTED_DATABASE_NULL)
+        return YOKAN_ERR_INVALID_ARGS;
+    if(count == 0)
+        return YOKAN_SUCCESS;
+    else if(!keys || !ksizes || !vsizes)
+        return YOKAN_ERR_INVALID_ARGS;
+    auto key_ptrs = yk_distributed_unpack(count, keys, ksizes);
+    auto val_ptrs = yk_distributed_unpack(count, values, vsizes);
+    return yk_distributed_put_multi(ddb, YK_MODE_WITH_EXTRA(mode), count,
+                                    key_ptrs.data(), ksizes,
+                                    val_ptrs.data(), vsizes,
+                                    YK_REEMIT_EXTRAS(extras));
+}
+
+extern "C" yk_return_t yk_distributed_exists(yk_distributed_database_t ddb,
+                                             int32_t mode,
+                                             const void* key,
+                                             size_t ksize,
+                                             uint8_t* exists, ...)
+{
+    YK_EXTRACT_EXTRAS(extras, mode, exists);
+    if(ddb == YOKAN_DISTRIBUTED_DATABASE_NULL || !key || ksize == 0)
+        return YOKAN_ERR_INVALID_ARGS;
+    auto dbh = ddb->dbhs[ddb->locate(key, ksize)];
+    return yk_exists(dbh, YK_MODE_WITH_EXTRA(mode), key, ksize, exists,
+                     YK_REEMIT_EXTRAS(extras));
+}
+
+extern "C" yk_return_t yk_distributed_length(yk_distributed_database_t ddb,
+                                             int32_t mode,
+                                             const void* key,
+                                             size_t ksize,
+                                             size_t* vsize, ...)
+{
+    YK_EXTRACT_EXTRAS(extras, mode, vsize);
+    if(ddb == YOKAN_DISTRIBUTED_DATABASE_NULL || !key || ksize == 0)
+        return YOKAN_ERR_INVALID_ARGS;
+    auto dbh = ddb->dbhs[ddb->locate(key, ksize)];
+    return yk_length(dbh, YK_MODE_WITH_EXTRA(mode), key, ksize, vsize,
+                     YK_REEMIT_EXTRAS(extras));
+}
+
+extern "C" yk_return_t yk_distributed_get(yk_distributed_database_t ddb,
+                                          int32_t mode,
+                                          const void* key,
+                                          size_t ksize,
+                                          void* value,
+                                          size_t* vsize, ...)
+{
+    YK_EXTRACT_EXTRAS(extras, mode, vsize);
+    if(ddb == YOKAN_DISTRIBUTED_DATABASE_NULL || !key || ksize == 0)
+        return YOKAN_ERR_INVALID_ARGS;
+    auto dbh = ddb->dbhs[ddb->locate(key, ksize)];
+    return yk_get(dbh, YK_MODE_WITH_EXTRA(mode), key, ksize, value, vsize,
+                  YK_REEMIT_EXTRAS(extras));
+}
+
+extern "C" yk_return_t yk_distributed_get_multi(yk_distributed_database_t ddb,
+                                                int32_t mode,
+                                                size_t count,
+                                                const void* const* keys,
+                                                const size_t* ksizes,
+                                                void* const* values,
+                                                size_t* vsizes, ...)
+{
+    YK_EXTRACT_EXTRAS(extras, mode, vsizes);
+    if(ddb == YOKAN_DISTRIBUTED_DATABASE_NULL)
+        return YOKAN_ERR_INVALID_ARGS;
+    if(count == 0)
+        return YOKAN_SUCCESS;
+    else if(!keys || !ksizes || !values || !vsizes)
+        return YOKAN_ERR_INVALID_ARGS;
+
+    std::vector<std::vector<size_t>> groups;
+    auto ret = yk_distributed_group(ddb, count,
+        [&](size_t i) { return std::make_pair(keys[i], ksizes[i]); }, groups);
+    if(ret != YOKAN_SUCCESS) return ret;
+
+    return yk_distributed_run(ddb, yk_distributed_targets(groups), [&](size_t db) {
+        auto& group = groups[db];
+        std::vector<const void*> sub_keys;
+        std::vector<void*>       sub_vals;
+        std::vector<size_t>      sub_ksizes, sub_vsizes;
+        sub_keys.reserve(group.size());
+        sub_vals.reserve(group.size());
+        sub_ksizes.reserve(group.size());
+        sub_vsizes.reserve(group.size());
+        for(auto i : group) {
+            sub_keys.push_back(keys[i]);
+            sub_ksizes.push_back(ksizes[i]);
+            sub_vals.push_back(values[i]);
+            sub_vsizes.push_back(vsizes[i]);
+        }
+        auto sub_ret = yk_get_multi(ddb->dbhs[db], YK_MODE_WITH_EXTRA(mode), group.size(),
+                                    sub_keys.data(), sub_ksizes.data(),
+                                    sub_vals.data(), sub_vsizes.data(),
+                                    YK_REEMIT_EXTRAS(extras));
+        if(sub_ret != YOKAN_SUCCESS) return sub_ret;
+        for(size_t j = 0; j < group.size(); ++j)
+            vsizes[group[j]] = sub_vsizes[j];
+        return sub_ret;
+    });
+}
+
+extern "C" yk_return_t yk_distributed_get_packed(yk_distributed_database_t ddb,
+                                                 int32_t mode,
+                                                 size_t count,
+                                                 const void* keys,
+                                                 const size_t* ksizes,
+                                                 size_t vbufsize,
+                                                 void* values,
+                                                 size_t* vsizes, ...)
+{
+    YK_EXTRACT_EXTRAS(extras, mode, vsizes);
+    if(ddb == YOKAN_DISTRIBUTED_DATABASE_NULL)
+        return YOKAN_ERR_INVALID_ARGS;
+    if(count == 0)
+        return YOKAN_SUCCESS;
+    else if(!keys || !ksizes || !vsizes || (!values && vbufsize))
+        return YOKAN_ERR_INVALID_ARGS;
+
+    auto key_ptrs = yk_distributed_unpack(count, keys, ksizes);
+    std::vector<std::vector<size_t>> groups;
+    auto ret = yk_distributed_group(ddb, count,
+        [&](size_t i) { return std::make_pair(key_ptrs[i], ksizes[i]); }, groups);
+    if(ret != YOKAN_SUCCESS) return ret;
+
+    auto targets = yk_distributed_targets(groups);
+    if(targets.size() == 1) {
+        return yk_get_packed(ddb->dbhs[targets[0]], YK_MODE_WITH_EXTRA(mode), count,
+                             keys, ksizes, vbufsize, values, vsizes,
+                             YK_REEMIT_EXTRAS(extras));
+    }
+
+    // each database packs its values in its own buffer
+    std::vector<std::vector<char>>   sub_vals(ddb->dbhs.size());
+    std::vector<std::vector<size_t>> sub_vsizes(ddb->dbhs.size());
+    ret = yk_distributed_run(ddb, targets, [&](size_t db) {
+        auto& group = groups[db];
+        std::vector<char>   sub_keys;
+        std::vector<size_t> sub_ksizes;
+        sub_ksizes.reserve(group.size());
+        for(auto i : group) {
+            auto k = static_cast<const char*>(key_ptrs[i]);
+            sub_keys.insert(sub_keys.end(), k, k + ksizes[i]);
+            sub_ksizes.push_back(ksizes[i]);
+        }
+        sub_vals[db].resize(vbufsize);
+        sub_vsizes[db].resize(group.size());
+        return yk_get_packed(ddb->dbhs[db], YK_MODE_WITH_EXTRA(mode), group.size(),
+                             sub_keys.data(), sub_ksizes.data(),
+                             vbufsize, sub_vals[db].data(), sub_vsizes[db].data(),
+                             YK_REEMIT_EXTRAS(extras));
+    });
+    if(ret != YOKAN_SUCCESS) return ret;
+
+    // re-pack the values in the order of the keys
+    std::vector<size_t> location(count);
+    for(auto db : targets)
+        for(auto i : groups[db]) location[i] = db;
+    std::vector<size_t> next(ddb->dbhs.size(), 0);
+    std::vector<size_t> offsets(ddb->dbhs.size(), 0);
+    size_t offset = 0;
+    for(size_t i = 0; i < count; ++i) {
+        auto db    = location[i];
+        auto vsize = sub_vsizes[db][next[db]++];
+        if(vsize > YOKAN_LAST_VALID_SIZE) {
+            vsizes[i] = vsize;
+            continue;
+        }
+        if(offset + vsize > vbufsize) {
+            vsizes[i] = YOKAN_SIZE_TOO_SMALL;
+        } else {
+            if(vsize) std::memcpy(static_cast<char*>(values) + offset,
+                                  sub_vals[db].data() + offsets[db], vsize);
+            vsizes[i] = vsize;
+            offset += vsize;
+        }
+        offsets[db] += vsize;
+    }
+    return YOKAN_SUCCESS;
+}
+
+extern "C" yk_return_t yk_distributed_erase(yk_distributed_database_t ddb,
+                                            int32_t mode,
+                                            const void* key,
+                                            size_t ksize, ...)
+{
+    YK_EXTRACT_EXTRAS(extras, mode, ksize);
+    if(ddb == YOKAN_DISTRIBUTED_DATABASE_NULL || !key || ksize == 0)
+        return YOKAN_ERR_INVALID_ARGS;
+    auto dbh = ddb->dbhs[ddb->locate(key, ksize)];
+    return yk_erase(dbh, YK_MODE_WITH_EXTRA(mode), key, ksize,
+                    YK_REEMIT_EXTRAS(extras));
+}
+
+extern "C" yk_return_t yk_distributed_erase_multi(yk_distributed_database_t ddb,
+                                                  int32_t mode,
+                                                  size_t count,
+                                                  const void* const* keys,
+                                                  const size_t* ksizes, ...)
+{
+    YK_EXTRACT_EXTRAS(extras, mode, ksizes);
+    if(ddb == YOKAN_DISTRIBUTED_DATABASE_NULL)
+        return YOKAN_ERR_INVALID_ARGS;
+    if(count == 0)
+        return YOKAN_SUCCESS;
+    else if(!keys || !ksizes)
+        return YOKAN_ERR_INVALID_ARGS;
+
+    std::vector<std::vector<size_t>> groups;
+    auto ret = yk_distributed_group(ddb, count,
+        [&](size_t i) { return std::make_pair(keys[i], ksizes[i]); }, groups);
+    if(ret != YOKAN_SUCCESS) return ret;
+
+    return yk_distributed_run(ddb, yk_distributed_targets(groups), [&](size_t db) {
+        auto& group = groups[db];
+        std::vector<const void*> sub_keys;
+        std::vector<size_t>      sub_ksizes;
+        sub_keys.reserve(group.size());
+        sub_ksizes.reserve(group.size());
+        for(auto i : group) {
+            sub_keys.push_back(keys[i]);
+            sub_ksizes.push_back(ksizes[i]);
+        }
+        return yk_erase_multi(ddb->dbhs[db], YK_MODE_WITH_EXTRA(mode), group.size(),
+                              sub_keys.data(), sub_ksizes.data(),
+                              YK_REEMIT_EXTRAS(extras));
+    });
+}
+
+extern "C" yk_return_t yk_distributed_erase_packed(yk_distributed_database_t ddb,
+                                                   int32_t mode,
+                                                   size_t count,
+                                                   const void* keys,
+                                                   const size_t* ksizes, ...)
+{
+    YK_EXTRACT_EXTRAS(extras, mode, ksizes);
+    if(ddb == YOKAN_DISTRIBUTED_DATABASE_NULL)
+        return YOKAN_ERR_INVALID_ARGS;
+    if(count == 0)
+        return YOKAN_SUCCESS;
+    else if(!keys || !ksizes)
+        return YOKAN_ERR_INVALID_ARGS;
+    auto key_ptrs = yk_distributed_unpack(count, keys, ksizes);
+    return yk_distributed_erase_multi(ddb, YK_MODE_WITH_EXTRA(mode), count,
+                                      key_ptrs.data(), ksizes,
+                                      YK_REEMIT_EXTRAS(extras));
+}
+
+/**
+ * Merges the key/value pairs of all the databases in key order. Each
+ * database is read in batches with yk_iter, resuming after the last key
+ * of the previous batch, and the smallest of the next keys of all the
+ * databases is passed to the callback, until count pairs have been
+ * passed (if count is not 0) or all the databases are exhausted.
+ */
+static yk_return_t yk_distributed_merge(
+        yk_distributed_database_t ddb,
+        int32_t mode,
+        const yk_extra_opts_t& extras,
+        const void* from_key,
+        size_t from_ksize,
+        const void* filter,
+        size_t filter_size,
+        size_t count,
+        size_t batch_size,
+        bool ignore_values,
+        const std::function<yk_return_t(size_t, const std::string&, const std::string&)>& cb)
+{
+    if(mode & (YOKAN_MODE_NO_PREFIX|YOKAN_MODE_IGNORE_KEYS|YOKAN_MODE_CONSUME))
+        return YOKAN_ERR_MODE;
+
+    struct cursor {
+        std::vector<std::pair<std::string, std::string>> items;
+        size_t                                           next = 0;
+        bool                                             started = false;
+        bool                                             done = false;
+    };
+
+    if(batch_size == 0) batch_size = 64;
+    if(count != 0) batch_size = std::min(batch_size, count);
+
+    std::vector<cursor> cursors(ddb->dbhs.size());
+    auto refill = [&](size_t db) -> yk_return_t {
+        auto& c = cursors[db];
+        std::string last_key;
+        int32_t m = mode;
+        const void* from = from_key;
+        size_t from_size = from_ksize;
+        if(c.started) {
+            // resume after the last key read from this database
+            last_key = std::move(c.items.back().first);
+            from      = last_key.data();
+            from_size = last_key.size();
+            m &= ~YOKAN_MODE_INCLUSIVE;
+        }
+        c.items.clear();
+        c.next    = 0;
+        c.started = true;
+        yk_iter_options_t options;
+        options.batch_size    = batch_size;
+        options.pool          = ABT_POOL_NULL;
+        options.ignore_values = ignore_values;
+        auto append = [](void* uargs, size_t, const void* key, size_t ksize,
+                         const void* val, size_t vsize) -> yk_return_t {
+            auto items = static_cast<std::vector<std::pair<std::string, std::string>>*>(uargs);
+            items->emplace_back(
+                std::string{static_cast<const char*>(key), ksize},
+                val ? std::string{static_cast<const char*>(val), vsize} : std::string{});
+            return YOKAN_SUCCESS;
+        };
+        auto ret = yk_iter(ddb->dbhs[db], YK_MODE_WITH_EXTRA(m), from, from_size,
+                           filter, filter_size, batch_size, append, &c.items, &options,
+                           YK_REEMIT_EXTRAS(extras));
+        if(c.items.size() < batch_size) c.done = true;
+        return ret;
+    };
+
+    std::vector<size_t> targets(ddb->dbhs.size());
+    std::iota(targets.begin(), targets.end(), 0);
+    auto ret = yk_distributed_run(ddb, targets, refill);
+    if(ret != YOKAN_SUCCESS) return ret;
+
+    for(size_t index = 0; count == 0 || index < count; ++index) {
+        cursor* best = nullptr;
+        for(size_t db = 0; db < cursors.size(); ++db) {
+            auto& c = cursors[db];
+            if(c.next == c.items.size() && !c.done) {
+                ret = refill(db);
+                if(ret != YOKAN_SUCCESS) return ret;
+            }
+            if(c.next == c.items.size()) continue;
+            if(!best || c.items[c.next].first < best->items[best->next].first)
+                best = &c;
+        }
+        if(!best) break;
+        auto& item = best->items[best->next++];
+        ret = cb(index, item.first, item.second);
+        if(ret == YOKAN_STOP_ITERATION) break;
+        if(ret != YOKAN_SUCCESS) return ret;
+    }
+    return YOKAN_SUCCESS;
+}
+
+extern "C" yk_return_t yk_distributed_list_keys(yk_distributed_database_t ddb,
+                                                int32_t mode,
+                                                const void* from_key,
+                                                size_t from_ksize,
+                                                const void* filter,
+                                                size_t filter_size,
+                                                size_t count,
+                                                void* const* keys,
+                                                size_t* ksizes, ...)
+{
+    YK_EXTRACT_EXTRAS(extras, mode, ksizes);
+    if(ddb == YOKAN_DISTRIBUTED_DATABASE_NULL)
+        return YOKAN_ERR_INVALID_ARGS;
+    if(count == 0)
+        return YOKAN_SUCCESS;
+    else if(!keys || !ksizes)
+        return YOKAN_ERR_INVALID_ARGS;
+
+    size_t found = 0;
+    auto ret = yk_distributed_merge(ddb, mode, extras, from_key, from_ksize,
+                                    filter, filter_size, count, count, true,
+        [&](size_t i, const std::string& key, const std::string&) {
+            if(ksizes[i] < key.size()) {
+                ksizes[i] = YOKAN_SIZE_TOO_SMALL;
+            } else {
+                std::memcpy(keys[i], key.data(), key.size());
+                ksizes[i] = key.size();
+            }
+            found = i + 1;
+            return YOKAN_SUCCESS;
+        });
+    if(ret != YOKAN_SUCCESS) return ret;
+    for(size_t i = found; i < count; ++i)
+        ksizes[i] = YOKAN_NO_MORE_KEYS;
+    return YOKAN_SUCCESS;
+}
+
+extern "C" yk_return_t yk_distributed_iter(yk_distributed_database_t ddb,
+                                           int32_t mode,
+                                           const void* from_key,
+                                           size_t from_ksize,
+                                           const void* filter,
+                                           size_t filter_size,
+                                           size_t count,
+                                           yk_keyvalue_callback_t cb,
+                                           void* uargs,
+                                           const yk_iter_options_t* options, ...)
+{
+    YK_EXTRACT_EXTRAS(extras, mode, options);
+    if(ddb == YOKAN_DISTRIBUTED_DATABASE_NULL || !cb)
+        return YOKAN_ERR_INVALID_ARGS;
+
+    bool ignore_values = options ? options->ignore_values : false;
+    size_t batch_size  = options ? options->batch_size : 0;
+    return yk_distributed_merge(ddb, mode, extras, from_key, from_ksize,
+                                filter, filter_size, count, batch_size, ignore_values,
+        [&](size_t i, const std::string& key, const std::string& val) {
+            return cb(uargs, i, key.data(), key.size(),
+                      ignore_values ? nullptr : val.data(),
+                      ignore_values ? 0 : val.size());
+        });
+}
@@ -224,11 +224,6 @@ extern "C" yk_return_t yk_doc_list_packed(yk_database_handle_t dbh,
 {
     YK_EXTRACT_EXTRAS(extras, mode, doc_sizes);
 
-    if(mode & YOKAN_MODE_NO_RDMA)
-        return yk_doc_list_direct(dbh, collection, YK_MODE_WITH_EXTRA(mode),
-                start_id, filter, filter_size, count, ids,
-                bufsize, docs, doc_sizes, YK_REEMIT_EXTRAS(extras));
-
     if(count == 0)
         return YOKAN_SUCCESS;
     if(filter == nullptr && filter_size > 0) {
@@ -237,6 +232,12 @@ extern "C" yk_return_t yk_doc_list_packed(yk_database_handle_t dbh,
     if(ids == nullptr || (docs == nullptr && bufsize != 0) || doc_sizes == nullptr)
         return YOKAN_ERR_INVALID_ARGS;
 
+    size_t payload = filter_size + count*(sizeof(*ids)+sizeof(*doc_sizes)) + bufsize;
+    if(yk_client_use_direct(dbh->client, YK_CLIENT_OP_DOC_LIST, mode, extras, payload))
+        return yk_doc_list_direct(dbh, collection, YK_MODE_WITH_EXTRA(mode),
+                start_id, filter, filter_size, count, ids,
+                bufsize, docs, doc_sizes, YK_REEMIT_EXTRAS(extras));
+
     hg_bulk_t bulk   = HG_BULK_NULL;
     hg_return_t hret = HG_SUCCESS;
     std::array<void*,4> ptrs;
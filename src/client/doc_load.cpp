@@ -134,16 +134,17 @@ extern "C" yk_return_t yk_doc_load_packed(yk_database_handle_t dbh,
                                           size_t* rsizes, ...) {
     YK_EXTRACT_EXTRAS(extras, mode, rsizes);
 
-
-    if(mode & YOKAN_MODE_NO_RDMA) {
-        return yk_doc_load_direct(dbh, collection, YK_MODE_WITH_EXTRA(mode), count, ids,
-                                  rbufsize, records, rsizes, YK_REEMIT_EXTRAS(extras));
-    }
     if(count == 0)
         return YOKAN_SUCCESS;
     else if(!ids || !rsizes || (!records && rbufsize))
         return YOKAN_ERR_INVALID_ARGS;
 
+    size_t payload = count*(sizeof(*ids)+sizeof(*rsizes)) + rbufsize;
+    if(yk_client_use_direct(dbh->client, YK_CLIENT_OP_DOC_LOAD, mode, extras, payload)) {
+        return yk_doc_load_direct(dbh, collection, YK_MODE_WITH_EXTRA(mode), count, ids,
+                                  rbufsize, records, rsizes, YK_REEMIT_EXTRAS(extras));
+    }
+
     hg_bulk_t bulk   = HG_BULK_NULL;
     hg_return_t hret = HG_SUCCESS;
     std::array<void*,2> ptrs = { const_cast<size_t*>(rsizes),
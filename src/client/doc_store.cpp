@@ -134,16 +134,18 @@ extern "C" yk_return_t yk_doc_store_packed(yk_database_handle_t dbh,
                                            yk_id_t* ids, ...) {
     YK_EXTRACT_EXTRAS(extras, mode, ids);
 
-    if(mode & YOKAN_MODE_NO_RDMA) {
-        return yk_doc_store_direct(dbh, collection, YK_MODE_WITH_EXTRA(mode),
-                                   count, records, rsizes, ids, YK_REEMIT_EXTRAS(extras));
-    }
-
     if(count == 0)
         return YOKAN_SUCCESS;
     else if(rsizes == nullptr)
         return YOKAN_ERR_INVALID_ARGS;
 
+    size_t payload = count*(sizeof(*rsizes)+sizeof(*ids))
+                   + std::accumulate(rsizes, rsizes+count, (size_t)0);
+    if(yk_client_use_direct(dbh->client, YK_CLIENT_OP_DOC_STORE, mode, extras, payload)) {
+        return yk_doc_store_direct(dbh, collection, YK_MODE_WITH_EXTRA(mode),
+                                   count, records, rsizes, ids, YK_REEMIT_EXTRAS(extras));
+    }
+
     hg_bulk_t bulk   = HG_BULK_NULL;
     hg_return_t hret = HG_SUCCESS;
     std::array<void*,2> ptrs = { const_cast<size_t*>(rsizes),
@@ -184,7 +186,9 @@ extern "C" yk_return_t yk_doc_store_multi(yk_database_handle_t dbh,
     else if(!records || !rsizes)
         return YOKAN_ERR_INVALID_ARGS;
 
-    if(mode & YOKAN_MODE_NO_RDMA) {
+    size_t payload = count*(sizeof(*rsizes)+sizeof(*ids))
+                   + std::accumulate(rsizes, rsizes+count, (size_t)0);
+    if(yk_client_use_direct(dbh->client, YK_CLIENT_OP_DOC_STORE, mode, extras, payload)) {
         std::vector<char> packed_records;
         if(count > 1) {
             size_t total_size = std::accumulate(rsizes, rsizes+count, (size_t)0);
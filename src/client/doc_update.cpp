@@ -123,14 +123,16 @@ extern "C" yk_return_t yk_doc_update_packed(yk_database_handle_t dbh,
                                             const size_t* rsizes, ...) {
     YK_EXTRACT_EXTRAS(extras, mode, rsizes);
 
-    if(mode & YOKAN_MODE_NO_RDMA)
-        return yk_doc_update_direct(dbh, collection, YK_MODE_WITH_EXTRA(mode), count, ids, records, rsizes, YK_REEMIT_EXTRAS(extras));
-
     if(count == 0)
         return YOKAN_SUCCESS;
     else if(!rsizes || !ids)
         return YOKAN_ERR_INVALID_ARGS;
 
+    size_t payload = count*(sizeof(*rsizes)+sizeof(*ids))
+                   + std::accumulate(rsizes, rsizes+count, (size_t)0);
+    if(yk_client_use_direct(dbh->client, YK_CLIENT_OP_DOC_UPDATE, mode, extras, payload))
+        return yk_doc_update_direct(dbh, collection, YK_MODE_WITH_EXTRA(mode), count, ids, records, rsizes, YK_REEMIT_EXTRAS(extras));
+
     hg_bulk_t bulk   = HG_BULK_NULL;
     hg_return_t hret = HG_SUCCESS;
     std::array<void*,2> ptrs = { const_cast<size_t*>(rsizes),
@@ -172,7 +174,9 @@ extern "C" yk_return_t yk_doc_update_multi(yk_database_handle_t dbh,
     else if(!records || !rsizes || !ids)
         return YOKAN_ERR_INVALID_ARGS;
 
-    if(mode & YOKAN_MODE_NO_RDMA) {
+    size_t payload = count*(sizeof(*rsizes)+sizeof(*ids))
+                   + std::accumulate(rsizes, rsizes+count, (size_t)0);
+    if(yk_client_use_direct(dbh->client, YK_CLIENT_OP_DOC_UPDATE, mode, extras, payload)) {
         if(count == 1) {
             return yk_doc_update_direct(dbh, collection, YK_MODE_WITH_EXTRA(mode),
                                         count, ids, records[0], rsizes, YK_REEMIT_EXTRAS(extras));
@@ -38,11 +38,14 @@ static yk_return_t yk_erase_direct(yk_database_handle_t dbh,
 
     in.mode   = mode;
     in.timeout_ms = extras.timeout_ms;
+    in.trace_id   = extras.trace_id;
     in.ksizes.sizes = (size_t*)ksizes;
     in.ksizes.count = count;
     in.keys.data = (char*)keys;
     in.keys.size = std::accumulate(ksizes, ksizes+count, (size_t)0);
 
+    YK_FLUSH_COMBINED_WRITES(dbh);
+
     hret = margo_create(mid, dbh->addr, dbh->client->erase_direct_id, &handle);
     CHECK_HRET(hret, margo_create);
     DEFER(margo_destroy(handle));
@@ -71,13 +74,13 @@ static yk_return_t yk_erase_direct(yk_database_handle_t dbh,
  *   M = sum of value sizes
  */
 
-extern "C" yk_return_t yk_erase_bulk(yk_database_handle_t dbh,
-                                     int32_t mode,
-                                     size_t count,
-                                     const char* origin,
-                                     hg_bulk_t data,
-                                     size_t offset,
-                                     size_t size, ...)
+static yk_return_t yk_erase_bulk_send(yk_database_handle_t dbh,
+                                      int32_t mode,
+                                      size_t count,
+                                      const char* origin,
+                                      hg_bulk_t data,
+                                      size_t offset,
+                                      size_t size, ...)
 {
     YK_EXTRACT_EXTRAS(extras, mode, size);
 
@@ -95,12 +98,15 @@ extern "C" yk_return_t yk_erase_bulk(yk_database_handle_t dbh,
 
     in.mode   = mode;
     in.timeout_ms = extras.timeout_ms;
+    in.trace_id   = extras.trace_id;
     in.count  = count;
     in.bulk   = data;
     in.offset = offset;
     in.size   = size;
     in.origin = const_cast<char*>(origin);
 
+    YK_FLUSH_COMBINED_WRITES(dbh);
+
     hret = margo_create(mid, dbh->addr, dbh->client->erase_id, &handle);
     CHECK_HRET(hret, margo_create);
     DEFER(margo_destroy(handle));
@@ -118,6 +124,20 @@ extern "C" yk_return_t yk_erase_bulk(yk_database_handle_t dbh,
     return ret;
 }
 
+extern "C" yk_return_t yk_erase_bulk(yk_database_handle_t dbh,
+                                     int32_t mode,
+                                     size_t count,
+                                     const char* origin,
+                                     hg_bulk_t data,
+                                     size_t offset,
+                                     size_t size, ...)
+{
+    YK_EXTRACT_EXTRAS(extras, mode, size);
+    YK_INVALIDATE_CACHE(dbh);
+    return yk_erase_bulk_send(dbh, YK_MODE_WITH_EXTRA(mode), count, origin, data, offset, size,
+                              YK_REEMIT_EXTRAS(extras));
+}
+
 extern "C" yk_return_t yk_erase(yk_database_handle_t dbh,
                                 int32_t mode,
                                 const void* key,
@@ -127,6 +147,10 @@ extern "C" yk_return_t yk_erase(yk_database_handle_t dbh,
 
     if(ksize == 0)
         return YOKAN_ERR_INVALID_ARGS;
+    yk_return_t ret;
+    YK_INVALIDATE_CACHED_PACKED(dbh, 1, key, &ksize);
+    if(yk_write_combiner_erase(dbh, mode, extras, key, ksize, &ret))
+        return ret;
     return yk_erase_packed(dbh, YK_MODE_WITH_EXTRA(mode), 1, key, &ksize, YK_REEMIT_EXTRAS(extras));
 }
 
@@ -143,7 +167,11 @@ extern "C" yk_return_t yk_erase_multi(yk_database_handle_t dbh,
     else if(!keys || !ksizes)
         return YOKAN_ERR_INVALID_ARGS;
 
-    if(mode & YOKAN_MODE_NO_RDMA) {
+    YK_INVALIDATE_CACHED_MULTI(dbh, count, keys, ksizes);
+
+    size_t payload = count*sizeof(*ksizes)
+                   + std::accumulate(ksizes, ksizes+count, (size_t)0);
+    if(yk_client_use_direct(dbh->client, YK_CLIENT_OP_ERASE, mode, extras, payload)) {
         if(count == 1) {
             return yk_erase_direct(dbh, YK_MODE_WITH_EXTRA(mode), 1, keys[0], ksizes, YK_REEMIT_EXTRAS(extras));
         }
@@ -182,7 +210,7 @@ extern "C" yk_return_t yk_erase_multi(yk_database_handle_t dbh,
     CHECK_HRET(hret, margo_bulk_create);
     DEFER(margo_bulk_free(bulk));
 
-    return yk_erase_bulk(dbh, YK_MODE_WITH_EXTRA(mode), count, nullptr, bulk, 0, total_size, YK_REEMIT_EXTRAS(extras));
+    return yk_erase_bulk_send(dbh, YK_MODE_WITH_EXTRA(mode), count, nullptr, bulk, 0, total_size, YK_REEMIT_EXTRAS(extras));
 }
 
 extern "C" yk_return_t yk_erase_packed(yk_database_handle_t dbh,
@@ -193,14 +221,18 @@ extern "C" yk_return_t yk_erase_packed(yk_database_handle_t dbh,
 {
     YK_EXTRACT_EXTRAS(extras, mode, ksizes);
 
-    if(mode & YOKAN_MODE_NO_RDMA)
-        return yk_erase_direct(dbh, YK_MODE_WITH_EXTRA(mode), count, keys, ksizes, YK_REEMIT_EXTRAS(extras));
-
     if(count == 0)
         return YOKAN_SUCCESS;
     else if(!keys || !ksizes)
         return YOKAN_ERR_INVALID_ARGS;
 
+    YK_INVALIDATE_CACHED_PACKED(dbh, count, keys, ksizes);
+
+    size_t payload = count*sizeof(*ksizes)
+                   + std::accumulate(ksizes, ksizes+count, (size_t)0);
+    if(yk_client_use_direct(dbh->client, YK_CLIENT_OP_ERASE, mode, extras, payload))
+        return yk_erase_direct(dbh, YK_MODE_WITH_EXTRA(mode), count, keys, ksizes, YK_REEMIT_EXTRAS(extras));
+
     hg_bulk_t bulk   = HG_BULK_NULL;
     hg_return_t hret = HG_SUCCESS;
     std::array<void*,2> ptrs = { const_cast<size_t*>(ksizes),
@@ -220,5 +252,5 @@ extern "C" yk_return_t yk_erase_packed(yk_database_handle_t dbh,
     CHECK_HRET(hret, margo_bulk_create);
     DEFER(margo_bulk_free(bulk));
 
-    return yk_erase_bulk(dbh, YK_MODE_WITH_EXTRA(mode), count, nullptr, bulk, 0, total_size, YK_REEMIT_EXTRAS(extras));
+    return yk_erase_bulk_send(dbh, YK_MODE_WITH_EXTRA(mode), count, nullptr, bulk, 0, total_size, YK_REEMIT_EXTRAS(extras));
 }
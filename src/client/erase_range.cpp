@@ -35,6 +35,9 @@ extern "C" yk_return_t yk_erase_range(yk_database_handle_t dbh,
     in.prefix.data  = (char*)prefix;
     in.prefix.size  = prefix_size;
 
+    YK_INVALIDATE_CACHED_PREFIX(dbh, prefix, prefix_size);
+    YK_FLUSH_COMBINED_WRITES(dbh);
+
     hret = margo_create(mid, dbh->addr, dbh->client->erase_range_id, &handle);
     CHECK_HRET(hret, margo_create);
     DEFER(margo_destroy(handle));
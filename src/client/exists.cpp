@@ -44,11 +44,14 @@ static yk_return_t yk_exists_direct(yk_database_handle_t dbh,
 
     in.mode        = mode;
     in.timeout_ms  = extras.timeout_ms;
+    in.trace_id    = extras.trace_id;
     in.keys.data   = (char*)keys;
     in.keys.size   = std::accumulate(ksizes, ksizes+count, (size_t)0);
     in.sizes.sizes = (size_t*)ksizes;
     in.sizes.count = count;
 
+    YK_FLUSH_COMBINED_WRITES(dbh);
+
     hret = margo_create(mid, dbh->addr, dbh->client->exists_direct_id, &handle);
     CHECK_HRET(hret, margo_create);
     DEFER(margo_destroy(handle));
@@ -109,12 +112,15 @@ extern "C" yk_return_t yk_exists_bulk(yk_database_handle_t dbh,
 
     in.mode   = mode;
     in.timeout_ms = extras.timeout_ms;
+    in.trace_id   = extras.trace_id;
     in.count  = count;
     in.bulk   = data;
     in.offset = offset;
     in.size   = size;
     in.origin = const_cast<char*>(origin);
 
+    YK_FLUSH_COMBINED_WRITES(dbh);
+
     hret = margo_create(mid, dbh->addr, dbh->client->exists_id, &handle);
     CHECK_HRET(hret, margo_create);
     DEFER(margo_destroy(handle));
@@ -159,7 +165,9 @@ extern "C" yk_return_t yk_exists_multi(yk_database_handle_t dbh,
     else if(!keys || !ksizes || !flags)
         return YOKAN_ERR_INVALID_ARGS;
 
-    if(mode & YOKAN_MODE_NO_RDMA) {
+    size_t payload = count*(sizeof(*ksizes)+sizeof(*flags))
+                   + std::accumulate(ksizes, ksizes+count, (size_t)0);
+    if(yk_client_use_direct(dbh->client, YK_CLIENT_OP_EXISTS, mode, extras, payload)) {
         if(count == 1) {
             return yk_exists_direct(dbh, YK_MODE_WITH_EXTRA(mode), count, keys[0], ksizes, flags, YK_REEMIT_EXTRAS(extras));
         }
@@ -217,14 +225,16 @@ extern "C" yk_return_t yk_exists_packed(yk_database_handle_t dbh,
 {
     YK_EXTRACT_EXTRAS(extras, mode, flags);
 
-    if(mode & YOKAN_MODE_NO_RDMA)
-        return yk_exists_direct(dbh, YK_MODE_WITH_EXTRA(mode), count, keys, ksizes, flags, YK_REEMIT_EXTRAS(extras));
-
     if(count == 0)
         return YOKAN_SUCCESS;
     else if(!keys || !ksizes || !flags)
         return YOKAN_ERR_INVALID_ARGS;
 
+    size_t payload = count*(sizeof(*ksizes)+sizeof(*flags))
+                   + std::accumulate(ksizes, ksizes+count, (size_t)0);
+    if(yk_client_use_direct(dbh->client, YK_CLIENT_OP_EXISTS, mode, extras, payload))
+        return yk_exists_direct(dbh, YK_MODE_WITH_EXTRA(mode), count, keys, ksizes, flags, YK_REEMIT_EXTRAS(extras));
+
     hg_bulk_t bulk   = HG_BULK_NULL;
     hg_return_t hret = HG_SUCCESS;
     std::array<void*,3> ptrs = { const_cast<size_t*>(ksizes),
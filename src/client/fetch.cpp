@@ -65,6 +65,7 @@ static yk_return_t yk_fetch_direct(yk_database_handle_t dbh,
 
     in.mode         = mode;
     in.timeout_ms   = extras.timeout_ms;
+    in.trace_id     = extras.trace_id;
     in.ksizes.sizes = (size_t*)ksizes;
     in.ksizes.count = count;
     in.keys.data    = (char*)keys;
@@ -72,6 +73,9 @@ static yk_return_t yk_fetch_direct(yk_database_handle_t dbh,
     in.op_ref       = reinterpret_cast<uint64_t>(&context);
     in.batch_size   = options ? options->batch_size : 0;
 
+    YK_INVALIDATE_CACHE_IF_CONSUMING(dbh, mode);
+    YK_FLUSH_COMBINED_WRITES(dbh);
+
     hret = margo_create(mid, dbh->addr, dbh->client->fetch_direct_id, &handle);
     CHECK_HRET(hret, margo_create);
     DEFER(margo_destroy(handle));
@@ -190,6 +194,7 @@ extern "C" yk_return_t yk_fetch_bulk(yk_database_handle_t dbh,
 
     in.mode   = mode;
     in.timeout_ms = extras.timeout_ms;
+    in.trace_id   = extras.trace_id;
     in.count  = count;
     in.bulk   = data;
     in.offset = offset;
@@ -198,6 +203,9 @@ extern "C" yk_return_t yk_fetch_bulk(yk_database_handle_t dbh,
     in.op_ref = reinterpret_cast<uint64_t>(&context);
     in.batch_size = options ? options->batch_size : 0;
 
+    YK_INVALIDATE_CACHE_IF_CONSUMING(dbh, mode);
+    YK_FLUSH_COMBINED_WRITES(dbh);
+
     hret = margo_create(mid, dbh->addr, dbh->client->fetch_id, &handle);
     CHECK_HRET(hret, margo_create);
     DEFER(margo_destroy(handle));
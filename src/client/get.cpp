@@ -41,6 +41,7 @@ static yk_return_t yk_get_direct(yk_database_handle_t dbh,
 
     in.mode         = mode;
     in.timeout_ms   = extras.timeout_ms;
+    in.trace_id     = extras.trace_id;
     in.vbufsize     = vbufsize;
     in.ksizes.sizes = (size_t*)ksizes;
     in.ksizes.count = count;
@@ -52,6 +53,9 @@ static yk_return_t yk_get_direct(yk_database_handle_t dbh,
     out.vals.data    = (char*)values;
     out.vals.size    = vbufsize;
 
+    YK_INVALIDATE_CACHE_IF_CONSUMING(dbh, mode);
+    YK_FLUSH_COMBINED_WRITES(dbh);
+
     hret = margo_create(mid, dbh->addr, dbh->client->get_direct_id, &handle);
     CHECK_HRET(hret, margo_create);
     DEFER(margo_destroy(handle));
@@ -111,6 +115,7 @@ extern "C" yk_return_t yk_get_bulk(yk_database_handle_t dbh,
 
     in.mode   = mode;
     in.timeout_ms = extras.timeout_ms;
+    in.trace_id   = extras.trace_id;
     in.count  = count;
     in.bulk   = data;
     in.offset = offset;
@@ -118,6 +123,9 @@ extern "C" yk_return_t yk_get_bulk(yk_database_handle_t dbh,
     in.origin = const_cast<char*>(origin);
     in.packed = packed;
 
+    YK_INVALIDATE_CACHE_IF_CONSUMING(dbh, mode);
+    YK_FLUSH_COMBINED_WRITES(dbh);
+
     hret = margo_create(mid, dbh->addr, dbh->client->get_id, &handle);
     CHECK_HRET(hret, margo_create);
     DEFER(margo_destroy(handle));
@@ -146,12 +154,17 @@ extern "C" yk_return_t yk_get(yk_database_handle_t dbh,
 
     if(ksize == 0)
         return YOKAN_ERR_INVALID_ARGS;
-    yk_return_t ret = yk_get_packed(dbh, YK_MODE_WITH_EXTRA(mode), 1, key, &ksize, *vsize, value, vsize, YK_REEMIT_EXTRAS(extras));
+    yk_return_t ret;
+    uint64_t generation;
+    if(yk_read_cache_lookup(dbh, mode, key, ksize, value, vsize, &ret, &generation))
+        return ret;
+    ret = yk_get_packed(dbh, YK_MODE_WITH_EXTRA(mode), 1, key, &ksize, *vsize, value, vsize, YK_REEMIT_EXTRAS(extras));
     if(ret != YOKAN_SUCCESS) return ret;
     else if(*vsize == YOKAN_SIZE_TOO_SMALL)
         return YOKAN_ERR_BUFFER_SIZE;
     else if(*vsize == YOKAN_KEY_NOT_FOUND)
         return YOKAN_ERR_KEY_NOT_FOUND;
+    yk_read_cache_insert(dbh, generation, key, ksize, value, *vsize);
     return YOKAN_SUCCESS;
 }
 
@@ -199,9 +212,9 @@ extern "C" yk_return_t yk_get_multi(yk_database_handle_t dbh,
 
     size_t total_size = std::accumulate(sizes.begin(), sizes.end(), (size_t)0);
 
-    hret = margo_bulk_create(mid, ptrs.size(), ptrs.data(), sizes.data(),
-                             HG_BULK_READWRITE, &bulk);
-    CHECK_HRET(hret, margo_bulk_create);
+    hret = yk_client_bulk_create(dbh->client, ptrs.size(), ptrs.data(), sizes.data(),
+                                 HG_BULK_READWRITE, &bulk);
+    CHECK_HRET(hret, yk_client_bulk_create);
     DEFER(margo_bulk_free(bulk));
 
     return yk_get_bulk(dbh, YK_MODE_WITH_EXTRA(mode), count, nullptr, bulk, 0, total_size, false, YK_REEMIT_EXTRAS(extras));
@@ -218,15 +231,18 @@ extern "C" yk_return_t yk_get_packed(yk_database_handle_t dbh,
 {
     YK_EXTRACT_EXTRAS(extras, mode, vsizes);
 
-    if(mode & YOKAN_MODE_NO_RDMA) {
-        return yk_get_direct(dbh, YK_MODE_WITH_EXTRA(mode), count, keys, ksizes, vbufsize, values, vsizes, YK_REEMIT_EXTRAS(extras));
-    }
-
     if(count == 0)
         return YOKAN_SUCCESS;
     else if(!keys || !ksizes || !vsizes || (!values && vbufsize))
         return YOKAN_ERR_INVALID_ARGS;
 
+    size_t payload = count*(sizeof(*ksizes)+sizeof(*vsizes))
+                   + std::accumulate(ksizes, ksizes+count, (size_t)0)
+                   + vbufsize;
+    if(yk_client_use_direct(dbh->client, YK_CLIENT_OP_GET, mode, extras, payload)) {
+        return yk_get_direct(dbh, YK_MODE_WITH_EXTRA(mode), count, keys, ksizes, vbufsize, values, vsizes, YK_REEMIT_EXTRAS(extras));
+    }
+
     hg_bulk_t bulk   = HG_BULK_NULL;
     hg_return_t hret = HG_SUCCESS;
     std::array<void*,4> ptrs = { const_cast<size_t*>(ksizes),
@@ -245,11 +261,160 @@ extern "C" yk_return_t yk_get_packed(yk_database_handle_t dbh,
         return YOKAN_ERR_INVALID_ARGS;
 
     int seg_count = sizes[3] != 0 ? 4 : 3;
-    hret = margo_bulk_create(mid, seg_count, ptrs.data(), sizes.data(),
-                             HG_BULK_READWRITE, &bulk);
+    hret = yk_client_bulk_create(dbh->client, seg_count, ptrs.data(), sizes.data(),
+                                 HG_BULK_READWRITE, &bulk);
 
-    CHECK_HRET(hret, margo_bulk_create);
+    CHECK_HRET(hret, yk_client_bulk_create);
     DEFER(margo_bulk_free(bulk));
 
     return yk_get_bulk(dbh, YK_MODE_WITH_EXTRA(mode), count, nullptr, bulk, 0, total_size, true, YK_REEMIT_EXTRAS(extras));
 }
+
+/**
+ * The get_alloc operation sends the keys along with the RPC. The provider
+ * responds with the value sizes and either the values themselves, if
+ * they fit within the inline threshold, or a bulk handle to a buffer it
+ * holds the values in, under a lease. In the latter case the client
+ * pulls the values into a buffer of the right size, then sends a
+ * get_alloc_release RPC (which has no response) to end the lease.
+ */
+
+extern "C" yk_return_t yk_get_alloc_packed(yk_database_handle_t dbh,
+                                           int32_t mode,
+                                           size_t count,
+                                           const void* keys,
+                                           const size_t* ksizes,
+                                           void** values,
+                                           size_t* vsizes, ...)
+{
+    YK_EXTRACT_EXTRAS(extras, mode, vsizes);
+
+    if(!values)
+        return YOKAN_ERR_INVALID_ARGS;
+    *values = nullptr;
+    if(count == 0)
+        return YOKAN_SUCCESS;
+    else if(!keys || !ksizes || !vsizes)
+        return YOKAN_ERR_INVALID_ARGS;
+
+    CHECK_MODE_VALID(mode);
+
+    margo_instance_id mid = dbh->client->mid;
+    yk_return_t ret = YOKAN_SUCCESS;
+    hg_return_t hret = HG_SUCCESS;
+    get_alloc_in_t in;
+    get_alloc_out_t out;
+    hg_handle_t handle = HG_HANDLE_NULL;
+
+    size_t threshold = extras.direct_threshold != SIZE_MAX
+                     ? extras.direct_threshold
+                     : dbh->client->direct_threshold.load(std::memory_order_relaxed);
+    if(mode & YOKAN_MODE_NO_RDMA)
+        threshold = SIZE_MAX;
+    else
+        threshold = threshold > YK_DIRECT_HEADER_SIZE ? threshold - YK_DIRECT_HEADER_SIZE : 0;
+
+    in.mode             = mode;
+    in.timeout_ms       = extras.timeout_ms;
+    in.trace_id         = extras.trace_id;
+    in.inline_threshold = threshold;
+    in.ksizes.sizes     = (size_t*)ksizes;
+    in.ksizes.count     = count;
+    in.keys.data        = (char*)keys;
+    in.keys.size        = std::accumulate(ksizes, ksizes+count, (size_t)0);
+
+    // the value sizes are decoded into the caller's array, the values
+    // into a buffer allocated by the decoder, which we hand to the caller
+    out.vsizes.sizes = vsizes;
+    out.vsizes.count = count;
+    out.vals.data    = nullptr;
+    out.vals.size    = 0;
+
+    YK_INVALIDATE_CACHE_IF_CONSUMING(dbh, mode);
+    YK_FLUSH_COMBINED_WRITES(dbh);
+
+    hret = margo_create(mid, dbh->addr, dbh->client->get_alloc_id, &handle);
+    CHECK_HRET(hret, margo_create);
+    DEFER(margo_destroy(handle));
+
+    hret = margo_provider_forward_timed(dbh->provider_id, handle, &in, extras.timeout_ms);
+    CHECK_HRET(hret, margo_provider_forward_timed);
+
+    hret = margo_get_output(handle, &out);
+    CHECK_HRET(hret, margo_get_output);
+
+    char* buffer = out.vals.data;
+    size_t total_vsize = 0;
+    ret = static_cast<yk_return_t>(out.ret);
+    if(ret == YOKAN_SUCCESS) {
+        for(size_t i = 0; i < count; ++i)
+            if(vsizes[i] != YOKAN_KEY_NOT_FOUND) total_vsize += vsizes[i];
+    }
+
+    if(ret == YOKAN_SUCCESS && out.bulk != HG_BULK_NULL) {
+        auto& counters = dbh->client->transport[YK_CLIENT_OP_GET];
+        counters.bulk.fetch_add(1, std::memory_order_relaxed);
+        // the values were not sent inline, pull them from the provider
+        free(buffer);
+        buffer = (char*)malloc(total_vsize);
+        hg_bulk_t local_bulk = HG_BULK_NULL;
+        void* ptr = buffer;
+        hg_size_t size = total_vsize;
+        hret = margo_bulk_create(mid, 1, &ptr, &size, HG_BULK_WRITE_ONLY, &local_bulk);
+        if(hret == HG_SUCCESS) {
+            hret = margo_bulk_transfer(mid, HG_BULK_PULL, dbh->addr,
+                    out.bulk, 0, local_bulk, 0, total_vsize);
+            margo_bulk_free(local_bulk);
+        }
+        if(hret != HG_SUCCESS) {
+            YOKAN_LOG_ERROR(mid, "margo_bulk_transfer returned %d", hret);
+            ret = YOKAN_ERR_FROM_MERCURY;
+        }
+        get_alloc_release_in_t release_in;
+        release_in.lease = out.lease;
+        hg_handle_t release_handle = HG_HANDLE_NULL;
+        if(margo_create(mid, dbh->addr, dbh->client->get_alloc_release_id,
+                        &release_handle) == HG_SUCCESS) {
+            margo_provider_forward(dbh->provider_id, release_handle, &release_in);
+            margo_destroy(release_handle);
+        }
+    } else if(ret == YOKAN_SUCCESS) {
+        auto& counters = dbh->client->transport[YK_CLIENT_OP_GET];
+        counters.direct.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    out.vsizes.sizes = nullptr;
+    out.vsizes.count = 0;
+    out.vals.data    = nullptr;
+    out.vals.size    = 0;
+    hret = margo_free_output(handle, &out);
+    if(ret == YOKAN_SUCCESS && hret != HG_SUCCESS) {
+        YOKAN_LOG_ERROR(mid, "margo_free_output returned %d", hret);
+        ret = YOKAN_ERR_FROM_MERCURY;
+    }
+
+    if(ret != YOKAN_SUCCESS || total_vsize == 0) {
+        free(buffer);
+        buffer = nullptr;
+    }
+    *values = buffer;
+    return ret;
+}
+
+extern "C" yk_return_t yk_get_alloc(yk_database_handle_t dbh,
+                                    int32_t mode,
+                                    const void* key,
+                                    size_t ksize,
+                                    void** value,
+                                    size_t* vsize, ...)
+{
+    YK_EXTRACT_EXTRAS(extras, mode, vsize);
+    if(!value || !vsize)
+        return YOKAN_ERR_INVALID_ARGS;
+    yk_return_t ret = yk_get_alloc_packed(dbh, YK_MODE_WITH_EXTRA(mode), 1,
+                                          key, &ksize, value, vsize,
+                                          YK_REEMIT_EXTRAS(extras));
+    if(ret == YOKAN_SUCCESS && *vsize == YOKAN_KEY_NOT_FOUND)
+        ret = YOKAN_ERR_KEY_NOT_FOUND;
+    return ret;
+}
@@ -0,0 +1,89 @@
+/*
+ * (C) 2026 The University of Chicago
+ *
+ * See COPYRIGHT in top-level directory.
+ */
+#include "client.hpp"
+#include "../common/defer.hpp"
+#include "../common/types.h"
+#include "../common/logging.h"
+#include "../common/checks.h"
+#include "../common/extras.h"
+
+/**
+ * The range is sent back in the response if it fits within the direct
+ * threshold, otherwise the provider pushes it into a bulk handle exposing
+ * the caller's buffer.
+ */
+extern "C" yk_return_t yk_get_range(yk_database_handle_t dbh,
+                                    int32_t mode,
+                                    const void* key,
+                                    size_t ksize,
+                                    size_t offset,
+                                    void* buffer,
+                                    size_t* size, ...)
+{
+    YK_EXTRACT_EXTRAS(extras, mode, size);
+
+    if(!key || ksize == 0 || !size || (!buffer && *size))
+        return YOKAN_ERR_INVALID_ARGS;
+
+    CHECK_MODE_VALID(mode);
+
+    margo_instance_id mid = dbh->client->mid;
+    yk_return_t ret = YOKAN_SUCCESS;
+    hg_return_t hret = HG_SUCCESS;
+    get_range_in_t in;
+    get_range_out_t out;
+    hg_handle_t handle = HG_HANDLE_NULL;
+    hg_bulk_t bulk = HG_BULK_NULL;
+
+    if(*size != 0
+    && !yk_client_use_direct(dbh->client, YK_CLIENT_OP_GET, mode, extras, ksize + *size)) {
+        void* ptr = buffer;
+        hg_size_t bsize = *size;
+        hret = yk_client_bulk_create(dbh->client, 1, &ptr, &bsize,
+                                     HG_BULK_WRITE_ONLY, &bulk);
+        CHECK_HRET(hret, yk_client_bulk_create);
+    }
+    DEFER(if(bulk != HG_BULK_NULL) margo_bulk_free(bulk));
+
+    in.mode       = mode;
+    in.timeout_ms = extras.timeout_ms;
+    in.trace_id   = extras.trace_id;
+    in.key.data   = (char*)key;
+    in.key.size   = ksize;
+    in.offset     = offset;
+    in.size       = *size;
+    in.origin     = nullptr;
+    in.bulk       = bulk;
+
+    // inline data is decoded directly into the caller's buffer
+    out.data.data = (char*)buffer;
+    out.data.size = *size;
+    out.size      = 0;
+
+    YK_INVALIDATE_CACHE_IF_CONSUMING(dbh, mode);
+    YK_FLUSH_COMBINED_WRITES(dbh);
+
+    hret = margo_create(mid, dbh->addr, dbh->client->get_range_id, &handle);
+    CHECK_HRET(hret, margo_create);
+    DEFER(margo_destroy(handle));
+
+    hret = margo_provider_forward_timed(dbh->provider_id, handle, &in, extras.timeout_ms);
+    CHECK_HRET(hret, margo_provider_forward_timed);
+
+    hret = margo_get_output(handle, &out);
+    CHECK_HRET(hret, margo_get_output);
+
+    ret = static_cast<yk_return_t>(out.ret);
+    if(ret == YOKAN_SUCCESS)
+        *size = out.size;
+
+    out.data.data = nullptr;
+    out.data.size = 0;
+    hret = margo_free_output(handle, &out);
+    CHECK_HRET(hret, margo_free_output);
+
+    return ret;
+}
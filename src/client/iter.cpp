@@ -19,6 +19,10 @@ struct iter_context {
     yk_keyvalue_callback_t cb;
     void*                  uargs;
     yk_iter_options_t      options;
+    // buffer receiving the batches, registered once and reused by the
+    // iter_back RPCs (which the server sends one at a time)
+    std::vector<char>      buffer;
+    hg_bulk_t              bulk = HG_BULK_NULL;
 };
 
 yk_return_t yk_iter(yk_database_handle_t dbh,
@@ -53,6 +57,7 @@ yk_return_t yk_iter(yk_database_handle_t dbh,
     iter_context context;
     context.cb      = cb;
     context.uargs   = uargs;
+    DEFER(if(context.bulk != HG_BULK_NULL) margo_bulk_free(context.bulk));
     if(options) {
         context.options.batch_size    = options->batch_size;
         context.options.pool          = options->pool;
@@ -74,6 +79,9 @@ yk_return_t yk_iter(yk_database_handle_t dbh,
     in.filter.size   = filter_size;
     in.op_ref        = reinterpret_cast<uint64_t>(&context);
 
+    YK_INVALIDATE_CACHE_IF_CONSUMING(dbh, mode);
+    YK_FLUSH_COMBINED_WRITES(dbh);
+
     hret = margo_create(mid, dbh->addr,
         mode & YOKAN_MODE_NO_RDMA ? dbh->client->iter_direct_id : dbh->client->iter_id, &handle);
     CHECK_HRET(hret, margo_create);
@@ -118,22 +126,27 @@ void yk_iter_back_ult(hg_handle_t h)
 
     iter_context* context = reinterpret_cast<iter_context*>(in.op_ref);
 
-    // create bulk for the keys and values
-    std::vector<size_t>     ksizes(in.count);
-    std::vector<size_t>     vsizes(in.count);
-    std::vector<char>       buffer(in.size - 2*in.count*sizeof(size_t));
-
-    std::array<void*,3>     buffer_ptrs  = { ksizes.data(), vsizes.data(), buffer.data() };
-    std::array<hg_size_t,3> buffer_sizes = { ksizes.size()*sizeof(size_t), vsizes.size()*sizeof(size_t), buffer.size() };
-    hg_bulk_t local_bulk  = HG_BULK_NULL;
-    hret = margo_bulk_create(mid, 3, buffer_ptrs.data(), buffer_sizes.data(), HG_BULK_WRITE_ONLY, &local_bulk);
-    CHECK_HRET_OUT(hret, margo_bulk_create);
-    DEFER(margo_bulk_free(local_bulk));
+    // (re)create the bulk for the keys and values if the current one is too small
+    if(context->buffer.size() < in.size) {
+        if(context->bulk != HG_BULK_NULL) {
+            margo_bulk_free(context->bulk);
+            context->bulk = HG_BULK_NULL;
+        }
+        context->buffer.resize(in.size);
+        void* buffer_ptr = context->buffer.data();
+        hg_size_t buffer_size = context->buffer.size();
+        hret = margo_bulk_create(mid, 1, &buffer_ptr, &buffer_size, HG_BULK_WRITE_ONLY, &context->bulk);
+        CHECK_HRET_OUT(hret, margo_bulk_create);
+    }
 
     // pull the data
-    hret = margo_bulk_transfer(mid, HG_BULK_PULL, info->addr, in.bulk, 0, local_bulk, 0, in.size);
+    hret = margo_bulk_transfer(mid, HG_BULK_PULL, info->addr, in.bulk, 0, context->bulk, 0, in.size);
     CHECK_HRET_OUT(hret, margo_bulk_transfer);
 
+    const size_t* ksizes = reinterpret_cast<const size_t*>(context->buffer.data());
+    const size_t* vsizes = ksizes + in.count;
+    const char*   buffer = context->buffer.data() + 2*in.count*sizeof(size_t);
+
     const auto& opt = context->options;
     ABT_pool pool = opt.pool ? opt.pool : ABT_POOL_NULL;
 
@@ -168,9 +181,9 @@ void yk_iter_back_ult(hg_handle_t h)
         args[i].cb    = context->cb;
         args[i].uargs = context->uargs;
         args[i].index = in.start + i;
-        args[i].key   = buffer.data() + offset;
+        args[i].key   = buffer + offset;
         args[i].ksize = ksizes[i];
-        args[i].val   = buffer.data() + offset + ksizes[i];
+        args[i].val   = buffer + offset + ksizes[i];
         args[i].vsize = vsizes[i];
         if(pool == ABT_POOL_NULL) {
             ult(&args[i]);
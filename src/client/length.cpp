@@ -39,6 +39,7 @@ static yk_return_t yk_length_direct(yk_database_handle_t dbh,
 
     in.mode        = mode;
     in.timeout_ms  = extras.timeout_ms;
+    in.trace_id    = extras.trace_id;
     in.keys.data   = (char*)keys;
     in.keys.size   = std::accumulate(ksizes, ksizes+count, (size_t)0);
     in.sizes.sizes = (size_t*)ksizes;
@@ -47,6 +48,8 @@ static yk_return_t yk_length_direct(yk_database_handle_t dbh,
     out.sizes.sizes = vsizes;
     out.sizes.count = count;
 
+    YK_FLUSH_COMBINED_WRITES(dbh);
+
     hret = margo_create(mid, dbh->addr, dbh->client->length_direct_id, &handle);
     CHECK_HRET(hret, margo_create);
     DEFER(margo_destroy(handle));
@@ -102,12 +105,15 @@ extern "C" yk_return_t yk_length_bulk(yk_database_handle_t dbh,
 
     in.mode   = mode;
     in.timeout_ms = extras.timeout_ms;
+    in.trace_id   = extras.trace_id;
     in.count  = count;
     in.bulk   = data;
     in.offset = offset;
     in.size   = size;
     in.origin = const_cast<char*>(origin);
 
+    YK_FLUSH_COMBINED_WRITES(dbh);
+
     hret = margo_create(mid, dbh->addr, dbh->client->length_id, &handle);
     CHECK_HRET(hret, margo_create);
     DEFER(margo_destroy(handle));
@@ -156,7 +162,9 @@ extern "C" yk_return_t yk_length_multi(yk_database_handle_t dbh,
     else if(!keys || !ksizes || !vsizes)
         return YOKAN_ERR_INVALID_ARGS;
 
-    if(mode & YOKAN_MODE_NO_RDMA) {
+    size_t payload = count*(sizeof(*ksizes)+sizeof(*vsizes))
+                   + std::accumulate(ksizes, ksizes+count, (size_t)0);
+    if(yk_client_use_direct(dbh->client, YK_CLIENT_OP_LENGTH, mode, extras, payload)) {
         if(count == 1) {
             return yk_length_direct(dbh, YK_MODE_WITH_EXTRA(mode), count, keys[0], ksizes, vsizes, YK_REEMIT_EXTRAS(extras));
         }
@@ -210,14 +218,16 @@ extern "C" yk_return_t yk_length_packed(yk_database_handle_t dbh,
 {
     YK_EXTRACT_EXTRAS(extras, mode, vsizes);
 
-    if(mode & YOKAN_MODE_NO_RDMA)
-        return yk_length_direct(dbh, YK_MODE_WITH_EXTRA(mode), count, keys, ksizes, vsizes, YK_REEMIT_EXTRAS(extras));
-
     if(count == 0)
         return YOKAN_SUCCESS;
     else if(!keys || !ksizes || !vsizes)
         return YOKAN_ERR_INVALID_ARGS;
 
+    size_t payload = count*(sizeof(*ksizes)+sizeof(*vsizes))
+                   + std::accumulate(ksizes, ksizes+count, (size_t)0);
+    if(yk_client_use_direct(dbh->client, YK_CLIENT_OP_LENGTH, mode, extras, payload))
+        return yk_length_direct(dbh, YK_MODE_WITH_EXTRA(mode), count, keys, ksizes, vsizes, YK_REEMIT_EXTRAS(extras));
+
     hg_bulk_t bulk   = HG_BULK_NULL;
     hg_return_t hret = HG_SUCCESS;
     std::array<void*,3> ptrs = { const_cast<size_t*>(ksizes),
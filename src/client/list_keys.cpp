@@ -56,6 +56,9 @@ static yk_return_t yk_list_keys_direct(yk_database_handle_t dbh,
     out.keys.data    = (char*)keys;
     out.keys.size    = keys_buf_size;
 
+    YK_INVALIDATE_CACHE_IF_CONSUMING(dbh, mode);
+    YK_FLUSH_COMBINED_WRITES(dbh);
+
     hret = margo_create(mid, dbh->addr, dbh->client->list_keys_direct_id, &handle);
     CHECK_HRET(hret, margo_create);
     DEFER(margo_destroy(handle));
@@ -126,6 +129,9 @@ extern "C" yk_return_t yk_list_keys_bulk(yk_database_handle_t dbh,
     in.origin        = const_cast<char*>(origin);
     in.bulk          = data;
 
+    YK_INVALIDATE_CACHE_IF_CONSUMING(dbh, mode);
+    YK_FLUSH_COMBINED_WRITES(dbh);
+
     hret = margo_create(mid, dbh->addr, dbh->client->list_keys_id, &handle);
     CHECK_HRET(hret, margo_create);
     DEFER(margo_destroy(handle));
@@ -192,9 +198,9 @@ extern "C" yk_return_t yk_list_keys(yk_database_handle_t dbh,
 
     size_t keys_buf_size = std::accumulate(ksizes, ksizes+count, (size_t)0);
 
-    hret = margo_bulk_create(mid, ptrs.size(), ptrs.data(), sizes.data(),
-                             HG_BULK_READWRITE, &bulk);
-    CHECK_HRET(hret, margo_bulk_create);
+    hret = yk_client_bulk_create(dbh->client, ptrs.size(), ptrs.data(), sizes.data(),
+                                 HG_BULK_READWRITE, &bulk);
+    CHECK_HRET(hret, yk_client_bulk_create);
     DEFER(margo_bulk_free(bulk));
 
     return yk_list_keys_bulk(dbh, YK_MODE_WITH_EXTRA(mode), from_ksize, filter_size,
@@ -215,17 +221,18 @@ extern "C" yk_return_t yk_list_keys_packed(yk_database_handle_t dbh,
 {
     YK_EXTRACT_EXTRAS(extras, mode, ksizes);
 
-    if(mode & YOKAN_MODE_NO_RDMA)
-        return yk_list_keys_direct(dbh, YK_MODE_WITH_EXTRA(mode), from_key,
-                from_ksize, filter, filter_size, count,
-                keys, keys_buf_size, ksizes, YK_REEMIT_EXTRAS(extras));
-
     if(count == 0) return YOKAN_SUCCESS;
     if(from_key == nullptr && from_ksize > 0)
         return YOKAN_ERR_INVALID_ARGS;
     if(filter == nullptr && filter_size > 0)
         return YOKAN_ERR_INVALID_ARGS;
 
+    size_t payload = from_ksize + filter_size + count*sizeof(*ksizes) + keys_buf_size;
+    if(yk_client_use_direct(dbh->client, YK_CLIENT_OP_LIST_KEYS, mode, extras, payload))
+        return yk_list_keys_direct(dbh, YK_MODE_WITH_EXTRA(mode), from_key,
+                from_ksize, filter, filter_size, count,
+                keys, keys_buf_size, ksizes, YK_REEMIT_EXTRAS(extras));
+
     hg_bulk_t bulk   = HG_BULK_NULL;
     hg_return_t hret = HG_SUCCESS;
     std::array<void*,4> ptrs;
@@ -251,10 +258,10 @@ extern "C" yk_return_t yk_list_keys_packed(yk_database_handle_t dbh,
 
     margo_instance_id mid = dbh->client->mid;
 
-    hret = margo_bulk_create(mid, i, ptrs.data(), sizes.data(),
-                             HG_BULK_READWRITE, &bulk);
+    hret = yk_client_bulk_create(dbh->client, i, ptrs.data(), sizes.data(),
+                                 HG_BULK_READWRITE, &bulk);
 
-    CHECK_HRET(hret, margo_bulk_create);
+    CHECK_HRET(hret, yk_client_bulk_create);
     DEFER(margo_bulk_free(bulk));
 
     return yk_list_keys_bulk(dbh, YK_MODE_WITH_EXTRA(mode), from_ksize, filter_size,
@@ -65,6 +65,9 @@ static yk_return_t yk_list_keyvals_direct(yk_database_handle_t dbh,
     out.vals.data    = (char*)values;
     out.vals.size    = vals_buf_size;
 
+    YK_INVALIDATE_CACHE_IF_CONSUMING(dbh, mode);
+    YK_FLUSH_COMBINED_WRITES(dbh);
+
     hret = margo_create(mid, dbh->addr, dbh->client->list_keyvals_direct_id, &handle);
     CHECK_HRET(hret, margo_create);
     DEFER(margo_destroy(handle));
@@ -142,6 +145,9 @@ extern "C" yk_return_t yk_list_keyvals_bulk(yk_database_handle_t dbh,
     in.origin        = const_cast<char*>(origin);
     in.bulk          = data;
 
+    YK_INVALIDATE_CACHE_IF_CONSUMING(dbh, mode);
+    YK_FLUSH_COMBINED_WRITES(dbh);
+
     hret = margo_create(mid, dbh->addr, dbh->client->list_keyvals_id, &handle);
     CHECK_HRET(hret, margo_create);
     DEFER(margo_destroy(handle));
@@ -221,9 +227,9 @@ extern "C" yk_return_t yk_list_keyvals(yk_database_handle_t dbh,
         vals_buf_size += vsizes[i];
     }
 
-    hret = margo_bulk_create(mid, ptrs.size(), ptrs.data(), sizes.data(),
-                             HG_BULK_READWRITE, &bulk);
-    CHECK_HRET(hret, margo_bulk_create);
+    hret = yk_client_bulk_create(dbh->client, ptrs.size(), ptrs.data(), sizes.data(),
+                                 HG_BULK_READWRITE, &bulk);
+    CHECK_HRET(hret, yk_client_bulk_create);
     DEFER(margo_bulk_free(bulk));
 
     return yk_list_keyvals_bulk(dbh, YK_MODE_WITH_EXTRA(mode), from_ksize, filter_size,
@@ -247,12 +253,6 @@ extern "C" yk_return_t yk_list_keyvals_packed(yk_database_handle_t dbh,
 {
     YK_EXTRACT_EXTRAS(extras, mode, vsizes);
 
-    if(mode & YOKAN_MODE_NO_RDMA)
-        return yk_list_keyvals_direct(dbh, YK_MODE_WITH_EXTRA(mode), from_key,
-                from_ksize, filter, filter_size, count,
-                keys, keys_buf_size, ksizes,
-                values, vals_buf_size, vsizes, YK_REEMIT_EXTRAS(extras));
-
     if(count == 0)
         return YOKAN_SUCCESS;
     if(from_key == nullptr && from_ksize > 0)
@@ -260,6 +260,14 @@ extern "C" yk_return_t yk_list_keyvals_packed(yk_database_handle_t dbh,
     if(filter == nullptr && filter_size > 0)
         return YOKAN_ERR_INVALID_ARGS;
 
+    size_t payload = from_ksize + filter_size + count*(sizeof(*ksizes)+sizeof(*vsizes))
+                   + keys_buf_size + vals_buf_size;
+    if(yk_client_use_direct(dbh->client, YK_CLIENT_OP_LIST_KEYVALS, mode, extras, payload))
+        return yk_list_keyvals_direct(dbh, YK_MODE_WITH_EXTRA(mode), from_key,
+                from_ksize, filter, filter_size, count,
+                keys, keys_buf_size, ksizes,
+                values, vals_buf_size, vsizes, YK_REEMIT_EXTRAS(extras));
+
     hg_bulk_t bulk   = HG_BULK_NULL;
     hg_return_t hret = HG_SUCCESS;
     std::array<void*,6> ptrs;
@@ -291,10 +299,10 @@ extern "C" yk_return_t yk_list_keyvals_packed(yk_database_handle_t dbh,
 
     margo_instance_id mid = dbh->client->mid;
 
-    hret = margo_bulk_create(mid, i, ptrs.data(), sizes.data(),
-                             HG_BULK_READWRITE, &bulk);
+    hret = yk_client_bulk_create(dbh->client, i, ptrs.data(), sizes.data(),
+                                 HG_BULK_READWRITE, &bulk);
 
-    CHECK_HRET(hret, margo_bulk_create);
+    CHECK_HRET(hret, yk_client_bulk_create);
     DEFER(margo_bulk_free(bulk));
 
     return yk_list_keyvals_bulk(dbh, YK_MODE_WITH_EXTRA(mode), from_ksize, filter_size,
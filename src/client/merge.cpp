@@ -0,0 +1,78 @@
+/*
+ * (C) 2026 The University of Chicago
+ *
+ * See COPYRIGHT in top-level directory.
+ */
+#include "client.hpp"
+#include "../common/defer.hpp"
+#include "../common/types.h"
+#include "../common/logging.h"
+#include "../common/checks.h"
+#include "../common/extras.h"
+
+extern "C" yk_return_t yk_merge(yk_database_handle_t dbh,
+                                int32_t mode,
+                                const void* key,
+                                size_t ksize,
+                                int32_t op,
+                                const void* operand,
+                                size_t osize,
+                                size_t bound,
+                                void* result,
+                                size_t* rsize, ...)
+{
+    YK_EXTRACT_EXTRAS(extras, mode, rsize);
+
+    if(!key || ksize == 0 || (!operand && osize)
+    || (rsize && *rsize && !result))
+        return YOKAN_ERR_INVALID_ARGS;
+
+    CHECK_MODE_VALID(mode);
+
+    margo_instance_id mid = dbh->client->mid;
+    yk_return_t ret = YOKAN_SUCCESS;
+    hg_return_t hret = HG_SUCCESS;
+    merge_in_t in;
+    merge_out_t out;
+    hg_handle_t handle = HG_HANDLE_NULL;
+
+    in.mode         = mode;
+    in.timeout_ms   = extras.timeout_ms;
+    in.trace_id     = extras.trace_id;
+    in.key.data     = (char*)key;
+    in.key.size     = ksize;
+    in.op           = op;
+    in.operand.data = (char*)operand;
+    in.operand.size = osize;
+    in.bound        = bound;
+    in.rsize        = rsize ? *rsize : 0;
+
+    // the new value is decoded directly into the caller's buffer
+    out.result.data = (char*)result;
+    out.result.size = rsize ? *rsize : 0;
+    out.rsize       = 0;
+
+    YK_INVALIDATE_CACHED_PACKED(dbh, 1, key, &ksize);
+    YK_FLUSH_COMBINED_WRITES(dbh);
+
+    hret = margo_create(mid, dbh->addr, dbh->client->merge_id, &handle);
+    CHECK_HRET(hret, margo_create);
+    DEFER(margo_destroy(handle));
+
+    hret = margo_provider_forward_timed(dbh->provider_id, handle, &in, extras.timeout_ms);
+    CHECK_HRET(hret, margo_provider_forward_timed);
+
+    hret = margo_get_output(handle, &out);
+    CHECK_HRET(hret, margo_get_output);
+
+    ret = static_cast<yk_return_t>(out.ret);
+    if(ret == YOKAN_SUCCESS && rsize)
+        *rsize = out.rsize;
+
+    out.result.data = nullptr;
+    out.result.size = 0;
+    hret = margo_free_output(handle, &out);
+    CHECK_HRET(hret, margo_free_output);
+
+    return ret;
+}
@@ -41,6 +41,7 @@ static yk_return_t yk_put_direct(yk_database_handle_t dbh,
 
     in.mode       = mode;
     in.timeout_ms = extras.timeout_ms;
+    in.trace_id   = extras.trace_id;
     in.ksizes.sizes = (size_t*)ksizes;
     in.ksizes.count = count;
     in.vsizes.sizes = (size_t*)vsizes;
@@ -53,6 +54,8 @@ static yk_return_t yk_put_direct(yk_database_handle_t dbh,
     if(in.vals.data == nullptr && in.vals.size != 0)
         return YOKAN_ERR_INVALID_ARGS;
 
+    YK_FLUSH_COMBINED_WRITES(dbh);
+
     hret = margo_create(mid, dbh->addr, dbh->client->put_direct_id, &handle);
     CHECK_HRET(hret, margo_create);
     DEFER(margo_destroy(handle));
@@ -70,13 +73,13 @@ static yk_return_t yk_put_direct(yk_database_handle_t dbh,
     return ret;
 }
 
-extern "C" yk_return_t yk_put_bulk(yk_database_handle_t dbh,
-                                   int32_t mode,
-                                   size_t count,
-                                   const char* origin,
-                                   hg_bulk_t data,
-                                   size_t offset,
-                                   size_t size, ...)
+static yk_return_t yk_put_bulk_send(yk_database_handle_t dbh,
+                                    int32_t mode,
+                                    size_t count,
+                                    const char* origin,
+                                    hg_bulk_t data,
+                                    size_t offset,
+                                    size_t size, ...)
 {
     YK_EXTRACT_EXTRAS(extras, mode, size);
 
@@ -94,12 +97,15 @@ extern "C" yk_return_t yk_put_bulk(yk_database_handle_t dbh,
 
     in.mode       = mode;
     in.timeout_ms = extras.timeout_ms;
+    in.trace_id   = extras.trace_id;
     in.count  = count;
     in.bulk   = data;
     in.offset = offset;
     in.size   = size;
     in.origin = const_cast<char*>(origin);
 
+    YK_FLUSH_COMBINED_WRITES(dbh);
+
     hret = margo_create(mid, dbh->addr, dbh->client->put_id, &handle);
     CHECK_HRET(hret, margo_create);
     DEFER(margo_destroy(handle));
@@ -117,6 +123,21 @@ extern "C" yk_return_t yk_put_bulk(yk_database_handle_t dbh,
     return ret;
 }
 
+extern "C" yk_return_t yk_put_bulk(yk_database_handle_t dbh,
+                                   int32_t mode,
+                                   size_t count,
+                                   const char* origin,
+                                   hg_bulk_t data,
+                                   size_t offset,
+                                   size_t size, ...)
+{
+    YK_EXTRACT_EXTRAS(extras, mode, size);
+    // the keys are not known to the client, so the whole read cache is invalidated
+    YK_INVALIDATE_CACHE(dbh);
+    return yk_put_bulk_send(dbh, YK_MODE_WITH_EXTRA(mode), count, origin, data, offset, size,
+                            YK_REEMIT_EXTRAS(extras));
+}
+
 extern "C" yk_return_t yk_put(yk_database_handle_t dbh,
                                 int32_t mode,
                                 const void* key,
@@ -127,6 +148,10 @@ extern "C" yk_return_t yk_put(yk_database_handle_t dbh,
     YK_EXTRACT_EXTRAS(extras, mode, vsize);
     if(ksize == 0)
         return YOKAN_ERR_INVALID_ARGS;
+    yk_return_t ret;
+    YK_INVALIDATE_CACHED_PACKED(dbh, 1, key, &ksize);
+    if(yk_write_combiner_put(dbh, mode, extras, key, ksize, value, vsize, &ret))
+        return ret;
     return yk_put_packed(dbh, YK_MODE_WITH_EXTRA(mode), 1, key, &ksize, value, &vsize,
                          YK_REEMIT_EXTRAS(extras));
 }
@@ -146,7 +171,12 @@ extern "C" yk_return_t yk_put_multi(yk_database_handle_t dbh,
     else if(!keys || !ksizes || !values || !vsizes)
         return YOKAN_ERR_INVALID_ARGS;
 
-    if(mode & YOKAN_MODE_NO_RDMA) {
+    YK_INVALIDATE_CACHED_MULTI(dbh, count, keys, ksizes);
+
+    size_t payload = count*(sizeof(*ksizes)+sizeof(*vsizes))
+                   + std::accumulate(ksizes, ksizes+count, (size_t)0)
+                   + std::accumulate(vsizes, vsizes+count, (size_t)0);
+    if(yk_client_use_direct(dbh->client, YK_CLIENT_OP_PUT, mode, extras, payload)) {
         if(count == 1) {
             return yk_put_direct(dbh, YK_MODE_WITH_EXTRA(mode), count, keys[0], ksizes,
                                  values[0], vsizes, YK_REEMIT_EXTRAS(extras));
@@ -202,13 +232,13 @@ extern "C" yk_return_t yk_put_multi(yk_database_handle_t dbh,
 
     size_t total_size = std::accumulate(sizes.begin(), sizes.end(), (size_t)0);
 
-    hret = margo_bulk_create(mid, ptrs.size(), ptrs.data(), sizes.data(),
-                             HG_BULK_READ_ONLY, &bulk);
-    CHECK_HRET(hret, margo_bulk_create);
+    hret = yk_client_bulk_create(dbh->client, ptrs.size(), ptrs.data(), sizes.data(),
+                                 HG_BULK_READ_ONLY, &bulk);
+    CHECK_HRET(hret, yk_client_bulk_create);
     DEFER(margo_bulk_free(bulk));
 
-    return yk_put_bulk(dbh, YK_MODE_WITH_EXTRA(mode), count, nullptr, bulk, 0, total_size,
-                       YK_REEMIT_EXTRAS(extras));
+    return yk_put_bulk_send(dbh, YK_MODE_WITH_EXTRA(mode), count, nullptr, bulk, 0, total_size,
+                            YK_REEMIT_EXTRAS(extras));
 }
 
 extern "C" yk_return_t yk_put_packed(yk_database_handle_t dbh,
@@ -221,16 +251,21 @@ extern "C" yk_return_t yk_put_packed(yk_database_handle_t dbh,
 {
     YK_EXTRACT_EXTRAS(extras, mode, vsizes);
 
-    if(mode & YOKAN_MODE_NO_RDMA) {
-        return yk_put_direct(dbh, YK_MODE_WITH_EXTRA(mode), count, keys, ksizes,
-                             values, vsizes, YK_REEMIT_EXTRAS(extras));
-    }
-
     if(count == 0)
         return YOKAN_SUCCESS;
     else if(!keys || !ksizes || !vsizes)
         return YOKAN_ERR_INVALID_ARGS;
 
+    YK_INVALIDATE_CACHED_PACKED(dbh, count, keys, ksizes);
+
+    size_t payload = count*(sizeof(*ksizes)+sizeof(*vsizes))
+                   + std::accumulate(ksizes, ksizes+count, (size_t)0)
+                   + std::accumulate(vsizes, vsizes+count, (size_t)0);
+    if(yk_client_use_direct(dbh->client, YK_CLIENT_OP_PUT, mode, extras, payload)) {
+        return yk_put_direct(dbh, YK_MODE_WITH_EXTRA(mode), count, keys, ksizes,
+                             values, vsizes, YK_REEMIT_EXTRAS(extras));
+    }
+
     hg_bulk_t bulk   = HG_BULK_NULL;
     hg_return_t hret = HG_SUCCESS;
     std::array<void*,4> ptrs = { const_cast<size_t*>(ksizes),
@@ -252,15 +287,15 @@ extern "C" yk_return_t yk_put_packed(yk_database_handle_t dbh,
         return YOKAN_ERR_INVALID_ARGS;
 
     if(sizes[3] != 0)
-        hret = margo_bulk_create(mid, 4, ptrs.data(), sizes.data(),
-                                 HG_BULK_READ_ONLY, &bulk);
+        hret = yk_client_bulk_create(dbh->client, 4, ptrs.data(), sizes.data(),
+                                     HG_BULK_READ_ONLY, &bulk);
     else
-        hret = margo_bulk_create(mid, 3, ptrs.data(), sizes.data(),
-                                 HG_BULK_READ_ONLY, &bulk);
+        hret = yk_client_bulk_create(dbh->client, 3, ptrs.data(), sizes.data(),
+                                     HG_BULK_READ_ONLY, &bulk);
 
-    CHECK_HRET(hret, margo_bulk_create);
+    CHECK_HRET(hret, yk_client_bulk_create);
     DEFER(margo_bulk_free(bulk));
 
-    return yk_put_bulk(dbh, YK_MODE_WITH_EXTRA(mode), count, nullptr, bulk, 0, total_size,
-                       YK_REEMIT_EXTRAS(extras));
+    return yk_put_bulk_send(dbh, YK_MODE_WITH_EXTRA(mode), count, nullptr, bulk, 0, total_size,
+                            YK_REEMIT_EXTRAS(extras));
 }
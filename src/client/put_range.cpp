@@ -0,0 +1,82 @@
+/*
+ * (C) 2026 The University of Chicago
+ *
+ * See COPYRIGHT in top-level directory.
+ */
+#include "client.hpp"
+#include "../common/defer.hpp"
+#include "../common/types.h"
+#include "../common/logging.h"
+#include "../common/checks.h"
+#include "../common/extras.h"
+
+/**
+ * The range is sent along with the RPC if it fits within the direct
+ * threshold, otherwise the provider pulls it from a bulk handle exposing
+ * the caller's buffer.
+ */
+extern "C" yk_return_t yk_put_range(yk_database_handle_t dbh,
+                                    int32_t mode,
+                                    const void* key,
+                                    size_t ksize,
+                                    size_t offset,
+                                    const void* data,
+                                    size_t size, ...)
+{
+    YK_EXTRACT_EXTRAS(extras, mode, size);
+
+    if(!key || ksize == 0 || (!data && size))
+        return YOKAN_ERR_INVALID_ARGS;
+
+    CHECK_MODE_VALID(mode);
+
+    margo_instance_id mid = dbh->client->mid;
+    yk_return_t ret = YOKAN_SUCCESS;
+    hg_return_t hret = HG_SUCCESS;
+    put_range_in_t in;
+    put_range_out_t out;
+    hg_handle_t handle = HG_HANDLE_NULL;
+    hg_bulk_t bulk = HG_BULK_NULL;
+
+    bool direct = size == 0
+        || yk_client_use_direct(dbh->client, YK_CLIENT_OP_PUT, mode, extras, ksize + size);
+    if(!direct) {
+        void* ptr = const_cast<void*>(data);
+        hg_size_t bsize = size;
+        hret = yk_client_bulk_create(dbh->client, 1, &ptr, &bsize,
+                                     HG_BULK_READ_ONLY, &bulk);
+        CHECK_HRET(hret, yk_client_bulk_create);
+    }
+    DEFER(if(bulk != HG_BULK_NULL) margo_bulk_free(bulk));
+
+    in.mode       = mode;
+    in.timeout_ms = extras.timeout_ms;
+    in.trace_id   = extras.trace_id;
+    in.key.data   = (char*)key;
+    in.key.size   = ksize;
+    in.offset     = offset;
+    in.size       = size;
+    in.data.data  = direct ? (char*)data : nullptr;
+    in.data.size  = direct ? size : 0;
+    in.origin     = nullptr;
+    in.bulk       = bulk;
+
+    YK_INVALIDATE_CACHED_PACKED(dbh, 1, key, &ksize);
+    YK_FLUSH_COMBINED_WRITES(dbh);
+
+    hret = margo_create(mid, dbh->addr, dbh->client->put_range_id, &handle);
+    CHECK_HRET(hret, margo_create);
+    DEFER(margo_destroy(handle));
+
+    hret = margo_provider_forward_timed(dbh->provider_id, handle, &in, extras.timeout_ms);
+    CHECK_HRET(hret, margo_provider_forward_timed);
+
+    hret = margo_get_output(handle, &out);
+    CHECK_HRET(hret, margo_get_output);
+
+    ret = static_cast<yk_return_t>(out.ret);
+    hret = margo_free_output(handle, &out);
+    CHECK_HRET(hret, margo_free_output);
+
+    return ret;
+}
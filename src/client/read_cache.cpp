@@ -0,0 +1,275 @@
+/*
+ * (C) 2026 The University of Chicago
+ *
+ * See COPYRIGHT in top-level directory.
+ */
+#include <cstring>
+#include <string>
+#include <list>
+#include <map>
+#include <limits>
+#include "client.hpp"
+
+static const yk_read_cache_options_t default_options = {
+    16*1024*1024, /* capacity */
+    1000.0        /* ttl_ms */
+};
+
+/**
+ * The read cache of a database handle keeps the values read by yk_get in
+ * an LRU list indexed by key. The index is ordered so that yk_erase_range
+ * can invalidate the keys starting with a prefix. Each invalidation
+ * increments the generation, and a value read from the provider is only
+ * inserted if the generation did not change since the lookup that missed,
+ * since a write racing with the read may have been applied after the
+ * provider read the value.
+ */
+struct yk_read_cache {
+
+    struct entry {
+        std::string key;
+        std::string value;
+        double      expiration; /* in seconds, as returned by ABT_get_wtime */
+    };
+
+    yk_read_cache_options_t                             options;
+    ABT_mutex                                           mutex;
+    std::list<entry>                                    lru;
+    std::map<std::string, std::list<entry>::iterator>   index;
+    size_t                                              size = 0;
+    uint64_t                                            generation = 0;
+    size_t                                              hits = 0;
+    size_t                                              misses = 0;
+
+    void erase(std::map<std::string, std::list<entry>::iterator>::iterator it) {
+        size -= it->second->key.size() + it->second->value.size();
+        lru.erase(it->second);
+        index.erase(it);
+    }
+
+    void evict() {
+        while(size > options.capacity && !lru.empty())
+            erase(index.find(lru.back().key));
+    }
+};
+
+static bool yk_read_cache_accepts(int32_t mode)
+{
+    return (mode & ~(YOKAN_MODE_NO_RDMA|YOKAN_MODE_EXTRA)) == YOKAN_MODE_DEFAULT;
+}
+
+bool yk_read_cache_lookup(yk_database_handle_t dbh,
+                          int32_t mode,
+                          const void* key,
+                          size_t ksize,
+                          void* value,
+                          size_t* vsize,
+                          yk_return_t* ret,
+                          uint64_t* generation)
+{
+    auto rc = dbh->read_cache;
+    *generation = UINT64_MAX;
+    if(!rc || !key || !vsize || !yk_read_cache_accepts(mode)) return false;
+
+    std::string k{static_cast<const char*>(key), ksize};
+    double now = ABT_get_wtime();
+
+    ABT_mutex_lock(rc->mutex);
+    auto it = rc->index.find(k);
+    if(it != rc->index.end() && it->second->expiration < now) {
+        rc->erase(it);
+        it = rc->index.end();
+    }
+    if(it == rc->index.end()) {
+        rc->misses += 1;
+        *generation = rc->generation;
+        ABT_mutex_unlock(rc->mutex);
+        return false;
+    }
+    rc->hits += 1;
+    rc->lru.splice(rc->lru.begin(), rc->lru, it->second);
+    auto& cached = it->second->value;
+    if(*vsize < cached.size() || (!value && !cached.empty())) {
+        *vsize = YOKAN_SIZE_TOO_SMALL;
+        *ret   = YOKAN_ERR_BUFFER_SIZE;
+    } else {
+        if(!cached.empty()) std::memcpy(value, cached.data(), cached.size());
+        *vsize = cached.size();
+        *ret   = YOKAN_SUCCESS;
+    }
+    ABT_mutex_unlock(rc->mutex);
+    return true;
+}
+
+void yk_read_cache_insert(yk_database_handle_t dbh,
+                          uint64_t generation,
+                          const void* key,
+                          size_t ksize,
+                          const void* value,
+                          size_t vsize)
+{
+    auto rc = dbh->read_cache;
+    if(!rc || generation == UINT64_MAX) return;
+    if(ksize + vsize > rc->options.capacity) return;
+
+    yk_read_cache::entry e;
+    e.key.assign(static_cast<const char*>(key), ksize);
+    if(vsize) e.value.assign(static_cast<const char*>(value), vsize);
+    e.expiration = rc->options.ttl_ms > 0.0
+                 ? ABT_get_wtime() + rc->options.ttl_ms/1000.0
+                 : std::numeric_limits<double>::infinity();
+
+    ABT_mutex_lock(rc->mutex);
+    if(generation == rc->generation) {
+        auto it = rc->index.find(e.key);
+        if(it != rc->index.end()) rc->erase(it);
+        rc->size += ksize + vsize;
+        rc->lru.push_front(std::move(e));
+        rc->index.emplace(rc->lru.front().key, rc->lru.begin());
+        rc->evict();
+    }
+    ABT_mutex_unlock(rc->mutex);
+}
+
+void yk_read_cache_invalidate_packed(yk_database_handle_t dbh,
+                                     size_t count,
+                                     const void* keys,
+                                     const size_t* ksizes)
+{
+    auto rc = dbh->read_cache;
+    if(!rc) return;
+    if(!keys || !ksizes) {
+        yk_read_cache_clear(dbh);
+        return;
+    }
+    auto ptr = static_cast<const char*>(keys);
+    ABT_mutex_lock(rc->mutex);
+    rc->generation += 1;
+    for(size_t i = 0; i < count && !rc->index.empty(); ++i) {
+        auto it = rc->index.find(std::string{ptr, ksizes[i]});
+        if(it != rc->index.end()) rc->erase(it);
+        ptr += ksizes[i];
+    }
+    ABT_mutex_unlock(rc->mutex);
+}
+
+void yk_read_cache_invalidate_multi(yk_database_handle_t dbh,
+                                    size_t count,
+                                    const void* const* keys,
+                                    const size_t* ksizes)
+{
+    auto rc = dbh->read_cache;
+    if(!rc) return;
+    if(!keys || !ksizes) {
+        yk_read_cache_clear(dbh);
+        return;
+    }
+    ABT_mutex_lock(rc->mutex);
+    rc->generation += 1;
+    for(size_t i = 0; i < count && !rc->index.empty(); ++i) {
+        if(!keys[i]) continue;
+        auto it = rc->index.find(
+            std::string{static_cast<const char*>(keys[i]), ksizes[i]});
+        if(it != rc->index.end()) rc->erase(it);
+    }
+    ABT_mutex_unlock(rc->mutex);
+}
+
+void yk_read_cache_invalidate_prefix(yk_database_handle_t dbh,
+                                     const void* prefix,
+                                     size_t prefix_size)
+{
+    auto rc = dbh->read_cache;
+    if(!rc) return;
+    std::string p;
+    if(prefix_size) p.assign(static_cast<const char*>(prefix), prefix_size);
+    ABT_mutex_lock(rc->mutex);
+    rc->generation += 1;
+    auto it = rc->index.lower_bound(p);
+    while(it != rc->index.end() && it->first.compare(0, p.size(), p) == 0)
+        rc->erase(it++);
+    ABT_mutex_unlock(rc->mutex);
+}
+
+void yk_read_cache_clear(yk_database_handle_t dbh)
+{
+    auto rc = dbh->read_cache;
+    if(!rc) return;
+    ABT_mutex_lock(rc->mutex);
+    rc->generation += 1;
+    rc->lru.clear();
+    rc->index.clear();
+    rc->size = 0;
+    ABT_mutex_unlock(rc->mutex);
+}
+
+extern "C" yk_return_t yk_database_handle_enable_read_cache(
+        yk_database_handle_t dbh,
+        const yk_read_cache_options_t* options)
+{
+    if(dbh == YOKAN_DATABASE_HANDLE_NULL)
+        return YOKAN_ERR_INVALID_ARGS;
+    if(options && options->ttl_ms < 0.0)
+        return YOKAN_ERR_INVALID_ARGS;
+
+    if(dbh->read_cache) {
+        // only update the options, and evict entries that no longer fit
+        auto rc = dbh->read_cache;
+        ABT_mutex_lock(rc->mutex);
+        rc->options = options ? *options : default_options;
+        rc->evict();
+        ABT_mutex_unlock(rc->mutex);
+        return YOKAN_SUCCESS;
+    }
+
+    auto rc = new yk_read_cache;
+    rc->options = options ? *options : default_options;
+    ABT_mutex_create(&rc->mutex);
+    dbh->read_cache = rc;
+    return YOKAN_SUCCESS;
+}
+
+extern "C" yk_return_t yk_database_handle_disable_read_cache(
+        yk_database_handle_t dbh)
+{
+    if(dbh == YOKAN_DATABASE_HANDLE_NULL)
+        return YOKAN_ERR_INVALID_ARGS;
+    auto rc = dbh->read_cache;
+    if(!rc) return YOKAN_SUCCESS;
+    dbh->read_cache = nullptr;
+    ABT_mutex_free(&rc->mutex);
+    delete rc;
+    return YOKAN_SUCCESS;
+}
+
+extern "C" yk_return_t yk_database_handle_invalidate_cache(
+        yk_database_handle_t dbh,
+        const void* key,
+        size_t ksize)
+{
+    if(dbh == YOKAN_DATABASE_HANDLE_NULL)
+        return YOKAN_ERR_INVALID_ARGS;
+    if(key) yk_read_cache_invalidate_packed(dbh, 1, key, &ksize);
+    else yk_read_cache_clear(dbh);
+    return YOKAN_SUCCESS;
+}
+
+extern "C" yk_return_t yk_database_handle_read_cache_stats(
+        yk_database_handle_t dbh,
+        size_t* hits,
+        size_t* misses)
+{
+    if(dbh == YOKAN_DATABASE_HANDLE_NULL)
+        return YOKAN_ERR_INVALID_ARGS;
+    auto rc = dbh->read_cache;
+    size_t h = 0, m = 0;
+    if(rc) {
+        ABT_mutex_lock(rc->mutex);
+        h = rc->hits;
+        m = rc->misses;
+        ABT_mutex_unlock(rc->mutex);
+    }
+    if(hits) *hits = h;
+    if(misses) *misses = m;
+    return YOKAN_SUCCESS;
+}
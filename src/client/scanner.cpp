@@ -0,0 +1,290 @@
+/*
+ * (C) 2026 The University of Chicago
+ *
+ * See COPYRIGHT in top-level directory.
+ */
+#include <string>
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include "client.hpp"
+
+/**
+ * A page holds the result of one yk_list_keyvals_packed call,
+ * truncated to the items that fit in its buffers, and the position
+ * of the application within it.
+ */
+struct yk_scan_page {
+    std::vector<char>   keys;
+    std::vector<char>   vals;
+    std::vector<size_t> ksizes;
+    std::vector<size_t> vsizes;
+    size_t              count = 0;
+    size_t              next = 0;
+    size_t              key_offset = 0;
+    size_t              val_offset = 0;
+};
+
+/**
+ * The prefetching ULT (producer) pushes pages into the ready queue as
+ * long as it holds fewer than depth pages, and the application
+ * (consumer) pops them from yk_scanner_next.
+ */
+struct yk_scanner {
+    yk_database_handle_t     dbh;
+    int32_t                  mode;
+    yk_extra_opts_t          extras;
+    std::string              filter;
+    std::string              from_key;
+    yk_scan_options_t        options;
+
+    // page sizes, only accessed by the producer
+    size_t                   batch_size;
+    size_t                   keys_buf_size;
+    size_t                   vals_buf_size;
+    double                   best_throughput = 0.0;
+
+    ABT_mutex                mutex = ABT_MUTEX_NULL;
+    ABT_cond                 cond  = ABT_COND_NULL;
+    std::deque<yk_scan_page> ready;
+    bool                     done = false;
+    bool                     stop = false;
+    yk_return_t              error = YOKAN_SUCCESS;
+    ABT_thread               ult = ABT_THREAD_NULL;
+
+    yk_scan_page             current;
+};
+
+/**
+ * @brief Fetches the page following from_key. If the first item does not
+ * fit in the buffers, they are grown until it does, regardless of
+ * max_buffer_size. Sets eof if the provider has no more items.
+ */
+static yk_return_t yk_scanner_fetch(yk_scanner* s, yk_scan_page& p, bool& eof)
+{
+    const bool ignore_values = s->options.ignore_values;
+    while(true) {
+        p.keys.resize(s->keys_buf_size);
+        p.ksizes.assign(s->batch_size, 0);
+        if(!ignore_values) {
+            p.vals.resize(s->vals_buf_size);
+            p.vsizes.assign(s->batch_size, 0);
+        }
+
+        double t_start = ABT_get_wtime();
+        yk_return_t ret;
+        if(ignore_values) {
+            ret = yk_list_keys_packed(s->dbh, YK_MODE_WITH_EXTRA(s->mode),
+                s->from_key.data(), s->from_key.size(),
+                s->filter.data(), s->filter.size(), s->batch_size,
+                p.keys.data(), p.keys.size(), p.ksizes.data(),
+                YK_REEMIT_EXTRAS(s->extras));
+        } else {
+            ret = yk_list_keyvals_packed(s->dbh, YK_MODE_WITH_EXTRA(s->mode),
+                s->from_key.data(), s->from_key.size(),
+                s->filter.data(), s->filter.size(), s->batch_size,
+                p.keys.data(), p.keys.size(), p.ksizes.data(),
+                p.vals.data(), p.vals.size(), p.vsizes.data(),
+                YK_REEMIT_EXTRAS(s->extras));
+        }
+        if(ret != YOKAN_SUCCESS) return ret;
+        double elapsed = ABT_get_wtime() - t_start;
+
+        bool keys_full = false, vals_full = false;
+        size_t bytes = 0;
+        p.count = 0;
+        eof = false;
+        for(; p.count < s->batch_size; ++p.count) {
+            size_t ksize = p.ksizes[p.count];
+            size_t vsize = ignore_values ? 0 : p.vsizes[p.count];
+            if(ksize == YOKAN_NO_MORE_KEYS) {
+                eof = true;
+                break;
+            }
+            keys_full = ksize == YOKAN_SIZE_TOO_SMALL;
+            vals_full = vsize == YOKAN_SIZE_TOO_SMALL;
+            if(keys_full || vals_full) break;
+            bytes += ksize + vsize;
+        }
+
+        if(p.count == 0 && (keys_full || vals_full)) {
+            if(keys_full) s->keys_buf_size *= 2;
+            if(vals_full) s->vals_buf_size *= 2;
+            continue;
+        }
+
+        // grow the pages as long as it increases the throughput
+        // (i.e. the fetch is latency-bound rather than bandwidth-bound)
+        bool constrained = keys_full || vals_full || p.count == s->batch_size;
+        double throughput = elapsed > 0.0 ? bytes / elapsed : 0.0;
+        if(constrained && !eof && throughput > 1.1 * s->best_throughput) {
+            s->best_throughput = throughput;
+            size_t max_size = s->options.max_buffer_size;
+            if(s->keys_buf_size + s->vals_buf_size <= max_size / 2) {
+                s->batch_size    *= 2;
+                s->keys_buf_size *= 2;
+                s->vals_buf_size *= 2;
+            }
+        }
+
+        if(p.count != 0) {
+            size_t last_koffset = 0;
+            for(size_t i = 0; i + 1 < p.count; ++i) last_koffset += p.ksizes[i];
+            s->from_key.assign(p.keys.data() + last_koffset, p.ksizes[p.count-1]);
+            s->mode &= ~YOKAN_MODE_INCLUSIVE;
+        }
+        if(p.count < s->batch_size && !keys_full && !vals_full)
+            eof = true;
+        return YOKAN_SUCCESS;
+    }
+}
+
+static void yk_scanner_run(void* arg)
+{
+    auto s = static_cast<yk_scanner*>(arg);
+    while(true) {
+        ABT_mutex_lock(s->mutex);
+        while(!s->stop && s->ready.size() >= s->options.depth)
+            ABT_cond_wait(s->cond, s->mutex);
+        bool stop = s->stop;
+        ABT_mutex_unlock(s->mutex);
+        if(stop) break;
+
+        yk_scan_page page;
+        bool eof = false;
+        yk_return_t ret = yk_scanner_fetch(s, page, eof);
+
+        ABT_mutex_lock(s->mutex);
+        if(ret != YOKAN_SUCCESS) s->error = ret;
+        else if(page.count != 0) s->ready.push_back(std::move(page));
+        s->done = ret != YOKAN_SUCCESS || eof;
+        ABT_cond_broadcast(s->cond);
+        bool done = s->done;
+        ABT_mutex_unlock(s->mutex);
+        if(done) break;
+    }
+}
+
+extern "C" yk_return_t yk_scanner_create(yk_database_handle_t dbh,
+                                         int32_t mode,
+                                         const void* from_key,
+                                         size_t from_ksize,
+                                         const void* filter,
+                                         size_t filter_size,
+                                         const yk_scan_options_t* options,
+                                         yk_scanner_t* scanner, ...)
+{
+    YK_EXTRACT_EXTRAS(extras, mode, scanner);
+
+    if(dbh == YOKAN_DATABASE_HANDLE_NULL || !scanner)
+        return YOKAN_ERR_INVALID_ARGS;
+    if(from_key == nullptr && from_ksize > 0)
+        return YOKAN_ERR_INVALID_ARGS;
+    if(filter == nullptr && filter_size > 0)
+        return YOKAN_ERR_INVALID_ARGS;
+    if(mode & (YOKAN_MODE_NO_PREFIX|YOKAN_MODE_IGNORE_KEYS))
+        return YOKAN_ERR_MODE;
+
+    auto s = new yk_scanner;
+    s->dbh    = dbh;
+    s->mode   = mode & ~YOKAN_MODE_EXTRA;
+    s->extras = extras;
+    if(from_ksize) s->from_key.assign(static_cast<const char*>(from_key), from_ksize);
+    if(filter_size) s->filter.assign(static_cast<const char*>(filter), filter_size);
+    s->options = options ? *options : yk_scan_options_t YOKAN_SCAN_OPTIONS_INIT;
+    if(s->options.batch_size == 0)      s->options.batch_size = 64;
+    if(s->options.buffer_size == 0)     s->options.buffer_size = 64*1024;
+    if(s->options.max_buffer_size == 0) s->options.max_buffer_size = 16*1024*1024;
+    if(s->options.depth == 0)           s->options.depth = 2;
+    s->batch_size = s->options.batch_size;
+    if(s->options.ignore_values) {
+        s->keys_buf_size = std::max<size_t>(s->options.buffer_size, 1);
+        s->vals_buf_size = 0;
+    } else {
+        s->keys_buf_size = std::max<size_t>(s->options.buffer_size / 2, 1);
+        s->vals_buf_size = std::max<size_t>(s->options.buffer_size / 2, 1);
+    }
+
+    ABT_pool pool = s->options.pool;
+    if(pool == ABT_POOL_NULL)
+        margo_get_handler_pool(dbh->client->mid, &pool);
+
+    ABT_mutex_create(&s->mutex);
+    ABT_cond_create(&s->cond);
+    yk_database_handle_ref_incr(dbh);
+
+    int aret = ABT_thread_create(pool, yk_scanner_run, s, ABT_THREAD_ATTR_NULL, &s->ult);
+    if(aret != ABT_SUCCESS) {
+        s->ult = ABT_THREAD_NULL;
+        yk_scanner_destroy(s);
+        return YOKAN_ERR_FROM_ARGOBOTS;
+    }
+    *scanner = s;
+    return YOKAN_SUCCESS;
+}
+
+extern "C" yk_return_t yk_scanner_next(yk_scanner_t s,
+                                       const void** key,
+                                       size_t* ksize,
+                                       const void** value,
+                                       size_t* vsize)
+{
+    if(s == YOKAN_SCANNER_NULL || !key || !ksize)
+        return YOKAN_ERR_INVALID_ARGS;
+
+    auto& p = s->current;
+    if(p.next != 0 && p.next < p.count) {
+        p.key_offset += p.ksizes[p.next-1];
+        if(!s->options.ignore_values) p.val_offset += p.vsizes[p.next-1];
+    }
+    if(p.next >= p.count) {
+        ABT_mutex_lock(s->mutex);
+        while(s->ready.empty() && !s->done)
+            ABT_cond_wait(s->cond, s->mutex);
+        if(s->ready.empty()) {
+            yk_return_t ret = s->error;
+            ABT_mutex_unlock(s->mutex);
+            p = yk_scan_page{};
+            *key   = nullptr;
+            *ksize = YOKAN_NO_MORE_KEYS;
+            if(value) *value = nullptr;
+            if(vsize) *vsize = 0;
+            return ret;
+        }
+        p = std::move(s->ready.front());
+        s->ready.pop_front();
+        ABT_cond_broadcast(s->cond);
+        ABT_mutex_unlock(s->mutex);
+    }
+
+    *key   = p.keys.data() + p.key_offset;
+    *ksize = p.ksizes[p.next];
+    if(s->options.ignore_values) {
+        if(value) *value = nullptr;
+        if(vsize) *vsize = 0;
+    } else {
+        if(value) *value = p.vals.data() + p.val_offset;
+        if(vsize) *vsize = p.vsizes[p.next];
+    }
+    p.next += 1;
+    return YOKAN_SUCCESS;
+}
+
+extern "C" yk_return_t yk_scanner_destroy(yk_scanner_t s)
+{
+    if(s == YOKAN_SCANNER_NULL)
+        return YOKAN_ERR_INVALID_ARGS;
+    if(s->ult != ABT_THREAD_NULL) {
+        ABT_mutex_lock(s->mutex);
+        s->stop = true;
+        ABT_cond_broadcast(s->cond);
+        ABT_mutex_unlock(s->mutex);
+        ABT_thread_join(s->ult);
+        ABT_thread_free(&s->ult);
+    }
+    ABT_cond_free(&s->cond);
+    ABT_mutex_free(&s->mutex);
+    yk_database_handle_release(s->dbh);
+    delete s;
+    return YOKAN_SUCCESS;
+}
@@ -0,0 +1,337 @@
+/*
+ * (C) 2026 The University of Chicago
+ *
+ * See COPYRIGHT in top-level directory.
+ */
+#include <margo-timer.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include "client.hpp"
+#include "../common/logging.h"
+#include "../common/extras.h"
+
+static const yk_write_combining_options_t default_options = {
+    1024,        /* max_count */
+    1024*1024,   /* max_size */
+    10.0         /* max_delay_ms */
+};
+
+/**
+ * The write combiner of a database handle holds the puts and erases
+ * issued with yk_put and yk_erase until one of the thresholds is reached.
+ * A key is either in the pending puts or in the pending erases: a put
+ * following a pending erase of the same key (or an erase following a
+ * pending put) replaces it, since only the last operation on a key
+ * determines its final state. Both batches can therefore be flushed in
+ * any order without changing the outcome.
+ *
+ * All the pending writes share the NO_RDMA bit of the mode they were
+ * issued with, and are flushed with it. A write issued with a different
+ * NO_RDMA bit first flushes the pending writes.
+ *
+ * The mutex is recursive and is held during the whole flush, so that
+ * operations that flush the pending writes before sending their own RPC
+ * (including the put_packed and erase_packed issued by the flush itself)
+ * observe the writes in the order they were issued.
+ */
+struct yk_write_combiner {
+    yk_write_combining_options_t            options;
+    ABT_mutex                               mutex;
+    std::vector<std::string>                put_keys;
+    std::vector<std::string>                put_vals;
+    std::unordered_map<std::string, size_t> put_index;
+    std::vector<std::string>                erase_keys;
+    std::unordered_set<std::string>         erase_index;
+    size_t                                  pending_size = 0;
+    int32_t                                 mode = YOKAN_MODE_DEFAULT;
+    margo_timer_t                           timer = MARGO_TIMER_NULL;
+    bool                                    timer_started = false;
+    yk_return_t                             deferred_error = YOKAN_SUCCESS;
+};
+
+/* Must be called with the combiner's mutex locked. */
+static yk_return_t yk_write_combiner_flush_locked(yk_database_handle_t dbh,
+                                                  yk_write_combiner* wc)
+{
+    if(wc->put_keys.empty() && wc->erase_keys.empty())
+        return YOKAN_SUCCESS;
+
+    std::vector<std::string> put_keys, put_vals, erase_keys;
+    put_keys.swap(wc->put_keys);
+    put_vals.swap(wc->put_vals);
+    erase_keys.swap(wc->erase_keys);
+    wc->put_index.clear();
+    wc->erase_index.clear();
+    wc->pending_size = 0;
+
+    yk_return_t ret = YOKAN_SUCCESS;
+
+    if(!put_keys.empty()) {
+        std::vector<size_t> ksizes, vsizes;
+        std::string keys, vals;
+        ksizes.reserve(put_keys.size());
+        vsizes.reserve(put_keys.size());
+        for(size_t i = 0; i < put_keys.size(); ++i) {
+            ksizes.push_back(put_keys[i].size());
+            vsizes.push_back(put_vals[i].size());
+            keys += put_keys[i];
+            vals += put_vals[i];
+        }
+        ret = yk_put_packed(dbh, wc->mode, put_keys.size(),
+                            keys.data(), ksizes.data(),
+                            vals.data(), vsizes.data());
+    }
+
+    if(!erase_keys.empty()) {
+        std::vector<size_t> ksizes;
+        std::string keys;
+        ksizes.reserve(erase_keys.size());
+        for(auto& key : erase_keys) {
+            ksizes.push_back(key.size());
+            keys += key;
+        }
+        auto erase_ret = yk_erase_packed(dbh, wc->mode, erase_keys.size(),
+                                         keys.data(), ksizes.data());
+        if(ret == YOKAN_SUCCESS) ret = erase_ret;
+    }
+
+    return ret;
+}
+
+static void yk_write_combiner_timer_cb(void* args)
+{
+    auto dbh = static_cast<yk_database_handle_t>(args);
+    auto wc  = dbh->combiner;
+    if(!wc) return;
+    ABT_mutex_lock(wc->mutex);
+    wc->timer_started = false;
+    auto ret = yk_write_combiner_flush_locked(dbh, wc);
+    if(ret != YOKAN_SUCCESS) {
+        YOKAN_LOG_ERROR(dbh->client->mid,
+            "flushing combined writes failed with error %d", ret);
+        if(wc->deferred_error == YOKAN_SUCCESS)
+            wc->deferred_error = ret;
+    }
+    ABT_mutex_unlock(wc->mutex);
+}
+
+/* Must be called with the combiner's mutex locked, after adding an entry
+ * or changing the options. */
+static yk_return_t yk_write_combiner_added(yk_database_handle_t dbh,
+                                           yk_write_combiner* wc)
+{
+    auto& opt = wc->options;
+    size_t pending_count = wc->put_keys.size() + wc->erase_keys.size();
+    if(pending_count == 0) return YOKAN_SUCCESS;
+    if((opt.max_count != 0 && pending_count >= opt.max_count)
+    || (opt.max_size  != 0 && wc->pending_size >= opt.max_size))
+        return yk_write_combiner_flush_locked(dbh, wc);
+    if(opt.max_delay_ms > 0.0 && !wc->timer_started) {
+        wc->timer_started = true;
+        margo_timer_start(wc->timer, opt.max_delay_ms);
+    }
+    return YOKAN_SUCCESS;
+}
+
+/* Must be called with the combiner's mutex locked, before adding an entry
+ * issued with the given mode. */
+static yk_return_t yk_write_combiner_set_mode(yk_database_handle_t dbh,
+                                              yk_write_combiner* wc,
+                                              int32_t mode)
+{
+    mode &= YOKAN_MODE_NO_RDMA;
+    if(mode == wc->mode) return YOKAN_SUCCESS;
+    auto ret = yk_write_combiner_flush_locked(dbh, wc);
+    wc->mode = mode;
+    return ret;
+}
+
+static bool yk_write_combiner_accepts(int32_t mode, const yk_extra_opts_t& extras)
+{
+    // operations that have their own semantics (or a timeout) are not delayed
+    return (mode & ~(YOKAN_MODE_NO_RDMA|YOKAN_MODE_EXTRA)) == YOKAN_MODE_DEFAULT
+        && extras.timeout_ms == 0.0;
+}
+
+bool yk_write_combiner_put(yk_database_handle_t dbh,
+                           int32_t mode,
+                           const yk_extra_opts_t& extras,
+                           const void* key,
+                           size_t ksize,
+                           const void* value,
+                           size_t vsize,
+                           yk_return_t* ret)
+{
+    auto wc = dbh->combiner;
+    if(!wc || !yk_write_combiner_accepts(mode, extras)) return false;
+    if(!key || (vsize && !value)) {
+        *ret = YOKAN_ERR_INVALID_ARGS;
+        return true;
+    }
+
+    std::string k{static_cast<const char*>(key), ksize};
+    std::string v{static_cast<const char*>(value), vsize};
+
+    ABT_mutex_lock(wc->mutex);
+    *ret = wc->deferred_error;
+    wc->deferred_error = YOKAN_SUCCESS;
+    auto mode_ret = yk_write_combiner_set_mode(dbh, wc, mode);
+    if(*ret == YOKAN_SUCCESS) *ret = mode_ret;
+    if(wc->erase_index.erase(k)) {
+        for(auto it = wc->erase_keys.begin(); it != wc->erase_keys.end(); ++it) {
+            if(*it != k) continue;
+            wc->erase_keys.erase(it);
+            break;
+        }
+    }
+    auto it = wc->put_index.find(k);
+    if(it != wc->put_index.end()) {
+        auto& previous = wc->put_vals[it->second];
+        wc->pending_size += v.size();
+        wc->pending_size -= previous.size();
+        previous = std::move(v);
+    } else {
+        wc->pending_size += k.size() + v.size();
+        wc->put_index.emplace(k, wc->put_keys.size());
+        wc->put_keys.push_back(std::move(k));
+        wc->put_vals.push_back(std::move(v));
+    }
+    auto flush_ret = yk_write_combiner_added(dbh, wc);
+    if(*ret == YOKAN_SUCCESS) *ret = flush_ret;
+    ABT_mutex_unlock(wc->mutex);
+    return true;
+}
+
+bool yk_write_combiner_erase(yk_database_handle_t dbh,
+                             int32_t mode,
+                             const yk_extra_opts_t& extras,
+                             const void* key,
+                             size_t ksize,
+                             yk_return_t* ret)
+{
+    auto wc = dbh->combiner;
+    if(!wc || !yk_write_combiner_accepts(mode, extras)) return false;
+    if(!key) {
+        *ret = YOKAN_ERR_INVALID_ARGS;
+        return true;
+    }
+
+    std::string k{static_cast<const char*>(key), ksize};
+
+    ABT_mutex_lock(wc->mutex);
+    *ret = wc->deferred_error;
+    wc->deferred_error = YOKAN_SUCCESS;
+    auto mode_ret = yk_write_combiner_set_mode(dbh, wc, mode);
+    if(*ret == YOKAN_SUCCESS) *ret = mode_ret;
+    auto it = wc->put_index.find(k);
+    if(it != wc->put_index.end()) {
+        // remove the pending put, moving the last one in its place
+        size_t index = it->second;
+        size_t last  = wc->put_keys.size() - 1;
+        wc->pending_size -= wc->put_keys[index].size() + wc->put_vals[index].size();
+        wc->put_index.erase(it);
+        if(index != last) {
+            wc->put_keys[index] = std::move(wc->put_keys[last]);
+            wc->put_vals[index] = std::move(wc->put_vals[last]);
+            wc->put_index[wc->put_keys[index]] = index;
+        }
+        wc->put_keys.pop_back();
+        wc->put_vals.pop_back();
+    }
+    if(wc->erase_index.insert(k).second) {
+        wc->pending_size += k.size();
+        wc->erase_keys.push_back(std::move(k));
+    }
+    auto flush_ret = yk_write_combiner_added(dbh, wc);
+    if(*ret == YOKAN_SUCCESS) *ret = flush_ret;
+    ABT_mutex_unlock(wc->mutex);
+    return true;
+}
+
+yk_return_t yk_write_combiner_flush(yk_database_handle_t dbh)
+{
+    auto wc = dbh->combiner;
+    if(!wc) return YOKAN_SUCCESS;
+    ABT_mutex_lock(wc->mutex);
+    auto ret = yk_write_combiner_flush_locked(dbh, wc);
+    ABT_mutex_unlock(wc->mutex);
+    return ret;
+}
+
+extern "C" yk_return_t yk_database_handle_enable_write_combining(
+        yk_database_handle_t dbh,
+        const yk_write_combining_options_t* options)
+{
+    if(dbh == YOKAN_DATABASE_HANDLE_NULL)
+        return YOKAN_ERR_INVALID_ARGS;
+    if(options && options->max_delay_ms < 0.0)
+        return YOKAN_ERR_INVALID_ARGS;
+
+    if(dbh->combiner) {
+        // only update the thresholds
+        auto wc = dbh->combiner;
+        ABT_mutex_lock(wc->mutex);
+        wc->options = options ? *options : default_options;
+        auto ret = yk_write_combiner_added(dbh, wc);
+        ABT_mutex_unlock(wc->mutex);
+        return ret;
+    }
+
+    auto wc = new yk_write_combiner;
+    wc->options = options ? *options : default_options;
+
+    ABT_mutex_attr attr;
+    ABT_mutex_attr_create(&attr);
+    ABT_mutex_attr_set_recursive(attr, ABT_TRUE);
+    ABT_mutex_create_with_attr(attr, &wc->mutex);
+    ABT_mutex_attr_free(&attr);
+
+    int r = margo_timer_create(dbh->client->mid, yk_write_combiner_timer_cb,
+                               dbh, &wc->timer);
+    if(r != 0) {
+        ABT_mutex_free(&wc->mutex);
+        delete wc;
+        return YOKAN_ERR_FROM_MERCURY;
+    }
+
+    dbh->combiner = wc;
+    return YOKAN_SUCCESS;
+}
+
+extern "C" yk_return_t yk_database_handle_disable_write_combining(
+        yk_database_handle_t dbh)
+{
+    if(dbh == YOKAN_DATABASE_HANDLE_NULL)
+        return YOKAN_ERR_INVALID_ARGS;
+    auto wc = dbh->combiner;
+    if(!wc) return YOKAN_SUCCESS;
+
+    margo_timer_cancel(wc->timer);
+    margo_timer_destroy(wc->timer);
+
+    ABT_mutex_lock(wc->mutex);
+    auto ret = yk_write_combiner_flush_locked(dbh, wc);
+    if(ret == YOKAN_SUCCESS) ret = wc->deferred_error;
+    dbh->combiner = nullptr;
+    ABT_mutex_unlock(wc->mutex);
+
+    ABT_mutex_free(&wc->mutex);
+    delete wc;
+    return ret;
+}
+
+extern "C" yk_return_t yk_database_handle_flush(yk_database_handle_t dbh)
+{
+    if(dbh == YOKAN_DATABASE_HANDLE_NULL)
+        return YOKAN_ERR_INVALID_ARGS;
+    auto wc = dbh->combiner;
+    if(!wc) return YOKAN_SUCCESS;
+    ABT_mutex_lock(wc->mutex);
+    auto ret = yk_write_combiner_flush_locked(dbh, wc);
+    if(ret == YOKAN_SUCCESS) ret = wc->deferred_error;
+    wc->deferred_error = YOKAN_SUCCESS;
+    ABT_mutex_unlock(wc->mutex);
+    return ret;
+}
@@ -8,6 +8,8 @@
 
 #include "logging.h"
 #include "yokan/allocator.h"
+#include <nlohmann/json.hpp>
+#include <atomic>
 #include <memory>
 #include <iostream>
 
@@ -30,6 +32,57 @@ inline void default_allocator_init(yk_allocator_t* allocator, const char* config
     };
 }
 
+/**
+ * @brief Context of an allocator wrapped by wrap_counting_allocator.
+ */
+struct CountingAllocatorContext {
+    yk_allocator_t      inner;
+    std::atomic<size_t> bytes{0};
+    std::atomic<size_t> allocations{0};
+};
+
+/**
+ * @brief Replace the provided allocator with one that forwards to it
+ * while keeping track of the number of bytes and of allocations currently
+ * live. The wrapper's finalize function finalizes the inner allocator.
+ * allocator_usage() can then be used to read the counters.
+ */
+inline void wrap_counting_allocator(yk_allocator_t* allocator) {
+    auto ctx = new CountingAllocatorContext;
+    ctx->inner = *allocator;
+    allocator->context = ctx;
+    allocator->allocate = [](void* c, size_t item_size, size_t count) {
+        auto ctx = static_cast<CountingAllocatorContext*>(c);
+        auto p = ctx->inner.allocate(ctx->inner.context, item_size, count);
+        ctx->bytes.fetch_add(item_size*count, std::memory_order_relaxed);
+        ctx->allocations.fetch_add(1, std::memory_order_relaxed);
+        return p;
+    };
+    allocator->deallocate = [](void* c, void* p, size_t item_size, size_t count) {
+        auto ctx = static_cast<CountingAllocatorContext*>(c);
+        ctx->inner.deallocate(ctx->inner.context, p, item_size, count);
+        ctx->bytes.fetch_sub(item_size*count, std::memory_order_relaxed);
+        ctx->allocations.fetch_sub(1, std::memory_order_relaxed);
+    };
+    allocator->finalize = [](void* c) {
+        auto ctx = static_cast<CountingAllocatorContext*>(c);
+        ctx->inner.finalize(ctx->inner.context);
+        delete ctx;
+    };
+}
+
+/**
+ * @brief Return the usage of an allocator wrapped by
+ * wrap_counting_allocator, as a JSON object.
+ */
+inline nlohmann::json allocator_usage(const yk_allocator_t& allocator) {
+    auto ctx = static_cast<const CountingAllocatorContext*>(allocator.context);
+    return nlohmann::json{
+        {"bytes",       ctx->bytes.load(std::memory_order_relaxed)},
+        {"allocations", ctx->allocations.load(std::memory_order_relaxed)}
+    };
+}
+
 template <typename T>
 struct Allocator {
 
@@ -84,10 +84,12 @@
 /* YOKAN_MODE_EXTRA is a client-side marker that the variadic tail carries
  * options (extracted before forwarding); the server / backend never reasons
  * about it, so strip it here before asking the backend whether the mode is
- * supported. */
+ * supported. YOKAN_MODE_NO_RDMA only selects which RPC the client sends
+ * (the client may also pick the direct RPCs on its own for small payloads),
+ * so it does not depend on the backend either. */
 #define CHECK_MODE_SUPPORTED(__db__, __mode__) \
     do { \
-        if(!__db__->supportsMode((__mode__) & ~YOKAN_MODE_EXTRA)) { \
+        if(!__db__->supportsMode((__mode__) & ~(YOKAN_MODE_EXTRA|YOKAN_MODE_NO_RDMA))) { \
             out.ret = YOKAN_ERR_MODE; \
             YOKAN_LOG_ERROR(mid, "mode not supported by database"); \
             return; \
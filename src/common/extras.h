@@ -7,6 +7,8 @@
 #define _YOKAN_EXTRAS_H
 
 #include <stdarg.h>
+#include <stdint.h>
+#include <stddef.h>
 #include "yokan/common.h"
 
 #ifdef __cplusplus
@@ -20,10 +22,12 @@ extern "C" {
  * behaves as if YOKAN_MODE_EXTRA had not been set.
  */
 typedef struct yk_extra_opts {
-    double timeout_ms; /* 0.0 = blocking forever */
+    double   timeout_ms;       /* 0.0 = blocking forever */
+    uint64_t trace_id;         /* 0 = let the server assign one */
+    size_t   direct_threshold; /* SIZE_MAX = use the client's */
 } yk_extra_opts_t;
 
-#define YK_EXTRA_OPTS_INIT { 0.0 }
+#define YK_EXTRA_OPTS_INIT { 0.0, 0, SIZE_MAX }
 
 /**
  * @brief Drain a va_list of (tag, value)... pairs terminated by
@@ -46,6 +50,12 @@ static inline void yk_extras_drain(va_list ap, yk_extra_opts_t* out)
         case YOKAN_EXTRA_TIMEOUT_MS:
             out->timeout_ms = va_arg(ap, double);
             break;
+        case YOKAN_EXTRA_TRACE_ID:
+            out->trace_id = va_arg(ap, uint64_t);
+            break;
+        case YOKAN_EXTRA_DIRECT_THRESHOLD:
+            out->direct_threshold = va_arg(ap, size_t);
+            break;
         default:
             (void)va_arg(ap, void*);
             break;
@@ -86,7 +96,10 @@ static inline void yk_extras_drain(va_list ap, yk_extra_opts_t* out)
  *                        value, &vsize, YK_REEMIT_EXTRAS(extras));
  */
 #define YK_REEMIT_EXTRAS(extras) \
-    YOKAN_EXTRA_TIMEOUT_MS, (extras).timeout_ms, YOKAN_EXTRA_END
+    YOKAN_EXTRA_TIMEOUT_MS, (extras).timeout_ms,             \
+    YOKAN_EXTRA_TRACE_ID, (extras).trace_id,                 \
+    YOKAN_EXTRA_DIRECT_THRESHOLD, (extras).direct_threshold, \
+    YOKAN_EXTRA_END
 
 #define YK_MODE_WITH_EXTRA(mode_var) ((mode_var) | YOKAN_MODE_EXTRA)
 
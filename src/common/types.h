@@ -63,6 +63,7 @@ MERCURY_GEN_PROC(count_out_t,
 MERCURY_GEN_PROC(exists_in_t,
         ((int32_t)(mode))\
         ((double)(timeout_ms))\
+        ((uint64_t)(trace_id))\
         ((uint64_t)(count))\
         ((uint64_t)(offset))\
         ((uint64_t)(size))\
@@ -75,6 +76,7 @@ MERCURY_GEN_PROC(exists_out_t,
 MERCURY_GEN_PROC(exists_direct_in_t,
         ((int32_t)(mode))\
         ((double)(timeout_ms))\
+        ((uint64_t)(trace_id))\
         ((raw_data)(keys))\
         ((uint64_list)(sizes)))
 MERCURY_GEN_PROC(exists_direct_out_t,
@@ -85,6 +87,7 @@ MERCURY_GEN_PROC(exists_direct_out_t,
 MERCURY_GEN_PROC(length_in_t,
         ((int32_t)(mode))\
         ((double)(timeout_ms))\
+        ((uint64_t)(trace_id))\
         ((uint64_t)(count))\
         ((uint64_t)(offset))\
         ((uint64_t)(size))\
@@ -97,6 +100,7 @@ MERCURY_GEN_PROC(length_out_t,
 MERCURY_GEN_PROC(length_direct_in_t,
         ((int32_t)(mode))\
         ((double)(timeout_ms))\
+        ((uint64_t)(trace_id))\
         ((raw_data)(keys))\
         ((uint64_list)(sizes)))
 MERCURY_GEN_PROC(length_direct_out_t,
@@ -107,6 +111,7 @@ MERCURY_GEN_PROC(length_direct_out_t,
 MERCURY_GEN_PROC(put_in_t,
         ((int32_t)(mode))\
         ((double)(timeout_ms))\
+        ((uint64_t)(trace_id))\
         ((uint64_t)(count))\
         ((uint64_t)(offset))\
         ((uint64_t)(size))\
@@ -119,6 +124,7 @@ MERCURY_GEN_PROC(put_out_t,
 MERCURY_GEN_PROC(put_direct_in_t,
         ((int32_t)(mode))\
         ((double)(timeout_ms))\
+        ((uint64_t)(trace_id))\
         ((uint64_list)(ksizes))\
         ((uint64_list)(vsizes))\
         ((raw_data)(keys))\
@@ -130,6 +136,7 @@ MERCURY_GEN_PROC(put_direct_out_t,
 MERCURY_GEN_PROC(get_in_t,
         ((int32_t)(mode))\
         ((double)(timeout_ms))\
+        ((uint64_t)(trace_id))\
         ((uint64_t)(count))\
         ((uint64_t)(offset))\
         ((uint64_t)(size))\
@@ -143,6 +150,7 @@ MERCURY_GEN_PROC(get_out_t,
 MERCURY_GEN_PROC(get_direct_in_t,
         ((int32_t)(mode))\
         ((double)(timeout_ms))\
+        ((uint64_t)(trace_id))\
         ((hg_size_t)(vbufsize))\
         ((uint64_list)(ksizes))\
         ((raw_data)(keys)))
@@ -151,10 +159,86 @@ MERCURY_GEN_PROC(get_direct_out_t,
         ((raw_data)(vals))\
         ((int32_t)(ret)))
 
+/* get (server-allocated) */
+MERCURY_GEN_PROC(get_alloc_in_t,
+        ((int32_t)(mode))\
+        ((double)(timeout_ms))\
+        ((uint64_t)(trace_id))\
+        ((hg_size_t)(inline_threshold))\
+        ((uint64_list)(ksizes))\
+        ((raw_data)(keys)))
+MERCURY_GEN_PROC(get_alloc_out_t,
+        ((uint64_list)(vsizes))\
+        ((raw_data)(vals))\
+        ((hg_bulk_t)(bulk))\
+        ((uint64_t)(lease))\
+        ((int32_t)(ret)))
+
+/* get_alloc_release (no response) */
+MERCURY_GEN_PROC(get_alloc_release_in_t,
+        ((uint64_t)(lease)))
+
+/* get_range (the data is sent back inline if bulk is null) */
+MERCURY_GEN_PROC(get_range_in_t,
+        ((int32_t)(mode))\
+        ((double)(timeout_ms))\
+        ((uint64_t)(trace_id))\
+        ((raw_data)(key))\
+        ((uint64_t)(offset))\
+        ((uint64_t)(size))\
+        ((hg_string_t)(origin))\
+        ((hg_bulk_t)(bulk)))
+MERCURY_GEN_PROC(get_range_out_t,
+        ((raw_data)(data))\
+        ((uint64_t)(size))\
+        ((int32_t)(ret)))
+
+/* put_range (the data is sent inline if bulk is null) */
+MERCURY_GEN_PROC(put_range_in_t,
+        ((int32_t)(mode))\
+        ((double)(timeout_ms))\
+        ((uint64_t)(trace_id))\
+        ((raw_data)(key))\
+        ((uint64_t)(offset))\
+        ((uint64_t)(size))\
+        ((raw_data)(data))\
+        ((hg_string_t)(origin))\
+        ((hg_bulk_t)(bulk)))
+MERCURY_GEN_PROC(put_range_out_t,
+        ((int32_t)(ret)))
+
+/* compare_and_swap (always direct: values used for coordination are small) */
+MERCURY_GEN_PROC(compare_and_swap_in_t,
+        ((int32_t)(mode))\
+        ((double)(timeout_ms))\
+        ((uint64_t)(trace_id))\
+        ((raw_data)(key))\
+        ((raw_data)(expected))\
+        ((raw_data)(value)))
+MERCURY_GEN_PROC(compare_and_swap_out_t,
+        ((int32_t)(ret))\
+        ((uint8_t)(swapped)))
+
+/* merge (always direct, the new value is sent back if rsize is not 0) */
+MERCURY_GEN_PROC(merge_in_t,
+        ((int32_t)(mode))\
+        ((double)(timeout_ms))\
+        ((uint64_t)(trace_id))\
+        ((raw_data)(key))\
+        ((int32_t)(op))\
+        ((raw_data)(operand))\
+        ((uint64_t)(bound))\
+        ((uint64_t)(rsize)))
+MERCURY_GEN_PROC(merge_out_t,
+        ((raw_data)(result))\
+        ((uint64_t)(rsize))\
+        ((int32_t)(ret)))
+
 /* fetch */
 MERCURY_GEN_PROC(fetch_in_t,
         ((int32_t)(mode))\
         ((double)(timeout_ms))\
+        ((uint64_t)(trace_id))\
         ((uint32_t)(batch_size))\
         ((uint64_t)(count))\
         ((uint64_t)(offset))\
@@ -169,6 +253,7 @@ MERCURY_GEN_PROC(fetch_out_t,
 MERCURY_GEN_PROC(fetch_direct_in_t,
         ((int32_t)(mode))\
         ((double)(timeout_ms))\
+        ((uint64_t)(trace_id))\
         ((uint32_t)(batch_size))\
         ((uint64_list)(ksizes))\
         ((raw_data)(keys))\
@@ -199,6 +284,7 @@ MERCURY_GEN_PROC(fetch_direct_back_out_t,
 MERCURY_GEN_PROC(erase_in_t,
         ((int32_t)(mode))\
         ((double)(timeout_ms))\
+        ((uint64_t)(trace_id))\
         ((uint64_t)(count))\
         ((uint64_t)(offset))\
         ((uint64_t)(size))\
@@ -211,6 +297,7 @@ MERCURY_GEN_PROC(erase_out_t,
 MERCURY_GEN_PROC(erase_direct_in_t,
         ((int32_t)(mode))\
         ((double)(timeout_ms))\
+        ((uint64_t)(trace_id))\
         ((uint64_list)(ksizes))\
         ((raw_data)(keys)))
 MERCURY_GEN_PROC(erase_direct_out_t,
@@ -552,6 +639,13 @@ MERCURY_GEN_PROC(get_remi_provider_id_out_t,
         ((int32_t)(ret))\
         ((uint16_t)(provider_id)))
 
+/* get_stats */
+MERCURY_GEN_PROC(get_stats_in_t,
+        ((uint8_t)(reset)))
+MERCURY_GEN_PROC(get_stats_out_t,
+        ((int32_t)(ret))\
+        ((hg_string_t)(stats)))
+
 /* Extra hand-coded serialization functions */
 
 static inline hg_return_t hg_proc_yk_id_t(
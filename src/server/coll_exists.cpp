@@ -28,6 +28,8 @@ void yk_coll_exists_ult(hg_handle_t h)
     const struct hg_info* info = margo_get_info(h);
     yk_provider_t provider = (yk_provider_t)margo_registered_data(mid, info->id);
     CHECK_PROVIDER(provider);
+    yokan::RPCMetricsScope metrics{
+        provider->metrics.get(), yokan::RPCType::COLL_EXISTS, out.ret};
 
     hret = margo_get_input(h, &in);
     CHECK_HRET_OUT(hret, margo_get_input);
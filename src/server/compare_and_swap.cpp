@@ -0,0 +1,66 @@
+/*
+ * (C) 2026 The University of Chicago
+ *
+ * See COPYRIGHT in top-level directory.
+ */
+#include "yokan/server.h"
+#include "provider.hpp"
+#include "../common/types.h"
+#include "../common/defer.hpp"
+#include "../common/logging.h"
+#include "../common/checks.h"
+#include <cstring>
+
+void yk_compare_and_swap_ult(hg_handle_t h)
+{
+    hg_return_t hret;
+    compare_and_swap_in_t in;
+    compare_and_swap_out_t out;
+
+    std::memset(&in, 0, sizeof(in));
+    std::memset(&out, 0, sizeof(out));
+
+    out.ret = YOKAN_SUCCESS;
+    yokan::RPCTrace trace;
+
+    DEFER(margo_destroy(h));
+    DEFER(trace.phase("respond"); margo_respond(h, &out));
+
+    margo_instance_id mid = margo_hg_handle_get_instance(h);
+    CHECK_MID(mid, margo_hg_handle_get_instance);
+
+    const struct hg_info* info = margo_get_info(h);
+    yk_provider_t provider = (yk_provider_t)margo_registered_data(mid, info->id);
+    CHECK_PROVIDER(provider);
+    yokan::RPCMetricsScope metrics{
+        provider->metrics.get(), yokan::RPCType::COMPARE_AND_SWAP, out.ret};
+    trace.start(provider->tracer.get(), yokan::RPCType::COMPARE_AND_SWAP);
+
+    hret = margo_get_input(h, &in);
+    CHECK_HRET_OUT(hret, margo_get_input);
+    trace.setTraceId(in.trace_id);
+    trace.phase("prepare");
+    metrics.keys     = 1;
+    metrics.bytes_in = in.key.size + in.expected.size + in.value.size;
+    DEFER(margo_free_input(h, &in));
+
+    if(in.key.size == 0) {
+        out.ret = YOKAN_ERR_INVALID_ARGS;
+        return;
+    }
+
+    yk_database* database = provider->db;
+    CHECK_DATABASE(database);
+    CHECK_MODE_SUPPORTED(database, in.mode);
+
+    auto key      = yokan::UserMem{ in.key.data, in.key.size };
+    auto expected = yokan::UserMem{ in.expected.data, in.expected.size };
+    auto value    = yokan::UserMem{ in.value.data, in.value.size };
+    bool swapped  = false;
+
+    trace.phase("backend");
+    out.ret = static_cast<yk_return_t>(
+            database->compareAndSwap(in.mode, key, expected, value, &swapped));
+    out.swapped = swapped;
+}
+DEFINE_MARGO_RPC_HANDLER(yk_compare_and_swap_ult)
@@ -31,9 +31,12 @@ void yk_doc_erase_ult(hg_handle_t h)
     const struct hg_info* info = margo_get_info(h);
     yk_provider_t provider = (yk_provider_t)margo_registered_data(mid, info->id);
     CHECK_PROVIDER(provider);
+    yokan::RPCMetricsScope metrics{
+        provider->metrics.get(), yokan::RPCType::DOC_ERASE, out.ret};
 
     hret = margo_get_input(h, &in);
     CHECK_HRET_OUT(hret, margo_get_input);
+    metrics.keys = in.ids.count;
     const double timeout_ms = in.timeout_ms;
     (void)timeout_ms;
     DEFER(margo_free_input(h, &in));
@@ -5,6 +5,7 @@
  */
 #include "yokan/server.h"
 #include "provider.hpp"
+#include "zero_copy.hpp"
 #include "../common/types.h"
 #include "../common/defer.hpp"
 #include "../common/logging.h"
@@ -30,9 +31,12 @@ void yk_doc_fetch_ult(hg_handle_t h)
     const struct hg_info* info = margo_get_info(h);
     yk_provider_t provider = (yk_provider_t)margo_registered_data(mid, info->id);
     CHECK_PROVIDER(provider);
+    yokan::RPCMetricsScope metrics{
+        provider->metrics.get(), yokan::RPCType::DOC_FETCH, out.ret};
 
     hret = margo_get_input(h, &in);
     CHECK_HRET_OUT(hret, margo_get_input);
+    metrics.keys = in.ids.count;
     const double timeout_ms = in.timeout_ms;
     (void)timeout_ms;
     DEFER(margo_free_input(h, &in));
@@ -47,6 +51,7 @@ void yk_doc_fetch_ult(hg_handle_t h)
     CHECK_MODE_SUPPORTED(database, in.mode);
 
     bool direct = in.mode & YOKAN_MODE_NO_RDMA;
+    bool zero_copy = !direct && database->supportsZeroCopyFetch();
 
     struct previous_op {
         std::vector<char>   docs;
@@ -80,6 +85,34 @@ void yk_doc_fetch_ult(hg_handle_t h)
             in.ids.ids + ids_start,
             std::min<size_t>(in.batch_size, in.ids.count - ids_start)};
 
+        if(zero_copy) {
+            // documents are exposed directly from the backend's memory,
+            // which is only valid during the call to docFetch, so the
+            // doc_fetch_back RPC is sent when the last document is processed
+            ZeroCopyBatch batch{ids.size};
+
+            auto fetcher = [&](yk_id_t id, const yokan::UserMem& doc) -> yokan::Status {
+                (void)id;
+                batch.add(doc);
+                if(!batch.complete()) return yokan::Status::OK;
+                doc_fetch_back_in_t back_in;
+                back_in.op_ref = in.op_ref;
+                back_in.start  = ids_start;
+                back_in.count  = ids.size;
+                return static_cast<yokan::Status>(
+                    batch.send<doc_fetch_back_out_t>(mid, info->addr, provider->doc_fetch_back_id, back_in));
+            };
+
+            out.ret = static_cast<yk_return_t>(
+                    database->docFetch(in.coll_name, in.mode, ids, fetcher));
+            if(out.ret == YOKAN_SUCCESS && !batch.complete())
+                out.ret = YOKAN_ERR_OTHER;
+            if(out.ret != YOKAN_SUCCESS)
+                break;
+
+            continue;
+        }
+
         // create buffers to hold the documents and document sizes
         std::vector<char>   docs;
         std::vector<size_t> doc_sizes;
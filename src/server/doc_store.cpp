@@ -34,9 +34,13 @@ void yk_doc_store_ult(hg_handle_t h)
     const struct hg_info* info = margo_get_info(h);
     yk_provider_t provider = (yk_provider_t)margo_registered_data(mid, info->id);
     CHECK_PROVIDER(provider);
+    yokan::RPCMetricsScope metrics{
+        provider->metrics.get(), yokan::RPCType::DOC_STORE, out.ret};
 
     hret = margo_get_input(h, &in);
     CHECK_HRET_OUT(hret, margo_get_input);
+    metrics.keys     = in.count;
+    metrics.bytes_in = in.size;
     const double timeout_ms = in.timeout_ms;
     const double t_start = ABT_get_wtime();
     double bulk_timeout;
@@ -113,9 +117,13 @@ void yk_doc_store_direct_ult(hg_handle_t h)
     const struct hg_info* info = margo_get_info(h);
     yk_provider_t provider = (yk_provider_t)margo_registered_data(mid, info->id);
     CHECK_PROVIDER(provider);
+    yokan::RPCMetricsScope metrics{
+        provider->metrics.get(), yokan::RPCType::DOC_STORE_DIRECT, out.ret};
 
     hret = margo_get_input(h, &in);
     CHECK_HRET_OUT(hret, margo_get_input);
+    metrics.keys     = in.sizes.count;
+    metrics.bytes_in = in.docs.size;
     const double timeout_ms = in.timeout_ms;
     (void)timeout_ms;
     const double t_start = ABT_get_wtime();
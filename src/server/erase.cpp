@@ -20,9 +20,10 @@ void yk_erase_ult(hg_handle_t h)
     hg_addr_t origin_addr = HG_ADDR_NULL;
 
     out.ret = YOKAN_SUCCESS;
+    yokan::RPCTrace trace;
 
     DEFER(margo_destroy(h));
-    DEFER(margo_respond(h, &out));
+    DEFER(trace.phase("respond"); margo_respond(h, &out));
 
     margo_instance_id mid = margo_hg_handle_get_instance(h);
     CHECK_MID(mid, margo_hg_handle_get_instance);
@@ -30,9 +31,16 @@ void yk_erase_ult(hg_handle_t h)
     const struct hg_info* info = margo_get_info(h);
     yk_provider_t provider = (yk_provider_t)margo_registered_data(mid, info->id);
     CHECK_PROVIDER(provider);
+    yokan::RPCMetricsScope metrics{
+        provider->metrics.get(), yokan::RPCType::ERASE, out.ret};
+    trace.start(provider->tracer.get(), yokan::RPCType::ERASE);
 
     hret = margo_get_input(h, &in);
     CHECK_HRET_OUT(hret, margo_get_input);
+    trace.setTraceId(in.trace_id);
+    trace.phase("prepare");
+    metrics.keys     = in.count;
+    metrics.bytes_in = in.size;
     const double timeout_ms = in.timeout_ms;
     const double t_start = ABT_get_wtime();
     double bulk_timeout;
@@ -51,6 +59,7 @@ void yk_erase_ult(hg_handle_t h)
     DEFER(provider->bulk_cache.release(
             provider->bulk_cache_data, buffer));
 
+    trace.phase("bulk_pull");
     bulk_timeout = yk_bulk_timeout_ms(timeout_ms, t_start);
     hret = margo_bulk_transfer_timed(mid, HG_BULK_PULL, origin_addr,
                                in.bulk, in.offset, buffer->bulk, 0, in.size, bulk_timeout);
@@ -81,6 +90,7 @@ void yk_erase_ult(hg_handle_t h)
 
     auto keys = yokan::UserMem{ ptr, total_ksize };
 
+    trace.phase("backend");
     out.ret = static_cast<yk_return_t>(
             database->erase(in.mode, keys, ksizes));
 }
@@ -97,9 +107,10 @@ void yk_erase_direct_ult(hg_handle_t h)
     in.keys.data = nullptr;
     in.keys.size = 0;
     out.ret = YOKAN_SUCCESS;
+    yokan::RPCTrace trace;
 
     DEFER(margo_destroy(h));
-    DEFER(margo_respond(h, &out));
+    DEFER(trace.phase("respond"); margo_respond(h, &out));
 
     margo_instance_id mid = margo_hg_handle_get_instance(h);
     CHECK_MID(mid, margo_hg_handle_get_instance);
@@ -107,9 +118,16 @@ void yk_erase_direct_ult(hg_handle_t h)
     const struct hg_info* info = margo_get_info(h);
     yk_provider_t provider = (yk_provider_t)margo_registered_data(mid, info->id);
     CHECK_PROVIDER(provider);
+    yokan::RPCMetricsScope metrics{
+        provider->metrics.get(), yokan::RPCType::ERASE_DIRECT, out.ret};
+    trace.start(provider->tracer.get(), yokan::RPCType::ERASE_DIRECT);
 
     hret = margo_get_input(h, &in);
     CHECK_HRET_OUT(hret, margo_get_input);
+    trace.setTraceId(in.trace_id);
+    trace.phase("prepare");
+    metrics.keys     = in.ksizes.count;
+    metrics.bytes_in = in.keys.size;
     const double timeout_ms = in.timeout_ms;
     (void)timeout_ms;
     const double t_start = ABT_get_wtime();
@@ -137,6 +155,7 @@ void yk_erase_direct_ult(hg_handle_t h)
 
     auto keys = yokan::UserMem{ in.keys.data, in.keys.size };
 
+    trace.phase("backend");
     out.ret = static_cast<yk_return_t>(
             database->erase(in.mode, keys, ksizes));
 }
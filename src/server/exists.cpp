@@ -21,9 +21,10 @@ void yk_exists_ult(hg_handle_t h)
     hg_addr_t origin_addr = HG_ADDR_NULL;
 
     out.ret = YOKAN_SUCCESS;
+    yokan::RPCTrace trace;
 
     DEFER(margo_destroy(h));
-    DEFER(margo_respond(h, &out));
+    DEFER(trace.phase("respond"); margo_respond(h, &out));
 
     margo_instance_id mid = margo_hg_handle_get_instance(h);
     CHECK_MID(mid, margo_hg_handle_get_instance);
@@ -31,9 +32,15 @@ void yk_exists_ult(hg_handle_t h)
     const struct hg_info* info = margo_get_info(h);
     yk_provider_t provider = (yk_provider_t)margo_registered_data(mid, info->id);
     CHECK_PROVIDER(provider);
+    yokan::RPCMetricsScope metrics{
+        provider->metrics.get(), yokan::RPCType::EXISTS, out.ret};
+    trace.start(provider->tracer.get(), yokan::RPCType::EXISTS);
 
     hret = margo_get_input(h, &in);
     CHECK_HRET_OUT(hret, margo_get_input);
+    trace.setTraceId(in.trace_id);
+    trace.phase("prepare");
+    metrics.keys = in.count;
     const double timeout_ms = in.timeout_ms;
     const double t_start = ABT_get_wtime();
     double bulk_timeout;
@@ -58,6 +65,7 @@ void yk_exists_ult(hg_handle_t h)
     // transfer ksizes
     size_t sizes_to_transfer = in.count*sizeof(size_t);
 
+    trace.phase("bulk_pull");
     bulk_timeout = yk_bulk_timeout_ms(timeout_ms, t_start);
     hret = margo_bulk_transfer_timed(mid, HG_BULK_PULL, origin_addr,
             in.bulk, in.offset, buffer->bulk, 0, sizes_to_transfer, bulk_timeout);
@@ -92,6 +100,7 @@ void yk_exists_ult(hg_handle_t h)
     }
 
     // transfer the actual keys from the client
+    trace.phase("bulk_pull");
     bulk_timeout = yk_bulk_timeout_ms(timeout_ms, t_start);
     hret = margo_bulk_transfer_timed(mid, HG_BULK_PULL, origin_addr,
             in.bulk, in.offset + keys_offset,
@@ -108,10 +117,12 @@ void yk_exists_ult(hg_handle_t h)
     };
     std::memset(flags.data, 0, flags_size);
 
+    trace.phase("backend");
     out.ret = static_cast<yk_return_t>(
             database->exists(in.mode, keys, ksizes, flags));
 
     if(out.ret == YOKAN_SUCCESS) {
+        trace.phase("bulk_push");
         // transfer the bit field back the client
         bulk_timeout = yk_bulk_timeout_ms(timeout_ms, t_start);
         hret = margo_bulk_transfer_timed(mid, HG_BULK_PUSH, origin_addr,
@@ -138,9 +149,10 @@ void yk_exists_direct_ult(hg_handle_t h)
     out.ret = YOKAN_SUCCESS;
     out.flags.data = nullptr;
     out.flags.size = 0;
+    yokan::RPCTrace trace;
 
     DEFER(margo_destroy(h));
-    DEFER(margo_respond(h, &out));
+    DEFER(trace.phase("respond"); margo_respond(h, &out));
 
     margo_instance_id mid = margo_hg_handle_get_instance(h);
     CHECK_MID(mid, margo_hg_handle_get_instance);
@@ -148,9 +160,16 @@ void yk_exists_direct_ult(hg_handle_t h)
     const struct hg_info* info = margo_get_info(h);
     yk_provider_t provider = (yk_provider_t)margo_registered_data(mid, info->id);
     CHECK_PROVIDER(provider);
+    yokan::RPCMetricsScope metrics{
+        provider->metrics.get(), yokan::RPCType::EXISTS_DIRECT, out.ret};
+    trace.start(provider->tracer.get(), yokan::RPCType::EXISTS_DIRECT);
 
     hret = margo_get_input(h, &in);
     CHECK_HRET_OUT(hret, margo_get_input);
+    trace.setTraceId(in.trace_id);
+    trace.phase("prepare");
+    metrics.keys     = in.ksizes.count;
+    metrics.bytes_in = in.keys.size;
     const double timeout_ms = in.timeout_ms;
     (void)timeout_ms;
     const double t_start = ABT_get_wtime();
@@ -187,6 +206,7 @@ void yk_exists_direct_ult(hg_handle_t h)
     // create memory wrapper for keys
     auto keys = yokan::UserMem{ in.keys.data, in.keys.size };
 
+    trace.phase("backend");
     out.ret = static_cast<yk_return_t>(
             database->exists(in.mode, keys, ksizes, flags));
 }
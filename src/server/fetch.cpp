@@ -5,6 +5,7 @@
  */
 #include "yokan/server.h"
 #include "provider.hpp"
+#include "zero_copy.hpp"
 #include "../common/types.h"
 #include "../common/defer.hpp"
 #include "../common/logging.h"
@@ -22,9 +23,10 @@ void yk_fetch_ult(hg_handle_t h)
     hg_addr_t origin_addr = HG_ADDR_NULL;
 
     out.ret = YOKAN_SUCCESS;
+    yokan::RPCTrace trace;
 
     DEFER(margo_destroy(h));
-    DEFER(margo_respond(h, &out));
+    DEFER(trace.phase("respond"); margo_respond(h, &out));
 
     margo_instance_id mid = margo_hg_handle_get_instance(h);
     CHECK_MID(mid, margo_hg_handle_get_instance);
@@ -32,9 +34,15 @@ void yk_fetch_ult(hg_handle_t h)
     const struct hg_info* info = margo_get_info(h);
     yk_provider_t provider = (yk_provider_t)margo_registered_data(mid, info->id);
     CHECK_PROVIDER(provider);
+    yokan::RPCMetricsScope metrics{
+        provider->metrics.get(), yokan::RPCType::FETCH, out.ret};
+    trace.start(provider->tracer.get(), yokan::RPCType::FETCH);
 
     hret = margo_get_input(h, &in);
     CHECK_HRET_OUT(hret, margo_get_input);
+    trace.setTraceId(in.trace_id);
+    trace.phase("prepare");
+    metrics.keys = in.count;
     const double timeout_ms = in.timeout_ms;
     const double t_start = ABT_get_wtime();
     double bulk_timeout;
@@ -62,6 +70,7 @@ void yk_fetch_ult(hg_handle_t h)
     // transfer ksizes
     size_t sizes_to_transfer = in.count*sizeof(size_t);
 
+    trace.phase("bulk_pull");
     bulk_timeout = yk_bulk_timeout_ms(timeout_ms, t_start);
     hret = margo_bulk_transfer_timed(mid, HG_BULK_PULL, origin_addr,
             in.bulk, in.offset, keys_buffer->bulk, 0, sizes_to_transfer, bulk_timeout);
@@ -89,6 +98,7 @@ void yk_fetch_ult(hg_handle_t h)
     }
 
     // transfer the actual keys from the client
+    trace.phase("bulk_pull");
     bulk_timeout = yk_bulk_timeout_ms(timeout_ms, t_start);
     hret = margo_bulk_transfer_timed(mid, HG_BULK_PULL, origin_addr,
             in.bulk, in.offset + keys_offset,
@@ -119,6 +129,8 @@ void yk_fetch_ult(hg_handle_t h)
         return (yk_return_t)back_out.ret;
     };
 
+    const bool zero_copy = database->supportsZeroCopyFetch();
+
     for(unsigned batch_index = 0; batch_index < num_batches; ++batch_index) {
 
         // create UserMem wrapper for ksizes for this batch
@@ -132,6 +144,38 @@ void yk_fetch_ult(hg_handle_t h)
         // create UserMem wrapper for keys for this batch
         auto keys = yokan::UserMem{ ((char*)ksizes_ptr) + keys_offset, total_batch_ksize };
 
+        if(zero_copy) {
+            // values are exposed directly from the backend's memory, which
+            // is only valid during the call to fetch, so the fetch_back RPC
+            // is sent (synchronously) when the last value is processed
+            ZeroCopyBatch batch{ksizes.size};
+
+            auto fetcher = [&](const yokan::UserMem& key, const yokan::UserMem& val) -> yokan::Status {
+                (void)key;
+                batch.add(val);
+                if(!batch.complete()) return yokan::Status::OK;
+                fetch_back_in_t back_in;
+                back_in.op_ref = in.op_ref;
+                back_in.start  = batch_index*in.batch_size;
+                back_in.count  = ksizes.size;
+                auto ret = batch.send<fetch_back_out_t>(
+                    mid, info->addr, provider->fetch_back_id, back_in);
+                metrics.bytes_out += back_in.size;
+                return static_cast<yokan::Status>(ret);
+            };
+
+            trace.phase("backend");
+            out.ret = static_cast<yk_return_t>(
+                    database->fetch(in.mode, keys, ksizes, fetcher));
+            if(out.ret == YOKAN_SUCCESS && !batch.complete())
+                out.ret = YOKAN_ERR_OTHER;
+            if(out.ret != YOKAN_SUCCESS)
+                break;
+
+            keys_offset += total_batch_ksize;
+            continue;
+        }
+
         // create buffers to hold the values and value sizes
         std::vector<char>   values;
         std::vector<size_t> vsizes;
@@ -150,6 +194,7 @@ void yk_fetch_ult(hg_handle_t h)
             return yokan::Status::OK;
         };
 
+        trace.phase("backend");
         out.ret = static_cast<yk_return_t>(
                 database->fetch(in.mode, keys, ksizes, fetcher));
         if(out.ret != YOKAN_SUCCESS)
@@ -171,7 +216,9 @@ void yk_fetch_ult(hg_handle_t h)
         back_in.count  = ksizes.size;
         back_in.size   = std::accumulate(values_sizes.begin(), values_sizes.end(), (size_t)0);
         back_in.bulk   = values_bulk;
+        metrics.bytes_out += back_in.size;
 
+        trace.phase("fetch_back");
         out.ret = wait_for_previous_rpc();
         if(out.ret != YOKAN_SUCCESS)
             break;
@@ -203,6 +250,7 @@ void yk_fetch_ult(hg_handle_t h)
         out.ret = YOKAN_SUCCESS;
 
 finish:
+    trace.phase("fetch_back");
     auto ret = wait_for_previous_rpc();
     if(out.ret == YOKAN_SUCCESS) out.ret = ret;
     return;
@@ -219,9 +267,10 @@ void yk_fetch_direct_ult(hg_handle_t h)
     std::memset(&out, 0, sizeof(out));
 
     out.ret = YOKAN_SUCCESS;
+    yokan::RPCTrace trace;
 
     DEFER(margo_destroy(h));
-    DEFER(margo_respond(h, &out));
+    DEFER(trace.phase("respond"); margo_respond(h, &out));
 
     margo_instance_id mid = margo_hg_handle_get_instance(h);
     CHECK_MID(mid, margo_hg_handle_get_instance);
@@ -229,9 +278,16 @@ void yk_fetch_direct_ult(hg_handle_t h)
     const struct hg_info* info = margo_get_info(h);
     yk_provider_t provider = (yk_provider_t)margo_registered_data(mid, info->id);
     CHECK_PROVIDER(provider);
+    yokan::RPCMetricsScope metrics{
+        provider->metrics.get(), yokan::RPCType::FETCH_DIRECT, out.ret};
+    trace.start(provider->tracer.get(), yokan::RPCType::FETCH_DIRECT);
 
     hret = margo_get_input(h, &in);
     CHECK_HRET_OUT(hret, margo_get_input);
+    trace.setTraceId(in.trace_id);
+    trace.phase("prepare");
+    metrics.keys     = in.ksizes.count;
+    metrics.bytes_in = in.keys.size;
     const double timeout_ms = in.timeout_ms;
     (void)timeout_ms;
     const double t_start = ABT_get_wtime();
@@ -313,6 +369,7 @@ void yk_fetch_direct_ult(hg_handle_t h)
             return yokan::Status::OK;
         };
 
+        trace.phase("backend");
         out.ret = static_cast<yk_return_t>(
                 database->fetch(in.mode, keys, ksizes, fetcher));
         if(out.ret != YOKAN_SUCCESS)
@@ -325,7 +382,9 @@ void yk_fetch_direct_ult(hg_handle_t h)
         back_in.vsizes.sizes = vsizes.data();
         back_in.vals.size    = values.size();
         back_in.vals.data    = values.data();
+        metrics.bytes_out += values.size();
 
+        trace.phase("fetch_back");
         out.ret = wait_for_previous_rpc();
         if(out.ret != YOKAN_SUCCESS)
             break;
@@ -353,6 +412,7 @@ void yk_fetch_direct_ult(hg_handle_t h)
         out.ret = YOKAN_SUCCESS;
 
 finish:
+    trace.phase("fetch_back");
     auto ret = wait_for_previous_rpc();
     if(out.ret == YOKAN_SUCCESS) out.ret = ret;
     return;
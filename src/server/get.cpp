@@ -20,9 +20,10 @@ void yk_get_ult(hg_handle_t h)
     hg_addr_t origin_addr = HG_ADDR_NULL;
 
     out.ret = YOKAN_SUCCESS;
+    yokan::RPCTrace trace;
 
     DEFER(margo_destroy(h));
-    DEFER(margo_respond(h, &out));
+    DEFER(trace.phase("respond"); margo_respond(h, &out));
 
     margo_instance_id mid = margo_hg_handle_get_instance(h);
     CHECK_MID(mid, margo_hg_handle_get_instance);
@@ -30,9 +31,15 @@ void yk_get_ult(hg_handle_t h)
     const struct hg_info* info = margo_get_info(h);
     yk_provider_t provider = (yk_provider_t)margo_registered_data(mid, info->id);
     CHECK_PROVIDER(provider);
+    yokan::RPCMetricsScope metrics{
+        provider->metrics.get(), yokan::RPCType::GET, out.ret};
+    trace.start(provider->tracer.get(), yokan::RPCType::GET);
 
     hret = margo_get_input(h, &in);
     CHECK_HRET_OUT(hret, margo_get_input);
+    trace.setTraceId(in.trace_id);
+    trace.phase("prepare");
+    metrics.keys = in.count;
     const double timeout_ms = in.timeout_ms;
     const double t_start = ABT_get_wtime();
     double bulk_timeout;
@@ -59,6 +66,7 @@ void yk_get_ult(hg_handle_t h)
     size_t sizes_to_transfer = in.count*sizeof(size_t);
     if(!in.packed) sizes_to_transfer *= 2;
 
+    trace.phase("bulk_pull");
     bulk_timeout = yk_bulk_timeout_ms(timeout_ms, t_start);
     hret = margo_bulk_transfer_timed(mid, HG_BULK_PULL, origin_addr,
             in.bulk, in.offset, buffer->bulk, 0, sizes_to_transfer, bulk_timeout);
@@ -106,6 +114,7 @@ void yk_get_ult(hg_handle_t h)
     }
 
     // transfer the actual keys from the client
+    trace.phase("bulk_pull");
     bulk_timeout = yk_bulk_timeout_ms(timeout_ms, t_start);
     hret = margo_bulk_transfer_timed(mid, HG_BULK_PULL, origin_addr,
             in.bulk, in.offset + keys_offset,
@@ -119,10 +128,14 @@ void yk_get_ult(hg_handle_t h)
     size_t remaining_vsize = in.size - vals_offset;
     auto vals = yokan::UserMem{ ptr + vals_offset, remaining_vsize };
 
+    trace.phase("backend");
     out.ret = static_cast<yk_return_t>(
             database->get(in.mode, in.packed, keys, ksizes, vals, vsizes));
+    metrics.bytes_in  = total_ksize;
+    metrics.bytes_out = vals.size;
 
     if(out.ret == YOKAN_SUCCESS) {
+        trace.phase("bulk_push");
         // transfer the vsizes and values back the client
         // this is done using two concurrent bulk transfers
         margo_request req = MARGO_REQUEST_NULL;
@@ -163,9 +176,10 @@ void yk_get_direct_ult(hg_handle_t h)
     std::vector<size_t> vsizes;
 
     out.ret = YOKAN_SUCCESS;
+    yokan::RPCTrace trace;
 
     DEFER(margo_destroy(h));
-    DEFER(margo_respond(h, &out));
+    DEFER(trace.phase("respond"); margo_respond(h, &out));
 
     margo_instance_id mid = margo_hg_handle_get_instance(h);
     CHECK_MID(mid, margo_hg_handle_get_instance);
@@ -173,9 +187,16 @@ void yk_get_direct_ult(hg_handle_t h)
     const struct hg_info* info = margo_get_info(h);
     yk_provider_t provider = (yk_provider_t)margo_registered_data(mid, info->id);
     CHECK_PROVIDER(provider);
+    yokan::RPCMetricsScope metrics{
+        provider->metrics.get(), yokan::RPCType::GET_DIRECT, out.ret};
+    trace.start(provider->tracer.get(), yokan::RPCType::GET_DIRECT);
 
     hret = margo_get_input(h, &in);
     CHECK_HRET_OUT(hret, margo_get_input);
+    trace.setTraceId(in.trace_id);
+    trace.phase("prepare");
+    metrics.keys     = in.ksizes.count;
+    metrics.bytes_in = in.keys.size;
     const double timeout_ms = in.timeout_ms;
     (void)timeout_ms;
     const double t_start = ABT_get_wtime();
@@ -211,6 +232,7 @@ void yk_get_direct_ult(hg_handle_t h)
     auto values_umem = yokan::UserMem{
         values.data(), values.size() };
 
+    trace.phase("backend");
     out.ret = static_cast<yk_return_t>(
             database->get(in.mode, true, keys_umem,
                           ksizes_umem, values_umem, vsizes_umem));
@@ -220,6 +242,149 @@ void yk_get_direct_ult(hg_handle_t h)
         out.vsizes.count = count;
         out.vals.data = values.data();
         out.vals.size = values_umem.size;
+        metrics.bytes_out = values_umem.size;
     }
 }
 DEFINE_MARGO_RPC_HANDLER(yk_get_direct_ult)
+
+void yk_get_alloc_ult(hg_handle_t h)
+{
+    hg_return_t hret;
+    get_alloc_in_t in;
+    get_alloc_out_t out;
+
+    std::memset(&in, 0, sizeof(in));
+    std::memset(&out, 0, sizeof(out));
+
+    std::vector<char> values;
+    std::vector<size_t> vsizes;
+
+    out.ret = YOKAN_SUCCESS;
+    out.bulk = HG_BULK_NULL;
+    yokan::RPCTrace trace;
+
+    DEFER(margo_destroy(h));
+    DEFER(trace.phase("respond"); margo_respond(h, &out));
+
+    margo_instance_id mid = margo_hg_handle_get_instance(h);
+    CHECK_MID(mid, margo_hg_handle_get_instance);
+
+    const struct hg_info* info = margo_get_info(h);
+    yk_provider_t provider = (yk_provider_t)margo_registered_data(mid, info->id);
+    CHECK_PROVIDER(provider);
+    yokan::RPCMetricsScope metrics{
+        provider->metrics.get(), yokan::RPCType::GET_ALLOC, out.ret};
+    trace.start(provider->tracer.get(), yokan::RPCType::GET_ALLOC);
+
+    hret = margo_get_input(h, &in);
+    CHECK_HRET_OUT(hret, margo_get_input);
+    trace.setTraceId(in.trace_id);
+    trace.phase("prepare");
+    metrics.keys     = in.ksizes.count;
+    metrics.bytes_in = in.keys.size;
+    DEFER(margo_free_input(h, &in));
+
+    yk_database* database = provider->db;
+    CHECK_DATABASE(database);
+    CHECK_MODE_SUPPORTED(database, in.mode);
+
+    auto count = in.ksizes.count;
+    auto ksizes_umem = yokan::BasicUserMem<size_t>{
+        in.ksizes.sizes, count };
+    auto keys_umem = yokan::UserMem{
+        in.keys.data, in.keys.size };
+
+    // check that there is no key of size 0
+    auto min_key_size = std::accumulate(in.ksizes.sizes, in.ksizes.sizes + count,
+                                        std::numeric_limits<size_t>::max(),
+                                        [](const size_t& lhs, const size_t& rhs) {
+                                            return std::min(lhs, rhs);
+                                        });
+    if(min_key_size == 0) {
+        out.ret = YOKAN_ERR_INVALID_ARGS;
+        return;
+    }
+
+    vsizes.reserve(count);
+    auto fetcher = [&values, &vsizes](const yokan::UserMem& key, const yokan::UserMem& val) -> yokan::Status {
+        (void)key;
+        vsizes.push_back(val.size);
+        if(val.size != YOKAN_KEY_NOT_FOUND)
+            values.insert(values.end(), val.data, val.data + val.size);
+        return yokan::Status::OK;
+    };
+
+    trace.phase("backend");
+    out.ret = static_cast<yk_return_t>(
+            database->fetch(in.mode, keys_umem, ksizes_umem, fetcher));
+    if(out.ret != YOKAN_SUCCESS)
+        return;
+
+    out.vsizes.sizes = vsizes.data();
+    out.vsizes.count = vsizes.size();
+    metrics.bytes_out = values.size();
+
+    if(values.size() <= in.inline_threshold) {
+        out.vals.data = values.data();
+        out.vals.size = values.size();
+        return;
+    }
+
+    // the values are too large to be sent inline: copy them into a buffer
+    // that the client will pull from, and keep it until the client
+    // releases it or its lease expires
+    trace.phase("prepare_bulk");
+    yk_buffer_t buffer = provider->bulk_cache.get(
+        provider->bulk_cache_data, values.size(), HG_BULK_READ_ONLY);
+    CHECK_BUFFER(buffer);
+    std::memcpy(buffer->data, values.data(), values.size());
+
+    const double now = ABT_get_wtime();
+    std::vector<yk_buffer_t> expired;
+    ABT_mutex_lock(provider->get_alloc_mtx);
+    auto& leases = provider->get_alloc_leases;
+    while(!leases.empty() && leases.begin()->second.second < now) {
+        expired.push_back(leases.begin()->second.first);
+        leases.erase(leases.begin());
+    }
+    out.lease = provider->get_alloc_next_lease++;
+    leases.emplace(out.lease, std::make_pair(buffer, now + YK_GET_ALLOC_LEASE_SEC));
+    ABT_mutex_unlock(provider->get_alloc_mtx);
+    for(auto b : expired)
+        provider->bulk_cache.release(provider->bulk_cache_data, b);
+
+    out.bulk = buffer->bulk;
+}
+DEFINE_MARGO_RPC_HANDLER(yk_get_alloc_ult)
+
+void yk_get_alloc_release_ult(hg_handle_t h)
+{
+    hg_return_t hret;
+    get_alloc_release_in_t in;
+
+    DEFER(margo_destroy(h));
+
+    margo_instance_id mid = margo_hg_handle_get_instance(h);
+    if(!mid) return;
+
+    const struct hg_info* info = margo_get_info(h);
+    yk_provider_t provider = (yk_provider_t)margo_registered_data(mid, info->id);
+    if(!provider) return;
+
+    hret = margo_get_input(h, &in);
+    if(hret != HG_SUCCESS) return;
+    uint64_t lease = in.lease;
+    margo_free_input(h, &in);
+
+    yk_buffer_t buffer = nullptr;
+    ABT_mutex_lock(provider->get_alloc_mtx);
+    auto it = provider->get_alloc_leases.find(lease);
+    if(it != provider->get_alloc_leases.end()) {
+        buffer = it->second.first;
+        provider->get_alloc_leases.erase(it);
+    }
+    ABT_mutex_unlock(provider->get_alloc_mtx);
+    if(buffer)
+        provider->bulk_cache.release(provider->bulk_cache_data, buffer);
+}
+DEFINE_MARGO_RPC_HANDLER(yk_get_alloc_release_ult)
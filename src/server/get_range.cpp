@@ -0,0 +1,105 @@
+/*
+ * (C) 2026 The University of Chicago
+ *
+ * See COPYRIGHT in top-level directory.
+ */
+#include "yokan/server.h"
+#include "provider.hpp"
+#include "../common/types.h"
+#include "../common/defer.hpp"
+#include "../common/logging.h"
+#include "../common/checks.h"
+#include "../common/bulk_timeout.h"
+#include <cstring>
+#include <vector>
+
+void yk_get_range_ult(hg_handle_t h)
+{
+    hg_return_t hret;
+    get_range_in_t in;
+    get_range_out_t out;
+    hg_addr_t origin_addr = HG_ADDR_NULL;
+
+    std::memset(&in, 0, sizeof(in));
+    std::memset(&out, 0, sizeof(out));
+
+    // holds the data sent back inline, until the response is sent
+    std::vector<char> data;
+
+    out.ret = YOKAN_SUCCESS;
+    yokan::RPCTrace trace;
+
+    DEFER(margo_destroy(h));
+    DEFER(trace.phase("respond"); margo_respond(h, &out));
+
+    margo_instance_id mid = margo_hg_handle_get_instance(h);
+    CHECK_MID(mid, margo_hg_handle_get_instance);
+
+    const struct hg_info* info = margo_get_info(h);
+    yk_provider_t provider = (yk_provider_t)margo_registered_data(mid, info->id);
+    CHECK_PROVIDER(provider);
+    yokan::RPCMetricsScope metrics{
+        provider->metrics.get(), yokan::RPCType::GET_RANGE, out.ret};
+    trace.start(provider->tracer.get(), yokan::RPCType::GET_RANGE);
+
+    hret = margo_get_input(h, &in);
+    CHECK_HRET_OUT(hret, margo_get_input);
+    trace.setTraceId(in.trace_id);
+    trace.phase("prepare");
+    metrics.keys     = 1;
+    metrics.bytes_in = in.key.size;
+    const double timeout_ms = in.timeout_ms;
+    const double t_start = ABT_get_wtime();
+    double bulk_timeout;
+    DEFER(margo_free_input(h, &in));
+
+    if(in.key.size == 0) {
+        out.ret = YOKAN_ERR_INVALID_ARGS;
+        return;
+    }
+
+    yk_database* database = provider->db;
+    CHECK_DATABASE(database);
+    CHECK_MODE_SUPPORTED(database, in.mode);
+
+    auto key = yokan::UserMem{ in.key.data, in.key.size };
+
+    if(in.bulk == HG_BULK_NULL) {
+        data.resize(in.size);
+        auto range = yokan::UserMem{ data.data(), data.size() };
+        trace.phase("backend");
+        out.ret = static_cast<yk_return_t>(
+                database->getRange(in.mode, key, in.offset, range));
+        if(out.ret != YOKAN_SUCCESS) return;
+        out.size      = range.size;
+        out.data.data = data.data();
+        out.data.size = range.size;
+        metrics.bytes_out = range.size;
+        return;
+    }
+
+    hret = yk_provider_resolve_addr(provider, h, in.origin, &origin_addr);
+    CHECK_HRET_OUT(hret, yk_provider_resolve_addr);
+
+    yk_buffer_t buffer = provider->bulk_cache.get(
+        provider->bulk_cache_data, in.size, HG_BULK_READ_ONLY);
+    CHECK_BUFFER(buffer);
+    DEFER(provider->bulk_cache.release(provider->bulk_cache_data, buffer));
+
+    auto range = yokan::UserMem{ buffer->data, in.size };
+    trace.phase("backend");
+    out.ret = static_cast<yk_return_t>(
+            database->getRange(in.mode, key, in.offset, range));
+    if(out.ret != YOKAN_SUCCESS) return;
+    out.size = range.size;
+    metrics.bytes_out = range.size;
+
+    if(range.size != 0) {
+        trace.phase("bulk_push");
+        bulk_timeout = yk_bulk_timeout_ms(timeout_ms, t_start);
+        hret = margo_bulk_transfer_timed(mid, HG_BULK_PUSH, origin_addr,
+                in.bulk, 0, buffer->bulk, 0, range.size, bulk_timeout);
+        CHECK_HRET_OUT(hret, margo_bulk_transfer_timed);
+    }
+}
+DEFINE_MARGO_RPC_HANDLER(yk_get_range_ult)
@@ -27,6 +27,8 @@ void yk_get_remi_provider_id_ult(hg_handle_t h)
     const struct hg_info* info = margo_get_info(h);
     yk_provider_t provider = (yk_provider_t)margo_registered_data(mid, info->id);
     CHECK_PROVIDER(provider);
+    yokan::RPCMetricsScope metrics{
+        provider->metrics.get(), yokan::RPCType::GET_REMI_PROVIDER_ID, out.ret};
 
 #ifdef YOKAN_HAS_REMI
     if(provider->remi.provider) {
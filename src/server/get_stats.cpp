@@ -0,0 +1,41 @@
+/*
+ * (C) 2026 The University of Chicago
+ *
+ * See COPYRIGHT in top-level directory.
+ */
+#include "yokan/server.h"
+#include "provider.hpp"
+#include "../common/types.h"
+#include "../common/defer.hpp"
+#include "../common/logging.h"
+#include "../common/checks.h"
+#include <string>
+
+void yk_get_stats_ult(hg_handle_t h)
+{
+    hg_return_t hret;
+    get_stats_in_t in;
+    get_stats_out_t out;
+    std::string stats;
+
+    out.ret   = YOKAN_SUCCESS;
+    out.stats = nullptr;
+
+    DEFER(margo_destroy(h));
+    DEFER(margo_respond(h, &out));
+
+    margo_instance_id mid = margo_hg_handle_get_instance(h);
+    CHECK_MID(mid, margo_hg_handle_get_instance);
+
+    const struct hg_info* info = margo_get_info(h);
+    yk_provider_t provider = (yk_provider_t)margo_registered_data(mid, info->id);
+    CHECK_PROVIDER(provider);
+
+    hret = margo_get_input(h, &in);
+    CHECK_HRET_OUT(hret, margo_get_input);
+    DEFER(margo_free_input(h, &in));
+
+    stats = yk_provider_collect_stats(provider, in.reset).dump();
+    out.stats = const_cast<char*>(stats.c_str());
+}
+DEFINE_MARGO_RPC_HANDLER(yk_get_stats_ult)
@@ -20,9 +20,10 @@ void yk_length_ult(hg_handle_t h)
     hg_addr_t origin_addr = HG_ADDR_NULL;
 
     out.ret = YOKAN_SUCCESS;
+    yokan::RPCTrace trace;
 
     DEFER(margo_destroy(h));
-    DEFER(margo_respond(h, &out));
+    DEFER(trace.phase("respond"); margo_respond(h, &out));
 
     margo_instance_id mid = margo_hg_handle_get_instance(h);
     CHECK_MID(mid, margo_hg_handle_get_instance);
@@ -30,9 +31,15 @@ void yk_length_ult(hg_handle_t h)
     const struct hg_info* info = margo_get_info(h);
     yk_provider_t provider = (yk_provider_t)margo_registered_data(mid, info->id);
     CHECK_PROVIDER(provider);
+    yokan::RPCMetricsScope metrics{
+        provider->metrics.get(), yokan::RPCType::LENGTH, out.ret};
+    trace.start(provider->tracer.get(), yokan::RPCType::LENGTH);
 
     hret = margo_get_input(h, &in);
     CHECK_HRET_OUT(hret, margo_get_input);
+    trace.setTraceId(in.trace_id);
+    trace.phase("prepare");
+    metrics.keys = in.count;
     const double timeout_ms = in.timeout_ms;
     const double t_start = ABT_get_wtime();
     double bulk_timeout;
@@ -56,6 +63,7 @@ void yk_length_ult(hg_handle_t h)
     // transfer ksizes
     size_t sizes_to_transfer = in.count*sizeof(size_t);
 
+    trace.phase("bulk_pull");
     bulk_timeout = yk_bulk_timeout_ms(timeout_ms, t_start);
     hret = margo_bulk_transfer_timed(mid, HG_BULK_PULL, origin_addr,
             in.bulk, in.offset, buffer->bulk, 0, sizes_to_transfer, bulk_timeout);
@@ -89,6 +97,7 @@ void yk_length_ult(hg_handle_t h)
     }
 
     // transfer the actual keys from the client
+    trace.phase("bulk_pull");
     bulk_timeout = yk_bulk_timeout_ms(timeout_ms, t_start);
     hret = margo_bulk_transfer_timed(mid, HG_BULK_PULL, origin_addr,
             in.bulk, in.offset + keys_offset,
@@ -104,10 +113,12 @@ void yk_length_ult(hg_handle_t h)
         in.count
     };
 
+    trace.phase("backend");
     out.ret = static_cast<yk_return_t>(
             database->length(in.mode, keys, ksizes, vsizes));
 
     if(out.ret == YOKAN_SUCCESS) {
+        trace.phase("bulk_push");
         // transfer the vsizes back the client
         bulk_timeout = yk_bulk_timeout_ms(timeout_ms, t_start);
         hret = margo_bulk_transfer_timed(mid, HG_BULK_PUSH, origin_addr,
@@ -134,9 +145,10 @@ void yk_length_direct_ult(hg_handle_t h)
     out.sizes.sizes = nullptr;
     out.sizes.count = 0;
     out.ret = YOKAN_SUCCESS;
+    yokan::RPCTrace trace;
 
     DEFER(margo_destroy(h));
-    DEFER(margo_respond(h, &out));
+    DEFER(trace.phase("respond"); margo_respond(h, &out));
 
     margo_instance_id mid = margo_hg_handle_get_instance(h);
     CHECK_MID(mid, margo_hg_handle_get_instance);
@@ -144,9 +156,16 @@ void yk_length_direct_ult(hg_handle_t h)
     const struct hg_info* info = margo_get_info(h);
     yk_provider_t provider = (yk_provider_t)margo_registered_data(mid, info->id);
     CHECK_PROVIDER(provider);
+    yokan::RPCMetricsScope metrics{
+        provider->metrics.get(), yokan::RPCType::LENGTH_DIRECT, out.ret};
+    trace.start(provider->tracer.get(), yokan::RPCType::LENGTH_DIRECT);
 
     hret = margo_get_input(h, &in);
     CHECK_HRET_OUT(hret, margo_get_input);
+    trace.setTraceId(in.trace_id);
+    trace.phase("prepare");
+    metrics.keys     = in.ksizes.count;
+    metrics.bytes_in = in.keys.size;
     const double timeout_ms = in.timeout_ms;
     (void)timeout_ms;
     const double t_start = ABT_get_wtime();
@@ -180,6 +199,7 @@ void yk_length_direct_ult(hg_handle_t h)
     // create memory wrapper for value sizes
     auto vsizes = yokan::BasicUserMem<size_t>{ vsizes_vec };
 
+    trace.phase("backend");
     out.ret = static_cast<yk_return_t>(
             database->length(in.mode, keys, ksizes, vsizes));
 }
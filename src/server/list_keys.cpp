@@ -31,6 +31,8 @@ void yk_list_keys_ult(hg_handle_t h)
     const struct hg_info* info = margo_get_info(h);
     yk_provider_t provider = (yk_provider_t)margo_registered_data(mid, info->id);
     CHECK_PROVIDER(provider);
+    yokan::RPCMetricsScope metrics{
+        provider->metrics.get(), yokan::RPCType::LIST_KEYS, out.ret};
 
     hret = margo_get_input(h, &in);
     CHECK_HRET_OUT(hret, margo_get_input);
@@ -89,6 +91,8 @@ void yk_list_keys_ult(hg_handle_t h)
             database->listKeys(in.mode, in.packed, from_key, filter, keys, ksizes));
 
     if(out.ret == YOKAN_SUCCESS) {
+        metrics.keys      = in.count;
+        metrics.bytes_out = keys.size;
         size_to_transfer = in.count*sizeof(size_t)
                          + keys.size;
         bulk_timeout = yk_bulk_timeout_ms(timeout_ms, t_start);
@@ -121,6 +125,8 @@ void yk_list_keys_direct_ult(hg_handle_t h)
     const struct hg_info* info = margo_get_info(h);
     yk_provider_t provider = (yk_provider_t)margo_registered_data(mid, info->id);
     CHECK_PROVIDER(provider);
+    yokan::RPCMetricsScope metrics{
+        provider->metrics.get(), yokan::RPCType::LIST_KEYS_DIRECT, out.ret};
 
     hret = margo_get_input(h, &in);
     CHECK_HRET_OUT(hret, margo_get_input);
@@ -157,6 +163,8 @@ void yk_list_keys_direct_ult(hg_handle_t h)
         out.ksizes.count = in.count;
         out.keys.data    = keys.data();
         out.keys.size    = keys_umem.size;
+        metrics.keys      = in.count;
+        metrics.bytes_out = keys_umem.size;
     }
 }
 DEFINE_MARGO_RPC_HANDLER(yk_list_keys_direct_ult)
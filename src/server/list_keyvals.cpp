@@ -31,6 +31,8 @@ void yk_list_keyvals_ult(hg_handle_t h)
     const struct hg_info* info = margo_get_info(h);
     yk_provider_t provider = (yk_provider_t)margo_registered_data(mid, info->id);
     CHECK_PROVIDER(provider);
+    yokan::RPCMetricsScope metrics{
+        provider->metrics.get(), yokan::RPCType::LIST_KEYVALS, out.ret};
 
     hret = margo_get_input(h, &in);
     CHECK_HRET_OUT(hret, margo_get_input);
@@ -103,6 +105,8 @@ void yk_list_keyvals_ult(hg_handle_t h)
         // push ksizes + vsizes + actually-filled keys region (async); the
         // unused tail of the keys region separates it from vals, so the
         // vals region must be a second transfer
+        metrics.keys      = in.count;
+        metrics.bytes_out = keys.size + vals.size;
         margo_request req = MARGO_REQUEST_NULL;
         size_to_transfer = 2*in.count*sizeof(size_t) + keys.size;
         bulk_timeout = yk_bulk_timeout_ms(timeout_ms, t_start);
@@ -149,6 +153,8 @@ void yk_list_keyvals_direct_ult(hg_handle_t h)
     const struct hg_info* info = margo_get_info(h);
     yk_provider_t provider = (yk_provider_t)margo_registered_data(mid, info->id);
     CHECK_PROVIDER(provider);
+    yokan::RPCMetricsScope metrics{
+        provider->metrics.get(), yokan::RPCType::LIST_KEYVALS_DIRECT, out.ret};
 
     hret = margo_get_input(h, &in);
     CHECK_HRET_OUT(hret, margo_get_input);
@@ -194,6 +200,8 @@ void yk_list_keyvals_direct_ult(hg_handle_t h)
         out.vsizes.count = in.count;
         out.vals.data    = vals.data();
         out.vals.size    = vals_umem.size;
+        metrics.keys      = in.count;
+        metrics.bytes_out = keys_umem.size + vals_umem.size;
     }
 }
 DEFINE_MARGO_RPC_HANDLER(yk_list_keyvals_direct_ult)
@@ -0,0 +1,194 @@
+/*
+ * (C) 2026 The University of Chicago
+ *
+ * See COPYRIGHT in top-level directory.
+ */
+#include "yokan/util/lock-profiler.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <mutex>
+
+namespace yokan {
+
+using json = nlohmann::json;
+
+/* The registry is an open-addressing hash table indexed by lock handle,
+ * with linear probing. Lookups (done on every acquisition of a lock) are
+ * lock-free; insertions and removals are serialized by a mutex. Removals
+ * shift the following entries of the probe sequence back instead of
+ * leaving tombstones, so lookups of unregistered locks stop at the first
+ * empty slot even after many databases have come and gone. A lookup that
+ * races with such a shift may miss the entry, in which case that
+ * acquisition is simply not profiled. If the table is full, new locks
+ * are not profiled.
+ */
+static constexpr size_t RegistrySize = 4096;
+
+struct RegistryEntry {
+    std::atomic<ABT_rwlock>   lock{ABT_RWLOCK_NULL};
+    std::atomic<LockProfile*> profile{nullptr};
+};
+
+static RegistryEntry s_registry[RegistrySize];
+static std::mutex    s_registry_mtx;
+
+static size_t registry_hash(ABT_rwlock lock) {
+    auto h = reinterpret_cast<uintptr_t>(lock);
+    h ^= h >> 17;
+    h *= 0xed5ad4bbu;
+    h ^= h >> 11;
+    return h % RegistrySize;
+}
+
+void LockProfiler::add(ABT_rwlock lock, const DatabaseInterface* owner, std::string name) {
+    if(lock == ABT_RWLOCK_NULL) return;
+    std::lock_guard<std::mutex> guard{s_registry_mtx};
+    RegistryEntry* target = nullptr;
+    auto h = registry_hash(lock);
+    for(size_t i = 0; i < RegistrySize; i++) {
+        auto& entry = s_registry[(h + i) % RegistrySize];
+        auto key = entry.lock.load(std::memory_order_relaxed);
+        if(key == lock || key == ABT_RWLOCK_NULL) {
+            target = &entry;
+            break;
+        }
+    }
+    if(!target) return;
+    auto profile = new LockProfile{owner, std::move(name)};
+    delete target->profile.exchange(nullptr, std::memory_order_acq_rel);
+    target->lock.store(lock, std::memory_order_release);
+    target->profile.store(profile, std::memory_order_release);
+}
+
+void LockProfiler::remove(ABT_rwlock lock) {
+    if(lock == ABT_RWLOCK_NULL) return;
+    std::lock_guard<std::mutex> guard{s_registry_mtx};
+    auto h = registry_hash(lock);
+    size_t hole = RegistrySize;
+    for(size_t i = 0; i < RegistrySize; i++) {
+        auto index = (h + i) % RegistrySize;
+        auto key = s_registry[index].lock.load(std::memory_order_relaxed);
+        if(key == ABT_RWLOCK_NULL) return;
+        if(key == lock) {
+            hole = index;
+            break;
+        }
+    }
+    if(hole == RegistrySize) return;
+    auto& removed = s_registry[hole];
+    removed.lock.store(ABT_RWLOCK_NULL, std::memory_order_release);
+    delete removed.profile.exchange(nullptr, std::memory_order_acq_rel);
+    // move back the entries that would no longer be reachable from
+    // their home slot because of the hole
+    for(size_t j = (hole + 1) % RegistrySize; j != hole; j = (j + 1) % RegistrySize) {
+        auto& entry = s_registry[j];
+        auto key = entry.lock.load(std::memory_order_relaxed);
+        if(key == ABT_RWLOCK_NULL) break;
+        auto home = registry_hash(key);
+        bool reachable = (hole < j) ? (hole < home && home <= j)
+                                    : (hole < home || home <= j);
+        if(reachable) continue;
+        auto& dest = s_registry[hole];
+        dest.profile.store(entry.profile.load(std::memory_order_relaxed),
+                           std::memory_order_release);
+        dest.lock.store(key, std::memory_order_release);
+        entry.lock.store(ABT_RWLOCK_NULL, std::memory_order_release);
+        entry.profile.store(nullptr, std::memory_order_release);
+        hole = j;
+    }
+}
+
+LockProfile* LockProfiler::find(ABT_rwlock lock) {
+    auto h = registry_hash(lock);
+    for(size_t i = 0; i < RegistrySize; i++) {
+        auto& entry = s_registry[(h + i) % RegistrySize];
+        auto key = entry.lock.load(std::memory_order_acquire);
+        if(key == ABT_RWLOCK_NULL) return nullptr;
+        if(key == lock) return entry.profile.load(std::memory_order_acquire);
+    }
+    return nullptr;
+}
+
+static json histogram_to_json(std::atomic<uint64_t>* histogram,
+                              uint64_t sum, uint64_t max, bool reset) {
+    constexpr auto relaxed = std::memory_order_relaxed;
+    uint64_t counts[LockProfile::NumBuckets];
+    uint64_t total = 0;
+    for(unsigned i = 0; i < LockProfile::NumBuckets; i++) {
+        counts[i] = reset ? histogram[i].exchange(0, relaxed)
+                          : histogram[i].load(relaxed);
+        total += counts[i];
+    }
+    // percentiles are reported as the upper bound of their bucket,
+    // clamped to the observed max
+    auto percentile = [&](double p) -> double {
+        if(total == 0) return 0.0;
+        uint64_t rank = static_cast<uint64_t>(p*total);
+        if(rank >= total) rank = total - 1;
+        uint64_t seen = 0;
+        for(unsigned i = 0; i < LockProfile::NumBuckets; i++) {
+            seen += counts[i];
+            if(seen <= rank) continue;
+            uint64_t upper = (i < 63) ? (2ull << i) : UINT64_MAX;
+            return std::min(upper, max)/1e3;
+        }
+        return max/1e3;
+    };
+    // the histogram is reported as [upper bound in us, count] pairs,
+    // omitting empty buckets
+    auto buckets = json::array();
+    for(unsigned i = 0; i < LockProfile::NumBuckets; i++) {
+        if(counts[i] == 0) continue;
+        buckets.push_back(json::array({(2ull << i)/1e3, counts[i]}));
+    }
+    return json{
+        {"avg",       total ? (sum/1e3)/total : 0.0},
+        {"max",       max/1e3},
+        {"p50",       percentile(0.50)},
+        {"p99",       percentile(0.99)},
+        {"histogram", buckets}
+    };
+}
+
+std::string LockProfiler::toJSON(const DatabaseInterface* owner, bool reset) {
+    constexpr auto relaxed = std::memory_order_relaxed;
+    auto result = json::object();
+    std::lock_guard<std::mutex> guard{s_registry_mtx};
+    for(auto& entry : s_registry) {
+        auto p = entry.profile.load(std::memory_order_acquire);
+        if(!p || p->owner != owner) continue;
+        auto read = reset ? p->read_acquisitions.exchange(0, relaxed)
+                          : p->read_acquisitions.load(relaxed);
+        auto write = reset ? p->write_acquisitions.exchange(0, relaxed)
+                           : p->write_acquisitions.load(relaxed);
+        auto contended = reset ? p->contended.exchange(0, relaxed)
+                               : p->contended.load(relaxed);
+        auto waiters_sum = reset ? p->waiters_sum.exchange(0, relaxed)
+                                 : p->waiters_sum.load(relaxed);
+        auto waiters_max = reset ? p->waiters_max.exchange(0, relaxed)
+                                 : p->waiters_max.load(relaxed);
+        auto wait_sum = reset ? p->wait_sum.exchange(0, relaxed)
+                              : p->wait_sum.load(relaxed);
+        auto wait_max = reset ? p->wait_max.exchange(0, relaxed)
+                              : p->wait_max.load(relaxed);
+        auto hold_sum = reset ? p->hold_sum.exchange(0, relaxed)
+                              : p->hold_sum.load(relaxed);
+        auto hold_max = reset ? p->hold_max.exchange(0, relaxed)
+                              : p->hold_max.load(relaxed);
+        auto acquisitions = read + write;
+        result[p->name] = json{
+            {"read_acquisitions",  read},
+            {"write_acquisitions", write},
+            {"contended",          contended},
+            {"waiters", {
+                {"avg", acquisitions ? static_cast<double>(waiters_sum)/acquisitions : 0.0},
+                {"max", waiters_max}
+            }},
+            {"wait_us", histogram_to_json(p->wait_histogram, wait_sum, wait_max, reset)},
+            {"hold_us", histogram_to_json(p->hold_histogram, hold_sum, hold_max, reset)}
+        };
+    }
+    return result.dump();
+}
+
+}
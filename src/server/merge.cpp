@@ -0,0 +1,82 @@
+/*
+ * (C) 2026 The University of Chicago
+ *
+ * See COPYRIGHT in top-level directory.
+ */
+#include "yokan/server.h"
+#include "provider.hpp"
+#include "../common/types.h"
+#include "../common/defer.hpp"
+#include "../common/logging.h"
+#include "../common/checks.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+void yk_merge_ult(hg_handle_t h)
+{
+    hg_return_t hret;
+    merge_in_t in;
+    merge_out_t out;
+
+    std::memset(&in, 0, sizeof(in));
+    std::memset(&out, 0, sizeof(out));
+
+    // holds the new value sent back inline, until the response is sent
+    std::vector<char> data;
+
+    out.ret = YOKAN_SUCCESS;
+    yokan::RPCTrace trace;
+
+    DEFER(margo_destroy(h));
+    DEFER(trace.phase("respond"); margo_respond(h, &out));
+
+    margo_instance_id mid = margo_hg_handle_get_instance(h);
+    CHECK_MID(mid, margo_hg_handle_get_instance);
+
+    const struct hg_info* info = margo_get_info(h);
+    yk_provider_t provider = (yk_provider_t)margo_registered_data(mid, info->id);
+    CHECK_PROVIDER(provider);
+    yokan::RPCMetricsScope metrics{
+        provider->metrics.get(), yokan::RPCType::MERGE, out.ret};
+    trace.start(provider->tracer.get(), yokan::RPCType::MERGE);
+
+    hret = margo_get_input(h, &in);
+    CHECK_HRET_OUT(hret, margo_get_input);
+    trace.setTraceId(in.trace_id);
+    trace.phase("prepare");
+    metrics.keys     = 1;
+    metrics.bytes_in = in.key.size + in.operand.size;
+    DEFER(margo_free_input(h, &in));
+
+    if(in.key.size == 0) {
+        out.ret = YOKAN_ERR_INVALID_ARGS;
+        return;
+    }
+
+    yk_database* database = provider->db;
+    CHECK_DATABASE(database);
+    CHECK_MODE_SUPPORTED(database, in.mode);
+
+    auto key     = yokan::UserMem{ in.key.data, in.key.size };
+    auto operand = yokan::UserMem{ in.operand.data, in.operand.size };
+
+    // only keep as much of the new value as the client can receive,
+    // rather than allocating in.rsize bytes up front
+    yk_database::MergeCallback func;
+    if(in.rsize) {
+        func = [&](const yokan::UserMem& val) {
+            data.assign(val.data, val.data + std::min<size_t>(in.rsize, val.size));
+            out.rsize = val.size;
+        };
+    }
+
+    trace.phase("backend");
+    out.ret = static_cast<yk_return_t>(
+            database->merge(in.mode, key, in.op, operand, in.bound, func));
+    if(out.ret != YOKAN_SUCCESS || in.rsize == 0) return;
+    out.result.data   = data.data();
+    out.result.size   = data.size();
+    metrics.bytes_out = out.result.size;
+}
+DEFINE_MARGO_RPC_HANDLER(yk_merge_ult)
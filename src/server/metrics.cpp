@@ -0,0 +1,160 @@
+/*
+ * (C) 2026 The University of Chicago
+ *
+ * See COPYRIGHT in top-level directory.
+ */
+#include "metrics.hpp"
+#include <algorithm>
+
+namespace yokan {
+
+using json = nlohmann::json;
+
+static const char* rpc_names[] = {
+#define X(__id__, __name__) __name__,
+    YOKAN_RPC_TYPES
+#undef X
+};
+
+static const char* return_value_names[] = {
+#define X(__err__, __msg__) #__err__,
+    YOKAN_RETURN_VALUES
+#undef X
+};
+
+const char* RPCTypeName(RPCType type) {
+    return rpc_names[static_cast<unsigned>(type)];
+}
+
+Metrics::~Metrics() {
+    for(auto& shard : m_shards)
+        delete shard.load();
+}
+
+Metrics::Shard& Metrics::getShard() {
+    int rank = 0;
+    ABT_self_get_xstream_rank(&rank);
+    auto& slot = m_shards[static_cast<unsigned>(rank) % MaxShards];
+    auto shard = slot.load(std::memory_order_acquire);
+    if(shard) return *shard;
+    auto new_shard = new Shard;
+    if(slot.compare_exchange_strong(shard, new_shard, std::memory_order_acq_rel))
+        return *new_shard;
+    // another ULT installed the shard first
+    delete new_shard;
+    return *shard;
+}
+
+void Metrics::record(RPCType type, double latency, int32_t ret,
+                     uint64_t keys, uint64_t bytes_in, uint64_t bytes_out) {
+    auto& c = getShard().rpcs[static_cast<unsigned>(type)];
+    constexpr auto relaxed = std::memory_order_relaxed;
+    uint64_t ns = latency > 0.0 ? static_cast<uint64_t>(latency*1e9) : 0;
+    c.calls.fetch_add(1, relaxed);
+    c.keys.fetch_add(keys, relaxed);
+    c.bytes_in.fetch_add(bytes_in, relaxed);
+    c.bytes_out.fetch_add(bytes_out, relaxed);
+    c.latency_sum.fetch_add(ns, relaxed);
+    auto min = c.latency_min.load(relaxed);
+    while(ns < min && !c.latency_min.compare_exchange_weak(min, ns, relaxed));
+    auto max = c.latency_max.load(relaxed);
+    while(ns > max && !c.latency_max.compare_exchange_weak(max, ns, relaxed));
+    c.histogram[bucketIndex(ns)].fetch_add(1, relaxed);
+    if(ret != YOKAN_SUCCESS) {
+        auto index = (ret >= 0 && static_cast<unsigned>(ret) < NumReturnValues) ?
+            static_cast<unsigned>(ret) : static_cast<unsigned>(YOKAN_ERR_OTHER);
+        c.errors[index].fetch_add(1, relaxed);
+    }
+}
+
+json Metrics::toJSON() const {
+    constexpr auto relaxed = std::memory_order_relaxed;
+    auto rpcs = json::object();
+    for(unsigned t = 0; t < static_cast<unsigned>(RPCType::NUM_TYPES); t++) {
+        uint64_t calls = 0, keys = 0, bytes_in = 0, bytes_out = 0, latency_sum = 0;
+        uint64_t latency_min = UINT64_MAX, latency_max = 0;
+        uint64_t errors[NumReturnValues] = {};
+        uint64_t histogram[NumBuckets] = {};
+        for(auto& slot : m_shards) {
+            auto shard = slot.load(std::memory_order_acquire);
+            if(!shard) continue;
+            auto& c = shard->rpcs[t];
+            calls       += c.calls.load(relaxed);
+            keys        += c.keys.load(relaxed);
+            bytes_in    += c.bytes_in.load(relaxed);
+            bytes_out   += c.bytes_out.load(relaxed);
+            latency_sum += c.latency_sum.load(relaxed);
+            latency_min  = std::min(latency_min, c.latency_min.load(relaxed));
+            latency_max  = std::max(latency_max, c.latency_max.load(relaxed));
+            for(unsigned i = 0; i < NumReturnValues; i++)
+                errors[i] += c.errors[i].load(relaxed);
+            for(unsigned i = 0; i < NumBuckets; i++)
+                histogram[i] += c.histogram[i].load(relaxed);
+        }
+        if(calls == 0) continue;
+
+        auto error_counts = json::object();
+        for(unsigned i = 0; i < NumReturnValues; i++) {
+            if(errors[i]) error_counts[return_value_names[i]] = errors[i];
+        }
+
+        // percentiles are reported as the middle of their bucket,
+        // clamped to the observed min and max
+        uint64_t total = 0;
+        for(unsigned i = 0; i < NumBuckets; i++) total += histogram[i];
+        auto percentile = [&](double p) -> double {
+            uint64_t rank = static_cast<uint64_t>(p*total);
+            if(rank >= total) rank = total - 1;
+            uint64_t seen = 0;
+            for(unsigned i = 0; i < NumBuckets; i++) {
+                seen += histogram[i];
+                if(seen <= rank) continue;
+                auto lower = bucketLowerBound(i);
+                auto upper = (i + 1 < NumBuckets) ? bucketLowerBound(i+1) : lower;
+                auto mid = lower + (upper - lower)/2;
+                mid = std::max(latency_min, std::min(latency_max, mid));
+                return mid/1e3;
+            }
+            return latency_max/1e3;
+        };
+
+        rpcs[rpc_names[t]] = json{
+            {"calls",     calls},
+            {"keys",      keys},
+            {"bytes_in",  bytes_in},
+            {"bytes_out", bytes_out},
+            {"errors",    error_counts},
+            {"latency_us", {
+                {"min",   latency_min/1e3},
+                {"max",   latency_max/1e3},
+                {"avg",   (latency_sum/1e3)/calls},
+                {"p50",   percentile(0.50)},
+                {"p90",   percentile(0.90)},
+                {"p99",   percentile(0.99)},
+                {"p999",  percentile(0.999)}
+            }}
+        };
+    }
+    return json{{"rpcs", rpcs}};
+}
+
+void Metrics::reset() {
+    constexpr auto relaxed = std::memory_order_relaxed;
+    for(auto& slot : m_shards) {
+        auto shard = slot.load(std::memory_order_acquire);
+        if(!shard) continue;
+        for(auto& c : shard->rpcs) {
+            c.calls.store(0, relaxed);
+            c.keys.store(0, relaxed);
+            c.bytes_in.store(0, relaxed);
+            c.bytes_out.store(0, relaxed);
+            c.latency_sum.store(0, relaxed);
+            c.latency_min.store(UINT64_MAX, relaxed);
+            c.latency_max.store(0, relaxed);
+            for(auto& e : c.errors) e.store(0, relaxed);
+            for(auto& b : c.histogram) b.store(0, relaxed);
+        }
+    }
+}
+
+}
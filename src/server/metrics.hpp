@@ -0,0 +1,223 @@
+/*
+ * (C) 2026 The University of Chicago
+ *
+ * See COPYRIGHT in top-level directory.
+ */
+#ifndef __YOKAN_METRICS_H
+#define __YOKAN_METRICS_H
+
+#include "yokan/common.h"
+#include <nlohmann/json.hpp>
+#include <abt.h>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+
+/**
+ * @brief List of RPC types for which the provider collects metrics,
+ * as (identifier, name) pairs. The name is used in the JSON output.
+ */
+#define YOKAN_RPC_TYPES                                 \
+    X(COUNT,                "count")                    \
+    X(EXISTS,               "exists")                   \
+    X(EXISTS_DIRECT,        "exists_direct")            \
+    X(LENGTH,               "length")                   \
+    X(LENGTH_DIRECT,        "length_direct")            \
+    X(PUT,                  "put")                      \
+    X(PUT_DIRECT,           "put_direct")               \
+    X(GET,                  "get")                      \
+    X(GET_DIRECT,           "get_direct")               \
+    X(GET_ALLOC,            "get_alloc")                \
+    X(GET_RANGE,            "get_range")                \
+    X(PUT_RANGE,            "put_range")                \
+    X(COMPARE_AND_SWAP,     "compare_and_swap")         \
+    X(MERGE,                "merge")                    \
+    X(FETCH,                "fetch")                    \
+    X(FETCH_DIRECT,         "fetch_direct")             \
+    X(ERASE,                "erase")                    \
+    X(ERASE_DIRECT,         "erase_direct")             \
+    X(ERASE_RANGE,          "erase_range")              \
+    X(LIST_KEYS,            "list_keys")                \
+    X(LIST_KEYS_DIRECT,     "list_keys_direct")         \
+    X(LIST_KEYVALS,         "list_keyvals")             \
+    X(LIST_KEYVALS_DIRECT,  "list_keyvals_direct")      \
+    X(ITER,                 "iter")                     \
+    X(ITER_DIRECT,          "iter_direct")              \
+    X(COLL_CREATE,          "coll_create")              \
+    X(COLL_DROP,            "coll_drop")                \
+    X(COLL_EXISTS,          "coll_exists")              \
+    X(COLL_LAST_ID,         "coll_last_id")             \
+    X(COLL_SIZE,            "coll_size")                \
+    X(DOC_ERASE,            "doc_erase")                \
+    X(DOC_LOAD,             "doc_load")                 \
+    X(DOC_LOAD_DIRECT,      "doc_load_direct")          \
+    X(DOC_FETCH,            "doc_fetch")                \
+    X(DOC_STORE,            "doc_store")                \
+    X(DOC_STORE_DIRECT,     "doc_store_direct")         \
+    X(DOC_UPDATE,           "doc_update")               \
+    X(DOC_UPDATE_DIRECT,    "doc_update_direct")        \
+    X(DOC_LENGTH,           "doc_length")               \
+    X(DOC_LIST,             "doc_list")                 \
+    X(DOC_LIST_DIRECT,      "doc_list_direct")          \
+    X(DOC_ITER,             "doc_iter")                 \
+    X(DOC_ITER_DIRECT,      "doc_iter_direct")          \
+    X(GET_REMI_PROVIDER_ID, "get_remi_provider_id")
+
+namespace yokan {
+
+enum class RPCType : unsigned {
+#define X(__id__, __name__) __id__,
+    YOKAN_RPC_TYPES
+#undef X
+    NUM_TYPES
+};
+
+/**
+ * @brief Name of an RPC type, as used in the JSON outputs.
+ */
+const char* RPCTypeName(RPCType type);
+
+/**
+ * @brief The Metrics class collects, for each RPC type, the number of
+ * calls, the number of keys/documents, the bytes received and sent,
+ * the number of occurences of each error code, and an histogram of
+ * latencies.
+ *
+ * The histogram is log-linear (in the style of HDR histograms): each
+ * power of two is divided into 2^SubBucketBits linear sub-buckets, which
+ * bounds the relative error on reported percentiles to about 6%.
+ *
+ * To avoid contention, counters are sharded per execution stream: a ULT
+ * only updates the shard associated with the rank of the execution stream
+ * it runs on. Shards are allocated lazily, the first time an RPC is
+ * recorded from a given execution stream.
+ */
+class Metrics {
+
+    public:
+
+    static constexpr unsigned SubBucketBits = 3;
+    static constexpr unsigned NumBuckets    = 64 << SubBucketBits;
+    static constexpr unsigned MaxShards     = 64;
+
+#define X(__err__, __msg__) +1
+    static constexpr unsigned NumReturnValues = 0 YOKAN_RETURN_VALUES;
+#undef X
+
+    Metrics() = default;
+
+    Metrics(const Metrics&) = delete;
+    Metrics(Metrics&&) = delete;
+
+    ~Metrics();
+
+    /**
+     * @brief Record the completion of an RPC.
+     *
+     * @param type RPC type.
+     * @param latency Latency, in seconds.
+     * @param ret Return code sent back to the client.
+     * @param keys Number of keys (or documents) handled.
+     * @param bytes_in Bytes received from the client.
+     * @param bytes_out Bytes sent to the client.
+     */
+    void record(RPCType type, double latency, int32_t ret,
+                uint64_t keys, uint64_t bytes_in, uint64_t bytes_out);
+
+    /**
+     * @brief Aggregate the counters of all the shards into a JSON object
+     * of the form { "rpcs": { "<name>": { ... }, ... } }. RPC types that
+     * have never been called are omitted.
+     */
+    nlohmann::json toJSON() const;
+
+    /**
+     * @brief Reset all the counters. Records that happen concurrently
+     * may or may not be accounted for.
+     */
+    void reset();
+
+    /**
+     * @brief Index of the histogram bucket corresponding to a latency
+     * expressed in nanoseconds.
+     */
+    static unsigned bucketIndex(uint64_t ns) {
+        if(ns < (1ull << SubBucketBits)) return ns;
+        unsigned e = 63 - __builtin_clzll(ns);
+        unsigned m = (ns >> (e - SubBucketBits)) & ((1u << SubBucketBits) - 1);
+        return ((e - SubBucketBits + 1) << SubBucketBits) + m;
+    }
+
+    /**
+     * @brief Lowest latency (in nanoseconds) that falls in the provided bucket.
+     */
+    static uint64_t bucketLowerBound(unsigned index) {
+        if(index < (1u << SubBucketBits)) return index;
+        unsigned e = (index >> SubBucketBits) + SubBucketBits - 1;
+        uint64_t m = index & ((1u << SubBucketBits) - 1);
+        return (1ull << e) + (m << (e - SubBucketBits));
+    }
+
+    private:
+
+    struct RPCCounters {
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> keys{0};
+        std::atomic<uint64_t> bytes_in{0};
+        std::atomic<uint64_t> bytes_out{0};
+        std::atomic<uint64_t> latency_sum{0};
+        std::atomic<uint64_t> latency_min{UINT64_MAX};
+        std::atomic<uint64_t> latency_max{0};
+        std::atomic<uint64_t> errors[NumReturnValues] = {};
+        std::atomic<uint64_t> histogram[NumBuckets] = {};
+    };
+
+    struct alignas(64) Shard {
+        RPCCounters rpcs[static_cast<unsigned>(RPCType::NUM_TYPES)];
+    };
+
+    Shard& getShard();
+
+    std::atomic<Shard*> m_shards[MaxShards] = {};
+};
+
+/**
+ * @brief Records the metrics of an RPC handler when going out of scope.
+ * The handler should fill the keys, bytes_in, and bytes_out fields
+ * where relevant. The return code is read from the provided reference
+ * (typically out.ret) at destruction time.
+ */
+class RPCMetricsScope {
+
+    public:
+
+    RPCMetricsScope(Metrics* metrics, RPCType type, const int32_t& ret)
+    : m_metrics(metrics)
+    , m_type(type)
+    , m_ret(ret)
+    , m_start(metrics ? ABT_get_wtime() : 0.0) {}
+
+    RPCMetricsScope(const RPCMetricsScope&) = delete;
+    RPCMetricsScope(RPCMetricsScope&&) = delete;
+
+    ~RPCMetricsScope() {
+        if(!m_metrics) return;
+        m_metrics->record(m_type, ABT_get_wtime() - m_start,
+                          m_ret, keys, bytes_in, bytes_out);
+    }
+
+    uint64_t keys      = 0;
+    uint64_t bytes_in  = 0;
+    uint64_t bytes_out = 0;
+
+    private:
+
+    Metrics*       m_metrics;
+    RPCType        m_type;
+    const int32_t& m_ret;
+    double         m_start;
+};
+
+}
+
+#endif
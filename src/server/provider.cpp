@@ -4,6 +4,7 @@
  * See COPYRIGHT in top-level directory.
  */
 #include <iostream>
+#include <fstream>
 #include "config.h"
 #include "yokan/server.h"
 #include "provider.hpp"
@@ -16,6 +17,9 @@
 #include "../buffer/keep_all_bulk_cache.hpp"
 #include "../buffer/lru_bulk_cache.hpp"
 #include <string>
+#ifdef YOKAN_LOCK_PROFILING
+#include "yokan/util/lock-profiler.hpp"
+#endif
 #ifdef YOKAN_HAS_REMI
 #include <remi/remi-client.h>
 #include <remi/remi-server.h>
@@ -103,6 +107,63 @@ yk_return_t yk_provider_register(
         config["buffer_cache"]["type"] = "external";
     }
 
+    // checking metrics field
+    if(not config.contains("metrics")) {
+        config["metrics"] = json::object();
+    }
+    if(not config["metrics"].is_object()) {
+        YOKAN_LOG_ERROR(mid, "\"metrics\" field in configuration is not an object");
+        return YOKAN_ERR_INVALID_CONFIG;
+    }
+    if(not config["metrics"].contains("enabled")) {
+        config["metrics"]["enabled"] = true;
+    }
+    if(not config["metrics"]["enabled"].is_boolean()) {
+        YOKAN_LOG_ERROR(mid, "\"enabled\" field in \"metrics\" should be a boolean");
+        return YOKAN_ERR_INVALID_CONFIG;
+    }
+    // checking tracing field
+    if(not config.contains("tracing")) {
+        config["tracing"] = json::object();
+    }
+    if(not config["tracing"].is_object()) {
+        YOKAN_LOG_ERROR(mid, "\"tracing\" field in configuration is not an object");
+        return YOKAN_ERR_INVALID_CONFIG;
+    }
+    if(not config["tracing"].contains("enabled")) {
+        config["tracing"]["enabled"] = false;
+    }
+    if(not config["tracing"]["enabled"].is_boolean()) {
+        YOKAN_LOG_ERROR(mid, "\"enabled\" field in \"tracing\" should be a boolean");
+        return YOKAN_ERR_INVALID_CONFIG;
+    }
+    if(not config["tracing"].contains("capacity")) {
+        config["tracing"]["capacity"] = 16384;
+    }
+    if(not config["tracing"]["capacity"].is_number_unsigned()
+    || config["tracing"]["capacity"].get<size_t>() == 0) {
+        YOKAN_LOG_ERROR(mid, "\"capacity\" field in \"tracing\" should be a positive integer");
+        return YOKAN_ERR_INVALID_CONFIG;
+    }
+    if(not config["tracing"].contains("output_file")) {
+        config["tracing"]["output_file"] = "";
+    }
+    if(not config["tracing"]["output_file"].is_string()) {
+        YOKAN_LOG_ERROR(mid, "\"output_file\" field in \"tracing\" should be a string");
+        return YOKAN_ERR_INVALID_CONFIG;
+    }
+    // checking max_range_end field
+    if(not config.contains("max_range_end")) {
+        config["max_range_end"] = 1024*1024*1024;
+    }
+    if(not config["max_range_end"].is_number_unsigned()) {
+        YOKAN_LOG_ERROR(mid, "\"max_range_end\" field in configuration should be an unsigned integer");
+        return YOKAN_ERR_INVALID_CONFIG;
+    }
+    // "stats" may be present if the configuration was produced by
+    // a component that appends the provider's statistics to it
+    config.erase("stats");
+
     p = new(std::nothrow) yk_provider;
     if(!p) {
         // LCOV_EXCL_START
@@ -115,7 +176,14 @@ yk_return_t yk_provider_register(
     p->provider_id = provider_id;
     p->pool = a.pool;
     p->config = config;
+    p->max_range_end = config["max_range_end"].get<size_t>();
     ABT_mutex_create(&p->addr_cache_mtx);
+    ABT_mutex_create(&p->get_alloc_mtx);
+    if(config["metrics"]["enabled"].get<bool>())
+        p->metrics = std::make_unique<yokan::Metrics>();
+    if(config["tracing"]["enabled"].get<bool>())
+        p->tracer = std::make_unique<yokan::Tracer>(
+            provider_id, config["tracing"]["capacity"].get<size_t>());
 
     /* REMI client and provider */
 #ifdef YOKAN_HAS_REMI
@@ -221,6 +289,30 @@ yk_return_t yk_provider_register(
     margo_register_data(mid, id, (void*)p, NULL);
     p->erase_range_id = id;
 
+    id = MARGO_REGISTER_PROVIDER(mid, "yk_get_range",
+            get_range_in_t, get_range_out_t,
+            yk_get_range_ult, provider_id, p->pool);
+    margo_register_data(mid, id, (void*)p, NULL);
+    p->get_range_id = id;
+
+    id = MARGO_REGISTER_PROVIDER(mid, "yk_put_range",
+            put_range_in_t, put_range_out_t,
+            yk_put_range_ult, provider_id, p->pool);
+    margo_register_data(mid, id, (void*)p, NULL);
+    p->put_range_id = id;
+
+    id = MARGO_REGISTER_PROVIDER(mid, "yk_compare_and_swap",
+            compare_and_swap_in_t, compare_and_swap_out_t,
+            yk_compare_and_swap_ult, provider_id, p->pool);
+    margo_register_data(mid, id, (void*)p, NULL);
+    p->compare_and_swap_id = id;
+
+    id = MARGO_REGISTER_PROVIDER(mid, "yk_merge",
+            merge_in_t, merge_out_t,
+            yk_merge_ult, provider_id, p->pool);
+    margo_register_data(mid, id, (void*)p, NULL);
+    p->merge_id = id;
+
     id = MARGO_REGISTER_PROVIDER(mid, "yk_get",
             get_in_t, get_out_t,
             yk_get_ult, provider_id, p->pool);
@@ -233,6 +325,19 @@ yk_return_t yk_provider_register(
     margo_register_data(mid, id, (void*)p, NULL);
     p->get_direct_id = id;
 
+    id = MARGO_REGISTER_PROVIDER(mid, "yk_get_alloc",
+            get_alloc_in_t, get_alloc_out_t,
+            yk_get_alloc_ult, provider_id, p->pool);
+    margo_register_data(mid, id, (void*)p, NULL);
+    p->get_alloc_id = id;
+
+    id = MARGO_REGISTER_PROVIDER(mid, "yk_get_alloc_release",
+            get_alloc_release_in_t, void,
+            yk_get_alloc_release_ult, provider_id, p->pool);
+    margo_register_data(mid, id, (void*)p, NULL);
+    margo_registered_disable_response(mid, id, HG_TRUE);
+    p->get_alloc_release_id = id;
+
     id = MARGO_REGISTER_PROVIDER(mid, "yk_fetch",
             fetch_in_t, fetch_out_t,
             yk_fetch_ult, provider_id, p->pool);
@@ -459,6 +564,12 @@ yk_return_t yk_provider_register(
     margo_register_data(mid, id, (void*)p, NULL);
     p->get_remi_provider_id = id;
 
+    id = MARGO_REGISTER_PROVIDER(mid, "yk_get_stats",
+            get_stats_in_t, get_stats_out_t,
+            yk_get_stats_ult, provider_id, p->pool);
+    margo_register_data(mid, id, (void*)p, NULL);
+    p->get_stats_id = id;
+
     margo_provider_push_finalize_callback(mid, p, &yk_finalize_provider, p);
 
     margo_provider_register_identity(mid, provider_id, "yokan");
@@ -483,6 +594,18 @@ static void yk_finalize_provider(void* p)
         delete provider->db;
     }
     YOKAN_LOG_TRACE(mid, "Finalizing YOKAN provider");
+    if(provider->tracer) {
+        auto& output_file = provider->config["tracing"]["output_file"]
+                            .get_ref<const std::string&>();
+        if(!output_file.empty()) {
+            std::ofstream f(output_file);
+            if(f.good())
+                f << provider->tracer->toChromeTrace().dump();
+            else
+                YOKAN_LOG_ERROR(mid, "Could not open trace output file %s",
+                                output_file.c_str());
+        }
+    }
     margo_provider_deregister_identity(provider->mid, provider->provider_id);
     margo_deregister(mid, provider->count_id);
     margo_deregister(mid, provider->exists_id);
@@ -493,11 +616,17 @@ static void yk_finalize_provider(void* p)
     margo_deregister(mid, provider->put_direct_id);
     margo_deregister(mid, provider->get_id);
     margo_deregister(mid, provider->get_direct_id);
+    margo_deregister(mid, provider->get_alloc_id);
+    margo_deregister(mid, provider->get_alloc_release_id);
     margo_deregister(mid, provider->fetch_id);
     margo_deregister(mid, provider->fetch_direct_id);
     margo_deregister(mid, provider->erase_id);
     margo_deregister(mid, provider->erase_direct_id);
     margo_deregister(mid, provider->erase_range_id);
+    margo_deregister(mid, provider->get_range_id);
+    margo_deregister(mid, provider->put_range_id);
+    margo_deregister(mid, provider->compare_and_swap_id);
+    margo_deregister(mid, provider->merge_id);
     margo_deregister(mid, provider->list_keys_id);
     margo_deregister(mid, provider->list_keys_direct_id);
     margo_deregister(mid, provider->list_keyvals_id);
@@ -520,6 +649,11 @@ static void yk_finalize_provider(void* p)
     margo_deregister(mid, provider->doc_list_id);
     margo_deregister(mid, provider->doc_list_direct_id);
     margo_deregister(mid, provider->doc_iter_id);
+    margo_deregister(mid, provider->get_stats_id);
+    for(auto& lease : provider->get_alloc_leases)
+        provider->bulk_cache.release(provider->bulk_cache_data, lease.second.first);
+    provider->get_alloc_leases.clear();
+    ABT_mutex_free(&provider->get_alloc_mtx);
     provider->bulk_cache.finalize(provider->bulk_cache_data);
     for(auto& e : provider->addr_cache)
         margo_addr_free(mid, e.second);
@@ -599,6 +733,48 @@ char* yk_provider_get_config(yk_provider_t provider)
     return strdup(provider->config.dump().c_str());
 }
 
+json yk_provider_collect_stats(yk_provider_t provider, bool reset)
+{
+    auto stats = json::object();
+    if(provider->metrics) {
+        stats = provider->metrics->toJSON();
+        if(reset) provider->metrics->reset();
+    }
+    if(provider->db) {
+        try {
+            stats["backend"] = json::parse(provider->db->stats());
+            stats["backend"]["type"] = provider->db->type();
+        } catch(const std::exception& ex) {
+            YOKAN_LOG_ERROR(provider->mid,
+                "Could not parse statistics returned by backend: %s", ex.what());
+        }
+#ifdef YOKAN_LOCK_PROFILING
+        // lock profiles are keyed by "<backend type>/<lock purpose>"
+        auto locks = json::object();
+        auto profiles = json::parse(yokan::LockProfiler::toJSON(provider->db, reset));
+        for(auto& p : profiles.items())
+            locks[provider->db->type() + "/" + p.key()] = std::move(p.value());
+        stats["locks"] = std::move(locks);
+#endif
+    }
+    return stats;
+}
+
+char* yk_provider_get_stats(yk_provider_t provider, bool reset)
+{
+    auto stats = yk_provider_collect_stats(provider, reset);
+    return strdup(stats.dump().c_str());
+}
+
+char* yk_provider_get_trace(yk_provider_t provider, bool clear)
+{
+    if(!provider->tracer)
+        return strdup("{}");
+    auto trace = provider->tracer->toChromeTrace();
+    if(clear) provider->tracer->clear();
+    return strdup(trace.dump().c_str());
+}
+
 static inline yk_return_t get_remi_provider_id_from_remote(
         yk_provider_t provider,
         hg_addr_t dest_address,
@@ -10,9 +10,12 @@
 #include "yokan/server.h"
 #include "yokan/backend.hpp"
 #include "yokan/bulk-cache.h"
+#include "metrics.hpp"
+#include "tracing.hpp"
 #include <nlohmann/json.hpp>
 #include <margo.h>
 #include <unordered_map>
+#include <map>
 #include <list>
 #include <utility>
 #include <string>
@@ -20,6 +23,10 @@
 
 using json = nlohmann::json;
 
+/* Time after which a buffer held for a yk_get_alloc response is reclaimed
+ * if the client did not release it (e.g. because it died) */
+#define YK_GET_ALLOC_LEASE_SEC 60.0
+
 typedef struct yk_provider {
     /* Margo/Argobots/Mercury environment */
     margo_instance_id  mid;                 // Margo instance
@@ -35,9 +42,24 @@ typedef struct yk_provider {
     std::unordered_map<std::string,
                        std::list<std::pair<std::string, hg_addr_t>>::iterator>           addr_cache_index;
 
+    /* Buffers holding the values of yk_get_alloc responses until the
+     * client pulls them, indexed by lease id, with their expiration time */
+    ABT_mutex                                                   get_alloc_mtx;
+    uint64_t                                                    get_alloc_next_lease = 1;
+    std::map<uint64_t, std::pair<yk_buffer_t, double>>          get_alloc_leases;
+
+    /* Largest offset + size accepted by yk_put_range (0 = no limit) */
+    size_t max_range_end = 0;
+
     /* Database */
     yk_database_t db = nullptr;
 
+    /* RPC metrics (null if disabled in the configuration) */
+    std::unique_ptr<yokan::Metrics> metrics;
+
+    /* RPC phase tracing (null if disabled in the configuration) */
+    std::unique_ptr<yokan::Tracer> tracer;
+
     /* RPC identifiers for clients */
     hg_id_t count_id;
     hg_id_t exists_id;
@@ -48,6 +70,8 @@ typedef struct yk_provider {
     hg_id_t put_direct_id;
     hg_id_t get_id;
     hg_id_t get_direct_id;
+    hg_id_t get_alloc_id;
+    hg_id_t get_alloc_release_id;
     hg_id_t fetch_id;
     hg_id_t fetch_direct_id;
     hg_id_t fetch_back_id;
@@ -55,6 +79,10 @@ typedef struct yk_provider {
     hg_id_t erase_id;
     hg_id_t erase_direct_id;
     hg_id_t erase_range_id;
+    hg_id_t get_range_id;
+    hg_id_t put_range_id;
+    hg_id_t compare_and_swap_id;
+    hg_id_t merge_id;
     hg_id_t list_keys_id;
     hg_id_t list_keys_direct_id;
     hg_id_t list_keyvals_id;
@@ -86,6 +114,7 @@ typedef struct yk_provider {
     hg_id_t doc_iter_back_id;
     hg_id_t doc_iter_direct_back_id;
     hg_id_t get_remi_provider_id;
+    hg_id_t get_stats_id;
 
     // REMI information
     struct {
@@ -108,10 +137,22 @@ DECLARE_MARGO_RPC_HANDLER(yk_erase_direct_ult)
 void yk_erase_direct_ult(hg_handle_t h);
 DECLARE_MARGO_RPC_HANDLER(yk_erase_range_ult)
 void yk_erase_range_ult(hg_handle_t h);
+DECLARE_MARGO_RPC_HANDLER(yk_get_range_ult)
+void yk_get_range_ult(hg_handle_t h);
+DECLARE_MARGO_RPC_HANDLER(yk_put_range_ult)
+void yk_put_range_ult(hg_handle_t h);
+DECLARE_MARGO_RPC_HANDLER(yk_compare_and_swap_ult)
+void yk_compare_and_swap_ult(hg_handle_t h);
+DECLARE_MARGO_RPC_HANDLER(yk_merge_ult)
+void yk_merge_ult(hg_handle_t h);
 DECLARE_MARGO_RPC_HANDLER(yk_get_ult)
 void yk_get_ult(hg_handle_t h);
 DECLARE_MARGO_RPC_HANDLER(yk_get_direct_ult)
 void yk_get_direct_ult(hg_handle_t h);
+DECLARE_MARGO_RPC_HANDLER(yk_get_alloc_ult)
+void yk_get_alloc_ult(hg_handle_t h);
+DECLARE_MARGO_RPC_HANDLER(yk_get_alloc_release_ult)
+void yk_get_alloc_release_ult(hg_handle_t h);
 DECLARE_MARGO_RPC_HANDLER(yk_fetch_ult)
 void yk_fetch_ult(hg_handle_t h);
 DECLARE_MARGO_RPC_HANDLER(yk_fetch_direct_ult)
@@ -178,6 +219,9 @@ void yk_doc_iter_direct_ult(hg_handle_t h);
 DECLARE_MARGO_RPC_HANDLER(yk_get_remi_provider_id_ult)
 void yk_get_remi_provider_id_ult(hg_handle_t h);
 
+DECLARE_MARGO_RPC_HANDLER(yk_get_stats_ult)
+void yk_get_stats_ult(hg_handle_t h);
+
 /* Returns a non-owning hg_addr_t for the RPC origin. When `origin` is NULL,
  * returns the handle's source address (valid for handle lifetime). When set,
  * looks up the address (caching the result in the provider's LRU) and returns
@@ -187,4 +231,10 @@ hg_return_t yk_provider_resolve_addr(yk_provider_t provider,
                                      hg_handle_t  h,
                                      const char*  origin,
                                      hg_addr_t*   addr_out);
+
+/* Collects the provider's statistics: RPC metrics under "rpcs" (if enabled)
+ * and the statistics reported by the database's backend under "backend"
+ * (if a database is attached). Used by yk_provider_get_stats and by the
+ * get_stats RPC. */
+json yk_provider_collect_stats(yk_provider_t provider, bool reset);
 #endif
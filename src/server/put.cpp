@@ -21,9 +21,10 @@ void yk_put_ult(hg_handle_t h)
     hg_addr_t origin_addr = HG_ADDR_NULL;
 
     out.ret = YOKAN_SUCCESS;
+    yokan::RPCTrace trace;
 
     DEFER(margo_destroy(h));
-    DEFER(margo_respond(h, &out));
+    DEFER(trace.phase("respond"); margo_respond(h, &out));
 
     margo_instance_id mid = margo_hg_handle_get_instance(h);
     CHECK_MID(mid, margo_hg_handle_get_instance);
@@ -31,9 +32,16 @@ void yk_put_ult(hg_handle_t h)
     const struct hg_info* info = margo_get_info(h);
     yk_provider_t provider = (yk_provider_t)margo_registered_data(mid, info->id);
     CHECK_PROVIDER(provider);
+    yokan::RPCMetricsScope metrics{
+        provider->metrics.get(), yokan::RPCType::PUT, out.ret};
+    trace.start(provider->tracer.get(), yokan::RPCType::PUT);
 
     hret = margo_get_input(h, &in);
     CHECK_HRET_OUT(hret, margo_get_input);
+    trace.setTraceId(in.trace_id);
+    trace.phase("prepare");
+    metrics.keys     = in.count;
+    metrics.bytes_in = in.size;
     const double timeout_ms = in.timeout_ms;
     const double t_start = ABT_get_wtime();
     double bulk_timeout;
@@ -51,6 +59,7 @@ void yk_put_ult(hg_handle_t h)
     CHECK_BUFFER(buffer);
     DEFER(provider->bulk_cache.release(provider->bulk_cache_data, buffer));
 
+    trace.phase("bulk_pull");
     bulk_timeout = yk_bulk_timeout_ms(timeout_ms, t_start);
     hret = margo_bulk_transfer_timed(mid, HG_BULK_PULL, origin_addr,
                                in.bulk, in.offset, buffer->bulk, 0, in.size, bulk_timeout);
@@ -91,6 +100,7 @@ void yk_put_ult(hg_handle_t h)
 
     auto vals = yokan::UserMem{ ptr, total_vsize };
 
+    trace.phase("backend");
     out.ret = static_cast<yk_return_t>(
             database->put(in.mode, keys, ksizes, vals, vsizes));
 }
@@ -111,9 +121,10 @@ void yk_put_direct_ult(hg_handle_t h)
     in.vals.data = nullptr;
     in.vals.size = 0;
     out.ret = YOKAN_SUCCESS;
+    yokan::RPCTrace trace;
 
     DEFER(margo_destroy(h));
-    DEFER(margo_respond(h, &out));
+    DEFER(trace.phase("respond"); margo_respond(h, &out));
 
     margo_instance_id mid = margo_hg_handle_get_instance(h);
     CHECK_MID(mid, margo_hg_handle_get_instance);
@@ -121,9 +132,16 @@ void yk_put_direct_ult(hg_handle_t h)
     const struct hg_info* info = margo_get_info(h);
     yk_provider_t provider = (yk_provider_t)margo_registered_data(mid, info->id);
     CHECK_PROVIDER(provider);
+    yokan::RPCMetricsScope metrics{
+        provider->metrics.get(), yokan::RPCType::PUT_DIRECT, out.ret};
+    trace.start(provider->tracer.get(), yokan::RPCType::PUT_DIRECT);
 
     hret = margo_get_input(h, &in);
     CHECK_HRET_OUT(hret, margo_get_input);
+    trace.setTraceId(in.trace_id);
+    trace.phase("prepare");
+    metrics.keys     = in.ksizes.count;
+    metrics.bytes_in = in.keys.size + in.vals.size;
     const double timeout_ms = in.timeout_ms;
     (void)timeout_ms;
     const double t_start = ABT_get_wtime();
@@ -155,6 +173,7 @@ void yk_put_direct_ult(hg_handle_t h)
     auto keys = yokan::UserMem{ in.keys.data, in.keys.size };
     auto vals = yokan::UserMem{ in.vals.data, in.vals.size };
 
+    trace.phase("backend");
     out.ret = static_cast<yk_return_t>(
             database->put(in.mode, keys, ksizes, vals, vsizes));
 }
@@ -0,0 +1,101 @@
+/*
+ * (C) 2026 The University of Chicago
+ *
+ * See COPYRIGHT in top-level directory.
+ */
+#include "yokan/server.h"
+#include "provider.hpp"
+#include "../common/types.h"
+#include "../common/defer.hpp"
+#include "../common/logging.h"
+#include "../common/checks.h"
+#include "../common/bulk_timeout.h"
+#include <cstring>
+#include <cstdint>
+
+void yk_put_range_ult(hg_handle_t h)
+{
+    hg_return_t hret;
+    put_range_in_t in;
+    put_range_out_t out;
+    hg_addr_t origin_addr = HG_ADDR_NULL;
+
+    std::memset(&in, 0, sizeof(in));
+
+    out.ret = YOKAN_SUCCESS;
+    yokan::RPCTrace trace;
+
+    DEFER(margo_destroy(h));
+    DEFER(trace.phase("respond"); margo_respond(h, &out));
+
+    margo_instance_id mid = margo_hg_handle_get_instance(h);
+    CHECK_MID(mid, margo_hg_handle_get_instance);
+
+    const struct hg_info* info = margo_get_info(h);
+    yk_provider_t provider = (yk_provider_t)margo_registered_data(mid, info->id);
+    CHECK_PROVIDER(provider);
+    yokan::RPCMetricsScope metrics{
+        provider->metrics.get(), yokan::RPCType::PUT_RANGE, out.ret};
+    trace.start(provider->tracer.get(), yokan::RPCType::PUT_RANGE);
+
+    hret = margo_get_input(h, &in);
+    CHECK_HRET_OUT(hret, margo_get_input);
+    trace.setTraceId(in.trace_id);
+    trace.phase("prepare");
+    metrics.keys     = 1;
+    metrics.bytes_in = in.key.size + in.size;
+    const double timeout_ms = in.timeout_ms;
+    const double t_start = ABT_get_wtime();
+    double bulk_timeout;
+    DEFER(margo_free_input(h, &in));
+
+    if(in.key.size == 0) {
+        out.ret = YOKAN_ERR_INVALID_ARGS;
+        return;
+    }
+
+    // the backends extend the value up to offset + size
+    if(in.offset > SIZE_MAX - in.size
+    || (provider->max_range_end && in.offset + in.size > provider->max_range_end)) {
+        out.ret = YOKAN_ERR_INVALID_ARGS;
+        return;
+    }
+
+    yk_database* database = provider->db;
+    CHECK_DATABASE(database);
+    CHECK_MODE_SUPPORTED(database, in.mode);
+
+    auto key = yokan::UserMem{ in.key.data, in.key.size };
+
+    if(in.bulk == HG_BULK_NULL) {
+        if(in.data.size != in.size) {
+            out.ret = YOKAN_ERR_INVALID_ARGS;
+            return;
+        }
+        auto range = yokan::UserMem{ in.data.data, in.data.size };
+        trace.phase("backend");
+        out.ret = static_cast<yk_return_t>(
+                database->putRange(in.mode, key, in.offset, range));
+        return;
+    }
+
+    hret = yk_provider_resolve_addr(provider, h, in.origin, &origin_addr);
+    CHECK_HRET_OUT(hret, yk_provider_resolve_addr);
+
+    yk_buffer_t buffer = provider->bulk_cache.get(
+        provider->bulk_cache_data, in.size, HG_BULK_WRITE_ONLY);
+    CHECK_BUFFER(buffer);
+    DEFER(provider->bulk_cache.release(provider->bulk_cache_data, buffer));
+
+    trace.phase("bulk_pull");
+    bulk_timeout = yk_bulk_timeout_ms(timeout_ms, t_start);
+    hret = margo_bulk_transfer_timed(mid, HG_BULK_PULL, origin_addr,
+            in.bulk, 0, buffer->bulk, 0, in.size, bulk_timeout);
+    CHECK_HRET_OUT(hret, margo_bulk_transfer_timed);
+
+    auto range = yokan::UserMem{ buffer->data, in.size };
+    trace.phase("backend");
+    out.ret = static_cast<yk_return_t>(
+            database->putRange(in.mode, key, in.offset, range));
+}
+DEFINE_MARGO_RPC_HANDLER(yk_put_range_ult)
@@ -0,0 +1,67 @@
+/*
+ * (C) 2026 The University of Chicago
+ *
+ * See COPYRIGHT in top-level directory.
+ */
+#include "tracing.hpp"
+#include <algorithm>
+
+namespace yokan {
+
+using json = nlohmann::json;
+
+Tracer::Tracer(uint16_t provider_id, size_t capacity)
+: m_provider_id(provider_id)
+, m_capacity(capacity ? capacity : 1)
+, m_slots(new Slot[m_capacity]) {}
+
+void Tracer::record(const Span& span) {
+    auto index = m_next_slot.fetch_add(1, std::memory_order_relaxed);
+    auto& slot = m_slots[index % m_capacity];
+    slot.seq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.span = span;
+    slot.seq.store(index + 1, std::memory_order_release);
+}
+
+json Tracer::toChromeTrace() const {
+    auto events = json::array();
+    for(size_t i = 0; i < m_capacity; i++) {
+        auto& slot = m_slots[i];
+        auto seq = slot.seq.load(std::memory_order_acquire);
+        if(seq == 0) continue;
+        Span span = slot.span;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(slot.seq.load(std::memory_order_relaxed) != seq) continue;
+        events.push_back(json{
+            {"name", span.name},
+            {"cat",  "yokan"},
+            {"ph",   "X"},
+            {"ts",   span.start_us},
+            {"dur",  span.end_us - span.start_us},
+            {"pid",  m_provider_id},
+            {"tid",  span.trace_id},
+            {"args", {
+                {"rpc",      RPCTypeName(span.type)},
+                {"trace_id", span.trace_id},
+                {"xstream",  span.xstream}
+            }}
+        });
+    }
+    // events of a same trace need to be ordered by start time,
+    // with enclosing spans first, for viewers to nest them properly
+    std::sort(events.begin(), events.end(),
+        [](const json& lhs, const json& rhs) {
+            auto l = lhs["ts"].get<int64_t>(), r = rhs["ts"].get<int64_t>();
+            if(l != r) return l < r;
+            return lhs["dur"].get<int64_t>() > rhs["dur"].get<int64_t>();
+        });
+    return json{{"traceEvents", events}, {"displayTimeUnit", "ns"}};
+}
+
+void Tracer::clear() {
+    for(size_t i = 0; i < m_capacity; i++)
+        m_slots[i].seq.store(0, std::memory_order_relaxed);
+}
+
+}
@@ -0,0 +1,177 @@
+/*
+ * (C) 2026 The University of Chicago
+ *
+ * See COPYRIGHT in top-level directory.
+ */
+#ifndef __YOKAN_TRACING_H
+#define __YOKAN_TRACING_H
+
+#include "metrics.hpp"
+#include <nlohmann/json.hpp>
+#include <abt.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <cstdint>
+
+namespace yokan {
+
+/**
+ * @brief The Tracer class keeps the most recent spans recorded by the
+ * RPC handlers of a provider in a fixed-size ring buffer. A span is either
+ * a whole RPC (named after its RPC type) or one of its phases (deserialize,
+ * prepare, bulk_pull, backend, bulk_push, respond). All the spans of a
+ * request carry the same trace id, either provided by the client via
+ * YOKAN_EXTRA_TRACE_ID or assigned by the provider.
+ *
+ * Timestamps are taken from the system clock so that they can be
+ * correlated with client-side timelines.
+ */
+class Tracer {
+
+    public:
+
+    struct Span {
+        uint64_t    trace_id = 0;
+        const char* name     = nullptr;
+        RPCType     type     = RPCType::NUM_TYPES;
+        int64_t     start_us = 0;
+        int64_t     end_us   = 0;
+        int         xstream  = 0;
+    };
+
+    Tracer(uint16_t provider_id, size_t capacity);
+
+    Tracer(const Tracer&) = delete;
+    Tracer(Tracer&&) = delete;
+
+    /**
+     * @brief Generate a new trace id. Ids generated by the provider have
+     * their most significant bit set, so they do not collide with small
+     * client-provided ids.
+     */
+    uint64_t newTraceId() {
+        return m_next_trace_id.fetch_add(1, std::memory_order_relaxed)
+             | (1ull << 63);
+    }
+
+    /**
+     * @brief Record a span, overwriting the oldest one if the buffer is full.
+     */
+    void record(const Span& span);
+
+    /**
+     * @brief Convert the content of the buffer into a JSON object in the
+     * Chrome trace event format (loadable in chrome://tracing or Perfetto).
+     * Spans that are being overwritten while this function runs are skipped.
+     */
+    nlohmann::json toChromeTrace() const;
+
+    /**
+     * @brief Remove all the spans from the buffer.
+     */
+    void clear();
+
+    static int64_t now() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    private:
+
+    struct Slot {
+        std::atomic<uint64_t> seq{0}; // 0 while being written
+        Span                  span;
+    };
+
+    uint16_t                m_provider_id;
+    size_t                  m_capacity;
+    std::unique_ptr<Slot[]> m_slots;
+    std::atomic<uint64_t>   m_next_slot{0};
+    std::atomic<uint64_t>   m_next_trace_id{1};
+};
+
+/**
+ * @brief Records the spans of an RPC handler. The object should be
+ * declared before the DEFER statements of the handler (so that it is
+ * destroyed after the response has been sent), then started once the
+ * provider is known. The phase() function closes the current phase and
+ * opens a new one. The last phase and the span of the whole RPC are
+ * recorded upon destruction. If tracing is disabled, all the functions
+ * are no-ops.
+ */
+class RPCTrace {
+
+    public:
+
+    RPCTrace() = default;
+
+    RPCTrace(const RPCTrace&) = delete;
+    RPCTrace(RPCTrace&&) = delete;
+
+    ~RPCTrace() {
+        if(!m_tracer) return;
+        auto end = closePhase();
+        m_tracer->record(Tracer::Span{
+            m_trace_id, RPCTypeName(m_type), m_type, m_start, end, xstream()});
+    }
+
+    /**
+     * @brief Start tracing the RPC. The first phase is "deserialize".
+     */
+    void start(Tracer* tracer, RPCType type) {
+        m_tracer = tracer;
+        if(!m_tracer) return;
+        m_type        = type;
+        m_start       = Tracer::now();
+        m_phase       = "deserialize";
+        m_phase_start = m_start;
+    }
+
+    /**
+     * @brief Set the trace id received from the client (0 to let the
+     * tracer assign one). Should be called right after deserializing
+     * the input, before any other phase is closed.
+     */
+    void setTraceId(uint64_t trace_id) {
+        if(!m_tracer) return;
+        m_trace_id = trace_id ? trace_id : m_tracer->newTraceId();
+    }
+
+    /**
+     * @brief Close the current phase and open a new one.
+     * The name must be a string literal.
+     */
+    void phase(const char* name) {
+        if(!m_tracer) return;
+        m_phase_start = closePhase();
+        m_phase       = name;
+    }
+
+    private:
+
+    int64_t closePhase() {
+        auto t = Tracer::now();
+        if(m_trace_id == 0) m_trace_id = m_tracer->newTraceId();
+        m_tracer->record(Tracer::Span{
+            m_trace_id, m_phase, m_type, m_phase_start, t, xstream()});
+        return t;
+    }
+
+    static int xstream() {
+        int rank = 0;
+        ABT_self_get_xstream_rank(&rank);
+        return rank;
+    }
+
+    Tracer*     m_tracer      = nullptr;
+    RPCType     m_type        = RPCType::NUM_TYPES;
+    uint64_t    m_trace_id    = 0;
+    int64_t     m_start       = 0;
+    const char* m_phase       = nullptr;
+    int64_t     m_phase_start = 0;
+};
+
+}
+
+#endif
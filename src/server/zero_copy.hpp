@@ -0,0 +1,109 @@
+/*
+ * (C) 2026 The University of Chicago
+ *
+ * See COPYRIGHT in top-level directory.
+ */
+#ifndef __ZERO_COPY_H
+#define __ZERO_COPY_H
+
+#include "yokan/backend.hpp"
+#include "../common/defer.hpp"
+#include "../common/logging.h"
+#include "../common/checks.h"
+#include <margo.h>
+#include <vector>
+
+/**
+ * @brief Helper used by the fetch and doc_fetch handlers when the
+ * backend supports zero-copy fetch (see
+ * DatabaseInterface::supportsZeroCopyFetch). Instead of copying values
+ * into a contiguous buffer, this class records the location of each
+ * value in the backend's memory and exposes them as segments of a single
+ * bulk handle. The first segment holds the value sizes, so the layout
+ * seen by the client is the same as with the copy-based approach.
+ *
+ * Since the memory is only guaranteed valid while the backend's fetch
+ * function is running, send() must be called from within the callback
+ * that processes the last item of the batch.
+ */
+class ZeroCopyBatch {
+
+    public:
+
+    explicit ZeroCopyBatch(size_t count)
+    : m_count(count) {
+        m_vsizes.reserve(count);
+        m_ptrs.reserve(count+1);
+        m_sizes.reserve(count+1);
+        // placeholder for the segment holding the value sizes
+        m_ptrs.push_back(nullptr);
+        m_sizes.push_back(0);
+    }
+
+    void add(const yokan::UserMem& val) {
+        m_vsizes.push_back(val.size);
+        if(val.size == 0 || val.size == YOKAN_KEY_NOT_FOUND)
+            return;
+        m_total_size += val.size;
+        // merge with the previous segment if contiguous
+        if(m_ptrs.size() > 1
+        && static_cast<char*>(m_ptrs.back()) + m_sizes.back() == val.data) {
+            m_sizes.back() += val.size;
+        } else {
+            m_ptrs.push_back(val.data);
+            m_sizes.push_back(val.size);
+        }
+    }
+
+    bool complete() const {
+        return m_vsizes.size() == m_count;
+    }
+
+    /**
+     * @brief Expose the recorded segments via a bulk handle and send
+     * the back RPC to the client, waiting for its response. BackIn
+     * is expected to have "size" and "bulk" fields, the other fields
+     * should be set by the caller.
+     */
+    template<typename BackOut, typename BackIn>
+    yk_return_t send(margo_instance_id mid, hg_addr_t addr,
+                     hg_id_t rpc_id, BackIn& back_in) {
+        hg_return_t hret = HG_SUCCESS;
+
+        m_ptrs[0]  = m_vsizes.data();
+        m_sizes[0] = m_vsizes.size()*sizeof(size_t);
+
+        hg_bulk_t bulk = HG_BULK_NULL;
+        hret = margo_bulk_create(mid, m_ptrs.size(), m_ptrs.data(), m_sizes.data(),
+                                 HG_BULK_READ_ONLY, &bulk);
+        CHECK_HRET(hret, margo_bulk_create);
+        DEFER(margo_bulk_free(bulk));
+
+        back_in.size = m_sizes[0] + m_total_size;
+        back_in.bulk = bulk;
+
+        hg_handle_t back_handle = HG_HANDLE_NULL;
+        hret = margo_create(mid, addr, rpc_id, &back_handle);
+        CHECK_HRET(hret, margo_create);
+        DEFER(margo_destroy(back_handle));
+
+        hret = margo_forward(back_handle, &back_in);
+        CHECK_HRET(hret, margo_forward);
+
+        BackOut back_out;
+        hret = margo_get_output(back_handle, &back_out);
+        CHECK_HRET(hret, margo_get_output);
+        DEFER(margo_free_output(back_handle, &back_out));
+        return (yk_return_t)back_out.ret;
+    }
+
+    private:
+
+    size_t                 m_count;
+    std::vector<size_t>    m_vsizes;
+    std::vector<void*>     m_ptrs;
+    std::vector<hg_size_t> m_sizes;
+    hg_size_t              m_total_size = 0;
+};
+
+#endif
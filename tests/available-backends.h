@@ -9,6 +9,7 @@ static const char* available_backends[] = {
     "set",
     "unordered_set",
     "log",
+    "buffered",
 #ifdef YOKAN_HAS_LEVELDB
     "leveldb",
 #endif
@@ -43,9 +44,15 @@ static const char* backend_configs[] = {
     "{\"disable_doc_mixin_lock\":true}",
     "{\"disable_doc_mixin_lock\":true}",
     "{\"path\":\"/tmp/log-test\"}",
+    "{\"inner\":{\"type\":\"map\",\"config\":{}},"
+    " \"wal_path\":\"/tmp/buffered-test.wal\","
+    " \"disable_doc_mixin_lock\":true}",
 #ifdef YOKAN_HAS_LEVELDB
     "{\"path\":\"/tmp/leveldb-test\","
     " \"disable_doc_mixin_lock\":true,"
+    " \"bloom_filter_bits_per_key\":10,"
+    " \"block_cache_size\":1048576,"
+    " \"read_options\":{\"snapshot_iteration\":true},"
     " \"create_if_missing\":true}",
 #endif
 #ifdef YOKAN_HAS_LMDB
@@ -95,13 +102,15 @@ inline static const char* find_backend_config_for(const char* backend) {
     return NULL;
 }
 
-inline static std::string make_provider_config(const char* backend) {
+inline static std::string make_provider_config(const char* backend, bool tracing = false) {
     auto backend_config = find_backend_config_for(backend);
     std::string result = "{\"database\":{\"type\":\"";
     result += backend;
     result += "\",\"config\":";
     result += backend_config;
-    result += "}}";
+    result += "}";
+    if(tracing) result += ",\"tracing\":{\"enabled\":true}";
+    result += "}";
     std::cerr << result << std::endl;
     return result;
 }
@@ -0,0 +1,66 @@
+import os
+import sys
+import unittest
+import asyncio
+import string
+import random
+
+wd = os.getcwd()
+sys.path.append(wd+'/../python')
+
+from mochi.margo import Engine
+from mochi.yokan.client import Client
+from mochi.yokan.server import Provider
+from mochi.yokan.aio import AsyncDatabase
+
+class TestAsyncDatabase(unittest.TestCase):
+
+    def setUp(self):
+        self.engine = Engine('tcp', config={"use_progress_thread": True})
+        self.addr = self.engine.addr()
+        self.provider_id = 42
+        self.provider = Provider(engine=self.engine,
+                                 provider_id=self.provider_id,
+                                 config='{"database":{"type":"map"}}')
+        self.client = Client(engine=self.engine)
+        self.db = self.client.make_database_handle(
+            address=self.addr,
+            provider_id=self.provider_id)
+        self.adb = AsyncDatabase(self.db)
+        self.reference = dict()
+        letters = string.ascii_letters
+        for i in range(0,32):
+            key_len = random.randint(8, 64)
+            val_len = random.randint(16, 128)
+            key = ''.join(random.choice(letters) for i in range(key_len))
+            val = ''.join(random.choice(letters) for i in range(val_len))
+            self.reference[key] = val
+
+    def tearDown(self):
+        del self.adb
+        del self.db
+        del self.addr
+        del self.client
+        del self.provider
+        del self.reference
+        self.engine.finalize()
+
+    def test_async_put_get(self):
+        """Test that concurrent coroutines can put and get key/value pairs."""
+
+        async def run():
+            await asyncio.gather(*[self.adb.put(key=k, value=v)
+                                   for k, v in self.reference.items()])
+            buffers = {k: bytearray(128) for k in self.reference}
+            sizes = await asyncio.gather(*[self.adb.get(key=k, value=buffers[k])
+                                           for k in self.reference])
+            for k, vsize in zip(self.reference, sizes):
+                self.assertEqual(buffers[k][0:vsize].decode('ascii'),
+                                 self.reference[k])
+            self.assertEqual(await self.adb.count(), len(self.reference))
+
+        asyncio.run(run())
+
+
+if __name__ == '__main__':
+    unittest.main()
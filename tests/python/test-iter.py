@@ -81,5 +81,16 @@ class TestIter(unittest.TestCase):
                 self.assertEqual(v_ref, out_vals[i])
                 i += 1
 
+    def test_scan(self):
+        for prefix in ['', self.prefix]:
+            expected = [(k, self.reference[k]) for k in sorted(self.reference.keys())
+                        if k.startswith(prefix)]
+            out = [(k, v.decode('ascii'))
+                   for k, v in self.db.scan(from_key='', filter=prefix, buffer_size=64)]
+            self.assertEqual(expected, out)
+            out_keys = [k for k, v in self.db.scan(from_key='', filter=prefix,
+                                                   ignore_values=True)]
+            self.assertEqual([k for k, v in expected], out_keys)
+
 if __name__ == '__main__':
     unittest.main()
@@ -4,6 +4,8 @@ import unittest
 import json
 import string
 import random
+import struct
+import array
 from typing import Optional
 
 wd = os.getcwd()
@@ -11,8 +13,9 @@ sys.path.append(wd+'/../python')
 
 from mochi.margo import Engine
 from mochi.yokan.exception import Exception, YOKAN_ERR_KEY_NOT_FOUND
-from mochi.yokan.client import Client
+from mochi.yokan.client import Client, YOKAN_KEY_NOT_FOUND
 from mochi.yokan.server import Provider
+from mochi.yokan.merge import YOKAN_MERGE_ADD_INT64, YOKAN_MERGE_APPEND
 
 class TestPutGetFetch(unittest.TestCase):
 
@@ -72,6 +75,62 @@ class TestPutGetFetch(unittest.TestCase):
             self.db.get(key=bytearray(b'xxxxx'), value=out_val)
         self.assertEqual(ctx.exception.code, YOKAN_ERR_KEY_NOT_FOUND)
 
+    def test_put_get_range(self):
+        """Test that we can read and write parts of values."""
+        self.db.put(key='matthieu', value='dorier')
+        out_val = bytearray(4)
+        vsize = self.db.get_range(key='matthieu', offset=2, value=out_val)
+        self.assertEqual(vsize, 4)
+        self.assertEqual(out_val.decode("ascii"), 'rier')
+        vsize = self.db.get_range(key='matthieu', offset=4, value=out_val)
+        self.assertEqual(vsize, 2)
+        self.assertEqual(out_val[0:vsize].decode("ascii"), 'er')
+
+        self.db.put_range(key='matthieu', offset=1, value='OR')
+        self.db.put_range(key='matthieu', offset=6, value=b'!!')
+        out_val = bytearray(128)
+        vsize = self.db.get(key='matthieu', value=out_val)
+        self.assertEqual(out_val[0:vsize].decode("ascii"), 'dORier!!')
+
+        with self.assertRaises(Exception) as ctx:
+            self.db.get_range(key='xxxxx', offset=0, value=out_val)
+        self.assertEqual(ctx.exception.code, YOKAN_ERR_KEY_NOT_FOUND)
+
+    def test_compare_and_swap_merge(self):
+        """Test that we can atomically update values on the provider."""
+        self.db.put(key='matthieu', value='dorier')
+        self.assertFalse(self.db.compare_and_swap(
+            key='matthieu', expected='xxx', value='mdorier'))
+        self.assertTrue(self.db.compare_and_swap(
+            key='matthieu', expected='dorier', value='mdorier'))
+        out_val = bytearray(128)
+        vsize = self.db.get(key='matthieu', value=out_val)
+        self.assertEqual(out_val[0:vsize].decode("ascii"), 'mdorier')
+
+        result = bytearray(8)
+        for i in range(1, 5):
+            self.db.merge(key='counter', op=YOKAN_MERGE_ADD_INT64,
+                          operand=struct.pack('=q', i), result=result)
+        self.assertEqual(struct.unpack('=q', result)[0], 10)
+
+        result = bytearray(16)
+        rsize = self.db.merge(key='matthieu', op=YOKAN_MERGE_APPEND,
+                              operand='!!', bound=8, result=result)
+        self.assertEqual(result[0:rsize].decode("ascii"), 'dorier!!')
+
+    def test_put_get_alloc(self):
+        """Test that we can get values without providing a buffer."""
+        for k, v in self.reference.items():
+            self.db.put(key=k, value=v)
+        for k, v in self.reference.items():
+            out_val = self.db.get_alloc(key=k)
+            self.assertEqual(len(out_val), len(v))
+            self.assertEqual(bytes(memoryview(out_val)).decode("ascii"), v)
+
+        with self.assertRaises(Exception) as ctx:
+            self.db.get_alloc(key='xxxxx')
+        self.assertEqual(ctx.exception.code, YOKAN_ERR_KEY_NOT_FOUND)
+
     def test_put_fetch_strings(self):
         """Test that we can fetch key/value pairs."""
         for k, v in self.reference.items():
@@ -232,6 +291,55 @@ class TestPutGetFetch(unittest.TestCase):
                              self.reference[k])
             voffset += vsize
 
+    def test_put_get_packed_arrays(self):
+        """Test put_packed and get_packed with sizes passed as arrays."""
+        in_keys_buf = bytearray()
+        in_vals_buf = bytearray()
+        in_key_sizes = array.array('Q')
+        in_val_sizes = array.array('i')  # converted, not used in place
+        for k, v in self.reference.items():
+            in_keys_buf += k.encode('ascii')
+            in_key_sizes.append(len(k))
+            in_vals_buf += v.encode('ascii')
+            in_val_sizes.append(len(v))
+
+        self.db.put_packed(keys=in_keys_buf, key_sizes=in_key_sizes,
+                           values=in_vals_buf, value_sizes=in_val_sizes)
+
+        out_keys = list(self.reference.keys())
+        out_keys.append('xxxxxxxx')
+        random.shuffle(out_keys)
+        out_keys_buf = bytearray()
+        out_key_sizes = array.array('Q')
+        for k in out_keys:
+            out_keys_buf += k.encode('ascii')
+            out_key_sizes.append(len(k))
+        out_vals_buf = bytearray(128*len(out_keys))
+        out_val_sizes = array.array('Q', [0]*len(out_keys))
+
+        self.db.get_packed(keys=out_keys_buf, key_sizes=out_key_sizes,
+                           values=out_vals_buf, value_sizes=out_val_sizes)
+        voffset = 0
+        for i, k in enumerate(out_keys):
+            if k == 'xxxxxxxx':
+                self.assertEqual(out_val_sizes[i], YOKAN_KEY_NOT_FOUND)
+                continue
+            vsize = out_val_sizes[i]
+            self.assertEqual(out_vals_buf[voffset:voffset+vsize].decode('ascii'),
+                             self.reference[k])
+            voffset += vsize
+
+        lengths = array.array('Q', [0]*len(out_keys))
+        self.db.length_packed(keys=out_keys_buf, key_sizes=out_key_sizes,
+                              value_sizes=lengths)
+        self.assertEqual(lengths, out_val_sizes)
+
+        self.db.erase_packed(keys=out_keys_buf, key_sizes=out_key_sizes)
+        self.db.length_packed(keys=out_keys_buf, key_sizes=out_key_sizes,
+                              value_sizes=lengths)
+        for length in lengths:
+            self.assertEqual(length, YOKAN_KEY_NOT_FOUND)
+
     def test_put_fetch_packed(self):
         """Test that we can use put_packed and fetch_packed."""
         in_keys_buf = bytearray()
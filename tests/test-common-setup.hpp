@@ -63,7 +63,8 @@ static void* kv_test_common_context_setup(const MunitParameter params[], void* u
     const char* num_keyvals  = munit_parameters_get(params, "num-items");
     const char* backend_type = munit_parameters_get(params, "backend");
     const char* no_rdma      = munit_parameters_get(params, "no-rdma");
-    auto provider_config     = make_provider_config(backend_type);
+    const char* tracing      = munit_parameters_get(params, "tracing");
+    auto provider_config     = make_provider_config(backend_type, to_bool(tracing));
     if(min_key_size) g_min_key_size = std::atol(min_key_size);
     if(max_key_size) g_max_key_size = std::atol(max_key_size);
     if(min_val_size) g_min_val_size = std::atol(min_val_size);
@@ -109,8 +110,14 @@ static void* kv_test_common_context_setup(const MunitParameter params[], void* u
     context->dbh      = dbh;
     context->mode     = 0;
     context->backend  = backend_type;
-    if(no_rdma && to_bool(no_rdma))
+    if(no_rdma && to_bool(no_rdma)) {
         context->mode |= YOKAN_MODE_NO_RDMA;
+    } else {
+        // disable the automatic selection of direct transfers so that
+        // the no-rdma parameter selects between the bulk and direct RPCs
+        ret = yk_client_set_direct_threshold(client, 0);
+        munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    }
     if(g_max_val_size == 0 && g_min_val_size == 0) {
         context->empty_values = true;
     }
@@ -0,0 +1,270 @@
+/*
+ * (C) 2026 The University of Chicago
+ *
+ * See COPYRIGHT in top-level directory.
+ */
+#include <stdio.h>
+#include <margo.h>
+#include <yokan/server.h>
+#include <yokan/client.h>
+#include <yokan/database.h>
+#include <yokan/distributed.h>
+#include "available-backends.h"
+#include "munit/munit.h"
+#include <vector>
+#include <string>
+#include <map>
+
+#define NUM_DATABASES 3
+#define NUM_KEYS      64
+
+struct test_context {
+    margo_instance_id       mid;
+    hg_addr_t               addr;
+    yk_client_t             client;
+    yk_database_handle_t    dbhs[NUM_DATABASES];
+    yk_distributed_database_t ddb;
+    std::map<std::string, std::string> reference;
+};
+
+static void* test_context_setup(const MunitParameter params[], void* user_data)
+{
+    (void) user_data;
+    margo_instance_id mid;
+    hg_addr_t         addr;
+    hg_return_t       hret;
+    yk_return_t       ret;
+    const char*       partitioning = munit_parameters_get(params, "partitioning");
+
+    mid = margo_init("ofi+tcp", MARGO_SERVER_MODE, 0, 0);
+    munit_assert_not_null(mid);
+
+    hret = margo_addr_self(mid, &addr);
+    munit_assert_int(hret, ==, HG_SUCCESS);
+
+    // register one provider per database
+    auto config = make_provider_config("map");
+    for(int i = 0; i < NUM_DATABASES; i++) {
+        ret = yk_provider_register(mid, 42+i, config.c_str(), NULL, NULL);
+        munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    }
+
+    struct test_context* context = new test_context;
+    context->mid  = mid;
+    context->addr = addr;
+
+    ret = yk_client_init(mid, &context->client);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+
+    for(int i = 0; i < NUM_DATABASES; i++) {
+        ret = yk_database_handle_create(
+            context->client, addr, 42+i, true, &context->dbhs[i]);
+        munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    }
+
+    // split the key space "key00000"..."key00063" in NUM_DATABASES ranges
+    static const char* split_keys[] = { "key00020", "key00040" };
+    static const size_t split_ksizes[] = { 8, 8 };
+
+    yk_distributed_options_t options = YOKAN_DISTRIBUTED_OPTIONS_INIT;
+    if(strcmp(partitioning, "range") == 0) {
+        options.partitioning = YOKAN_PARTITION_RANGE;
+        options.split_keys   = (const void* const*)split_keys;
+        options.split_ksizes = split_ksizes;
+    }
+    ret = yk_distributed_database_create(
+        NUM_DATABASES, context->dbhs, &options, &context->ddb);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+
+    for(int i = 0; i < NUM_KEYS; i++) {
+        char key[16], value[16];
+        sprintf(key, "key%05d", i);
+        sprintf(value, "value%05d", i * 7);
+        context->reference[key] = value;
+    }
+
+    return context;
+}
+
+static void test_context_tear_down(void* fixture)
+{
+    struct test_context* context = (struct test_context*)fixture;
+    yk_distributed_database_release(context->ddb);
+    for(int i = 0; i < NUM_DATABASES; i++)
+        yk_database_handle_release(context->dbhs[i]);
+    yk_client_finalize(context->client);
+    margo_addr_free(context->mid, context->addr);
+    margo_finalize(context->mid);
+    delete context;
+}
+
+static void put_reference(struct test_context* context)
+{
+    std::vector<const void*> keys, vals;
+    std::vector<size_t> ksizes, vsizes;
+    for(auto& p : context->reference) {
+        keys.push_back(p.first.data());
+        ksizes.push_back(p.first.size());
+        vals.push_back(p.second.data());
+        vsizes.push_back(p.second.size());
+    }
+    yk_return_t ret = yk_distributed_put_multi(context->ddb, 0, keys.size(),
+            keys.data(), ksizes.data(), vals.data(), vsizes.data());
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+}
+
+static MunitResult test_distributed_put_get(const MunitParameter params[], void* data)
+{
+    (void)params;
+    struct test_context* context = (struct test_context*)data;
+    yk_return_t ret;
+
+    put_reference(context);
+
+    // each key is found by get, and lives in the database given by locate
+    size_t total = 0;
+    for(auto& p : context->reference) {
+        char value[16];
+        size_t vsize = 16;
+        ret = yk_distributed_get(context->ddb, 0,
+                p.first.data(), p.first.size(), value, &vsize);
+        munit_assert_int(ret, ==, YOKAN_SUCCESS);
+        munit_assert_long(vsize, ==, p.second.size());
+        munit_assert_memory_equal(vsize, value, p.second.data());
+
+        size_t index;
+        ret = yk_distributed_locate(context->ddb,
+                p.first.data(), p.first.size(), &index);
+        munit_assert_int(ret, ==, YOKAN_SUCCESS);
+        munit_assert_long(index, <, NUM_DATABASES);
+        uint8_t flag = 0;
+        ret = yk_exists(context->dbhs[index], 0,
+                p.first.data(), p.first.size(), &flag);
+        munit_assert_int(ret, ==, YOKAN_SUCCESS);
+        munit_assert_int(flag, ==, 1);
+    }
+
+    // the databases hold disjoint parts of the keys
+    for(int i = 0; i < NUM_DATABASES; i++) {
+        size_t c = 0;
+        ret = yk_count(context->dbhs[i], 0, &c);
+        munit_assert_int(ret, ==, YOKAN_SUCCESS);
+        total += c;
+    }
+    munit_assert_long(total, ==, context->reference.size());
+
+    size_t count = 0;
+    ret = yk_distributed_count(context->ddb, 0, &count);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    munit_assert_long(count, ==, context->reference.size());
+
+    // get_packed returns the values in the order of the keys
+    std::string packed_keys;
+    std::vector<size_t> ksizes;
+    std::string expected;
+    for(auto& p : context->reference) {
+        packed_keys += p.first;
+        ksizes.push_back(p.first.size());
+        expected += p.second;
+    }
+    std::vector<char> values(expected.size());
+    std::vector<size_t> vsizes(ksizes.size());
+    ret = yk_distributed_get_packed(context->ddb, 0, ksizes.size(),
+            packed_keys.data(), ksizes.data(),
+            values.size(), values.data(), vsizes.data());
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    munit_assert_memory_equal(expected.size(), values.data(), expected.data());
+
+    // erase_packed removes the keys from their database
+    ret = yk_distributed_erase_packed(context->ddb, 0, ksizes.size(),
+            packed_keys.data(), ksizes.data());
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    ret = yk_distributed_count(context->ddb, 0, &count);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    munit_assert_long(count, ==, 0);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_distributed_list(const MunitParameter params[], void* data)
+{
+    (void)params;
+    struct test_context* context = (struct test_context*)data;
+    yk_return_t ret;
+
+    put_reference(context);
+
+    // list_keys returns the keys in order, starting after from_key
+    const size_t count = 16;
+    std::vector<std::vector<char>> buffers(count, std::vector<char>(16));
+    std::vector<void*> keys(count);
+    std::vector<size_t> ksizes(count, 16);
+    for(size_t i = 0; i < count; i++) keys[i] = buffers[i].data();
+
+    auto it = context->reference.begin();
+    std::advance(it, 10);
+    ret = yk_distributed_list_keys(context->ddb, 0,
+            it->first.data(), it->first.size(), "key", 3,
+            count, keys.data(), ksizes.data());
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    ++it;
+    for(size_t i = 0; i < count; ++i, ++it) {
+        munit_assert_long(ksizes[i], ==, it->first.size());
+        munit_assert_memory_equal(ksizes[i], keys[i], it->first.data());
+    }
+
+    // iter goes over all the key/value pairs in order
+    struct iter_args {
+        std::map<std::string, std::string>::iterator it;
+        size_t count;
+    } args = { context->reference.begin(), 0 };
+
+    yk_iter_options_t options;
+    options.batch_size    = 5;
+    options.pool          = ABT_POOL_NULL;
+    options.ignore_values = false;
+    ret = yk_distributed_iter(context->ddb, 0, NULL, 0, NULL, 0, 0,
+        [](void* uargs, size_t i, const void* key, size_t ksize,
+           const void* val, size_t vsize) -> yk_return_t {
+            auto args = static_cast<iter_args*>(uargs);
+            if(i != args->count) return YOKAN_ERR_OTHER;
+            if(ksize != args->it->first.size()
+            || memcmp(key, args->it->first.data(), ksize) != 0)
+                return YOKAN_ERR_OTHER;
+            if(vsize != args->it->second.size()
+            || memcmp(val, args->it->second.data(), vsize) != 0)
+                return YOKAN_ERR_OTHER;
+            ++args->it;
+            ++args->count;
+            return YOKAN_SUCCESS;
+        }, &args, &options);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    munit_assert_long(args.count, ==, context->reference.size());
+
+    return MUNIT_OK;
+}
+
+static char* partitionings[] = {
+    (char*)"hash", (char*)"range", NULL
+};
+
+static MunitParameterEnum test_params[] = {
+  { (char*)"partitioning", partitionings },
+  { NULL, NULL }
+};
+
+static MunitTest test_suite_tests[] = {
+    { (char*) "/put_get", test_distributed_put_get,
+        test_context_setup, test_context_tear_down, MUNIT_TEST_OPTION_NONE, test_params },
+    { (char*) "/list", test_distributed_list,
+        test_context_setup, test_context_tear_down, MUNIT_TEST_OPTION_NONE, test_params },
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char*) "/yk/distributed", test_suite_tests, NULL, 1, MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char* argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, (void*) "yk", argc, argv);
+}
@@ -651,6 +651,87 @@ static MunitResult test_get_packed_key_not_found(const MunitParameter params[],
     return MUNIT_OK;
 }
 
+/**
+ * @brief Check that we can get values in buffers allocated by get_alloc,
+ * both with the values inlined in the response (default threshold) and
+ * pulled from the provider (threshold of 0).
+ */
+static MunitResult test_get_alloc(const MunitParameter params[], void* data)
+{
+    (void)params;
+    (void)data;
+    struct kv_test_context* context = (struct kv_test_context*)data;
+    yk_database_handle_t dbh = context->dbh;
+    yk_return_t ret;
+
+    for(size_t threshold : { (size_t)1024*1024, (size_t)0 }) {
+        for(auto& p : context->reference) {
+            void*  val   = nullptr;
+            size_t vsize = 0;
+            ret = yk_get_alloc(dbh, context->mode | YOKAN_MODE_EXTRA,
+                               p.first.data(), p.first.size(), &val, &vsize,
+                               YOKAN_EXTRA_DIRECT_THRESHOLD, threshold,
+                               YOKAN_EXTRA_END);
+            SKIP_IF_NOT_IMPLEMENTED(ret);
+            munit_assert_int(ret, ==, YOKAN_SUCCESS);
+            munit_assert_long(vsize, ==, p.second.size());
+            munit_assert_memory_equal(vsize, val, p.second.data());
+            free(val);
+        }
+
+        auto count = context->reference.size();
+        std::string         packed_keys;
+        std::vector<size_t> packed_ksizes(count);
+        std::vector<size_t> packed_vsizes(count);
+
+        unsigned i = 0;
+        for(auto& p : context->reference) {
+            if(i % 3 == 0) {
+                packed_keys += "XXXXXXXXXXXX";
+                packed_ksizes[i] = 12;
+            } else {
+                packed_keys += p.first;
+                packed_ksizes[i] = p.first.size();
+            }
+            i += 1;
+        }
+
+        void* packed_values = nullptr;
+        ret = yk_get_alloc_packed(dbh, context->mode | YOKAN_MODE_EXTRA, count,
+                                  packed_keys.data(), packed_ksizes.data(),
+                                  &packed_values, packed_vsizes.data(),
+                                  YOKAN_EXTRA_DIRECT_THRESHOLD, threshold,
+                                  YOKAN_EXTRA_END);
+        SKIP_IF_NOT_IMPLEMENTED(ret);
+        munit_assert_int(ret, ==, YOKAN_SUCCESS);
+
+        i = 0;
+        size_t offset = 0;
+        for(auto& p : context->reference) {
+            auto vsize = packed_vsizes[i];
+            if(i % 3 == 0) {
+                munit_assert_long(vsize, ==, YOKAN_KEY_NOT_FOUND);
+            } else {
+                munit_assert_long(vsize, ==, p.second.size());
+                munit_assert_memory_equal(vsize, (char*)packed_values + offset,
+                                          p.second.data());
+                offset += vsize;
+            }
+            i += 1;
+        }
+        free(packed_values);
+    }
+
+    void*  val   = nullptr;
+    size_t vsize = 0;
+    ret = yk_get_alloc(dbh, context->mode, "XXXXXXXXXXXX", 12, &val, &vsize);
+    SKIP_IF_NOT_IMPLEMENTED(ret);
+    munit_assert_int(ret, ==, YOKAN_ERR_KEY_NOT_FOUND);
+    munit_assert_null(val);
+
+    return MUNIT_OK;
+}
+
 /**
  * @brief Check that we can use get_bulk to store the key/value
  * pairs from the reference map. We use either null as the origin
@@ -765,6 +846,100 @@ static MunitResult test_get_bulk(const MunitParameter params[], void* data)
 static char* no_rdma_params[] = {
     (char*)"true", (char*)"false", (char*)NULL };
 
+/**
+ * @brief Check that the read cache serves repeated yk_get calls, that
+ * writes through the handle invalidate it, and that writes from another
+ * handle are only seen once the entry has been invalidated.
+ */
+static MunitResult test_get_read_cache(const MunitParameter params[], void* data)
+{
+    (void)params;
+    struct kv_test_context* context = (struct kv_test_context*)data;
+    yk_database_handle_t dbh = context->dbh;
+    yk_return_t ret;
+
+    if(context->reference.empty()) return MUNIT_OK;
+
+    yk_read_cache_options_t options;
+    options.capacity = 1024*1024;
+    options.ttl_ms   = 0.0;
+    ret = yk_database_handle_enable_read_cache(dbh, &options);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+
+    std::vector<char> val(g_max_val_size);
+    for(int i = 0; i < 2; i++) {
+        for(auto& p : context->reference) {
+            size_t vsize = g_max_val_size;
+            ret = yk_get(dbh, context->mode, p.first.data(), p.first.size(),
+                         val.data(), &vsize);
+            SKIP_IF_NOT_IMPLEMENTED(ret);
+            munit_assert_int(ret, ==, YOKAN_SUCCESS);
+            munit_assert_int(vsize, ==, p.second.size());
+            munit_assert_memory_equal(vsize, val.data(), p.second.data());
+        }
+    }
+
+    size_t hits = 0, misses = 0;
+    ret = yk_database_handle_read_cache_stats(dbh, &hits, &misses);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    munit_assert_long(hits, ==, context->reference.size());
+    munit_assert_long(misses, ==, context->reference.size());
+
+    /* The following checks need values that can be told apart. */
+    auto& key = context->reference.begin()->first;
+    auto& old_val = context->reference.begin()->second;
+    if(context->empty_values || old_val.empty()) return MUNIT_OK;
+
+    /* A write from another handle is not seen until invalidation.
+     * The new value has the same size, so it fits in val. */
+    std::string new_val = old_val;
+    new_val[0] = new_val[0] == '#' ? '$' : '#';
+    yk_database_handle_t other_dbh = YOKAN_DATABASE_HANDLE_NULL;
+    ret = yk_database_handle_create(context->client, context->addr,
+                                    provider_id, true, &other_dbh);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    ret = yk_put(other_dbh, context->mode, key.data(), key.size(),
+                 new_val.data(), new_val.size());
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    yk_database_handle_release(other_dbh);
+
+    size_t vsize = g_max_val_size;
+    ret = yk_get(dbh, context->mode, key.data(), key.size(), val.data(), &vsize);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    munit_assert_int(vsize, ==, old_val.size());
+    munit_assert_memory_equal(vsize, val.data(), old_val.data());
+
+    ret = yk_database_handle_invalidate_cache(dbh, key.data(), key.size());
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    vsize = g_max_val_size;
+    ret = yk_get(dbh, context->mode, key.data(), key.size(), val.data(), &vsize);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    munit_assert_int(vsize, ==, new_val.size());
+    munit_assert_memory_equal(vsize, val.data(), new_val.data());
+
+    /* Writes through the handle are seen immediately. */
+    ret = yk_put(dbh, context->mode, key.data(), key.size(),
+                 old_val.data(), old_val.size());
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    vsize = g_max_val_size;
+    ret = yk_get(dbh, context->mode, key.data(), key.size(), val.data(), &vsize);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    munit_assert_int(vsize, ==, old_val.size());
+    munit_assert_memory_equal(vsize, val.data(), old_val.data());
+
+    ret = yk_erase(dbh, context->mode, key.data(), key.size());
+    SKIP_IF_NOT_IMPLEMENTED(ret);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    vsize = g_max_val_size;
+    ret = yk_get(dbh, context->mode, key.data(), key.size(), val.data(), &vsize);
+    munit_assert_int(ret, ==, YOKAN_ERR_KEY_NOT_FOUND);
+
+    ret = yk_database_handle_disable_read_cache(dbh);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+
+    return MUNIT_OK;
+}
+
 static MunitParameterEnum test_params[] = {
   { (char*)"backend", (char**)available_backends },
   { (char*)"no-rdma", (char**)no_rdma_params },
@@ -801,8 +976,12 @@ static MunitTest test_suite_tests[] = {
         test_get_context_setup, kv_test_common_context_tear_down, MUNIT_TEST_OPTION_NONE, test_params },
     { (char*) "/get_packed/key-not-found", test_get_packed_key_not_found,
         test_get_context_setup, kv_test_common_context_tear_down, MUNIT_TEST_OPTION_NONE, test_params },
+    { (char*) "/get_alloc", test_get_alloc,
+        test_get_context_setup, kv_test_common_context_tear_down, MUNIT_TEST_OPTION_NONE, test_params },
     { (char*) "/get_bulk", test_get_bulk,
         test_get_context_setup, kv_test_common_context_tear_down, MUNIT_TEST_OPTION_NONE, test_params },
+    { (char*) "/get/read_cache", test_get_read_cache,
+        test_get_context_setup, kv_test_common_context_tear_down, MUNIT_TEST_OPTION_NONE, test_params },
     { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
 };
 
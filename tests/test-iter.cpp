@@ -166,6 +166,72 @@ static MunitResult test_iter(const MunitParameter params[], void* data)
     return MUNIT_OK;
 }
 
+static MunitResult test_scan(const MunitParameter params[], void* data)
+{
+    (void)params;
+    (void)data;
+    auto context = static_cast<iter_context*>(data);
+    yk_database_handle_t dbh = context->base->dbh;
+    yk_return_t ret;
+
+    std::vector<std::string> expected_keys;
+    std::vector<std::string> expected_vals;
+
+    for(auto& p : context->ordered_ref) {
+        if(starts_with(p.first, context->prefix)) {
+            expected_keys.push_back(p.first);
+            expected_vals.push_back(p.second);
+        }
+    }
+
+    auto no_values = to_bool(munit_parameters_get(params, "no-values"));
+
+    yk_scan_options_t options = YOKAN_SCAN_OPTIONS_INIT;
+    options.batch_size    = atol(munit_parameters_get(params, "batch-size"));
+    options.buffer_size   = 64; // small enough to need growing the pages
+    options.ignore_values = no_values;
+
+    yk_scanner_t scanner = YOKAN_SCANNER_NULL;
+    ret = yk_scanner_create(dbh, context->base->mode, nullptr, 0,
+                            context->prefix.data(), context->prefix.size(),
+                            &options, &scanner);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+
+    std::vector<std::string> recv_keys;
+    std::vector<std::string> recv_vals;
+    while(true) {
+        const void* key;
+        const void* val;
+        size_t ksize, vsize;
+        ret = yk_scanner_next(scanner, &key, &ksize, &val, &vsize);
+        if(ret == YOKAN_ERR_OP_UNSUPPORTED || ret == YOKAN_ERR_MODE) {
+            yk_scanner_destroy(scanner);
+            return MUNIT_SKIP;
+        }
+        munit_assert_int(ret, ==, YOKAN_SUCCESS);
+        if(ksize == YOKAN_NO_MORE_KEYS) break;
+        recv_keys.emplace_back((const char*)key, ksize);
+        if(val) recv_vals.emplace_back((const char*)val, vsize);
+        else recv_vals.emplace_back();
+    }
+    ret = yk_scanner_destroy(scanner);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+
+    munit_assert_long(recv_keys.size(), ==, expected_keys.size());
+    for(unsigned i=0; i < expected_keys.size(); ++i) {
+        munit_assert_long(recv_keys[i].size(), ==, expected_keys[i].size());
+        munit_assert_memory_equal(recv_keys[i].size(), recv_keys[i].data(), expected_keys[i].data());
+        if(no_values) {
+            munit_assert(recv_vals[i].empty());
+        } else {
+            munit_assert_long(recv_vals[i].size(), ==, expected_vals[i].size());
+            munit_assert_memory_equal(recv_vals[i].size(), recv_vals[i].data(), expected_vals[i].data());
+        }
+    }
+
+    return MUNIT_OK;
+}
+
 static MunitResult test_iter_custom_filter(const MunitParameter params[], void* data)
 {
     (void)params;
@@ -301,11 +367,28 @@ static MunitParameterEnum test_params_with_prefix[] = {
   { NULL, NULL }
 };
 
+static MunitParameterEnum test_scan_params[] = {
+  { (char*)"backend", (char**)available_backends },
+  { (char*)"no-rdma", (char**)true_false_params },
+  { (char*)"no-values", (char**)true_false_params },
+  { (char*)"inclusive", (char**)true_false_params },
+  { (char*)"batch-size", (char**)batch_size_params },
+  { (char*)"prefix", (char**)prefix_params },
+  { (char*)"min-key-size", NULL },
+  { (char*)"max-key-size", NULL },
+  { (char*)"min-val-size", NULL },
+  { (char*)"max-val-size", NULL },
+  { (char*)"num-items", NULL },
+  { NULL, NULL }
+};
+
 static MunitTest test_suite_tests[] = {
     { (char*) "/iter", test_iter,
         test_iter_context_setup, test_iter_context_tear_down, MUNIT_TEST_OPTION_NONE, test_params_with_prefix },
     { (char*) "/iter/custom_filter", test_iter_custom_filter,
         test_iter_context_setup, test_iter_context_tear_down, MUNIT_TEST_OPTION_NONE, test_params },
+    { (char*) "/scan", test_scan,
+        test_iter_context_setup, test_iter_context_tear_down, MUNIT_TEST_OPTION_NONE, test_scan_params },
     { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
 };
 
@@ -629,6 +629,129 @@ static MunitResult test_custom_filter(const MunitParameter params[], void* data)
 }
 
 
+/**
+ * @brief Check that a listing sees the writes that precede it
+ * (the leveldb backend keeps the snapshot of a scan across its pages).
+ */
+static MunitResult test_list_keys_after_put(const MunitParameter params[], void* data)
+{
+    (void)params;
+    auto context = static_cast<list_keys_context*>(data);
+    yk_database_handle_t dbh = context->base->dbh;
+    yk_return_t ret;
+
+    if(context->base->backend == "unqlite") return MUNIT_SKIP;
+
+    auto count = context->ordered_ref.size() + 1;
+    std::vector<size_t> ksizes(count);
+    std::vector<std::string> keys(count, std::string(g_max_key_size, '\0'));
+    std::vector<void*> kptrs(count, nullptr);
+    for(unsigned i = 0; i < count; i++)
+        kptrs[i] = const_cast<char*>(keys[i].data());
+
+    auto contains = [&](const std::string& key) {
+        for(unsigned i = 0; i < count; i++) {
+            if(ksizes[i] == YOKAN_NO_MORE_KEYS) break;
+            if(ksizes[i] == key.size()
+            && std::memcmp(kptrs[i], key.data(), key.size()) == 0)
+                return true;
+        }
+        return false;
+    };
+    auto list_all = [&]() {
+        ksizes.assign(count, g_max_key_size);
+        return yk_list_keys(dbh, context->base->mode, nullptr, 0,
+                            nullptr, 0, count, kptrs.data(), ksizes.data());
+    };
+
+    std::string new_key = "\x01";
+    std::string new_val = context->base->empty_values ? "" : "v";
+
+    ret = list_all();
+    SKIP_IF_NOT_IMPLEMENTED(ret);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    munit_assert(!contains(new_key));
+
+    ret = yk_put(dbh, context->base->mode, new_key.data(), new_key.size(),
+                 new_val.data(), new_val.size());
+    SKIP_IF_NOT_IMPLEMENTED(ret);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    ret = list_all();
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    munit_assert(contains(new_key));
+
+    ret = yk_erase(dbh, context->base->mode, new_key.data(), new_key.size());
+    if(ret == YOKAN_ERR_OP_UNSUPPORTED) return MUNIT_OK;
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    ret = list_all();
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    munit_assert(!contains(new_key));
+
+    return MUNIT_OK;
+}
+
+
+/**
+ * @brief Check that the pages of a scan over a leveldb database with
+ * snapshot_iteration enabled do not see the writes made between them,
+ * while a new scan does.
+ */
+static MunitResult test_list_keys_snapshot_pages(const MunitParameter params[], void* data)
+{
+    (void)params;
+    auto context = static_cast<list_keys_context*>(data);
+    yk_database_handle_t dbh = context->base->dbh;
+    yk_return_t ret;
+
+    if(context->base->backend != "leveldb") return MUNIT_SKIP;
+    if(context->ordered_ref.size() < 2) return MUNIT_SKIP;
+
+    auto mode = context->base->mode & ~YOKAN_MODE_INCLUSIVE;
+    auto it = context->ordered_ref.begin();
+    auto first_key  = it->first;
+    auto second_key = (++it)->first;
+
+    std::vector<std::string> keys(2, std::string(g_max_key_size, '\0'));
+    std::vector<void*> kptrs = { &keys[0][0], &keys[1][0] };
+    std::vector<size_t> ksizes(2, g_max_key_size);
+
+    // first page of the scan
+    ret = yk_list_keys(dbh, mode, nullptr, 0, nullptr, 0,
+                       1, kptrs.data(), ksizes.data());
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    munit_assert_long(ksizes[0], ==, first_key.size());
+    munit_assert_memory_equal(ksizes[0], kptrs[0], first_key.data());
+
+    // key sorted right after the end of the first page
+    std::string new_key = first_key + std::string(1, '\0');
+    std::string new_val = context->base->empty_values ? "" : "v";
+    ret = yk_put(dbh, context->base->mode, new_key.data(), new_key.size(),
+                 new_val.data(), new_val.size());
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+
+    // the second page uses the snapshot of the first one
+    ksizes[0] = g_max_key_size;
+    ret = yk_list_keys(dbh, mode, first_key.data(), first_key.size(),
+                       nullptr, 0, 1, kptrs.data(), ksizes.data());
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    munit_assert_long(ksizes[0], ==, second_key.size());
+    munit_assert_memory_equal(ksizes[0], kptrs[0], second_key.data());
+
+    // a new scan sees the put
+    ksizes.assign(2, g_max_key_size);
+    ret = yk_list_keys(dbh, mode, nullptr, 0, nullptr, 0,
+                       2, kptrs.data(), ksizes.data());
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    munit_assert_long(ksizes[1], ==, new_key.size());
+    munit_assert_memory_equal(ksizes[1], kptrs[1], new_key.data());
+
+    ret = yk_erase(dbh, context->base->mode, new_key.data(), new_key.size());
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+
+    return MUNIT_OK;
+}
+
+
 static char* inclusive_params[] = {
     (char*)"true", (char*)"false", NULL
 };
@@ -667,6 +790,10 @@ static MunitTest test_suite_tests[] = {
         test_list_keys_context_setup, test_list_keys_context_tear_down, MUNIT_TEST_OPTION_NONE, test_params },
     { (char*) "/list_custom_filter", test_custom_filter,
         test_list_keys_context_setup, test_list_keys_context_tear_down, MUNIT_TEST_OPTION_NONE, test_params },
+    { (char*) "/list_keys/after_put", test_list_keys_after_put,
+        test_list_keys_context_setup, test_list_keys_context_tear_down, MUNIT_TEST_OPTION_NONE, test_params },
+    { (char*) "/list_keys/snapshot_pages", test_list_keys_snapshot_pages,
+        test_list_keys_context_setup, test_list_keys_context_tear_down, MUNIT_TEST_OPTION_NONE, test_params },
     { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
 };
 
@@ -0,0 +1,223 @@
+/*
+ * (C) 2026 The University of Chicago
+ *
+ * See COPYRIGHT in top-level directory.
+ */
+#include "test-common-setup.hpp"
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdint>
+
+static void* test_merge_context_setup(const MunitParameter params[], void* user_data)
+{
+    auto context = static_cast<kv_test_context*>(
+        kv_test_common_context_setup(params, user_data));
+
+    std::vector<const void*> kptrs;
+    std::vector<size_t>      ksizes;
+    std::vector<const void*> vptrs;
+    std::vector<size_t>      vsizes;
+    for(auto& p : context->reference) {
+        kptrs.push_back(p.first.data());
+        ksizes.push_back(p.first.size());
+        vptrs.push_back(p.second.data());
+        vsizes.push_back(p.second.size());
+    }
+    yk_put_multi(context->dbh, context->mode, kptrs.size(), kptrs.data(), ksizes.data(),
+                 vptrs.data(), vsizes.data());
+
+    return context;
+}
+
+/**
+ * @brief Check that compare_and_swap only replaces values that match
+ * the expected value.
+ */
+static MunitResult test_compare_and_swap(const MunitParameter params[], void* data)
+{
+    (void)params;
+    auto* context = (kv_test_context*)data;
+    yk_database_handle_t dbh = context->dbh;
+    yk_return_t ret;
+
+    for(auto& p : context->reference) {
+        auto& val = p.second;
+        bool swapped = true;
+
+        // wrong expected value
+        std::string wrong = val + "X";
+        std::string new_val = "new_" + val;
+        ret = yk_compare_and_swap(dbh, context->mode, p.first.data(), p.first.size(),
+                                  wrong.data(), wrong.size(),
+                                  new_val.data(), new_val.size(), &swapped);
+        SKIP_IF_NOT_IMPLEMENTED(ret);
+        munit_assert_int(ret, ==, YOKAN_SUCCESS);
+        munit_assert(!swapped);
+
+        // right expected value
+        ret = yk_compare_and_swap(dbh, context->mode, p.first.data(), p.first.size(),
+                                  val.data(), val.size(),
+                                  new_val.data(), new_val.size(), &swapped);
+        munit_assert_int(ret, ==, YOKAN_SUCCESS);
+        munit_assert(swapped);
+        val = new_val;
+    }
+
+    bool swapped = true;
+    ret = yk_compare_and_swap(dbh, context->mode, "XXXXXXXXXXXX", 12,
+                              "a", 1, "b", 1, &swapped);
+    munit_assert_int(ret, ==, YOKAN_ERR_KEY_NOT_FOUND);
+
+    for(auto& p : context->reference) {
+        std::vector<char> buffer(p.second.size() + 1);
+        size_t vsize = buffer.size();
+        ret = yk_get(dbh, context->mode, p.first.data(), p.first.size(),
+                     buffer.data(), &vsize);
+        munit_assert_int(ret, ==, YOKAN_SUCCESS);
+        munit_assert_long(vsize, ==, p.second.size());
+        munit_assert_memory_equal(vsize, buffer.data(), p.second.data());
+    }
+
+    return MUNIT_OK;
+}
+
+/**
+ * @brief Check the merge operators, on new keys and on existing ones.
+ */
+static MunitResult test_merge(const MunitParameter params[], void* data)
+{
+    (void)params;
+    auto* context = (kv_test_context*)data;
+    yk_database_handle_t dbh = context->dbh;
+    yk_return_t ret;
+
+    // integer addition, starting from a missing key
+    std::string counter = "counter";
+    int64_t x = 0;
+    for(int64_t i = 1; i <= 10; i++) {
+        size_t rsize = sizeof(x);
+        ret = yk_merge(dbh, context->mode, counter.data(), counter.size(),
+                       YOKAN_MERGE_ADD_INT64, &i, sizeof(i), 0, &x, &rsize);
+        SKIP_IF_NOT_IMPLEMENTED(ret);
+        munit_assert_int(ret, ==, YOKAN_SUCCESS);
+        munit_assert_long(rsize, ==, sizeof(x));
+        munit_assert_long(x, ==, i*(i+1)/2);
+    }
+
+    // integer maximum, without requesting the result
+    int64_t y = 42;
+    ret = yk_merge(dbh, context->mode, counter.data(), counter.size(),
+                   YOKAN_MERGE_MAX_INT64, &y, sizeof(y), 0, nullptr, nullptr);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    y = 7;
+    ret = yk_merge(dbh, context->mode, counter.data(), counter.size(),
+                   YOKAN_MERGE_MAX_INT64, &y, sizeof(y), 0, nullptr, nullptr);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    size_t vsize = sizeof(x);
+    ret = yk_get(dbh, context->mode, counter.data(), counter.size(), &x, &vsize);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    munit_assert_long(x, ==, 55);
+
+    // integer operand of the wrong size
+    ret = yk_merge(dbh, context->mode, counter.data(), counter.size(),
+                   YOKAN_MERGE_ADD_INT64, "abc", 3, 0, nullptr, nullptr);
+    munit_assert_int(ret, ==, YOKAN_ERR_INVALID_ARGS);
+
+    // integer operators on an existing value of the wrong size, with and
+    // without requesting the result
+    std::string not_int = "not_int";
+    ret = yk_put(dbh, context->mode, not_int.data(), not_int.size(), "abc", 3);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    for(int32_t op : { YOKAN_MERGE_ADD_INT64, YOKAN_MERGE_MAX_INT64 }) {
+        ret = yk_merge(dbh, context->mode, not_int.data(), not_int.size(),
+                       op, &y, sizeof(y), 0, nullptr, nullptr);
+        munit_assert_int(ret, ==, YOKAN_ERR_INVALID_ARGS);
+        size_t rsize = sizeof(x);
+        ret = yk_merge(dbh, context->mode, not_int.data(), not_int.size(),
+                       op, &y, sizeof(y), 0, &x, &rsize);
+        munit_assert_int(ret, ==, YOKAN_ERR_INVALID_ARGS);
+    }
+    char not_int_val[8];
+    vsize = sizeof(not_int_val);
+    ret = yk_get(dbh, context->mode, not_int.data(), not_int.size(),
+                 not_int_val, &vsize);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    munit_assert_long(vsize, ==, 3);
+    munit_assert_memory_equal(3, not_int_val, "abc");
+
+    // bitwise or, extending the value
+    std::string flags = "flags";
+    ret = yk_merge(dbh, context->mode, flags.data(), flags.size(),
+                   YOKAN_MERGE_BIT_OR, "\x01", 1, 0, nullptr, nullptr);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    char bits[2] = { 0, 0 };
+    size_t bsize = sizeof(bits);
+    ret = yk_merge(dbh, context->mode, flags.data(), flags.size(),
+                   YOKAN_MERGE_BIT_OR, "\x02\x04", 2, 0, bits, &bsize);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    munit_assert_long(bsize, ==, 2);
+    munit_assert_int(bits[0], ==, 0x03);
+    munit_assert_int(bits[1], ==, 0x04);
+
+    // bounded append on existing keys
+    for(auto& p : context->reference) {
+        auto& val = p.second;
+        size_t bound = val.size() + 2;
+        std::vector<char> result(bound);
+        size_t rsize = result.size();
+        ret = yk_merge(dbh, context->mode, p.first.data(), p.first.size(),
+                       YOKAN_MERGE_APPEND, "12345", 5, bound, result.data(), &rsize);
+        munit_assert_int(ret, ==, YOKAN_SUCCESS);
+        val += "12345";
+        val.erase(0, val.size() - bound);
+        munit_assert_long(rsize, ==, val.size());
+        munit_assert_memory_equal(rsize, result.data(), val.data());
+    }
+
+    // EXIST_ONLY does not create the key
+    ret = yk_merge(dbh, context->mode|YOKAN_MODE_EXIST_ONLY,
+                   "XXXXXXXXXXXX", 12, YOKAN_MERGE_APPEND, "a", 1, 0, nullptr, nullptr);
+    if(ret != YOKAN_ERR_MODE)
+        munit_assert_int(ret, ==, YOKAN_ERR_KEY_NOT_FOUND);
+
+    for(auto& p : context->reference) {
+        std::vector<char> buffer(p.second.size() + 1);
+        size_t vsize = buffer.size();
+        ret = yk_get(dbh, context->mode, p.first.data(), p.first.size(),
+                     buffer.data(), &vsize);
+        munit_assert_int(ret, ==, YOKAN_SUCCESS);
+        munit_assert_long(vsize, ==, p.second.size());
+        munit_assert_memory_equal(vsize, buffer.data(), p.second.data());
+    }
+
+    return MUNIT_OK;
+}
+
+static MunitParameterEnum test_params[] = {
+    { (char*)"backend", (char**)available_backends },
+    { (char*)"min-key-size", NULL },
+    { (char*)"max-key-size", NULL },
+    { (char*)"min-val-size", NULL },
+    { (char*)"max-val-size", NULL },
+    { (char*)"num-items", NULL },
+    { NULL, NULL }
+};
+
+static MunitTest test_suite_tests[] = {
+    { (char*) "/compare_and_swap", test_compare_and_swap,
+        test_merge_context_setup, kv_test_common_context_tear_down,
+        MUNIT_TEST_OPTION_NONE, test_params },
+    { (char*) "/merge", test_merge,
+        test_merge_context_setup, kv_test_common_context_tear_down,
+        MUNIT_TEST_OPTION_NONE, test_params },
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char*) "/yk/database", test_suite_tests, NULL, 1, MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char* argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, (void*) "yk", argc, argv);
+}
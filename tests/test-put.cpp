@@ -1048,6 +1048,97 @@ static MunitResult test_put_extra_timeout(const MunitParameter params[], void* d
 static char* no_rdma_params[] = {
     (char*)"true", (char*)"false", (char*)NULL };
 
+/**
+ * @brief Check that puts and erases queued by the write combiner are
+ * flushed, in order, before a subsequent read on the same handle.
+ */
+static MunitResult test_put_write_combining(const MunitParameter params[], void* data)
+{
+    (void)params;
+    struct kv_test_context* context = (struct kv_test_context*)data;
+    yk_database_handle_t dbh = context->dbh;
+    yk_return_t ret;
+
+    if(context->reference.empty()) return MUNIT_OK;
+
+    /* Large thresholds so that only reads and explicit flushes send them. */
+    yk_write_combining_options_t options;
+    options.max_count    = 0;
+    options.max_size     = 0;
+    options.max_delay_ms = 60000.0;
+    ret = yk_database_handle_enable_write_combining(dbh, &options);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+
+    for(auto& p : context->reference) {
+        ret = yk_put(dbh, context->mode, p.first.data(), p.first.size(),
+                     p.second.data(), p.second.size());
+        munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    }
+
+    /* Erase the first key, then put it back and erase it again. */
+    auto& first = *context->reference.begin();
+    ret = yk_erase(dbh, context->mode, first.first.data(), first.first.size());
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    ret = yk_put(dbh, context->mode, first.first.data(), first.first.size(),
+                 first.second.data(), first.second.size());
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    ret = yk_erase(dbh, context->mode, first.first.data(), first.first.size());
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+
+    std::vector<char> val(g_max_val_size);
+    size_t vsize = g_max_val_size;
+    ret = yk_get(dbh, context->mode, first.first.data(), first.first.size(),
+                 val.data(), &vsize);
+    SKIP_IF_NOT_IMPLEMENTED(ret);
+    munit_assert_int(ret, ==, YOKAN_ERR_KEY_NOT_FOUND);
+
+    for(auto& p : context->reference) {
+        if(p.first == first.first) continue;
+        vsize = g_max_val_size;
+        ret = yk_get(dbh, context->mode, p.first.data(), p.first.size(),
+                     val.data(), &vsize);
+        munit_assert_int(ret, ==, YOKAN_SUCCESS);
+        munit_assert_int(vsize, ==, p.second.size());
+        munit_assert_memory_equal(vsize, val.data(), p.second.data());
+    }
+
+    /* Writes alternating between RDMA and NO_RDMA are all applied. */
+    int32_t other_mode = context->mode ^ YOKAN_MODE_NO_RDMA;
+    size_t i = 0;
+    for(auto& p : context->reference) {
+        ret = yk_put(dbh, (i++ % 2) ? other_mode : context->mode,
+                     p.first.data(), p.first.size(),
+                     p.second.data(), p.second.size());
+        munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    }
+    ret = yk_database_handle_flush(dbh);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    for(auto& p : context->reference) {
+        vsize = g_max_val_size;
+        ret = yk_get(dbh, context->mode, p.first.data(), p.first.size(),
+                     val.data(), &vsize);
+        munit_assert_int(ret, ==, YOKAN_SUCCESS);
+        munit_assert_int(vsize, ==, p.second.size());
+        munit_assert_memory_equal(vsize, val.data(), p.second.data());
+    }
+    ret = yk_erase(dbh, context->mode, first.first.data(), first.first.size());
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+
+    /* Writes with their own semantics are not queued. */
+    ret = yk_put(dbh, context->mode|YOKAN_MODE_NEW_ONLY,
+                 first.first.data(), first.first.size(),
+                 first.second.data(), first.second.size());
+    SKIP_IF_NOT_IMPLEMENTED(ret);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    ret = yk_database_handle_flush(dbh);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+
+    ret = yk_database_handle_disable_write_combining(dbh);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+
+    return MUNIT_OK;
+}
+
 static MunitParameterEnum test_params[] = {
   { (char*)"backend", (char**)available_backends },
   { (char*)"no-rdma", (char**)no_rdma_params },
@@ -1095,6 +1186,8 @@ static MunitTest test_suite_tests[] = {
         kv_test_common_context_setup, kv_test_common_context_tear_down, MUNIT_TEST_OPTION_NONE, test_params },
     { (char*) "/put/extra_timeout", test_put_extra_timeout,
         kv_test_common_context_setup, kv_test_common_context_tear_down, MUNIT_TEST_OPTION_NONE, test_params },
+    { (char*) "/put/write_combining", test_put_write_combining,
+        kv_test_common_context_setup, kv_test_common_context_tear_down, MUNIT_TEST_OPTION_NONE, test_params },
     { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
 };
 
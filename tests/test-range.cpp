@@ -0,0 +1,213 @@
+/*
+ * (C) 2026 The University of Chicago
+ *
+ * See COPYRIGHT in top-level directory.
+ */
+#include "test-common-setup.hpp"
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdint>
+
+static void* test_range_context_setup(const MunitParameter params[], void* user_data)
+{
+    auto context = static_cast<kv_test_context*>(
+        kv_test_common_context_setup(params, user_data));
+
+    std::vector<const void*> kptrs;
+    std::vector<size_t>      ksizes;
+    std::vector<const void*> vptrs;
+    std::vector<size_t>      vsizes;
+    for(auto& p : context->reference) {
+        kptrs.push_back(p.first.data());
+        ksizes.push_back(p.first.size());
+        vptrs.push_back(p.second.data());
+        vsizes.push_back(p.second.size());
+    }
+    yk_put_multi(context->dbh, context->mode, kptrs.size(), kptrs.data(), ksizes.data(),
+                 vptrs.data(), vsizes.data());
+
+    return context;
+}
+
+/**
+ * @brief Check that get_range reads the requested part of the values,
+ * truncated to the end of the value, both with the range inlined in
+ * the response (large threshold) and pushed by the provider (threshold
+ * of 0).
+ */
+static MunitResult test_get_range(const MunitParameter params[], void* data)
+{
+    (void)params;
+    auto* context = (kv_test_context*)data;
+    yk_database_handle_t dbh = context->dbh;
+    yk_return_t ret;
+
+    if(context->empty_values) return MUNIT_OK;
+
+    auto mode = context->mode | YOKAN_MODE_EXTRA;
+    std::vector<char> buffer(g_max_val_size);
+
+    for(size_t threshold : { (size_t)1024*1024, (size_t)0 }) {
+        for(auto& p : context->reference) {
+            auto& val = p.second;
+
+            // middle of the value
+            size_t offset = val.size() / 3;
+            size_t size   = val.size() / 2;
+            ret = yk_get_range(dbh, mode, p.first.data(), p.first.size(),
+                               offset, buffer.data(), &size,
+                               YOKAN_EXTRA_DIRECT_THRESHOLD, threshold,
+                               YOKAN_EXTRA_END);
+            SKIP_IF_NOT_IMPLEMENTED(ret);
+            munit_assert_int(ret, ==, YOKAN_SUCCESS);
+            munit_assert_long(size, ==, val.size() / 2);
+            munit_assert_memory_equal(size, buffer.data(), val.data() + offset);
+
+            // range going past the end of the value
+            size = g_max_val_size;
+            ret = yk_get_range(dbh, mode, p.first.data(), p.first.size(),
+                               offset, buffer.data(), &size,
+                               YOKAN_EXTRA_DIRECT_THRESHOLD, threshold,
+                               YOKAN_EXTRA_END);
+            munit_assert_int(ret, ==, YOKAN_SUCCESS);
+            munit_assert_long(size, ==, val.size() - offset);
+            munit_assert_memory_equal(size, buffer.data(), val.data() + offset);
+
+            // offset past the end of the value
+            size = g_max_val_size;
+            ret = yk_get_range(dbh, mode, p.first.data(), p.first.size(),
+                               val.size() + 1, buffer.data(), &size,
+                               YOKAN_EXTRA_DIRECT_THRESHOLD, threshold,
+                               YOKAN_EXTRA_END);
+            munit_assert_int(ret, ==, YOKAN_SUCCESS);
+            munit_assert_long(size, ==, 0);
+        }
+
+        size_t size = g_max_val_size;
+        ret = yk_get_range(dbh, mode, "XXXXXXXXXXXX", 12,
+                           0, buffer.data(), &size,
+                           YOKAN_EXTRA_DIRECT_THRESHOLD, threshold,
+                           YOKAN_EXTRA_END);
+        munit_assert_int(ret, ==, YOKAN_ERR_KEY_NOT_FOUND);
+    }
+
+    return MUNIT_OK;
+}
+
+/**
+ * @brief Check that put_range overwrites part of the values, extends
+ * them when writing past their end, and creates missing keys, both with
+ * the range sent along with the RPC (large threshold) and pulled by the
+ * provider (threshold of 0).
+ */
+static MunitResult test_put_range(const MunitParameter params[], void* data)
+{
+    (void)params;
+    auto* context = (kv_test_context*)data;
+    yk_database_handle_t dbh = context->dbh;
+    yk_return_t ret;
+
+    if(context->empty_values) return MUNIT_OK;
+
+    auto mode = context->mode | YOKAN_MODE_EXTRA;
+    std::string new_key = "XXXXXXXXXXXX";
+
+    for(size_t threshold : { (size_t)1024*1024, (size_t)0 }) {
+        for(auto& p : context->reference) {
+            if(p.first == new_key) continue;
+            auto& val = p.second;
+
+            // overwrite the middle of the value
+            std::string patch(val.size() / 2, '#');
+            size_t offset = val.size() / 3;
+            ret = yk_put_range(dbh, mode, p.first.data(), p.first.size(),
+                               offset, patch.data(), patch.size(),
+                               YOKAN_EXTRA_DIRECT_THRESHOLD, threshold,
+                               YOKAN_EXTRA_END);
+            SKIP_IF_NOT_IMPLEMENTED(ret);
+            munit_assert_int(ret, ==, YOKAN_SUCCESS);
+            val.replace(offset, patch.size(), patch);
+
+            // write past the end of the value, leaving a gap
+            std::string tail = "tail";
+            offset = val.size() + 3;
+            ret = yk_put_range(dbh, mode, p.first.data(), p.first.size(),
+                               offset, tail.data(), tail.size(),
+                               YOKAN_EXTRA_DIRECT_THRESHOLD, threshold,
+                               YOKAN_EXTRA_END);
+            munit_assert_int(ret, ==, YOKAN_SUCCESS);
+            val.resize(offset, '\0');
+            val += tail;
+        }
+
+        // create a new key (the second time, overwrite the same bytes)
+        ret = yk_put_range(dbh, mode, new_key.data(), new_key.size(),
+                           2, "abc", 3,
+                           YOKAN_EXTRA_DIRECT_THRESHOLD, threshold,
+                           YOKAN_EXTRA_END);
+        munit_assert_int(ret, ==, YOKAN_SUCCESS);
+        context->reference[new_key] = std::string("\0\0abc", 5);
+
+        // NEW_ONLY fails on an existing key
+        ret = yk_put_range(dbh, mode|YOKAN_MODE_NEW_ONLY,
+                           new_key.data(), new_key.size(), 0, "z", 1,
+                           YOKAN_EXTRA_DIRECT_THRESHOLD, threshold,
+                           YOKAN_EXTRA_END);
+        if(ret != YOKAN_ERR_MODE)
+            munit_assert_int(ret, ==, YOKAN_ERR_KEY_EXISTS);
+
+        // offsets whose end overflows or exceeds the provider's limit
+        for(size_t offset : { SIZE_MAX - 1, SIZE_MAX / 2 }) {
+            ret = yk_put_range(dbh, mode, new_key.data(), new_key.size(),
+                               offset, "abc", 3,
+                               YOKAN_EXTRA_DIRECT_THRESHOLD, threshold,
+                               YOKAN_EXTRA_END);
+            munit_assert_int(ret, ==, YOKAN_ERR_INVALID_ARGS);
+        }
+    }
+
+    for(auto& p : context->reference) {
+        std::vector<char> buffer(p.second.size() + 1);
+        size_t vsize = buffer.size();
+        ret = yk_get(dbh, context->mode, p.first.data(), p.first.size(),
+                     buffer.data(), &vsize);
+        munit_assert_int(ret, ==, YOKAN_SUCCESS);
+        munit_assert_long(vsize, ==, p.second.size());
+        munit_assert_memory_equal(vsize, buffer.data(), p.second.data());
+    }
+
+    return MUNIT_OK;
+}
+
+static char* no_rdma_params[] = {
+    (char*)"true", (char*)"false", (char*)NULL };
+
+static MunitParameterEnum test_params[] = {
+    { (char*)"backend", (char**)available_backends },
+    { (char*)"no-rdma", (char**)no_rdma_params },
+    { (char*)"min-key-size", NULL },
+    { (char*)"max-key-size", NULL },
+    { (char*)"min-val-size", NULL },
+    { (char*)"max-val-size", NULL },
+    { (char*)"num-items", NULL },
+    { NULL, NULL }
+};
+
+static MunitTest test_suite_tests[] = {
+    { (char*) "/get_range", test_get_range,
+        test_range_context_setup, kv_test_common_context_tear_down,
+        MUNIT_TEST_OPTION_NONE, test_params },
+    { (char*) "/put_range", test_put_range,
+        test_range_context_setup, kv_test_common_context_tear_down,
+        MUNIT_TEST_OPTION_NONE, test_params },
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char*) "/yk/database", test_suite_tests, NULL, 1, MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char* argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, (void*) "yk", argc, argv);
+}
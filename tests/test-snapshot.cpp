@@ -7,6 +7,7 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <string>
 #include <margo.h>
 #include <yokan/server.h>
 #include <yokan/client.h>
@@ -232,6 +233,85 @@ static MunitResult test_snapshot_remove_source(const MunitParameter params[], vo
     return MUNIT_OK;
 }
 
+static MunitResult test_restore_replays_wal(const MunitParameter params[], void* data)
+{
+    (void)params;
+    struct test_context* context = (struct test_context*)data;
+    yk_return_t ret;
+
+    if(strcmp(context->backend, "buffered") != 0) return MUNIT_SKIP;
+
+    // dedicated provider whose memtable never gets flushed in the background
+    const char* wal_path  = "/tmp/yokan-replay-test.wal";
+    const char* wal_saved = "/tmp/yokan-replay-test-saved.wal";
+    char cmd[512];
+    snprintf(cmd, sizeof(cmd), "rm -f %s %s*", wal_saved, wal_path);
+    int sysret = system(cmd);
+    (void)sysret;
+
+    std::string config = "{\"database\":{\"type\":\"buffered\",\"config\":{"
+        "\"inner\":{\"type\":\"map\",\"config\":{}},"
+        "\"flush_interval_ms\":3600000,"
+        "\"wal_path\":\"";
+    config += wal_path;
+    config += "\"}}}";
+    yk_provider_t provider;
+    struct yk_provider_args args = YOKAN_PROVIDER_ARGS_INIT;
+    ret = yk_provider_register(context->mid, 3, config.c_str(), &args, &provider);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+
+    yk_database_handle_t dbh;
+    ret = yk_database_handle_create(context->yokan_client,
+                                    context->addr, 3, true, &dbh);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+
+    // "before" is flushed into the snapshot
+    ret = yk_put(dbh, 0, "before", 6, "value1", 6);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    struct yk_snapshot_options snap_opts = { NULL, 0 };
+    ret = yk_provider_snapshot_database(provider, context->snap_dir, false, &snap_opts);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+
+    // "after" only lives in the memtable and the WAL, which we save
+    // as it would be left by a crash
+    ret = yk_put(dbh, 0, "after", 5, "value2", 6);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    snprintf(cmd, sizeof(cmd), "cp %s %s", wal_path, wal_saved);
+    munit_assert_int(system(cmd), ==, 0);
+    yk_database_handle_release(dbh);
+    yk_provider_destroy(provider);
+
+    // restore with the saved WAL, which must be replayed
+    std::string extra = "{\"wal_path\":\"";
+    extra += wal_saved;
+    extra += "\"}";
+    struct yk_restore_options rest_opts = {
+        context->restored_root, extra.c_str(), 0
+    };
+    ret = yk_provider_restore_database(
+        context->dst_provider, context->snap_dir, &rest_opts);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+
+    ret = yk_database_handle_create(context->yokan_client,
+                                    context->addr, 2, true, &dbh);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    char buf[16];
+    size_t vsize = sizeof(buf);
+    ret = yk_get(dbh, 0, "before", 6, buf, &vsize);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    munit_assert_memory_equal(vsize, buf, "value1");
+    vsize = sizeof(buf);
+    ret = yk_get(dbh, 0, "after", 5, buf, &vsize);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    munit_assert_memory_equal(vsize, buf, "value2");
+    yk_database_handle_release(dbh);
+
+    snprintf(cmd, sizeof(cmd), "rm -f %s* %s*", wal_saved, wal_path);
+    sysret = system(cmd);
+    (void)sysret;
+    return MUNIT_OK;
+}
+
 static MunitResult test_restore_requires_new_root(const MunitParameter params[], void* data)
 {
     (void)params;
@@ -291,6 +371,8 @@ static MunitTest test_suite_tests[] = {
         test_context_setup, test_context_tear_down, MUNIT_TEST_OPTION_NONE, test_params },
     { (char*)"/snapshot-remove-source", test_snapshot_remove_source,
         test_context_setup, test_context_tear_down, MUNIT_TEST_OPTION_NONE, test_params },
+    { (char*)"/restore-replays-wal", test_restore_replays_wal,
+        test_context_setup, test_context_tear_down, MUNIT_TEST_OPTION_NONE, test_params },
     { (char*)"/restore-requires-new-root", test_restore_requires_new_root,
         test_context_setup, test_context_tear_down, MUNIT_TEST_OPTION_NONE, test_params },
     { (char*)"/restore-bad-path", test_restore_bad_path,
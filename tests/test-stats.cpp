@@ -0,0 +1,369 @@
+/*
+ * (C) 2026 The University of Chicago
+ *
+ * See COPYRIGHT in top-level directory.
+ */
+#include "test-common-setup.hpp"
+#include <nlohmann/json.hpp>
+#include <cstdlib>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+
+#ifdef YOKAN_LOCK_PROFILING
+/**
+ * @brief Purpose of the lock that every put and get goes through in
+ * the given backend (with the test configuration), or nullptr if
+ * the backend does not have such a lock.
+ */
+static const char* profiled_lock_of(const std::string& backend) {
+    if(backend == "buffered") return "memtable";
+    if(backend == "leveldb" || backend == "lmdb"
+    || backend == "rocksdb" || backend == "tkrzw")
+        return "migration";
+    if(backend == "berkeleydb" || backend == "pmemkv")
+        return nullptr;
+    return "db";
+}
+#endif
+
+static MunitResult test_stats(const MunitParameter params[], void* data)
+{
+    (void)data;
+    struct kv_test_context* context = (struct kv_test_context*)data;
+    yk_database_handle_t dbh = context->dbh;
+    yk_return_t ret;
+
+    // make the client use RDMA unless YOKAN_MODE_NO_RDMA is specified
+    ret = yk_client_set_direct_threshold(context->client, 0);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+
+    // put all the reference key/value pairs, one at a time
+    for(auto& p : context->reference) {
+        ret = yk_put(dbh, context->mode,
+                     p.first.data(), p.first.size(),
+                     p.second.data(), p.second.size());
+        SKIP_IF_NOT_IMPLEMENTED(ret);
+        munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    }
+
+    char value[16];
+    size_t vsize = sizeof(value);
+    ret = yk_get(dbh, context->mode, "__missing__", 11, value, &vsize);
+    munit_assert_int(ret, ==, YOKAN_ERR_KEY_NOT_FOUND);
+
+    const bool direct = context->mode & YOKAN_MODE_NO_RDMA;
+
+    char* stats_str = nullptr;
+    ret = yk_get_stats(dbh, true, &stats_str);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    munit_assert_not_null(stats_str);
+    auto stats = json::parse(stats_str);
+    free(stats_str);
+
+    munit_assert_true(stats.contains("rpcs"));
+    auto& rpcs = stats["rpcs"];
+
+    auto put_name = direct ? "put_direct" : "put";
+    munit_assert_true(rpcs.contains(put_name));
+    auto& put = rpcs[put_name];
+    munit_assert_long(put["calls"].get<size_t>(), ==, context->reference.size());
+    munit_assert_long(put["keys"].get<size_t>(), ==, context->reference.size());
+    munit_assert_true(put["errors"].empty());
+    auto& latency = put["latency_us"];
+    munit_assert_true(latency["min"].get<double>() <= latency["p50"].get<double>());
+    munit_assert_true(latency["p50"].get<double>() <= latency["p99"].get<double>());
+    munit_assert_true(latency["p99"].get<double>() <= latency["max"].get<double>());
+
+    auto get_name = direct ? "get_direct" : "get";
+    munit_assert_true(rpcs.contains(get_name));
+    auto& get = rpcs[get_name];
+    munit_assert_long(get["calls"].get<size_t>(), ==, 1);
+    munit_assert_long(get["keys"].get<size_t>(), ==, 1);
+
+    // backend statistics are reported along with the RPC metrics
+    munit_assert_true(stats.contains("backend"));
+    auto& backend = stats["backend"];
+    munit_assert_true(backend.is_object());
+    munit_assert_string_equal(backend["type"].get<std::string>().c_str(),
+                              munit_parameters_get(params, "backend"));
+
+#ifdef YOKAN_LOCK_PROFILING
+    // locks of the backend have been profiled
+    munit_assert_true(stats.contains("locks"));
+    for(auto& lock : stats["locks"]) {
+        munit_assert_true(lock["wait_us"]["p50"].get<double>()
+                       <= lock["wait_us"]["max"].get<double>());
+    }
+    auto lock_purpose = profiled_lock_of(context->backend);
+    if(lock_purpose) {
+        // locks are keyed by "<backend type>/<lock purpose>"
+        auto lock_name = context->backend + "/" + lock_purpose;
+        munit_assert_true(stats["locks"].contains(lock_name));
+        auto& lock = stats["locks"][lock_name];
+        munit_assert_true(lock["read_acquisitions"].get<uint64_t>()
+                        + lock["write_acquisitions"].get<uint64_t>() > 0);
+    }
+#endif
+
+    // the metrics have been reset by the previous call
+    char* provider_stats_str = yk_provider_get_stats(context->provider, false);
+    munit_assert_not_null(provider_stats_str);
+    auto provider_stats = json::parse(provider_stats_str);
+    free(provider_stats_str);
+    munit_assert_true(provider_stats["rpcs"].empty());
+    munit_assert_true(provider_stats.contains("backend"));
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_client_stats(const MunitParameter params[], void* data)
+{
+    (void)params;
+    struct kv_test_context* context = (struct kv_test_context*)data;
+    yk_database_handle_t dbh = context->dbh;
+    yk_return_t ret;
+
+    size_t threshold = 0;
+    ret = yk_client_set_direct_threshold(context->client, 1024*1024);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    ret = yk_client_get_direct_threshold(context->client, &threshold);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    munit_assert_long(threshold, ==, 1024*1024);
+
+    char* stats_str = nullptr;
+    ret = yk_client_get_stats(context->client, true, &stats_str);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    free(stats_str);
+
+    // small operations are sent along with the RPC
+    size_t num_puts = 0;
+    for(auto& p : context->reference) {
+        ret = yk_put(dbh, context->mode,
+                     p.first.data(), p.first.size(),
+                     p.second.data(), p.second.size());
+        SKIP_IF_NOT_IMPLEMENTED(ret);
+        munit_assert_int(ret, ==, YOKAN_SUCCESS);
+        num_puts += 1;
+    }
+
+    // the per-call threshold takes precedence over the client's
+    auto& p = *context->reference.begin();
+    ret = yk_put(dbh, context->mode | YOKAN_MODE_EXTRA,
+                 p.first.data(), p.first.size(),
+                 p.second.data(), p.second.size(),
+                 YOKAN_EXTRA_DIRECT_THRESHOLD, (size_t)0,
+                 YOKAN_EXTRA_END);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+
+    const bool no_rdma = context->mode & YOKAN_MODE_NO_RDMA;
+
+    ret = yk_client_get_stats(context->client, true, &stats_str);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    munit_assert_not_null(stats_str);
+    auto stats = json::parse(stats_str);
+    free(stats_str);
+
+    munit_assert_long(stats["direct_threshold"].get<size_t>(), ==, 1024*1024);
+    auto& put = stats["transport"]["put"];
+    munit_assert_long(put["direct"].get<size_t>(), ==, no_rdma ? num_puts + 1 : num_puts);
+    munit_assert_long(put["bulk"].get<size_t>(), ==, no_rdma ? 0 : 1);
+
+    // the counters have been reset by the previous call
+    ret = yk_client_get_stats(context->client, false, &stats_str);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    stats = json::parse(stats_str);
+    free(stats_str);
+    munit_assert_true(stats["transport"].empty());
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_auto_direct(const MunitParameter params[], void* data)
+{
+    (void)params;
+    struct kv_test_context* context = (struct kv_test_context*)data;
+    yk_return_t ret;
+
+    if(context->mode & YOKAN_MODE_NO_RDMA || context->empty_values)
+        return MUNIT_SKIP;
+
+    // the common setup disables automatic selection,
+    // so use a new client that keeps its default threshold
+    yk_client_t client = YOKAN_CLIENT_NULL;
+    ret = yk_client_init(context->mid, &client);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    yk_database_handle_t dbh = YOKAN_DATABASE_HANDLE_NULL;
+    ret = yk_database_handle_create(client, context->addr, provider_id, true, &dbh);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+
+    // the default threshold is derived from Mercury's eager sizes
+    size_t threshold = 0;
+    ret = yk_client_get_direct_threshold(client, &threshold);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    munit_assert_long(threshold, >, 0);
+
+    // a small value is sent along with the RPC, a large one through RDMA
+    std::string small_key = "small", large_key = "large";
+    std::string small_val(1, 'x'), large_val(threshold + 1, 'x');
+    ret = yk_put(dbh, context->mode, small_key.data(), small_key.size(),
+                 small_val.data(), small_val.size());
+    SKIP_IF_NOT_IMPLEMENTED(ret);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    ret = yk_put(dbh, context->mode, large_key.data(), large_key.size(),
+                 large_val.data(), large_val.size());
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+
+    char* stats_str = nullptr;
+    ret = yk_client_get_stats(client, false, &stats_str);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    auto stats = json::parse(stats_str);
+    free(stats_str);
+    munit_assert_long(stats["direct_threshold"].get<size_t>(), ==, threshold);
+    auto& put = stats["transport"]["put"];
+    munit_assert_long(put["direct"].get<size_t>(), ==, 1);
+    munit_assert_long(put["bulk"].get<size_t>(), ==, 1);
+
+    ret = yk_database_handle_release(dbh);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    ret = yk_client_finalize(client);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_bulk_cache(const MunitParameter params[], void* data)
+{
+    (void)params;
+    struct kv_test_context* context = (struct kv_test_context*)data;
+    yk_database_handle_t dbh = context->dbh;
+    yk_return_t ret;
+
+    if(context->mode & YOKAN_MODE_NO_RDMA)
+        return MUNIT_SKIP;
+
+    // pack the reference key/value pairs into long-lived buffers
+    size_t count = context->reference.size();
+    std::vector<size_t> ksizes, vsizes;
+    std::string keys, vals;
+    for(auto& p : context->reference) {
+        ksizes.push_back(p.first.size());
+        vsizes.push_back(p.second.size());
+        keys += p.first;
+        vals += p.second;
+    }
+    std::vector<char> out_vals(vals.size()+1);
+    std::vector<size_t> out_vsizes(count);
+
+    ret = yk_client_set_direct_threshold(context->client, 0);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+
+    hg_bulk_t bulk = HG_BULK_NULL;
+    ret = yk_client_register_buffer(context->client, ksizes.data(),
+            count*sizeof(size_t), HG_BULK_READWRITE, &bulk);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    munit_assert_true(bulk != HG_BULK_NULL);
+    // registered buffers cannot overlap
+    ret = yk_client_register_buffer(context->client, ksizes.data(),
+            sizeof(size_t), HG_BULK_READWRITE, nullptr);
+    munit_assert_int(ret, ==, YOKAN_ERR_INVALID_ARGS);
+    for(auto& buffer : std::vector<std::pair<void*, size_t>>{
+            {vsizes.data(), count*sizeof(size_t)},
+            {out_vsizes.data(), count*sizeof(size_t)},
+            {(void*)keys.data(), keys.size()},
+            {(void*)vals.data(), vals.size()+1},
+            {out_vals.data(), out_vals.size()}}) {
+        ret = yk_client_register_buffer(context->client, buffer.first,
+                buffer.second, HG_BULK_READWRITE, nullptr);
+        munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    }
+
+    char* stats_str = nullptr;
+    ret = yk_client_get_stats(context->client, true, &stats_str);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    free(stats_str);
+
+    // the first operation creates the handle, the second one reuses it
+    for(int i = 0; i < 2; ++i) {
+        ret = yk_put_packed(dbh, context->mode, count,
+                            keys.data(), ksizes.data(),
+                            vals.data(), vsizes.data());
+        SKIP_IF_NOT_IMPLEMENTED(ret);
+        munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    }
+    for(int i = 0; i < 2; ++i) {
+        std::copy(vsizes.begin(), vsizes.end(), out_vsizes.begin());
+        ret = yk_get_packed(dbh, context->mode, count,
+                            keys.data(), ksizes.data(),
+                            out_vals.size(), out_vals.data(), out_vsizes.data());
+        SKIP_IF_NOT_IMPLEMENTED(ret);
+        munit_assert_int(ret, ==, YOKAN_SUCCESS);
+        munit_assert_memory_equal(vals.size(), out_vals.data(), vals.data());
+    }
+
+    ret = yk_client_get_stats(context->client, false, &stats_str);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    auto stats = json::parse(stats_str);
+    free(stats_str);
+    auto& cache = stats["bulk_cache"];
+    munit_assert_long(cache["registered_buffers"].get<size_t>(), ==, 6);
+    munit_assert_long(cache["entries"].get<size_t>(), ==, 2);
+    munit_assert_long(cache["misses"].get<size_t>(), ==, 2);
+    munit_assert_long(cache["hits"].get<size_t>(), ==, 2);
+
+    // unregistering a buffer invalidates the handles that expose it
+    ret = yk_client_unregister_buffer(context->client, out_vals.data());
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    ret = yk_client_unregister_buffer(context->client, out_vals.data());
+    munit_assert_int(ret, ==, YOKAN_ERR_INVALID_ARGS);
+
+    ret = yk_client_get_stats(context->client, false, &stats_str);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    stats = json::parse(stats_str);
+    free(stats_str);
+    munit_assert_long(stats["bulk_cache"]["entries"].get<size_t>(), ==, 1);
+
+    for(void* ptr : {(void*)ksizes.data(), (void*)vsizes.data(), (void*)out_vsizes.data(),
+                     (void*)keys.data(), (void*)vals.data()}) {
+        ret = yk_client_unregister_buffer(context->client, ptr);
+        munit_assert_int(ret, ==, YOKAN_SUCCESS);
+    }
+
+    return MUNIT_OK;
+}
+
+static char* no_rdma_params[] = {
+    (char*)"true", (char*)"false", (char*)NULL };
+
+static MunitParameterEnum test_params[] = {
+  { (char*)"backend", (char**)available_backends },
+  { (char*)"no-rdma", (char**)no_rdma_params },
+  { (char*)"min-key-size", NULL },
+  { (char*)"max-key-size", NULL },
+  { (char*)"min-val-size", NULL },
+  { (char*)"max-val-size", NULL },
+  { (char*)"num-items", NULL },
+  { NULL, NULL }
+};
+
+static MunitTest test_suite_tests[] = {
+    { (char*) "/stats", test_stats,
+        kv_test_common_context_setup, kv_test_common_context_tear_down, MUNIT_TEST_OPTION_NONE, test_params },
+    { (char*) "/client_stats", test_client_stats,
+        kv_test_common_context_setup, kv_test_common_context_tear_down, MUNIT_TEST_OPTION_NONE, test_params },
+    { (char*) "/auto_direct", test_auto_direct,
+        kv_test_common_context_setup, kv_test_common_context_tear_down, MUNIT_TEST_OPTION_NONE, test_params },
+    { (char*) "/bulk_cache", test_bulk_cache,
+        kv_test_common_context_setup, kv_test_common_context_tear_down, MUNIT_TEST_OPTION_NONE, test_params },
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char*) "/yk/database", test_suite_tests, NULL, 1, MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char* argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, (void*) "yk", argc, argv);
+}
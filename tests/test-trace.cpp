@@ -0,0 +1,122 @@
+/*
+ * (C) 2026 The University of Chicago
+ *
+ * See COPYRIGHT in top-level directory.
+ */
+#include "test-common-setup.hpp"
+#include <nlohmann/json.hpp>
+#include <cstdlib>
+#include <set>
+
+using json = nlohmann::json;
+
+static MunitResult test_trace(const MunitParameter params[], void* data)
+{
+    (void)params;
+    (void)data;
+    struct kv_test_context* context = (struct kv_test_context*)data;
+    yk_database_handle_t dbh = context->dbh;
+    yk_return_t ret;
+
+    // clear the spans produced by the setup
+    free(yk_provider_get_trace(context->provider, true));
+
+    auto& p = *context->reference.begin();
+    ret = yk_put(dbh, context->mode | YOKAN_MODE_EXTRA,
+                 p.first.data(), p.first.size(),
+                 p.second.data(), p.second.size(),
+                 YOKAN_EXTRA_TRACE_ID, (uint64_t)42,
+                 YOKAN_EXTRA_DIRECT_THRESHOLD, (size_t)0,
+                 YOKAN_EXTRA_END);
+    SKIP_IF_NOT_IMPLEMENTED(ret);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+
+    std::vector<char> value(p.second.size());
+    size_t vsize = value.size();
+    ret = yk_get(dbh, context->mode | YOKAN_MODE_EXTRA,
+                 p.first.data(), p.first.size(),
+                 value.data(), &vsize,
+                 YOKAN_EXTRA_TRACE_ID, (uint64_t)43,
+                 YOKAN_EXTRA_DIRECT_THRESHOLD, (size_t)0,
+                 YOKAN_EXTRA_END);
+    SKIP_IF_NOT_IMPLEMENTED(ret);
+    munit_assert_int(ret, ==, YOKAN_SUCCESS);
+
+    const bool direct = context->mode & YOKAN_MODE_NO_RDMA;
+
+    char* trace_str = yk_provider_get_trace(context->provider, true);
+    munit_assert_not_null(trace_str);
+    auto trace = json::parse(trace_str);
+    free(trace_str);
+
+    munit_assert_true(trace.contains("traceEvents"));
+    auto& events = trace["traceEvents"];
+
+    // phases that precede the response are guaranteed to have been
+    // recorded by the time the client gets the response
+    std::set<std::string> put_phases, get_phases;
+    for(auto& event : events) {
+        munit_assert_string_equal(event["ph"].get<std::string>().c_str(), "X");
+        munit_assert_true(event["dur"].get<int64_t>() >= 0);
+        auto tid = event["tid"].get<uint64_t>();
+        auto name = event["name"].get<std::string>();
+        if(tid == 42) {
+            munit_assert_string_equal(event["args"]["rpc"].get<std::string>().c_str(),
+                                      direct ? "put_direct" : "put");
+            put_phases.insert(name);
+        } else if(tid == 43) {
+            munit_assert_string_equal(event["args"]["rpc"].get<std::string>().c_str(),
+                                      direct ? "get_direct" : "get");
+            get_phases.insert(name);
+        }
+    }
+    for(auto& phases : {put_phases, get_phases}) {
+        munit_assert_true(phases.count("deserialize"));
+        munit_assert_true(phases.count("prepare"));
+        munit_assert_true(phases.count("backend"));
+        munit_assert_true(direct || phases.count("bulk_pull"));
+    }
+
+    // the trace has been cleared by the previous call
+    trace_str = yk_provider_get_trace(context->provider, false);
+    trace = json::parse(trace_str);
+    free(trace_str);
+    for(auto& event : trace["traceEvents"]) {
+        auto tid = event["tid"].get<uint64_t>();
+        // only late "respond" phases and RPC spans may remain
+        if(tid == 42 || tid == 43) {
+            auto name = event["name"].get<std::string>();
+            munit_assert_true(name != "backend");
+        }
+    }
+
+    return MUNIT_OK;
+}
+
+static char* tracing_params[] = {
+    (char*)"true", (char*)NULL };
+
+static MunitParameterEnum test_params[] = {
+  { (char*)"backend", (char**)available_backends },
+  { (char*)"tracing", (char**)tracing_params },
+  { (char*)"min-key-size", NULL },
+  { (char*)"max-key-size", NULL },
+  { (char*)"min-val-size", NULL },
+  { (char*)"max-val-size", NULL },
+  { (char*)"num-items", NULL },
+  { NULL, NULL }
+};
+
+static MunitTest test_suite_tests[] = {
+    { (char*) "/trace", test_trace,
+        kv_test_common_context_setup, kv_test_common_context_tear_down, MUNIT_TEST_OPTION_NONE, test_params },
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char*) "/yk/database", test_suite_tests, NULL, 1, MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char* argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, (void*) "yk", argc, argv);
+}